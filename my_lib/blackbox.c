@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    blackbox.c
+  * @version V 1.0.0
+  * @brief   固定长度记录的环形缓冲区，用于事故前后的现场记录（黑匣子）
+  ******************************************************************************
+  */
+
+#include "blackbox.h"
+
+//
+// @简介：初始化
+// @参数：BlackBox - 句柄
+// @参数：pBuffer - 存放记录的数组，大小为RecordSize*Capacity字节
+// @参数：RecordSize - 每条记录的字节数
+// @参数：Capacity - 最多存放的记录条数
+// @参数：PostTrigger - 触发后再写入的记录条数，不超过Capacity，其余为触发前的记录
+//
+void BlackBox_Init(BlackBox_TypeDef *BlackBox, void *pBuffer, uint16_t RecordSize, uint16_t Capacity, uint16_t PostTrigger)
+{
+	BlackBox->pBuffer = (uint8_t *)pBuffer;
+	BlackBox->RecordSize = RecordSize;
+	BlackBox->Capacity = Capacity;
+	BlackBox->PostTrigger = PostTrigger <= Capacity ? PostTrigger : Capacity;
+	BlackBox->Reason = 0;
+	BlackBox->TriggerUs = 0;
+
+	BlackBox_Arm(BlackBox);
+}
+
+//
+// @简介：清空记录，重新开始循环记录并等待触发
+//
+void BlackBox_Arm(BlackBox_TypeDef *BlackBox)
+{
+	BlackBox->Head = 0;
+	BlackBox->Count = 0;
+	BlackBox->Remaining = 0;
+	BlackBox->PreTrigger = 0;
+	BlackBox->State = BLACKBOX_STATE_ARMED;
+}
+
+//
+// @简介：取得下一条记录的位置，由调用者直接填写，省去一次复制
+// @返回值：记录的地址；已冻结时返回NULL，本次不记录
+// @注意：写入触发后的最后一条记录的位置时即进入冻结状态，
+//        调用者须在导出之前填写完毕（同一任务中紧接着填写即可）
+//
+void *BlackBox_Next(BlackBox_TypeDef *BlackBox)
+{
+	if(BlackBox->State == BLACKBOX_STATE_FROZEN) return NULL;
+
+	uint8_t *p = BlackBox->pBuffer + (uint32_t)BlackBox->Head * BlackBox->RecordSize;
+
+	if(++BlackBox->Head == BlackBox->Capacity) BlackBox->Head = 0;
+
+	if(BlackBox->Count < BlackBox->Capacity) BlackBox->Count++;
+
+	if(BlackBox->State == BLACKBOX_STATE_TRIGGERED && --BlackBox->Remaining == 0)
+	{
+		BlackBox->State = BLACKBOX_STATE_FROZEN;
+	}
+
+	return p;
+}
+
+//
+// @简介：触发，此后再写入PostTrigger条记录后冻结
+// @参数：Reason - 触发原因，由调用者定义，导出时一并给出
+// @参数：Us - 触发的时刻，单位us
+// @返回值：1 - 成功，0 - 已经触发过，本次忽略（只保留第一次触发的现场）
+//
+uint8_t BlackBox_Trigger(BlackBox_TypeDef *BlackBox, uint8_t Reason, uint32_t Us)
+{
+	if(BlackBox->State != BLACKBOX_STATE_ARMED) return 0;
+
+	BlackBox->Reason = Reason;
+	BlackBox->TriggerUs = Us;
+	BlackBox->PreTrigger = BlackBox->Count;
+	BlackBox->Remaining = BlackBox->PostTrigger;
+
+	if(BlackBox->PostTrigger > 0)
+	{
+		// 触发前的记录在写入触发后的记录时可能被覆盖，最多保留Capacity-PostTrigger条
+		if(BlackBox->PreTrigger > BlackBox->Capacity - BlackBox->PostTrigger)
+		{
+			BlackBox->PreTrigger = BlackBox->Capacity - BlackBox->PostTrigger;
+		}
+
+		BlackBox->State = BLACKBOX_STATE_TRIGGERED;
+	}
+	else
+	{
+		BlackBox->State = BLACKBOX_STATE_FROZEN;
+	}
+
+	return 1;
+}
+
+//
+// @简介：获取已有的记录条数
+//
+uint16_t BlackBox_GetCount(BlackBox_TypeDef *BlackBox)
+{
+	return BlackBox->Count;
+}
+
+//
+// @简介：按时间顺序读取一条记录
+// @参数：Index - 0为最旧的一条，BlackBox_GetCount()-1为最新的一条
+// @返回值：记录的地址，Index超出范围时返回NULL
+//
+const void *BlackBox_Get(BlackBox_TypeDef *BlackBox, uint16_t Index)
+{
+	if(Index >= BlackBox->Count) return NULL;
+
+	uint32_t pos = (uint32_t)BlackBox->Head + BlackBox->Capacity - BlackBox->Count + Index;
+
+	if(pos >= BlackBox->Capacity) pos -= BlackBox->Capacity;
+
+	return BlackBox->pBuffer + pos * BlackBox->RecordSize;
+}
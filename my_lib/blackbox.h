@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file    blackbox.h
+  * @version V 1.0.0
+  * @brief   固定长度记录的环形缓冲区，用于事故前后的现场记录（黑匣子）
+  *          平时循环覆盖最旧的记录；触发后再写入PostTrigger条记录即冻结，
+  *          此后不再写入，缓冲区中保存的是触发前后的一段连续记录，导出后重新启用。
+  *          记录的内容和格式由调用者决定，本模块只负责存放。本模块不处理互斥，由调用者负责
+  ******************************************************************************
+  */
+
+#ifndef _BLACKBOX_H_
+#define _BLACKBOX_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BLACKBOX_STATE_ARMED     0 // 循环记录，等待触发
+#define BLACKBOX_STATE_TRIGGERED 1 // 已触发，正在写入触发后的记录
+#define BLACKBOX_STATE_FROZEN    2 // 已冻结，等待导出
+
+typedef struct
+{
+	uint8_t *pBuffer;
+	uint16_t RecordSize;  // 每条记录的字节数
+	uint16_t Capacity;    // 最多存放的记录条数
+	uint16_t PostTrigger; // 触发后再写入的记录条数
+	uint16_t Head;        // 下一条记录的位置
+	uint16_t Count;       // 已有的记录条数
+	uint16_t Remaining;   // 冻结前还要写入的记录条数
+	uint16_t PreTrigger;  // 冻结时触发之前的记录条数
+	uint8_t State;        // BLACKBOX_STATE_xxx
+	uint8_t Reason;       // 触发原因，由调用者定义
+	uint32_t TriggerUs;   // 触发的时刻，单位us
+} BlackBox_TypeDef;
+
+       void BlackBox_Init(BlackBox_TypeDef *BlackBox, void *pBuffer, uint16_t RecordSize, uint16_t Capacity, uint16_t PostTrigger);
+       void BlackBox_Arm(BlackBox_TypeDef *BlackBox);
+      void *BlackBox_Next(BlackBox_TypeDef *BlackBox);
+    uint8_t BlackBox_Trigger(BlackBox_TypeDef *BlackBox, uint8_t Reason, uint32_t Us);
+   uint16_t BlackBox_GetCount(BlackBox_TypeDef *BlackBox);
+const void *BlackBox_Get(BlackBox_TypeDef *BlackBox, uint16_t Index);
+
+//
+// @简介：float转换为Q格式的16位定点数（值乘以2^Frac后向0取整），超出范围时饱和，nan按饱和处理
+//        单片机没有FPU，乘法加取整要调用两次浮点库函数；这里直接按IEEE 754的位移位，
+//        Cortex-M3上约10条指令，供每个控制周期写入记录时使用
+// @参数：Frac - 小数位数，0..15，可表示的范围为±2^(15-Frac)
+//
+static __inline int16_t BlackBox_Q16(float Value, uint8_t Frac)
+{
+	union { float f; uint32_t u; } v;
+
+	v.f = Value;
+
+	int32_t shift = 150 - (int32_t)Frac - (int32_t)((v.u >> 23) & 0xff); // 尾数（含隐含的1）右移的位数
+	int32_t neg = (int32_t)v.u >> 31;                                    // 负数为-1，否则为0
+	int32_t mag;
+
+	if(shift <= 8) mag = 0x7fff;       // 绝对值不小于2^(15-Frac)
+	else if(shift >= 32) mag = 0;      // 绝对值小于2^-Frac，含0和非规格化数
+	else mag = (int32_t)(((v.u & 0x7fffff) | 0x800000) >> shift);
+
+	return (int16_t)((mag ^ neg) - neg);
+}
+
+#endif
@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    bus.c
+  * @version V 1.0.0
+  * @brief   样本总线（发布/订阅）
+  ******************************************************************************
+  */
+
+#include "bus.h"
+#include "delay.h"
+#include <string.h>
+
+//
+// @简介：初始化主题，清空样本
+// @参数：pBuffer - 样本的存储区，Size - 样本的字节数
+// @注意：也可以用BUS_TOPIC静态初始化，不必调用本函数
+//
+void Bus_Init(Bus_TopicTypeDef *Topic, void *pBuffer, uint16_t Size)
+{
+	Topic->pData = pBuffer;
+	Topic->Size = Size;
+	Topic->Seq = 0;
+	Topic->Us = 0;
+	
+	memset(pBuffer, 0, Size);
+}
+
+//
+// @简介：取得样本的存储区，生产者在其中原地写入，写完后调用Bus_Publish
+// @返回值：存储区的地址，其中是上一个样本，只更新变化的部分即可
+//
+void *Bus_Write(Bus_TopicTypeDef *Topic)
+{
+	return Topic->pData;
+}
+
+//
+// @简介：发布写好的样本
+// @参数：Us - 样本的时刻（测量的时刻），单位us
+//
+void Bus_Publish(Bus_TopicTypeDef *Topic, uint32_t Us)
+{
+	Topic->Us = Us;
+	Topic->Seq++;
+}
+
+//
+// @简介：读取最近的样本，不复制
+// @返回值：存储区的地址，还没有样本时其中全为0（见Bus_GetSeq）
+//
+const void *Bus_Read(const Bus_TopicTypeDef *Topic)
+{
+	return Topic->pData;
+}
+
+//
+// @简介：已发布的样本数
+// @返回值：0表示还没有样本
+//
+uint32_t Bus_GetSeq(const Bus_TopicTypeDef *Topic)
+{
+	return Topic->Seq;
+}
+
+//
+// @简介：最近的样本的时刻
+// @返回值：发布时传入的时刻，单位us
+//
+uint32_t Bus_GetUs(const Bus_TopicTypeDef *Topic)
+{
+	return Topic->Us;
+}
+
+//
+// @简介：最近的样本有多旧
+// @参数：Now - 当前时刻，单位us
+// @返回值：Now与样本的时刻之差，单位us；还没有样本时返回0xFFFFFFFF
+//
+uint32_t Bus_GetAge(const Bus_TopicTypeDef *Topic, uint32_t Now)
+{
+	if(Topic->Seq == 0) return 0xFFFFFFFF;
+	
+	return Time_Diff(Now, Topic->Us);
+}
+
+//
+// @简介：自上次调用以来有没有新样本
+// @参数：pLastSeq - 输入输出参数，消费者保存的上次看到的序号，初值为0
+// @返回值：1 - 有，0 - 没有
+// @注意：两次调用之间发布了多个样本时也只返回1，丢失的个数为序号之差减1
+//
+uint8_t Bus_Poll(const Bus_TopicTypeDef *Topic, uint32_t *pLastSeq)
+{
+	if(Topic->Seq == *pLastSeq) return 0;
+	
+	*pLastSeq = Topic->Seq;
+	
+	return 1;
+}
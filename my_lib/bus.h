@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file    bus.h
+  * @version V 1.0.0
+  * @brief   样本总线（发布/订阅）
+  *          每个主题是一块固定大小的存储区，只保存最近的一个样本。生产者原地写入后发布，
+  *          记下时刻并把序号加1；消费者原地读取，不复制，用序号判断有没有新样本，
+  *          用时刻判断样本有多旧。
+  *
+  *          ImuSample_TypeDef *s = Bus_Write(&topic);   // 生产者
+  *          s->Pitch = ...;
+  *          Bus_Publish(&topic, GetUs());
+  *
+  *          const ImuSample_TypeDef *s = Bus_Read(&topic); // 消费者
+  *          uint32_t age = Bus_GetAge(&topic, GetUs());
+  *
+  *          只有一块存储区，生产者写入期间读到的样本不完整，因此同一个主题的生产者和消费者
+  *          须在同一优先级运行（例如都在主循环中），不能一个在中断中
+  ******************************************************************************
+  */
+
+#ifndef _BUS_H_
+#define _BUS_H_
+
+#include <stdint.h>
+
+typedef struct
+{
+	void *pData;           // 样本的存储区
+	uint16_t Size;         // 样本的字节数
+	uint32_t Seq;          // 已发布的样本数，0表示还没有样本
+	uint32_t Us;           // 最近一次发布时传入的时刻，单位us
+} Bus_TopicTypeDef;
+
+// 静态初始化一个主题，Sample为样本的存储区（变量名）
+#define BUS_TOPIC(Sample) {&(Sample), sizeof(Sample), 0, 0}
+
+       void Bus_Init(Bus_TopicTypeDef *Topic, void *pBuffer, uint16_t Size);
+      void *Bus_Write(Bus_TopicTypeDef *Topic);
+       void Bus_Publish(Bus_TopicTypeDef *Topic, uint32_t Us);
+const void *Bus_Read(const Bus_TopicTypeDef *Topic);
+   uint32_t Bus_GetSeq(const Bus_TopicTypeDef *Topic);
+   uint32_t Bus_GetUs(const Bus_TopicTypeDef *Topic);
+   uint32_t Bus_GetAge(const Bus_TopicTypeDef *Topic, uint32_t Now);
+    uint8_t Bus_Poll(const Bus_TopicTypeDef *Topic, uint32_t *pLastSeq);
+
+#endif
@@ -0,0 +1,188 @@
+/**
+  ******************************************************************************
+  * @file    cascade.c
+  * @version V 1.0.0
+  * @brief   串级控制器框架
+  ******************************************************************************
+  */
+
+#include "cascade.h"
+
+//
+// @简介：初始化串级控制器
+// @参数：Cascade - 串级控制器句柄
+// @参数：BaseTs - 基本周期，单位s，即Cascade_Run的调用周期
+//
+void Cascade_Init(Cascade_TypeDef *Cascade, float BaseTs)
+{
+	Cascade->NumStages = 0;
+	Cascade->BaseTs = BaseTs;
+	Cascade->Tick = 0;
+}
+
+//
+// @简介：为串级控制器添加一级
+// @参数：Cascade - 串级控制器句柄
+// @参数：Cascade_StageInitStruct - 该级的参数
+// @返回值：该级的编号，-1表示级数已满
+// @注意：Cascade_Run按添加的顺序执行各级，因此外环须先于内环添加
+//
+int8_t Cascade_AddStage(Cascade_TypeDef *Cascade, Cascade_StageInitTypeDef *Cascade_StageInitStruct)
+{
+	if(Cascade->NumStages >= CASCADE_MAX_STAGES) return -1;
+	
+	int8_t idx = Cascade->NumStages++;
+	Cascade_StageTypeDef *stage = &Cascade->Stages[idx];
+	
+	stage->pInput = Cascade_StageInitStruct->pInput;
+	stage->Transform = Cascade_StageInitStruct->Transform;
+	stage->Next = CASCADE_NO_LINK;
+	stage->Output = Cascade_StageInitStruct->PID_InitStruct.DefaultOutput;
+	stage->Decimation = Cascade_StageInitStruct->Decimation ? Cascade_StageInitStruct->Decimation : 1;
+	stage->Average = Cascade_StageInitStruct->Average;
+	stage->Count = 0;
+	stage->Sum = 0;
+	
+	// 每一级都是固定周期的PID，周期为基本周期乘以分频系数
+	PID_InitFixedRate(&stage->PID, &Cascade_StageInitStruct->PID_InitStruct, Cascade->BaseTs * stage->Decimation);
+	
+	return idx;
+}
+
+//
+// @简介：将From级的输出（经Transform换算后）连接到To级的设定值
+// @参数：Cascade - 串级控制器句柄
+// @参数：From - 外环的编号
+// @参数：To - 内环的编号，必须在From之后添加
+//
+void Cascade_Link(Cascade_TypeDef *Cascade, int8_t From, int8_t To)
+{
+	if(From < 0 || From >= Cascade->NumStages) return;
+	if(To <= From || To >= Cascade->NumStages) return; // 只允许向后连接，保证同一次运行内设定值即时生效
+	
+	Cascade->Stages[From].Next = To;
+}
+
+//
+// @简介：运行一次串级控制器，须以基本周期调用
+//        各级按顺序执行，未到运行时刻的级保持上一次的输出，
+//        因此低速的外环给出的设定值会保持到它下一次运行；设置了Average的级每次都累加反馈量，运行时取平均
+// @参数：Cascade - 串级控制器句柄
+//
+void Cascade_Run(Cascade_TypeDef *Cascade)
+{
+	for(uint8_t i=0; i<Cascade->NumStages; i++)
+	{
+		Cascade_StageTypeDef *stage = &Cascade->Stages[i];
+		float input = *stage->pInput;
+		
+		if(stage->Average)
+		{
+			stage->Sum += input;
+			stage->Count++;
+		}
+		
+		if(Cascade->Tick % stage->Decimation != 0) continue; // 本周期不运行
+		
+		if(stage->Average)
+		{
+			input = stage->Sum / stage->Count;
+			stage->Sum = 0;
+			stage->Count = 0;
+		}
+		
+		stage->Output = PID_ComputeFixedRate(&stage->PID, input);
+		
+		if(stage->Next != CASCADE_NO_LINK)
+		{
+			float sp = stage->Transform ? stage->Transform(stage->Output) : stage->Output;
+			
+			PID_ChangeSetpoint(&Cascade->Stages[stage->Next].PID, sp);
+		}
+	}
+	
+	Cascade->Tick++;
+}
+
+//
+// @简介：复位串级控制器的所有级，并从头开始计数
+// @参数：Cascade - 串级控制器句柄
+//
+void Cascade_Reset(Cascade_TypeDef *Cascade)
+{
+	for(uint8_t i=0; i<Cascade->NumStages; i++)
+	{
+		PID_Reset(&Cascade->Stages[i].PID);
+		Cascade->Stages[i].Output = Cascade->Stages[i].PID.Init.DefaultOutput;
+		Cascade->Stages[i].Count = 0;
+		Cascade->Stages[i].Sum = 0;
+	}
+	
+	Cascade->Tick = 0;
+}
+
+//
+// @简介：调整计数，使分频系数为Decimation（及其约数）的级在下一次Cascade_Run时运行，已对齐时不改变
+//        外环的测量值比基本周期更新得慢时，在新的测量值到达后、Cascade_Run之前调用，
+//        外环就总是使用刚到达的测量值，而不是等到下一次轮到它时才用上
+// @参数：Cascade - 串级控制器句柄
+// @参数：Decimation - 测量值的更新周期（基本周期的倍数），须为各慢速级的分频系数的约数或倍数
+//
+void Cascade_Align(Cascade_TypeDef *Cascade, uint16_t Decimation)
+{
+	if(Decimation <= 1) return;
+	
+	uint32_t r = Cascade->Tick % Decimation;
+	
+	if(r != 0) Cascade->Tick += Decimation - r;
+}
+
+//
+// @简介：修改某一级的分频系数，并同步修改该级PID的运算周期
+// @参数：Cascade - 串级控制器句柄
+// @参数：Stage - 级的编号
+// @参数：Decimation - 新的分频系数，0视为1
+//
+void Cascade_SetDecimation(Cascade_TypeDef *Cascade, int8_t Stage, uint16_t Decimation)
+{
+	if(Stage < 0 || Stage >= Cascade->NumStages) return;
+	
+	Cascade_StageTypeDef *stage = &Cascade->Stages[Stage];
+	
+	stage->Decimation = Decimation ? Decimation : 1;
+	
+	PID_ChangeRate(&stage->PID, Cascade->BaseTs * stage->Decimation);
+}
+
+//
+// @简介：修改某一级的设定值，通常用于最外环
+// @参数：Cascade - 串级控制器句柄
+// @参数：Stage - 级的编号
+// @参数：NewSetpoint - 新的设定值
+//
+void Cascade_ChangeSetpoint(Cascade_TypeDef *Cascade, int8_t Stage, float NewSetpoint)
+{
+	if(Stage < 0 || Stage >= Cascade->NumStages) return;
+	
+	PID_ChangeSetpoint(&Cascade->Stages[Stage].PID, NewSetpoint);
+}
+
+//
+// @简介：获取某一级最近一次的输出（换算之前）
+// @参数：Cascade - 串级控制器句柄
+// @参数：Stage - 级的编号
+//
+float Cascade_GetOutput(Cascade_TypeDef *Cascade, int8_t Stage)
+{
+	return Cascade->Stages[Stage].Output;
+}
+
+//
+// @简介：获取某一级的PID句柄，用于调参或读取内部状态
+// @参数：Cascade - 串级控制器句柄
+// @参数：Stage - 级的编号
+//
+PID_TypeDef *Cascade_GetPID(Cascade_TypeDef *Cascade, int8_t Stage)
+{
+	return &Cascade->Stages[Stage].PID;
+}
@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file    cascade.h
+  * @version V 1.0.0
+  * @brief   串级控制器框架
+  *          由若干级固定周期PID组成，每一级的输出经过可选的换算后作为下一级的设定值，
+  *          各级可以按基本周期的整数倍分频运行，整条串级在一次调用中按顺序执行完毕
+  ******************************************************************************
+  */
+
+#ifndef _CASCADE_H_
+#define _CASCADE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pid.h"
+
+#define CASCADE_MAX_STAGES 6 // 最多支持的级数
+#define CASCADE_NO_LINK   -1 // 该级的输出不连接到其它级
+
+typedef struct
+{
+	PID_InitTypeDef PID_InitStruct; // 该级PID的参数
+	const float *pInput;            // 该级的反馈量（测量值），Cascade_Run时读取
+	float (*Transform)(float Output); // 输出换算为下一级设定值的函数，NULL表示直接连接
+	uint16_t Decimation;            // 分频系数，每Decimation个基本周期运行一次，0视为1
+	uint8_t Average;                // 非0时反馈量取两次运行之间各基本周期的平均值，分频运行时滤除高于该级频率的成分
+} Cascade_StageInitTypeDef;
+
+typedef struct
+{
+	PID_TypeDef PID;
+	const float *pInput;
+	float (*Transform)(float Output);
+	uint16_t Decimation;
+	uint8_t Average;
+	uint16_t Count; // 本次运行前已累加的反馈量的个数（Average）
+	float Sum;      // 累加的反馈量
+	int8_t Next;   // 下一级的编号，CASCADE_NO_LINK表示末级
+	float Output;  // 该级最近一次的输出（换算之前），在两次运行之间保持不变
+} Cascade_StageTypeDef;
+
+typedef struct
+{
+	Cascade_StageTypeDef Stages[CASCADE_MAX_STAGES];
+	uint8_t NumStages;
+	float BaseTs;   // 基本周期，单位s，即Cascade_Run的调用周期
+	uint32_t Tick;  // Cascade_Run的调用次数，各级据此判断本周期是否运行
+} Cascade_TypeDef;
+
+         void Cascade_Init(Cascade_TypeDef *Cascade, float BaseTs);
+       int8_t Cascade_AddStage(Cascade_TypeDef *Cascade, Cascade_StageInitTypeDef *Cascade_StageInitStruct);
+         void Cascade_Link(Cascade_TypeDef *Cascade, int8_t From, int8_t To);
+         void Cascade_Run(Cascade_TypeDef *Cascade);
+         void Cascade_Reset(Cascade_TypeDef *Cascade);
+         void Cascade_Align(Cascade_TypeDef *Cascade, uint16_t Decimation);
+         void Cascade_SetDecimation(Cascade_TypeDef *Cascade, int8_t Stage, uint16_t Decimation);
+         void Cascade_ChangeSetpoint(Cascade_TypeDef *Cascade, int8_t Stage, float NewSetpoint);
+        float Cascade_GetOutput(Cascade_TypeDef *Cascade, int8_t Stage);
+ PID_TypeDef *Cascade_GetPID(Cascade_TypeDef *Cascade, int8_t Stage);
+
+#endif
@@ -1,22 +1,53 @@
-/**
-  ******************************************************************************
-  * @file    delay.c
-  * @author  铁头山羊
-  * @version V 1.0.0
-  * @date    2022年8月30日
-  * @brief   延迟函数源头文件
-  ******************************************************************************
-  */
-
-#ifndef _DELAY_H_
-#define _DELAY_H_
-
-#include "stm32f10x.h"
-
-    void Delay_Init(void); // 延迟函数初始化
-    void Delay(uint32_t ms); // 延迟
-uint32_t GetTick(void); // 获取系统的当前时间
-uint64_t GetUs(void); // 获取当前的微秒级时间
-    void DelayUs(uint32_t us); // 微秒级延迟
-
-#endif
+/**
+  ******************************************************************************
+  * @file    delay.c
+  * @author  铁头山羊
+  * @version V 1.0.0
+  * @date    2022年8月30日
+  * @brief   延迟函数源头文件
+  ******************************************************************************
+  */
+
+#ifndef _DELAY_H_
+#define _DELAY_H_
+
+#include "stm32f10x.h"
+
+    void Delay_Init(void); // 延迟函数初始化
+    void Delay(uint32_t ms); // 延迟
+uint32_t GetTick(void); // 获取系统的当前时间
+uint32_t GetUs(void); // 获取当前的微秒级时间
+    void DelayUs(uint32_t us); // 微秒级延迟
+
+//
+// 时间戳均为32位无符号数，毫秒时间约49.7天回绕一次，微秒时间约71.6分钟回绕一次。
+// 回绕后直接比较大小会出错，因此求时间差、判断先后一律使用下面的函数，
+// 它们利用无符号减法的模运算，只要两个时刻相距不超过2^31即可得到正确结果
+//
+
+//
+// @简介：计算时间差 Later - Earlier，单位与参数相同
+//
+__STATIC_INLINE uint32_t Time_Diff(uint32_t Later, uint32_t Earlier)
+{
+	return Later - Earlier;
+}
+
+//
+// @简介：判断时刻Now是否已经到达（或超过）时刻Deadline
+// @返回值：1 - 已到达，0 - 未到达
+//
+__STATIC_INLINE uint8_t Time_Reached(uint32_t Now, uint32_t Deadline)
+{
+	return (int32_t)(Now - Deadline) >= 0;
+}
+
+//
+// @简介：将微秒级的时间差换算为秒
+//
+__STATIC_INLINE float Time_UsToSec(uint32_t Us)
+{
+	return Us * 1.0e-6f;
+}
+
+#endif
@@ -0,0 +1,248 @@
+/**
+  ******************************************************************************
+  * @file    edgecap.c
+  * @version V 1.0.0
+  * @brief   定时器输入捕获+循环DMA的边沿时间记录器
+  *          每个边沿由硬件把CCR（时间）和GPIO的IDR（电平快照）各搬运一次，
+  *          CPU只需要在任务中批量读取，边沿本身不再产生中断
+  ******************************************************************************
+  */
+
+#include "edgecap.h"
+#include "delay.h"
+
+static void DMA_Config(DMA_Channel_TypeDef *DMAy_Channelx, uint32_t PeripheralAddr, uint16_t *pBuffer, uint16_t Size);
+static void Consume(EdgeCap_TypeDef *EdgeCap, uint16_t Idx);
+static uint8_t IsFresh(EdgeCap_TypeDef *EdgeCap, uint16_t Idx);
+
+//
+// @简介：初始化边沿记录器
+// @参数：EdgeCap - 边沿记录器句柄
+// @参数：EdgeCap_InitStruct - 初始化参数
+// @注意：如果定时器尚未启动，则将其配置为1MHz自由计数（周期65536us）；
+//        如果定时器已经被其它模块启动（例如TIM3作为ADC触发源），则沿用其时基，
+//        此时要求其计数频率同样为1MHz
+//
+void My_EdgeCap_Init(EdgeCap_TypeDef *EdgeCap, EdgeCap_InitTypeDef *EdgeCap_InitStruct)
+{
+	EdgeCap->Init = *EdgeCap_InitStruct;
+	EdgeCap->ReadIdx = 0;
+	EdgeCap->Overruns = 0;
+
+	for(uint16_t i=0; i<EdgeCap->Init.BufferSize; i++)
+	{
+		Consume(EdgeCap, i); // 空的缓冲区视为全部已读取
+	}
+
+	TIM_TypeDef *TIMx = EdgeCap->Init.TIMx;
+
+	// #1. 初始化引脚为上拉输入
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	GPIO_InitStruct.GPIO_Pin = EdgeCap->Init.GPIO_Pin;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
+
+	GPIO_Init(EdgeCap->Init.GPIOx, &GPIO_InitStruct);
+
+	// #2. 时基单元
+	if((TIMx->CR1 & TIM_CR1_CEN) == 0)
+	{
+		RCC_ClocksTypeDef clockinfo = {0};
+		RCC_GetClocksFreq(&clockinfo);
+
+		TIM_TimeBaseInitTypeDef TIM_TimeBaseInitStruct = {0};
+
+		TIM_TimeBaseInitStruct.TIM_CounterMode = TIM_CounterMode_Up;
+		TIM_TimeBaseInitStruct.TIM_Period = 0xffff;
+		TIM_TimeBaseInitStruct.TIM_Prescaler = clockinfo.PCLK1_Frequency * 2 / 1000000 - 1; // APB1定时器时钟为PCLK1的2倍
+		TIM_TimeBaseInitStruct.TIM_RepetitionCounter = 0;
+
+		TIM_TimeBaseInit(TIMx, &TIM_TimeBaseInitStruct);
+
+		TIM_Cmd(TIMx, ENABLE);
+	}
+
+	EdgeCap->Period = TIMx->ARR + 1;
+
+	// #3. 输入捕获
+	// 捕获通道直接连接引脚，配对通道以IndirectTI方式连接同一引脚，二者在同一个边沿上触发
+	TIM_ICInitTypeDef TIM_ICInitStruct = {0};
+
+	TIM_ICInitStruct.TIM_Channel = EdgeCap->Init.TIM_Channel;
+	TIM_ICInitStruct.TIM_ICPolarity = EdgeCap->Init.TIM_ICPolarity;
+	TIM_ICInitStruct.TIM_ICSelection = TIM_ICSelection_DirectTI;
+	TIM_ICInitStruct.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+	TIM_ICInitStruct.TIM_ICFilter = 0x3; // 8个采样点的数字滤波，滤除电机干扰
+	TIM_ICInit(TIMx, &TIM_ICInitStruct);
+
+	TIM_ICInitStruct.TIM_Channel = EdgeCap->Init.TIM_Channel ^ TIM_Channel_2; // 1<->2，3<->4
+	TIM_ICInitStruct.TIM_ICSelection = TIM_ICSelection_IndirectTI;
+	TIM_ICInit(TIMx, &TIM_ICInitStruct);
+
+	// #4. DMA，循环模式
+	RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+	DMA_Config(EdgeCap->Init.TimeDMAy_Channelx,
+	           (uint32_t)&TIMx->CCR1 + EdgeCap->Init.TIM_Channel, // CCR1..CCR4之间间隔4字节，与TIM_Channel_x的取值一致
+	           EdgeCap->Init.pTimeBuffer, EdgeCap->Init.BufferSize);
+
+	DMA_Config(EdgeCap->Init.LevelDMAy_Channelx,
+	           (uint32_t)&EdgeCap->Init.GPIOx->IDR,
+	           EdgeCap->Init.pLevelBuffer, EdgeCap->Init.BufferSize);
+
+	// TIM_DMA_CC1..CC4的取值依次左移1位
+	TIM_DMACmd(TIMx, TIM_DMA_CC1 << (EdgeCap->Init.TIM_Channel >> 2), ENABLE);
+	TIM_DMACmd(TIMx, TIM_DMA_CC1 << ((EdgeCap->Init.TIM_Channel ^ TIM_Channel_2) >> 2), ENABLE);
+}
+
+//
+// @简介：批量取出自上次读取以来捕获到的全部边沿
+// @参数：EdgeCap - 边沿记录器句柄
+// @参数：pTimesOut - 输出参数，边沿发生的时间，单位us，与GetUs()同一时间轴
+// @参数：pLevelsOut - 输出参数，边沿发生时端口的电平快照，可以为NULL
+// @参数：MaxCount - 输出数组的长度
+// @返回值：取出的边沿数量，按时间先后排列
+//
+uint16_t My_EdgeCap_Fetch(EdgeCap_TypeDef *EdgeCap, uint32_t *pTimesOut, uint16_t *pLevelsOut, uint16_t MaxCount)
+{
+	__disable_irq(); // 保证计数器和GetUs()在同一时刻读取
+
+	uint16_t timeRemaining = EdgeCap->Init.TimeDMAy_Channelx->CNDTR;
+	uint16_t levelRemaining = EdgeCap->Init.LevelDMAy_Channelx->CNDTR;
+	uint16_t counterNow = EdgeCap->Init.TIMx->CNT;
+	uint32_t now = GetUs();
+
+	__enable_irq();
+
+	uint16_t timeIdx = (EdgeCap->Init.BufferSize - timeRemaining) % EdgeCap->Init.BufferSize;
+	uint16_t levelIdx = (EdgeCap->Init.BufferSize - levelRemaining) % EdgeCap->Init.BufferSize;
+
+	// 两路DMA在同一边沿上触发，以落后的一路为准，另一路多出来的边沿留到下一次。
+	// 二者最多相差一个位置；CNDTR到0时重装为BufferSize，因此不能直接比较剩余数量的大小
+	uint16_t writeIdx = ((timeIdx + 1) % EdgeCap->Init.BufferSize == levelIdx) ? timeIdx : levelIdx;
+
+	return EdgeCap_Drain(EdgeCap, writeIdx, counterNow, now, pTimesOut, pLevelsOut, MaxCount);
+}
+
+//
+// @简介：从缓冲区中取出[ReadIdx, WriteIdx)之间的边沿，不访问任何外设
+//        My_EdgeCap_Fetch在读取DMA和定时器的状态后调用此函数；
+//        在电脑上可以直接填写缓冲区并调用此函数，以模拟捕获数据流（tools/edgecap）
+//        溢出检测：读取过的位置在电平缓冲区中改写为被捕获引脚在边沿之后不可能出现的电平，
+//        DMA的下一个写入位置本应是读取过的位置，如果它仍是新写入的边沿，说明DMA已经绕过了
+//        未读取的数据（只看WriteIdx无法区分缓冲区为空和正好绕过一圈），此时丢弃全部边沿并计数。
+//        两路DMA服务同一个边沿有先后，电平可能比时间多写一个位置，因此连续两个位置都是新边沿才算溢出
+// @参数：EdgeCap - 边沿记录器句柄
+// @参数：WriteIdx - DMA的下一个写入位置
+// @参数：CounterNow - 定时器计数器的当前值
+// @参数：Now - 当前时间，单位us
+// @参数：pTimesOut - 输出参数，边沿发生的时间，单位us
+// @参数：pLevelsOut - 输出参数，边沿发生时端口的电平快照，可以为NULL
+// @参数：MaxCount - 输出数组的长度
+// @返回值：取出的边沿数量
+//
+uint16_t EdgeCap_Drain(EdgeCap_TypeDef *EdgeCap, uint16_t WriteIdx, uint16_t CounterNow, uint32_t Now, uint32_t *pTimesOut, uint16_t *pLevelsOut, uint16_t MaxCount)
+{
+	uint16_t n = 0;
+
+	if(IsFresh(EdgeCap, WriteIdx) && IsFresh(EdgeCap, (WriteIdx + 1) % EdgeCap->Init.BufferSize)) // 溢出
+	{
+		for(uint16_t i=0; i<EdgeCap->Init.BufferSize; i++)
+		{
+			Consume(EdgeCap, i);
+		}
+
+		EdgeCap->ReadIdx = WriteIdx;
+		EdgeCap->Overruns++;
+
+		return 0;
+	}
+
+	while(EdgeCap->ReadIdx != WriteIdx && n < MaxCount)
+	{
+		pTimesOut[n] = EdgeCap_ToUs(EdgeCap, EdgeCap->Init.pTimeBuffer[EdgeCap->ReadIdx], CounterNow, Now);
+
+		if(pLevelsOut)
+		{
+			pLevelsOut[n] = EdgeCap->Init.pLevelBuffer[EdgeCap->ReadIdx];
+		}
+
+		Consume(EdgeCap, EdgeCap->ReadIdx);
+
+		n++;
+
+		EdgeCap->ReadIdx++;
+
+		if(EdgeCap->ReadIdx >= EdgeCap->Init.BufferSize)
+		{
+			EdgeCap->ReadIdx = 0;
+		}
+	}
+
+	return n;
+}
+
+//
+// @简介：将捕获值换算到GetUs()的时间轴上
+// @参数：Capture - 捕获值（CCR）
+// @参数：CounterNow - 定时器计数器的当前值
+// @参数：Now - 读取CounterNow时的GetUs()
+// @返回值：边沿发生的时间，单位us
+// @注意：要求边沿距今不超过一个定时器周期，因此必须周期性地读取
+//
+uint32_t EdgeCap_ToUs(EdgeCap_TypeDef *EdgeCap, uint16_t Capture, uint16_t CounterNow, uint32_t Now)
+{
+	uint32_t elapsed = (CounterNow + EdgeCap->Period - Capture) % EdgeCap->Period; // 边沿距今的时间
+
+	return Now - elapsed;
+}
+
+//
+// @简介：把电平缓冲区中的一个位置标记为已读取：被捕获引脚的电平改为边沿之后不可能出现的值
+//        （上升沿之后为高电平，标记为低电平；下降沿反之），其它引脚的电平不变
+//
+static void Consume(EdgeCap_TypeDef *EdgeCap, uint16_t Idx)
+{
+	if(EdgeCap->Init.TIM_ICPolarity == TIM_ICPolarity_Falling)
+	{
+		EdgeCap->Init.pLevelBuffer[Idx] |= EdgeCap->Init.GPIO_Pin;
+	}
+	else
+	{
+		EdgeCap->Init.pLevelBuffer[Idx] &= ~EdgeCap->Init.GPIO_Pin;
+	}
+}
+
+//
+// @简介：该位置是否为DMA写入后尚未读取的边沿
+//
+static uint8_t IsFresh(EdgeCap_TypeDef *EdgeCap, uint16_t Idx)
+{
+	uint16_t level = EdgeCap->Init.pLevelBuffer[Idx] & EdgeCap->Init.GPIO_Pin;
+
+	return (EdgeCap->Init.TIM_ICPolarity == TIM_ICPolarity_Falling) ? (level == 0) : (level != 0);
+}
+
+//
+// @简介：将DMA通道配置为从外设寄存器到内存的16位循环传输
+//
+static void DMA_Config(DMA_Channel_TypeDef *DMAy_Channelx, uint32_t PeripheralAddr, uint16_t *pBuffer, uint16_t Size)
+{
+	DMA_Cmd(DMAy_Channelx, DISABLE);
+
+	DMA_InitTypeDef DMA_InitStruct;
+	DMA_InitStruct.DMA_PeripheralBaseAddr = PeripheralAddr;
+	DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)pBuffer;
+	DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralSRC;
+	DMA_InitStruct.DMA_BufferSize = Size;
+	DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+	DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+	DMA_InitStruct.DMA_Mode = DMA_Mode_Circular;
+	DMA_InitStruct.DMA_Priority = DMA_Priority_High;
+	DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;
+	DMA_Init(DMAy_Channelx, &DMA_InitStruct);
+
+	DMA_Cmd(DMAy_Channelx, ENABLE);
+}
@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    edgecap.h
+  * @version V 1.0.0
+  * @brief   定时器输入捕获+循环DMA的边沿时间记录器
+  ******************************************************************************
+  */
+
+#ifndef _EDGECAP_H_
+#define _EDGECAP_H_
+
+#include "stm32f10x.h"
+
+typedef struct
+{
+	TIM_TypeDef *TIMx;                       // 定时器，计数频率须为1MHz（1us/计数）
+	uint16_t TIM_Channel;                    // 记录时间的捕获通道，TIM_Channel_1..4
+	                                         // 配对通道（1-2，3-4）以IndirectTI方式捕获同一边沿，用于拍下引脚电平
+	uint16_t TIM_ICPolarity;                 // TIM_ICPolarity_Rising或TIM_ICPolarity_Falling（F1不支持双边沿捕获）
+	DMA_Channel_TypeDef *TimeDMAy_Channelx;  // 捕获通道对应的DMA通道
+	DMA_Channel_TypeDef *LevelDMAy_Channelx; // 配对通道对应的DMA通道
+	GPIO_TypeDef *GPIOx;                     // 被捕获信号所在的端口，电平快照读取的是该端口的IDR
+	uint16_t GPIO_Pin;                       // 被捕获信号的引脚
+	uint16_t *pTimeBuffer;                   // 时间缓冲区（循环DMA写入CCR的值）
+	uint16_t *pLevelBuffer;                  // 电平缓冲区（循环DMA写入IDR的值）
+	uint16_t BufferSize;                     // 缓冲区长度，两次读取之间的边沿须少于BufferSize-1个
+} EdgeCap_InitTypeDef;
+
+typedef struct
+{
+	EdgeCap_InitTypeDef Init;
+	uint32_t Period;  // 定时器的计数周期（ARR+1），单位us
+	uint16_t ReadIdx; // 下一个待读取的缓冲区位置
+	uint32_t Overruns; // DMA绕过未读取的边沿（溢出）的次数，溢出时缓冲区中的边沿全部丢弃
+} EdgeCap_TypeDef;
+
+    void My_EdgeCap_Init(EdgeCap_TypeDef *EdgeCap, EdgeCap_InitTypeDef *EdgeCap_InitStruct);
+uint16_t My_EdgeCap_Fetch(EdgeCap_TypeDef *EdgeCap, uint32_t *pTimesOut, uint16_t *pLevelsOut, uint16_t MaxCount);
+uint16_t EdgeCap_Drain(EdgeCap_TypeDef *EdgeCap, uint16_t WriteIdx, uint16_t CounterNow, uint32_t Now, uint32_t *pTimesOut, uint16_t *pLevelsOut, uint16_t MaxCount);
+uint32_t EdgeCap_ToUs(EdgeCap_TypeDef *EdgeCap, uint16_t Capture, uint16_t CounterNow, uint32_t Now);
+
+#endif
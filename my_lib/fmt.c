@@ -0,0 +1,366 @@
+/**
+  ******************************************************************************
+  * @file    fmt.c
+  * @version V 1.0.0
+  * @brief   精简的格式化输出，代替vsprintf
+  ******************************************************************************
+  */
+
+#include "fmt.h"
+
+#define FLAG_LEFT  0x01 // -
+#define FLAG_ZERO  0x02 // 0
+#define FLAG_PLUS  0x04 // +
+#define FLAG_SPACE 0x08 // 空格
+
+typedef struct
+{
+	char *pBuffer;
+	uint16_t Size;
+	uint16_t Len;
+} Out_TypeDef;
+
+static const uint32_t pow10[FMT_MAX_PRECISION + 1] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+static void    Put(Out_TypeDef *Out, char C);
+static void    Pad(Out_TypeDef *Out, char C, int Count);
+static void    Emit(Out_TypeDef *Out, char Sign, const char *pBody, int BodyLen, int Width, uint8_t Flags);
+static uint8_t UToStr(uint64_t Value, uint8_t Base, uint8_t Upper, char *pOut);
+static uint8_t FloatToStr(float Value, uint8_t Precision, char *pOut, uint8_t *pNeg);
+
+//
+// @简介：格式化输出到缓冲区
+// @参数：pBuffer - 输出的缓冲区，结果总是以'\0'结尾
+// @参数：Size - 缓冲区的大小，放不下的部分被截断
+// @参数：Format - 格式，支持的功能见fmt.h
+// @返回值：写入的字符数（不含'\0'）
+//
+int Fmt_Format(char *pBuffer, uint16_t Size, const char *Format, ...)
+{
+	va_list args;
+
+	va_start(args, Format);
+
+	int n = Fmt_VFormat(pBuffer, Size, Format, args);
+
+	va_end(args);
+
+	return n;
+}
+
+//
+// @简介：同Fmt_Format，参数以va_list传入
+//
+int Fmt_VFormat(char *pBuffer, uint16_t Size, const char *Format, va_list Args)
+{
+	Out_TypeDef out = {pBuffer, Size, 0};
+	char body[52]; // float的整数部分最多39位，加小数点和9位小数
+
+	for(const char *p = Format; *p != '\0'; p++)
+	{
+		if(*p != '%')
+		{
+			Put(&out, *p);
+			continue;
+		}
+
+		// #1. 标志
+		uint8_t flags = 0;
+
+		for(p++; ; p++)
+		{
+			if(*p == '-') flags |= FLAG_LEFT;
+			else if(*p == '0') flags |= FLAG_ZERO;
+			else if(*p == '+') flags |= FLAG_PLUS;
+			else if(*p == ' ') flags |= FLAG_SPACE;
+			else break;
+		}
+
+		// #2. 宽度
+		int width = 0;
+
+		if(*p == '*')
+		{
+			width = va_arg(Args, int);
+			if(width < 0) { flags |= FLAG_LEFT; width = -width; }
+			p++;
+		}
+		else
+		{
+			while(*p >= '0' && *p <= '9') width = width * 10 + (*p++ - '0');
+		}
+
+		// #3. 精度
+		int precision = -1;
+
+		if(*p == '.')
+		{
+			p++;
+			precision = 0;
+
+			if(*p == '*')
+			{
+				precision = va_arg(Args, int);
+				p++;
+			}
+			else
+			{
+				while(*p >= '0' && *p <= '9') precision = precision * 10 + (*p++ - '0');
+			}
+		}
+
+		// #4. 长度
+		uint8_t isLong = 0;
+
+		while(*p == 'l' || *p == 'h')
+		{
+			if(*p == 'l') isLong = 1;
+			p++;
+		}
+
+		// #5. 转换
+		char sign = 0;
+		int len;
+
+		switch(*p)
+		{
+			case 'd':
+			case 'i':
+			{
+				long v = isLong ? va_arg(Args, long) : va_arg(Args, int);
+				unsigned long mag = v < 0 ? 0UL - (unsigned long)v : (unsigned long)v;
+
+				sign = v < 0 ? '-' : (flags & FLAG_PLUS) ? '+' : (flags & FLAG_SPACE) ? ' ' : 0;
+				len = UToStr(mag, 10, 0, body);
+				Emit(&out, sign, body, len, width, flags);
+				break;
+			}
+			case 'u':
+			case 'x':
+			case 'X':
+			{
+				unsigned long v = isLong ? va_arg(Args, unsigned long) : va_arg(Args, unsigned int);
+
+				len = UToStr(v, *p == 'u' ? 10 : 16, *p == 'X', body);
+				Emit(&out, 0, body, len, width, flags);
+				break;
+			}
+			case 'c':
+			{
+				body[0] = (char)va_arg(Args, int);
+				Emit(&out, 0, body, 1, width, flags & ~FLAG_ZERO);
+				break;
+			}
+			case 's':
+			{
+				const char *s = va_arg(Args, const char *);
+
+				if(s == NULL) s = "(null)";
+
+				for(len = 0; s[len] != '\0' && (precision < 0 || len < precision); len++);
+
+				Emit(&out, 0, s, len, width, flags & ~FLAG_ZERO);
+				break;
+			}
+			case 'f':
+			{
+				uint8_t neg;
+
+				if(precision < 0) precision = 6;
+				if(precision > FMT_MAX_PRECISION) precision = FMT_MAX_PRECISION;
+
+				len = FloatToStr((float)va_arg(Args, double), precision, body, &neg);
+
+				sign = neg ? '-' : (flags & FLAG_PLUS) ? '+' : (flags & FLAG_SPACE) ? ' ' : 0;
+
+				if(body[0] == 'n' || body[0] == 'i') flags &= ~FLAG_ZERO; // nan和inf不用0填充
+
+				Emit(&out, sign, body, len, width, flags);
+				break;
+			}
+			case '%':
+			{
+				Put(&out, '%');
+				break;
+			}
+			default: // 不支持的转换原样输出
+			{
+				Put(&out, '%');
+				if(*p == '\0') p--; else Put(&out, *p);
+				break;
+			}
+		}
+	}
+
+	if(Size > 0) pBuffer[out.Len] = '\0';
+
+	return out.Len;
+}
+
+static void Put(Out_TypeDef *Out, char C)
+{
+	if(Out->Len + 1 < Out->Size)
+	{
+		Out->pBuffer[Out->Len++] = C;
+	}
+}
+
+static void Pad(Out_TypeDef *Out, char C, int Count)
+{
+	while(Count-- > 0) Put(Out, C);
+}
+
+//
+// @简介：输出一个转换的结果，处理符号、宽度和对齐
+//
+static void Emit(Out_TypeDef *Out, char Sign, const char *pBody, int BodyLen, int Width, uint8_t Flags)
+{
+	int pad = Width - BodyLen - (Sign ? 1 : 0);
+
+	if(!(Flags & FLAG_LEFT) && !(Flags & FLAG_ZERO)) Pad(Out, ' ', pad);
+	if(Sign) Put(Out, Sign);
+	if(!(Flags & FLAG_LEFT) && (Flags & FLAG_ZERO)) Pad(Out, '0', pad);
+
+	for(int i = 0; i < BodyLen; i++) Put(Out, pBody[i]);
+
+	if(Flags & FLAG_LEFT) Pad(Out, ' ', pad);
+}
+
+//
+// @简介：无符号整数转换为字符串（不含'\0'）
+// @返回值：字符数
+//
+static uint8_t UToStr(uint64_t Value, uint8_t Base, uint8_t Upper, char *pOut)
+{
+	const char *digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	char tmp[20];
+	uint8_t n = 0;
+
+	// 32位以内的数用32位除法，避免调用64位除法的库函数
+	if(Value <= 0xffffffffUL)
+	{
+		uint32_t v = (uint32_t)Value;
+
+		do { tmp[n++] = digits[v % Base]; v /= Base; } while(v != 0);
+	}
+	else
+	{
+		do { tmp[n++] = digits[Value % Base]; Value /= Base; } while(Value != 0);
+	}
+
+	for(uint8_t i = 0; i < n; i++) pOut[i] = tmp[n - 1 - i];
+
+	return n;
+}
+
+//
+// @简介：float转换为定点小数的字符串（不含符号和'\0'）
+//        float的值为 m * 2^(e-23)，m为24位整数，据此用整数运算得到十进制表示
+// @参数：Precision - 小数位数，0..FMT_MAX_PRECISION
+// @参数：pNeg - 输出参数，是否为负数
+// @返回值：字符数
+//
+static uint8_t FloatToStr(float Value, uint8_t Precision, char *pOut, uint8_t *pNeg)
+{
+	union { float f; uint32_t u; } v;
+
+	v.f = Value;
+
+	uint32_t exp = (v.u >> 23) & 0xff;
+	uint32_t m = v.u & 0x7fffff;
+	uint8_t n = 0;
+
+	*pNeg = v.u >> 31;
+
+	if(exp == 0xff)
+	{
+		const char *s = m ? "nan" : "inf";
+
+		for(n = 0; n < 3; n++) pOut[n] = s[n];
+
+		return n;
+	}
+
+	int shift;
+
+	if(exp == 0) shift = -126 - 23;                 // 非规格化数
+	else { m |= 0x800000; shift = (int)exp - 127 - 23; }
+
+	uint64_t ip;      // 整数部分
+	uint32_t fp = 0;  // 小数部分乘以10^Precision
+
+	if(shift >= 0)
+	{
+		if(shift <= 40)
+		{
+			ip = (uint64_t)m << shift;
+		}
+		else
+		{
+			// 超过64位的整数，以10^9为基数的大数逐次乘2
+			uint32_t limbs[5] = {m, 0, 0, 0, 0};
+			uint8_t numLimbs = 1;
+
+			for(int i = 0; i < shift; i++)
+			{
+				uint32_t carry = 0;
+
+				for(uint8_t k = 0; k < numLimbs; k++)
+				{
+					uint32_t x = limbs[k] * 2 + carry;
+
+					carry = x >= 1000000000 ? 1 : 0;
+					limbs[k] = x - carry * 1000000000;
+				}
+
+				if(carry) limbs[numLimbs++] = carry;
+			}
+
+			n = UToStr(limbs[numLimbs - 1], 10, 0, pOut);
+
+			for(int k = numLimbs - 2; k >= 0; k--)
+			{
+				uint32_t x = limbs[k];
+
+				for(int d = 8; d >= 0; d--) { pOut[n + d] = '0' + x % 10; x /= 10; }
+
+				n += 9;
+			}
+
+			ip = 0;
+		}
+	}
+	else
+	{
+		// 乘以10^Precision后右移，恰为一半时向偶数舍入
+		int s = -shift;
+		uint64_t x = (uint64_t)m * pow10[Precision];
+		uint64_t q = s < 64 ? x >> s : 0;
+
+		if(s <= 64)
+		{
+			uint64_t half = (uint64_t)1 << (s - 1);
+			uint64_t rem = x & ((half << 1) - 1);
+
+			if(rem > half || (rem == half && (q & 1))) q++;
+		}
+
+		ip = q / pow10[Precision];
+		fp = (uint32_t)(q - ip * pow10[Precision]);
+	}
+
+	if(n == 0) n = UToStr(ip, 10, 0, pOut);
+
+	if(Precision > 0)
+	{
+		pOut[n++] = '.';
+
+		for(int d = Precision - 1; d >= 0; d--) { pOut[n + d] = '0' + fp % 10; fp /= 10; }
+
+		n += Precision;
+	}
+
+	return n;
+}
@@ -0,0 +1,29 @@
+/**
+  ******************************************************************************
+  * @file    fmt.h
+  * @version V 1.0.0
+  * @brief   精简的格式化输出，代替vsprintf
+  *          只支持固定的功能：%d %i %u %x %X %c %s %f %%，以及
+  *            标志     - 左对齐，0 用0填充，+ 正数加+号，空格 正数加空格
+  *            宽度     - 数字或*
+  *            精度     - 仅%f（小数位数，默认6，最多9）和%s（最多输出的字符数），数字或*
+  *            长度     - l（long），其余忽略
+  *          %f按float的精度用整数运算完成（按IEEE 754的位直接换算），除了把可变参数中的double
+  *          转换为float以外不做浮点运算，舍入方式与C库相同（恰为一半时向偶数舍入）。
+  *          不分配内存，输出到调用者提供的缓冲区
+  ******************************************************************************
+  */
+
+#ifndef _FMT_H_
+#define _FMT_H_
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#define FMT_MAX_PRECISION 9
+
+int Fmt_Format(char *pBuffer, uint16_t Size, const char *Format, ...);
+int Fmt_VFormat(char *pBuffer, uint16_t Size, const char *Format, va_list Args);
+
+#endif
@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    hist.c
+  * @version V 1.0.0
+  * @brief   等宽直方图
+  ******************************************************************************
+  */
+
+#include "hist.h"
+
+//
+// @简介：初始化
+// @参数：NumBins - 桶数，超过HIST_MAX_BINS时按HIST_MAX_BINS
+// @参数：BinWidth - 桶宽，不能为0
+//
+void Hist_Init(Hist_TypeDef *Hist, uint16_t NumBins, uint32_t BinWidth)
+{
+	if(NumBins == 0) NumBins = 1;
+	if(NumBins > HIST_MAX_BINS) NumBins = HIST_MAX_BINS;
+	
+	Hist->NumBins = NumBins;
+	Hist->BinWidth = BinWidth;
+	
+	Hist_Reset(Hist);
+}
+
+//
+// @简介：清空样本，桶数和桶宽不变
+//
+void Hist_Reset(Hist_TypeDef *Hist)
+{
+	for(uint16_t i=0; i<HIST_MAX_BINS; i++)
+	{
+		Hist->Bins[i] = 0;
+	}
+	
+	Hist->N = 0;
+	Hist->Max = 0;
+}
+
+//
+// @简介：加入一个样本
+//
+void Hist_Add(Hist_TypeDef *Hist, uint32_t x)
+{
+	uint32_t k = x / Hist->BinWidth;
+	
+	if(k >= Hist->NumBins) k = Hist->NumBins - 1;
+	
+	Hist->Bins[k]++;
+	Hist->N++;
+	
+	if(x > Hist->Max) Hist->Max = x;
+}
+
+//
+// @简介：百分位数，即不超过它的样本占Percent%
+// @参数：Percent - 0..100
+// @返回值：所在桶的上边界，不超过最大值；没有样本时返回0
+//
+uint32_t Hist_GetPercentile(const Hist_TypeDef *Hist, uint8_t Percent)
+{
+	if(Hist->N == 0) return 0;
+	
+	uint64_t target = (uint64_t)Hist->N * Percent; // 与累计样本数*100比较，避免浮点运算
+	uint64_t count = 0;
+	uint16_t k;
+	
+	for(k=0; k<Hist->NumBins - 1; k++)
+	{
+		count += Hist->Bins[k];
+		
+		if(count * 100 >= target) break;
+	}
+	
+	uint64_t upper = (uint64_t)(k + 1) * Hist->BinWidth; // 桶宽很大时超过32位
+	
+	return (k == Hist->NumBins - 1 || upper > Hist->Max) ? Hist->Max : (uint32_t)upper;
+}
@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file    hist.h
+  * @version V 1.0.0
+  * @brief   等宽直方图，统计整数样本（如延迟）的分布，不保存样本。
+  *          第k个桶统计[k*BinWidth, (k+1)*BinWidth)内的样本，最后一个桶还包括更大的样本，
+  *          另外记录最大值，百分位数按桶的上边界给出，精度为一个桶宽
+  ******************************************************************************
+  */
+
+#ifndef _HIST_H_
+#define _HIST_H_
+
+#include <stdint.h>
+
+#define HIST_MAX_BINS 32
+
+typedef struct
+{
+	uint32_t Bins[HIST_MAX_BINS]; // 各桶的样本数
+	uint16_t NumBins;             // 使用的桶数，1..HIST_MAX_BINS
+	uint32_t BinWidth;            // 桶宽
+	uint32_t N;                   // 样本数
+	uint32_t Max;                 // 最大值
+} Hist_TypeDef;
+
+    void Hist_Init(Hist_TypeDef *Hist, uint16_t NumBins, uint32_t BinWidth);
+    void Hist_Reset(Hist_TypeDef *Hist);
+    void Hist_Add(Hist_TypeDef *Hist, uint32_t x);
+uint32_t Hist_GetPercentile(const Hist_TypeDef *Hist, uint8_t Percent);
+
+#endif
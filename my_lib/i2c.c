@@ -1,427 +1,664 @@
-/**
-  ******************************************************************************
-  * @file    i2c.c
-  * @author  铁头山羊
-  * @version V 1.0.0
-  * @date    2024年9月3日
-  * @brief   i2c驱动源文件
-  ******************************************************************************
-  */
-#include "i2c.h"
-
-//
-// @简介：通过I2C向从机写入多个字节
-// 
-// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
-// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
-// @参数 pData：要发送的数据（数组）
-// @参数 Size：要发送的数据的数量，以字节为单位
-//
-// @返回值：0 - 发送成功， -1 - 寻址失败， -2 - 数据被拒收
-//
-__weak int My_I2C_SendBytes(I2C_TypeDef *I2Cx, uint8_t Addr, const uint8_t *pData, uint16_t Size)
-{
-	// #1. 等待总线空闲
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
-	
-	// #2. 发送起始位
-	I2C_GenerateSTART(I2Cx, ENABLE);
-	
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
-	
-	// #3. 寻址阶段
-	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
-	
-	I2C_SendData(I2Cx, Addr & 0xfe);
-	
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
-		{
-			break;
-		}
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-			I2C_GenerateSTOP(I2Cx, ENABLE);
-			return -1; // 寻址失败
-		}
-	}
-	
-	// 清除ADDR
-	I2C_ReadRegister(I2Cx, I2C_Register_SR1);
-	I2C_ReadRegister(I2Cx, I2C_Register_SR2);
-	
-	// #4. 发送数据
-	for(uint16_t i=0; i<Size; i++)
-	{
-		while(1)
-		{
-			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-			{
-				I2C_GenerateSTOP(I2Cx, ENABLE);
-				return -2; // 数据被拒收
-			}
-			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
-			{
-				break;
-			}
-		}
-		
-		I2C_SendData(I2Cx, pData[i]);
-	}
-	
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-				I2C_GenerateSTOP(I2Cx, ENABLE);
-				return -2; // 数据被拒收			
-		}
-		
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BTF) == SET)
-		{
-			break;
-		}
-	}
-	
-	// #5. 发送停止位
-	I2C_GenerateSTOP(I2Cx, ENABLE);
-	return 0; // 成功
-}
-
-
-//
-// @简介：通过I2C从从机读多个字节
-// 
-// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
-// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
-// @参数 pBuffer：接收缓冲区（数组）
-// @参数 Size：要读取的数据的数量，以字节为单位
-//
-// @返回值：0 - 发送成功， -1 - 寻址失败
-//
-__weak int My_I2C_ReceiveBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t *pBuffer, uint16_t Size)
-{
-	if(Size == 0) return 0;
-	
-	// #1. 等待总线空闲
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
-	
-	// #2. 发送起始位
-	I2C_GenerateSTART(I2Cx, ENABLE);
-	
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
-	
-	// #3. 寻址阶段
-	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
-	
-	I2C_SendData(I2Cx, Addr | 0x01);
-	
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
-		{
-			break;
-		}
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-			I2C_GenerateSTOP(I2Cx, ENABLE);
-			return -1; // 寻址失败
-		}
-	}
-	
-	// #4. 数据读取
-	if(Size == 1)
-	{
-		// 向ACK写0
-		I2C_AcknowledgeConfig(I2Cx, DISABLE);
-		
-		// 清除ADDR
-		__disable_irq();
-		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
-		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
-		
-		// 发送停止位
-		I2C_GenerateSTOP(I2Cx, ENABLE);
-		__enable_irq();
-		// 等待RxNE置位
-		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
-		// 读取数据
-		pBuffer[0] = I2C_ReceiveData(I2Cx);
-	}
-	else
-	{
-		// 向ACK写1
-		I2C_AcknowledgeConfig(I2Cx, ENABLE);
-		
-		// 清除ADDR
-		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
-		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
-		
-		for(uint16_t i=0; i<Size-1; i++)
-		{
-			if(i==Size-2)
-			{
-				__disable_irq();
-			}
-			// 等待RxNE置位
-			while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
-			// 读取
-			pBuffer[i] = I2C_ReceiveData(I2Cx);
-		}
-		
-		// 向ACK写0
-		I2C_AcknowledgeConfig(I2Cx, DISABLE);
-		// 发送停止位
-		I2C_GenerateSTOP(I2Cx, ENABLE);
-		
-		__enable_irq();
-		
-		// 等待RxNE置位
-		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
-		pBuffer[Size-1] = I2C_ReceiveData(I2Cx);
-	}
-	
-	return 0;
-}
-
-
-//
-// @简介：通过I2C从寄存器读取数据
-// 
-// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
-// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
-// @参数 Reg： 寄存器地址
-// @参数 pBuffer：接收缓冲区（数组）
-// @参数 Size：要读取的数据的数量，以字节为单位
-//
-// @返回值：0 - 接收成功， -1 - 寻址失败
-//
-__weak int My_I2C_RegReadBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size)
-{
-	if(Size == 0) return 0;
-	
-	// #1. 等待总线空闲
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
-	
-	// #2. 发送起始位
-	I2C_GenerateSTART(I2Cx, ENABLE);
-	
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
-	
-	// #3. 寻址阶段
-	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
-	I2C_SendData(I2Cx, Addr & 0xfe);
-	
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
-		{
-			break;
-		}
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-			I2C_GenerateSTOP(I2Cx, ENABLE);
-			return -1; // 寻址失败
-		}
-	}
-	
-	// 清除ADDR
-	I2C_ReadRegister(I2Cx, I2C_Register_SR1);
-	I2C_ReadRegister(I2Cx, I2C_Register_SR2);
-	
-	// #4. 发送寄存器地址
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == RESET){}
-	
-	I2C_SendData(I2Cx, Reg);
-		
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-			I2C_GenerateSTOP(I2Cx, ENABLE);
-			return -2; // 数据被拒收
-		}
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
-		{
-			break;
-		}
-	}
-	
-	// #5. 发送重复起始位
-	I2C_GenerateSTART(I2Cx, ENABLE);
-	
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
-	
-	// #6. 再次发送地址
-	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
-	I2C_SendData(I2Cx, Addr | 0x01);
-	
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
-		{
-			break;
-		}
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-			I2C_GenerateSTOP(I2Cx, ENABLE);
-			return -1; // 寻址失败
-		}
-	}
-
-	// #4. 数据读取
-	if(Size == 1)
-	{
-		// 向ACK写0
-		I2C_AcknowledgeConfig(I2Cx, DISABLE);
-		
-		// 清除ADDR
-		__disable_irq();
-		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
-		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
-		
-		// 发送停止位
-		I2C_GenerateSTOP(I2Cx, ENABLE);
-		__enable_irq();
-		// 等待RxNE置位
-		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
-		// 读取数据
-		pBuffer[0] = I2C_ReceiveData(I2Cx);
-	}
-	else
-	{
-		// 向ACK写1
-		I2C_AcknowledgeConfig(I2Cx, ENABLE);
-		
-		// 清除ADDR
-		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
-		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
-		
-		for(uint16_t i=0; i<Size-1; i++)
-		{
-			if(i==Size-2)
-			{
-				__disable_irq();
-			}
-			// 等待RxNE置位
-			while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
-			// 读取
-			pBuffer[i] = I2C_ReceiveData(I2Cx);
-		}
-		
-		// 向ACK写0
-		I2C_AcknowledgeConfig(I2Cx, DISABLE);
-		// 发送停止位
-		I2C_GenerateSTOP(I2Cx, ENABLE);
-		
-		__enable_irq();
-		
-		// 等待RxNE置位
-		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
-		pBuffer[Size-1] = I2C_ReceiveData(I2Cx);
-	}
-	
-	return 0;
-}
-
-//
-// @简介：通过I2C向寄存器写入数据
-// 
-// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
-// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
-// @参数 Reg： 寄存器地址
-// @参数 pData：要发送的数据（数组）
-// @参数 Size：要发送的数据的数量，以字节为单位
-//
-// @返回值：0 - 发送成功， -1 - 寻址失败， -2 - 数据被拒收
-//
-int My_I2C_MemWriteBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, const uint8_t *pData, uint16_t Size)
-{
-	if(Size == 0) return 0;
-	
-	// #1. 等待总线空闲
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
-	
-	// #2. 发送起始位
-	I2C_GenerateSTART(I2Cx, ENABLE);
-	
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
-	
-	// #3. 寻址阶段
-	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
-	I2C_SendData(I2Cx, Addr & 0xfe);
-	
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
-		{
-			break;
-		}
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-			I2C_GenerateSTOP(I2Cx, ENABLE);
-			return -1; // 寻址失败
-		}
-	}
-	
-	// 清除ADDR
-	I2C_ReadRegister(I2Cx, I2C_Register_SR1);
-	I2C_ReadRegister(I2Cx, I2C_Register_SR2);
-	
-	// #4. 发送寄存器地址
-	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == RESET){}
-	
-	I2C_SendData(I2Cx, Reg);	
-		
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-			I2C_GenerateSTOP(I2Cx, ENABLE);
-			return -2; // 数据被拒收
-		}
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
-		{
-			break;
-		}
-	}
-		
-	// #5. 发送数据
-	for(uint16_t i=0; i<Size; i++)
-	{
-		while(1)
-		{
-			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-			{
-				I2C_GenerateSTOP(I2Cx, ENABLE);
-				return -2; // 数据被拒收
-			}
-			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
-			{
-				break;
-			}
-		}
-		
-		I2C_SendData(I2Cx, pData[i]);
-	}
-	
-	// #6. 等待BTF
-	while(1)
-	{
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
-		{
-				I2C_GenerateSTOP(I2Cx, ENABLE);
-				return -2; // 数据被拒收			
-		}
-		
-		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BTF) == SET)
-		{
-			break;
-		}
-	}
-	
-	// #5. 发送停止位
-	I2C_GenerateSTOP(I2Cx, ENABLE);
-	return 0; // 成功
-}
+/**
+  ******************************************************************************
+  * @file    i2c.c
+  * @author  铁头山羊
+  * @version V 1.0.0
+  * @date    2024年9月3日
+  * @brief   i2c驱动源文件
+  ******************************************************************************
+  */
+#include "i2c.h"
+
+//
+// @简介：通过I2C向从机写入多个字节
+// 
+// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
+// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
+// @参数 pData：要发送的数据（数组）
+// @参数 Size：要发送的数据的数量，以字节为单位
+//
+// @返回值：0 - 发送成功， -1 - 寻址失败， -2 - 数据被拒收
+//
+__weak int My_I2C_SendBytes(I2C_TypeDef *I2Cx, uint8_t Addr, const uint8_t *pData, uint16_t Size)
+{
+	// #1. 等待总线空闲
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
+	
+	// #2. 发送起始位
+	I2C_GenerateSTART(I2Cx, ENABLE);
+	
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
+	
+	// #3. 寻址阶段
+	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
+	
+	I2C_SendData(I2Cx, Addr & 0xfe);
+	
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
+		{
+			break;
+		}
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+			return -1; // 寻址失败
+		}
+	}
+	
+	// 清除ADDR
+	I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+	I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+	
+	// #4. 发送数据
+	for(uint16_t i=0; i<Size; i++)
+	{
+		while(1)
+		{
+			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+			{
+				I2C_GenerateSTOP(I2Cx, ENABLE);
+				return -2; // 数据被拒收
+			}
+			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
+			{
+				break;
+			}
+		}
+		
+		I2C_SendData(I2Cx, pData[i]);
+	}
+	
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+				I2C_GenerateSTOP(I2Cx, ENABLE);
+				return -2; // 数据被拒收			
+		}
+		
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BTF) == SET)
+		{
+			break;
+		}
+	}
+	
+	// #5. 发送停止位
+	I2C_GenerateSTOP(I2Cx, ENABLE);
+	return 0; // 成功
+}
+
+
+//
+// @简介：通过I2C从从机读多个字节
+// 
+// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
+// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
+// @参数 pBuffer：接收缓冲区（数组）
+// @参数 Size：要读取的数据的数量，以字节为单位
+//
+// @返回值：0 - 发送成功， -1 - 寻址失败
+//
+__weak int My_I2C_ReceiveBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t *pBuffer, uint16_t Size)
+{
+	if(Size == 0) return 0;
+	
+	// #1. 等待总线空闲
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
+	
+	// #2. 发送起始位
+	I2C_GenerateSTART(I2Cx, ENABLE);
+	
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
+	
+	// #3. 寻址阶段
+	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
+	
+	I2C_SendData(I2Cx, Addr | 0x01);
+	
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
+		{
+			break;
+		}
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+			return -1; // 寻址失败
+		}
+	}
+	
+	// #4. 数据读取
+	if(Size == 1)
+	{
+		// 向ACK写0
+		I2C_AcknowledgeConfig(I2Cx, DISABLE);
+		
+		// 清除ADDR
+		__disable_irq();
+		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+		
+		// 发送停止位
+		I2C_GenerateSTOP(I2Cx, ENABLE);
+		__enable_irq();
+		// 等待RxNE置位
+		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
+		// 读取数据
+		pBuffer[0] = I2C_ReceiveData(I2Cx);
+	}
+	else
+	{
+		// 向ACK写1
+		I2C_AcknowledgeConfig(I2Cx, ENABLE);
+		
+		// 清除ADDR
+		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+		
+		for(uint16_t i=0; i<Size-1; i++)
+		{
+			if(i==Size-2)
+			{
+				__disable_irq();
+			}
+			// 等待RxNE置位
+			while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
+			// 读取
+			pBuffer[i] = I2C_ReceiveData(I2Cx);
+		}
+		
+		// 向ACK写0
+		I2C_AcknowledgeConfig(I2Cx, DISABLE);
+		// 发送停止位
+		I2C_GenerateSTOP(I2Cx, ENABLE);
+		
+		__enable_irq();
+		
+		// 等待RxNE置位
+		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
+		pBuffer[Size-1] = I2C_ReceiveData(I2Cx);
+	}
+	
+	return 0;
+}
+
+
+//
+// @简介：通过I2C从寄存器读取数据
+// 
+// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
+// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
+// @参数 Reg： 寄存器地址
+// @参数 pBuffer：接收缓冲区（数组）
+// @参数 Size：要读取的数据的数量，以字节为单位
+//
+// @返回值：0 - 接收成功， -1 - 寻址失败
+//
+__weak int My_I2C_RegReadBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size)
+{
+	if(Size == 0) return 0;
+	
+	// #1. 等待总线空闲
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
+	
+	// #2. 发送起始位
+	I2C_GenerateSTART(I2Cx, ENABLE);
+	
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
+	
+	// #3. 寻址阶段
+	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
+	I2C_SendData(I2Cx, Addr & 0xfe);
+	
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
+		{
+			break;
+		}
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+			return -1; // 寻址失败
+		}
+	}
+	
+	// 清除ADDR
+	I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+	I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+	
+	// #4. 发送寄存器地址
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == RESET){}
+	
+	I2C_SendData(I2Cx, Reg);
+		
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+			return -2; // 数据被拒收
+		}
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
+		{
+			break;
+		}
+	}
+	
+	// #5. 发送重复起始位
+	I2C_GenerateSTART(I2Cx, ENABLE);
+	
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
+	
+	// #6. 再次发送地址
+	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
+	I2C_SendData(I2Cx, Addr | 0x01);
+	
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
+		{
+			break;
+		}
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+			return -1; // 寻址失败
+		}
+	}
+
+	// #4. 数据读取
+	if(Size == 1)
+	{
+		// 向ACK写0
+		I2C_AcknowledgeConfig(I2Cx, DISABLE);
+		
+		// 清除ADDR
+		__disable_irq();
+		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+		
+		// 发送停止位
+		I2C_GenerateSTOP(I2Cx, ENABLE);
+		__enable_irq();
+		// 等待RxNE置位
+		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
+		// 读取数据
+		pBuffer[0] = I2C_ReceiveData(I2Cx);
+	}
+	else
+	{
+		// 向ACK写1
+		I2C_AcknowledgeConfig(I2Cx, ENABLE);
+		
+		// 清除ADDR
+		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+		
+		for(uint16_t i=0; i<Size-1; i++)
+		{
+			if(i==Size-2)
+			{
+				__disable_irq();
+			}
+			// 等待RxNE置位
+			while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
+			// 读取
+			pBuffer[i] = I2C_ReceiveData(I2Cx);
+		}
+		
+		// 向ACK写0
+		I2C_AcknowledgeConfig(I2Cx, DISABLE);
+		// 发送停止位
+		I2C_GenerateSTOP(I2Cx, ENABLE);
+		
+		__enable_irq();
+		
+		// 等待RxNE置位
+		while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET);
+		pBuffer[Size-1] = I2C_ReceiveData(I2Cx);
+	}
+	
+	return 0;
+}
+
+//
+// @简介：通过I2C向寄存器写入数据
+// 
+// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2
+// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
+// @参数 Reg： 寄存器地址
+// @参数 pData：要发送的数据（数组）
+// @参数 Size：要发送的数据的数量，以字节为单位
+//
+// @返回值：0 - 发送成功， -1 - 寻址失败， -2 - 数据被拒收
+//
+__weak int My_I2C_RegWriteBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, const uint8_t *pData, uint16_t Size)
+{
+	if(Size == 0) return 0;
+	
+	// #1. 等待总线空闲
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET);
+	
+	// #2. 发送起始位
+	I2C_GenerateSTART(I2Cx, ENABLE);
+	
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET);
+	
+	// #3. 寻址阶段
+	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
+	I2C_SendData(I2Cx, Addr & 0xfe);
+	
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == SET)
+		{
+			break;
+		}
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+			return -1; // 寻址失败
+		}
+	}
+	
+	// 清除ADDR
+	I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+	I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+	
+	// #4. 发送寄存器地址
+	while(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == RESET){}
+	
+	I2C_SendData(I2Cx, Reg);	
+		
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+			return -2; // 数据被拒收
+		}
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
+		{
+			break;
+		}
+	}
+		
+	// #5. 发送数据
+	for(uint16_t i=0; i<Size; i++)
+	{
+		while(1)
+		{
+			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+			{
+				I2C_GenerateSTOP(I2Cx, ENABLE);
+				return -2; // 数据被拒收
+			}
+			if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_TXE) == SET)
+			{
+				break;
+			}
+		}
+		
+		I2C_SendData(I2Cx, pData[i]);
+	}
+	
+	// #6. 等待BTF
+	while(1)
+	{
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+		{
+				I2C_GenerateSTOP(I2Cx, ENABLE);
+				return -2; // 数据被拒收			
+		}
+		
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BTF) == SET)
+		{
+			break;
+		}
+	}
+	
+	// #5. 发送停止位
+	I2C_GenerateSTOP(I2Cx, ENABLE);
+	return 0; // 成功
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 中断方式的寄存器读取
+// 每个事件由中断推进一步，CPU只在起始位、地址、寄存器地址和每个接收字节处各进一次中断，
+// 不必等待总线。没有使用DMA，是因为I2C1的接收通道DMA1_Channel7已被编码器的边沿捕获占用。
+// 接收倒数第二个字节时须在下一个字节的应答位之前（400kHz下约22us）关闭ACK并设置STOP，
+// 因此事件中断的抢占优先级应为最高，否则从机会多发送一个字节
+//////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	XFER_IDLE = 0,
+	XFER_START,    // 等待起始位（SB）
+	XFER_ADDR_W,   // 等待写地址的应答（ADDR）
+	XFER_REG,      // 等待寄存器地址发送完毕（BTF）
+	XFER_RESTART,  // 等待重复起始位（SB）
+	XFER_ADDR_R,   // 等待读地址的应答（ADDR）
+	XFER_RX,       // 接收数据（RXNE）
+};
+
+static void XferEnd(I2C_XferTypeDef *Xfer, int8_t Result);
+
+//
+// @简介：初始化传输句柄，并使能I2C的事件和错误中断
+// 
+// @参数 Xfer：传输句柄
+// @参数 I2Cx：填写要操作的I2C的名称，可以是I2C1或I2C2，须已完成引脚、时钟和速率的配置
+// @参数 NVIC_IRQChannelPreemptionPriority：事件和错误中断的抢占优先级，应为最高（见上）
+//
+// @注意：中断在传输期间才由I2C_ITConfig打开，因此阻塞方式的读写函数仍然可以在传输之间使用
+//
+void My_I2C_XferInit(I2C_XferTypeDef *Xfer, I2C_TypeDef *I2Cx, uint8_t NVIC_IRQChannelPreemptionPriority)
+{
+	NVIC_InitTypeDef NVIC_InitStruct = {0};
+	
+	Xfer->I2Cx = I2Cx;
+	Xfer->State = XFER_IDLE;
+	Xfer->Result = I2C_XFER_OK;
+	
+	I2C_ITConfig(I2Cx, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+	
+	NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = NVIC_IRQChannelPreemptionPriority;
+	NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+	
+	NVIC_InitStruct.NVIC_IRQChannel = I2Cx == I2C1 ? I2C1_EV_IRQn : I2C2_EV_IRQn;
+	NVIC_Init(&NVIC_InitStruct);
+	
+	NVIC_InitStruct.NVIC_IRQChannel = I2Cx == I2C1 ? I2C1_ER_IRQn : I2C2_ER_IRQn;
+	NVIC_Init(&NVIC_InitStruct);
+}
+
+//
+// @简介：开始从寄存器读取数据，立即返回，由中断完成传输
+// 
+// @参数 Xfer：传输句柄
+// @参数 Addr：填写从机的地址，左对齐 - A6 A5 A4 A3 A2 A1 A0 0
+// @参数 Reg： 寄存器地址
+// @参数 pBuffer：接收缓冲区（数组），传输结束前不能改动
+// @参数 Size：要读取的数据的数量，以字节为单位，不能为0
+//
+// @返回值：0 - 已开始，之后用My_I2C_GetResult查询结果， -1 - 上一个传输尚未结束或总线忙
+//
+int My_I2C_RegReadBytes_IT(I2C_XferTypeDef *Xfer, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size)
+{
+	I2C_TypeDef *I2Cx = Xfer->I2Cx;
+	
+	if(Xfer->State != XFER_IDLE || Size == 0) return -1;
+	
+	if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BUSY) == SET) return -1; // 例如上一次的停止位还没有发完
+	
+	Xfer->Addr = Addr;
+	Xfer->Reg = Reg;
+	Xfer->pBuffer = pBuffer;
+	Xfer->Size = Size;
+	Xfer->Count = 0;
+	Xfer->Result = I2C_XFER_BUSY;
+	Xfer->State = XFER_START;
+	
+	I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
+	I2C_ITConfig(I2Cx, I2C_IT_EVT | I2C_IT_ERR, ENABLE); // 接收数据时才打开缓冲区中断
+	
+	I2C_GenerateSTART(I2Cx, ENABLE);
+	
+	return 0;
+}
+
+//
+// @简介：查询最近一次传输的结果
+// @返回值：I2C_XFER_BUSY - 进行中，I2C_XFER_OK - 成功，其余见I2C_XFER_xxx
+//
+int8_t My_I2C_GetResult(I2C_XferTypeDef *Xfer)
+{
+	return Xfer->Result;
+}
+
+//
+// @简介：中止进行中的传输（例如超时），发送停止位，结果为I2C_XFER_ABORTED
+//
+void My_I2C_AbortIT(I2C_XferTypeDef *Xfer)
+{
+	__disable_irq();
+	
+	if(Xfer->State != XFER_IDLE)
+	{
+		I2C_GenerateSTOP(Xfer->I2Cx, ENABLE);
+		XferEnd(Xfer, I2C_XFER_ABORTED);
+	}
+	
+	__enable_irq();
+}
+
+//
+// @简介：事件中断，在I2Cx_EV_IRQHandler中调用
+//
+void My_I2C_EV_IRQHandler(I2C_XferTypeDef *Xfer)
+{
+	I2C_TypeDef *I2Cx = Xfer->I2Cx;
+	
+	switch(Xfer->State)
+	{
+	case XFER_START: // #1. 起始位已发出，发送写地址
+	case XFER_RESTART: // #4. 重复起始位已发出，发送读地址
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_SB) == RESET) return;
+		
+		if(Xfer->State == XFER_START)
+		{
+			I2C_SendData(I2Cx, Xfer->Addr & 0xfe);
+			Xfer->State = XFER_ADDR_W;
+		}
+		else
+		{
+			I2C_SendData(I2Cx, Xfer->Addr | 0x01);
+			Xfer->State = XFER_ADDR_R;
+		}
+		break;
+		
+	case XFER_ADDR_W: // #2. 从机应答，清除ADDR并发送寄存器地址
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == RESET) return;
+		
+		I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+		I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+		
+		I2C_SendData(I2Cx, Xfer->Reg);
+		Xfer->State = XFER_REG;
+		break;
+		
+	case XFER_REG: // #3. 寄存器地址已发出，发送重复起始位（同时清除BTF）
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_BTF) == RESET) return;
+		
+		I2C_GenerateSTART(I2Cx, ENABLE);
+		Xfer->State = XFER_RESTART;
+		break;
+		
+	case XFER_ADDR_R: // #5. 从机应答，设置ACK后清除ADDR，开始接收
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_ADDR) == RESET) return;
+		
+		if(Xfer->Size == 1)
+		{
+			// 只有一个字节：清除ADDR之前向ACK写0，清除之后立即发送停止位
+			I2C_AcknowledgeConfig(I2Cx, DISABLE);
+			I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+			I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+		}
+		else
+		{
+			I2C_AcknowledgeConfig(I2Cx, ENABLE);
+			I2C_ReadRegister(I2Cx, I2C_Register_SR1);
+			I2C_ReadRegister(I2Cx, I2C_Register_SR2);
+		}
+		
+		Xfer->State = XFER_RX;
+		I2C_ITConfig(I2Cx, I2C_IT_BUF, ENABLE);
+		break;
+		
+	case XFER_RX: // #6. 逐字节读取
+		if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_RXNE) == RESET) return;
+		
+		// 正在接收的是最后一个字节，在它的应答位之前向ACK写0并设置停止位
+		if(Xfer->Count == Xfer->Size - 2)
+		{
+			I2C_AcknowledgeConfig(I2Cx, DISABLE);
+			I2C_GenerateSTOP(I2Cx, ENABLE);
+		}
+		
+		Xfer->pBuffer[Xfer->Count] = I2C_ReceiveData(I2Cx);
+		Xfer->Count++;
+		
+		if(Xfer->Count == Xfer->Size)
+		{
+			XferEnd(Xfer, I2C_XFER_OK);
+		}
+		break;
+		
+	default: // 没有传输时不应该有事件，关闭中断以免反复进入
+		I2C_ITConfig(I2Cx, I2C_IT_EVT | I2C_IT_BUF, DISABLE);
+		break;
+	}
+}
+
+//
+// @简介：错误中断，在I2Cx_ER_IRQHandler中调用
+//
+void My_I2C_ER_IRQHandler(I2C_XferTypeDef *Xfer)
+{
+	I2C_TypeDef *I2Cx = Xfer->I2Cx;
+	int8_t result = I2C_XFER_ABORTED; // 总线错误、仲裁丢失
+	
+	if(I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF) == SET)
+	{
+		result = Xfer->State == XFER_REG ? I2C_XFER_NACK : I2C_XFER_NOADDR;
+	}
+	
+	I2C_ClearFlag(I2Cx, I2C_FLAG_AF | I2C_FLAG_BERR | I2C_FLAG_ARLO);
+	I2C_GenerateSTOP(I2Cx, ENABLE);
+	
+	if(Xfer->State != XFER_IDLE)
+	{
+		XferEnd(Xfer, result);
+	}
+	else
+	{
+		I2C_ITConfig(I2Cx, I2C_IT_ERR, DISABLE);
+	}
+}
+
+//
+// @简介：结束传输，关闭中断并给出结果
+//
+static void XferEnd(I2C_XferTypeDef *Xfer, int8_t Result)
+{
+	I2C_ITConfig(Xfer->I2Cx, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+	
+	Xfer->State = XFER_IDLE;
+	Xfer->Result = Result;
+}
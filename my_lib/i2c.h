@@ -1,16 +1,51 @@
-/**
-  ******************************************************************************
-  * @file    i2c.h
-  * @author  铁头山羊
-  * @version V 1.0.0
-  * @date    2024年9月3日
-  * @brief   i2c驱动头文件
-  ******************************************************************************
-  */
-
-#include "stm32f10x.h"
-
-int My_I2C_SendBytes(I2C_TypeDef *I2Cx, uint8_t Addr, const uint8_t *pData, uint16_t Size);
-int My_I2C_ReceiveBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t *pBuffer, uint16_t Size);
-int My_I2C_RegReadBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size);
-int My_I2C_RegWriteBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, const uint8_t *pData, uint16_t Size);
+/**
+  ******************************************************************************
+  * @file    i2c.h
+  * @author  铁头山羊
+  * @version V 1.0.0
+  * @date    2024年9月3日
+  * @brief   i2c驱动头文件
+  ******************************************************************************
+  */
+
+#ifndef _I2C_H_
+#define _I2C_H_
+
+#include "stm32f10x.h"
+
+//
+// 中断方式的寄存器读取（My_I2C_RegReadBytes_IT），每个I2C一个句柄，同一时刻只能有一个传输
+//
+#define I2C_XFER_BUSY    1  // 传输进行中
+#define I2C_XFER_OK      0
+#define I2C_XFER_NOADDR  -1 // 寻址失败
+#define I2C_XFER_NACK    -2 // 寄存器地址被拒收
+#define I2C_XFER_ABORTED -3 // 被My_I2C_AbortIT中止，或者总线错误、仲裁丢失
+
+typedef struct
+{
+	I2C_TypeDef *I2Cx;         // 须已完成引脚、时钟和速率的配置
+	uint8_t Addr;              // 从机地址，左对齐
+	uint8_t Reg;               // 起始寄存器
+	uint8_t *pBuffer;
+	uint16_t Size;
+	volatile uint16_t Count;   // 已接收的字节数
+	volatile uint8_t State;    // 传输进行到哪一步，0表示空闲
+	volatile int8_t Result;    // 最近一次传输的结果，I2C_XFER_xxx
+} I2C_XferTypeDef;
+
+int My_I2C_SendBytes(I2C_TypeDef *I2Cx, uint8_t Addr, const uint8_t *pData, uint16_t Size);
+int My_I2C_ReceiveBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t *pBuffer, uint16_t Size);
+int My_I2C_RegReadBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size);
+int My_I2C_RegWriteBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, const uint8_t *pData, uint16_t Size);
+
+   void My_I2C_XferInit(I2C_XferTypeDef *Xfer, I2C_TypeDef *I2Cx, uint8_t NVIC_IRQChannelPreemptionPriority);
+    int My_I2C_RegReadBytes_IT(I2C_XferTypeDef *Xfer, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size);
+ int8_t My_I2C_GetResult(I2C_XferTypeDef *Xfer);
+   void My_I2C_AbortIT(I2C_XferTypeDef *Xfer);
+
+// 在对应的中断函数中调用
+   void My_I2C_EV_IRQHandler(I2C_XferTypeDef *Xfer);
+   void My_I2C_ER_IRQHandler(I2C_XferTypeDef *Xfer);
+
+#endif
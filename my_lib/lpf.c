@@ -1,50 +1,86 @@
-#include "lpf.h"
-
-//
-// @简介：初始化一阶低通滤波器
-//                                1
-//        低通滤波器的公式为 ----------
-//                            Tf*s + 1
-// @参数：Tf - 低通滤波器的时间常数
-//
-void LPF_Init(LPF_TypeDef *Lpf, float Tf)
-{
-	Lpf->Tf = Tf;
-	
-	Lpf->LastTime = 0xffffffffffffffff; // 0xffffffff表示低通滤波器从未计算过
-}
-
-//
-// @简介：计算低通滤波器的输出
-// @参数：Lpf - 低通滤波器
-// @参数：Input - 输入
-// @参数：now - 当前时间，单位us
-// @返回值：输入信号经由低通滤波器滤波后的结果
-//
-float LPF_Calc(LPF_TypeDef *Lpf, float Input, uint64_t now)
-{
-	float output;
-	
-	if(Lpf->LastTime == 0xffffffffffffffff)
-	{
-		output = Input; // 如果是第一次运算，那么将输入值直接输出出去
-	}
-	else
-	{
-		//          ------
-		//  r(t)   |  1   |  c(t)
-		// --- --> | ---- | ------>
-		//  - ^    | Tf*s |    |
-		//    |     ------     |
-		//     ----------------
-		// 
-		// 由框图可知 c(t) = c(t) + (r(t) - c(t)) * Δt / Tf 
-		float dt = (now - Lpf->LastTime) * 1e-6; // Δt
-		output = Lpf->LastOutput + (Input - Lpf->LastOutput) / Lpf->Tf *dt;
-	}
-	
-	Lpf->LastTime = now;
-	Lpf->LastOutput = output;
-	
-	return output;
-}
+#include "lpf.h"
+#include "delay.h"
+
+//
+// @简介：初始化一阶低通滤波器
+//                                1
+//        低通滤波器的公式为 ----------
+//                            Tf*s + 1
+// @参数：Tf - 低通滤波器的时间常数
+//
+void LPF_Init(LPF_TypeDef *Lpf, float Tf)
+{
+	Lpf->Tf = Tf;
+	
+	Lpf->FirstCompute = 1; // 标记低通滤波器从未计算过
+}
+
+//
+// @简介：计算低通滤波器的输出
+// @参数：Lpf - 低通滤波器
+// @参数：Input - 输入
+// @参数：now - 当前时间，单位us
+// @返回值：输入信号经由低通滤波器滤波后的结果
+//
+float LPF_Calc(LPF_TypeDef *Lpf, float Input, uint32_t now)
+{
+	float output;
+	
+	if(Lpf->FirstCompute)
+	{
+		Lpf->FirstCompute = 0;
+		output = Input; // 如果是第一次运算，那么将输入值直接输出出去
+	}
+	else
+	{
+		//          ------
+		//  r(t)   |  1   |  c(t)
+		// --- --> | ---- | ------>
+		//  - ^    | Tf*s |    |
+		//    |     ------     |
+		//     ----------------
+		// 
+		// 由框图可知 c(t) = c(t) + (r(t) - c(t)) * Δt / Tf 
+		float dt = Time_UsToSec(Time_Diff(now, Lpf->LastTime)); // Δt
+		output = Lpf->LastOutput + (Input - Lpf->LastOutput) / Lpf->Tf *dt;
+	}
+	
+	Lpf->LastTime = now;
+	Lpf->LastOutput = output;
+	
+	return output;
+}
+
+//
+// @简介：以固定周期初始化一阶低通滤波器
+//        离散系数Ts/Tf在此处预先算好，LPF_CalcFixedRate只需一次乘加
+// @参数：Tf - 低通滤波器的时间常数
+// @参数：Ts - 调用LPF_CalcFixedRate的周期，单位s
+//
+void LPF_InitFixedRate(LPF_TypeDef *Lpf, float Tf, float Ts)
+{
+	LPF_Init(Lpf, Tf);
+	
+	Lpf->Alpha = Ts / Tf;
+}
+
+//
+// @简介：以固定周期计算低通滤波器的输出，结果与周期为Ts时的LPF_Calc相同
+// @参数：Lpf - 低通滤波器
+// @参数：Input - 输入
+// @返回值：输入信号经由低通滤波器滤波后的结果
+//
+float LPF_CalcFixedRate(LPF_TypeDef *Lpf, float Input)
+{
+	if(Lpf->FirstCompute)
+	{
+		Lpf->FirstCompute = 0;
+		Lpf->LastOutput = Input;
+	}
+	else
+	{
+		Lpf->LastOutput += (Input - Lpf->LastOutput) * Lpf->Alpha;
+	}
+	
+	return Lpf->LastOutput;
+}
@@ -1,16 +1,20 @@
-#ifndef LPF_H
-#define LPF_H
-
-#include <stdint.h>
-
-typedef struct
-{
-	float Tf; // 低通滤波器的时间常数
-	float LastOutput;  // 上次低通滤波器的输出，用于迭代运算
-	uint64_t LastTime; // 上次计算的时间，用于计算Δt
-} LPF_TypeDef;
-
- void LPF_Init(LPF_TypeDef *Lpf, float Tf);
-float LPF_Calc(LPF_TypeDef *Lpf, float Input, uint64_t now);
-
-#endif
+#ifndef LPF_H
+#define LPF_H
+
+#include <stdint.h>
+
+typedef struct
+{
+	float Tf; // 低通滤波器的时间常数
+	float LastOutput;  // 上次低通滤波器的输出，用于迭代运算
+	uint32_t LastTime; // 上次计算的时间，用于计算Δt
+	uint8_t FirstCompute; // 1 - 低通滤波器从未计算过
+	float Alpha; // 固定周期下的离散系数 Ts/Tf，由LPF_InitFixedRate计算
+} LPF_TypeDef;
+
+ void LPF_Init(LPF_TypeDef *Lpf, float Tf);
+float LPF_Calc(LPF_TypeDef *Lpf, float Input, uint32_t now);
+ void LPF_InitFixedRate(LPF_TypeDef *Lpf, float Tf, float Ts);
+float LPF_CalcFixedRate(LPF_TypeDef *Lpf, float Input);
+
+#endif
@@ -0,0 +1,86 @@
+/**
+  ******************************************************************************
+  * @file    lqr.c
+  * @version V 1.0.0
+  * @brief   全状态反馈（LQR）控制器
+  ******************************************************************************
+  */
+
+#include "lqr.h"
+#include <stddef.h>
+
+//
+// @简介：初始化LQR控制器，所有状态量的参考值清零
+// @参数：LQR - LQR控制器句柄
+// @参数：LQR_InitStruct - 初始化参数，增益矩阵及限幅数组须在控制器的整个生命周期内有效
+//
+void LQR_Init(LQR_TypeDef *LQR, LQR_InitTypeDef *LQR_InitStruct)
+{
+	LQR->Init = *LQR_InitStruct;
+	
+	if(LQR->Init.NumStates > LQR_MAX_STATES) LQR->Init.NumStates = LQR_MAX_STATES;
+	if(LQR->Init.NumInputs > LQR_MAX_INPUTS) LQR->Init.NumInputs = LQR_MAX_INPUTS;
+	
+	for(uint8_t i=0; i<LQR_MAX_STATES; i++)
+	{
+		LQR->Reference[i] = 0;
+	}
+}
+
+//
+// @简介：修改某个状态量的参考值
+// @参数：LQR - LQR控制器句柄
+// @参数：State - 状态量的编号
+// @参数：NewReference - 新的参考值
+//
+void LQR_ChangeReference(LQR_TypeDef *LQR, uint8_t State, float NewReference)
+{
+	if(State >= LQR->Init.NumStates) return;
+	
+	LQR->Reference[State] = NewReference;
+}
+
+//
+// @简介：读取某个状态量的参考值
+// @参数：LQR - LQR控制器句柄
+// @参数：State - 状态量的编号
+//
+float LQR_GetReference(LQR_TypeDef *LQR, uint8_t State)
+{
+	if(State >= LQR->Init.NumStates) return 0;
+	
+	return LQR->Reference[State];
+}
+
+//
+// @简介：计算控制量 u = -K(x - x_ref)，并按上下限限幅
+// @参数：LQR - LQR控制器句柄
+// @参数：State - 当前的状态量，长度为NumStates
+// @参数：Output - 输出参数，控制量，长度为NumInputs
+//
+void LQR_Compute(LQR_TypeDef *LQR, const float *State, float *Output)
+{
+	float err[LQR_MAX_STATES];
+	
+	for(uint8_t j=0; j<LQR->Init.NumStates; j++)
+	{
+		err[j] = State[j] - LQR->Reference[j];
+	}
+	
+	const float *k = LQR->Init.K;
+	
+	for(uint8_t i=0; i<LQR->Init.NumInputs; i++)
+	{
+		float u = 0;
+		
+		for(uint8_t j=0; j<LQR->Init.NumStates; j++)
+		{
+			u -= *k++ * err[j];
+		}
+		
+		if(LQR->Init.pOutputUpperLimit != NULL && u > LQR->Init.pOutputUpperLimit[i]) u = LQR->Init.pOutputUpperLimit[i];
+		if(LQR->Init.pOutputLowerLimit != NULL && u < LQR->Init.pOutputLowerLimit[i]) u = LQR->Init.pOutputLowerLimit[i];
+		
+		Output[i] = u;
+	}
+}
@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file    lqr.h
+  * @version V 1.0.0
+  * @brief   全状态反馈（LQR）控制器
+  *          u = -K(x - x_ref)，增益矩阵K由电脑上的工具离线计算后以常量表的形式给出，
+  *          每个周期只需一次矩阵向量乘法
+  ******************************************************************************
+  */
+
+#ifndef LQR_H
+#define LQR_H
+
+#include <stdint.h>
+
+#define LQR_MAX_STATES 8 // 最多支持的状态量个数
+#define LQR_MAX_INPUTS 4 // 最多支持的控制量个数
+
+typedef struct
+{
+	const float *K; // 增益矩阵，NumInputs行NumStates列，按行存放
+	uint8_t NumStates; // 状态量的个数
+	uint8_t NumInputs; // 控制量的个数
+	const float *pOutputUpperLimit; // 各控制量的上限，NULL表示不限幅
+	const float *pOutputLowerLimit; // 各控制量的下限，NULL表示不限幅
+} LQR_InitTypeDef;
+
+typedef struct
+{
+	LQR_InitTypeDef Init;
+	float Reference[LQR_MAX_STATES]; // 各状态量的参考值
+} LQR_TypeDef;
+
+ void LQR_Init(LQR_TypeDef *LQR, LQR_InitTypeDef *LQR_InitStruct);
+ void LQR_ChangeReference(LQR_TypeDef *LQR, uint8_t State, float NewReference);
+float LQR_GetReference(LQR_TypeDef *LQR, uint8_t State);
+ void LQR_Compute(LQR_TypeDef *LQR, const float *State, float *Output);
+
+#endif
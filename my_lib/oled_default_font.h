@@ -1,1564 +1,1564 @@
-/**
-  ******************************************************************************
-  * 简介：适用于pal库oled驱动的字体文件
-  *       该文件由bdf2c软件自动生成，工具获取方式 Bilibili关注"铁头山羊"
-  * 字体名称：Matrix 5x8
-  * 字体字号：8磅
-  * 字符数量：95/96
-  * 备注：华文宋体16磅
-  ******************************************************************************
-*/
-
-#ifndef default_font_H_
-#define default_font_H_
-
-#include "oled_font.h"
-
-/* 字形数据 */
-static const uint8_t default_font_GlyphBitmap_0020[] = {0x00}; //  
-static const uint8_t default_font_GlyphBitmap_0021[] = {0x80,0x80,0x80,0x80,0x80,0x00,0x80,}; // !
-static const uint8_t default_font_GlyphBitmap_0022[] = {0xA0,0xA0,0xA0,}; // "
-static const uint8_t default_font_GlyphBitmap_0023[] = {0x50,0x50,0xF8,0x50,0xF8,0x50,0x50,}; // #
-static const uint8_t default_font_GlyphBitmap_0024[] = {0x20,0x78,0xA0,0x50,0x08,0xD0,}; // $
-static const uint8_t default_font_GlyphBitmap_0025[] = {0xC0,0xC8,0x10,0x20,0x40,0x98,0x18,}; // %
-static const uint8_t default_font_GlyphBitmap_0026[] = {0xE0,0x90,0xA0,0x40,0xA8,0x90,0x68,}; // &
-static const uint8_t default_font_GlyphBitmap_0027[] = {0xC0,0x40,0x80,}; // '
-static const uint8_t default_font_GlyphBitmap_0028[] = {0x20,0x40,0x80,0x80,0x80,0x40,0x20,}; // (
-static const uint8_t default_font_GlyphBitmap_0029[] = {0x80,0x40,0x20,0x20,0x20,0x40,0x80,}; // )
-static const uint8_t default_font_GlyphBitmap_002A[] = {0x50,0x20,0xF8,0x20,0x50,}; // *
-static const uint8_t default_font_GlyphBitmap_002B[] = {0x20,0x20,0xF8,0x20,0x20,}; // +
-static const uint8_t default_font_GlyphBitmap_002C[] = {0xC0,0x40,0x80,}; // ,
-static const uint8_t default_font_GlyphBitmap_002D[] = {0xF8,}; // -
-static const uint8_t default_font_GlyphBitmap_002E[] = {0xC0,0xC0,}; // .
-static const uint8_t default_font_GlyphBitmap_002F[] = {0x08,0x10,0x20,0x40,0x80,}; // /
-static const uint8_t default_font_GlyphBitmap_0030[] = {0x70,0x88,0x98,0xA8,0xC8,0x88,0x70,}; // 0
-static const uint8_t default_font_GlyphBitmap_0031[] = {0x40,0xC0,0x40,0x40,0x40,0x40,0xE0,}; // 1
-static const uint8_t default_font_GlyphBitmap_0032[] = {0x70,0x88,0x08,0x10,0x20,0x40,0xF8,}; // 2
-static const uint8_t default_font_GlyphBitmap_0033[] = {0xF8,0x10,0x20,0x10,0x08,0x88,0x70,}; // 3
-static const uint8_t default_font_GlyphBitmap_0034[] = {0x10,0x30,0x50,0x90,0xF8,0x10,0x10,}; // 4
-static const uint8_t default_font_GlyphBitmap_0035[] = {0xF8,0x80,0xF0,0x08,0x08,0x88,0x70,}; // 5
-static const uint8_t default_font_GlyphBitmap_0036[] = {0x30,0x40,0x80,0xF0,0x88,0x88,0x70,}; // 6
-static const uint8_t default_font_GlyphBitmap_0037[] = {0xF8,0x08,0x10,0x20,0x40,0x40,0x40,}; // 7
-static const uint8_t default_font_GlyphBitmap_0038[] = {0x70,0x88,0x88,0x70,0x88,0x88,0x70,}; // 8
-static const uint8_t default_font_GlyphBitmap_0039[] = {0x70,0x88,0x88,0x78,0x08,0x10,0x60,}; // 9
-static const uint8_t default_font_GlyphBitmap_003A[] = {0xC0,0xC0,0x00,0xC0,0xC0,}; // :
-static const uint8_t default_font_GlyphBitmap_003B[] = {0xC0,0xC0,0x00,0xC0,0x40,0x80,}; // ;
-static const uint8_t default_font_GlyphBitmap_003C[] = {0x10,0x20,0x40,0x80,0x40,0x20,0x10,}; // <
-static const uint8_t default_font_GlyphBitmap_003D[] = {0xF8,0x00,0xF8,}; // =
-static const uint8_t default_font_GlyphBitmap_003E[] = {0x80,0x40,0x20,0x10,0x20,0x40,0x80,}; // >
-static const uint8_t default_font_GlyphBitmap_003F[] = {0x70,0x88,0x08,0x10,0x20,0x00,0x20,}; // ?
-static const uint8_t default_font_GlyphBitmap_0040[] = {0x70,0x88,0x08,0x68,0xA8,0xA8,0x70,}; // @
-static const uint8_t default_font_GlyphBitmap_0041[] = {0x70,0x88,0x88,0x88,0xF8,0x88,0x88,}; // A
-static const uint8_t default_font_GlyphBitmap_0042[] = {0xF0,0x88,0x88,0xF0,0x88,0x88,0xF0,}; // B
-static const uint8_t default_font_GlyphBitmap_0043[] = {0x70,0x88,0x80,0x80,0x80,0x88,0x70,}; // C
-static const uint8_t default_font_GlyphBitmap_0044[] = {0xE0,0x90,0x88,0x88,0x88,0x90,0xE0,}; // D
-static const uint8_t default_font_GlyphBitmap_0045[] = {0xF8,0x80,0x80,0xF0,0x80,0x80,0xF8,}; // E
-static const uint8_t default_font_GlyphBitmap_0046[] = {0xF8,0x80,0x80,0xE0,0x80,0x80,0x80,}; // F
-static const uint8_t default_font_GlyphBitmap_0047[] = {0x70,0x88,0x80,0x80,0x98,0x88,0x70,}; // G
-static const uint8_t default_font_GlyphBitmap_0048[] = {0x88,0x88,0x88,0xF8,0x88,0x88,0x88,}; // H
-static const uint8_t default_font_GlyphBitmap_0049[] = {0xC0,0x40,0x40,0x40,0x40,0x40,0xC0,}; // I
-static const uint8_t default_font_GlyphBitmap_004A[] = {0x30,0x10,0x10,0x10,0x10,0x90,0x60,}; // J
-static const uint8_t default_font_GlyphBitmap_004B[] = {0x88,0x90,0xA0,0xC0,0xA0,0x90,0x88,}; // K
-static const uint8_t default_font_GlyphBitmap_004C[] = {0x80,0x80,0x80,0x80,0x80,0x80,0xF8,}; // L
-static const uint8_t default_font_GlyphBitmap_004D[] = {0x88,0xD8,0xA8,0x88,0x88,0x88,0x88,}; // M
-static const uint8_t default_font_GlyphBitmap_004E[] = {0x88,0x88,0xC8,0xA8,0x98,0x88,0x88,}; // N
-static const uint8_t default_font_GlyphBitmap_004F[] = {0x70,0x88,0x88,0x88,0x88,0x88,0x70,}; // O
-static const uint8_t default_font_GlyphBitmap_0050[] = {0xF0,0x88,0x88,0xF0,0x80,0x80,0x80,}; // P
-static const uint8_t default_font_GlyphBitmap_0051[] = {0x70,0x88,0x88,0x88,0xA8,0x90,0x68,}; // Q
-static const uint8_t default_font_GlyphBitmap_0052[] = {0xF0,0x88,0x88,0xF0,0xA0,0x90,0x88,}; // R
-static const uint8_t default_font_GlyphBitmap_0053[] = {0x78,0x80,0x80,0x70,0x08,0x08,0xF0,}; // S
-static const uint8_t default_font_GlyphBitmap_0054[] = {0xF8,0x20,0x20,0x20,0x20,0x20,0x20,}; // T
-static const uint8_t default_font_GlyphBitmap_0055[] = {0x88,0x88,0x88,0x88,0x88,0x88,0x70,}; // U
-static const uint8_t default_font_GlyphBitmap_0056[] = {0x88,0x88,0x88,0x88,0x88,0x50,0x20,}; // V
-static const uint8_t default_font_GlyphBitmap_0057[] = {0x88,0x88,0x88,0xA8,0xA8,0xD8,0x88,}; // W
-static const uint8_t default_font_GlyphBitmap_0058[] = {0x88,0x88,0x50,0x20,0x50,0x88,0x88,}; // X
-static const uint8_t default_font_GlyphBitmap_0059[] = {0x88,0x88,0x50,0x20,0x20,0x20,0x20,}; // Y
-static const uint8_t default_font_GlyphBitmap_005A[] = {0xF8,0x08,0x10,0x20,0x40,0x80,0xF8,}; // Z
-static const uint8_t default_font_GlyphBitmap_005B[] = {0xE0,0x80,0x80,0x80,0x80,0x80,0xE0,}; // [
-static const uint8_t default_font_GlyphBitmap_005C[] = {0x80,0x40,0x20,0x10,0x08,}; // backslash
-static const uint8_t default_font_GlyphBitmap_005D[] = {0xE0,0x20,0x20,0x20,0x20,0x20,0xE0,}; // ]
-static const uint8_t default_font_GlyphBitmap_005E[] = {0x20,0x50,0x88,}; // ^
-static const uint8_t default_font_GlyphBitmap_005F[] = {0xF8,}; // _
-static const uint8_t default_font_GlyphBitmap_0060[] = {0x80,0x40,0x20,}; // `
-static const uint8_t default_font_GlyphBitmap_0061[] = {0x70,0x08,0x78,0x88,0x78,}; // a
-static const uint8_t default_font_GlyphBitmap_0062[] = {0x80,0x80,0xB0,0xC8,0x88,0x88,0xF0,}; // b
-static const uint8_t default_font_GlyphBitmap_0063[] = {0x70,0x80,0x80,0x88,0x70,}; // c
-static const uint8_t default_font_GlyphBitmap_0064[] = {0x08,0x08,0x68,0x98,0x88,0x88,0x78,}; // d
-static const uint8_t default_font_GlyphBitmap_0065[] = {0x70,0x88,0xF8,0x80,0x70,}; // e
-static const uint8_t default_font_GlyphBitmap_0066[] = {0x30,0x48,0x40,0xE0,0x40,0x40,0x40,}; // f
-static const uint8_t default_font_GlyphBitmap_0067[] = {0x78,0x88,0x78,0x08,0x30,}; // g
-static const uint8_t default_font_GlyphBitmap_0068[] = {0x80,0x80,0xB0,0xC8,0x88,0x88,0x88,}; // h
-static const uint8_t default_font_GlyphBitmap_0069[] = {0x40,0x00,0xC0,0x40,0x40,0x40,0xE0,}; // i
-static const uint8_t default_font_GlyphBitmap_006A[] = {0x10,0x00,0x30,0x10,0x10,0x90,0x60,}; // j
-static const uint8_t default_font_GlyphBitmap_006B[] = {0x80,0x80,0x90,0xA0,0xC0,0xA0,0x90,}; // k
-static const uint8_t default_font_GlyphBitmap_006C[] = {0xC0,0x40,0x40,0x40,0x40,0x40,0xE0,}; // l
-static const uint8_t default_font_GlyphBitmap_006D[] = {0xD0,0xA8,0xA8,0x88,0x88,}; // m
-static const uint8_t default_font_GlyphBitmap_006E[] = {0xB0,0xC8,0x88,0x88,0x88,}; // n
-static const uint8_t default_font_GlyphBitmap_006F[] = {0x70,0x88,0x88,0x88,0x70,}; // o
-static const uint8_t default_font_GlyphBitmap_0070[] = {0xF0,0x88,0xF0,0x80,0x80,}; // p
-static const uint8_t default_font_GlyphBitmap_0071[] = {0x68,0x98,0x78,0x08,0x08,0x08,}; // q
-static const uint8_t default_font_GlyphBitmap_0072[] = {0xB0,0xC8,0x80,0x80,0x80,}; // r
-static const uint8_t default_font_GlyphBitmap_0073[] = {0x70,0x80,0x70,0x08,0x70,}; // s
-static const uint8_t default_font_GlyphBitmap_0074[] = {0x40,0x40,0xE0,0x40,0x40,0x48,0x30,}; // t
-static const uint8_t default_font_GlyphBitmap_0075[] = {0x88,0x88,0x88,0x88,0x98,0x68,}; // u
-static const uint8_t default_font_GlyphBitmap_0076[] = {0x88,0x88,0x88,0x50,0x20,}; // v
-static const uint8_t default_font_GlyphBitmap_0077[] = {0x88,0x88,0xA8,0xA8,0x50,}; // w
-static const uint8_t default_font_GlyphBitmap_0078[] = {0x88,0x50,0x20,0x50,0x88,}; // x
-static const uint8_t default_font_GlyphBitmap_0079[] = {0x88,0x88,0x78,0x08,0x70,}; // y
-static const uint8_t default_font_GlyphBitmap_007A[] = {0xF8,0x10,0x20,0x40,0xF8,}; // z
-static const uint8_t default_font_GlyphBitmap_007B[] = {0x20,0x40,0x40,0x80,0x40,0x40,0x20,}; // {
-static const uint8_t default_font_GlyphBitmap_007C[] = {0x80,0x80,0x80,0x80,0x80,0x80,0x80,}; // |
-static const uint8_t default_font_GlyphBitmap_007D[] = {0x80,0x40,0x40,0x20,0x40,0x40,0x80,}; // }
-static const uint8_t default_font_GlyphBitmap_007E[] = {0x40,0xA8,0x10,}; // ~
-
-/* 映射表 */
-static const uint32_t default_font_Map[] = {32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,93,94,95,96,97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,121,122,123,124,125,126,};
-
-/* 字形 */
-static const Glyph_TypeDef default_font_Glyphs[] = {
-	//  
-	{
-		.Name = "0020", 
-		.Encoding = 32, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 0, 
-		.BBh = 0, 
-		.BBxoff0x = 0, 
-		.BByoff0y = 0, 
-		.nBytes = 0, 
-		.Bitmap = default_font_GlyphBitmap_0020, 
-	},
-	// !
-	{
-		.Name = "0021", 
-		.Encoding = 33, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 1, 
-		.BBh = 7, 
-		.BBxoff0x = 3, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0021, 
-	},
-	// "
-	{
-		.Name = "0022", 
-		.Encoding = 34, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 3, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 4, 
-		.nBytes = 3, 
-		.Bitmap = default_font_GlyphBitmap_0022, 
-	},
-	// #
-	{
-		.Name = "0023", 
-		.Encoding = 35, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0023, 
-	},
-	// $
-	{
-		.Name = "0024", 
-		.Encoding = 36, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 6, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 2, 
-		.nBytes = 6, 
-		.Bitmap = default_font_GlyphBitmap_0024, 
-	},
-	// %
-	{
-		.Name = "0025", 
-		.Encoding = 37, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0025, 
-	},
-	// &
-	{
-		.Name = "0026", 
-		.Encoding = 38, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0026, 
-	},
-	// '
-	{
-		.Name = "0027", 
-		.Encoding = 39, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 2, 
-		.BBh = 3, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 5, 
-		.nBytes = 3, 
-		.Bitmap = default_font_GlyphBitmap_0027, 
-	},
-	// (
-	{
-		.Name = "0028", 
-		.Encoding = 40, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0028, 
-	},
-	// )
-	{
-		.Name = "0029", 
-		.Encoding = 41, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0029, 
-	},
-	// *
-	{
-		.Name = "002A", 
-		.Encoding = 42, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 2, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_002A, 
-	},
-	// +
-	{
-		.Name = "002B", 
-		.Encoding = 43, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 2, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_002B, 
-	},
-	// ,
-	{
-		.Name = "002C", 
-		.Encoding = 44, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 2, 
-		.BBh = 3, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 3, 
-		.Bitmap = default_font_GlyphBitmap_002C, 
-	},
-	// -
-	{
-		.Name = "002D", 
-		.Encoding = 45, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 1, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 4, 
-		.nBytes = 1, 
-		.Bitmap = default_font_GlyphBitmap_002D, 
-	},
-	// .
-	{
-		.Name = "002E", 
-		.Encoding = 46, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 2, 
-		.BBh = 2, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 2, 
-		.Bitmap = default_font_GlyphBitmap_002E, 
-	},
-	// /
-	{
-		.Name = "002F", 
-		.Encoding = 47, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 2, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_002F, 
-	},
-	// 0
-	{
-		.Name = "0030", 
-		.Encoding = 48, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0030, 
-	},
-	// 1
-	{
-		.Name = "0031", 
-		.Encoding = 49, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0031, 
-	},
-	// 2
-	{
-		.Name = "0032", 
-		.Encoding = 50, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0032, 
-	},
-	// 3
-	{
-		.Name = "0033", 
-		.Encoding = 51, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0033, 
-	},
-	// 4
-	{
-		.Name = "0034", 
-		.Encoding = 52, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0034, 
-	},
-	// 5
-	{
-		.Name = "0035", 
-		.Encoding = 53, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0035, 
-	},
-	// 6
-	{
-		.Name = "0036", 
-		.Encoding = 54, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0036, 
-	},
-	// 7
-	{
-		.Name = "0037", 
-		.Encoding = 55, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0037, 
-	},
-	// 8
-	{
-		.Name = "0038", 
-		.Encoding = 56, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0038, 
-	},
-	// 9
-	{
-		.Name = "0039", 
-		.Encoding = 57, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0039, 
-	},
-	// :
-	{
-		.Name = "003A", 
-		.Encoding = 58, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 2, 
-		.BBh = 5, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 2, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_003A, 
-	},
-	// ;
-	{
-		.Name = "003B", 
-		.Encoding = 59, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 2, 
-		.BBh = 6, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 6, 
-		.Bitmap = default_font_GlyphBitmap_003B, 
-	},
-	// <
-	{
-		.Name = "003C", 
-		.Encoding = 60, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 4, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_003C, 
-	},
-	// =
-	{
-		.Name = "003D", 
-		.Encoding = 61, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 3, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 3, 
-		.nBytes = 3, 
-		.Bitmap = default_font_GlyphBitmap_003D, 
-	},
-	// >
-	{
-		.Name = "003E", 
-		.Encoding = 62, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 4, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_003E, 
-	},
-	// ?
-	{
-		.Name = "003F", 
-		.Encoding = 63, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_003F, 
-	},
-	// @
-	{
-		.Name = "0040", 
-		.Encoding = 64, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0040, 
-	},
-	// A
-	{
-		.Name = "0041", 
-		.Encoding = 65, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0041, 
-	},
-	// B
-	{
-		.Name = "0042", 
-		.Encoding = 66, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0042, 
-	},
-	// C
-	{
-		.Name = "0043", 
-		.Encoding = 67, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0043, 
-	},
-	// D
-	{
-		.Name = "0044", 
-		.Encoding = 68, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0044, 
-	},
-	// E
-	{
-		.Name = "0045", 
-		.Encoding = 69, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0045, 
-	},
-	// F
-	{
-		.Name = "0046", 
-		.Encoding = 70, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0046, 
-	},
-	// G
-	{
-		.Name = "0047", 
-		.Encoding = 71, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0047, 
-	},
-	// H
-	{
-		.Name = "0048", 
-		.Encoding = 72, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0048, 
-	},
-	// I
-	{
-		.Name = "0049", 
-		.Encoding = 73, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0049, 
-	},
-	// J
-	{
-		.Name = "004A", 
-		.Encoding = 74, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_004A, 
-	},
-	// K
-	{
-		.Name = "004B", 
-		.Encoding = 75, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_004B, 
-	},
-	// L
-	{
-		.Name = "004C", 
-		.Encoding = 76, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_004C, 
-	},
-	// M
-	{
-		.Name = "004D", 
-		.Encoding = 77, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_004D, 
-	},
-	// N
-	{
-		.Name = "004E", 
-		.Encoding = 78, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_004E, 
-	},
-	// O
-	{
-		.Name = "004F", 
-		.Encoding = 79, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_004F, 
-	},
-	// P
-	{
-		.Name = "0050", 
-		.Encoding = 80, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0050, 
-	},
-	// Q
-	{
-		.Name = "0051", 
-		.Encoding = 81, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0051, 
-	},
-	// R
-	{
-		.Name = "0052", 
-		.Encoding = 82, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0052, 
-	},
-	// S
-	{
-		.Name = "0053", 
-		.Encoding = 83, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0053, 
-	},
-	// T
-	{
-		.Name = "0054", 
-		.Encoding = 84, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0054, 
-	},
-	// U
-	{
-		.Name = "0055", 
-		.Encoding = 85, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0055, 
-	},
-	// V
-	{
-		.Name = "0056", 
-		.Encoding = 86, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0056, 
-	},
-	// W
-	{
-		.Name = "0057", 
-		.Encoding = 87, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0057, 
-	},
-	// X
-	{
-		.Name = "0058", 
-		.Encoding = 88, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0058, 
-	},
-	// Y
-	{
-		.Name = "0059", 
-		.Encoding = 89, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0059, 
-	},
-	// Z
-	{
-		.Name = "005A", 
-		.Encoding = 90, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_005A, 
-	},
-	// [
-	{
-		.Name = "005B", 
-		.Encoding = 91, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_005B, 
-	},
-	// back slash
-	{
-		.Name = "005C", 
-		.Encoding = 92, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 2, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_005C, 
-	},
-	// ]
-	{
-		.Name = "005D", 
-		.Encoding = 93, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_005D, 
-	},
-	// ^
-	{
-		.Name = "005E", 
-		.Encoding = 94, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 3, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 5, 
-		.nBytes = 3, 
-		.Bitmap = default_font_GlyphBitmap_005E, 
-	},
-	// _
-	{
-		.Name = "005F", 
-		.Encoding = 95, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 1, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 1, 
-		.Bitmap = default_font_GlyphBitmap_005F, 
-	},
-	// `
-	{
-		.Name = "0060", 
-		.Encoding = 96, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 3, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 5, 
-		.nBytes = 3, 
-		.Bitmap = default_font_GlyphBitmap_0060, 
-	},
-	// a
-	{
-		.Name = "0061", 
-		.Encoding = 97, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0061, 
-	},
-	// b
-	{
-		.Name = "0062", 
-		.Encoding = 98, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0062, 
-	},
-	// c
-	{
-		.Name = "0063", 
-		.Encoding = 99, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0063, 
-	},
-	// d
-	{
-		.Name = "0064", 
-		.Encoding = 100, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0064, 
-	},
-	// e
-	{
-		.Name = "0065", 
-		.Encoding = 101, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0065, 
-	},
-	// f
-	{
-		.Name = "0066", 
-		.Encoding = 102, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0066, 
-	},
-	// g
-	{
-		.Name = "0067", 
-		.Encoding = 103, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0067, 
-	},
-	// h
-	{
-		.Name = "0068", 
-		.Encoding = 104, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0068, 
-	},
-	// i
-	{
-		.Name = "0069", 
-		.Encoding = 105, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0069, 
-	},
-	// j
-	{
-		.Name = "006A", 
-		.Encoding = 106, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 4, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_006A, 
-	},
-	// k
-	{
-		.Name = "006B", 
-		.Encoding = 107, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 4, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_006B, 
-	},
-	// l
-	{
-		.Name = "006C", 
-		.Encoding = 108, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_006C, 
-	},
-	// m
-	{
-		.Name = "006D", 
-		.Encoding = 109, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_006D, 
-	},
-	// n
-	{
-		.Name = "006E", 
-		.Encoding = 110, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_006E, 
-	},
-	// o
-	{
-		.Name = "006F", 
-		.Encoding = 111, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_006F, 
-	},
-	// p
-	{
-		.Name = "0070", 
-		.Encoding = 112, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0070, 
-	},
-	// q
-	{
-		.Name = "0071", 
-		.Encoding = 113, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 6, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 6, 
-		.Bitmap = default_font_GlyphBitmap_0071, 
-	},
-	// r
-	{
-		.Name = "0072", 
-		.Encoding = 114, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0072, 
-	},
-	// s
-	{
-		.Name = "0073", 
-		.Encoding = 115, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0073, 
-	},
-	// t
-	{
-		.Name = "0074", 
-		.Encoding = 116, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 7, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_0074, 
-	},
-	// u
-	{
-		.Name = "0075", 
-		.Encoding = 117, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 6, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 6, 
-		.Bitmap = default_font_GlyphBitmap_0075, 
-	},
-	// v
-	{
-		.Name = "0076", 
-		.Encoding = 118, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0076, 
-	},
-	// w
-	{
-		.Name = "0077", 
-		.Encoding = 119, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0077, 
-	},
-	// x
-	{
-		.Name = "0078", 
-		.Encoding = 120, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0078, 
-	},
-	// y
-	{
-		.Name = "0079", 
-		.Encoding = 121, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_0079, 
-	},
-	// z
-	{
-		.Name = "007A", 
-		.Encoding = 122, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 5, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 1, 
-		.nBytes = 5, 
-		.Bitmap = default_font_GlyphBitmap_007A, 
-	},
-	// {
-	{
-		.Name = "007B", 
-		.Encoding = 123, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_007B, 
-	},
-	// |
-	{
-		.Name = "007C", 
-		.Encoding = 124, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 1, 
-		.BBh = 7, 
-		.BBxoff0x = 3, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_007C, 
-	},
-	// }
-	{
-		.Name = "007D", 
-		.Encoding = 125, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 3, 
-		.BBh = 7, 
-		.BBxoff0x = 2, 
-		.BByoff0y = 1, 
-		.nBytes = 7, 
-		.Bitmap = default_font_GlyphBitmap_007D, 
-	},
-	// ~
-	{
-		.Name = "007E", 
-		.Encoding = 126, 
-		.Swx0 = 1000, 
-		.Swy0 = 0, 
-		.Dwx0 = 7, 
-		.Dwy0 = 0, 
-		.BBw = 5, 
-		.BBh = 3, 
-		.BBxoff0x = 1, 
-		.BByoff0y = 5, 
-		.nBytes = 3, 
-		.Bitmap = default_font_GlyphBitmap_007E, 
-	},
-};
-
-/* 字体文件 */
-const Font_TypeDef default_font =
-{
-	.SpecVersion = "2.1",
-	.FontName = "Matrix 5x8",
-	.MetricsSet = 0,
-	.FontSize = 8,
-	.Xres = 72,
-	.Yres = 72,
-	.FBBx = 7,
-	.FBBy = 8,
-	.FBBXoff = 0,
-	.FBBYoff = 0,
-	.nChars = 95,
-	.Map = default_font_Map,
-	.Glyphs = default_font_Glyphs,
-};
-
-#endif
+/**
+  ******************************************************************************
+  * 简介：适用于pal库oled驱动的字体文件
+  *       该文件由bdf2c软件自动生成，工具获取方式 Bilibili关注"铁头山羊"
+  * 字体名称：Matrix 5x8
+  * 字体字号：8磅
+  * 字符数量：95/96
+  * 备注：华文宋体16磅
+  ******************************************************************************
+*/
+
+#ifndef default_font_H_
+#define default_font_H_
+
+#include "oled_font.h"
+
+/* 字形数据 */
+static const uint8_t default_font_GlyphBitmap_0020[] = {0x00}; //  
+static const uint8_t default_font_GlyphBitmap_0021[] = {0x80,0x80,0x80,0x80,0x80,0x00,0x80,}; // !
+static const uint8_t default_font_GlyphBitmap_0022[] = {0xA0,0xA0,0xA0,}; // "
+static const uint8_t default_font_GlyphBitmap_0023[] = {0x50,0x50,0xF8,0x50,0xF8,0x50,0x50,}; // #
+static const uint8_t default_font_GlyphBitmap_0024[] = {0x20,0x78,0xA0,0x50,0x08,0xD0,}; // $
+static const uint8_t default_font_GlyphBitmap_0025[] = {0xC0,0xC8,0x10,0x20,0x40,0x98,0x18,}; // %
+static const uint8_t default_font_GlyphBitmap_0026[] = {0xE0,0x90,0xA0,0x40,0xA8,0x90,0x68,}; // &
+static const uint8_t default_font_GlyphBitmap_0027[] = {0xC0,0x40,0x80,}; // '
+static const uint8_t default_font_GlyphBitmap_0028[] = {0x20,0x40,0x80,0x80,0x80,0x40,0x20,}; // (
+static const uint8_t default_font_GlyphBitmap_0029[] = {0x80,0x40,0x20,0x20,0x20,0x40,0x80,}; // )
+static const uint8_t default_font_GlyphBitmap_002A[] = {0x50,0x20,0xF8,0x20,0x50,}; // *
+static const uint8_t default_font_GlyphBitmap_002B[] = {0x20,0x20,0xF8,0x20,0x20,}; // +
+static const uint8_t default_font_GlyphBitmap_002C[] = {0xC0,0x40,0x80,}; // ,
+static const uint8_t default_font_GlyphBitmap_002D[] = {0xF8,}; // -
+static const uint8_t default_font_GlyphBitmap_002E[] = {0xC0,0xC0,}; // .
+static const uint8_t default_font_GlyphBitmap_002F[] = {0x08,0x10,0x20,0x40,0x80,}; // /
+static const uint8_t default_font_GlyphBitmap_0030[] = {0x70,0x88,0x98,0xA8,0xC8,0x88,0x70,}; // 0
+static const uint8_t default_font_GlyphBitmap_0031[] = {0x40,0xC0,0x40,0x40,0x40,0x40,0xE0,}; // 1
+static const uint8_t default_font_GlyphBitmap_0032[] = {0x70,0x88,0x08,0x10,0x20,0x40,0xF8,}; // 2
+static const uint8_t default_font_GlyphBitmap_0033[] = {0xF8,0x10,0x20,0x10,0x08,0x88,0x70,}; // 3
+static const uint8_t default_font_GlyphBitmap_0034[] = {0x10,0x30,0x50,0x90,0xF8,0x10,0x10,}; // 4
+static const uint8_t default_font_GlyphBitmap_0035[] = {0xF8,0x80,0xF0,0x08,0x08,0x88,0x70,}; // 5
+static const uint8_t default_font_GlyphBitmap_0036[] = {0x30,0x40,0x80,0xF0,0x88,0x88,0x70,}; // 6
+static const uint8_t default_font_GlyphBitmap_0037[] = {0xF8,0x08,0x10,0x20,0x40,0x40,0x40,}; // 7
+static const uint8_t default_font_GlyphBitmap_0038[] = {0x70,0x88,0x88,0x70,0x88,0x88,0x70,}; // 8
+static const uint8_t default_font_GlyphBitmap_0039[] = {0x70,0x88,0x88,0x78,0x08,0x10,0x60,}; // 9
+static const uint8_t default_font_GlyphBitmap_003A[] = {0xC0,0xC0,0x00,0xC0,0xC0,}; // :
+static const uint8_t default_font_GlyphBitmap_003B[] = {0xC0,0xC0,0x00,0xC0,0x40,0x80,}; // ;
+static const uint8_t default_font_GlyphBitmap_003C[] = {0x10,0x20,0x40,0x80,0x40,0x20,0x10,}; // <
+static const uint8_t default_font_GlyphBitmap_003D[] = {0xF8,0x00,0xF8,}; // =
+static const uint8_t default_font_GlyphBitmap_003E[] = {0x80,0x40,0x20,0x10,0x20,0x40,0x80,}; // >
+static const uint8_t default_font_GlyphBitmap_003F[] = {0x70,0x88,0x08,0x10,0x20,0x00,0x20,}; // ?
+static const uint8_t default_font_GlyphBitmap_0040[] = {0x70,0x88,0x08,0x68,0xA8,0xA8,0x70,}; // @
+static const uint8_t default_font_GlyphBitmap_0041[] = {0x70,0x88,0x88,0x88,0xF8,0x88,0x88,}; // A
+static const uint8_t default_font_GlyphBitmap_0042[] = {0xF0,0x88,0x88,0xF0,0x88,0x88,0xF0,}; // B
+static const uint8_t default_font_GlyphBitmap_0043[] = {0x70,0x88,0x80,0x80,0x80,0x88,0x70,}; // C
+static const uint8_t default_font_GlyphBitmap_0044[] = {0xE0,0x90,0x88,0x88,0x88,0x90,0xE0,}; // D
+static const uint8_t default_font_GlyphBitmap_0045[] = {0xF8,0x80,0x80,0xF0,0x80,0x80,0xF8,}; // E
+static const uint8_t default_font_GlyphBitmap_0046[] = {0xF8,0x80,0x80,0xE0,0x80,0x80,0x80,}; // F
+static const uint8_t default_font_GlyphBitmap_0047[] = {0x70,0x88,0x80,0x80,0x98,0x88,0x70,}; // G
+static const uint8_t default_font_GlyphBitmap_0048[] = {0x88,0x88,0x88,0xF8,0x88,0x88,0x88,}; // H
+static const uint8_t default_font_GlyphBitmap_0049[] = {0xC0,0x40,0x40,0x40,0x40,0x40,0xC0,}; // I
+static const uint8_t default_font_GlyphBitmap_004A[] = {0x30,0x10,0x10,0x10,0x10,0x90,0x60,}; // J
+static const uint8_t default_font_GlyphBitmap_004B[] = {0x88,0x90,0xA0,0xC0,0xA0,0x90,0x88,}; // K
+static const uint8_t default_font_GlyphBitmap_004C[] = {0x80,0x80,0x80,0x80,0x80,0x80,0xF8,}; // L
+static const uint8_t default_font_GlyphBitmap_004D[] = {0x88,0xD8,0xA8,0x88,0x88,0x88,0x88,}; // M
+static const uint8_t default_font_GlyphBitmap_004E[] = {0x88,0x88,0xC8,0xA8,0x98,0x88,0x88,}; // N
+static const uint8_t default_font_GlyphBitmap_004F[] = {0x70,0x88,0x88,0x88,0x88,0x88,0x70,}; // O
+static const uint8_t default_font_GlyphBitmap_0050[] = {0xF0,0x88,0x88,0xF0,0x80,0x80,0x80,}; // P
+static const uint8_t default_font_GlyphBitmap_0051[] = {0x70,0x88,0x88,0x88,0xA8,0x90,0x68,}; // Q
+static const uint8_t default_font_GlyphBitmap_0052[] = {0xF0,0x88,0x88,0xF0,0xA0,0x90,0x88,}; // R
+static const uint8_t default_font_GlyphBitmap_0053[] = {0x78,0x80,0x80,0x70,0x08,0x08,0xF0,}; // S
+static const uint8_t default_font_GlyphBitmap_0054[] = {0xF8,0x20,0x20,0x20,0x20,0x20,0x20,}; // T
+static const uint8_t default_font_GlyphBitmap_0055[] = {0x88,0x88,0x88,0x88,0x88,0x88,0x70,}; // U
+static const uint8_t default_font_GlyphBitmap_0056[] = {0x88,0x88,0x88,0x88,0x88,0x50,0x20,}; // V
+static const uint8_t default_font_GlyphBitmap_0057[] = {0x88,0x88,0x88,0xA8,0xA8,0xD8,0x88,}; // W
+static const uint8_t default_font_GlyphBitmap_0058[] = {0x88,0x88,0x50,0x20,0x50,0x88,0x88,}; // X
+static const uint8_t default_font_GlyphBitmap_0059[] = {0x88,0x88,0x50,0x20,0x20,0x20,0x20,}; // Y
+static const uint8_t default_font_GlyphBitmap_005A[] = {0xF8,0x08,0x10,0x20,0x40,0x80,0xF8,}; // Z
+static const uint8_t default_font_GlyphBitmap_005B[] = {0xE0,0x80,0x80,0x80,0x80,0x80,0xE0,}; // [
+static const uint8_t default_font_GlyphBitmap_005C[] = {0x80,0x40,0x20,0x10,0x08,}; // backslash
+static const uint8_t default_font_GlyphBitmap_005D[] = {0xE0,0x20,0x20,0x20,0x20,0x20,0xE0,}; // ]
+static const uint8_t default_font_GlyphBitmap_005E[] = {0x20,0x50,0x88,}; // ^
+static const uint8_t default_font_GlyphBitmap_005F[] = {0xF8,}; // _
+static const uint8_t default_font_GlyphBitmap_0060[] = {0x80,0x40,0x20,}; // `
+static const uint8_t default_font_GlyphBitmap_0061[] = {0x70,0x08,0x78,0x88,0x78,}; // a
+static const uint8_t default_font_GlyphBitmap_0062[] = {0x80,0x80,0xB0,0xC8,0x88,0x88,0xF0,}; // b
+static const uint8_t default_font_GlyphBitmap_0063[] = {0x70,0x80,0x80,0x88,0x70,}; // c
+static const uint8_t default_font_GlyphBitmap_0064[] = {0x08,0x08,0x68,0x98,0x88,0x88,0x78,}; // d
+static const uint8_t default_font_GlyphBitmap_0065[] = {0x70,0x88,0xF8,0x80,0x70,}; // e
+static const uint8_t default_font_GlyphBitmap_0066[] = {0x30,0x48,0x40,0xE0,0x40,0x40,0x40,}; // f
+static const uint8_t default_font_GlyphBitmap_0067[] = {0x78,0x88,0x78,0x08,0x30,}; // g
+static const uint8_t default_font_GlyphBitmap_0068[] = {0x80,0x80,0xB0,0xC8,0x88,0x88,0x88,}; // h
+static const uint8_t default_font_GlyphBitmap_0069[] = {0x40,0x00,0xC0,0x40,0x40,0x40,0xE0,}; // i
+static const uint8_t default_font_GlyphBitmap_006A[] = {0x10,0x00,0x30,0x10,0x10,0x90,0x60,}; // j
+static const uint8_t default_font_GlyphBitmap_006B[] = {0x80,0x80,0x90,0xA0,0xC0,0xA0,0x90,}; // k
+static const uint8_t default_font_GlyphBitmap_006C[] = {0xC0,0x40,0x40,0x40,0x40,0x40,0xE0,}; // l
+static const uint8_t default_font_GlyphBitmap_006D[] = {0xD0,0xA8,0xA8,0x88,0x88,}; // m
+static const uint8_t default_font_GlyphBitmap_006E[] = {0xB0,0xC8,0x88,0x88,0x88,}; // n
+static const uint8_t default_font_GlyphBitmap_006F[] = {0x70,0x88,0x88,0x88,0x70,}; // o
+static const uint8_t default_font_GlyphBitmap_0070[] = {0xF0,0x88,0xF0,0x80,0x80,}; // p
+static const uint8_t default_font_GlyphBitmap_0071[] = {0x68,0x98,0x78,0x08,0x08,0x08,}; // q
+static const uint8_t default_font_GlyphBitmap_0072[] = {0xB0,0xC8,0x80,0x80,0x80,}; // r
+static const uint8_t default_font_GlyphBitmap_0073[] = {0x70,0x80,0x70,0x08,0x70,}; // s
+static const uint8_t default_font_GlyphBitmap_0074[] = {0x40,0x40,0xE0,0x40,0x40,0x48,0x30,}; // t
+static const uint8_t default_font_GlyphBitmap_0075[] = {0x88,0x88,0x88,0x88,0x98,0x68,}; // u
+static const uint8_t default_font_GlyphBitmap_0076[] = {0x88,0x88,0x88,0x50,0x20,}; // v
+static const uint8_t default_font_GlyphBitmap_0077[] = {0x88,0x88,0xA8,0xA8,0x50,}; // w
+static const uint8_t default_font_GlyphBitmap_0078[] = {0x88,0x50,0x20,0x50,0x88,}; // x
+static const uint8_t default_font_GlyphBitmap_0079[] = {0x88,0x88,0x78,0x08,0x70,}; // y
+static const uint8_t default_font_GlyphBitmap_007A[] = {0xF8,0x10,0x20,0x40,0xF8,}; // z
+static const uint8_t default_font_GlyphBitmap_007B[] = {0x20,0x40,0x40,0x80,0x40,0x40,0x20,}; // {
+static const uint8_t default_font_GlyphBitmap_007C[] = {0x80,0x80,0x80,0x80,0x80,0x80,0x80,}; // |
+static const uint8_t default_font_GlyphBitmap_007D[] = {0x80,0x40,0x40,0x20,0x40,0x40,0x80,}; // }
+static const uint8_t default_font_GlyphBitmap_007E[] = {0x40,0xA8,0x10,}; // ~
+
+/* 映射表 */
+static const uint32_t default_font_Map[] = {32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,93,94,95,96,97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,121,122,123,124,125,126,};
+
+/* 字形 */
+static const Glyph_TypeDef default_font_Glyphs[] = {
+	//  
+	{
+		.Name = "0020", 
+		.Encoding = 32, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 0, 
+		.BBh = 0, 
+		.BBxoff0x = 0, 
+		.BByoff0y = 0, 
+		.nBytes = 0, 
+		.Bitmap = default_font_GlyphBitmap_0020, 
+	},
+	// !
+	{
+		.Name = "0021", 
+		.Encoding = 33, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 1, 
+		.BBh = 7, 
+		.BBxoff0x = 3, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0021, 
+	},
+	// "
+	{
+		.Name = "0022", 
+		.Encoding = 34, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 3, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 4, 
+		.nBytes = 3, 
+		.Bitmap = default_font_GlyphBitmap_0022, 
+	},
+	// #
+	{
+		.Name = "0023", 
+		.Encoding = 35, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0023, 
+	},
+	// $
+	{
+		.Name = "0024", 
+		.Encoding = 36, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 6, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 2, 
+		.nBytes = 6, 
+		.Bitmap = default_font_GlyphBitmap_0024, 
+	},
+	// %
+	{
+		.Name = "0025", 
+		.Encoding = 37, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0025, 
+	},
+	// &
+	{
+		.Name = "0026", 
+		.Encoding = 38, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0026, 
+	},
+	// '
+	{
+		.Name = "0027", 
+		.Encoding = 39, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 2, 
+		.BBh = 3, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 5, 
+		.nBytes = 3, 
+		.Bitmap = default_font_GlyphBitmap_0027, 
+	},
+	// (
+	{
+		.Name = "0028", 
+		.Encoding = 40, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0028, 
+	},
+	// )
+	{
+		.Name = "0029", 
+		.Encoding = 41, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0029, 
+	},
+	// *
+	{
+		.Name = "002A", 
+		.Encoding = 42, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 2, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_002A, 
+	},
+	// +
+	{
+		.Name = "002B", 
+		.Encoding = 43, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 2, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_002B, 
+	},
+	// ,
+	{
+		.Name = "002C", 
+		.Encoding = 44, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 2, 
+		.BBh = 3, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 3, 
+		.Bitmap = default_font_GlyphBitmap_002C, 
+	},
+	// -
+	{
+		.Name = "002D", 
+		.Encoding = 45, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 1, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 4, 
+		.nBytes = 1, 
+		.Bitmap = default_font_GlyphBitmap_002D, 
+	},
+	// .
+	{
+		.Name = "002E", 
+		.Encoding = 46, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 2, 
+		.BBh = 2, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 2, 
+		.Bitmap = default_font_GlyphBitmap_002E, 
+	},
+	// /
+	{
+		.Name = "002F", 
+		.Encoding = 47, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 2, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_002F, 
+	},
+	// 0
+	{
+		.Name = "0030", 
+		.Encoding = 48, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0030, 
+	},
+	// 1
+	{
+		.Name = "0031", 
+		.Encoding = 49, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0031, 
+	},
+	// 2
+	{
+		.Name = "0032", 
+		.Encoding = 50, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0032, 
+	},
+	// 3
+	{
+		.Name = "0033", 
+		.Encoding = 51, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0033, 
+	},
+	// 4
+	{
+		.Name = "0034", 
+		.Encoding = 52, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0034, 
+	},
+	// 5
+	{
+		.Name = "0035", 
+		.Encoding = 53, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0035, 
+	},
+	// 6
+	{
+		.Name = "0036", 
+		.Encoding = 54, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0036, 
+	},
+	// 7
+	{
+		.Name = "0037", 
+		.Encoding = 55, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0037, 
+	},
+	// 8
+	{
+		.Name = "0038", 
+		.Encoding = 56, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0038, 
+	},
+	// 9
+	{
+		.Name = "0039", 
+		.Encoding = 57, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0039, 
+	},
+	// :
+	{
+		.Name = "003A", 
+		.Encoding = 58, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 2, 
+		.BBh = 5, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 2, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_003A, 
+	},
+	// ;
+	{
+		.Name = "003B", 
+		.Encoding = 59, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 2, 
+		.BBh = 6, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 6, 
+		.Bitmap = default_font_GlyphBitmap_003B, 
+	},
+	// <
+	{
+		.Name = "003C", 
+		.Encoding = 60, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 4, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_003C, 
+	},
+	// =
+	{
+		.Name = "003D", 
+		.Encoding = 61, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 3, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 3, 
+		.nBytes = 3, 
+		.Bitmap = default_font_GlyphBitmap_003D, 
+	},
+	// >
+	{
+		.Name = "003E", 
+		.Encoding = 62, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 4, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_003E, 
+	},
+	// ?
+	{
+		.Name = "003F", 
+		.Encoding = 63, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_003F, 
+	},
+	// @
+	{
+		.Name = "0040", 
+		.Encoding = 64, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0040, 
+	},
+	// A
+	{
+		.Name = "0041", 
+		.Encoding = 65, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0041, 
+	},
+	// B
+	{
+		.Name = "0042", 
+		.Encoding = 66, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0042, 
+	},
+	// C
+	{
+		.Name = "0043", 
+		.Encoding = 67, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0043, 
+	},
+	// D
+	{
+		.Name = "0044", 
+		.Encoding = 68, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0044, 
+	},
+	// E
+	{
+		.Name = "0045", 
+		.Encoding = 69, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0045, 
+	},
+	// F
+	{
+		.Name = "0046", 
+		.Encoding = 70, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0046, 
+	},
+	// G
+	{
+		.Name = "0047", 
+		.Encoding = 71, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0047, 
+	},
+	// H
+	{
+		.Name = "0048", 
+		.Encoding = 72, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0048, 
+	},
+	// I
+	{
+		.Name = "0049", 
+		.Encoding = 73, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0049, 
+	},
+	// J
+	{
+		.Name = "004A", 
+		.Encoding = 74, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_004A, 
+	},
+	// K
+	{
+		.Name = "004B", 
+		.Encoding = 75, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_004B, 
+	},
+	// L
+	{
+		.Name = "004C", 
+		.Encoding = 76, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_004C, 
+	},
+	// M
+	{
+		.Name = "004D", 
+		.Encoding = 77, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_004D, 
+	},
+	// N
+	{
+		.Name = "004E", 
+		.Encoding = 78, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_004E, 
+	},
+	// O
+	{
+		.Name = "004F", 
+		.Encoding = 79, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_004F, 
+	},
+	// P
+	{
+		.Name = "0050", 
+		.Encoding = 80, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0050, 
+	},
+	// Q
+	{
+		.Name = "0051", 
+		.Encoding = 81, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0051, 
+	},
+	// R
+	{
+		.Name = "0052", 
+		.Encoding = 82, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0052, 
+	},
+	// S
+	{
+		.Name = "0053", 
+		.Encoding = 83, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0053, 
+	},
+	// T
+	{
+		.Name = "0054", 
+		.Encoding = 84, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0054, 
+	},
+	// U
+	{
+		.Name = "0055", 
+		.Encoding = 85, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0055, 
+	},
+	// V
+	{
+		.Name = "0056", 
+		.Encoding = 86, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0056, 
+	},
+	// W
+	{
+		.Name = "0057", 
+		.Encoding = 87, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0057, 
+	},
+	// X
+	{
+		.Name = "0058", 
+		.Encoding = 88, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0058, 
+	},
+	// Y
+	{
+		.Name = "0059", 
+		.Encoding = 89, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0059, 
+	},
+	// Z
+	{
+		.Name = "005A", 
+		.Encoding = 90, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_005A, 
+	},
+	// [
+	{
+		.Name = "005B", 
+		.Encoding = 91, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_005B, 
+	},
+	// back slash
+	{
+		.Name = "005C", 
+		.Encoding = 92, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 2, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_005C, 
+	},
+	// ]
+	{
+		.Name = "005D", 
+		.Encoding = 93, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_005D, 
+	},
+	// ^
+	{
+		.Name = "005E", 
+		.Encoding = 94, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 3, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 5, 
+		.nBytes = 3, 
+		.Bitmap = default_font_GlyphBitmap_005E, 
+	},
+	// _
+	{
+		.Name = "005F", 
+		.Encoding = 95, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 1, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 1, 
+		.Bitmap = default_font_GlyphBitmap_005F, 
+	},
+	// `
+	{
+		.Name = "0060", 
+		.Encoding = 96, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 3, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 5, 
+		.nBytes = 3, 
+		.Bitmap = default_font_GlyphBitmap_0060, 
+	},
+	// a
+	{
+		.Name = "0061", 
+		.Encoding = 97, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0061, 
+	},
+	// b
+	{
+		.Name = "0062", 
+		.Encoding = 98, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0062, 
+	},
+	// c
+	{
+		.Name = "0063", 
+		.Encoding = 99, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0063, 
+	},
+	// d
+	{
+		.Name = "0064", 
+		.Encoding = 100, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0064, 
+	},
+	// e
+	{
+		.Name = "0065", 
+		.Encoding = 101, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0065, 
+	},
+	// f
+	{
+		.Name = "0066", 
+		.Encoding = 102, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0066, 
+	},
+	// g
+	{
+		.Name = "0067", 
+		.Encoding = 103, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0067, 
+	},
+	// h
+	{
+		.Name = "0068", 
+		.Encoding = 104, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0068, 
+	},
+	// i
+	{
+		.Name = "0069", 
+		.Encoding = 105, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0069, 
+	},
+	// j
+	{
+		.Name = "006A", 
+		.Encoding = 106, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 4, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_006A, 
+	},
+	// k
+	{
+		.Name = "006B", 
+		.Encoding = 107, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 4, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_006B, 
+	},
+	// l
+	{
+		.Name = "006C", 
+		.Encoding = 108, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_006C, 
+	},
+	// m
+	{
+		.Name = "006D", 
+		.Encoding = 109, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_006D, 
+	},
+	// n
+	{
+		.Name = "006E", 
+		.Encoding = 110, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_006E, 
+	},
+	// o
+	{
+		.Name = "006F", 
+		.Encoding = 111, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_006F, 
+	},
+	// p
+	{
+		.Name = "0070", 
+		.Encoding = 112, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0070, 
+	},
+	// q
+	{
+		.Name = "0071", 
+		.Encoding = 113, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 6, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 6, 
+		.Bitmap = default_font_GlyphBitmap_0071, 
+	},
+	// r
+	{
+		.Name = "0072", 
+		.Encoding = 114, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0072, 
+	},
+	// s
+	{
+		.Name = "0073", 
+		.Encoding = 115, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0073, 
+	},
+	// t
+	{
+		.Name = "0074", 
+		.Encoding = 116, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 7, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_0074, 
+	},
+	// u
+	{
+		.Name = "0075", 
+		.Encoding = 117, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 6, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 6, 
+		.Bitmap = default_font_GlyphBitmap_0075, 
+	},
+	// v
+	{
+		.Name = "0076", 
+		.Encoding = 118, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0076, 
+	},
+	// w
+	{
+		.Name = "0077", 
+		.Encoding = 119, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0077, 
+	},
+	// x
+	{
+		.Name = "0078", 
+		.Encoding = 120, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0078, 
+	},
+	// y
+	{
+		.Name = "0079", 
+		.Encoding = 121, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_0079, 
+	},
+	// z
+	{
+		.Name = "007A", 
+		.Encoding = 122, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 5, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 1, 
+		.nBytes = 5, 
+		.Bitmap = default_font_GlyphBitmap_007A, 
+	},
+	// {
+	{
+		.Name = "007B", 
+		.Encoding = 123, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_007B, 
+	},
+	// |
+	{
+		.Name = "007C", 
+		.Encoding = 124, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 1, 
+		.BBh = 7, 
+		.BBxoff0x = 3, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_007C, 
+	},
+	// }
+	{
+		.Name = "007D", 
+		.Encoding = 125, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 3, 
+		.BBh = 7, 
+		.BBxoff0x = 2, 
+		.BByoff0y = 1, 
+		.nBytes = 7, 
+		.Bitmap = default_font_GlyphBitmap_007D, 
+	},
+	// ~
+	{
+		.Name = "007E", 
+		.Encoding = 126, 
+		.Swx0 = 1000, 
+		.Swy0 = 0, 
+		.Dwx0 = 7, 
+		.Dwy0 = 0, 
+		.BBw = 5, 
+		.BBh = 3, 
+		.BBxoff0x = 1, 
+		.BByoff0y = 5, 
+		.nBytes = 3, 
+		.Bitmap = default_font_GlyphBitmap_007E, 
+	},
+};
+
+/* 字体文件 */
+const Font_TypeDef default_font =
+{
+	.SpecVersion = "2.1",
+	.FontName = "Matrix 5x8",
+	.MetricsSet = 0,
+	.FontSize = 8,
+	.Xres = 72,
+	.Yres = 72,
+	.FBBx = 7,
+	.FBBy = 8,
+	.FBBXoff = 0,
+	.FBBYoff = 0,
+	.nChars = 95,
+	.Map = default_font_Map,
+	.Glyphs = default_font_Glyphs,
+};
+
+#endif
@@ -1,268 +1,375 @@
-/**
-  ******************************************************************************
-  * @file    pid.c
-  * @author  铁头山羊stm32工作组
-  * @version V1.0.0
-  * @date    2023年2月24日
-  * @brief   pid算法库
-  ******************************************************************************
-  * @attention
-  * Copyright (c) 2022 - 2023 东莞市明玉科技有限公司. 保留所有权力.
-  ******************************************************************************
-*/
-
-#include "pid.h"
-
-#define INVALID_TICK 0xffffffffffffffff
-
-//
-// @简介：初始化PID控制器
-// @参数：PID - PID算法句柄
-// @参数：PID_InitStruct - PID参数结构体
-// @返回：空
-//
-void PID_Init(PID_TypeDef *PID, PID_InitTypeDef *PID_InitStruct)
-{
-	PID->Init = *PID_InitStruct;
-	
-	PID->Setpoint = PID->Init.Setpoint;
-	PID->Kp = PID->Init.Kp;
-	PID->Ki = PID->Init.Ki;
-	PID->Kd = PID->Init.Kd;
-	PID->OutputLowerLimit = PID->Init.OutputLowerLimit;
-	PID->OutputUpperLimit = PID->Init.OutputUpperLimit;
-	PID->ITerm = PID->Init.DefaultOutput;
-	PID->LastTime = INVALID_TICK;
-	PID->LastInput = 0;
-	
-	PID->cmd = 0;
-	PID->LpfCmd = 0;
-}
-
-//
-// @简介：为PID控制器配置低通滤波器参数，该低通滤波器串联在PID输出上
-// @参数：Tf - 低通滤波器的时间常数
-//
-void PID_LpfConfig(PID_TypeDef *PID, float Tf, uint8_t NewState)
-{
-	PID->LpfCmd = NewState;
-	
-	LPF_Init(&PID->Lpf, Tf);
-}
-
-//
-// @简介：复位PID算法
-// @参数：PID - PID算法句柄
-// @返回：空
-// @注意：作用机理是强制让积分项等于默认输出
-//
-void PID_Reset(PID_TypeDef *PID)
-{
-	PID->LastTime = INVALID_TICK; // 标记PID控制器从未计算过
-	PID->ITerm = PID->Init.DefaultOutput; // 强制让积分项等于默认输出
-}
-
-//
-// @简介：执行一次PID运算并得出控制器当前的输出值
-// @参数：PID - PID控制器
-// @参数：Input  - 传感器的输入值
-// @参数：now - 当前时间，单位us
-// @返回：控制器当前的输出值
-//
-float PID_Compute1(PID_TypeDef *PID, float Input, uint64_t now)
-{
-	float error	= PID->Setpoint - Input;
-	float dt = (now - PID->LastTime) * 1.0e-6f; // Δt
-	
-	float output = PID->Kp * error; // 比例环节
-	
-	if(PID->LastTime != INVALID_TICK) // 非第一次初始化，或有I或D环节
-	{
-		if(PID->Kd != 0) // 计算微分环节
-		{
-			PID->DTerm = PID->Kd * (error - PID->LastError) / dt;
-			
-			output += PID->DTerm;
-		}
-		
-		if(PID->Ki != 0) // 计算积分环节
-		{
-			PID->ITerm += PID->Ki * (error + PID->LastError) * 0.5 * dt;
-			
-			// 积分限幅
-			if(PID->ITerm > PID->OutputUpperLimit)
-			{
-				PID->ITerm = PID->OutputUpperLimit;
-			}
-			else if(PID->ITerm < PID->OutputLowerLimit)
-			{
-				PID->ITerm = PID->OutputLowerLimit;
-			}
-			
-			output += PID->ITerm;
-		}
-	}
-	
-	// 输出限幅
-	if(output > PID->OutputUpperLimit)
-	{
-		output = PID->OutputUpperLimit;
-	}
-	else if(output < PID->OutputLowerLimit)
-	{
-		output = PID->OutputLowerLimit;
-	}
-	
-	PID->LastInput = Input;
-	PID->LastTime = now;
-	PID->LastError = error;
-	PID->LastOutput = output;
-	
-	if(PID->LpfCmd) // 如果使能了低通滤波器
-	{
-		output = LPF_Calc(&PID->Lpf, output, now);
-	}
-	
-	return output;
-}
-
-//
-// @简介：执行一次PID运算并得出控制器当前的输出值
-//        此方法与PID_Compute1相同，但需要用户提供dInput/Dt的值
-// @参数：PID - PID算法句柄
-// @参数：Input  - 传感器的输入值
-// @参数：dInputDt - 传感器输入的变化速度 dInput(k) = (Input(k) - Input(k-1)) / dt
-// @返回：控制器当前的输出值
-//
-float PID_Compute2(PID_TypeDef *PID, float Input, float dInputDt, uint64_t now)
-{
-	float error	= PID->Setpoint - Input;
-	float dt = (now - PID->LastTime) * 1.0e-6f;
-	
-	float output = PID->Kp * error;
-	
-	if(PID->LastTime != INVALID_TICK) // 非第一次初始化，或有I或D环节
-	{
-		if(PID->Kd != 0)
-		{
-			PID->DTerm = -PID->Kd * dInputDt;;
-			
-			output += PID->DTerm;
-		}
-		
-		if(PID->Ki != 0)
-		{
-			PID->ITerm += PID->Ki * (error + PID->LastError) * 0.5 * dt;
-			
-			if(PID->ITerm > PID->OutputUpperLimit)
-			{
-				PID->ITerm = PID->OutputUpperLimit;
-			}
-			else if(PID->ITerm < PID->OutputLowerLimit)
-			{
-				PID->ITerm = PID->OutputLowerLimit;
-			}
-			
-			output += PID->ITerm;
-		}
-	}
-	
-	if(output > PID->OutputUpperLimit)
-	{
-		output = PID->OutputUpperLimit;
-	}
-	else if(output < PID->OutputLowerLimit)
-	{
-		output = PID->OutputLowerLimit;
-	}
-	
-	PID->LastInput = Input;
-	PID->LastTime = now;
-	PID->LastError = error;
-	PID->LastOutput = output;
-	
-	if(PID->LpfCmd) // 如果使能了低通滤波器
-	{
-		output = LPF_Calc(&PID->Lpf, output, now);
-	}
-	
-	return output;
-}
-
-//
-// @简介：调节PID的参数（Kp, Ki和Kd）
-// @参数：PID - PID算法句柄
-// @参数：NewKp  - 新的比例系数Kp
-// @参数：NewKi  - 新的积分系数Ki
-// @参数：NewKd  - 新的微分系数Kd
-// @返回：空
-//
-void PID_ChangeTunings(PID_TypeDef *PID, float NewKp, float NewKi, float NewKd)
-{
-	PID->Kp = NewKp;
-	PID->Ki = NewKi;
-	PID->Kd = NewKd;
-}
-
-//
-// @简介：改变设定值SP
-// @参数：PID      - PID算法句柄
-// @参数：NewSetpoint - 新的设定值
-// @返回：空
-//
-void PID_ChangeSetpoint(PID_TypeDef *PID, float NewSetpoint)
-{
-	PID->Setpoint = NewSetpoint;
-}
-
-//
-// @简介：获取设定值SP
-// @参数：PID      - PID算法句柄
-// @返回：SP
-//
-float PID_GetSetpoint(PID_TypeDef *PID)
-{
-	return PID->Setpoint;
-}
-
-//
-// @简介：获取当前的PID参数
-// @参数：PID - PID算法句柄
-// @参数：pKpOut - 输出参数，用于输出Kp的值
-// @参数：pKiOut - 输出参数，用于输出Ki的值
-// @参数：pKdOut - 输出参数，用于输出Kd的值
-// @返回：空
-//
-void PID_GetTunings(PID_TypeDef *PID, float *pKpOut, float *pKiOut, float *pKdOut)
-{
-	*pKpOut = PID->Kp;
-	*pKiOut = PID->Ki;
-	*pKdOut = PID->Kd;
-}
-
-//
-// @简介：使能/禁止PID
-// @参数：PID   - PID算法句柄
-// @参数：NewState - 非零 - 使能，0 - 禁止
-// @返回：空
-// @注意：PID被禁止后会进入手动模式。手动模式下的输出由PID_ChangeManualOutput设置
-//
-void PID_Cmd(PID_TypeDef *PID, uint8_t NewState)
-{
-	if(PID->cmd == 0 && NewState == 1) // 关闭 -> 开启
-	{
-		PID->ITerm = PID->Init.DefaultOutput;
-		
-		if(PID->ITerm > PID->OutputUpperLimit)
-		{
-			PID->ITerm = PID->OutputUpperLimit;
-		}
-		
-		if(PID->ITerm < PID->OutputLowerLimit)
-		{
-			PID->ITerm = PID->OutputLowerLimit;
-		}
-	}
-	
-	PID->cmd = NewState;
-}
+/**
+  ******************************************************************************
+  * @file    pid.c
+  * @author  铁头山羊stm32工作组
+  * @version V1.0.0
+  * @date    2023年2月24日
+  * @brief   pid算法库
+  ******************************************************************************
+  * @attention
+  * Copyright (c) 2022 - 2023 东莞市明玉科技有限公司. 保留所有权力.
+  ******************************************************************************
+*/
+
+#include "pid.h"
+#include "delay.h"
+
+//
+// @简介：初始化PID控制器
+// @参数：PID - PID算法句柄
+// @参数：PID_InitStruct - PID参数结构体
+// @返回：空
+//
+void PID_Init(PID_TypeDef *PID, PID_InitTypeDef *PID_InitStruct)
+{
+	PID->Init = *PID_InitStruct;
+	
+	PID->Setpoint = PID->Init.Setpoint;
+	PID->Kp = PID->Init.Kp;
+	PID->Ki = PID->Init.Ki;
+	PID->Kd = PID->Init.Kd;
+	PID->OutputLowerLimit = PID->Init.OutputLowerLimit;
+	PID->OutputUpperLimit = PID->Init.OutputUpperLimit;
+	PID->ITerm = PID->Init.DefaultOutput;
+	PID->FirstCompute = 1;
+	PID->LastInput = 0;
+	
+	PID->cmd = 0;
+	PID->LpfCmd = 0;
+	
+	PID->Ts = 0;
+}
+
+//
+// @简介：以固定运算周期初始化PID控制器，之后使用PID_ComputeFixedRate计算
+// @参数：PID - PID算法句柄
+// @参数：PID_InitStruct - PID参数结构体
+// @参数：Ts - 运算周期，单位s
+//
+void PID_InitFixedRate(PID_TypeDef *PID, PID_InitTypeDef *PID_InitStruct, float Ts)
+{
+	PID_Init(PID, PID_InitStruct);
+	PID_ChangeRate(PID, Ts);
+}
+
+//
+// @简介：修改固定运算周期，并重新计算离散系数
+// @参数：PID - PID算法句柄
+// @参数：Ts - 运算周期，单位s
+//
+void PID_ChangeRate(PID_TypeDef *PID, float Ts)
+{
+	PID->Ts = Ts;
+	PID->KiT = PID->Ki * 0.5f * Ts;
+	PID->KdT = PID->Kd / Ts;
+	
+	if(PID->LpfCmd)
+	{
+		PID->Lpf.Alpha = Ts / PID->Lpf.Tf;
+	}
+}
+
+//
+// @简介：为PID控制器配置低通滤波器参数，该低通滤波器串联在PID输出上
+// @参数：Tf - 低通滤波器的时间常数
+//
+void PID_LpfConfig(PID_TypeDef *PID, float Tf, uint8_t NewState)
+{
+	PID->LpfCmd = NewState;
+	
+	if(PID->Ts != 0)
+	{
+		LPF_InitFixedRate(&PID->Lpf, Tf, PID->Ts);
+	}
+	else
+	{
+		LPF_Init(&PID->Lpf, Tf);
+	}
+}
+
+//
+// @简介：复位PID算法
+// @参数：PID - PID算法句柄
+// @返回：空
+// @注意：作用机理是强制让积分项等于默认输出
+//
+void PID_Reset(PID_TypeDef *PID)
+{
+	PID->FirstCompute = 1; // 标记PID控制器从未计算过
+	PID->ITerm = PID->Init.DefaultOutput; // 强制让积分项等于默认输出
+}
+
+//
+// @简介：执行一次PID运算并得出控制器当前的输出值
+// @参数：PID - PID控制器
+// @参数：Input  - 传感器的输入值
+// @参数：now - 当前时间，单位us
+// @返回：控制器当前的输出值
+//
+float PID_Compute1(PID_TypeDef *PID, float Input, uint32_t now)
+{
+	float error	= PID->Setpoint - Input;
+	float dt = Time_UsToSec(Time_Diff(now, PID->LastTime)); // Δt
+	
+	float output = PID->Kp * error; // 比例环节
+	
+	if(!PID->FirstCompute) // 非第一次初始化，或有I或D环节
+	{
+		if(PID->Kd != 0) // 计算微分环节
+		{
+			PID->DTerm = PID->Kd * (error - PID->LastError) / dt;
+			
+			output += PID->DTerm;
+		}
+		
+		if(PID->Ki != 0) // 计算积分环节
+		{
+			PID->ITerm += PID->Ki * (error + PID->LastError) * 0.5f * dt;
+			
+			// 积分限幅
+			if(PID->ITerm > PID->OutputUpperLimit)
+			{
+				PID->ITerm = PID->OutputUpperLimit;
+			}
+			else if(PID->ITerm < PID->OutputLowerLimit)
+			{
+				PID->ITerm = PID->OutputLowerLimit;
+			}
+			
+			output += PID->ITerm;
+		}
+	}
+	
+	// 输出限幅
+	if(output > PID->OutputUpperLimit)
+	{
+		output = PID->OutputUpperLimit;
+	}
+	else if(output < PID->OutputLowerLimit)
+	{
+		output = PID->OutputLowerLimit;
+	}
+	
+	PID->LastInput = Input;
+	PID->LastTime = now;
+	PID->FirstCompute = 0;
+	PID->LastError = error;
+	PID->LastOutput = output;
+	
+	if(PID->LpfCmd) // 如果使能了低通滤波器
+	{
+		output = LPF_Calc(&PID->Lpf, output, now);
+	}
+	
+	return output;
+}
+
+//
+// @简介：执行一次PID运算并得出控制器当前的输出值
+//        此方法与PID_Compute1相同，但需要用户提供dInput/Dt的值
+// @参数：PID - PID算法句柄
+// @参数：Input  - 传感器的输入值
+// @参数：dInputDt - 传感器输入的变化速度 dInput(k) = (Input(k) - Input(k-1)) / dt
+// @返回：控制器当前的输出值
+//
+float PID_Compute2(PID_TypeDef *PID, float Input, float dInputDt, uint32_t now)
+{
+	float error	= PID->Setpoint - Input;
+	float dt = Time_UsToSec(Time_Diff(now, PID->LastTime));
+	
+	float output = PID->Kp * error;
+	
+	if(!PID->FirstCompute) // 非第一次初始化，或有I或D环节
+	{
+		if(PID->Kd != 0)
+		{
+			PID->DTerm = -PID->Kd * dInputDt;;
+			
+			output += PID->DTerm;
+		}
+		
+		if(PID->Ki != 0)
+		{
+			PID->ITerm += PID->Ki * (error + PID->LastError) * 0.5f * dt;
+			
+			if(PID->ITerm > PID->OutputUpperLimit)
+			{
+				PID->ITerm = PID->OutputUpperLimit;
+			}
+			else if(PID->ITerm < PID->OutputLowerLimit)
+			{
+				PID->ITerm = PID->OutputLowerLimit;
+			}
+			
+			output += PID->ITerm;
+		}
+	}
+	
+	if(output > PID->OutputUpperLimit)
+	{
+		output = PID->OutputUpperLimit;
+	}
+	else if(output < PID->OutputLowerLimit)
+	{
+		output = PID->OutputLowerLimit;
+	}
+	
+	PID->LastInput = Input;
+	PID->LastTime = now;
+	PID->FirstCompute = 0;
+	PID->LastError = error;
+	PID->LastOutput = output;
+	
+	if(PID->LpfCmd) // 如果使能了低通滤波器
+	{
+		output = LPF_Calc(&PID->Lpf, output, now);
+	}
+	
+	return output;
+}
+
+//
+// @简介：以固定周期执行一次PID运算，结果与Δt=Ts时的PID_Compute1相同
+//        Ki*Δt/2和Kd/Δt已由PID_ChangeRate预先算好，此处只有乘加运算
+// @参数：PID - PID控制器，须由PID_InitFixedRate初始化
+// @参数：Input  - 传感器的输入值
+// @返回：控制器当前的输出值
+//
+float PID_ComputeFixedRate(PID_TypeDef *PID, float Input)
+{
+	float error	= PID->Setpoint - Input;
+	
+	float output = PID->Kp * error; // 比例环节
+	
+	if(!PID->FirstCompute)
+	{
+		if(PID->Kd != 0) // 计算微分环节
+		{
+			PID->DTerm = PID->KdT * (error - PID->LastError);
+			
+			output += PID->DTerm;
+		}
+		
+		if(PID->Ki != 0) // 计算积分环节
+		{
+			PID->ITerm += PID->KiT * (error + PID->LastError);
+			
+			// 积分限幅
+			if(PID->ITerm > PID->OutputUpperLimit)
+			{
+				PID->ITerm = PID->OutputUpperLimit;
+			}
+			else if(PID->ITerm < PID->OutputLowerLimit)
+			{
+				PID->ITerm = PID->OutputLowerLimit;
+			}
+			
+			output += PID->ITerm;
+		}
+	}
+	
+	// 输出限幅
+	if(output > PID->OutputUpperLimit)
+	{
+		output = PID->OutputUpperLimit;
+	}
+	else if(output < PID->OutputLowerLimit)
+	{
+		output = PID->OutputLowerLimit;
+	}
+	
+	PID->LastInput = Input;
+	PID->FirstCompute = 0;
+	PID->LastError = error;
+	PID->LastOutput = output;
+	
+	if(PID->LpfCmd) // 如果使能了低通滤波器
+	{
+		output = LPF_CalcFixedRate(&PID->Lpf, output);
+	}
+	
+	return output;
+}
+
+//
+// @简介：调节PID的参数（Kp, Ki和Kd）
+// @参数：PID - PID算法句柄
+// @参数：NewKp  - 新的比例系数Kp
+// @参数：NewKi  - 新的积分系数Ki
+// @参数：NewKd  - 新的微分系数Kd
+// @返回：空
+//
+void PID_ChangeTunings(PID_TypeDef *PID, float NewKp, float NewKi, float NewKd)
+{
+	PID->Kp = NewKp;
+	PID->Ki = NewKi;
+	PID->Kd = NewKd;
+	
+	if(PID->Ts != 0) // 固定周期模式下同步更新离散系数
+	{
+		PID_ChangeRate(PID, PID->Ts);
+	}
+}
+
+//
+// @简介：改变设定值SP
+// @参数：PID      - PID算法句柄
+// @参数：NewSetpoint - 新的设定值
+// @返回：空
+//
+void PID_ChangeSetpoint(PID_TypeDef *PID, float NewSetpoint)
+{
+	PID->Setpoint = NewSetpoint;
+}
+
+//
+// @简介：获取设定值SP
+// @参数：PID      - PID算法句柄
+// @返回：SP
+//
+float PID_GetSetpoint(PID_TypeDef *PID)
+{
+	return PID->Setpoint;
+}
+
+//
+// @简介：获取当前的PID参数
+// @参数：PID - PID算法句柄
+// @参数：pKpOut - 输出参数，用于输出Kp的值
+// @参数：pKiOut - 输出参数，用于输出Ki的值
+// @参数：pKdOut - 输出参数，用于输出Kd的值
+// @返回：空
+//
+void PID_GetTunings(PID_TypeDef *PID, float *pKpOut, float *pKiOut, float *pKdOut)
+{
+	*pKpOut = PID->Kp;
+	*pKiOut = PID->Ki;
+	*pKdOut = PID->Kd;
+}
+
+//
+// @简介：使能/禁止PID
+// @参数：PID   - PID算法句柄
+// @参数：NewState - 非零 - 使能，0 - 禁止
+// @返回：空
+// @注意：PID被禁止后会进入手动模式。手动模式下的输出由PID_ChangeManualOutput设置
+//
+void PID_Cmd(PID_TypeDef *PID, uint8_t NewState)
+{
+	if(PID->cmd == 0 && NewState == 1) // 关闭 -> 开启
+	{
+		PID->ITerm = PID->Init.DefaultOutput;
+		
+		if(PID->ITerm > PID->OutputUpperLimit)
+		{
+			PID->ITerm = PID->OutputUpperLimit;
+		}
+		
+		if(PID->ITerm < PID->OutputLowerLimit)
+		{
+			PID->ITerm = PID->OutputLowerLimit;
+		}
+	}
+	
+	PID->cmd = NewState;
+}
@@ -1,58 +1,65 @@
-/**
-  ******************************************************************************
-  * @file    pid.h
-  * @author  铁头山羊stm32工作组
-  * @version V1.0.0
-  * @date    2024年10月27日
-  * @brief   pid算法库
-  ******************************************************************************
-  * @attention
-  * Copyright (c) 2024 -  东莞市明玉科技有限公司. 保留所有权力.
-  ******************************************************************************
-*/
-
-#ifndef _PID_H_
-#define _PID_H_
-
-#include <stdint.h>
-#include "lpf.h"
-
-typedef struct{
-	float Kp; // 比例环节系数 Kp
-	float Ki; // 积分环节系数 Ki
-	float Kd; // 微分环节系数 Kd
-	float Setpoint; // PID的参考值
-	float OutputUpperLimit; // 输出上限
-	float OutputLowerLimit; // 输出下限
-	float DefaultOutput; // 默认输出值
-}PID_InitTypeDef;
-
-typedef struct{
-	PID_InitTypeDef Init;
-	uint8_t cmd; // 0 - PID禁止 1 - PID使能
-	uint64_t LastTime; // PID上次运行的时间，用于计算Δt
-	float LastOutput;  // PID上次的输出
-	float ITerm; // 积分项
-	float DTerm; // 微分项
-	float LastInput; // 上次的输入值
-	float LastError; // 上次的误差值
-	float Kp;
-	float Ki; 
-	float Kd; 
-	float OutputUpperLimit;
-	float OutputLowerLimit;
-	float Setpoint;
-	LPF_TypeDef Lpf; // 低通滤波器，该滤波器级联在PID的输出端
-	uint8_t LpfCmd; // 低通滤波器开关，0-禁止，1-使能
-}PID_TypeDef;
-
- void PID_Init(PID_TypeDef *PID, PID_InitTypeDef *PID_InitStruct);
- void PID_LpfConfig(PID_TypeDef *PID, float Tf, uint8_t NewState);
- void PID_Cmd(PID_TypeDef *PID, uint8_t NewState);
- void PID_Reset(PID_TypeDef *PID);
-float PID_Compute1(PID_TypeDef *PID, float Input, uint64_t Now);
-float PID_Compute2(PID_TypeDef *PID, float Input, float dInput, uint64_t Now);
- void PID_ChangeTunings(PID_TypeDef *PID, float NewKp, float NewKi, float NewKd);
- void PID_ChangeSetpoint(PID_TypeDef *PID, float NewSetpoint);
-
-#endif
+/**
+  ******************************************************************************
+  * @file    pid.h
+  * @author  铁头山羊stm32工作组
+  * @version V1.0.0
+  * @date    2024年10月27日
+  * @brief   pid算法库
+  ******************************************************************************
+  * @attention
+  * Copyright (c) 2024 -  东莞市明玉科技有限公司. 保留所有权力.
+  ******************************************************************************
+*/
+
+#ifndef _PID_H_
+#define _PID_H_
+
+#include <stdint.h>
+#include "lpf.h"
+
+typedef struct{
+	float Kp; // 比例环节系数 Kp
+	float Ki; // 积分环节系数 Ki
+	float Kd; // 微分环节系数 Kd
+	float Setpoint; // PID的参考值
+	float OutputUpperLimit; // 输出上限
+	float OutputLowerLimit; // 输出下限
+	float DefaultOutput; // 默认输出值
+}PID_InitTypeDef;
+
+typedef struct{
+	PID_InitTypeDef Init;
+	uint8_t cmd; // 0 - PID禁止 1 - PID使能
+	uint32_t LastTime; // PID上次运行的时间，用于计算Δt
+	uint8_t FirstCompute; // 1 - PID从未计算过
+	float LastOutput;  // PID上次的输出
+	float ITerm; // 积分项
+	float DTerm; // 微分项
+	float LastInput; // 上次的输入值
+	float LastError; // 上次的误差值
+	float Kp;
+	float Ki; 
+	float Kd; 
+	float OutputUpperLimit;
+	float OutputLowerLimit;
+	float Setpoint;
+	LPF_TypeDef Lpf; // 低通滤波器，该滤波器级联在PID的输出端
+	uint8_t LpfCmd; // 低通滤波器开关，0-禁止，1-使能
+	float Ts; // 固定运算周期，单位s，0表示变周期（使用PID_Compute1/2）
+	float KiT; // 固定周期下的离散积分系数 Ki*Ts/2
+	float KdT; // 固定周期下的离散微分系数 Kd/Ts
+}PID_TypeDef;
+
+ void PID_Init(PID_TypeDef *PID, PID_InitTypeDef *PID_InitStruct);
+ void PID_LpfConfig(PID_TypeDef *PID, float Tf, uint8_t NewState);
+ void PID_Cmd(PID_TypeDef *PID, uint8_t NewState);
+ void PID_Reset(PID_TypeDef *PID);
+float PID_Compute1(PID_TypeDef *PID, float Input, uint32_t Now);
+float PID_Compute2(PID_TypeDef *PID, float Input, float dInput, uint32_t Now);
+ void PID_InitFixedRate(PID_TypeDef *PID, PID_InitTypeDef *PID_InitStruct, float Ts);
+ void PID_ChangeRate(PID_TypeDef *PID, float Ts);
+float PID_ComputeFixedRate(PID_TypeDef *PID, float Input);
+ void PID_ChangeTunings(PID_TypeDef *PID, float NewKp, float NewKi, float NewKd);
+ void PID_ChangeSetpoint(PID_TypeDef *PID, float NewSetpoint);
+
+#endif
@@ -0,0 +1,92 @@
+/**
+  ******************************************************************************
+  * @file    pt.h
+  * @version V 1.0.0
+  * @brief   无栈协程（protothread），把需要等待的多步操作按顺序写成一个函数，
+  *          等待时返回，下次调用时从返回的位置继续，不阻塞主循环。
+  *          协程函数由任务函数（PERIODIC之后）反复调用，等待的时间与PERIODIC使用同一个时基（GetTick）。
+  *
+  *          static uint8_t Blink(PT_TypeDef *pt)
+  *          {
+  *              PT_BEGIN(pt);
+  *              LED_On();
+  *              PT_DELAY(pt, 500);                     // 等待500ms
+  *              LED_Off();
+  *              PT_WAIT_UNTIL(pt, Button_Pressed());   // 等待条件成立
+  *              PT_END(pt);
+  *          }
+  *
+  *          用switch实现（case __LINE__），因此有以下限制：
+  *          1. 局部变量在等待后不保留，跨过等待使用的变量须为static或放在结构体中
+  *          2. 协程函数中不能使用switch语句，每行最多一个PT_xxx宏
+  *          3. 不能在循环以外用break跳出
+  ******************************************************************************
+  */
+
+#ifndef _PT_H_
+#define _PT_H_
+
+#include "delay.h"
+
+typedef struct
+{
+	uint16_t Line;  // 继续执行的位置（行号），0表示从头开始
+	uint32_t Start; // PT_TIMER_START的时刻，单位ms
+} PT_TypeDef;
+
+// 协程函数的返回值
+#define PT_WAITING 0 // 正在等待，需要再次调用
+#define PT_ENDED   1 // 已执行完毕（PT_END或PT_EXIT），再次调用时从头开始
+
+//
+// @简介：初始化，下次调用时从头开始执行
+//
+#define PT_INIT(pt) do { (pt)->Line = 0; } while(0)
+
+//
+// @简介：协程函数体的开始和结束，函数返回uint8_t（PT_WAITING或PT_ENDED）
+//
+#define PT_BEGIN(pt) switch((pt)->Line) { case 0:
+
+#define PT_END(pt) } (pt)->Line = 0; return PT_ENDED
+
+//
+// 顺序执行到下一个case标号是有意的，告知编译器，避免-Wimplicit-fallthrough警告
+//
+#if defined(__GNUC__) && __GNUC__ >= 7
+#define PT_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define PT_FALLTHROUGH
+#endif
+
+//
+// @简介：等待条件成立，每次调用时检查一次，条件已经成立时不返回
+//
+#define PT_WAIT_UNTIL(pt, cond) \
+do { (pt)->Line = __LINE__; PT_FALLTHROUGH; case __LINE__: if(!(cond)) return PT_WAITING; } while(0)
+
+//
+// @简介：让出一次，下次调用时继续
+//
+#define PT_YIELD(pt) \
+do { (pt)->Line = __LINE__; return PT_WAITING; case __LINE__:; } while(0)
+
+//
+// @简介：结束执行，下次调用时从头开始
+//
+#define PT_EXIT(pt) do { (pt)->Line = 0; return PT_ENDED; } while(0)
+
+//
+// @简介：计时，PT_TIMER_START记下当前时刻，PT_ELAPSED为此后经过的时间，单位ms
+//
+#define PT_TIMER_START(pt) do { (pt)->Start = GetTick(); } while(0)
+
+#define PT_ELAPSED(pt) Time_Diff(GetTick(), (pt)->Start)
+
+//
+// @简介：等待一段时间，单位ms
+//
+#define PT_DELAY(pt, ms) \
+do { PT_TIMER_START(pt); PT_WAIT_UNTIL(pt, PT_ELAPSED(pt) >= (ms)); } while(0)
+
+#endif
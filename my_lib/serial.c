@@ -0,0 +1,556 @@
+/**
+  ******************************************************************************
+  * @file    serial.c
+  * @version V 1.0.0
+  * @brief   不阻塞的串口驱动
+  *          发送队列的写入方每次预留一段连续空间（队列尾部放不下时从队列开头预留，
+  *          尾部剩余的空间本轮不再使用），因此DMA每次只需发送一段连续的数据；
+  *          接收缓冲区的写入位置由DMA的剩余计数得出，在半满、全满和空闲线中断中更新，
+  *          据此累计写入的字节数，与读出的字节数比较即可知道是否被覆盖
+  ******************************************************************************
+  */
+
+#include "serial.h"
+#include "usart.h"
+#include "delay.h"
+#include <string.h>
+
+#define SERIAL_MAX_PORTS 3
+
+static Serial_TypeDef *ports[SERIAL_MAX_PORTS]; // 已初始化的串口，供My_USART_SendBytes等查找
+
+static uint32_t Lock(void);
+static void     Unlock(uint32_t Primask);
+static uint32_t DMA_Index(DMA_Channel_TypeDef *DMAy_Channelx);
+static void     NVIC_Config(uint8_t IRQChannel, uint8_t Priority);
+static void     StartTx(Serial_TypeDef *Serial);
+static void     RxUpdate(Serial_TypeDef *Serial);
+static Serial_TypeDef *FindPort(USART_TypeDef *USARTx);
+
+//
+// @简介：初始化串口的收发队列
+// @参数：Serial - 串口句柄
+// @参数：Serial_InitStruct - 初始化参数
+// @注意：调用前须完成引脚、串口时钟和串口参数的配置；DMA通道须是该串口对应的通道，
+//        USART1 - TX DMA1_Channel4 / RX DMA1_Channel5
+//        USART2 - TX DMA1_Channel7 / RX DMA1_Channel6
+//        USART3 - TX DMA1_Channel2 / RX DMA1_Channel3
+//
+void My_Serial_Init(Serial_TypeDef *Serial, Serial_InitTypeDef *Serial_InitStruct)
+{
+	memset(Serial, 0, sizeof(Serial_TypeDef));
+
+	Serial->Init = *Serial_InitStruct;
+	Serial->TxWrap = Serial->Init.TxBufferSize;
+
+	USART_TypeDef *USARTx = Serial->Init.USARTx;
+	uint8_t priority = Serial->Init.NVIC_IRQChannelPreemptionPriority;
+
+	for(uint8_t i=0; i<SERIAL_MAX_PORTS; i++)
+	{
+		if(ports[i] == NULL || ports[i]->Init.USARTx == USARTx)
+		{
+			ports[i] = Serial;
+			break;
+		}
+	}
+
+	RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+	DMA_InitTypeDef DMA_InitStruct;
+
+	DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t)&USARTx->DR;
+	DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+	DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA_InitStruct.DMA_Priority = DMA_Priority_Medium;
+	DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;
+
+	// #1. 发送，DMA每次发送一段连续的数据，完成中断中启动下一段
+	if(Serial->Init.TxDMAy_Channelx != NULL)
+	{
+		DMA_Cmd(Serial->Init.TxDMAy_Channelx, DISABLE);
+
+		DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)Serial->Init.pTxBuffer;
+		DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralDST;
+		DMA_InitStruct.DMA_BufferSize = 0;
+		DMA_InitStruct.DMA_Mode = DMA_Mode_Normal;
+		DMA_Init(Serial->Init.TxDMAy_Channelx, &DMA_InitStruct);
+
+		DMA_ITConfig(Serial->Init.TxDMAy_Channelx, DMA_IT_TC, ENABLE);
+		NVIC_Config(DMA1_Channel1_IRQn + DMA_Index(Serial->Init.TxDMAy_Channelx), priority);
+
+		USART_DMACmd(USARTx, USART_DMAReq_Tx, ENABLE);
+	}
+
+	// #2. 接收，DMA循环写入，半满和全满时各更新一次写入位置，保证不会漏算整圈
+	if(Serial->Init.RxDMAy_Channelx != NULL)
+	{
+		DMA_Cmd(Serial->Init.RxDMAy_Channelx, DISABLE);
+
+		DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)Serial->Init.pRxBuffer;
+		DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralSRC;
+		DMA_InitStruct.DMA_BufferSize = Serial->Init.RxBufferSize;
+		DMA_InitStruct.DMA_Mode = DMA_Mode_Circular;
+		DMA_Init(Serial->Init.RxDMAy_Channelx, &DMA_InitStruct);
+
+		DMA_ITConfig(Serial->Init.RxDMAy_Channelx, DMA_IT_HT | DMA_IT_TC, ENABLE);
+		NVIC_Config(DMA1_Channel1_IRQn + DMA_Index(Serial->Init.RxDMAy_Channelx), priority);
+
+		USART_DMACmd(USARTx, USART_DMAReq_Rx, ENABLE);
+
+		DMA_Cmd(Serial->Init.RxDMAy_Channelx, ENABLE);
+	}
+	else
+	{
+		USART_ITConfig(USARTx, USART_IT_RXNE, ENABLE);
+	}
+
+	// #3. 空闲线中断
+	USART_ITConfig(USARTx, USART_IT_IDLE, ENABLE);
+
+	NVIC_Config(USARTx == USART1 ? USART1_IRQn : USARTx == USART2 ? USART2_IRQn : USART3_IRQn, priority);
+}
+
+//
+// @简介：在发送队列中预留一段连续的空间，由调用者直接填写数据，然后调用My_Serial_TxCommit发送
+// @参数：Serial - 串口句柄
+// @参数：Size - 需要的字节数，须小于发送队列的长度
+// @返回值：预留空间的起始地址，NULL表示队列已满（计入TxOverrun）
+// @注意：可以在中断中调用。预留和提交之间不能有其它写入方预留空间，
+//        多个写入方（例如主循环和中断）时须在同一个临界区内完成预留、填写和提交
+//
+uint8_t *My_Serial_TxReserve(Serial_TypeDef *Serial, uint16_t Size)
+{
+	uint8_t *p = NULL;
+	uint32_t primask = Lock();
+
+	uint16_t head = Serial->TxHead;
+	uint16_t tail = Serial->TxTail;
+
+	if(head == tail && Serial->TxBusy == 0) // 队列为空，从头开始，避免无谓的回绕
+	{
+		head = tail = 0;
+		Serial->TxHead = Serial->TxTail = 0;
+		Serial->TxWrap = Serial->Init.TxBufferSize;
+	}
+
+	if(Size == 0 || Size >= Serial->Init.TxBufferSize)
+	{
+		// 不可能放得下
+	}
+	else if(head >= tail) // 未回绕，空闲空间为[head, 末尾)和[0, tail)
+	{
+		if(Serial->Init.TxBufferSize - head >= Size)
+		{
+			Serial->TxReserveWrap = 0;
+			p = Serial->Init.pTxBuffer + head;
+		}
+		else if(tail > Size) // 回绕后head不能追上tail，否则与队列为空无法区分
+		{
+			Serial->TxReserveWrap = 1;
+			p = Serial->Init.pTxBuffer;
+		}
+	}
+	else if(tail - head > Size) // 已回绕，空闲空间为[head, tail)
+	{
+		Serial->TxReserveWrap = 0;
+		p = Serial->Init.pTxBuffer + head;
+	}
+
+	if(p == NULL)
+	{
+		Serial->TxOverrun += Size;
+	}
+
+	Unlock(primask);
+
+	return p;
+}
+
+//
+// @简介：提交预留的空间，开始发送
+// @参数：Serial - 串口句柄
+// @参数：Size - 实际填写的字节数，不能超过预留时的Size
+//
+void My_Serial_TxCommit(Serial_TypeDef *Serial, uint16_t Size)
+{
+	uint32_t primask = Lock();
+
+	if(Serial->TxReserveWrap)
+	{
+		Serial->TxWrap = Serial->TxHead;
+		Serial->TxHead = Size;
+		Serial->TxReserveWrap = 0;
+	}
+	else
+	{
+		Serial->TxHead += Size;
+	}
+
+	StartTx(Serial);
+
+	Unlock(primask);
+}
+
+//
+// @简介：把数据复制到发送队列，立即返回
+// @参数：Serial - 串口句柄
+// @参数：pData - 要发送的数据
+// @参数：Size - 数据的长度
+// @返回值：写入的字节数，队列放不下时整段丢弃，返回0
+// @注意：可以在中断中调用，复制期间关中断
+//
+uint16_t My_Serial_Write(Serial_TypeDef *Serial, const void *pData, uint16_t Size)
+{
+	uint32_t primask = Lock();
+
+	uint8_t *p = My_Serial_TxReserve(Serial, Size);
+
+	if(p != NULL)
+	{
+		memcpy(p, pData, Size);
+		My_Serial_TxCommit(Serial, Size);
+	}
+
+	Unlock(primask);
+
+	return p != NULL ? Size : 0;
+}
+
+//
+// @简介：获取发送队列中一次最多能预留的字节数
+//
+uint16_t My_Serial_GetTxFree(Serial_TypeDef *Serial)
+{
+	uint32_t primask = Lock();
+
+	uint16_t head = Serial->TxHead;
+	uint16_t tail = Serial->TxTail;
+	uint16_t size = Serial->Init.TxBufferSize;
+	uint16_t free;
+
+	if(head == tail && Serial->TxBusy == 0)
+	{
+		free = size - 1;
+	}
+	else if(head >= tail)
+	{
+		uint16_t end = size - head;
+		uint16_t start = tail > 0 ? tail - 1 : 0;
+
+		free = end > start ? end : start;
+	}
+	else
+	{
+		free = tail - head - 1;
+	}
+
+	Unlock(primask);
+
+	return free;
+}
+
+//
+// @简介：读出接收到的数据
+// @参数：Serial - 串口句柄
+// @参数：pDataOut - 输出参数，读出的数据
+// @参数：MaxSize - 最多读出的字节数
+// @返回值：实际读出的字节数
+// @注意：两次读取之间收到的数据超过接收缓冲区的长度时，最早的数据被覆盖，
+//        只能读到最近的RxBufferSize个字节，丢失的字节计入RxOverrun
+//
+uint16_t My_Serial_Read(Serial_TypeDef *Serial, void *pDataOut, uint16_t MaxSize)
+{
+	uint16_t size = Serial->Init.RxBufferSize;
+	uint8_t *p = (uint8_t *)pDataOut;
+
+	uint32_t primask = Lock();
+
+	RxUpdate(Serial);
+
+	uint32_t avail = Serial->RxWritten - Serial->RxRead;
+	uint16_t idx = (Serial->RxPos + size - (avail > size ? size : avail)) % size;
+
+	if(avail > size)
+	{
+		Serial->RxOverrun += avail - size;
+		Serial->RxRead = Serial->RxWritten - size;
+		avail = size;
+	}
+
+	Unlock(primask);
+
+	uint16_t n = avail < MaxSize ? avail : MaxSize;
+
+	for(uint16_t i=0; i<n; i++)
+	{
+		p[i] = Serial->Init.pRxBuffer[idx];
+
+		if(++idx == size) idx = 0;
+	}
+
+	Serial->RxRead += n;
+
+	return n;
+}
+
+//
+// @简介：获取接收缓冲区中尚未读出的字节数
+//
+uint16_t My_Serial_GetRxCount(Serial_TypeDef *Serial)
+{
+	uint32_t primask = Lock();
+
+	RxUpdate(Serial);
+
+	uint32_t avail = Serial->RxWritten - Serial->RxRead;
+
+	Unlock(primask);
+
+	return avail > Serial->Init.RxBufferSize ? Serial->Init.RxBufferSize : avail;
+}
+
+//
+// @简介：查询自上次调用以来是否检测到空闲线（对方发完一帧数据）
+// @返回值：1 - 检测到，0 - 没有
+//
+uint8_t My_Serial_RxIdle(Serial_TypeDef *Serial)
+{
+	uint8_t idle = Serial->RxIdle;
+
+	Serial->RxIdle = 0;
+
+	return idle;
+}
+
+//
+// @简介：串口中断，在USARTx_IRQHandler中调用
+//
+void My_Serial_IRQHandler(Serial_TypeDef *Serial)
+{
+	USART_TypeDef *USARTx = Serial->Init.USARTx;
+	uint16_t sr = USARTx->SR; // 只读一次，之后读DR即清除空闲线和错误标志
+	uint8_t drRead = 0;
+
+	if(sr & (USART_FLAG_ORE | USART_FLAG_FE | USART_FLAG_NE))
+	{
+		Serial->RxErrors++;
+	}
+
+	// 不使用DMA接收时逐字节写入缓冲区
+	if(Serial->Init.RxDMAy_Channelx == NULL && (sr & USART_FLAG_RXNE))
+	{
+		Serial->Init.pRxBuffer[Serial->RxPos] = USART_ReceiveData(USARTx);
+		Serial->RxPos = Serial->RxPos + 1 == Serial->Init.RxBufferSize ? 0 : Serial->RxPos + 1;
+		Serial->RxWritten++;
+		drRead = 1;
+	}
+
+	if(sr & (USART_FLAG_IDLE | USART_FLAG_ORE | USART_FLAG_FE | USART_FLAG_NE))
+	{
+		if(!drRead) (void)USART_ReceiveData(USARTx); // 已经读过DR时不能再读，否则可能取走刚收到的字节
+
+		RxUpdate(Serial);
+
+		if(sr & USART_FLAG_IDLE) Serial->RxIdle = 1;
+	}
+
+	// 不使用DMA发送时逐字节发送
+	if(Serial->Init.TxDMAy_Channelx == NULL && (USARTx->CR1 & USART_CR1_TXEIE) && (sr & USART_FLAG_TXE))
+	{
+		uint16_t head = Serial->TxHead;
+		uint16_t tail = Serial->TxTail;
+
+		if(head < tail && tail >= Serial->TxWrap) tail = 0;
+
+		if(head == tail)
+		{
+			USART_ITConfig(USARTx, USART_IT_TXE, DISABLE);
+		}
+		else
+		{
+			USART_SendData(USARTx, Serial->Init.pTxBuffer[tail]);
+			tail++;
+		}
+
+		Serial->TxTail = tail;
+	}
+}
+
+//
+// @简介：发送DMA的传输完成中断，在DMA1_Channelx_IRQHandler中调用
+//
+void My_Serial_TxDMA_IRQHandler(Serial_TypeDef *Serial)
+{
+	DMA_ClearITPendingBit(DMA1_IT_GL1 << (4 * DMA_Index(Serial->Init.TxDMAy_Channelx)));
+
+	Serial->TxTail += Serial->TxBusy;
+	Serial->TxBusy = 0;
+
+	StartTx(Serial);
+}
+
+//
+// @简介：接收DMA的半满、全满中断，在DMA1_Channelx_IRQHandler中调用
+//
+void My_Serial_RxDMA_IRQHandler(Serial_TypeDef *Serial)
+{
+	DMA_ClearITPendingBit(DMA1_IT_GL1 << (4 * DMA_Index(Serial->Init.RxDMAy_Channelx)));
+
+	RxUpdate(Serial);
+}
+
+//
+// @简介：有数据且发送空闲时启动发送，须在关中断或同一串口的中断中调用
+//
+static void StartTx(Serial_TypeDef *Serial)
+{
+	if(Serial->Init.TxDMAy_Channelx == NULL)
+	{
+		USART_ITConfig(Serial->Init.USARTx, USART_IT_TXE, ENABLE); // 由中断取出数据，队列为空时自行关闭
+		return;
+	}
+
+	if(Serial->TxBusy) return;
+
+	uint16_t head = Serial->TxHead;
+	uint16_t tail = Serial->TxTail;
+
+	if(head < tail && tail >= Serial->TxWrap) // 回绕前的数据已发完
+	{
+		tail = 0;
+		Serial->TxTail = 0;
+	}
+
+	uint16_t len = head >= tail ? head - tail : Serial->TxWrap - tail;
+
+	if(len == 0) return;
+
+	DMA_Channel_TypeDef *DMAy_Channelx = Serial->Init.TxDMAy_Channelx;
+
+	DMA_Cmd(DMAy_Channelx, DISABLE);
+	DMAy_Channelx->CMAR = (uint32_t)(Serial->Init.pTxBuffer + tail);
+	DMAy_Channelx->CNDTR = len;
+	Serial->TxBusy = len;
+	DMA_Cmd(DMAy_Channelx, ENABLE);
+}
+
+//
+// @简介：根据DMA的剩余计数更新接收缓冲区的写入位置，须在关中断或同一串口的中断中调用
+//
+static void RxUpdate(Serial_TypeDef *Serial)
+{
+	if(Serial->Init.RxDMAy_Channelx == NULL) return; // 由RXNE中断逐字节更新
+
+	uint16_t size = Serial->Init.RxBufferSize;
+	uint16_t pos = size - Serial->Init.RxDMAy_Channelx->CNDTR;
+
+	if(pos >= size) pos = 0;
+
+	Serial->RxWritten += (pos + size - Serial->RxPos) % size;
+	Serial->RxPos = pos;
+}
+
+static uint32_t Lock(void)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+
+	return primask;
+}
+
+static void Unlock(uint32_t Primask)
+{
+	__set_PRIMASK(Primask);
+}
+
+//
+// @简介：DMA1通道的序号，Channel1为0
+//
+static uint32_t DMA_Index(DMA_Channel_TypeDef *DMAy_Channelx)
+{
+	return ((uint32_t)DMAy_Channelx - (uint32_t)DMA1_Channel1) / ((uint32_t)DMA1_Channel2 - (uint32_t)DMA1_Channel1);
+}
+
+static void NVIC_Config(uint8_t IRQChannel, uint8_t Priority)
+{
+	NVIC_InitTypeDef NVIC_InitStruct = {0};
+
+	NVIC_InitStruct.NVIC_IRQChannel = IRQChannel;
+	NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = Priority;
+	NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+
+	NVIC_Init(&NVIC_InitStruct);
+}
+
+static Serial_TypeDef *FindPort(USART_TypeDef *USARTx)
+{
+	for(uint8_t i=0; i<SERIAL_MAX_PORTS; i++)
+	{
+		if(ports[i] != NULL && ports[i]->Init.USARTx == USARTx) return ports[i];
+	}
+
+	return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 替换usart.c中的弱函数：已初始化队列的串口改为通过队列收发，其它串口仍按原方式等待
+//////////////////////////////////////////////////////////////////////////
+
+void My_USART_SendBytes(USART_TypeDef *USARTx, const uint8_t *pData, uint16_t Size)
+{
+	Serial_TypeDef *serial = FindPort(USARTx);
+
+	if(Size == 0) return;
+
+	if(serial != NULL)
+	{
+		My_Serial_Write(serial, pData, Size); // 队列放不下时丢弃，计入TxOverrun
+		return;
+	}
+
+	for(uint16_t i=0; i < Size; i++)
+	{
+		while(USART_GetFlagStatus(USARTx, USART_FLAG_TXE) == RESET);
+
+		USART_SendData(USARTx, pData[i]);
+	}
+
+	while(USART_GetFlagStatus(USARTx, USART_FLAG_TC) == RESET);
+}
+
+uint16_t My_USART_ReceiveBytes(USART_TypeDef *USARTx, uint8_t *pDataOut, uint16_t Size, int Timeout)
+{
+	Serial_TypeDef *serial = FindPort(USARTx);
+	uint32_t expireTime;
+
+	Delay_Init();
+
+	if(Timeout >= 0)
+	{
+		expireTime = GetTick() + Timeout;
+	}
+
+	uint16_t i = 0;
+
+	do
+	{
+		if(serial != NULL)
+		{
+			i += My_Serial_Read(serial, pDataOut + i, Size - i);
+		}
+		else if(USART_GetFlagStatus(USARTx, USART_FLAG_RXNE) == SET)
+		{
+			pDataOut[i++] = USART_ReceiveData(USARTx);
+		}
+
+		if(i == Size) break;
+	}
+	while(Timeout < 0 || !Time_Reached(GetTick(), expireTime));
+
+	return i;
+}
@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file    serial.h
+  * @version V 1.0.0
+  * @brief   不阻塞的串口驱动
+  *          发送：环形队列，由DMA（或TXE中断）在后台发出，写入方直接在队列中预留连续空间并填写，
+  *                不经过中间缓冲区；队列已满时拒绝写入并计数，从不等待
+  *          接收：DMA循环写入环形缓冲区（或RXNE中断逐字节写入），空闲线中断标记一帧结束，
+  *                读取方来不及读取而被覆盖的字节计数后丢弃
+  *          初始化后My_USART_SendBytes/My_USART_ReceiveBytes对该串口也改为通过队列收发
+  ******************************************************************************
+  */
+
+#ifndef _SERIAL_H_
+#define _SERIAL_H_
+
+#include "stm32f10x.h"
+
+typedef struct
+{
+	USART_TypeDef *USARTx;                 // 串口，须已完成引脚、时钟和波特率的配置
+	DMA_Channel_TypeDef *TxDMAy_Channelx;  // 发送用的DMA通道，NULL表示由TXE中断逐字节发送
+	DMA_Channel_TypeDef *RxDMAy_Channelx;  // 接收用的DMA通道（循环模式），NULL表示由RXNE中断逐字节接收
+	uint8_t *pTxBuffer;                    // 发送队列
+	uint16_t TxBufferSize;
+	uint8_t *pRxBuffer;                    // 接收缓冲区
+	uint16_t RxBufferSize;
+	uint8_t NVIC_IRQChannelPreemptionPriority; // 串口和DMA中断的抢占优先级
+} Serial_InitTypeDef;
+
+typedef struct
+{
+	Serial_InitTypeDef Init;
+
+	// 发送队列：未回绕时数据为[TxTail, TxHead)，回绕后为[TxTail, TxWrap)和[0, TxHead)
+	volatile uint16_t TxHead;    // 下一个写入位置
+	volatile uint16_t TxTail;    // 下一个发送位置
+	volatile uint16_t TxWrap;    // 回绕前数据的结束位置
+	volatile uint16_t TxBusy;    // DMA正在发送的字节数，0表示空闲
+	uint8_t TxReserveWrap;       // 最近一次预留的空间位于队列开头（需要回绕）
+
+	// 接收缓冲区
+	volatile uint16_t RxPos;     // 最近一次观察到的写入位置
+	volatile uint32_t RxWritten; // 累计写入的字节数
+	uint32_t RxRead;             // 累计读出的字节数
+	volatile uint8_t RxIdle;     // 检测到空闲线，由My_Serial_RxIdle清除
+
+	// 统计
+	uint32_t TxOverrun;          // 因队列已满被拒绝的字节数
+	volatile uint32_t RxOverrun; // 来不及读取被覆盖的字节数
+	volatile uint32_t RxErrors;  // 硬件报告的溢出、帧错误和噪声次数
+} Serial_TypeDef;
+
+    void My_Serial_Init(Serial_TypeDef *Serial, Serial_InitTypeDef *Serial_InitStruct);
+ uint8_t *My_Serial_TxReserve(Serial_TypeDef *Serial, uint16_t Size);
+    void My_Serial_TxCommit(Serial_TypeDef *Serial, uint16_t Size);
+uint16_t My_Serial_Write(Serial_TypeDef *Serial, const void *pData, uint16_t Size);
+uint16_t My_Serial_GetTxFree(Serial_TypeDef *Serial);
+uint16_t My_Serial_Read(Serial_TypeDef *Serial, void *pDataOut, uint16_t MaxSize);
+uint16_t My_Serial_GetRxCount(Serial_TypeDef *Serial);
+ uint8_t My_Serial_RxIdle(Serial_TypeDef *Serial);
+
+// 在对应的中断函数中调用
+    void My_Serial_IRQHandler(Serial_TypeDef *Serial);
+    void My_Serial_TxDMA_IRQHandler(Serial_TypeDef *Serial);
+    void My_Serial_RxDMA_IRQHandler(Serial_TypeDef *Serial);
+
+#endif
@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    stats.c
+  * @version V 1.0.0
+  * @brief   流式统计（Welford算法）
+  ******************************************************************************
+  */
+
+#include "stats.h"
+#include <math.h>
+
+//
+// @简介：清空统计
+//
+void Stats_Init(Stats_TypeDef *Stats)
+{
+	Stats->N = 0;
+	Stats->Mean = 0;
+	Stats->M2 = 0;
+}
+
+//
+// @简介：加入一个样本
+//        Mean(n) = Mean(n-1) + (x - Mean(n-1)) / n
+//        M2(n) = M2(n-1) + (x - Mean(n-1)) * (x - Mean(n))
+//
+void Stats_Add(Stats_TypeDef *Stats, float x)
+{
+	Stats->N++;
+	
+	float delta = x - Stats->Mean;
+	
+	Stats->Mean += delta / Stats->N;
+	Stats->M2 += delta * (x - Stats->Mean);
+}
+
+//
+// @简介：样本方差（除以N-1）
+// @返回值：方差，样本不足2个时返回0
+//
+float Stats_GetVariance(const Stats_TypeDef *Stats)
+{
+	if(Stats->N < 2) return 0;
+	
+	return Stats->M2 / (Stats->N - 1);
+}
+
+//
+// @简介：样本标准差
+//
+float Stats_GetStdDev(const Stats_TypeDef *Stats)
+{
+	return sqrtf(Stats_GetVariance(Stats));
+}
+
+//
+// @简介：均值的标准误差，即标准差/√N，均值的95%置信区间约为±2倍标准误差
+// @返回值：标准误差，样本不足2个时返回无穷大
+// @注意：假设样本之间相互独立；相邻样本相关时（例如经过低通滤波）实际误差更大
+//
+float Stats_GetStdErr(const Stats_TypeDef *Stats)
+{
+	if(Stats->N < 2) return INFINITY;
+	
+	return sqrtf(Stats_GetVariance(Stats) / Stats->N);
+}
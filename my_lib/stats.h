@@ -0,0 +1,28 @@
+/**
+  ******************************************************************************
+  * @file    stats.h
+  * @version V 1.0.0
+  * @brief   流式统计（Welford算法），逐个加入样本，随时得到均值、方差和均值的标准误差，
+  *          不保存样本。与先求和再相除相比，样本很多、均值远大于波动时也不会损失精度
+  ******************************************************************************
+  */
+
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#include <stdint.h>
+
+typedef struct
+{
+	uint32_t N;  // 样本数
+	float Mean;  // 均值
+	float M2;    // 与均值之差的平方和
+} Stats_TypeDef;
+
+ void Stats_Init(Stats_TypeDef *Stats);
+ void Stats_Add(Stats_TypeDef *Stats, float x);
+float Stats_GetVariance(const Stats_TypeDef *Stats);
+float Stats_GetStdDev(const Stats_TypeDef *Stats);
+float Stats_GetStdErr(const Stats_TypeDef *Stats);
+
+#endif
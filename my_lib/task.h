@@ -1,13 +1,20 @@
-#include "delay.h"
-
-#define PERIODIC(T) \
-static uint32_t nxt = 0; \
-if(GetTick() < nxt) return; \
-nxt += (T);
-
-#define PERIODIC_START(NAME, T) \
-static uint32_t NAME##_nxt = 0; \
-if(GetTick() >= NAME##_nxt) {\
-NAME##_nxt += (T);
-
-#define PERIODIC_END }
+#include "delay.h"
+
+#define PERIODIC(T) \
+static uint32_t nxt = 0; \
+if(!Time_Reached(GetTick(), nxt)) return; \
+nxt += (T);
+
+// 与PERIODIC相同，另外定义LATE（uint32_t）为本次执行比计划时刻晚了多少ms，用于超时判断
+#define PERIODIC_LATE(T, LATE) \
+static uint32_t nxt = 0; \
+if(!Time_Reached(GetTick(), nxt)) return; \
+uint32_t LATE = Time_Diff(GetTick(), nxt); \
+nxt += (T);
+
+#define PERIODIC_START(NAME, T) \
+static uint32_t NAME##_nxt = 0; \
+if(Time_Reached(GetTick(), NAME##_nxt)) {\
+NAME##_nxt += (T);
+
+#define PERIODIC_END }
@@ -0,0 +1,498 @@
+/**
+  ******************************************************************************
+  * @file    telemetry.c
+  * @version V 1.0.0
+  * @brief   二进制遥测帧的生成和COBS成帧
+  ******************************************************************************
+  */
+
+#include "telemetry.h"
+#include <string.h>
+
+static int32_t  ReadChannel(Telemetry_ChannelTypeDef *Channel);
+static uint16_t PutVarint(uint8_t *pOut, int32_t Value);
+static void     UpdateActive(Telemetry_TypeDef *Telemetry);
+
+#define SCHEMA_SET(T, i)   ((T)->SchemaPending[(i) / 8] |= 1 << ((i) % 8))
+#define SCHEMA_CLEAR(T, i) ((T)->SchemaPending[(i) / 8] &= ~(1 << ((i) % 8)))
+#define SCHEMA_TEST(T, i)  ((T)->SchemaPending[(i) / 8] & (1 << ((i) % 8)))
+
+//
+// @简介：初始化
+// @参数：Telemetry - 句柄
+// @参数：KeyInterval - KEY帧的间隔，单位tick，决定了解码端丢帧或中途接入后最多多久能恢复
+//
+void Telemetry_Init(Telemetry_TypeDef *Telemetry, uint16_t KeyInterval)
+{
+	memset(Telemetry, 0, sizeof(Telemetry_TypeDef));
+
+	Telemetry->KeyInterval = KeyInterval;
+	Telemetry->KeyPending = 1;
+}
+
+//
+// @简介：登记一个通道
+// @参数：Name - 名称，不超过TELEMETRY_MAX_NAME个字符，须在整个运行期间有效（通常为字符串常量）
+// @参数：Type - 数据类型，TELEMETRY_xxx
+// @参数：pValue - 变量的地址
+// @参数：Scale - 仅对TELEMETRY_FLOAT有效，发送round(值*Scale)，例如0.01°的分辨率取100
+// @参数：Divider - 默认的分频系数，每Divider个tick发送一次，0表示关闭（仍可用Telemetry_Value单次读取）
+// @返回值：通道号，-1表示通道已满
+//
+int8_t Telemetry_AddChannel(Telemetry_TypeDef *Telemetry, const char *Name, uint8_t Type, const volatile void *pValue, float Scale, uint16_t Divider)
+{
+	if(Telemetry->NumChannels >= TELEMETRY_MAX_CHANNELS) return -1;
+
+	int8_t id = Telemetry->NumChannels++;
+	Telemetry_ChannelTypeDef *ch = &Telemetry->Channels[id];
+
+	ch->Name = Name;
+	ch->Type = Type;
+	ch->pValue = pValue;
+	ch->Scale = (Type == TELEMETRY_FLOAT) ? Scale : 1.0f;
+	ch->Divider = Divider;
+	ch->Writable = -1;
+	ch->Last = 0;
+
+	SCHEMA_SET(Telemetry, id);
+	Telemetry->KeyPending = 1;
+
+	UpdateActive(Telemetry);
+
+	return id;
+}
+
+//
+// @简介：按名称查找通道
+// @返回值：通道号，-1表示不存在
+//
+int8_t Telemetry_FindChannel(Telemetry_TypeDef *Telemetry, const char *Name)
+{
+	for(uint8_t i=0; i<Telemetry->NumChannels; i++)
+	{
+		if(strcmp(Telemetry->Channels[i].Name, Name) == 0) return i;
+	}
+
+	return -1;
+}
+
+//
+// @简介：修改通道的分频系数
+// @参数：Channel - 通道号，-1表示全部通道
+// @参数：Divider - 每Divider个tick发送一次，0表示关闭
+// @注意：新开启的通道没有可供差分的上一次值，因此随后发送一个KEY帧；修改后的描述也会尽快发送
+//
+void Telemetry_SetDivider(Telemetry_TypeDef *Telemetry, int8_t Channel, uint16_t Divider)
+{
+	for(uint8_t i=0; i<Telemetry->NumChannels; i++)
+	{
+		if(Channel >= 0 && Channel != i) continue;
+
+		Telemetry->Channels[i].Divider = Divider;
+		SCHEMA_SET(Telemetry, i);
+	}
+
+	Telemetry->KeyPending = 1;
+
+	UpdateActive(Telemetry);
+}
+
+//
+// @简介：请求尽快重发全部通道的描述
+//
+void Telemetry_RequestSchema(Telemetry_TypeDef *Telemetry)
+{
+	for(uint8_t i=0; i<Telemetry->NumChannels; i++)
+	{
+		SCHEMA_SET(Telemetry, i);
+	}
+}
+
+//
+// @简介：允许在给定的范围内修改通道的变量
+// @参数：Channel - 通道号
+// @参数：Min, Max - 允许写入的范围，与通道的值同一单位（不乘Scale）
+// @参数：OnWrite - 写入后调用，例如使新的增益生效，可以为NULL
+// @返回值：在可写通道表中的序号，-1表示通道号无效或表已满
+// @注意：变量的地址登记时为const，可写的通道须确实指向可以修改的变量
+//
+int8_t Telemetry_SetWritable(Telemetry_TypeDef *Telemetry, int8_t Channel, float Min, float Max, void (*OnWrite)(void))
+{
+	if(Channel < 0 || Channel >= Telemetry->NumChannels) return -1;
+
+	Telemetry_ChannelTypeDef *ch = &Telemetry->Channels[Channel];
+
+	if(ch->Writable < 0)
+	{
+		if(Telemetry->NumWritables >= TELEMETRY_MAX_WRITABLE) return -1;
+
+		ch->Writable = Telemetry->NumWritables++;
+	}
+
+	Telemetry_WritableTypeDef *w = &Telemetry->Writables[ch->Writable];
+
+	w->Min = Min;
+	w->Max = Max;
+	w->OnWrite = OnWrite;
+
+	SCHEMA_SET(Telemetry, Channel);
+
+	return ch->Writable;
+}
+
+//
+// @简介：修改一个可写通道的变量
+// @参数：Channel - 通道号
+// @参数：Value - 新的值，与通道的值同一单位（不乘Scale），整数类型的通道四舍五入
+// @返回值：TELEMETRY_STATUS_xxx，不是TELEMETRY_STATUS_OK时变量未修改
+// @注意：直接写入变量，须在不会与使用该变量的代码同时执行的地方调用（例如主循环中两个任务之间）
+//
+uint8_t Telemetry_Write(Telemetry_TypeDef *Telemetry, int8_t Channel, float Value)
+{
+	if(Channel < 0 || Channel >= Telemetry->NumChannels) return TELEMETRY_STATUS_UNKNOWN;
+
+	Telemetry_ChannelTypeDef *ch = &Telemetry->Channels[Channel];
+
+	if(ch->Writable < 0) return TELEMETRY_STATUS_READONLY;
+
+	Telemetry_WritableTypeDef *w = &Telemetry->Writables[ch->Writable];
+
+	if(!(Value >= w->Min && Value <= w->Max)) return TELEMETRY_STATUS_RANGE; // 含NaN
+
+	volatile void *p = (volatile void *)ch->pValue;
+	int32_t n = (int32_t)Value; // 向0取整，范围由Min、Max保证
+	float frac = Value - (float)n; // 没有舍入误差；直接加0.5f在0.49999997和2^23以上的奇数处会多进1
+
+	if(frac >= 0.5f) n++;
+	else if(frac <= -0.5f) n--;
+
+	switch(ch->Type)
+	{
+	case TELEMETRY_INT32:  *(volatile int32_t *)p = n; break;
+	case TELEMETRY_INT16:  *(volatile int16_t *)p = (int16_t)n; break;
+	case TELEMETRY_UINT16: *(volatile uint16_t *)p = (uint16_t)n; break;
+	case TELEMETRY_INT8:   *(volatile int8_t *)p = (int8_t)n; break;
+	case TELEMETRY_UINT8:  *(volatile uint8_t *)p = (uint8_t)n; break;
+	default:               *(volatile float *)p = Value; break;
+	}
+
+	if(w->OnWrite != NULL) w->OnWrite();
+
+	return TELEMETRY_STATUS_OK;
+}
+
+//
+// @简介：生成一个VALUE帧，作为单次读写的应答，附带通道当前的值
+// @参数：Channel - 通道号，无效时帧中的通道号为0xff，不含值
+// @参数：Status - TELEMETRY_STATUS_xxx
+// @参数：pOut - 输出参数，长度不小于TELEMETRY_VALUE_FRAME
+// @返回值：帧的长度
+// @注意：不影响DATA帧的差分
+//
+uint16_t Telemetry_Value(Telemetry_TypeDef *Telemetry, int8_t Channel, uint8_t Status, uint8_t *pOut)
+{
+	uint16_t len = 0;
+	uint8_t valid = (Channel >= 0 && Channel < Telemetry->NumChannels);
+
+	pOut[len++] = TELEMETRY_FRAME_VALUE;
+	pOut[len++] = valid ? Channel : 0xff;
+	pOut[len++] = valid ? Status : TELEMETRY_STATUS_UNKNOWN;
+
+	if(valid)
+	{
+		len += PutVarint(pOut + len, ReadChannel(&Telemetry->Channels[Channel]));
+	}
+
+	pOut[len] = Telemetry_Crc8(pOut, len);
+
+	return len + 1;
+}
+
+//
+// @简介：采样并生成本tick的DATA或KEY帧，每个tick调用一次
+// @参数：pOut - 输出参数，长度不小于TELEMETRY_MAX_FRAME，编码前的帧
+// @返回值：帧的长度，0表示本tick没有到期的通道
+// @注意：帧生成后如果没能发出，须调用Telemetry_Drop，否则解码端的差分会出错
+//
+uint16_t Telemetry_Sample(Telemetry_TypeDef *Telemetry, uint8_t *pOut)
+{
+	uint32_t tick = Telemetry->Tick++;
+	uint8_t key = 0;
+
+	if(Telemetry->KeyCountdown == 0 || Telemetry->KeyPending)
+	{
+		key = 1;
+		Telemetry->KeyPending = 0;
+		Telemetry->KeyCountdown = Telemetry->KeyInterval;
+
+		// 每个KEY帧之后轮流发送一个通道的描述
+		if(Telemetry->NumChannels > 0)
+		{
+			SCHEMA_SET(Telemetry, Telemetry->SchemaNext);
+			Telemetry->SchemaNext = (Telemetry->SchemaNext + 1) % Telemetry->NumChannels;
+		}
+	}
+
+	Telemetry->KeyCountdown--;
+
+	uint8_t maskLen = (Telemetry->NumChannels + 7) / 8;
+	uint16_t len = 4 + maskLen;
+	uint8_t any = 0;
+
+	memset(pOut + 4, 0, maskLen);
+
+	for(uint8_t k=0; k<Telemetry->NumActive; k++)
+	{
+		uint8_t i = Telemetry->Active[k];
+		Telemetry_ChannelTypeDef *ch = &Telemetry->Channels[i];
+
+		if(!key && ch->Divider != 1 && (tick % ch->Divider) != 0) continue;
+
+		int32_t value = ReadChannel(ch);
+
+		len += PutVarint(pOut + len, key ? value : (int32_t)((uint32_t)value - (uint32_t)ch->Last));
+		ch->Last = value;
+
+		pOut[4 + i / 8] |= 1 << (i % 8);
+		any = 1;
+	}
+
+	if(!any)
+	{
+		if(key) Telemetry->KeyPending = 1; // 没有开启的通道，等有通道开启时再发
+		return 0;
+	}
+
+	pOut[0] = key ? TELEMETRY_FRAME_KEY : TELEMETRY_FRAME_DATA;
+	pOut[1] = Telemetry->Seq++;
+	pOut[2] = tick;
+	pOut[3] = tick >> 8;
+
+	pOut[len] = Telemetry_Crc8(pOut, len);
+
+	return len + 1;
+}
+
+//
+// @简介：生成一个待发送的SCHEMA帧，每次最多一个，避免占满带宽
+// @参数：pOut - 输出参数，长度不小于TELEMETRY_MAX_FRAME
+// @返回值：帧的长度，0表示没有待发送的描述
+// @注意：没能发出的描述不再重发，等轮到该通道时再发送
+//
+uint16_t Telemetry_Schema(Telemetry_TypeDef *Telemetry, uint8_t *pOut)
+{
+	uint8_t i;
+
+	for(i=0; i<Telemetry->NumChannels; i++)
+	{
+		if(SCHEMA_TEST(Telemetry, i)) break;
+	}
+
+	if(i >= Telemetry->NumChannels) return 0;
+
+	SCHEMA_CLEAR(Telemetry, i);
+
+	Telemetry_ChannelTypeDef *ch = &Telemetry->Channels[i];
+	uint16_t len = 0;
+
+	pOut[len++] = TELEMETRY_FRAME_SCHEMA;
+	pOut[len++] = i;
+	pOut[len++] = Telemetry->NumChannels;
+	pOut[len++] = ch->Type;
+
+	memcpy(pOut + len, &ch->Scale, 4);
+	len += 4;
+
+	pOut[len++] = ch->Divider;
+	pOut[len++] = ch->Divider >> 8;
+	pOut[len++] = (ch->Writable >= 0) ? TELEMETRY_FLAG_WRITABLE : 0;
+
+	for(uint8_t k=0; k<TELEMETRY_MAX_NAME && ch->Name[k] != '\0'; k++)
+	{
+		pOut[len++] = ch->Name[k];
+	}
+
+	pOut[len] = Telemetry_Crc8(pOut, len);
+
+	return len + 1;
+}
+
+//
+// @简介：报告最近一次Telemetry_Sample生成的帧没能发出，下一帧改为KEY帧
+//
+void Telemetry_Drop(Telemetry_TypeDef *Telemetry)
+{
+	Telemetry->KeyPending = 1;
+	Telemetry->Dropped++;
+}
+
+//
+// @简介：把帧中的整数换算回通道的值，用于解码端
+//
+double Telemetry_ToValue(uint8_t Type, float Scale, int32_t Raw)
+{
+	return (Type == TELEMETRY_FLOAT && Scale != 0) ? Raw / (double)Scale : Raw;
+}
+
+//
+// @简介：COBS编码，输出中不含0x00，末尾追加一个0x00作为帧的结束
+// @参数：pData - 编码前的数据
+// @参数：Len - 数据的长度
+// @参数：pOut - 输出参数，长度不小于TELEMETRY_COBS_SIZE(Len)，不能与pData重叠
+// @返回值：输出的长度（含结尾的0x00）
+//
+uint16_t Telemetry_CobsEncode(const uint8_t *pData, uint16_t Len, uint8_t *pOut)
+{
+	uint16_t code = 0; // 当前一段的长度字节的位置
+	uint16_t n = 1;
+
+	for(uint16_t i=0; i<Len; i++)
+	{
+		if(pData[i] != 0)
+		{
+			pOut[n++] = pData[i];
+		}
+
+		if(pData[i] == 0 || n - code == 0xff)
+		{
+			pOut[code] = n - code;
+			code = n++;
+		}
+	}
+
+	pOut[code] = n - code;
+	pOut[n++] = 0;
+
+	return n;
+}
+
+//
+// @简介：COBS解码
+// @参数：pData - 一帧编码后的数据，不含结尾的0x00
+// @参数：Len - 数据的长度
+// @参数：pOut - 输出参数，长度不小于Len
+// @返回值：解码后的长度，-1表示数据损坏
+//
+int Telemetry_CobsDecode(const uint8_t *pData, uint16_t Len, uint8_t *pOut)
+{
+	uint16_t i = 0;
+	int n = 0;
+
+	while(i < Len)
+	{
+		uint8_t code = pData[i++];
+
+		if(code == 0 || i + code - 1 > Len) return -1;
+
+		for(uint8_t k=1; k<code; k++)
+		{
+			if(pData[i] == 0) return -1;
+			pOut[n++] = pData[i++];
+		}
+
+		if(code != 0xff && i < Len)
+		{
+			pOut[n++] = 0;
+		}
+	}
+
+	return n;
+}
+
+//
+// @简介：CRC-8（多项式0x07，初值0）
+//
+uint8_t Telemetry_Crc8(const uint8_t *pData, uint16_t Len)
+{
+	uint8_t crc = 0;
+
+	for(uint16_t i=0; i<Len; i++)
+	{
+		crc ^= pData[i];
+
+		for(uint8_t k=0; k<8; k++)
+		{
+			crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+//
+// @简介：读取一个zigzag变长整数，用于解码端
+// @参数：pValue - 输出参数，读到的值
+// @返回值：占用的字节数，-1表示数据不完整或超过5个字节
+//
+int Telemetry_GetVarint(const uint8_t *pData, uint16_t Len, int32_t *pValue)
+{
+	uint32_t zz = 0;
+
+	for(uint16_t i=0; i<Len && i<5; i++)
+	{
+		zz |= (uint32_t)(pData[i] & 0x7f) << (7 * i);
+
+		if((pData[i] & 0x80) == 0)
+		{
+			*pValue = (int32_t)((zz >> 1) ^ (0 - (zz & 1)));
+			return i + 1;
+		}
+	}
+
+	return -1;
+}
+
+static int32_t ReadChannel(Telemetry_ChannelTypeDef *Channel)
+{
+	const volatile void *p = Channel->pValue;
+
+	switch(Channel->Type)
+	{
+	case TELEMETRY_INT32:  return *(const volatile int32_t *)p;
+	case TELEMETRY_INT16:  return *(const volatile int16_t *)p;
+	case TELEMETRY_UINT16: return *(const volatile uint16_t *)p;
+	case TELEMETRY_INT8:   return *(const volatile int8_t *)p;
+	case TELEMETRY_UINT8:  return *(const volatile uint8_t *)p;
+	default: break;
+	}
+
+	float x = *(const volatile float *)p * Channel->Scale;
+
+	// 限幅后差值不会溢出，NaN记为0
+	if(x > 1.0e9f) return 1000000000;
+	if(x < -1.0e9f) return -1000000000;
+	if(!(x == x)) return 0;
+
+	return (int32_t)(x >= 0 ? x + 0.5f : x - 0.5f);
+}
+
+static uint16_t PutVarint(uint8_t *pOut, int32_t Value)
+{
+	uint32_t zz = ((uint32_t)Value << 1) ^ (uint32_t)(Value >> 31);
+	uint16_t n = 0;
+
+	while(zz >= 0x80)
+	{
+		pOut[n++] = (zz & 0x7f) | 0x80;
+		zz >>= 7;
+	}
+
+	pOut[n++] = zz;
+
+	return n;
+}
+
+//
+// @简介：重新生成开启的通道的列表，Telemetry_Sample只遍历这张列表
+//
+static void UpdateActive(Telemetry_TypeDef *Telemetry)
+{
+	uint8_t n = 0;
+
+	for(uint8_t i=0; i<Telemetry->NumChannels; i++)
+	{
+		if(Telemetry->Channels[i].Divider != 0) Telemetry->Active[n++] = i;
+	}
+
+	Telemetry->NumActive = n;
+}
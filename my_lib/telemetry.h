@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file    telemetry.h
+  * @version V 1.0.0
+  * @brief   二进制遥测帧的生成和COBS成帧
+  *          各模块把变量登记为通道，每个基本周期（tick）调用一次Telemetry_Sample，
+  *          按各通道的分频系数取出到期的通道，生成一帧：
+  *            DATA   - 类型 序号 tick(2) 通道位图 各通道的值 CRC8
+  *                     值为整数（浮点数乘以Scale后取整）与该通道上一次发送值的差，zigzag后按7位一组变长存放
+  *            KEY    - 格式同DATA，但包含全部开启的通道，值为绝对值；
+  *                     每KeyInterval个tick以及有帧被丢弃后发送一次，解码端据此重新同步
+  *            SCHEMA - 类型 通道号 通道数 数据类型 Scale(float) 分频系数(2) 标志 名称 CRC8
+  *                     每个KEY帧之后轮流发送一个通道的描述，解码端中途接入也能得到全部通道
+  *            VALUE  - 类型 通道号 状态 值 CRC8
+  *                     单次读写一个通道的应答，值的换算与KEY帧相同，状态为TELEMETRY_STATUS_xxx
+  *          通道同时是可供观察的变量的登记表：分频系数为0的通道不发送，但可以单次读取，
+  *          登记为可写的通道还可以在给定的范围内修改（Telemetry_Write）。
+  *          开启的通道另外保存在一张列表中，每个tick只遍历这张列表
+  *          帧经COBS编码后以0x00结尾，字节流中出现的0x00只可能是帧的结束。多字节整数均为小端
+  ******************************************************************************
+  */
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TELEMETRY_MAX_CHANNELS 48 // 8的倍数
+#define TELEMETRY_MAX_WRITABLE 16 // 可写的通道数
+
+#define TELEMETRY_FRAME_DATA   0x01
+#define TELEMETRY_FRAME_KEY    0x02
+#define TELEMETRY_FRAME_SCHEMA 0x03
+#define TELEMETRY_FRAME_VALUE  0x04
+#define TELEMETRY_FRAME_USER   0x10 // 0x10及以上留给共用同一串口的其它模块（如app_blackbox.c），格式由其自定，解码端跳过
+
+// 通道的数据类型
+#define TELEMETRY_FLOAT  0 // 乘以Scale后取整
+#define TELEMETRY_INT32  1
+#define TELEMETRY_INT16  2
+#define TELEMETRY_UINT16 3
+#define TELEMETRY_INT8   4
+#define TELEMETRY_UINT8  5
+
+// 通道的标志，随SCHEMA帧发送
+#define TELEMETRY_FLAG_WRITABLE 0x01
+
+// VALUE帧的状态
+#define TELEMETRY_STATUS_OK       0
+#define TELEMETRY_STATUS_UNKNOWN  1 // 没有这个通道
+#define TELEMETRY_STATUS_READONLY 2 // 通道不可写
+#define TELEMETRY_STATUS_RANGE    3 // 超出允许的范围，未修改
+
+#define TELEMETRY_MAX_NAME  16 // 通道名称的最大长度
+#define TELEMETRY_MAX_FRAME (4 + TELEMETRY_MAX_CHANNELS / 8 + TELEMETRY_MAX_CHANNELS * 5 + 1) // 编码前一帧的最大长度
+#define TELEMETRY_VALUE_FRAME 9 // 编码前VALUE帧的最大长度
+#define TELEMETRY_COBS_SIZE(Len) ((Len) + (Len) / 254 + 2) // COBS编码后（含结尾的0x00）的最大长度
+
+typedef struct
+{
+	const char *Name;
+	uint8_t Type;                // TELEMETRY_xxx
+	const volatile void *pValue; // 变量的地址，Telemetry_Sample时读取
+	float Scale;                 // 仅TELEMETRY_FLOAT，发送round(值*Scale)，即分辨率为1/Scale
+	uint16_t Divider;            // 每Divider个tick发送一次，0表示关闭
+	int8_t Writable;             // 在Writables中的序号，-1表示不可写
+	int32_t Last;                // 上一次发送的值
+} Telemetry_ChannelTypeDef;
+
+typedef struct
+{
+	float Min;                   // 允许写入的范围，与通道的值同一单位
+	float Max;
+	void (*OnWrite)(void);       // 写入后调用，例如使新的增益生效，可以为NULL
+} Telemetry_WritableTypeDef;
+
+typedef struct
+{
+	Telemetry_ChannelTypeDef Channels[TELEMETRY_MAX_CHANNELS];
+	uint8_t NumChannels;
+	uint8_t Active[TELEMETRY_MAX_CHANNELS]; // 开启的通道，按通道号从小到大排列
+	uint8_t NumActive;
+	Telemetry_WritableTypeDef Writables[TELEMETRY_MAX_WRITABLE];
+	uint8_t NumWritables;
+	uint32_t Tick;          // Telemetry_Sample的调用次数
+	uint8_t Seq;            // 已生成的帧数，解码端据此发现丢帧
+	uint16_t KeyInterval;   // KEY帧的间隔，单位tick
+	uint16_t KeyCountdown;  // 距下一个KEY帧的tick数
+	uint8_t KeyPending;     // 下一帧须为KEY帧
+	uint8_t SchemaNext;     // 下一个轮流发送描述的通道
+	uint8_t SchemaPending[TELEMETRY_MAX_CHANNELS / 8]; // 须尽快发送描述的通道（位图）
+	uint32_t Dropped;       // 来不及发送而丢弃的帧数
+} Telemetry_TypeDef;
+
+    void Telemetry_Init(Telemetry_TypeDef *Telemetry, uint16_t KeyInterval);
+  int8_t Telemetry_AddChannel(Telemetry_TypeDef *Telemetry, const char *Name, uint8_t Type, const volatile void *pValue, float Scale, uint16_t Divider);
+  int8_t Telemetry_FindChannel(Telemetry_TypeDef *Telemetry, const char *Name);
+    void Telemetry_SetDivider(Telemetry_TypeDef *Telemetry, int8_t Channel, uint16_t Divider);
+    void Telemetry_RequestSchema(Telemetry_TypeDef *Telemetry);
+  int8_t Telemetry_SetWritable(Telemetry_TypeDef *Telemetry, int8_t Channel, float Min, float Max, void (*OnWrite)(void));
+ uint8_t Telemetry_Write(Telemetry_TypeDef *Telemetry, int8_t Channel, float Value);
+uint16_t Telemetry_Value(Telemetry_TypeDef *Telemetry, int8_t Channel, uint8_t Status, uint8_t *pOut);
+uint16_t Telemetry_Sample(Telemetry_TypeDef *Telemetry, uint8_t *pOut);
+uint16_t Telemetry_Schema(Telemetry_TypeDef *Telemetry, uint8_t *pOut);
+    void Telemetry_Drop(Telemetry_TypeDef *Telemetry);
+  double Telemetry_ToValue(uint8_t Type, float Scale, int32_t Raw);
+
+uint16_t Telemetry_CobsEncode(const uint8_t *pData, uint16_t Len, uint8_t *pOut);
+     int Telemetry_CobsDecode(const uint8_t *pData, uint16_t Len, uint8_t *pOut);
+ uint8_t Telemetry_Crc8(const uint8_t *pData, uint16_t Len);
+     int Telemetry_GetVarint(const uint8_t *pData, uint16_t Len, int32_t *pValue);
+
+#endif
@@ -0,0 +1,303 @@
+/**
+  ******************************************************************************
+  * @file    trace.c
+  * @version V 1.0.0
+  * @brief   紧凑的事件记录格式及其环形缓冲区
+  ******************************************************************************
+  */
+
+#include "trace.h"
+
+static uint16_t GetFree(Trace_TypeDef *Trace);
+static uint8_t  VarLen(uint32_t Value);
+static void     PutByte(Trace_TypeDef *Trace, uint8_t Byte);
+static void     PutRecord(Trace_TypeDef *Trace, uint8_t Type, uint8_t Flags, uint32_t Us, const uint8_t *pData, uint8_t Size, uint8_t HasPayload);
+static uint8_t  EncodeHead(uint32_t *pLastUs, uint8_t *pOut, uint8_t Type, uint8_t Flags, uint32_t Us, uint8_t HasPayload);
+
+//
+// @简介：zigzag编码，把有符号数映射为无符号数，绝对值小的数编码后也小
+//
+static uint32_t ZigZag(int32_t Value)
+{
+	return ((uint32_t)Value << 1) ^ (uint32_t)(Value >> 31);
+}
+
+//
+// @简介：初始化记录缓冲区
+// @参数：Trace - 记录缓冲区句柄
+// @参数：pBuffer - 存放数据的数组
+// @参数：Size - 数组的大小，最多可存放Size-1个字节
+//
+void Trace_Init(Trace_TypeDef *Trace, uint8_t *pBuffer, uint16_t Size)
+{
+	Trace->pBuffer = pBuffer;
+	Trace->Size = Size;
+	Trace->Head = 0;
+	Trace->Tail = 0;
+	Trace->LastUs = 0;
+	Trace->Dropped = 0;
+	Trace->TotalDropped = 0;
+}
+
+//
+// @简介：写入一条记录
+// @参数：Trace - 记录缓冲区句柄
+// @参数：Type - 记录类型，0..14，15保留给TRACE_TYPE_LOST
+// @参数：Flags - 标志，0..7
+// @参数：Us - 记录的时间，单位us
+// @参数：pData - 负载，为NULL时记录不带负载
+// @参数：Size - 负载的长度
+// @返回值：0 - 成功，-1 - 缓冲区已满，记录被丢弃
+// @注意：时间以差值存放，Us可以早于上一条记录（例如在中断中插入的记录），
+//        但相邻两条记录的时间差不能超过2^31us
+//
+int Trace_Write(Trace_TypeDef *Trace, uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size)
+{
+	uint16_t len = 1 + VarLen(ZigZag((int32_t)(Us - Trace->LastUs))) + (pData != NULL ? 1 + Size : 0);
+	uint16_t free = GetFree(Trace);
+
+	if(Trace->Dropped > 0)
+	{
+		// 先报告丢弃的条数，LOST记录与本条记录同一时刻，本条记录的时间差为0
+		uint8_t n[4];
+
+		n[0] = Trace->Dropped; n[1] = Trace->Dropped >> 8; n[2] = Trace->Dropped >> 16; n[3] = Trace->Dropped >> 24;
+
+		uint16_t lostLen = 1 + VarLen(ZigZag((int32_t)(Us - Trace->LastUs))) + 1 + sizeof(n);
+
+		len = lostLen + 2 + (pData != NULL ? 1 + Size : 0);
+
+		if(free < len)
+		{
+			Trace->Dropped++;
+			Trace->TotalDropped++;
+			return -1;
+		}
+
+		PutRecord(Trace, TRACE_TYPE_LOST, 0, Us, n, sizeof(n), 1);
+		Trace->Dropped = 0;
+	}
+	else if(free < len)
+	{
+		Trace->Dropped++;
+		Trace->TotalDropped++;
+		return -1;
+	}
+
+	PutRecord(Trace, Type, Flags, Us, (const uint8_t *)pData, Size, pData != NULL);
+
+	return 0;
+}
+
+//
+// @简介：读出一个字节
+// @参数：pByte - 输出参数，读出的字节
+// @返回值：0 - 成功，-1 - 缓冲区为空
+//
+int Trace_ReadByte(Trace_TypeDef *Trace, uint8_t *pByte)
+{
+	uint16_t tail = Trace->Tail;
+
+	if(tail == Trace->Head) return -1;
+
+	*pByte = Trace->pBuffer[tail];
+
+	Trace->Tail = (tail + 1 == Trace->Size) ? 0 : tail + 1;
+
+	return 0;
+}
+
+//
+// @简介：获取缓冲区中尚未读出的字节数
+//
+uint16_t Trace_GetCount(Trace_TypeDef *Trace)
+{
+	return Trace->Size - 1 - GetFree(Trace);
+}
+
+//
+// @简介：计算一条记录编码后的长度
+// @参数：LastUs - 上一条记录的时间
+// @参数：Us - 本条记录的时间
+// @参数：HasPayload - 是否带负载
+// @参数：Size - 负载的长度
+//
+uint16_t Trace_GetEncodedSize(uint32_t LastUs, uint32_t Us, uint8_t HasPayload, uint8_t Size)
+{
+	return 1 + VarLen(ZigZag((int32_t)(Us - LastUs))) + (HasPayload ? 1 + Size : 0);
+}
+
+//
+// @简介：把一条记录编码到连续的内存中，用于不经过Trace_TypeDef直接写入发送队列
+// @参数：pLastUs - 输入输出参数，上一条记录的时间，编码后更新为本条记录的时间
+// @参数：pOut - 输出参数，长度不小于Trace_GetEncodedSize的返回值
+// @参数：其余参数同Trace_Write
+// @返回值：写入pOut的字节数
+// @注意：丢弃计数和LOST记录由调用者负责
+//
+uint16_t Trace_Encode(uint32_t *pLastUs, uint8_t *pOut, uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size)
+{
+	uint16_t len = EncodeHead(pLastUs, pOut, Type, Flags, Us, pData != NULL);
+
+	if(pData != NULL)
+	{
+		pOut[len++] = Size;
+
+		for(uint8_t i = 0; i < Size; i++)
+		{
+			pOut[len++] = ((const uint8_t *)pData)[i];
+		}
+	}
+
+	return len;
+}
+
+//
+// @简介：从字节流中解码一条记录
+// @参数：pLastUs - 输入输出参数，上一条记录的时间，解码成功后更新为本条记录的时间，初值为0
+// @参数：pData - 字节流
+// @参数：Len - 字节流的长度
+// @参数：Record - 输出参数，解码得到的记录
+// @返回值：>0 - 本条记录占用的字节数，0 - 数据不完整，-1 - 数据损坏（变长整数超过5个字节）
+//
+int Trace_Decode(uint32_t *pLastUs, const uint8_t *pData, uint32_t Len, Trace_RecordTypeDef *Record)
+{
+	uint32_t pos = 0;
+	uint32_t zz = 0;
+	uint8_t shift = 0;
+
+	if(Len < 2) return 0;
+
+	uint8_t head = pData[pos++];
+
+	while(1)
+	{
+		if(pos >= Len) return 0;
+		if(shift > 28) return -1;
+
+		uint8_t byte = pData[pos++];
+
+		zz |= (uint32_t)(byte & 0x7f) << shift;
+		shift += 7;
+
+		if((byte & 0x80) == 0) break;
+	}
+
+	Record->Type = head & 0x0f;
+	Record->Flags = (head >> 4) & 0x07;
+	Record->Size = 0;
+
+	if(head & 0x80)
+	{
+		if(pos >= Len) return 0;
+
+		uint8_t size = pData[pos++];
+
+		if(pos + size > Len) return 0;
+
+		for(uint8_t i = 0; i < size; i++)
+		{
+			Record->Data[i] = pData[pos + i];
+		}
+
+		Record->Size = size;
+		pos += size;
+	}
+
+	*pLastUs += (uint32_t)((zz >> 1) ^ -(zz & 1));
+	Record->Us = *pLastUs;
+
+	return pos;
+}
+
+//
+// @简介：计算数据的16位校验值（FNV-1a，32位结果折叠为16位）
+//        用于在记录中以很小的代价标记一组输出，回放时逐位比较
+//
+uint16_t Trace_Hash(const void *pData, uint16_t Size)
+{
+	const uint8_t *p = (const uint8_t *)pData;
+	uint32_t h = 2166136261u;
+
+	for(uint16_t i = 0; i < Size; i++)
+	{
+		h ^= p[i];
+		h *= 16777619u;
+	}
+
+	return (uint16_t)(h ^ (h >> 16));
+}
+
+static uint16_t GetFree(Trace_TypeDef *Trace)
+{
+	uint16_t head = Trace->Head;
+	uint16_t tail = Trace->Tail;
+
+	return (tail > head) ? (tail - head - 1) : (Trace->Size - 1 - (head - tail));
+}
+
+static uint8_t VarLen(uint32_t Value)
+{
+	uint8_t n = 1;
+
+	while(Value >= 0x80)
+	{
+		Value >>= 7;
+		n++;
+	}
+
+	return n;
+}
+
+static void PutByte(Trace_TypeDef *Trace, uint8_t Byte)
+{
+	uint16_t head = Trace->Head;
+
+	Trace->pBuffer[head] = Byte;
+
+	Trace->Head = (head + 1 == Trace->Size) ? 0 : head + 1;
+}
+
+static void PutRecord(Trace_TypeDef *Trace, uint8_t Type, uint8_t Flags, uint32_t Us, const uint8_t *pData, uint8_t Size, uint8_t HasPayload)
+{
+	uint8_t head[6];
+	uint8_t len = EncodeHead(&Trace->LastUs, head, Type, Flags, Us, HasPayload);
+
+	for(uint8_t i = 0; i < len; i++)
+	{
+		PutByte(Trace, head[i]);
+	}
+
+	if(HasPayload)
+	{
+		PutByte(Trace, Size);
+
+		for(uint8_t i = 0; i < Size; i++)
+		{
+			PutByte(Trace, pData[i]);
+		}
+	}
+}
+
+//
+// @简介：编码记录头和时间差，最多6个字节
+//
+static uint8_t EncodeHead(uint32_t *pLastUs, uint8_t *pOut, uint8_t Type, uint8_t Flags, uint32_t Us, uint8_t HasPayload)
+{
+	uint32_t zz = ZigZag((int32_t)(Us - *pLastUs));
+	uint8_t len = 0;
+
+	*pLastUs = Us;
+
+	pOut[len++] = (Type & 0x0f) | ((Flags & 0x07) << 4) | (HasPayload ? 0x80 : 0x00);
+
+	while(zz >= 0x80)
+	{
+		pOut[len++] = (zz & 0x7f) | 0x80;
+		zz >>= 7;
+	}
+
+	pOut[len++] = zz;
+
+	return len;
+}
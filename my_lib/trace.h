@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    trace.h
+  * @version V 1.0.0
+  * @brief   紧凑的事件记录格式及其环形缓冲区
+  *          每条记录由1字节头、时间增量和可选的负载组成：
+  *            头    - bit0..3 类型，bit4..6 标志，bit7 为1表示带负载
+  *            时间  - 与上一条记录的时间差（us，有符号），zigzag编码后按7位一组的变长整数存放
+  *            负载  - 1字节长度 + 数据（仅bit7为1时存在）
+  *          不带负载的记录通常只占2~3个字节。缓冲区写满时丢弃新记录并计数，
+  *          腾出空间后先写入一条TRACE_TYPE_LOST记录（负载为丢弃的条数），
+  *          因此解码端总能知道数据是否完整。本模块不处理互斥，由调用者负责
+  ******************************************************************************
+  */
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TRACE_TYPE_LOST     15  // 保留的类型：此前有记录因缓冲区满而丢弃
+#define TRACE_MAX_PAYLOAD   255 // 单条记录负载的最大长度
+#define TRACE_MAX_RECORD    (1 + 5 + 1 + TRACE_MAX_PAYLOAD) // 单条记录编码后的最大长度
+
+typedef struct
+{
+	uint8_t *pBuffer;
+	uint16_t Size;
+	volatile uint16_t Head; // 写入位置
+	volatile uint16_t Tail; // 读出位置
+	uint32_t LastUs;        // 最近一条记录的时间
+	uint32_t Dropped;       // 尚未报告的丢弃条数
+	uint32_t TotalDropped;  // 累计丢弃的条数
+} Trace_TypeDef;
+
+typedef struct
+{
+	uint8_t Type;
+	uint8_t Flags;
+	uint32_t Us;
+	uint8_t Size;
+	uint8_t Data[TRACE_MAX_PAYLOAD];
+} Trace_RecordTypeDef;
+
+    void Trace_Init(Trace_TypeDef *Trace, uint8_t *pBuffer, uint16_t Size);
+     int Trace_Write(Trace_TypeDef *Trace, uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size);
+     int Trace_ReadByte(Trace_TypeDef *Trace, uint8_t *pByte);
+uint16_t Trace_GetCount(Trace_TypeDef *Trace);
+uint16_t Trace_GetEncodedSize(uint32_t LastUs, uint32_t Us, uint8_t HasPayload, uint8_t Size);
+uint16_t Trace_Encode(uint32_t *pLastUs, uint8_t *pOut, uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size);
+     int Trace_Decode(uint32_t *pLastUs, const uint8_t *pData, uint32_t Len, Trace_RecordTypeDef *Record);
+uint16_t Trace_Hash(const void *pData, uint16_t Size);
+
+#endif
@@ -0,0 +1,425 @@
+/**
+  ******************************************************************************
+  * @file    batch.c
+  * @version V 1.0.0
+  * @brief   批量仿真内核
+  *          每次处理VEC_WIDTH个实例（一个通道组），把它们的全部状态放在局部变量中，
+  *          从头到尾推进整个仿真时长后再写回数组，因此内核几乎不访问内存；
+  *          不同通道组之间互不相关，可以交给线程池并行执行
+  ******************************************************************************
+  */
+
+#include "batch.h"
+#include "bqmath.h"
+#include "app_pid_gain.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// 车体参数（user/app_control.c），控制器按标称值计算
+#define RW  0.032f
+#define LP  0.062f
+#define MP  0.12f
+#define JP  4.6128e-4f
+#define G   9.8f
+
+// 被控对象参数（tools/sim/plant.c）
+#define MW     0.26f
+#define LA     1.5e-3f
+#define RA     3.0f
+#define KT     0.176f
+#define KE     0.176f
+#define JM     2.787e-4f
+#define BM     2.279e-4f
+#define TIDLE  0.01f
+#define THETA_MAX 1.45f // 倾倒后触地的角度，略大于固件判定摔倒的80度
+
+#define CONTROL_RATE_TS 0.001f // 控制任务的基本周期（角速度环），单位s
+#define CONTROL_TS      0.005f // 姿态的更新周期（角度环），单位s
+#define CONTROL_VEL_TS  0.020f // 速度环的周期，单位s
+#define MOTOR_TS        0.001f // 电机速度环周期，单位s
+#define PWM_STEPS  1000.0f // 与user/app_pwm.c的PERIOD+1一致
+#define ENCODER_SCALE 0.01399402208920360588844895090594f
+#define ACCEL_LSB 0.00006103515625f
+#define GYRO_LSB  0.06097560975610f
+
+#define NUM_FIELDS (5 + 2 * BATCH_NUM_PID + 1 + 7)
+
+//
+// @简介：为Count个实例分配数组，所有数组按32字节对齐
+// @返回值：0 - 成功，-1 - 内存不足
+//
+int Batch_Create(Batch_TypeDef *Batch, uint32_t Count)
+{
+	memset(Batch, 0, sizeof(*Batch));
+	
+	Batch->Count = Count;
+	Batch->Padded = (Count + 7) / 8 * 8;
+	
+	size_t bytes = (size_t)Batch->Padded * sizeof(float);
+	uint8_t *mem = aligned_alloc(32, bytes * NUM_FIELDS);
+	
+	if(mem == NULL) return -1;
+	
+	memset(mem, 0, bytes * NUM_FIELDS);
+	Batch->Memory = mem;
+	
+	float **fields[NUM_FIELDS] = {
+		&Batch->Mass, &Batch->Vbat, &Batch->GyroNoise, &Batch->AccelNoise, &Batch->Theta0,
+		&Batch->Kp[0], &Batch->Kp[1], &Batch->Kp[2], &Batch->Kp[3],
+		&Batch->Ki[0], &Batch->Ki[1], &Batch->Ki[2], &Batch->Ki[3],
+		(float **)&Batch->Seed,
+		&Batch->Fell, &Batch->FellTime, &Batch->RmsPitch, &Batch->MaxPitch, &Batch->Settle, &Batch->Energy, &Batch->Drift,
+	};
+	
+	for(int i=0; i<NUM_FIELDS; i++)
+	{
+		*fields[i] = (float *)(mem + bytes * i);
+	}
+	
+	return 0;
+}
+
+void Batch_Free(Batch_TypeDef *Batch)
+{
+	free(Batch->Memory);
+	Batch->Memory = NULL;
+}
+
+//
+// @简介：所有实例取固件的标称参数和增益，配置取默认值
+//
+void Batch_SetDefaults(Batch_TypeDef *Batch, Batch_ConfigTypeDef *Config)
+{
+	static const float kp[BATCH_NUM_PID] = {PID_GAIN_VEL_KP, PID_GAIN_ALPHA_KP, PID_GAIN_DALPHA_KP, PID_GAIN_MOTOR_KP};
+	static const float ki[BATCH_NUM_PID] = {PID_GAIN_VEL_KI, PID_GAIN_ALPHA_KI, PID_GAIN_DALPHA_KI, PID_GAIN_MOTOR_KI};
+	
+	for(uint32_t i=0; i<Batch->Padded; i++)
+	{
+		Batch->Mass[i] = MP;
+		Batch->Vbat[i] = 7.4f;
+		Batch->GyroNoise[i] = 0.05f;
+		Batch->AccelNoise[i] = 0.004f;
+		Batch->Theta0[i] = 5.0f * 0.0174532925f;
+		Batch->Seed[i] = 2463534242u + i * 2654435761u;
+		if(Batch->Seed[i] == 0) Batch->Seed[i] = 1;
+		
+		for(int k=0; k<BATCH_NUM_PID; k++)
+		{
+			Batch->Kp[k][i] = kp[k];
+			Batch->Ki[k][i] = ki[k];
+		}
+	}
+	
+	Config->Duration = 10;
+	Config->StepUs = 100;
+	Config->VelSetpoint = 0;
+	Config->PushTime = -1;
+	Config->PushRate = 0;
+	Config->SettleTime = 1;
+	Config->SettleBand = 1;
+}
+
+//
+// PID_ComputeFixedRate的批量版本（Kd=0，DefaultOutput=0）
+//
+typedef struct
+{
+	vf Kp, KiT, I, E;
+} BPid_TypeDef;
+
+static inline vf BPid(BPid_TypeDef *P, vf Setpoint, vf Input, float Lo, float Hi, int First)
+{
+	vf error = vf_sub(Setpoint, Input);
+	vf output = vf_mul(P->Kp, error);
+	
+	if(!First)
+	{
+		P->I = vf_clamp(vf_add(P->I, vf_mul(P->KiT, vf_add(error, P->E))), vf_set1(Lo), vf_set1(Hi));
+		output = vf_add(output, P->I);
+	}
+	
+	P->E = error;
+	
+	return vf_clamp(output, vf_set1(Lo), vf_set1(Hi));
+}
+
+//
+// 近似标准正态分布：xorshift32生成4个均匀分布随机数求和
+//
+static inline vf Gauss(vi *State)
+{
+	vf sum = vf_set1(0);
+	
+	for(int k=0; k<4; k++)
+	{
+		vi x = *State;
+		x = vi_xor(x, vi_shl(x, 13));
+		x = vi_xor(x, vi_shr(x, 17));
+		x = vi_xor(x, vi_shl(x, 5));
+		*State = x;
+		sum = vf_add(sum, vf_mul(vf_from_vi(vi_shr(x, 8)), vf_set1(1.0f / 16777216.0f)));
+	}
+	
+	return vf_mul(vf_sub(sum, vf_set1(2.0f)), vf_set1(1.7320508f));
+}
+
+// 被控对象使用的正弦和余弦（泰勒级数，|x|<1.4时误差小于3e-5），不能用查表法代替
+static inline vf PSin(vf x)
+{
+	vf x2 = vf_mul(x, x);
+	vf p = vf_sub(vf_set1(1.0f / 120), vf_mul(x2, vf_set1(1.0f / 5040)));
+	p = vf_sub(vf_set1(1.0f / 6), vf_mul(x2, p));
+	return vf_mul(x, vf_sub(vf_set1(1), vf_mul(x2, p)));
+}
+
+static inline vf PCos(vf x)
+{
+	vf x2 = vf_mul(x, x);
+	vf p = vf_sub(vf_set1(1.0f / 720), vf_mul(x2, vf_set1(1.0f / 40320)));
+	p = vf_sub(vf_set1(1.0f / 24), vf_mul(x2, p));
+	p = vf_sub(vf_set1(0.5f), vf_mul(x2, p));
+	return vf_sub(vf_set1(1), vf_mul(x2, p));
+}
+
+static inline vf Quantize(vf x, float Lsb)
+{
+	return vf_mul(vf_floor(vf_add(vf_mul(x, vf_set1(1.0f / Lsb)), vf_set1(0.5f))), vf_set1(Lsb));
+}
+
+//
+// @简介：推进一个通道组（First..First+VEC_WIDTH-1）的整个仿真
+// @参数：First - 组内第一个实例的编号，须为VEC_WIDTH的整数倍
+//
+void Batch_RunGroup(Batch_TypeDef *B, const Batch_ConfigTypeDef *C, uint32_t First)
+{
+	const vf zero = vf_set1(0);
+	const vf one = vf_set1(1);
+	
+	// 参数
+	vf mp = vf_load(B->Mass + First);
+	vf jp = vf_mul(mp, vf_set1(JP / MP));
+	vf vbat = vf_load(B->Vbat + First);
+	vf nG = vf_load(B->GyroNoise + First);
+	vf nA = vf_load(B->AccelNoise + First);
+	vi rng = vi_load(B->Seed + First);
+	
+	BPid_TypeDef pid[BATCH_NUM_PID];
+	
+	static const float ts[BATCH_NUM_PID] = {
+		[BATCH_PID_VEL] = CONTROL_VEL_TS, [BATCH_PID_ALPHA] = CONTROL_TS,
+		[BATCH_PID_DALPHA] = CONTROL_RATE_TS, [BATCH_PID_MOTOR] = MOTOR_TS,
+	};
+	
+	for(int k=0; k<BATCH_NUM_PID; k++)
+	{
+		pid[k].Kp = vf_load(B->Kp[k] + First);
+		pid[k].KiT = vf_mul(vf_load(B->Ki[k] + First), vf_set1(0.5f * ts[k]));
+		pid[k].I = zero;
+		pid[k].E = zero;
+	}
+	
+	// 被控对象
+	vf x = zero, dx = zero, th = vf_load(B->Theta0 + First), dth = zero;
+	vf cur = zero, duty = zero, ddx = zero, ddth = zero;
+	
+	// 编码器：计数、方向、边沿间隔
+	vf count = vf_floor(vf_div(th, vf_set1(ENCODER_SCALE))); // 电机转角 = -(x/rw - theta)
+	vf d0 = zero, d1 = zero, dt0 = zero, dtnow = zero;
+	
+	// IMU及控制器
+	vf pitch = vf_mul(vf_neg(th), vf_set1(57.29578f)); // 首次融合取加速度计的结果（静止）
+	vf gx = zero, omegaRef = zero, spMotor = zero;
+	vf alpha = zero, alphaRef = zero, dalphaRef = zero, vSum = zero;
+	int vCount = 0;
+	
+	// 统计
+	vf fell = zero, fellTime = zero, sumSq = zero, maxPitch = zero, energy = zero, lastOut = zero;
+	
+	const vf m11Base = vf_set1(1.5f * MW + 2 * JM / (RW * RW));
+	const float dt = C->StepUs * 1e-6f;
+	const vf decay = vf_set1(expf(-dt * RA / LA));
+	const int subSteps = 1000 / C->StepUs;
+	const uint32_t totalMs = (uint32_t)(C->Duration * 1000 + 0.5f);
+	const uint32_t pushMs = C->PushTime >= 0 ? (uint32_t)(C->PushTime * 1000 + 0.5f) : UINT32_MAX;
+	const uint32_t settleMs = (uint32_t)(C->SettleTime * 1000 + 0.5f);
+	uint32_t samples = 0;
+	int firstMotor = 1, firstControl = 1;
+	
+	for(uint32_t ms=0; ms<totalMs; ms++)
+	{
+		vm alive = vm_not(vm_from_vf(fell));
+		
+		//
+		// App_MPU6050_Proc，每5ms读取全部数据并融合，其余每1ms只读取x轴角速度
+		//
+		if(ms % 5 != 0)
+		{
+			gx = Quantize(vf_add(vf_mul(vf_neg(dth), vf_set1(57.29578f)), vf_mul(nG, Gauss(&rng))), GYRO_LSB);
+		}
+		else
+		{
+			vf s = PSin(th), c = PCos(th);
+			vf dth2 = vf_mul(dth, dth);
+			vf fx = vf_sub(vf_add(ddx, vf_mul(vf_set1(LP), vf_mul(c, ddth))), vf_mul(vf_set1(LP), vf_mul(s, dth2)));
+			vf fz = vf_add(vf_sub(vf_neg(vf_mul(vf_set1(LP), vf_mul(s, ddth))), vf_mul(vf_set1(LP), vf_mul(c, dth2))), vf_set1(G));
+			
+			vf ay = vf_mul(vf_sub(vf_mul(fx, c), vf_mul(fz, s)), vf_set1(1.0f / G));
+			vf az = vf_mul(vf_add(vf_mul(fx, s), vf_mul(fz, c)), vf_set1(1.0f / G));
+			
+			ay = Quantize(vf_add(ay, vf_mul(nA, Gauss(&rng))), ACCEL_LSB);
+			az = Quantize(vf_add(az, vf_mul(nA, Gauss(&rng))), ACCEL_LSB);
+			gx = Quantize(vf_add(vf_mul(vf_neg(dth), vf_set1(57.29578f)), vf_mul(nG, Gauss(&rng))), GYRO_LSB);
+			
+			vf pitchAccel = vf_mul(bq_atan2(ay, az), vf_set1(180.0f / 3.14159265f));
+			
+			pitch = vf_add(vf_mul(vf_set1(0.95238f), vf_add(pitch, vf_mul(gx, vf_set1(0.005f)))),
+			               vf_mul(vf_set1(1 - 0.95238f), pitchAccel));
+		}
+		
+		//
+		// App_Motor_Proc，每1ms
+		//
+		{
+			vf T = vf_max(dtnow, dt0);
+			vf speed = vf_select(vm_and(vf_gt(vf_mul(d0, d1), zero), vf_gt(T, zero)),
+			                     vf_div(vf_mul(d0, vf_set1(ENCODER_SCALE)), T), zero);
+			
+			vf va = BPid(&pid[BATCH_PID_MOTOR], spMotor, speed, -8.2f, 8.2f, firstMotor);
+			firstMotor = 0;
+			
+			vf d = vf_clamp(vf_mul(vf_div(va, vbat), vf_set1(100.0f)), vf_set1(-100), vf_set1(100));
+			d = vf_mul(vf_sign(d), vf_mul(vf_floor(vf_mul(vf_abs(d), vf_set1(PWM_STEPS / 100.0f))), vf_set1(1.0f / PWM_STEPS)));
+			
+			duty = vf_select(alive, d, zero); // 摔倒后电机停机
+			
+			//
+			// App_Control_Proc，每1ms：速度环每20ms（轮速取平均），角度环和摔倒检测每5ms，角速度环每1ms
+			//
+			{
+				vf dalpha = vf_mul(gx, vf_set1(0.0174532925f));
+				vf v = vf_add(speed, vf_mul(dalpha, vf_set1((LP + RW) / RW)));
+				
+				vSum = vf_add(vSum, v);
+				vCount++;
+				
+				if(ms % 20 == 0)
+				{
+					vf acc = BPid(&pid[BATCH_PID_VEL], vf_set1(C->VelSetpoint), vf_mul(vSum, vf_set1(1.0f / vCount)), -9.8f, 9.8f, firstControl);
+					alphaRef = bq_atan(vf_mul(acc, vf_set1(1.0f / G)));
+					vSum = zero;
+					vCount = 0;
+				}
+				
+				if(ms % 5 == 0)
+				{
+					alpha = vf_mul(pitch, vf_set1(0.0174532925f));
+					dalphaRef = BPid(&pid[BATCH_PID_ALPHA], alphaRef, alpha, -6.28f, 6.28f, firstControl);
+					
+					vm down = vm_and(alive, vf_gt(vf_abs(alpha), vf_set1(80 * 0.0174532925f)));
+					fellTime = vf_select(down, vf_set1(ms * 1e-3f), fellTime);
+					fell = vf_select(down, one, fell);
+				}
+				
+				vf ddalphaRef = BPid(&pid[BATCH_PID_DALPHA], dalphaRef, dalpha, -100.0f, 100.0f, firstControl);
+				firstControl = 0; // 第一次各级都运行
+				
+				vf num = vf_sub(vf_mul(vf_set1(JP), ddalphaRef), vf_mul(vf_set1(MP * G * LP), bq_sin(alpha)));
+				vf ddxRef = vf_div(num, vf_mul(vf_set1(MP * LP), bq_cos(alpha)));
+				
+				omegaRef = vf_clamp(vf_add(omegaRef, vf_mul(ddxRef, vf_set1(CONTROL_RATE_TS / RW))), vf_set1(-40), vf_set1(40));
+				spMotor = vf_neg(omegaRef);
+			}
+		}
+		
+		if(ms == pushMs)
+		{
+			dth = vf_add(dth, vf_set1(C->PushRate));
+		}
+		
+		//
+		// 被控对象，1ms内积分subSteps步
+		//
+		for(int k=0; k<subSteps; k++)
+		{
+			vf omega = vf_neg(vf_sub(vf_mul(dx, vf_set1(1.0f / RW)), dth)); // 电机转速（固件的正方向）
+			vf V = vf_mul(duty, vbat);
+			vf iInf = vf_mul(vf_sub(V, vf_mul(vf_set1(KE), omega)), vf_set1(1.0f / RA));
+			cur = vf_add(iInf, vf_mul(vf_sub(cur, iInf), decay));
+			
+			vf friction = vf_mul(vf_set1(TIDLE), vf_clamp(vf_mul(omega, vf_set1(10.0f)), vf_set1(-1), one));
+			vf torque = vf_mul(vf_set1(-2.0f), vf_sub(vf_sub(vf_mul(vf_set1(KT), cur), vf_mul(vf_set1(BM), omega)), friction)); // 两个电机
+			
+			energy = vf_add(energy, vf_mul(vf_abs(vf_mul(V, cur)), vf_set1(2 * dt)));
+			
+			vf s = PSin(th), c = PCos(th);
+			vf m11 = vf_add(m11Base, mp);
+			vf m12 = vf_mul(vf_mul(mp, vf_set1(LP)), c);
+			vf f1 = vf_add(vf_mul(torque, vf_set1(1.0f / RW)), vf_mul(vf_mul(mp, vf_set1(LP)), vf_mul(s, vf_mul(dth, dth))));
+			vf f2 = vf_sub(vf_mul(vf_mul(mp, vf_set1(G * LP)), s), torque);
+			vf invDet = vf_div(one, vf_sub(vf_mul(m11, jp), vf_mul(m12, m12)));
+			
+			ddx = vf_mul(vf_sub(vf_mul(f1, jp), vf_mul(m12, f2)), invDet);
+			ddth = vf_mul(vf_sub(vf_mul(m11, f2), vf_mul(m12, f1)), invDet);
+			
+			// 触地后倾角不再变化，轮子推着整车移动
+			vm ground = vm_or(vm_and(vf_ge(th, vf_set1(THETA_MAX)), vf_gt(ddth, zero)),
+			                  vm_and(vf_ge(vf_neg(th), vf_set1(THETA_MAX)), vf_lt(ddth, zero)));
+			ddx = vf_select(ground, vf_div(f1, m11), ddx);
+			ddth = vf_select(ground, zero, ddth);
+			
+			dx = vf_add(dx, vf_mul(ddx, vf_set1(dt)));
+			dth = vf_add(dth, vf_mul(ddth, vf_set1(dt)));
+			x = vf_add(x, vf_mul(dx, vf_set1(dt)));
+			th = vf_add(th, vf_mul(dth, vf_set1(dt)));
+			
+			// 越过触地角度时截断
+			vm hiHit = vf_gt(th, vf_set1(THETA_MAX));
+			vm loHit = vf_lt(th, vf_set1(-THETA_MAX));
+			
+			// 车体触地同样记为摔倒：轮子贴地空转时加速度计读数被污染，姿态解算不一定能读到80度
+			vm touch = vm_and(vm_not(vm_from_vf(fell)), vm_or(hiHit, loHit));
+			fellTime = vf_select(touch, vf_set1(ms * 1e-3f), fellTime);
+			fell = vf_select(touch, one, fell);
+			dth = vf_select(vm_and(hiHit, vf_gt(dth, zero)), zero, dth);
+			dth = vf_select(vm_and(loHit, vf_lt(dth, zero)), zero, dth);
+			th = vf_clamp(th, vf_set1(-THETA_MAX), vf_set1(THETA_MAX));
+			
+			// 编码器边沿，步长内至多一个边沿（最高转速下每100us约0.3个）
+			vf angle = vf_neg(vf_sub(vf_mul(x, vf_set1(1.0f / RW)), th));
+			vf newCount = vf_floor(vf_mul(angle, vf_set1(1.0f / ENCODER_SCALE)));
+			vm edge = vf_ne(newCount, count);
+			vf dir = vf_select(vf_gt(newCount, count), one, vf_set1(-1));
+			
+			d1 = vf_select(edge, d0, d1);
+			d0 = vf_select(edge, dir, d0);
+			dt0 = vf_select(edge, vf_add(dtnow, vf_set1(dt * 0.5f)), dt0); // 边沿按步长中点计时
+			dtnow = vf_select(edge, vf_set1(dt * 0.5f), vf_add(dtnow, vf_set1(dt)));
+			count = newCount;
+		}
+		
+		if(ms >= settleMs)
+		{
+			vf p = vf_mul(th, vf_set1(57.29578f));
+			sumSq = vf_add(sumSq, vf_mul(p, p));
+			maxPitch = vf_max(maxPitch, vf_abs(p));
+			samples++;
+		}
+		
+		if(ms >= pushMs || pushMs == UINT32_MAX)
+		{
+			vm out = vf_gt(vf_abs(vf_mul(th, vf_set1(57.29578f))), vf_set1(C->SettleBand));
+			lastOut = vf_select(out, vf_set1((ms + 1) * 1e-3f), lastOut);
+		}
+	}
+	
+	float pushT = C->PushTime >= 0 ? C->PushTime : 0;
+	
+	vf_store(B->Fell + First, fell);
+	vf_store(B->FellTime + First, fellTime);
+	vf_store(B->RmsPitch + First, samples ? vf_sqrt(vf_mul(sumSq, vf_set1(1.0f / samples))) : zero);
+	vf_store(B->MaxPitch + First, maxPitch);
+	vf_store(B->Settle + First, vf_max(zero, vf_sub(lastOut, vf_set1(pushT))));
+	vf_store(B->Energy + First, energy);
+	vf_store(B->Drift + First, x);
+}
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    batch.h
+  * @version V 1.0.0
+  * @brief   批量仿真：N个小车实例按结构数组（SoA）存放，按SIMD通道并行推进
+  *
+  *          每个实例包括：
+  *          - 平面被控对象（倒立摆+两个同步的直流电机，不含偏航），参数可逐实例设置
+  *          - 编码器（A相双边沿、边沿间隔测速）和MPU6050（量化、噪声、互补滤波）
+  *          - user/app_control.c中串级PID（速度环20ms -> 角度环5ms -> 角速度环1ms）和
+  *            user/app_motor.c中电机速度环的批量移植，增益可逐实例设置
+  *          控制器的常数与固件一致，且使用与qmath.c相同的查找表（见bqmath.c）；
+  *          所有PID的Kd均为0，因此批量版本省略了微分环节
+  ******************************************************************************
+  */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h>
+
+// PID编号
+#define BATCH_PID_VEL    0 // 速度环
+#define BATCH_PID_ALPHA  1 // 角度环
+#define BATCH_PID_DALPHA 2 // 角速度环
+#define BATCH_PID_MOTOR  3 // 电机速度环（左右轮相同）
+#define BATCH_NUM_PID    4
+
+typedef struct
+{
+	float Duration;     // 仿真时长，单位s
+	uint32_t StepUs;    // 被控对象的积分步长，须能整除1000
+	float VelSetpoint;  // 速度环的设定值，与App_Control_Move(speed, 0)中的 -speed/3.8 相同
+	float PushTime;     // 扰动时刻，单位s，小于0表示无扰动
+	float PushRate;     // 扰动：在PushTime时给车体倾角速度叠加的值，单位rad/s
+	float SettleTime;   // 从此时刻开始统计RMS和最大倾角，单位s
+	float SettleBand;   // 调节时间的判据：倾角进入并保持在±SettleBand以内，单位°
+} Batch_ConfigTypeDef;
+
+typedef struct
+{
+	uint32_t Count;     // 实例个数
+	uint32_t Padded;    // 向上取整到SIMD宽度的实例个数，数组的实际长度
+	
+	// 逐实例参数
+	float *Mass;        // 摆的质量，单位kg（转动惯量按比例缩放）
+	float *Vbat;        // 电池电压，单位V
+	float *GyroNoise;   // 陀螺仪噪声标准差，单位°/s
+	float *AccelNoise;  // 加速度计噪声标准差，单位g
+	float *Theta0;      // 初始倾角，单位rad，向前为正
+	float *Kp[BATCH_NUM_PID];
+	float *Ki[BATCH_NUM_PID];
+	uint32_t *Seed;     // 噪声的随机数状态，不能为0
+	
+	// 结果
+	float *Fell;        // 1 - 倾角超过80°或车体触地（固件会停机进入起立流程）
+	float *FellTime;    // 摔倒的时刻，单位s
+	float *RmsPitch;    // SettleTime之后倾角的均方根，单位°
+	float *MaxPitch;    // SettleTime之后倾角绝对值的最大值，单位°
+	float *Settle;      // 扰动后倾角最后一次超出±SettleBand的时刻相对扰动时刻的时间，单位s
+	float *Energy;      // 两个电机消耗的电能，单位J
+	float *Drift;       // 结束时轮子的位置，单位m
+	
+	void *Memory;
+} Batch_TypeDef;
+
+int  Batch_Create(Batch_TypeDef *Batch, uint32_t Count);
+void Batch_Free(Batch_TypeDef *Batch);
+void Batch_SetDefaults(Batch_TypeDef *Batch, Batch_ConfigTypeDef *Config);
+void Batch_RunGroup(Batch_TypeDef *Batch, const Batch_ConfigTypeDef *Config, uint32_t First);
+
+#endif
@@ -0,0 +1,194 @@
+/**
+  ******************************************************************************
+  * @file    batch_main.c
+  * @version V 1.0.0
+  * @brief   批量鲁棒性扫描
+  *          在给定范围内随机抽取摆的质量、电池电压和IMU噪声，每个组合一个实例，
+  *          全部实例并行仿真后按参数分箱统计摔倒率
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O3 -mavx2 -mfma -o batch -Itools/sim -Iuser -Imy_lib \
+  *              tools/batch/batch.c tools/batch/bqmath.c tools/batch/pool.c tools/batch/batch_main.c -lm -lpthread
+  *          不加-mavx2 -mfma即为标量版本，结果在浮点舍入范围内一致
+  *
+  *          使用：./batch [-n 实例数] [-t 秒] [-j 线程数] [-a 初始倾角°] [-p 扰动rad/s]
+  *                        [-m 质量下限:上限] [-b 电压下限:上限] [-x 噪声倍数下限:上限] [-s 种子]
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "batch.h"
+#include "pool.h"
+#include "vec.h"
+
+#define GROUPS_PER_JOB 4 // 每个任务包含的通道组数
+
+typedef struct
+{
+	Batch_TypeDef *Batch;
+	const Batch_ConfigTypeDef *Config;
+} Job_TypeDef;
+
+static void RunJob(void *Arg, uint32_t Job)
+{
+	Job_TypeDef *job = Arg;
+	uint32_t first = Job * GROUPS_PER_JOB * VEC_WIDTH;
+	
+	for(uint32_t g=0; g<GROUPS_PER_JOB; g++, first += VEC_WIDTH)
+	{
+		if(first >= job->Batch->Padded) break;
+		Batch_RunGroup(job->Batch, job->Config, first);
+	}
+}
+
+static uint64_t rngState = 88172645463325252ULL;
+
+static double Uniform(double Lo, double Hi)
+{
+	rngState ^= rngState << 13;
+	rngState ^= rngState >> 7;
+	rngState ^= rngState << 17;
+	return Lo + (Hi - Lo) * ((rngState >> 11) * (1.0 / 9007199254740992.0));
+}
+
+static int ParseRange(const char *Arg, float *Lo, float *Hi)
+{
+	return sscanf(Arg, "%f:%f", Lo, Hi) == 2 && *Hi >= *Lo ? 0 : -1;
+}
+
+static double WallTime(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#define BINS 4
+
+int main(int argc, char *argv[])
+{
+	uint32_t n = 16384;
+	int threads = 0;
+	float duration = 5, tilt = 5, push = 0;
+	float massLo = 0.08f, massHi = 0.24f;   // 标称0.12kg
+	float vbatLo = 6.0f, vbatHi = 8.4f;     // 2S锂电池
+	float noiseLo = 0.5f, noiseHi = 8.0f;   // 相对于MPU6050典型噪声的倍数
+	
+	for(int i=1; i+1<argc; i+=2)
+	{
+		const char *opt = argv[i], *arg = argv[i+1];
+		int err = 0;
+		
+		if(strcmp(opt, "-n") == 0) n = atoi(arg);
+		else if(strcmp(opt, "-t") == 0) duration = atof(arg);
+		else if(strcmp(opt, "-j") == 0) threads = atoi(arg);
+		else if(strcmp(opt, "-a") == 0) tilt = atof(arg);
+		else if(strcmp(opt, "-p") == 0) push = atof(arg);
+		else if(strcmp(opt, "-s") == 0) rngState = strtoull(arg, NULL, 0) | 1;
+		else if(strcmp(opt, "-m") == 0) err = ParseRange(arg, &massLo, &massHi);
+		else if(strcmp(opt, "-b") == 0) err = ParseRange(arg, &vbatLo, &vbatHi);
+		else if(strcmp(opt, "-x") == 0) err = ParseRange(arg, &noiseLo, &noiseHi);
+		else err = -1;
+		
+		if(err) { fprintf(stderr, "bad option %s %s\n", opt, arg); return 1; }
+	}
+	
+	if(n == 0) return 1;
+	
+	Batch_TypeDef batch;
+	Batch_ConfigTypeDef config;
+	
+	if(Batch_Create(&batch, n) != 0) { fprintf(stderr, "out of memory\n"); return 1; }
+	
+	Batch_SetDefaults(&batch, &config);
+	
+	config.Duration = duration;
+	
+	if(push != 0)
+	{
+		config.PushTime = 1.0f;
+		config.PushRate = push;
+	}
+	
+	for(uint32_t i=0; i<batch.Padded; i++)
+	{
+		float k = Uniform(noiseLo, noiseHi);
+		
+		batch.Mass[i] = Uniform(massLo, massHi);
+		batch.Vbat[i] = Uniform(vbatLo, vbatHi);
+		batch.GyroNoise[i] *= k;
+		batch.AccelNoise[i] *= k;
+		batch.Theta0[i] = tilt * 0.0174532925f;
+	}
+	
+	Pool_TypeDef *pool = Pool_Create(threads);
+	Job_TypeDef job = { &batch, &config };
+	uint32_t groups = batch.Padded / VEC_WIDTH;
+	uint32_t jobs = (groups + GROUPS_PER_JOB - 1) / GROUPS_PER_JOB;
+	
+	double t0 = WallTime();
+	Pool_Run(pool, RunJob, &job, jobs);
+	double wall = WallTime() - t0;
+	
+	Pool_Destroy(pool);
+	
+	// 按参数分箱统计摔倒率
+	uint32_t fellMass[BINS] = {0}, cntMass[BINS] = {0};
+	uint32_t fellVbat[BINS] = {0}, cntVbat[BINS] = {0};
+	uint32_t fellNoise[BINS] = {0}, cntNoise[BINS] = {0};
+	uint32_t fell = 0;
+	double rms = 0;
+	uint32_t standing = 0;
+	
+	for(uint32_t i=0; i<n; i++)
+	{
+		int bm = massHi > massLo ? (int)((batch.Mass[i] - massLo) / (massHi - massLo) * BINS) : 0;
+		int bv = vbatHi > vbatLo ? (int)((batch.Vbat[i] - vbatLo) / (vbatHi - vbatLo) * BINS) : 0;
+		int bx = noiseHi > noiseLo ? (int)((batch.GyroNoise[i] / 0.05f - noiseLo) / (noiseHi - noiseLo) * BINS) : 0;
+		
+		if(bm >= BINS) bm = BINS - 1;
+		if(bv >= BINS) bv = BINS - 1;
+		if(bx >= BINS) bx = BINS - 1;
+		if(bx < 0) bx = 0;
+		
+		int f = batch.Fell[i] != 0;
+		
+		cntMass[bm]++; fellMass[bm] += f;
+		cntVbat[bv]++; fellVbat[bv] += f;
+		cntNoise[bx]++; fellNoise[bx] += f;
+		fell += f;
+		
+		if(!f)
+		{
+			rms += batch.RmsPitch[i];
+			standing++;
+		}
+	}
+	
+	printf("kernel      %s, %d lanes\n", VEC_NAME, VEC_WIDTH);
+	printf("instances   %u x %.1f s\n", n, duration);
+	printf("wall time   %.3f s (%.0f robot-seconds per second)\n", wall, n * duration / wall);
+	printf("fell        %u (%.2f%%)\n", fell, 100.0 * fell / n);
+	printf("pitch rms   %.4f deg (mean over standing instances)\n", standing ? rms / standing : 0.0);
+	
+	printf("\n%-20s", "fall rate by bin");
+	for(int b=0; b<BINS; b++) printf("  bin%d   ", b);
+	
+	printf("\n%-20s", "mass [kg]");
+	for(int b=0; b<BINS; b++) printf("%6.1f%%  ", cntMass[b] ? 100.0 * fellMass[b] / cntMass[b] : 0.0);
+	
+	printf("\n%-20s", "battery [V]");
+	for(int b=0; b<BINS; b++) printf("%6.1f%%  ", cntVbat[b] ? 100.0 * fellVbat[b] / cntVbat[b] : 0.0);
+	
+	printf("\n%-20s", "imu noise [x]");
+	for(int b=0; b<BINS; b++) printf("%6.1f%%  ", cntNoise[b] ? 100.0 * fellNoise[b] / cntNoise[b] : 0.0);
+	
+	printf("\n");
+	
+	Batch_Free(&batch);
+	
+	return 0;
+}
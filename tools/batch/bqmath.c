@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    bqmath.c
+  * @version V 1.0.0
+  * @brief   my_lib/qmath.c的批量版本
+  *          直接包含qmath.c以使用它的静态查找表，保证两者的表完全一致；
+  *          因此链接时不要再单独加入qmath.c
+  ******************************************************************************
+  */
+
+#include "bqmath.h"
+#include "../../my_lib/qmath.c"
+
+#define QMATH_IDX_SCALE 651.89864690440329530934789477382f // 1024 / (PI/2)
+#define QMATH_IDX_STEP  0.00153398078788564122971808758949f // (PI/2) / 1024
+
+//
+// @简介：把0..4095的相位索引折算到sin_vals表的0..1023，并给出象限的符号
+//
+static vf Lookup(vi Idx)
+{
+	vm q1 = vi_lt(Idx, vi_set1(1024));
+	vm q2 = vi_lt(Idx, vi_set1(2048));
+	vm q3 = vi_lt(Idx, vi_set1(3072));
+	
+	vi j = vi_select(q1, Idx,
+	       vi_select(q2, vi_sub(vi_set1(2047), Idx),
+	       vi_select(q3, vi_sub(Idx, vi_set1(2048)),
+	                     vi_sub(vi_set1(4095), Idx))));
+	
+	vf v = vf_gather(sin_vals, j);
+	
+	return vf_select(q2, v, vf_neg(v));
+}
+
+vf bq_sin(vf x)
+{
+	vf sign = vf_sign(x);
+	vi idx = vi_from_vf(vf_add(vf_mul(vf_abs(x), vf_set1(QMATH_IDX_SCALE)), vf_set1(0.5f)));
+	
+	idx = vi_and(idx, vi_set1(4095)); // 对4096取余（4096对应2PI弧度）
+	
+	return vf_mul(sign, Lookup(idx));
+}
+
+vf bq_cos(vf x)
+{
+	vi idx = vi_from_vf(vf_add(vf_mul(vf_abs(x), vf_set1(QMATH_IDX_SCALE)), vf_set1(0.5f)));
+	
+	idx = vi_and(vi_add(idx, vi_set1(1024)), vi_set1(4095)); // cos(x) = sin(x+PI/2)
+	
+	return Lookup(idx);
+}
+
+//
+// @简介：与qmath.c中的binary_search逐步相同的二分查找，
+//        各通道独立推进，已经结束的通道保持不变
+//
+vf bq_atan(vf x)
+{
+	vf sign = vf_sign(x);
+	vf t = vf_abs(x);
+	
+	vi low = vi_set1(0);
+	vi high = vi_set1(1023);
+	vi mid = vi_set1(0);
+	vm found = vf_ne(vf_set1(0), vf_set1(0)); // 全假
+	
+	for(int iter=0; iter<11; iter++) // 1024个元素最多11次
+	{
+		vm active = vm_and(vm_not(vi_lt(high, low)), vm_not(found));
+		
+		if(!vm_any(active)) break;
+		
+		vi m = vi_add(low, vi_shr(vi_sub(high, low), 1));
+		vf v = vf_gather(tan_vals, vi_and(m, vi_set1(1023)));
+		
+		vm gt = vm_and(active, vf_gt(v, t));
+		vm lt = vm_and(active, vf_lt(v, t));
+		
+		high = vi_select(gt, vi_sub(m, vi_set1(1)), high);
+		low = vi_select(lt, vi_add(m, vi_set1(1)), low);
+		found = vm_or(found, vm_and(active, vm_not(vm_or(gt, lt))));
+		mid = vi_select(active, m, mid);
+	}
+	
+	return vf_mul(sign, vf_mul(vf_from_vi(mid), vf_set1(QMATH_IDX_STEP)));
+}
+
+vf bq_atan2(vf y, vf x)
+{
+	const vf pi = vf_set1(3.1415926535897932384626433832795f);
+	const vf halfPi = vf_set1(1.5707963267948966192313216916398f);
+	const vf zero = vf_set1(0);
+	
+	vf angle = bq_atan(vf_div(y, x));
+	
+	// x<0时调整象限
+	vf left = vf_select(vf_gt(y, zero), vf_add(angle, pi),
+	          vf_select(vf_lt(y, zero), vf_sub(angle, pi), vf_neg(pi)));
+	
+	angle = vf_select(vf_lt(x, zero), left, angle);
+	
+	// x=0
+	vf axis = vf_select(vf_lt(y, zero), vf_neg(halfPi), halfPi);
+	
+	return vf_select(vm_not(vf_ne(x, zero)), axis, angle);
+}
@@ -0,0 +1,20 @@
+/**
+  ******************************************************************************
+  * @file    bqmath.h
+  * @version V 1.0.0
+  * @brief   my_lib/qmath.c的批量版本
+  *          使用与qmath.c相同的正弦表和正切表，查表和二分查找按通道并行执行
+  ******************************************************************************
+  */
+
+#ifndef BQMATH_H
+#define BQMATH_H
+
+#include "vec.h"
+
+vf bq_sin(vf x);
+vf bq_cos(vf x);
+vf bq_atan(vf x);
+vf bq_atan2(vf y, vf x);
+
+#endif
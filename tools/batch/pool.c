@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file    pool.c
+  * @version V 1.0.0
+  * @brief   固定线程数的线程池（pthread）
+  *          每次Pool_Run为一"代"，工作线程被唤醒后用原子计数器领取任务编号，
+  *          最后一个完成的线程通知调用者
+  ******************************************************************************
+  */
+
+#include "pool.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct Pool_TypeDef
+{
+	pthread_t *Threads;
+	int NumThreads;
+	
+	pthread_mutex_t Lock;
+	pthread_cond_t Wake;   // 新的一代任务或退出
+	pthread_cond_t Done;   // 本代任务全部完成
+	
+	uint32_t Generation;
+	int Quit;
+	int Busy;              // 本代中尚未退出领取循环的工作线程数
+	
+	Pool_JobFunc Func;
+	void *Arg;
+	uint32_t NumJobs;
+	uint32_t NextJob;      // 原子访问
+};
+
+static void Work(Pool_TypeDef *Pool)
+{
+	for(;;)
+	{
+		uint32_t job = __atomic_fetch_add(&Pool->NextJob, 1, __ATOMIC_RELAXED);
+		
+		if(job >= Pool->NumJobs) break;
+		
+		Pool->Func(Pool->Arg, job);
+	}
+}
+
+static void *Worker(void *Param)
+{
+	Pool_TypeDef *pool = Param;
+	uint32_t seen = 0;
+	
+	pthread_mutex_lock(&pool->Lock);
+	
+	for(;;)
+	{
+		while(!pool->Quit && pool->Generation == seen)
+		{
+			pthread_cond_wait(&pool->Wake, &pool->Lock);
+		}
+		
+		if(pool->Quit) break;
+		
+		seen = pool->Generation;
+		pthread_mutex_unlock(&pool->Lock);
+		
+		Work(pool);
+		
+		pthread_mutex_lock(&pool->Lock);
+		
+		if(--pool->Busy == 0)
+		{
+			pthread_cond_signal(&pool->Done);
+		}
+	}
+	
+	pthread_mutex_unlock(&pool->Lock);
+	return NULL;
+}
+
+//
+// @简介：创建线程池
+// @参数：Threads - 线程总数（包括调用Pool_Run的线程），小于1时取CPU核数
+//
+Pool_TypeDef *Pool_Create(int Threads)
+{
+	if(Threads < 1) Threads = Pool_DefaultThreads();
+	
+	Pool_TypeDef *pool = calloc(1, sizeof(Pool_TypeDef));
+	if(pool == NULL) return NULL;
+	
+	pthread_mutex_init(&pool->Lock, NULL);
+	pthread_cond_init(&pool->Wake, NULL);
+	pthread_cond_init(&pool->Done, NULL);
+	
+	pool->NumThreads = Threads - 1;
+	pool->Threads = calloc(pool->NumThreads > 0 ? pool->NumThreads : 1, sizeof(pthread_t));
+	
+	for(int i=0; i<pool->NumThreads; i++)
+	{
+		pthread_create(&pool->Threads[i], NULL, Worker, pool);
+	}
+	
+	return pool;
+}
+
+void Pool_Run(Pool_TypeDef *Pool, Pool_JobFunc Func, void *Arg, uint32_t NumJobs)
+{
+	pthread_mutex_lock(&Pool->Lock);
+	
+	Pool->Func = Func;
+	Pool->Arg = Arg;
+	Pool->NumJobs = NumJobs;
+	Pool->NextJob = 0;
+	Pool->Busy = Pool->NumThreads;
+	Pool->Generation++;
+	
+	pthread_cond_broadcast(&Pool->Wake);
+	pthread_mutex_unlock(&Pool->Lock);
+	
+	Work(Pool); // 调用者也参与
+	
+	pthread_mutex_lock(&Pool->Lock);
+	
+	while(Pool->Busy > 0)
+	{
+		pthread_cond_wait(&Pool->Done, &Pool->Lock);
+	}
+	
+	pthread_mutex_unlock(&Pool->Lock);
+}
+
+void Pool_Destroy(Pool_TypeDef *Pool)
+{
+	pthread_mutex_lock(&Pool->Lock);
+	Pool->Quit = 1;
+	pthread_cond_broadcast(&Pool->Wake);
+	pthread_mutex_unlock(&Pool->Lock);
+	
+	for(int i=0; i<Pool->NumThreads; i++)
+	{
+		pthread_join(Pool->Threads[i], NULL);
+	}
+	
+	pthread_mutex_destroy(&Pool->Lock);
+	pthread_cond_destroy(&Pool->Wake);
+	pthread_cond_destroy(&Pool->Done);
+	free(Pool->Threads);
+	free(Pool);
+}
+
+int Pool_DefaultThreads(void)
+{
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? (int)n : 1;
+}
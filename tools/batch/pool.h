@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file    pool.h
+  * @version V 1.0.0
+  * @brief   固定线程数的线程池
+  *          Pool_Run把编号0..NumJobs-1的任务分给所有线程（包括调用者），全部完成后返回
+  ******************************************************************************
+  */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+
+typedef void (*Pool_JobFunc)(void *Arg, uint32_t Job);
+
+typedef struct Pool_TypeDef Pool_TypeDef;
+
+Pool_TypeDef *Pool_Create(int Threads);
+         void Pool_Run(Pool_TypeDef *Pool, Pool_JobFunc Func, void *Arg, uint32_t NumJobs);
+         void Pool_Destroy(Pool_TypeDef *Pool);
+          int Pool_DefaultThreads(void);
+
+#endif
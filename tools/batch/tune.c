@@ -0,0 +1,471 @@
+/**
+  ******************************************************************************
+  * @file    tune.c
+  * @version V 1.0.0
+  * @brief   PID增益自动整定（在电脑上运行）
+  *          用CMA-ES在对数空间中搜索串级PID和电机速度环的8个增益（Kp、Ki），
+  *          每个候选增益在若干组工况（质量、电池电压、IMU噪声、初始倾角）下各仿真一次，
+  *          按摔倒、扰动后的调节时间、超调、倾角RMS、电能和位置漂移加权打分；
+  *          一代中所有候选×工况组成一个批量仿真，由线程池分给全部CPU核心
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O3 -mavx2 -mfma -o tune -Itools/sim -Iuser -Imy_lib \
+  *              tools/batch/batch.c tools/batch/bqmath.c tools/batch/pool.c tools/batch/tune.c -lm -lpthread
+  *          使用：./tune [-g 代数] [-l 种群大小] [-t 秒] [-p 扰动rad/s] [-j 线程数] [-s 种子] > user/app_pid_gain.h
+  *          搜索过程和整定前后的对比输出到stderr，增益头文件输出到stdout
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "batch.h"
+#include "pool.h"
+#include "vec.h"
+#include "app_pid_gain.h"
+
+#define N (2 * BATCH_NUM_PID) // 搜索维数：4个PID的Kp和Ki
+#define MAX_LAMBDA 64
+
+#define SEARCH_RANGE 20.0 // 每个增益的搜索范围：初始值的1/20..20倍
+
+// 打分的权重
+#define W_FALL   100.0  // 摔倒，另按剩余时间的比例再加同样的分数，越早摔倒越差
+#define W_SETTLE 2.0    // 调节时间，每秒
+#define W_OVER   0.5    // 扰动后倾角的最大值，每度
+#define W_RMS    2.0    // 扰动后倾角的RMS，每度
+#define W_ENERGY 0.05   // 电能，每焦耳
+#define W_DRIFT  30.0   // 结束时的位置，每米
+
+//
+// 工况，每个候选增益在下列全部工况下仿真
+//
+typedef struct
+{
+	float Mass;   // 摆的质量，单位kg
+	float Vbat;   // 电池电压，单位V
+	float Noise;  // IMU噪声相对于典型值的倍数
+	float Tilt;   // 初始倾角，单位°
+} Scenario_TypeDef;
+
+static const Scenario_TypeDef scenarios[] = {
+	{0.12f, 7.4f, 1, 5}, {0.12f, 7.4f, 1, -5}, {0.09f, 8.2f, 1, 3}, {0.16f, 8.2f, 1, -3},
+	{0.09f, 6.4f, 4, -5}, {0.16f, 6.4f, 4, 5}, {0.12f, 6.8f, 8, 0}, {0.14f, 7.8f, 2, 8},
+};
+
+#define NUM_SCENARIOS (sizeof(scenarios) / sizeof(scenarios[0]))
+
+static const double initGain[N] = {
+	PID_GAIN_VEL_KP, PID_GAIN_ALPHA_KP, PID_GAIN_DALPHA_KP, PID_GAIN_MOTOR_KP,
+	PID_GAIN_VEL_KI, PID_GAIN_ALPHA_KI, PID_GAIN_DALPHA_KI, PID_GAIN_MOTOR_KI,
+};
+
+typedef struct
+{
+	Batch_TypeDef *Batch;
+	const Batch_ConfigTypeDef *Config;
+} Job_TypeDef;
+
+static void RunJob(void *Arg, uint32_t Job)
+{
+	Job_TypeDef *job = Arg;
+	Batch_RunGroup(job->Batch, job->Config, Job * VEC_WIDTH);
+}
+
+static uint64_t rngState = 88172645463325252ULL;
+
+static double Uniform(void)
+{
+	rngState ^= rngState << 13;
+	rngState ^= rngState >> 7;
+	rngState ^= rngState << 17;
+	return ((rngState >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static double Gauss(void)
+{
+	return sqrt(-2 * log(Uniform())) * cos(6.283185307179586 * Uniform());
+}
+
+//
+// @简介：在一个批量仿真中评估Count组增益
+// @参数：Gain - Count组增益，每组N个，排列顺序与initGain相同
+// @参数：pCost - 输出参数，每组增益在所有工况下的平均分数，越小越好
+// @参数：pFell - 输出参数，每组增益摔倒的工况数，可以为NULL
+//
+static void Evaluate(Pool_TypeDef *Pool, Batch_TypeDef *Batch, const Batch_ConfigTypeDef *Config,
+                     const double (*Gain)[N], int Count, double *pCost, int *pFell)
+{
+	for(int c=0; c<Count; c++)
+	{
+		for(uint32_t s=0; s<NUM_SCENARIOS; s++)
+		{
+			uint32_t i = c * NUM_SCENARIOS + s;
+
+			Batch->Mass[i] = scenarios[s].Mass;
+			Batch->Vbat[i] = scenarios[s].Vbat;
+			Batch->GyroNoise[i] = 0.05f * scenarios[s].Noise;
+			Batch->AccelNoise[i] = 0.004f * scenarios[s].Noise;
+			Batch->Theta0[i] = scenarios[s].Tilt * 0.0174532925f;
+			Batch->Seed[i] = 2463534242u + s * 2654435761u; // 同一工况对所有候选使用相同的噪声序列
+
+			for(int k=0; k<BATCH_NUM_PID; k++)
+			{
+				Batch->Kp[k][i] = (float)Gain[c][k];
+				Batch->Ki[k][i] = (float)Gain[c][BATCH_NUM_PID + k];
+			}
+		}
+	}
+
+	Job_TypeDef job = { Batch, Config };
+	uint32_t lanes = Count * NUM_SCENARIOS;
+
+	Pool_Run(Pool, RunJob, &job, (lanes + VEC_WIDTH - 1) / VEC_WIDTH);
+
+	for(int c=0; c<Count; c++)
+	{
+		double sum = 0;
+		int fell = 0;
+
+		for(uint32_t s=0; s<NUM_SCENARIOS; s++)
+		{
+			uint32_t i = c * NUM_SCENARIOS + s;
+
+			if(Batch->Fell[i] != 0)
+			{
+				sum += W_FALL * (2 - Batch->FellTime[i] / Config->Duration);
+				fell++;
+				continue;
+			}
+
+			sum += W_SETTLE * Batch->Settle[i]
+			     + W_OVER * Batch->MaxPitch[i]
+			     + W_RMS * Batch->RmsPitch[i]
+			     + W_ENERGY * Batch->Energy[i]
+			     + W_DRIFT * fabsf(Batch->Drift[i]);
+		}
+
+		pCost[c] = sum / NUM_SCENARIOS;
+		if(pFell) pFell[c] = fell;
+	}
+}
+
+//
+// @简介：对称矩阵的特征分解（Jacobi迭代）
+// @参数：A - 输入矩阵，返回时被破坏
+// @参数：V - 输出参数，特征向量（按列）
+// @参数：d - 输出参数，特征值
+//
+static void Eigen(double A[N][N], double V[N][N], double d[N])
+{
+	for(int i=0; i<N; i++)
+	{
+		for(int j=0; j<N; j++) V[i][j] = i == j;
+	}
+
+	for(int sweep=0; sweep<50; sweep++)
+	{
+		double off = 0;
+
+		for(int p=0; p<N; p++)
+		{
+			for(int q=p+1; q<N; q++) off += A[p][q] * A[p][q];
+		}
+
+		if(off < 1e-30) break;
+
+		for(int p=0; p<N; p++)
+		{
+			for(int q=p+1; q<N; q++)
+			{
+				if(fabs(A[p][q]) < 1e-300) continue;
+
+				double theta = (A[q][q] - A[p][p]) / (2 * A[p][q]);
+				double t = (theta >= 0 ? 1 : -1) / (fabs(theta) + sqrt(theta * theta + 1));
+				double c = 1 / sqrt(t * t + 1), s = t * c;
+
+				for(int k=0; k<N; k++)
+				{
+					double akp = A[k][p], akq = A[k][q];
+					A[k][p] = c * akp - s * akq;
+					A[k][q] = s * akp + c * akq;
+				}
+
+				for(int k=0; k<N; k++)
+				{
+					double apk = A[p][k], aqk = A[q][k];
+					A[p][k] = c * apk - s * aqk;
+					A[q][k] = s * apk + c * aqk;
+				}
+
+				for(int k=0; k<N; k++)
+				{
+					double vkp = V[k][p], vkq = V[k][q];
+					V[k][p] = c * vkp - s * vkq;
+					V[k][q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+
+	for(int i=0; i<N; i++) d[i] = A[i][i];
+}
+
+//
+// @简介：按分数从小到大排列候选的编号（插入排序，种群很小）
+//
+static void SortByCost(int *Order, const double *Cost, int Count)
+{
+	for(int i=0; i<Count; i++) Order[i] = i;
+
+	for(int i=1; i<Count; i++)
+	{
+		int k = Order[i], j = i;
+
+		for(; j>0 && Cost[Order[j-1]] > Cost[k]; j--) Order[j] = Order[j-1];
+
+		Order[j] = k;
+	}
+}
+
+static void PrintGains(FILE *f, const double g[N])
+{
+	fprintf(f, "vel %.4g/%.4g  alpha %.4g/%.4g  dalpha %.4g/%.4g  motor %.4g/%.4g",
+	        g[0], g[4], g[1], g[5], g[2], g[6], g[3], g[7]);
+}
+
+int main(int argc, char *argv[])
+{
+	int generations = 60, lambda = 16, threads = 0;
+	float duration = 6, push = 2;
+
+	for(int i=1; i+1<argc; i+=2)
+	{
+		const char *opt = argv[i], *arg = argv[i+1];
+
+		if(strcmp(opt, "-g") == 0) generations = atoi(arg);
+		else if(strcmp(opt, "-l") == 0) lambda = atoi(arg);
+		else if(strcmp(opt, "-t") == 0) duration = atof(arg);
+		else if(strcmp(opt, "-p") == 0) push = atof(arg);
+		else if(strcmp(opt, "-j") == 0) threads = atoi(arg);
+		else if(strcmp(opt, "-s") == 0) rngState = strtoull(arg, NULL, 0) | 1;
+		else { fprintf(stderr, "bad option %s %s\n", opt, arg); return 1; }
+	}
+
+	if(lambda < 4 || lambda > MAX_LAMBDA || generations < 1 || duration < 2)
+	{
+		fprintf(stderr, "population must be 4..%d, generations >= 1, duration >= 2 s\n", MAX_LAMBDA);
+		return 1;
+	}
+
+	Batch_TypeDef batch;
+	Batch_ConfigTypeDef config;
+
+	if(Batch_Create(&batch, lambda * NUM_SCENARIOS) != 0) { fprintf(stderr, "out of memory\n"); return 1; }
+
+	Batch_SetDefaults(&batch, &config);
+
+	config.Duration = duration;
+	config.PushTime = 1.0f;
+	config.PushRate = push;
+	config.SettleTime = 1.0f; // 倾角的最大值和RMS只统计扰动之后，初始倾角的恢复过程不计入
+
+	Pool_TypeDef *pool = Pool_Create(threads);
+
+	//
+	// CMA-ES的参数（Hansen, The CMA Evolution Strategy: A Tutorial）
+	//
+	int mu = lambda / 2;
+	double w[MAX_LAMBDA], wsum = 0, w2sum = 0;
+
+	for(int i=0; i<mu; i++)
+	{
+		w[i] = log(mu + 0.5) - log(i + 1);
+		wsum += w[i];
+	}
+
+	for(int i=0; i<mu; i++)
+	{
+		w[i] /= wsum;
+		w2sum += w[i] * w[i];
+	}
+
+	double mueff = 1 / w2sum;
+	double cc = (4 + mueff / N) / (N + 4 + 2 * mueff / N);
+	double cs = (mueff + 2) / (N + mueff + 5);
+	double c1 = 2 / ((N + 1.3) * (N + 1.3) + mueff);
+	double cmu = fmin(1 - c1, 2 * (mueff - 2 + 1 / mueff) / ((N + 2) * (N + 2) + mueff));
+	double damps = 1 + 2 * fmax(0, sqrt((mueff - 1) / (N + 1)) - 1) + cs;
+	double chiN = sqrt(N) * (1 - 1.0 / (4 * N) + 1.0 / (21 * N * N));
+
+	// 状态：均值、步长、协方差及其分解、进化路径，均在log(增益)空间中
+	double m[N], lo[N], hi[N], sigma = 0.5;
+	double C[N][N] = {{0}}, B[N][N], D[N], pc[N] = {0}, ps[N] = {0};
+
+	for(int i=0; i<N; i++)
+	{
+		m[i] = log(initGain[i]);
+		lo[i] = m[i] - log(SEARCH_RANGE);
+		hi[i] = m[i] + log(SEARCH_RANGE);
+		C[i][i] = 1;
+	}
+
+	// 整定前的分数，作为对比的基准
+	double base[1][N], baseCost;
+	int baseFell;
+
+	memcpy(base[0], initGain, sizeof(base[0]));
+	Evaluate(pool, &batch, &config, base, 1, &baseCost, &baseFell);
+
+	fprintf(stderr, "initial     cost %8.4f  fell %d/%d  ", baseCost, baseFell, (int)NUM_SCENARIOS);
+	PrintGains(stderr, initGain);
+	fprintf(stderr, "\n");
+
+	double bestGain[N], bestCost = baseCost;
+	int bestFell = baseFell;
+	memcpy(bestGain, initGain, sizeof(bestGain));
+
+	double y[MAX_LAMBDA][N], gain[MAX_LAMBDA][N], cost[MAX_LAMBDA];
+	int order[MAX_LAMBDA], fell[MAX_LAMBDA];
+
+	for(int gen=0; gen<generations; gen++)
+	{
+		// #1. 分解协方差矩阵 C = B*diag(D^2)*B'
+		double A[N][N];
+		memcpy(A, C, sizeof(A));
+		Eigen(A, B, D);
+
+		for(int i=0; i<N; i++) D[i] = sqrt(fmax(D[i], 1e-20));
+
+		// #2. 采样，超出范围的分量截断到边界
+		for(int k=0; k<lambda; k++)
+		{
+			double z[N];
+			for(int i=0; i<N; i++) z[i] = Gauss();
+
+			for(int i=0; i<N; i++)
+			{
+				double yi = 0;
+				for(int j=0; j<N; j++) yi += B[i][j] * D[j] * z[j];
+
+				double xi = fmin(fmax(m[i] + sigma * yi, lo[i]), hi[i]);
+				y[k][i] = (xi - m[i]) / sigma;
+				gain[k][i] = exp(xi);
+			}
+		}
+
+		// #3. 评估并排序
+		Evaluate(pool, &batch, &config, (const double (*)[N])gain, lambda, cost, fell);
+
+		SortByCost(order, cost, lambda);
+
+		if(cost[order[0]] < bestCost)
+		{
+			bestCost = cost[order[0]];
+			bestFell = fell[order[0]];
+			memcpy(bestGain, gain[order[0]], sizeof(bestGain));
+		}
+
+		// #4. 更新均值
+		double yw[N] = {0};
+
+		for(int i=0; i<mu; i++)
+		{
+			for(int j=0; j<N; j++) yw[j] += w[i] * y[order[i]][j];
+		}
+
+		for(int j=0; j<N; j++) m[j] += sigma * yw[j];
+
+		// #5. 更新进化路径，C^(-1/2)*yw = B*diag(1/D)*B'*yw
+		double t[N], ps2 = 0;
+
+		for(int i=0; i<N; i++)
+		{
+			t[i] = 0;
+			for(int j=0; j<N; j++) t[i] += B[j][i] * yw[j];
+			t[i] /= D[i];
+		}
+
+		for(int i=0; i<N; i++)
+		{
+			double s = 0;
+			for(int j=0; j<N; j++) s += B[i][j] * t[j];
+
+			ps[i] = (1 - cs) * ps[i] + sqrt(cs * (2 - cs) * mueff) * s;
+			ps2 += ps[i] * ps[i];
+		}
+
+		double psNorm = sqrt(ps2);
+		int hsig = psNorm / sqrt(1 - pow(1 - cs, 2 * (gen + 1))) < (1.4 + 2.0 / (N + 1)) * chiN;
+
+		for(int i=0; i<N; i++)
+		{
+			pc[i] = (1 - cc) * pc[i] + hsig * sqrt(cc * (2 - cc) * mueff) * yw[i];
+		}
+
+		// #6. 更新协方差矩阵（rank-one + rank-mu）
+		for(int i=0; i<N; i++)
+		{
+			for(int j=0; j<N; j++)
+			{
+				double rankMu = 0;
+				for(int k=0; k<mu; k++) rankMu += w[k] * y[order[k]][i] * y[order[k]][j];
+
+				C[i][j] = (1 - c1 - cmu) * C[i][j]
+				        + c1 * (pc[i] * pc[j] + (1 - hsig) * cc * (2 - cc) * C[i][j])
+				        + cmu * rankMu;
+			}
+		}
+
+		// #7. 更新步长
+		sigma *= exp(cs / damps * (psNorm / chiN - 1));
+		sigma = fmin(sigma, 2.0);
+
+		fprintf(stderr, "gen %3d     cost %8.4f  fell %d/%d  sigma %.3f  best %.4f\n",
+		        gen + 1, cost[order[0]], fell[order[0]], (int)NUM_SCENARIOS, sigma, bestCost);
+
+		if(sigma < 1e-3) break;
+	}
+
+	fprintf(stderr, "tuned       cost %8.4f  fell %d/%d  ", bestCost, bestFell, (int)NUM_SCENARIOS);
+	PrintGains(stderr, bestGain);
+	fprintf(stderr, "\n");
+
+	Pool_Destroy(pool);
+	Batch_Free(&batch);
+
+	//
+	// 输出头文件
+	//
+	static const char *names[N] = {
+		"VEL_KP   ", "ALPHA_KP ", "DALPHA_KP", "MOTOR_KP ",
+		"VEL_KI   ", "ALPHA_KI ", "DALPHA_KI", "MOTOR_KI ",
+	};
+	static const char *notes[N] = {
+		" // 速度环", " // 角度环", " // 角速度环", " // 电机速度环", "", "", "", "",
+	};
+	static const int print[N] = {0, 4, 1, 5, 2, 6, 3, 7};
+
+	printf("/**\n");
+	printf("  ******************************************************************************\n");
+	printf("  * @file    app_pid_gain.h\n");
+	printf("  * @brief   串级PID和电机速度环的增益，由tools/batch/tune自动生成，请勿手工修改\n");
+	printf("  *          %d组工况，仿真%gs，%gs时扰动%grad/s\n", (int)NUM_SCENARIOS, duration, config.PushTime, push);
+	printf("  *          分数 %.4f（整定前 %.4f），摔倒 %d/%d（整定前 %d/%d）\n",
+	       bestCost, baseCost, bestFell, (int)NUM_SCENARIOS, baseFell, (int)NUM_SCENARIOS);
+	printf("  ******************************************************************************\n");
+	printf("  */\n\n");
+	printf("#ifndef APP_PID_GAIN_H\n");
+	printf("#define APP_PID_GAIN_H\n\n");
+
+	for(int i=0; i<N; i++)
+	{
+		int k = print[i];
+		printf("#define PID_GAIN_%s %.7ef%s\n", names[k], bestGain[k], notes[k]);
+	}
+
+	printf("\n#endif\n");
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file    vec.h
+  * @version V 1.0.0
+  * @brief   批量仿真用的SIMD通道抽象
+  *          用-mavx2编译时每个vf包含8个float（AVX2），否则退化为单个float，
+  *          批量内核只写一份，两种编译方式共用
+  ******************************************************************************
+  */
+
+#ifndef VEC_H
+#define VEC_H
+
+#include <stdint.h>
+#include <math.h>
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#define VEC_WIDTH 8
+#define VEC_NAME "avx2"
+
+typedef __m256  vf; // 8个float
+typedef __m256  vm; // 比较结果（每个通道全0或全1）
+typedef __m256i vi; // 8个int32/uint32
+
+static inline vf vf_set1(float a) { return _mm256_set1_ps(a); }
+static inline vf vf_load(const float *p) { return _mm256_load_ps(p); }
+static inline void vf_store(float *p, vf a) { _mm256_store_ps(p, a); }
+static inline vf vf_add(vf a, vf b) { return _mm256_add_ps(a, b); }
+static inline vf vf_sub(vf a, vf b) { return _mm256_sub_ps(a, b); }
+static inline vf vf_mul(vf a, vf b) { return _mm256_mul_ps(a, b); }
+static inline vf vf_div(vf a, vf b) { return _mm256_div_ps(a, b); }
+static inline vf vf_min(vf a, vf b) { return _mm256_min_ps(a, b); }
+static inline vf vf_max(vf a, vf b) { return _mm256_max_ps(a, b); }
+static inline vf vf_floor(vf a) { return _mm256_floor_ps(a); }
+static inline vf vf_sqrt(vf a) { return _mm256_sqrt_ps(a); }
+static inline vf vf_abs(vf a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+static inline vf vf_neg(vf a) { return _mm256_xor_ps(_mm256_set1_ps(-0.0f), a); }
+
+static inline vm vf_gt(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static inline vm vf_ge(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+static inline vm vf_lt(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline vm vf_ne(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_OQ); }
+static inline vm vm_and(vm a, vm b) { return _mm256_and_ps(a, b); }
+static inline vm vm_or(vm a, vm b) { return _mm256_or_ps(a, b); }
+static inline vm vm_not(vm a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+static inline int vm_any(vm a) { return _mm256_movemask_ps(a) != 0; }
+static inline vm vm_from_vf(vf a) { return _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_UQ); } // 非0为真
+static inline vf vf_from_vm(vm a) { return _mm256_and_ps(a, _mm256_set1_ps(1.0f)); } // 真为1.0
+static inline vf vf_select(vm m, vf a, vf b) { return _mm256_blendv_ps(b, a, m); } // m ? a : b
+
+static inline vi vi_set1(int32_t a) { return _mm256_set1_epi32(a); }
+static inline vi vi_load(const uint32_t *p) { return _mm256_load_si256((const __m256i *)p); }
+static inline void vi_store(uint32_t *p, vi a) { _mm256_store_si256((__m256i *)p, a); }
+static inline vi vi_from_vf(vf a) { return _mm256_cvttps_epi32(a); } // 向0取整
+static inline vf vf_from_vi(vi a) { return _mm256_cvtepi32_ps(a); }
+static inline vi vi_add(vi a, vi b) { return _mm256_add_epi32(a, b); }
+static inline vi vi_sub(vi a, vi b) { return _mm256_sub_epi32(a, b); }
+static inline vi vi_and(vi a, vi b) { return _mm256_and_si256(a, b); }
+static inline vi vi_xor(vi a, vi b) { return _mm256_xor_si256(a, b); }
+static inline vi vi_shl(vi a, int n) { return _mm256_slli_epi32(a, n); }
+static inline vi vi_shr(vi a, int n) { return _mm256_srli_epi32(a, n); }
+static inline vm vi_lt(vi a, vi b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)); }
+static inline vi vi_select(vm m, vi a, vi b) { return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), m)); }
+static inline vf vf_gather(const float *Table, vi Idx) { return _mm256_i32gather_ps(Table, Idx, 4); }
+
+#else
+
+#define VEC_WIDTH 1
+#define VEC_NAME "scalar"
+
+typedef float    vf;
+typedef int      vm;
+typedef uint32_t vi;
+
+static inline vf vf_set1(float a) { return a; }
+static inline vf vf_load(const float *p) { return *p; }
+static inline void vf_store(float *p, vf a) { *p = a; }
+static inline vf vf_add(vf a, vf b) { return a + b; }
+static inline vf vf_sub(vf a, vf b) { return a - b; }
+static inline vf vf_mul(vf a, vf b) { return a * b; }
+static inline vf vf_div(vf a, vf b) { return a / b; }
+static inline vf vf_min(vf a, vf b) { return a < b ? a : b; }
+static inline vf vf_max(vf a, vf b) { return a > b ? a : b; }
+static inline vf vf_floor(vf a) { return floorf(a); }
+static inline vf vf_sqrt(vf a) { return sqrtf(a); }
+static inline vf vf_abs(vf a) { return fabsf(a); }
+static inline vf vf_neg(vf a) { return -a; }
+
+static inline vm vf_gt(vf a, vf b) { return a > b; }
+static inline vm vf_ge(vf a, vf b) { return a >= b; }
+static inline vm vf_lt(vf a, vf b) { return a < b; }
+static inline vm vf_ne(vf a, vf b) { return a != b; }
+static inline vm vm_and(vm a, vm b) { return a && b; }
+static inline vm vm_or(vm a, vm b) { return a || b; }
+static inline vm vm_not(vm a) { return !a; }
+static inline int vm_any(vm a) { return a; }
+static inline vm vm_from_vf(vf a) { return a != 0; }
+static inline vf vf_from_vm(vm a) { return a ? 1.0f : 0.0f; }
+static inline vf vf_select(vm m, vf a, vf b) { return m ? a : b; }
+
+static inline vi vi_set1(int32_t a) { return (uint32_t)a; }
+static inline vi vi_load(const uint32_t *p) { return *p; }
+static inline void vi_store(uint32_t *p, vi a) { *p = a; }
+static inline vi vi_from_vf(vf a) { return (uint32_t)(int32_t)a; }
+static inline vf vf_from_vi(vi a) { return (float)(int32_t)a; }
+static inline vi vi_add(vi a, vi b) { return a + b; }
+static inline vi vi_sub(vi a, vi b) { return a - b; }
+static inline vi vi_and(vi a, vi b) { return a & b; }
+static inline vi vi_xor(vi a, vi b) { return a ^ b; }
+static inline vi vi_shl(vi a, int n) { return a << n; }
+static inline vi vi_shr(vi a, int n) { return a >> n; }
+static inline vm vi_lt(vi a, vi b) { return (int32_t)a < (int32_t)b; }
+static inline vi vi_select(vm m, vi a, vi b) { return m ? a : b; }
+static inline vf vf_gather(const float *Table, vi Idx) { return Table[Idx]; }
+
+#endif
+
+// 以下运算由基本运算组合而成，两种实现共用
+static inline vf vf_clamp(vf a, vf lo, vf hi) { return vf_min(vf_max(a, lo), hi); }
+static inline vf vf_sign(vf a) { return vf_select(vf_lt(a, vf_set1(0)), vf_set1(-1.0f), vf_set1(1.0f)); } // x<0取-1，否则取+1
+
+#endif
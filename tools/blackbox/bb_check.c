@@ -0,0 +1,688 @@
+/**
+  ******************************************************************************
+  * @file    bb_check.c
+  * @version V 1.0.0
+  * @brief   my_lib/blackbox.h的BlackBox_Q16和黑匣子导出（user/app_blackbox.c、tools/blackbox/bb_decode.c）的检查
+  *          1. BlackBox_Q16：随机的位模式（含nan、inf、非规格化数）、集中在可表示范围两端的值，
+  *             以及各小数位数下的边界值，与双精度的参考（乘以2^Frac后向0取整，饱和到±0x7fff，
+  *             nan按符号位饱和）逐个比较
+  *          2. 导出：原样编译的app_blackbox.c按控制周期（5ms）写入记录，在重新开始记录后的随机时刻
+  *             （含尚无记录、不足和超过触发前容量时）以摔倒或超时触发，触发后、导出完毕前再次触发应被忽略。
+  *             App_Telemetry_Send由本程序实现：随机地返回队列已满（须重发同一帧）、在线路上丢帧，
+  *             并穿插遥测和其它模块的帧。每帧的内容与独立推算的冻结现场（条数、触发前的条数、
+  *             先后顺序、记录的内容）比较；全部导出后交给原样编译的bb_decode解码，
+  *             输出的CSV与推算的逐行、逐个字符一致，各物理量与写入的浮点数相差不超过1 LSB，
+  *             触发前的记录t_ms为负、触发后的为正
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o bb_check -Itools/blackbox -Iuser -Imy_lib tools/blackbox/bb_check.c my_lib/blackbox.c user/app_blackbox.c my_lib/telemetry.c -lm
+  *
+  *          使用：./bb_check [-n BlackBox_Q16的随机输入个数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "app_blackbox.h"
+#include "app_telemetry.h"
+#include "delay.h"
+
+// 解码器原样编译进来，每种情形在子进程中从头运行一次
+#define main BbDecode_Main
+#include "bb_decode.c"
+#undef main
+
+#define CONTROL_PERIOD_MS 5
+#define RECORDS_PER_FRAME 4    // 与app_blackbox.c的BLACKBOX_RECORDS_PER_FRAME一致
+#define DUMPS             200  // 每种情形的导出次数
+#define MAX_SINCE_ARM     4096 // 两次重新开始记录之间最多写入的记录条数
+#define STALL_MS          10000 // 超过此时间没有导出完毕一次即视为停滞
+#define US_OFFSET         (0xffffffffu - 3000000u) // 开始后约3s微秒时间回绕
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static int Chance(double P)
+{
+	return Rand() < P * 4294967296.0;
+}
+
+static void Check(int Ok, const char *What, unsigned long A, unsigned long B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %lu, expected %lu\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 1. BlackBox_Q16
+//////////////////////////////////////////////////////////////////////////
+
+static int16_t RefQ16(float Value, uint8_t Frac)
+{
+	if(isnan(Value)) return signbit(Value) ? -0x7fff : 0x7fff;
+
+	double x = trunc((double)Value * ldexp(1.0, Frac)); // 乘以2的幂，双精度下没有舍入
+
+	if(x >= 0x7fff) return 0x7fff;
+	if(x <= -0x7fff) return -0x7fff;
+
+	return (int16_t)x;
+}
+
+static void CheckQ16(float Value, uint8_t Frac)
+{
+	int16_t got = BlackBox_Q16(Value, Frac), want = RefQ16(Value, Frac);
+
+	if(got != want && failures < 20)
+	{
+		printf("BlackBox_Q16(%a, %u) = %d, expected %d\n", Value, Frac, got, want);
+	}
+
+	Check(got == want, "q16", (uint16_t)got, (uint16_t)want);
+}
+
+static float FromBits(uint32_t Bits)
+{
+	union { float f; uint32_t u; } v;
+
+	v.u = Bits;
+
+	return v.f;
+}
+
+static void Q16(unsigned long Count)
+{
+	for(uint8_t frac=0; frac<16; frac++)
+	{
+		float top = ldexpf(1.0f, 15 - frac), lsb = ldexpf(1.0f, -frac);
+		const float edges[] = {0.0f, -0.0f, top, nextafterf(top, 0), lsb, nextafterf(lsb, 0),
+		                       32767 * lsb, nextafterf(32767 * lsb, 0), nextafterf(32767 * lsb, INFINITY),
+		                       1.5f * lsb, FLT_MIN, FromBits(1), FromBits(0x7fffff), FLT_MAX,
+		                       INFINITY, NAN, FromBits(0x7f800001), FromBits(0x7fc00000)};
+
+		for(size_t i=0; i<sizeof(edges) / sizeof(edges[0]); i++)
+		{
+			CheckQ16(edges[i], frac);
+			CheckQ16(-edges[i], frac);
+		}
+	}
+
+	for(unsigned long n=0; n<Count; n++)
+	{
+		uint8_t frac = Rand() % 16;
+		uint32_t bits = Rand();
+
+		if(Rand() % 4 != 0)
+		{
+			// 指数集中在2^(-Frac-3)..2^(17-Frac)，即向0取整为0和饱和的两端附近
+			uint32_t exp = 127 - frac - 3 + Rand() % 21;
+
+			bits = (bits & 0x807fffff) | exp << 23;
+		}
+
+		CheckQ16(FromBits(bits), frac);
+	}
+
+	printf("q16        %lu inputs\n", Count);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 2. 导出
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	const char *Name;
+	double Busy;        // App_Telemetry_Send返回队列已满的概率
+	double Drop;        // 发出的帧在线路上丢失的概率
+} Case_TypeDef;
+
+// 写入过的每条记录，以及写入时的浮点数
+typedef struct
+{
+	BlackBoxRecord_TypeDef Raw;
+	float Value[NUM_FIELDS];
+} History_TypeDef;
+
+// 推算的一次冻结现场
+typedef struct
+{
+	uint8_t Id, Reason;
+	uint32_t TriggerUs;
+	uint16_t Count, Pre;
+	uint32_t Index[BLACKBOX_DEPTH];    // 各条记录在history中的位置，按时间先后
+	uint8_t Received[BLACKBOX_DEPTH];  // 已送到线路上
+	uint8_t HeaderLost;
+} Dump_TypeDef;
+
+static const Case_TypeDef *cur;
+static FILE *capture;
+
+static uint32_t tick = 0;
+
+static History_TypeDef *history = NULL;
+static uint32_t numHistory = 0, maxHistory = 0;
+
+static Dump_TypeDef expect[DUMPS];
+static unsigned long numExpect;
+
+// 黑匣子状态的推算
+static struct
+{
+	uint8_t State;                   // BLACKBOX_STATE_xxx
+	uint32_t Since[MAX_SINCE_ARM];   // 重新开始记录以来写入的记录
+	uint32_t Len;
+	uint32_t TriggerAt;              // 写入多少条记录后触发
+	uint16_t Remaining;              // 冻结前还要写入的条数
+	uint8_t Reason;
+	uint32_t TriggerUs;
+	uint16_t Pre;
+	uint8_t Id;                      // 下一次导出的序号
+	int32_t Next;                    // 下一帧的第一条记录，-1表示HEADER
+	uint8_t Failed[4 + RECORDS_PER_FRAME * sizeof(BlackBoxRecord_TypeDef) + 1]; // 队列已满时未发出的帧
+	uint16_t FailedLen;
+} model;
+
+static unsigned long sent, busy, dropped, spurious;
+
+uint32_t GetTick(void)
+{
+	return tick;
+}
+
+static uint32_t NowUs(void)
+{
+	return US_OFFSET + tick * 1000u;
+}
+
+//
+// @简介：COBS编码后写入采集的数据，或者在线路上丢失
+// @返回值：1 - 写入，0 - 丢失
+//
+static int Emit(const uint8_t *pFrame, uint16_t Len)
+{
+	uint8_t enc[TELEMETRY_COBS_SIZE(1024)];
+
+	sent++;
+
+	if(Chance(cur->Drop))
+	{
+		dropped++;
+		return 0;
+	}
+
+	fwrite(enc, 1, Telemetry_CobsEncode(pFrame, Len, enc), capture);
+
+	return 1;
+}
+
+//
+// @简介：遥测和其它模块的帧，解码器应跳过
+//
+static void Noise(void)
+{
+	uint8_t frame[200];
+	uint16_t len = 2 + Rand() % (sizeof(frame) - 2);
+
+	frame[0] = Rand() % 2 ? Rand() % TELEMETRY_FRAME_USER : BLACKBOX_FRAME_DATA + 1 + Rand() % 16;
+
+	for(uint16_t i=1; i<len - 1; i++) frame[i] = Rand();
+
+	frame[len - 1] = Telemetry_Crc8(frame, len - 1);
+
+	Emit(frame, len);
+}
+
+static void SendHeader(const uint8_t *pFrame, uint16_t Len, Dump_TypeDef *D)
+{
+	Check(model.Next == -1, "header expected", model.Next, (unsigned long)-1);
+	Check(Len == 14, "header length", Len, 14);
+
+	if(Len != 14) return;
+
+	Check(pFrame[1] == BLACKBOX_VERSION, "header version", pFrame[1], BLACKBOX_VERSION);
+	Check(pFrame[2] == D->Id, "header dump id", pFrame[2], D->Id);
+	Check(pFrame[3] == D->Reason, "header reason", pFrame[3], D->Reason);
+	Check(Get32(pFrame + 4) == D->TriggerUs, "header trigger us", Get32(pFrame + 4), D->TriggerUs);
+	Check((pFrame[8] | pFrame[9] << 8) == D->Count, "header count", pFrame[8] | pFrame[9] << 8, D->Count);
+	Check((pFrame[10] | pFrame[11] << 8) == D->Pre, "header pre-trigger", pFrame[10] | pFrame[11] << 8, D->Pre);
+	Check(pFrame[12] == sizeof(BlackBoxRecord_TypeDef), "header record size", pFrame[12], sizeof(BlackBoxRecord_TypeDef));
+
+	D->HeaderLost = !Emit(pFrame, Len);
+	model.Next = 0;
+}
+
+static void SendData(const uint8_t *pFrame, uint16_t Len, Dump_TypeDef *D)
+{
+	uint16_t first = pFrame[2] | pFrame[3] << 8;
+	uint16_t n = D->Count - first < RECORDS_PER_FRAME ? D->Count - first : RECORDS_PER_FRAME;
+
+	Check(pFrame[1] == D->Id, "data dump id", pFrame[1], D->Id);
+	Check(first == model.Next, "data first record", first, model.Next);
+	Check(first < D->Count && Len == 5 + n * sizeof(BlackBoxRecord_TypeDef), "data length", Len, 5 + n * sizeof(BlackBoxRecord_TypeDef));
+
+	if(first != model.Next || first >= D->Count || Len != 5 + n * sizeof(BlackBoxRecord_TypeDef)) return;
+
+	for(uint16_t i=0; i<n; i++)
+	{
+		Check(!memcmp(pFrame + 4 + i * sizeof(BlackBoxRecord_TypeDef), &history[D->Index[first + i]].Raw, sizeof(BlackBoxRecord_TypeDef)),
+		      "data record", first + i, D->Index[first + i]);
+	}
+
+	int ok = Emit(pFrame, Len);
+
+	for(uint16_t i=0; i<n; i++) D->Received[first + i] = ok;
+
+	model.Next += n;
+
+	if(model.Next >= D->Count)
+	{
+		// 导出完毕，app_blackbox.c随即重新开始记录
+		model.State = BLACKBOX_STATE_ARMED;
+		model.Len = 0;
+		model.TriggerAt = Rand() % 250;
+		model.Next = -1;
+		model.Id++;
+		numExpect++;
+	}
+}
+
+//
+// @简介：替代user/app_telemetry.c，检查app_blackbox.c发出的每一帧
+//
+int App_Telemetry_Send(const uint8_t *pFrame, uint16_t Len)
+{
+	if(Chance(0.2)) Noise();
+
+	if(model.FailedLen != 0)
+	{
+		Check(Len == model.FailedLen && !memcmp(pFrame, model.Failed, Len), "retry same frame", Len, model.FailedLen);
+		model.FailedLen = 0;
+	}
+
+	if(Chance(cur->Busy))
+	{
+		busy++;
+
+		if(Len <= sizeof(model.Failed))
+		{
+			memcpy(model.Failed, pFrame, Len);
+			model.FailedLen = Len;
+		}
+
+		return -1;
+	}
+
+	Check(model.State == BLACKBOX_STATE_FROZEN && numExpect < DUMPS, "send while not frozen", model.State, BLACKBOX_STATE_FROZEN);
+	Check(Len >= 2 && Telemetry_Crc8(pFrame, Len - 1) == pFrame[Len - 1], "frame crc", Len, 0);
+
+	if(model.State != BLACKBOX_STATE_FROZEN || numExpect >= DUMPS || Len < 2) return 0;
+
+	Dump_TypeDef *d = &expect[numExpect];
+
+	switch(pFrame[0])
+	{
+		case BLACKBOX_FRAME_HEADER: SendHeader(pFrame, Len, d); break;
+		case BLACKBOX_FRAME_DATA:   SendData(pFrame, Len, d); break;
+		default:                    Check(0, "frame type", pFrame[0], BLACKBOX_FRAME_DATA); break;
+	}
+
+	return 0;
+}
+
+//
+// @简介：冻结时按推算的状态记下应导出的现场
+//
+static void Freeze(void)
+{
+	Dump_TypeDef *d = &expect[numExpect];
+	uint32_t count = model.Len < BLACKBOX_DEPTH ? model.Len : BLACKBOX_DEPTH;
+
+	d->Id = model.Id;
+	d->Reason = model.Reason;
+	d->TriggerUs = model.TriggerUs;
+	d->Count = count;
+	d->Pre = model.Pre;
+	d->HeaderLost = 0;
+
+	for(uint32_t i=0; i<count; i++)
+	{
+		d->Index[i] = model.Since[model.Len - count + i];
+		d->Received[i] = 0;
+	}
+
+	Check(count - model.Pre == BLACKBOX_POST_TRIGGER, "post-trigger records", count - model.Pre, BLACKBOX_POST_TRIGGER);
+
+	model.State = BLACKBOX_STATE_FROZEN;
+}
+
+static void Trigger(uint8_t Reason, uint32_t Us)
+{
+	App_BlackBox_Trigger(Reason, Us);
+
+	if(model.State != BLACKBOX_STATE_ARMED) return; // 应被忽略
+
+	model.State = BLACKBOX_STATE_TRIGGERED;
+	model.Reason = Reason;
+	model.TriggerUs = Us;
+	model.Pre = model.Len < BLACKBOX_DEPTH - BLACKBOX_POST_TRIGGER ? model.Len : BLACKBOX_DEPTH - BLACKBOX_POST_TRIGGER;
+	model.Remaining = BLACKBOX_POST_TRIGGER;
+}
+
+//
+// @简介：写入记录的物理量，多数在可表示的范围内，少数超出范围或为nan
+//
+static float RandValue(uint8_t Q)
+{
+	uint32_t r = Rand() % 100;
+	float top = ldexpf(1.0f, 15 - Q);
+
+	if(r == 0) return Rand() % 2 ? NAN : -NAN;
+
+	float v = (float)((Rand() / 4294967296.0 * 2 - 1) * top);
+
+	return r < 10 ? v * 1.5f : v;
+}
+
+//
+// @简介：一个控制周期：按app_control.c的做法先判断是否触发，再写入本周期的记录
+//
+static void Control(void)
+{
+	if(model.State == BLACKBOX_STATE_ARMED && model.Len >= model.TriggerAt)
+	{
+		Trigger(Rand() % 2 ? BLACKBOX_REASON_FALL : BLACKBOX_REASON_OVERRUN, NowUs());
+	}
+	else if(model.State != BLACKBOX_STATE_ARMED && Chance(0.05))
+	{
+		spurious++;
+		Trigger(BLACKBOX_REASON_OVERRUN, NowUs());
+	}
+
+	BlackBoxRecord_TypeDef *r = App_BlackBox_Next();
+
+	Check((r == NULL) == (model.State == BLACKBOX_STATE_FROZEN), "next returns NULL while frozen", r == NULL, model.State);
+
+	if(r == NULL || model.State == BLACKBOX_STATE_FROZEN) return;
+
+	if(numHistory == maxHistory)
+	{
+		maxHistory = maxHistory ? maxHistory * 2 : 4096;
+		history = realloc(history, maxHistory * sizeof(History_TypeDef));
+	}
+
+	History_TypeDef *h = &history[numHistory];
+
+	memset(&h->Raw, 0, sizeof(h->Raw));
+	h->Raw.Us = NowUs() + 1 + Rand() % 200;
+	h->Raw.Mode = Rand() % 4;
+	h->Raw.Flags = Rand() & (BLACKBOX_FLAG_STANDUP | BLACKBOX_FLAG_MOTOR | BLACKBOX_FLAG_OVERRUN);
+
+	for(size_t k=0; k<NUM_FIELDS; k++)
+	{
+		int16_t raw;
+
+		h->Value[k] = RandValue(fields[k].Q);
+		raw = BlackBox_Q16(h->Value[k], fields[k].Q);
+		memcpy((uint8_t *)&h->Raw + fields[k].Offset, &raw, sizeof(raw));
+	}
+
+	memcpy(r, &h->Raw, sizeof(*r));
+
+	if(model.Len < MAX_SINCE_ARM) model.Since[model.Len++] = numHistory;
+
+	numHistory++;
+
+	if(model.State == BLACKBOX_STATE_TRIGGERED && --model.Remaining == 0) Freeze();
+}
+
+//
+// @简介：在子进程中运行bb_decode -o Csv Capture
+// @返回值：bb_decode的返回值
+//
+static int Decode(const char *Capture, const char *Csv)
+{
+	fflush(stdout);
+
+	pid_t pid = fork();
+
+	if(pid == 0)
+	{
+		char *argv[] = {"bb_decode", "-o", (char *)Csv, (char *)Capture, NULL};
+
+		if(freopen("/dev/null", "w", stderr) == NULL) _exit(2); // 统计信息
+
+		_exit(BbDecode_Main(4, argv));
+	}
+
+	int status = 0;
+
+	waitpid(pid, &status, 0);
+
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+//
+// @简介：按bb_decode的格式写出一行
+//
+static void Row(char *pOut, size_t Size, const Dump_TypeDef *D, const BlackBoxRecord_TypeDef *R)
+{
+	int n = snprintf(pOut, Size, "%u,%s,%.3f,%u,%u,%u,%u,%u", D->Id, reasons[D->Reason],
+	                 (int32_t)(R->Us - D->TriggerUs) / 1000.0, R->Us, R->Mode, R->Flags & BLACKBOX_FLAG_STANDUP,
+	                 (R->Flags & BLACKBOX_FLAG_MOTOR) != 0, (R->Flags & BLACKBOX_FLAG_OVERRUN) != 0);
+
+	for(size_t k=0; k<NUM_FIELDS; k++)
+	{
+		int16_t raw;
+
+		memcpy(&raw, (const uint8_t *)R + fields[k].Offset, sizeof(raw));
+		n += snprintf(pOut + n, Size - n, ",%.*f", fields[k].Q / 3 + 1, raw / (double)(1 << fields[k].Q));
+	}
+}
+
+//
+// @简介：解码出的一行与写入时的浮点数比较：t_ms的符号与触发前后一致，各物理量相差不超过1 LSB
+//        （向0取整）加上输出时的舍入，超出范围和nan为饱和值
+//
+static void Values(char *pLine, const Dump_TypeDef *D, uint16_t Index)
+{
+	const History_TypeDef *h = &history[D->Index[Index]];
+	char *save = NULL, *tok = strtok_r(pLine, ",", &save);
+
+	for(int col=0; tok != NULL; col++, tok = strtok_r(NULL, ",", &save))
+	{
+		double x = strtod(tok, NULL);
+
+		if(col == 2)
+		{
+			Check(Index < D->Pre ? x < 0 : x > 0, "t_ms sign", Index, D->Pre);
+		}
+		else if(col >= 8 && col < 8 + (int)NUM_FIELDS)
+		{
+			const Field_TypeDef *f = &fields[col - 8];
+			double v = h->Value[col - 8], lsb = ldexp(1.0, -f->Q), top = 32767 * lsb;
+			double tol = 0.5 * pow(10, -(f->Q / 3 + 1)) + 1e-9;
+
+			if(isnan(v)) v = signbit(v) ? -top : top;
+			else if(v >= top) v = top;
+			else if(v <= -top) v = -top;
+			else tol += lsb;
+
+			Check(fabs(x - v) <= tol, "decoded value", col, Index);
+		}
+	}
+}
+
+//
+// @简介：逐行、逐个字符比较CSV
+// @返回值：输出的行数
+//
+static unsigned long Compare(FILE *Csv)
+{
+	char line[1024], want[1024];
+	unsigned long numRows = 0;
+	int n = snprintf(want, sizeof(want), "dump,reason,t_ms,us,mode,standup,motor,overrun");
+
+	for(size_t k=0; k<NUM_FIELDS; k++) n += snprintf(want + n, sizeof(want) - n, ",%s", fields[k].Name);
+
+	if(fgets(line, sizeof(line), Csv) == NULL) line[0] = '\0';
+
+	line[strcspn(line, "\n")] = '\0';
+
+	Check(strcmp(line, want) == 0, "csv header", strlen(line), strlen(want));
+
+	for(unsigned long d=0; d<numExpect; d++)
+	{
+		const Dump_TypeDef *dump = &expect[d];
+
+		if(dump->HeaderLost) continue; // 整次导出都不输出
+
+		for(uint16_t i=0; i<dump->Count; i++)
+		{
+			if(!dump->Received[i]) continue;
+
+			Row(want, sizeof(want), dump, &history[dump->Index[i]].Raw);
+
+			if(fgets(line, sizeof(line), Csv) == NULL)
+			{
+				Check(0, "csv rows", numRows, numRows + 1);
+				return numRows;
+			}
+
+			line[strcspn(line, "\n")] = '\0';
+
+			if(strcmp(line, want) != 0 && failures < 20)
+			{
+				printf("dump %lu record %u:\n  got      %s\n  expected %s\n", d, i, line, want);
+			}
+
+			Check(strcmp(line, want) == 0, "csv row", d, i);
+
+			Values(line, dump, i);
+			numRows++;
+		}
+	}
+
+	Check(fgets(line, sizeof(line), Csv) == NULL, "csv extra rows", numRows + 1, numRows);
+
+	return numRows;
+}
+
+static void Export(const Case_TypeDef *C)
+{
+	char path[] = "/tmp/bb_check_XXXXXX", csv[] = "/tmp/bb_check_XXXXXX";
+	int fdCapture = mkstemp(path), fdCsv = mkstemp(csv);
+
+	if(fdCapture < 0 || fdCsv < 0) { perror("mkstemp"); exit(2); }
+
+	cur = C;
+	capture = fdopen(fdCapture, "wb");
+	numExpect = 0;
+	sent = busy = dropped = spurious = 0;
+
+	// 上一种情形结束时刚导出完毕，黑匣子与推算的状态都是重新开始记录
+	uint32_t progress = tick;
+	unsigned long done = 0;
+
+	while(numExpect < DUMPS)
+	{
+		tick++;
+
+		if(numExpect != done)
+		{
+			done = numExpect;
+			progress = tick;
+		}
+		else if(tick - progress > STALL_MS)
+		{
+			Check(0, "dump completed", numExpect, DUMPS);
+			break;
+		}
+
+		App_BlackBox_Proc();
+
+		if(tick % CONTROL_PERIOD_MS == 0) Control();
+	}
+
+	fclose(capture);
+
+	int ret = Decode(path, csv);
+
+	Check(ret == 0, "bb_decode exit", ret, 0);
+
+	FILE *in = fdopen(fdCsv, "r");
+	unsigned long rows = Compare(in);
+
+	fclose(in);
+
+	unlink(path);
+	unlink(csv);
+
+	printf("%-10s %d dumps, %lu frames, %lu busy, %lu dropped, %lu ignored triggers, %lu rows\n",
+	       C->Name, DUMPS, sent, busy, dropped, spurious, rows);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 20000000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n inputs] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	static const Case_TypeDef cases[] =
+	{
+		{"clean", 0,   0},
+		{"busy",  0.3, 0},
+		{"drop",  0,   0.05},
+		{"all",   0.3, 0.05},
+	};
+
+	Q16(n);
+
+	model.State = BLACKBOX_STATE_ARMED;
+	model.Next = -1;
+	model.TriggerAt = Rand() % 250;
+
+	for(size_t i=0; i<sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		Export(&cases[i]);
+	}
+
+	free(history);
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
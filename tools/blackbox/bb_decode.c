@@ -0,0 +1,263 @@
+/**
+  ******************************************************************************
+  * @file    bb_decode.c
+  * @version V 1.0.0
+  * @brief   黑匣子解码器
+  *          从USART2的字节流（遥测帧和黑匣子的帧混在一起，见user/app_blackbox.h）中
+  *          找出黑匣子导出的HEADER和DATA帧，校验后按定点数的小数位数还原各物理量，输出CSV：
+  *            dump,reason,t_ms,us,mode,standup,motor,overrun,alpha,...
+  *          t_ms为相对触发时刻的时间（毫秒），触发前为负，多次导出的记录以dump区分，
+  *          每次导出的记录都按时间先后排列。缺失的记录（CRC错误等）不输出，统计信息输出到stderr
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o bb_decode -Iuser -Imy_lib tools/blackbox/bb_decode.c my_lib/telemetry.c
+  *
+  *          使用：./bb_decode [-o out.csv] [capture.bin]
+  *          不指定文件时从标准输入读取，可以与tools/telemetry/tele_decode使用同一份采集的数据
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "telemetry.h"
+#include "app_blackbox.h"
+
+#define MAX_ENCODED 1024 // 超过此长度还没有遇到0x00的数据视为损坏
+
+typedef struct
+{
+	const char *Name;
+	size_t Offset;
+	uint8_t Q;
+} Field_TypeDef;
+
+#define FIELD(Name, Member, Q) {Name, offsetof(BlackBoxRecord_TypeDef, Member), Q}
+
+static const Field_TypeDef fields[] = {
+	FIELD("alpha",      Alpha,     BLACKBOX_Q_ALPHA),
+	FIELD("dalpha",     DAlpha,    BLACKBOX_Q_GYRO),
+	FIELD("gz",         Gz,        BLACKBOX_Q_GYRO),
+	FIELD("v",          V,         BLACKBOX_Q_V),
+	FIELD("vel_out",    VelOut,    BLACKBOX_Q_PID),
+	FIELD("vel_i",      VelI,      BLACKBOX_Q_PID),
+	FIELD("alpha_out",  AlphaOut,  BLACKBOX_Q_PID),
+	FIELD("alpha_i",    AlphaI,    BLACKBOX_Q_PID),
+	FIELD("dalpha_out", DAlphaOut, BLACKBOX_Q_DPID),
+	FIELD("dalpha_i",   DAlphaI,   BLACKBOX_Q_DPID),
+	FIELD("turn_out",   TurnOut,   BLACKBOX_Q_PID),
+	FIELD("ddx_ref",    DdxRef,    BLACKBOX_Q_DDX),
+	FIELD("omega_ref",  OmegaRef,  BLACKBOX_Q_OMEGA),
+	FIELD("omega_turn", OmegaTurn, BLACKBOX_Q_TURN),
+	FIELD("duty_l",     Duty_L,    BLACKBOX_Q_DUTY),
+	FIELD("duty_r",     Duty_R,    BLACKBOX_Q_DUTY),
+	FIELD("volt",       Volt,      BLACKBOX_Q_VOLT),
+};
+
+#define NUM_FIELDS (sizeof(fields) / sizeof(fields[0]))
+
+static const char *reasons[] = {"?", "fall", "overrun"};
+
+// 正在接收的一次导出
+static int active = 0;
+static uint8_t dumpId;
+static uint8_t reason;
+static uint32_t triggerUs;
+static uint16_t count, pre;
+static BlackBoxRecord_TypeDef *records = NULL;
+static uint8_t *received = NULL;
+
+static FILE *out;
+
+// 统计
+static uint64_t bytes, frames, badFrames, dumps, rows, missing;
+
+static uint32_t Get32(const uint8_t *p)
+{
+	return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+//
+// @简介：输出一次导出的全部记录
+//
+static void Flush(void)
+{
+	if(!active) return;
+
+	for(uint16_t i=0; i<count; i++)
+	{
+		if(!received[i])
+		{
+			missing++;
+			continue;
+		}
+
+		const BlackBoxRecord_TypeDef *r = &records[i];
+
+		fprintf(out, "%u,%s,%.3f,%u,%u,%u,%u,%u", dumpId, reason < sizeof(reasons) / sizeof(reasons[0]) ? reasons[reason] : "?",
+		        (int32_t)(r->Us - triggerUs) / 1000.0, r->Us, r->Mode, r->Flags & BLACKBOX_FLAG_STANDUP,
+		        (r->Flags & BLACKBOX_FLAG_MOTOR) != 0, (r->Flags & BLACKBOX_FLAG_OVERRUN) != 0);
+
+		for(size_t k=0; k<NUM_FIELDS; k++)
+		{
+			int16_t raw;
+
+			memcpy(&raw, (const uint8_t *)r + fields[k].Offset, sizeof(raw));
+			fprintf(out, ",%.*f", fields[k].Q / 3 + 1, raw / (double)(1 << fields[k].Q));
+		}
+
+		fprintf(out, "\n");
+		rows++;
+	}
+
+	fflush(out);
+
+	fprintf(stderr, "dump %u: %s at %u us, %u records (%u before trigger)\n", dumpId,
+	        reason < sizeof(reasons) / sizeof(reasons[0]) ? reasons[reason] : "?", triggerUs, count, pre);
+
+	free(records);
+	free(received);
+	records = NULL;
+	received = NULL;
+	active = 0;
+	dumps++;
+}
+
+static void Header(const uint8_t *pFrame, int Len)
+{
+	if(Len != 13 || pFrame[1] != BLACKBOX_VERSION || pFrame[12] != sizeof(BlackBoxRecord_TypeDef))
+	{
+		badFrames++;
+		return;
+	}
+
+	Flush();
+
+	dumpId = pFrame[2];
+	reason = pFrame[3];
+	triggerUs = Get32(pFrame + 4);
+	count = pFrame[8] | pFrame[9] << 8;
+	pre = pFrame[10] | pFrame[11] << 8;
+	records = calloc(count ? count : 1, sizeof(BlackBoxRecord_TypeDef));
+	received = calloc(count ? count : 1, 1);
+	active = 1;
+}
+
+static void Data(const uint8_t *pFrame, int Len)
+{
+	if(Len < 4 || (Len - 4) % sizeof(BlackBoxRecord_TypeDef) != 0)
+	{
+		badFrames++;
+		return;
+	}
+
+	if(!active || pFrame[1] != dumpId) return; // 没有收到这次导出的HEADER
+
+	uint16_t first = pFrame[2] | pFrame[3] << 8;
+	int n = (Len - 4) / (int)sizeof(BlackBoxRecord_TypeDef);
+
+	if(first + n > count)
+	{
+		badFrames++;
+		return;
+	}
+
+	for(int i=0; i<n; i++)
+	{
+		memcpy(&records[first + i], pFrame + 4 + i * sizeof(BlackBoxRecord_TypeDef), sizeof(BlackBoxRecord_TypeDef));
+		received[first + i] = 1;
+	}
+}
+
+static void Frame(const uint8_t *pData, int Len)
+{
+	uint8_t frame[MAX_ENCODED];
+
+	if(Len == 0) return;
+
+	int n = Telemetry_CobsDecode(pData, Len, frame);
+
+	if(n < 2 || Telemetry_Crc8(frame, n - 1) != frame[n - 1])
+	{
+		badFrames++;
+		return;
+	}
+
+	frames++;
+	n--;
+
+	switch(frame[0])
+	{
+		case BLACKBOX_FRAME_HEADER: Header(frame, n); break;
+		case BLACKBOX_FRAME_DATA:   Data(frame, n); break;
+		default:                    break; // 遥测帧
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = NULL, *csvPath = NULL;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-o") && i + 1 < argc) csvPath = argv[++i];
+		else if(argv[i][0] != '-') path = argv[i];
+		else
+		{
+			fprintf(stderr, "usage: %s [-o out.csv] [capture.bin]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	FILE *in = path ? fopen(path, "rb") : stdin;
+
+	if(in == NULL) { perror(path); return 1; }
+
+	out = csvPath ? fopen(csvPath, "w") : stdout;
+
+	if(out == NULL) { perror(csvPath); return 1; }
+
+	fprintf(out, "dump,reason,t_ms,us,mode,standup,motor,overrun");
+
+	for(size_t k=0; k<NUM_FIELDS; k++) fprintf(out, ",%s", fields[k].Name);
+
+	fprintf(out, "\n");
+
+	uint8_t buf[MAX_ENCODED];
+	int len = 0;
+	int discard = 0;
+	int c;
+
+	while((c = fgetc(in)) != EOF)
+	{
+		bytes++;
+
+		if(c == 0)
+		{
+			if(!discard) Frame(buf, len);
+
+			len = 0;
+			discard = 0;
+		}
+		else if(len < MAX_ENCODED)
+		{
+			buf[len++] = c;
+		}
+		else
+		{
+			badFrames++;
+			discard = 1;
+		}
+	}
+
+	Flush();
+
+	fprintf(stderr, "bytes %llu, frames %llu, bad %llu, dumps %llu, rows %llu, missing %llu\n",
+	        (unsigned long long)bytes, (unsigned long long)frames, (unsigned long long)badFrames,
+	        (unsigned long long)dumps, (unsigned long long)rows, (unsigned long long)missing);
+
+	if(out != stdout) fclose(out);
+	if(in != stdin) fclose(in);
+
+	return 0;
+}
@@ -0,0 +1,18 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   黑匣子检查用的替身头文件
+  *          在电脑上编译user/app_blackbox.c时代替std_periph_driver/inc/stm32f10x.h，
+  *          app_blackbox.c只经task.h、delay.h用到GetTick，这里只提供delay.h需要的定义
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+#define __STATIC_INLINE static inline
+
+#endif
@@ -0,0 +1,448 @@
+/**
+  ******************************************************************************
+  * @file    boot_check.c
+  * @version V 1.0.0
+  * @brief   user/app_boot.c的检查点检查
+  *          后备寄存器和复位标志由本程序用内存实现，每次“复位”设置复位标志后调用App_Boot_Init，
+  *          后备寄存器保持不变（上电复位时按有无后备电池保持或清零）：
+  *          1. 编码和解码：随机的检查点（含超出范围的值和nan）写入后复位，热启动读到的各量
+  *             与按Q格式向0取整、饱和的结果完全一致，控制模式和电机的标志不变
+  *          2. 复位原因：看门狗、软件、复位按键引起的复位热启动，上电复位（后备寄存器保持或丢失）
+  *             一律冷启动，复位标志读取后清除
+  *          3. 连续复位：热启动后检查点立即作废，控制任务写入新的检查点之前再次复位时冷启动
+  *          4. 写入时复位：从一个有效的检查点出发写入下一个检查点（相邻控制周期只差几个LSB，
+  *             或完全无关），依次在每一次写寄存器之前复位，热启动时读到的必须是前后两个检查点之一，
+  *             否则必须冷启动
+  *          5. 后备寄存器中任意一位出错时冷启动
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o boot_check -Itools/boot -Iuser -Imy_lib tools/boot/boot_check.c user/app_boot.c -lm
+  *
+  *          使用：./boot_check [-n 随机检查点的个数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <setjmp.h>
+#include "app_boot.h"
+#include "app_telemetry.h"
+#include "app_cmd.h"
+#include "delay.h"
+
+#define NUM_REGS 10 // BKP_DR1..DR10
+
+#define CUT_NONE (-1L)
+
+// 复位标志，按RCC_FLAG_xxx - RCC_FLAG_PINRST的位置
+#define FLAG(x) (1u << ((x) - RCC_FLAG_PINRST))
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void Check(int Ok, const char *What, unsigned long A, unsigned long B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %lu, expected %lu\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 硬件替身
+//////////////////////////////////////////////////////////////////////////
+
+static uint16_t bkp[NUM_REGS + 1]; // 下标为BKP_DRx / 4
+static uint8_t backupAccess = 0;
+static uint32_t resetFlags = 0;
+
+static long writes = 0;          // 写寄存器的次数
+static long cut = CUT_NONE;      // 第几次写寄存器之前复位
+static jmp_buf powerCut;
+
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState)
+{
+	(void)RCC_APB1Periph; (void)NewState;
+}
+
+FlagStatus RCC_GetFlagStatus(uint8_t RCC_FLAG)
+{
+	return (resetFlags & FLAG(RCC_FLAG)) ? SET : RESET;
+}
+
+void RCC_ClearFlag(void)
+{
+	resetFlags = 0;
+}
+
+void PWR_BackupAccessCmd(FunctionalState NewState)
+{
+	backupAccess = NewState == ENABLE;
+}
+
+void BKP_WriteBackupRegister(uint16_t BKP_DR, uint16_t Data)
+{
+	Check(backupAccess, "backup access enabled", 0, 1);
+	Check(BKP_DR >= BKP_DR1 && BKP_DR <= BKP_DR10 && BKP_DR % 4 == 0, "backup register", BKP_DR, BKP_DR1);
+
+	if(writes == cut) longjmp(powerCut, 1);
+
+	writes++;
+	bkp[BKP_DR / 4] = Data;
+}
+
+uint16_t BKP_ReadBackupRegister(uint16_t BKP_DR)
+{
+	return bkp[BKP_DR / 4];
+}
+
+void IWDG_WriteAccessCmd(uint16_t IWDG_WriteAccess) { (void)IWDG_WriteAccess; }
+void IWDG_SetPrescaler(uint8_t IWDG_Prescaler) { (void)IWDG_Prescaler; }
+void IWDG_SetReload(uint16_t Reload) { (void)Reload; }
+void IWDG_ReloadCounter(void) {}
+void IWDG_Enable(void) {}
+void DBGMCU_Config(uint32_t DBGMCU_Periph, FunctionalState NewState) { (void)DBGMCU_Periph; (void)NewState; }
+
+uint32_t GetUs(void) { return 0; }
+uint32_t GetTick(void) { return 0; }
+
+void App_Cmd_Printf(const char *Format, ...) { (void)Format; }
+
+int8_t App_Telemetry_AddVariable(const char *Name, uint8_t Type, const volatile void *pValue, float Scale)
+{
+	(void)Name; (void)Type; (void)pValue; (void)Scale;
+	return -1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 检查点
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	const char *Name;
+	size_t Offset;
+	uint8_t Q;      // 与app_boot.c的BOOT_Q_xxx一致
+} Field_TypeDef;
+
+#define FIELD(Member, Q) {#Member, offsetof(BootCheckpoint_TypeDef, Member), Q}
+
+static const Field_TypeDef fields[] = {
+	FIELD(Pitch,    7),
+	FIELD(OmegaRef, 9),
+	FIELD(VelI,     11),
+	FIELD(AlphaI,   11),
+	FIELD(DAlphaI,  8),
+	FIELD(PosErr,   12),
+	FIELD(MotorI_L, 11),
+	FIELD(MotorI_R, 11),
+};
+
+#define NUM_FIELDS (sizeof(fields) / sizeof(fields[0]))
+
+static float *Member(BootCheckpoint_TypeDef *C, size_t K)
+{
+	return (float *)((uint8_t *)C + fields[K].Offset);
+}
+
+//
+// @简介：按Q格式向0取整、饱和到±0x7fff（nan按符号位）后还原，即热启动时应读到的值
+//
+static float Quantize(float Value, uint8_t Q)
+{
+	double x;
+
+	if(isnan(Value)) x = signbit(Value) ? -0x7fff : 0x7fff;
+	else x = fmax(-0x7fff, fmin(0x7fff, trunc((double)Value * ldexp(1.0, Q))));
+
+	return (float)(x / ldexp(1.0, Q));
+}
+
+static void Random(BootCheckpoint_TypeDef *C)
+{
+	for(size_t k=0; k<NUM_FIELDS; k++)
+	{
+		uint32_t r = Rand() % 100;
+		float top = ldexpf(1.0f, 15 - fields[k].Q);
+		float v = (float)((Rand() / 4294967296.0 * 2 - 1) * top);
+
+		*Member(C, k) = r == 0 ? (Rand() % 2 ? NAN : -NAN) : r < 5 ? v * 3 : v;
+	}
+
+	C->Mode = Rand() % 128;
+	C->Motor = Rand() % 3 == 0 ? 0 : Rand() % 255 + 1;
+}
+
+//
+// @简介：下一个控制周期的检查点，各量只差几个LSB
+//
+static void Nearby(BootCheckpoint_TypeDef *C, const BootCheckpoint_TypeDef *From)
+{
+	*C = *From;
+
+	for(size_t k=0; k<NUM_FIELDS; k++)
+	{
+		if(Rand() % 2) *Member(C, k) += ((int)(Rand() % 9) - 4) * ldexpf(1.0f, -fields[k].Q);
+	}
+
+	if(Rand() % 20 == 0) C->Motor = !C->Motor;
+}
+
+static void Write(const BootCheckpoint_TypeDef *C)
+{
+	cut = CUT_NONE;
+	App_Boot_Checkpoint(C);
+}
+
+//
+// @简介：写入检查点，在第K次写寄存器之前复位
+//
+static void CutWrite(const BootCheckpoint_TypeDef *C, long K)
+{
+	writes = 0;
+	cut = K;
+
+	if(setjmp(powerCut) == 0)
+	{
+		App_Boot_Checkpoint(C);
+	}
+
+	cut = CUT_NONE;
+}
+
+//
+// @简介：复位，设置复位标志后运行App_Boot_Init
+// @参数：Flags - FLAG(RCC_FLAG_xxx)的组合，复位按键的标志在任何复位时都会置位
+// @参数：Lost - 1表示后备域也复位了（上电复位且没有后备电池）
+//
+static const BootCheckpoint_TypeDef *Reset(uint32_t Flags, int Lost)
+{
+	if(Lost) memset(bkp, 0, sizeof(bkp));
+
+	backupAccess = 0;
+	resetFlags = Flags | FLAG(RCC_FLAG_PINRST);
+
+	App_Boot_Init();
+
+	Check(resetFlags == 0, "reset flags cleared", resetFlags, 0);
+	Check((bkp[BKP_DR1 / 4] & 0xff00) == 0, "checkpoint invalidated", bkp[BKP_DR1 / 4], 0);
+
+	return App_Boot_GetWarm();
+}
+
+static const uint32_t warmFlags[] = {FLAG(RCC_FLAG_IWDGRST), FLAG(RCC_FLAG_WWDGRST), FLAG(RCC_FLAG_SFTRST), 0};
+static const uint8_t warmCauses[] = {BOOT_RESET_WATCHDOG, BOOT_RESET_WATCHDOG, BOOT_RESET_SOFTWARE, BOOT_RESET_PIN};
+
+#define NUM_WARM (sizeof(warmFlags) / sizeof(warmFlags[0]))
+
+//
+// @简介：热启动读到的检查点与写入的完全一致（按Q格式）
+//
+static void Same(const BootCheckpoint_TypeDef *Got, const BootCheckpoint_TypeDef *Want, const char *What)
+{
+	Check(Got != NULL, What, 0, 1);
+
+	if(Got == NULL) return;
+
+	BootCheckpoint_TypeDef want = *Want;
+
+	for(size_t k=0; k<NUM_FIELDS; k++)
+	{
+		float g = *Member((BootCheckpoint_TypeDef *)Got, k), w = Quantize(*Member(&want, k), fields[k].Q);
+
+		if(g != w && failures < 20)
+		{
+			printf("%s: %s = %.9g, expected %.9g (written %.9g)\n", What, fields[k].Name, g, w, *Member(&want, k));
+		}
+
+		Check(g == w, What, k, k);
+	}
+
+	Check(Got->Mode == Want->Mode, What, Got->Mode, Want->Mode);
+	Check(Got->Motor == (Want->Motor != 0), What, Got->Motor, Want->Motor != 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 1. 编码和解码
+//////////////////////////////////////////////////////////////////////////
+
+static void RoundTrip(unsigned long Count)
+{
+	BootCheckpoint_TypeDef c;
+
+	for(unsigned long n=0; n<Count; n++)
+	{
+		uint32_t i = Rand() % NUM_WARM;
+
+		Random(&c);
+		Write(&c);
+
+		Same(Reset(warmFlags[i], 0), &c, "round trip");
+		Check(App_Boot_GetResetCause() == warmCauses[i], "reset cause", App_Boot_GetResetCause(), warmCauses[i]);
+	}
+
+	printf("round trip %lu checkpoints\n", Count);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 2、3. 复位原因，连续复位
+//////////////////////////////////////////////////////////////////////////
+
+static void Causes(unsigned long Count)
+{
+	BootCheckpoint_TypeDef c;
+
+	for(unsigned long n=0; n<Count; n++)
+	{
+		Random(&c);
+
+		// 上电复位，后备寄存器保持（有后备电池）或丢失，此前的任何复位标志都不影响
+		uint32_t others = warmFlags[Rand() % NUM_WARM];
+
+		Write(&c);
+		Check(Reset(FLAG(RCC_FLAG_PORRST) | others, 0) == NULL, "power-on reset is cold", 1, 0);
+		Check(App_Boot_GetResetCause() == BOOT_RESET_POWER, "reset cause", App_Boot_GetResetCause(), BOOT_RESET_POWER);
+
+		Write(&c);
+		Check(Reset(FLAG(RCC_FLAG_PORRST), 1) == NULL, "power-on reset without backup is cold", 1, 0);
+
+		// 后备域复位后没有写入检查点即复位
+		Check(Reset(warmFlags[Rand() % NUM_WARM], 0) == NULL, "empty backup registers are cold", 1, 0);
+
+		// 连续复位：热启动一次后作废，再复位（含初始化期间的看门狗复位）时冷启动
+		Write(&c);
+		Same(Reset(warmFlags[Rand() % NUM_WARM], 0), &c, "first reset");
+		Check(Reset(warmFlags[Rand() % NUM_WARM], 0) == NULL, "second reset is cold", 1, 0);
+		Check(Reset(warmFlags[Rand() % NUM_WARM], 0) == NULL, "third reset is cold", 1, 0);
+
+		// 控制任务重新写入后又可以热启动
+		Random(&c);
+		Write(&c);
+		Same(Reset(warmFlags[Rand() % NUM_WARM], 0), &c, "reset after new checkpoint");
+	}
+
+	printf("causes     %lu sequences\n", Count);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 4. 写入时复位
+//////////////////////////////////////////////////////////////////////////
+
+static void Torn(unsigned long Count)
+{
+	BootCheckpoint_TypeDef a, b;
+	uint16_t regsA[NUM_REGS + 1], regsB[NUM_REGS + 1];
+	unsigned long cuts = 0, warmA = 0, warmB = 0, cold = 0;
+
+	for(unsigned long n=0; n<Count; n++)
+	{
+		Random(&a);
+
+		if(Rand() % 4) Nearby(&b, &a);
+		else Random(&b);
+
+		// 先完整地写一遍，数出写寄存器的次数，记下前后两个检查点的寄存器内容
+		Write(&b);
+		memcpy(regsB, bkp, sizeof(bkp));
+		Write(&a);
+		memcpy(regsA, bkp, sizeof(bkp));
+
+		writes = 0;
+		Write(&b);
+
+		long total = writes;
+
+		for(long k=0; k<=total; k++)
+		{
+			memcpy(bkp, regsA, sizeof(bkp));
+			CutWrite(&b, k);
+			cuts++;
+
+			int isA = !memcmp(bkp, regsA, sizeof(bkp)), isB = !memcmp(bkp, regsB, sizeof(bkp));
+			const BootCheckpoint_TypeDef *got = Reset(warmFlags[Rand() % NUM_WARM], 0);
+
+			if(isA || isB)
+			{
+				Same(got, isB ? &b : &a, "complete checkpoint after reset during write");
+				isB ? warmB++ : warmA++;
+			}
+			else
+			{
+				Check(got == NULL, "torn checkpoint is cold", k, total);
+				cold++;
+			}
+		}
+	}
+
+	printf("torn       %lu cuts: %lu previous, %lu new, %lu cold\n", cuts, warmA, warmB, cold);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 5. 一位错误
+//////////////////////////////////////////////////////////////////////////
+
+static void BitFlip(unsigned long Count)
+{
+	BootCheckpoint_TypeDef c;
+
+	for(unsigned long n=0; n<Count; n++)
+	{
+		Random(&c);
+		Write(&c);
+
+		uint32_t reg = 1 + Rand() % NUM_REGS;
+
+		bkp[reg] ^= 1 << (Rand() % 16);
+
+		Check(Reset(warmFlags[Rand() % NUM_WARM], 0) == NULL, "bit error is cold", reg, 0);
+	}
+
+	printf("bit flip   %lu checkpoints\n", Count);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 1000000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n checkpoints] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Reset(FLAG(RCC_FLAG_PORRST), 1); // 上电
+
+	RoundTrip(n);
+	Causes(n / 10);
+	Torn(n / 10);
+	BitFlip(n);
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
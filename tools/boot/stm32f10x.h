@@ -0,0 +1,71 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   热启动检查用的替身头文件
+  *          在电脑上编译user/app_boot.c时代替std_periph_driver/inc/stm32f10x.h，
+  *          只提供app_boot.c用到的类型、常数和函数，常数的取值与标准库一致。
+  *          后备寄存器、复位标志和看门狗由boot_check.c实现
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+
+#define __STATIC_INLINE static inline
+
+//
+// RCC
+//
+#define RCC_APB1Periph_BKP ((uint32_t)0x08000000)
+#define RCC_APB1Periph_PWR ((uint32_t)0x10000000)
+
+#define RCC_FLAG_PINRST  ((uint8_t)0x7A)
+#define RCC_FLAG_PORRST  ((uint8_t)0x7B)
+#define RCC_FLAG_SFTRST  ((uint8_t)0x7C)
+#define RCC_FLAG_IWDGRST ((uint8_t)0x7D)
+#define RCC_FLAG_WWDGRST ((uint8_t)0x7E)
+#define RCC_FLAG_LPWRRST ((uint8_t)0x7F)
+
+      void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState);
+FlagStatus RCC_GetFlagStatus(uint8_t RCC_FLAG);
+      void RCC_ClearFlag(void);
+
+//
+// PWR、BKP
+//
+#define BKP_DR1  ((uint16_t)0x0004)
+#define BKP_DR2  ((uint16_t)0x0008)
+#define BKP_DR3  ((uint16_t)0x000C)
+#define BKP_DR4  ((uint16_t)0x0010)
+#define BKP_DR5  ((uint16_t)0x0014)
+#define BKP_DR6  ((uint16_t)0x0018)
+#define BKP_DR7  ((uint16_t)0x001C)
+#define BKP_DR8  ((uint16_t)0x0020)
+#define BKP_DR9  ((uint16_t)0x0024)
+#define BKP_DR10 ((uint16_t)0x0028)
+
+    void PWR_BackupAccessCmd(FunctionalState NewState);
+    void BKP_WriteBackupRegister(uint16_t BKP_DR, uint16_t Data);
+uint16_t BKP_ReadBackupRegister(uint16_t BKP_DR);
+
+//
+// IWDG、DBGMCU
+//
+#define IWDG_WriteAccess_Enable ((uint16_t)0x5555)
+#define IWDG_Prescaler_32       ((uint8_t)0x03)
+#define DBGMCU_IWDG_STOP        ((uint32_t)0x00000100)
+
+void IWDG_WriteAccessCmd(uint16_t IWDG_WriteAccess);
+void IWDG_SetPrescaler(uint8_t IWDG_Prescaler);
+void IWDG_SetReload(uint16_t Reload);
+void IWDG_ReloadCounter(void);
+void IWDG_Enable(void);
+void DBGMCU_Config(uint32_t DBGMCU_Periph, FunctionalState NewState);
+
+#endif
@@ -0,0 +1,807 @@
+/**
+  ******************************************************************************
+  * @file    cali_check.c
+  * @version V 1.0.0
+  * @brief   my_lib/stats.c和user/app_calibrator.c的停止条件的检查
+  *          1. stats.c：随机的样本（均值远大于波动的也有），与双精度的两遍算法比较均值、方差和标准误差，
+  *             以及样本不足2个时的返回值
+  *          2. app_calibrator.c：按1ms的节拍运行校准任务，编码器和MPU6050的数据由本文件按场景合成。
+  *             噪声为均匀分布的准随机序列（有界，开头几个样本就分布均匀），正常的样本不会因为偶然的大偏差
+  *             或开头的标准差偏小被剔除，剔除的数量因此是确定的：
+  *             - 安静：提前结束的时刻与双精度下第一次满足容差的样本数一致，不剔除，保存的标准差与样本一致
+  *             - 干扰：编码器缺边沿的段和跳变的段、IMU的尖峰，剔除的数量等于注入的数量，标准差不受影响
+  *             - 碰动：IMU采集中途小车被碰动并停在新的倾角上，统计从头开始，结果只含碰动之后的点
+  *             - 到达上限：标准误差在容差的1~CALI_CAP_FACTOR倍之间时在上限处采用，超过时失败，
+  *               失败时之前的校准结果和保存的记录不变
+  *          直接包含app_calibrator.c，以便读取它的步骤和中间结果
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o cali_check -Itools/cali -Iuser -Imy_lib tools/cali/cali_check.c my_lib/stats.c -lm
+  *
+  *          使用：./cali_check [-n 每个场景的次数] [-s 种子] [-v]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#define Check Calibrator_Check // app_calibrator.c中有同名的静态函数
+#include "app_calibrator.c"
+#undef Check
+
+#define MAX_WINDOWS (CALI_ENCODER_MS / CALI_ENCODER_WINDOW_MS + 1)
+#define MAX_POINTS  (CALI_IMU_MS / CALI_PERIOD_MS + 1)
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+static int verbose = 0;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void Check(int Ok, const char *What, double A, double B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %.6g, expected %.6g\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+static double Uniform(double Min, double Max)
+{
+	return Min + (Max - Min) * (Rand() / 4294967296.0);
+}
+
+#define CH_DUTY  0 // 噪声的通道：左右占空比
+#define CH_GYRO  2 // x y z轴角速度
+#define CH_PITCH 5 // 倾角
+
+static double phase[6]; // 每个通道的准随机序列的起点，每次校准随机选取
+
+//
+// @简介：标准差为Sd的均匀分布的噪声，有界（±√3·Sd）
+// @参数：Channel - 通道，CH_xxx
+// @参数：K - 样本的序号，序号相邻的样本按黄金分割错开，前几个样本的标准差就接近Sd
+//
+static float Noise(int Channel, uint32_t K, float Sd)
+{
+	double u = phase[Channel] + K * 0.6180339887498949;
+
+	return (2 * (u - floor(u)) - 1) * 1.7320508 * Sd;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 模拟的硬件和其他模块
+//////////////////////////////////////////////////////////////////////////
+
+static uint32_t tick = 0;
+
+uint32_t GetTick(void)
+{
+	return tick;
+}
+
+uint32_t GetUs(void)
+{
+	return tick * 1000;
+}
+
+GPIO_TypeDef *const Emu_GPIOC = NULL;
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState)
+{
+	(void)RCC_APB2Periph;
+	(void)NewState;
+}
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct)
+{
+	(void)GPIOx;
+	(void)GPIO_InitStruct;
+}
+
+void GPIO_WriteBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, BitAction BitVal)
+{
+	(void)GPIOx;
+	(void)GPIO_Pin;
+	(void)BitVal;
+}
+
+void App_Motor_Cmd(FunctionalState NewState)
+{
+	(void)NewState;
+}
+
+void App_Control_Reset(void)
+{
+}
+
+void App_PWM_Cmd(uint8_t State)
+{
+	(void)State;
+}
+
+void App_PWM_Set_L(float Duty)
+{
+	(void)Duty;
+}
+
+void App_PWM_Set_R(float Duty)
+{
+	(void)Duty;
+}
+
+static unsigned restarts = 0; // "cali: motion, restart"的次数
+
+void App_Cmd_Printf(const char *Format, ...)
+{
+	if(strstr(Format, "restart") != NULL) restarts++;
+
+	if(verbose)
+	{
+		va_list args;
+
+		va_start(args, Format);
+		printf("%6u ", tick);
+		vprintf(Format, args);
+		va_end(args);
+	}
+}
+
+//
+// 参数存储，每个键只保留最新的值
+//
+static uint8_t flashData[APP_FLASH_MAX_KEYS][APP_FLASH_MAX_SIZE];
+static int flashLen[APP_FLASH_MAX_KEYS];
+static unsigned flashWrites = 0;
+
+int App_Flash_Read(uint8_t Key, void *pData, uint16_t Size)
+{
+	if(Key >= APP_FLASH_MAX_KEYS || flashLen[Key] <= 0) return -1;
+
+	memcpy(pData, flashData[Key], flashLen[Key] < Size ? flashLen[Key] : Size);
+
+	return flashLen[Key];
+}
+
+int App_Flash_Write(uint8_t Key, const void *pData, uint16_t Size)
+{
+	if(Key >= APP_FLASH_MAX_KEYS || Size > APP_FLASH_MAX_SIZE) return -1;
+
+	memcpy(flashData[Key], pData, Size);
+	flashLen[Key] = Size;
+	flashWrites++;
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 合成的数据
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	// 编码器，每段的占空比
+	float duty[2];
+	float dutySd;
+	uint16_t missEvery; // 每隔几段有一段边沿不足，0表示没有
+	uint16_t jumpEvery; // 每隔几段（第8段之后）有一段左侧占空比跳变0.1，0表示没有
+
+	// MPU6050，未经校准的角速度（度/s）和倾角（度）
+	float gyro[3];
+	float gyroSd[3];
+	float pitch;
+	float pitchSd;
+	uint16_t spikeEvery; // 每隔几个点（第10个点之后）有一个y轴角速度的尖峰，0表示没有
+	uint16_t bumpAt;     // 第几个点开始被碰动，0表示没有：持续bumpLen个点，x轴角速度增加15度/s，
+	uint16_t bumpLen;    // 倾角线性地变化bumpPitch，此后停在新的倾角上
+	float bumpPitch;
+} Scenario_t;
+
+static const Scenario_t *scenario;
+
+static uint16_t windows, points; // 已经取走的段数和点数
+static unsigned injectedEncoder, injectedImu; // 注入的干扰的数量
+static float encoderData[MAX_WINDOWS][2]; // 每段的占空比，边沿不足的段不记
+static float imuData[MAX_POINTS][4]; // 每个点的gx gy gz pitch
+static float imu[4]; // 当前的点
+
+void App_Encoder_StartCalibration(void)
+{
+	windows = 0;
+}
+
+int App_Encoder_EndCalibration(float *duty_l, float *duty_r)
+{
+	*duty_l = scenario->duty[0];
+	*duty_r = scenario->duty[1];
+
+	return 0;
+}
+
+int App_Encoder_SampleCalibration(float *duty_l, float *duty_r)
+{
+	uint16_t k = ++windows;
+
+	encoderData[k - 1][0] = NAN;
+
+	if(scenario->missEvery && k % scenario->missEvery == 0)
+	{
+		injectedEncoder++;
+		return 1;
+	}
+
+	*duty_l = scenario->duty[0] + Noise(CH_DUTY, k, scenario->dutySd);
+	*duty_r = scenario->duty[1] + Noise(CH_DUTY + 1, k, scenario->dutySd);
+
+	if(scenario->jumpEvery && k > 8 && k % scenario->jumpEvery == 0)
+	{
+		*duty_l += 0.1f;
+		injectedEncoder++;
+	}
+
+	encoderData[k - 1][0] = *duty_l;
+	encoderData[k - 1][1] = *duty_r;
+
+	return 0;
+}
+
+void App_Encoder_UpdateCalibration(void)
+{
+}
+
+//
+// @简介：合成下一个点。SampleMPU6050先读x轴角速度，在这里前进一个点
+//
+static void NextPoint(void)
+{
+	uint16_t k = ++points;
+
+	for(int i=0; i<3; i++) imu[i] = scenario->gyro[i] + Noise(CH_GYRO + i, k, scenario->gyroSd[i]);
+
+	imu[3] = scenario->pitch + Noise(CH_PITCH, k, scenario->pitchSd);
+
+	if(scenario->spikeEvery && k > 10 && k % scenario->spikeEvery == 0)
+	{
+		imu[1] += 30;
+		injectedImu++;
+	}
+
+	if(scenario->bumpAt && k >= scenario->bumpAt)
+	{
+		uint16_t j = k - scenario->bumpAt;
+
+		if(j < scenario->bumpLen)
+		{
+			imu[0] += 15;
+			imu[3] += scenario->bumpPitch * j / scenario->bumpLen;
+		}
+		else
+		{
+			imu[3] += scenario->bumpPitch;
+		}
+	}
+
+	if(k <= MAX_POINTS) memcpy(imuData[k - 1], imu, sizeof(imu));
+}
+
+// 与app_mpu6050.c相同，角速度已扣除零偏，倾角已加上安装偏差（平放时约为180度）
+float App_MPU6050_GetGyroX(void)
+{
+	NextPoint();
+
+	return imu[0] - caliResult.mpu6050_gx_bias;
+}
+
+float App_MPU6050_GetGyroY(void)
+{
+	return imu[1] - caliResult.mpu6050_gy_bias;
+}
+
+float App_MPU6050_GetGyroZ(void)
+{
+	return imu[2] - caliResult.mpu6050_gz_bias;
+}
+
+float App_MPU6050_GetPitch(void)
+{
+	return 180 + imu[3] + caliResult.mpu6050_pitch_bias;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 运行一次校准
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	int encoder, imu; // 1 - 完成，-1 - 失败，0 - 没有进行
+	uint32_t encoderMs, imuMs; // 测量结束时经过的时间
+} Result_t;
+
+static void Run(const Scenario_t *pScenario, Result_t *pResult)
+{
+	scenario = pScenario;
+	points = 0;
+	windows = 0;
+	injectedEncoder = 0;
+	injectedImu = 0;
+	restarts = 0;
+	flashWrites = 0;
+
+	for(int i=0; i<6; i++) phase[i] = Uniform(0, 1);
+
+	memset(pResult, 0, sizeof(*pResult));
+
+	App_Calibrator_Start();
+
+	uint8_t last = state;
+	uint32_t encoderStart = 0, imuStart = 0;
+	uint32_t deadline = tick + 60000;
+
+	while(state != CALI_STATE_IDLE && tick != deadline)
+	{
+		tick++;
+		App_Calibrator_Proc();
+
+		if(state == last) continue;
+
+		if(last == CALI_STATE_ENCODER)
+		{
+			pResult->encoder = (state == CALI_STATE_SETTLE) ? 1 : -1;
+			pResult->encoderMs = tick - encoderStart;
+		}
+		else if(last == CALI_STATE_IMU)
+		{
+			pResult->imu = (state == CALI_STATE_DONE) ? 1 : -1;
+			pResult->imuMs = tick - imuStart;
+		}
+
+		if(state == CALI_STATE_ENCODER) encoderStart = tick;
+		if(state == CALI_STATE_IMU) imuStart = tick;
+
+		last = state;
+	}
+
+	Check(state == CALI_STATE_IDLE, "calibration finished", state, CALI_STATE_IDLE);
+}
+
+//
+// @简介：双精度下的均值和标准差
+//
+static void Reference(const float *pData, int Stride, int N, double *pMean, double *pSd)
+{
+	double sum = 0, sum2 = 0;
+
+	for(int i=0; i<N; i++) sum += pData[i * Stride];
+
+	double mean = sum / N;
+
+	for(int i=0; i<N; i++) sum2 += (pData[i * Stride] - mean) * (pData[i * Stride] - mean);
+
+	*pMean = mean;
+	*pSd = (N > 1) ? sqrt(sum2 / (N - 1)) : 0;
+}
+
+//
+// @简介：双精度下第一次满足容差的样本数，样本按列存放，Tol为每列的容差
+// @返回值：样本数，到N仍不满足时返回N+1
+//
+static int FirstConverged(const float *pData, int Columns, int N, int MinN, const float *pTol)
+{
+	for(int n=MinN; n<=N; n++)
+	{
+		int ok = 1;
+
+		for(int c=0; c<Columns && ok; c++)
+		{
+			double mean, sd;
+
+			Reference(pData + c, Columns, n, &mean, &sd);
+
+			ok = sd / sqrt(n) <= pTol[c];
+		}
+
+		if(ok) return n;
+	}
+
+	return N + 1;
+}
+
+static void CheckClose(const char *What, double A, double B, double Tol)
+{
+	Check(fabs(A - B) <= Tol, What, A, B);
+}
+
+//
+// @简介：保存的记录与caliResult、caliNoise一致
+//
+static void CheckSaved(void)
+{
+	EncoderCali_TypeDef encoder;
+	IMUCali_TypeDef imu;
+
+	Check(App_Flash_Read(APP_FLASH_KEY_ENCODER, &encoder, sizeof(encoder)) == sizeof(encoder), "encoder record", flashLen[APP_FLASH_KEY_ENCODER], sizeof(encoder));
+	Check(App_Flash_Read(APP_FLASH_KEY_IMU, &imu, sizeof(imu)) == sizeof(imu), "imu record", flashLen[APP_FLASH_KEY_IMU], sizeof(imu));
+
+	Check(encoder.duty_l == caliResult.encoder_duty_l && encoder.duty_r == caliResult.encoder_duty_r, "saved duty", encoder.duty_l, caliResult.encoder_duty_l);
+	Check(encoder.duty_l_sd == caliNoise.encoder_duty_l_sd && encoder.duty_r_sd == caliNoise.encoder_duty_r_sd, "saved duty sd", encoder.duty_l_sd, caliNoise.encoder_duty_l_sd);
+	Check(encoder.samples == caliNoise.encoder_samples && encoder.rejected == caliNoise.encoder_rejected, "saved encoder counts", encoder.rejected, caliNoise.encoder_rejected);
+	Check(imu.gx_bias == caliResult.mpu6050_gx_bias && imu.pitch_bias == caliResult.mpu6050_pitch_bias, "saved bias", imu.gx_bias, caliResult.mpu6050_gx_bias);
+	Check(imu.gx_sd == caliNoise.mpu6050_gx_sd && imu.gy_sd == caliNoise.mpu6050_gy_sd &&
+	      imu.gz_sd == caliNoise.mpu6050_gz_sd && imu.pitch_sd == caliNoise.mpu6050_pitch_sd, "saved imu sd", imu.gx_sd, caliNoise.mpu6050_gx_sd);
+	Check(imu.samples == caliNoise.mpu6050_samples && imu.rejected == caliNoise.mpu6050_rejected, "saved imu counts", imu.rejected, caliNoise.mpu6050_rejected);
+}
+
+//
+// @简介：保存的标准差与采用的样本一致（Data中依次为采用的样本），并接近合成时的标准差
+//
+static void CheckNoise(const char *What, float Sd, const float *pData, int Stride, int N, float TrueMean, float TrueSd, float Mean)
+{
+	double mean, sd;
+	char what[64];
+
+	Reference(pData, Stride, N, &mean, &sd);
+
+	snprintf(what, sizeof(what), "%s sd vs samples", What);
+	CheckClose(what, Sd, sd, 1e-3 * sd + 1e-6);
+
+	snprintf(what, sizeof(what), "%s mean vs samples", What);
+	CheckClose(what, Mean, mean, 1e-4 * (fabs(mean) + sd) + 2e-5); // 倾角经过±180度的换算，单精度的分辨率约为1.5e-5度
+
+	snprintf(what, sizeof(what), "%s sd vs truth", What);
+	CheckClose(what, Sd, TrueSd, 2.5 * TrueSd / sqrt(N)); // 样本标准差的相对误差约为0.45/√N（均匀分布）
+
+	snprintf(what, sizeof(what), "%s mean vs truth", What);
+	CheckClose(what, Mean, TrueMean, 5 * TrueSd / sqrt(N));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 场景
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：安静，两项都提前结束，结束的时刻与双精度下第一次满足容差一致
+//
+static void Quiet(void)
+{
+	Scenario_t s = {0};
+	Result_t r;
+
+	s.duty[0] = Uniform(0.45, 0.55);
+	s.duty[1] = Uniform(0.45, 0.55);
+	s.dutySd = Uniform(0.002, 0.006);
+
+	for(int i=0; i<3; i++)
+	{
+		s.gyro[i] = Uniform(-3, 3);
+		s.gyroSd[i] = Uniform(0.03, 0.15);
+	}
+
+	s.pitch = Uniform(-5, 5);
+	s.pitchSd = Uniform(0.02, 0.1);
+
+	Run(&s, &r);
+
+	Check(r.encoder == 1 && r.imu == 1, "quiet: done", r.encoder * 10 + r.imu, 11);
+	Check(caliNoise.encoder_rejected == 0, "quiet: encoder rejected", caliNoise.encoder_rejected, 0);
+	Check(caliNoise.mpu6050_rejected == 0, "quiet: imu rejected", caliNoise.mpu6050_rejected, 0);
+	Check(restarts == 0, "quiet: restarts", restarts, 0);
+
+	// 结束的时刻
+	const float encoderTol[2] = {CALI_ENCODER_TOL, CALI_ENCODER_TOL};
+	const float imuTol[4] = {CALI_GYRO_TOL, CALI_GYRO_TOL, CALI_GYRO_TOL, CALI_PITCH_TOL};
+
+	int n = caliNoise.encoder_samples;
+	int expected = FirstConverged(&encoderData[0][0], 2, windows, CALI_ENCODER_MIN_SAMPLES, encoderTol);
+
+	Check(abs(n - expected) <= 1, "quiet: encoder samples at stop", n, expected); // 恰在容差上时单精度与双精度可能差一个
+	Check(r.encoderMs == windows * CALI_ENCODER_WINDOW_MS, "quiet: encoder stop time", r.encoderMs, windows * CALI_ENCODER_WINDOW_MS);
+
+	n = caliNoise.mpu6050_samples;
+	expected = FirstConverged(&imuData[0][0], 4, points, CALI_IMU_MIN_SAMPLES, imuTol);
+
+	Check(abs(n - expected) <= 1, "quiet: imu samples at stop", n, expected);
+	Check(n == points, "quiet: imu samples", n, points);
+	Check(r.imuMs == points * CALI_PERIOD_MS, "quiet: imu stop time", r.imuMs, points * CALI_PERIOD_MS);
+
+	// 保存的结果
+	CheckNoise("quiet: duty_l", caliNoise.encoder_duty_l_sd, &encoderData[0][0], 2, windows, s.duty[0], s.dutySd, caliResult.encoder_duty_l);
+	CheckNoise("quiet: duty_r", caliNoise.encoder_duty_r_sd, &encoderData[0][1], 2, windows, s.duty[1], s.dutySd, caliResult.encoder_duty_r);
+	CheckNoise("quiet: gx", caliNoise.mpu6050_gx_sd, &imuData[0][0], 4, points, s.gyro[0], s.gyroSd[0], caliResult.mpu6050_gx_bias);
+	CheckNoise("quiet: gy", caliNoise.mpu6050_gy_sd, &imuData[0][1], 4, points, s.gyro[1], s.gyroSd[1], caliResult.mpu6050_gy_bias);
+	CheckNoise("quiet: gz", caliNoise.mpu6050_gz_sd, &imuData[0][2], 4, points, s.gyro[2], s.gyroSd[2], caliResult.mpu6050_gz_bias);
+	CheckNoise("quiet: pitch", caliNoise.mpu6050_pitch_sd, &imuData[0][3], 4, points, s.pitch, s.pitchSd, caliResult.mpu6050_pitch_bias);
+	CheckSaved();
+}
+
+//
+// @简介：编码器缺边沿和跳变的段、IMU的尖峰，剔除的数量等于注入的数量，标准差不受影响
+//
+static void Outliers(void)
+{
+	Scenario_t s = {0};
+	Result_t r;
+
+	s.duty[0] = Uniform(0.45, 0.55);
+	s.duty[1] = Uniform(0.45, 0.55);
+	s.dutySd = Uniform(0.0001, 0.0003); // 很一致，CALI_ENCODER_MIN_SAMPLES段即可
+	s.missEvery = 3 + Rand() % 3;
+	s.jumpEvery = 7;
+
+	for(int i=0; i<3; i++)
+	{
+		s.gyro[i] = Uniform(-3, 3);
+		s.gyroSd[i] = Uniform(0.01, 0.03); // CALI_IMU_MIN_SAMPLES个点即可
+	}
+
+	s.pitch = Uniform(-5, 5);
+	s.pitchSd = Uniform(0.005, 0.02);
+	s.spikeEvery = 20 + Rand() % 20;
+
+	Run(&s, &r);
+
+	Check(r.encoder == 1 && r.imu == 1, "outliers: done", r.encoder * 10 + r.imu, 11);
+	Check(injectedEncoder > 0 && injectedImu > 0, "outliers: injected", injectedEncoder, injectedImu);
+
+	Check(caliNoise.encoder_samples == CALI_ENCODER_MIN_SAMPLES, "outliers: encoder samples", caliNoise.encoder_samples, CALI_ENCODER_MIN_SAMPLES);
+	Check(caliNoise.encoder_rejected == injectedEncoder, "outliers: encoder rejected", caliNoise.encoder_rejected, injectedEncoder);
+	Check(r.encoderMs == (CALI_ENCODER_MIN_SAMPLES + injectedEncoder) * CALI_ENCODER_WINDOW_MS, "outliers: encoder stop time",
+	      r.encoderMs, (CALI_ENCODER_MIN_SAMPLES + injectedEncoder) * CALI_ENCODER_WINDOW_MS);
+
+	Check(caliNoise.mpu6050_samples == CALI_IMU_MIN_SAMPLES, "outliers: imu samples", caliNoise.mpu6050_samples, CALI_IMU_MIN_SAMPLES);
+	Check(caliNoise.mpu6050_rejected == injectedImu, "outliers: imu rejected", caliNoise.mpu6050_rejected, injectedImu);
+	Check(r.imuMs == (CALI_IMU_MIN_SAMPLES + injectedImu) * CALI_PERIOD_MS, "outliers: imu stop time",
+	      r.imuMs, (CALI_IMU_MIN_SAMPLES + injectedImu) * CALI_PERIOD_MS);
+	Check(restarts == 0, "outliers: restarts", restarts, 0);
+
+	// 去掉注入的样本后与合成时一致
+	static float accepted[MAX_POINTS][4];
+	int n = 0;
+
+	for(int i=0; i<windows; i++)
+	{
+		if(!isnan(encoderData[i][0]) && !(i + 1 > 8 && (i + 1) % s.jumpEvery == 0))
+		{
+			memcpy(accepted[n++], encoderData[i], sizeof(encoderData[i]));
+		}
+	}
+
+	CheckNoise("outliers: duty_l", caliNoise.encoder_duty_l_sd, &accepted[0][0], 4, n, s.duty[0], s.dutySd, caliResult.encoder_duty_l);
+
+	n = 0;
+
+	for(int i=0; i<points; i++)
+	{
+		if(!(i + 1 > 10 && (i + 1) % s.spikeEvery == 0)) memcpy(accepted[n++], imuData[i], sizeof(imuData[i]));
+	}
+
+	CheckNoise("outliers: gy", caliNoise.mpu6050_gy_sd, &accepted[0][1], 4, n, s.gyro[1], s.gyroSd[1], caliResult.mpu6050_gy_bias);
+	CheckNoise("outliers: pitch", caliNoise.mpu6050_pitch_sd, &accepted[0][3], 4, n, s.pitch, s.pitchSd, caliResult.mpu6050_pitch_bias);
+	CheckSaved();
+}
+
+//
+// @简介：IMU采集中途小车被碰动，停在新的倾角上，统计从头开始，结果只含碰动之后的点
+//
+static void Bump(void)
+{
+	Scenario_t s = {0};
+	Result_t r;
+
+	s.duty[0] = 0.5;
+	s.duty[1] = 0.5;
+	s.dutySd = 0.0002;
+
+	for(int i=0; i<3; i++)
+	{
+		s.gyro[i] = Uniform(-3, 3);
+		s.gyroSd[i] = Uniform(0.01, 0.03);
+	}
+
+	s.pitch = Uniform(-5, 5);
+	s.pitchSd = Uniform(0.005, 0.02);
+	s.bumpAt = 50 + Rand() % 100;
+	s.bumpLen = 20 + Rand() % 60;
+	s.bumpPitch = Uniform(1, 4) * (Rand() % 2 ? 1 : -1);
+
+	Run(&s, &r);
+
+	uint16_t settled = s.bumpAt + s.bumpLen; // 停在新的倾角上的第一个点
+
+	Check(r.imu == 1, "bump: done", r.imu, 1);
+	Check(restarts >= 1, "bump: restarts", restarts, 1);
+	Check(caliNoise.mpu6050_rejected >= CALI_MOTION_SAMPLES, "bump: imu rejected", caliNoise.mpu6050_rejected, CALI_MOTION_SAMPLES);
+	Check(caliNoise.mpu6050_samples >= CALI_IMU_MIN_SAMPLES && caliNoise.mpu6050_samples <= points - settled + 1, "bump: imu samples",
+	      caliNoise.mpu6050_samples, points - settled + 1);
+	Check(r.imuMs == points * CALI_PERIOD_MS, "bump: imu stop time", r.imuMs, points * CALI_PERIOD_MS);
+
+	// 采用的是最后mpu6050_samples个点，全部在碰动之后
+	int n = caliNoise.mpu6050_samples;
+	int first = points - n;
+
+	CheckNoise("bump: gx", caliNoise.mpu6050_gx_sd, &imuData[first][0], 4, n, s.gyro[0], s.gyroSd[0], caliResult.mpu6050_gx_bias);
+	CheckNoise("bump: pitch", caliNoise.mpu6050_pitch_sd, &imuData[first][3], 4, n, s.pitch + s.bumpPitch, s.pitchSd, caliResult.mpu6050_pitch_bias);
+	CheckSaved();
+}
+
+//
+// @简介：标准误差在容差的1~CALI_CAP_FACTOR倍之间，到达上限时采用
+//
+static void CapAccepted(void)
+{
+	Scenario_t s = {0};
+	Result_t r;
+
+	s.duty[0] = Uniform(0.45, 0.55);
+	s.duty[1] = Uniform(0.45, 0.55);
+	s.dutySd = Uniform(0.015, 0.02); // 上限处的标准误差约为容差的1.5~2倍
+
+	for(int i=0; i<3; i++)
+	{
+		s.gyro[i] = Uniform(-3, 3);
+		s.gyroSd[i] = Uniform(0.3, 0.5); // 上限处约为容差的1.3~2.2倍
+	}
+
+	s.pitch = Uniform(-5, 5);
+	s.pitchSd = Uniform(0.02, 0.1);
+
+	Run(&s, &r);
+
+	Check(r.encoder == 1 && r.imu == 1, "cap: done", r.encoder * 10 + r.imu, 11);
+	Check(r.encoderMs == CALI_ENCODER_MS, "cap: encoder stop time", r.encoderMs, CALI_ENCODER_MS);
+	Check(caliNoise.encoder_samples == CALI_ENCODER_MS / CALI_ENCODER_WINDOW_MS, "cap: encoder samples", caliNoise.encoder_samples, CALI_ENCODER_MS / CALI_ENCODER_WINDOW_MS);
+	Check(r.imuMs == CALI_IMU_MS, "cap: imu stop time", r.imuMs, CALI_IMU_MS);
+	Check(caliNoise.mpu6050_samples == CALI_IMU_MS / CALI_PERIOD_MS, "cap: imu samples", caliNoise.mpu6050_samples, CALI_IMU_MS / CALI_PERIOD_MS);
+	Check(caliNoise.encoder_rejected == 0 && caliNoise.mpu6050_rejected == 0, "cap: rejected", caliNoise.encoder_rejected + caliNoise.mpu6050_rejected, 0);
+
+	CheckNoise("cap: duty_l", caliNoise.encoder_duty_l_sd, &encoderData[0][0], 2, windows, s.duty[0], s.dutySd, caliResult.encoder_duty_l);
+	CheckNoise("cap: gz", caliNoise.mpu6050_gz_sd, &imuData[0][2], 4, points, s.gyro[2], s.gyroSd[2], caliResult.mpu6050_gz_bias);
+	CheckSaved();
+}
+
+//
+// @简介：标准误差超过容差的CALI_CAP_FACTOR倍，到达上限时失败，之前的结果和记录不变
+// @参数：Imu - 0 - 编码器的噪声太大，1 - 陀螺仪的噪声太大
+//
+static void CapFailed(int Imu)
+{
+	Scenario_t s = {0};
+	Result_t r;
+
+	s.duty[0] = 0.5;
+	s.duty[1] = 0.5;
+	s.dutySd = Imu ? 0.0002 : 0.045; // 上限处的标准误差约为容差的4.5倍
+
+	for(int i=0; i<3; i++)
+	{
+		s.gyro[i] = Uniform(-3, 3);
+		s.gyroSd[i] = 0.02;
+	}
+
+	if(Imu) s.gyroSd[2] = 1.5; // 上限处约为容差的6.7倍
+
+	s.pitch = Uniform(-5, 5);
+	s.pitchSd = 0.01;
+
+	CaliResult_TypeDef result = caliResult;
+	CaliNoise_TypeDef noise = caliNoise;
+
+	Run(&s, &r);
+
+	if(Imu)
+	{
+		Check(r.encoder == 1 && r.imu == -1, "cap failed: imu failed", r.encoder * 10 + r.imu, 10 - 1);
+		Check(r.imuMs == CALI_IMU_MS, "cap failed: imu stop time", r.imuMs, CALI_IMU_MS);
+	}
+	else
+	{
+		Check(r.encoder == -1 && r.imu == 0, "cap failed: encoder failed", r.encoder * 10 + r.imu, -10);
+		Check(r.encoderMs == CALI_ENCODER_MS, "cap failed: encoder stop time", r.encoderMs, CALI_ENCODER_MS);
+	}
+
+	Check(memcmp(&result, &caliResult, sizeof(result)) == 0, "cap failed: result unchanged", 0, 1);
+	Check(memcmp(&noise, &caliNoise, sizeof(noise)) == 0, "cap failed: noise unchanged", 0, 1);
+	Check(flashWrites == 0, "cap failed: nothing saved", flashWrites, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// stats.c
+//////////////////////////////////////////////////////////////////////////
+
+static void StatsCheck(unsigned long N)
+{
+	static float data[1000];
+
+	for(unsigned long i=0; i<N; i++)
+	{
+		int n = 2 + Rand() % 999;
+		double offset = Uniform(-1000, 1000) * (Rand() % 2);
+		double sd = pow(10, Uniform(-3, 1));
+		Stats_TypeDef stats;
+
+		Stats_Init(&stats);
+
+		for(int j=0; j<n; j++)
+		{
+			data[j] = offset + Uniform(-1.7320508, 1.7320508) * sd;
+			Stats_Add(&stats, data[j]);
+		}
+
+		double mean, refSd;
+
+		Reference(data, 1, n, &mean, &refSd);
+
+		Check(stats.N == (uint32_t)n, "stats N", stats.N, n);
+		CheckClose("stats mean", stats.Mean, mean, 1e-5 * (fabs(mean) + refSd));
+		CheckClose("stats sd", Stats_GetStdDev(&stats), refSd, 1e-3 * refSd + 1e-6 * fabs(mean));
+		CheckClose("stats variance", Stats_GetVariance(&stats), refSd * refSd, 2e-3 * refSd * refSd + 1e-6 * fabs(mean) * refSd);
+		CheckClose("stats stderr", Stats_GetStdErr(&stats), refSd / sqrt(n), (1e-3 * refSd + 1e-6 * fabs(mean)) / sqrt(n));
+	}
+
+	// 样本不足2个
+	Stats_TypeDef stats;
+
+	Stats_Init(&stats);
+	Check(Stats_GetVariance(&stats) == 0 && isinf(Stats_GetStdErr(&stats)), "stats empty", Stats_GetVariance(&stats), 0);
+
+	Stats_Add(&stats, 3.5f);
+	Check(stats.Mean == 3.5f && Stats_GetVariance(&stats) == 0 && isinf(Stats_GetStdErr(&stats)), "stats one sample", stats.Mean, 3.5);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 20;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else if(!strcmp(argv[i], "-v")) verbose = 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n runs] [-s seed] [-v]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	StatsCheck(n * 100);
+
+	// 之前保存过的校准结果
+	EncoderCali_TypeDef encoder = {0.49f, 0.51f, 0.003f, 0.003f, 20, 1};
+	IMUCali_TypeDef imu = {1.0f, -1.0f, 0.5f, 1.5f, 0.1f, 0.1f, 0.1f, 0.05f, 400, 2};
+
+	App_Flash_Write(APP_FLASH_KEY_ENCODER, &encoder, sizeof(encoder));
+	App_Flash_Write(APP_FLASH_KEY_IMU, &imu, sizeof(imu));
+	App_Calibrator_Init();
+
+	Check(caliResult.mpu6050_gx_bias == imu.gx_bias && caliNoise.mpu6050_samples == imu.samples, "load", caliResult.mpu6050_gx_bias, imu.gx_bias);
+
+	for(unsigned long i=0; i<n; i++)
+	{
+		Quiet();
+		Outliers();
+		Bump();
+		CapAccepted();
+		CapFailed(0);
+		CapFailed(1);
+	}
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
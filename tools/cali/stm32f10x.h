@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   校准检查用的替身头文件
+  *          在电脑上编译user/app_calibrator.c时代替std_periph_driver/inc/stm32f10x.h，
+  *          只提供app_calibrator.c用到的类型、常数和函数（板载LED），由cali_check.c实现
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+
+#define __STATIC_INLINE static inline
+
+//
+// RCC
+//
+#define RCC_APB2Periph_GPIOC ((uint32_t)0x00000010)
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState);
+
+//
+// GPIO，端口只作为不透明的句柄出现
+//
+typedef struct GPIO_TypeDef GPIO_TypeDef;
+
+extern GPIO_TypeDef *const Emu_GPIOC;
+
+#define GPIOC Emu_GPIOC
+
+#define GPIO_Pin_13 ((uint16_t)0x2000)
+
+typedef enum {GPIO_Speed_10MHz = 1, GPIO_Speed_2MHz, GPIO_Speed_50MHz} GPIOSpeed_TypeDef;
+typedef enum {GPIO_Mode_Out_OD = 0x14, GPIO_Mode_Out_PP = 0x10} GPIOMode_TypeDef;
+typedef enum {Bit_RESET = 0, Bit_SET} BitAction;
+
+typedef struct
+{
+	uint16_t GPIO_Pin;
+	GPIOSpeed_TypeDef GPIO_Speed;
+	GPIOMode_TypeDef GPIO_Mode;
+} GPIO_InitTypeDef;
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+void GPIO_WriteBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, BitAction BitVal);
+
+#endif
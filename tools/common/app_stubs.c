@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file    app_stubs.c
+  * @version V 1.0.0
+  * @brief   电脑上运行的工具（tools/sim、tools/replay、tools/emu、tools/wrap）共用的替身
+  *          遥测、黑匣子、热启动、延迟统计和参数存储模块在这些工具中都不需要，
+  *          由本文件给出空实现：不注册遥测通道，不写黑匣子，总是冷启动，
+  *          不统计延迟，没有保存过的参数（一律使用默认值）。
+  *          控制代码用到这些模块的哪个函数，就在这里补上对应的空实现，
+  *          各工具的编译命令加上tools/common/app_stubs.c
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include "app_telemetry.h"
+#include "app_blackbox.h"
+#include "app_boot.h"
+#include "app_latency.h"
+#include "app_flash.h"
+
+//////////////////////////////////////////////////////////////////////////
+// app_telemetry.h
+//////////////////////////////////////////////////////////////////////////
+
+int8_t App_Telemetry_AddChannel(const char *Name, uint8_t Type, const volatile void *pValue, float Scale)
+{
+	(void)Name; (void)Type; (void)pValue; (void)Scale;
+	return -1;
+}
+
+int8_t App_Telemetry_AddVariable(const char *Name, uint8_t Type, const volatile void *pValue, float Scale)
+{
+	(void)Name; (void)Type; (void)pValue; (void)Scale;
+	return -1;
+}
+
+int8_t App_Telemetry_SetWritable(int8_t Channel, float Min, float Max, void (*OnWrite)(void))
+{
+	(void)Channel; (void)Min; (void)Max; (void)OnWrite;
+	return -1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_blackbox.h
+//////////////////////////////////////////////////////////////////////////
+
+BlackBoxRecord_TypeDef *App_BlackBox_Next(void)
+{
+	return NULL;
+}
+
+void App_BlackBox_Trigger(uint8_t Reason, uint32_t Us)
+{
+	(void)Reason; (void)Us;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_boot.h
+//////////////////////////////////////////////////////////////////////////
+
+const BootCheckpoint_TypeDef *App_Boot_GetWarm(void)
+{
+	return NULL;
+}
+
+void App_Boot_Checkpoint(const BootCheckpoint_TypeDef *pCheckpoint)
+{
+	(void)pCheckpoint;
+}
+
+void App_Boot_Ready(void)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_latency.h
+//////////////////////////////////////////////////////////////////////////
+
+void App_Latency_Add(uint32_t Us)
+{
+	(void)Us;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_flash.h
+//////////////////////////////////////////////////////////////////////////
+
+int App_Flash_Read(uint8_t Key, void *pData, uint16_t Size)
+{
+	(void)Key; (void)pData; (void)Size;
+	return -1;
+}
+
+int App_Flash_Write(uint8_t Key, const void *pData, uint16_t Size)
+{
+	(void)Key; (void)pData; (void)Size;
+	return -1;
+}
@@ -0,0 +1,363 @@
+/**
+  ******************************************************************************
+  * @file    edgecap_check.c
+  * @version V 1.0.0
+  * @brief   my_lib/edgecap.c的检查
+  *          用内存模拟定时器的计数器、两路循环DMA和GPIO的IDR，按硬件的时序产生捕获数据流，
+  *          通过My_EdgeCap_Fetch取出边沿，与产生时记下的时间和电平逐一比较：
+  *          1. EdgeCap_ToUs：捕获值在定时器周期回绕前、计数器在回绕后，以及GetUs()的32位回绕
+  *          2. 随机数据流：缓冲区循环回绕、MaxCount截断后的剩余边沿、电平DMA比时间DMA多写一个位置，
+  *             边沿跨过定时器周期的回绕（边沿距读取始终不超过一个周期），
+  *             定时器周期为65536（由本模块启动）和50000（沿用已启动的定时器），上升沿和下降沿
+  *          3. 溢出：正好绕过一圈、绕过一圈多、绕过两圈时丢弃并计数，BufferSize-1个边沿不算溢出
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -Wno-pointer-to-int-cast -o edgecap_check -Itools/edgecap -Imy_lib tools/edgecap/edgecap_check.c my_lib/edgecap.c
+  *
+  *          使用：./edgecap_check [-n 随机读取次数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "edgecap.h"
+#include "delay.h"
+
+#define N     16   // 缓冲区长度
+#define QUEUE 1024 // 已产生、尚未取出的边沿
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+//
+// 模拟的硬件
+//
+static uint32_t now;   // GetUs()
+static TIM_TypeDef tim;
+static GPIO_TypeDef gpio;
+static DMA_Channel_TypeDef timeDma, levelDma;
+static uint16_t timeBuffer[N], levelBuffer[N];
+static uint16_t timeWrite, levelWrite; // 两路DMA各自的下一个写入位置
+static uint16_t pendingCapture;        // 电平已搬运、时间尚未搬运的边沿的捕获值
+
+static EdgeCap_TypeDef edgecap;
+
+//
+// 产生但尚未取出的边沿
+//
+static uint32_t expTime[QUEUE];
+static uint16_t expLevel[QUEUE];
+static unsigned head, tail;
+
+uint32_t GetUs(void) { return now; }
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct) { (void)GPIOx; (void)GPIO_InitStruct; }
+void RCC_GetClocksFreq(RCC_ClocksTypeDef *RCC_Clocks) { RCC_Clocks->PCLK1_Frequency = 36000000; }
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState) { (void)RCC_AHBPeriph; (void)NewState; }
+void TIM_TimeBaseInit(TIM_TypeDef *TIMx, TIM_TimeBaseInitTypeDef *TIM_TimeBaseInitStruct) { TIMx->ARR = TIM_TimeBaseInitStruct->TIM_Period; }
+void TIM_ICInit(TIM_TypeDef *TIMx, TIM_ICInitTypeDef *TIM_ICInitStruct) { (void)TIMx; (void)TIM_ICInitStruct; }
+void TIM_DMACmd(TIM_TypeDef *TIMx, uint16_t TIM_DMASource, FunctionalState NewState) { (void)TIMx; (void)TIM_DMASource; (void)NewState; }
+void DMA_Init(DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct) { DMAy_Channelx->CNDTR = DMA_InitStruct->DMA_BufferSize; }
+void DMA_Cmd(DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState) { (void)DMAy_Channelx; (void)NewState; }
+
+void TIM_Cmd(TIM_TypeDef *TIMx, FunctionalState NewState)
+{
+	if(NewState) TIMx->CR1 |= TIM_CR1_CEN;
+	else TIMx->CR1 &= ~TIM_CR1_CEN;
+}
+
+static void Check(int Ok, const char *What, unsigned long A, unsigned long B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %lu, expected %lu\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+//
+// @简介：时间前进Us微秒，定时器计数器同步前进
+//
+static void Advance(uint32_t Us)
+{
+	now += Us;
+	tim.CNT = (uint16_t)((tim.CNT + Us) % edgecap.Period);
+}
+
+//
+// @简介：DMA搬运一次，CNDTR从BufferSize递减到1，到0时重装为BufferSize
+//
+static void DmaWrite(DMA_Channel_TypeDef *Dma, uint16_t *pBuffer, uint16_t *pWrite, uint16_t Value)
+{
+	pBuffer[*pWrite] = Value;
+
+	*pWrite = (*pWrite + 1) % N;
+
+	Dma->CNDTR = N - *pWrite;
+}
+
+//
+// @简介：在当前时刻产生一个边沿
+// @参数：LevelOnly - 1表示只完成电平的搬运，时间的搬运留到CompleteTime
+//
+static void Edge(uint8_t LevelOnly)
+{
+	uint16_t level = (uint16_t)Rand();
+
+	if(edgecap.Init.TIM_ICPolarity == TIM_ICPolarity_Falling) level &= ~edgecap.Init.GPIO_Pin;
+	else level |= edgecap.Init.GPIO_Pin;
+
+	gpio.IDR = level;
+
+	DmaWrite(&levelDma, levelBuffer, &levelWrite, level);
+
+	if(LevelOnly) pendingCapture = tim.CNT;
+	else DmaWrite(&timeDma, timeBuffer, &timeWrite, tim.CNT);
+
+	expTime[tail % QUEUE] = now;
+	expLevel[tail % QUEUE] = level;
+	tail++;
+}
+
+static void CompleteTime(void)
+{
+	if(levelWrite != timeWrite)
+	{
+		DmaWrite(&timeDma, timeBuffer, &timeWrite, pendingCapture);
+	}
+}
+
+//
+// @简介：复位模拟的硬件并初始化边沿记录器
+// @参数：Period - 0表示定时器尚未启动，由My_EdgeCap_Init配置；否则为已启动定时器的周期
+//
+static void Setup(uint32_t Period, uint16_t Polarity, uint16_t Pin)
+{
+	memset(&tim, 0, sizeof(tim));
+	memset(&timeDma, 0, sizeof(timeDma));
+	memset(&levelDma, 0, sizeof(levelDma));
+	memset(timeBuffer, 0x55, sizeof(timeBuffer));
+	memset(levelBuffer, 0x55, sizeof(levelBuffer)); // 上电后的内容任意，其中有的位置看起来像新边沿
+	timeWrite = levelWrite = 0;
+	head = tail = 0;
+
+	if(Period)
+	{
+		tim.ARR = Period - 1;
+		tim.CR1 = TIM_CR1_CEN;
+		tim.CNT = Rand() % Period;
+	}
+
+	EdgeCap_InitTypeDef init;
+
+	init.TIMx = &tim;
+	init.TIM_Channel = TIM_Channel_1;
+	init.TIM_ICPolarity = Polarity;
+	init.TimeDMAy_Channelx = &timeDma;
+	init.LevelDMAy_Channelx = &levelDma;
+	init.GPIOx = &gpio;
+	init.GPIO_Pin = Pin;
+	init.pTimeBuffer = timeBuffer;
+	init.pLevelBuffer = levelBuffer;
+	init.BufferSize = N;
+
+	My_EdgeCap_Init(&edgecap, &init);
+
+	Check(edgecap.Period == (Period ? Period : 65536), "Period", edgecap.Period, Period ? Period : 65536);
+}
+
+//
+// @简介：取出边沿并与产生时记下的逐一比较
+// @返回值：取出的数量
+//
+static uint16_t FetchAndCompare(uint16_t MaxCount)
+{
+	uint32_t times[N];
+	uint16_t levels[N];
+
+	uint16_t n = My_EdgeCap_Fetch(&edgecap, times, levels, MaxCount);
+
+	for(uint16_t i=0; i<n; i++)
+	{
+		Check(head != tail, "edge count", n, i);
+
+		if(head == tail) break;
+
+		Check(times[i] == expTime[head % QUEUE], "time", times[i], expTime[head % QUEUE]);
+		Check(levels[i] == expLevel[head % QUEUE], "level", levels[i], expLevel[head % QUEUE]);
+
+		head++;
+	}
+
+	return n;
+}
+
+//
+// @简介：EdgeCap_ToUs的回绕
+//
+static void ToUs(void)
+{
+	Setup(0, TIM_ICPolarity_Rising, GPIO_Pin_0);
+
+	// 捕获在定时器回绕前，读取在回绕后，GetUs()也刚好回绕
+	Check(EdgeCap_ToUs(&edgecap, 65000, 100, 0x10) == 0x10u - 636u, "ToUs 65536", EdgeCap_ToUs(&edgecap, 65000, 100, 0x10), 0x10u - 636u);
+	Check(EdgeCap_ToUs(&edgecap, 100, 100, 0x10) == 0x10, "ToUs same count", EdgeCap_ToUs(&edgecap, 100, 100, 0x10), 0x10);
+	Check(EdgeCap_ToUs(&edgecap, 101, 100, 0x10) == 0x10u - 65535u, "ToUs full period", EdgeCap_ToUs(&edgecap, 101, 100, 0x10), 0x10u - 65535u);
+
+	Setup(50000, TIM_ICPolarity_Rising, GPIO_Pin_0);
+
+	Check(EdgeCap_ToUs(&edgecap, 49990, 5, 1000) == 1000u - 15u, "ToUs 50000", EdgeCap_ToUs(&edgecap, 49990, 5, 1000), 1000u - 15u);
+	Check(EdgeCap_ToUs(&edgecap, 0, 49999, 7) == 7u - 49999u, "ToUs 50000 max", EdgeCap_ToUs(&edgecap, 0, 49999, 7), 7u - 49999u);
+}
+
+//
+// @简介：随机的捕获数据流，两次读取之间最多BufferSize-2个边沿，边沿距读取不超过一个定时器周期
+//
+static void Stream(uint32_t Period, uint16_t Polarity, uint16_t Pin, unsigned long Count)
+{
+	Setup(Period, Polarity, Pin);
+
+	now = 0xffffffffu - Rand() % 200000; // 数据流跨过GetUs()的回绕
+
+	uint32_t maxGap = edgecap.Period / (2 * N); // 一次读取之间新增的时间不超过半个周期
+
+	for(unsigned long k=0; k<Count; k++)
+	{
+		CompleteTime();
+
+		unsigned room = N - 2 - (tail - head);
+		unsigned edges = room ? Rand() % (room + 1) : 0;
+		uint8_t flush = head != tail && now - expTime[head % QUEUE] > edgecap.Period / 2; // 上次截断后剩下的边沿已经太旧
+
+		if(flush) edges = 0;
+
+		for(unsigned i=0; i<edges; i++)
+		{
+			Advance(1 + Rand() % maxGap);
+
+			Edge(i == edges - 1 && Rand() % 4 == 0); // 有时读取发生在两路DMA之间
+		}
+
+		if(!flush) Advance(Rand() % maxGap);
+
+		uint16_t pendingBefore = tail - head - (levelWrite != timeWrite);
+
+		uint16_t maxCount = flush ? N : 1 + Rand() % N;
+		uint16_t n = FetchAndCompare(maxCount);
+
+		Check(n == (pendingBefore < maxCount ? pendingBefore : maxCount), "fetched", n, pendingBefore < maxCount ? pendingBefore : maxCount);
+	}
+
+	Check(edgecap.Overruns == 0, "Overruns", edgecap.Overruns, 0);
+}
+
+//
+// @简介：两次读取之间写入Edges个边沿，期望溢出时取出0个并计数，否则全部取出
+//
+static void Lap(unsigned Edges, uint8_t ExpectOverrun)
+{
+	uint32_t overruns = edgecap.Overruns;
+
+	for(unsigned i=0; i<Edges; i++)
+	{
+		Advance(1 + Rand() % 100);
+		Edge(0);
+	}
+
+	uint16_t n = FetchAndCompare(N);
+
+	if(ExpectOverrun)
+	{
+		Check(n == 0, "overrun fetched", n, 0);
+		Check(edgecap.Overruns == overruns + 1, "Overruns", edgecap.Overruns, overruns + 1);
+
+		head = tail; // 丢弃的边沿
+	}
+	else
+	{
+		Check(n == Edges, "fetched", n, Edges);
+		Check(edgecap.Overruns == overruns, "Overruns", edgecap.Overruns, overruns);
+	}
+}
+
+static void Overrun(uint16_t Polarity, uint16_t Pin)
+{
+	Setup(0, Polarity, Pin);
+
+	now = Rand();
+
+	Lap(0, 0);
+	Lap(3, 0);
+	Lap(N - 1, 0); // 缓冲区只剩一个空位，WriteIdx紧挨在ReadIdx之前
+	Lap(N, 1);     // 正好绕过一圈，WriteIdx==ReadIdx
+	Lap(2, 0);     // 溢出后恢复正常
+	Lap(N + 3, 1);
+	Lap(N - 1, 0);
+	Lap(2 * N, 1);
+	Lap(2 * N + 5, 1);
+	Lap(5, 0);
+
+	// 电平DMA多写一个位置：N-2个完整的边沿加一个半个，不是溢出
+	for(unsigned i=0; i<N-2; i++)
+	{
+		Advance(1 + Rand() % 100);
+		Edge(0);
+	}
+
+	Advance(10);
+	Edge(1);
+
+	Check(FetchAndCompare(N) == N - 2, "skewed fetched", 0, N - 2);
+	Check(edgecap.Overruns == 4, "Overruns", edgecap.Overruns, 4);
+
+	CompleteTime();
+
+	Check(FetchAndCompare(N) == 1, "completed fetched", 0, 1);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 200000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n fetches] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	ToUs();
+
+	Stream(0, TIM_ICPolarity_Rising, GPIO_Pin_0, n);
+	Stream(50000, TIM_ICPolarity_Rising, GPIO_Pin_4, n);
+	Stream(0, TIM_ICPolarity_Falling, GPIO_Pin_1, n);
+	Stream(50000, TIM_ICPolarity_Falling, GPIO_Pin_3, n);
+
+	Overrun(TIM_ICPolarity_Rising, GPIO_Pin_0);
+	Overrun(TIM_ICPolarity_Falling, GPIO_Pin_3);
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   边沿记录器检查用的替身头文件
+  *          在电脑上编译my_lib/edgecap.c时代替std_periph_driver/inc/stm32f10x.h，
+  *          只提供edgecap.c用到的类型、常数和函数，常数的取值与标准库一致。
+  *          定时器的CNT、ARR和DMA的CNDTR、GPIO的IDR是普通的内存，
+  *          由edgecap_check.c按捕获和DMA搬运的时序改写，以模拟捕获数据流
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+
+#define __IO volatile
+#define __STATIC_INLINE static inline
+
+// 检查程序是单线程的，不存在中断抢占
+__STATIC_INLINE void __disable_irq(void) {}
+__STATIC_INLINE void __enable_irq(void) {}
+
+//
+// 外设，只保留edgecap.c访问的寄存器
+//
+typedef struct
+{
+	__IO uint16_t CR1;
+	__IO uint16_t CNT;
+	__IO uint16_t ARR;
+	__IO uint16_t CCR1;
+	__IO uint16_t CCR2;
+	__IO uint16_t CCR3;
+	__IO uint16_t CCR4;
+} TIM_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CCR;
+	__IO uint32_t CNDTR;
+	__IO uint32_t CPAR;
+	__IO uint32_t CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t IDR;
+} GPIO_TypeDef;
+
+#define TIM_CR1_CEN ((uint16_t)0x0001)
+
+//
+// GPIO
+//
+#define GPIO_Pin_0  ((uint16_t)0x0001)
+#define GPIO_Pin_1  ((uint16_t)0x0002)
+#define GPIO_Pin_3  ((uint16_t)0x0008)
+#define GPIO_Pin_4  ((uint16_t)0x0010)
+
+typedef enum
+{
+	GPIO_Mode_IPU = 0x48,
+} GPIOMode_TypeDef;
+
+typedef struct
+{
+	uint16_t GPIO_Pin;
+	uint16_t GPIO_Speed;
+	GPIOMode_TypeDef GPIO_Mode;
+} GPIO_InitTypeDef;
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+
+//
+// RCC
+//
+#define RCC_AHBPeriph_DMA1 ((uint32_t)0x00000001)
+
+typedef struct
+{
+	uint32_t SYSCLK_Frequency;
+	uint32_t HCLK_Frequency;
+	uint32_t PCLK1_Frequency;
+	uint32_t PCLK2_Frequency;
+	uint32_t ADCCLK_Frequency;
+} RCC_ClocksTypeDef;
+
+void RCC_GetClocksFreq(RCC_ClocksTypeDef *RCC_Clocks);
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState);
+
+//
+// TIM
+//
+#define TIM_Channel_1 ((uint16_t)0x0000)
+#define TIM_Channel_2 ((uint16_t)0x0004)
+#define TIM_Channel_3 ((uint16_t)0x0008)
+#define TIM_Channel_4 ((uint16_t)0x000C)
+
+#define TIM_ICPolarity_Rising  ((uint16_t)0x0000)
+#define TIM_ICPolarity_Falling ((uint16_t)0x0002)
+
+#define TIM_ICSelection_DirectTI   ((uint16_t)0x0001)
+#define TIM_ICSelection_IndirectTI ((uint16_t)0x0002)
+
+#define TIM_ICPSC_DIV1 ((uint16_t)0x0000)
+
+#define TIM_CounterMode_Up ((uint16_t)0x0000)
+
+#define TIM_DMA_CC1 ((uint16_t)0x0200)
+
+typedef struct
+{
+	uint16_t TIM_Prescaler;
+	uint16_t TIM_CounterMode;
+	uint16_t TIM_Period;
+	uint16_t TIM_ClockDivision;
+	uint8_t TIM_RepetitionCounter;
+} TIM_TimeBaseInitTypeDef;
+
+typedef struct
+{
+	uint16_t TIM_Channel;
+	uint16_t TIM_ICPolarity;
+	uint16_t TIM_ICSelection;
+	uint16_t TIM_ICPrescaler;
+	uint16_t TIM_ICFilter;
+} TIM_ICInitTypeDef;
+
+void TIM_TimeBaseInit(TIM_TypeDef *TIMx, TIM_TimeBaseInitTypeDef *TIM_TimeBaseInitStruct);
+void TIM_Cmd(TIM_TypeDef *TIMx, FunctionalState NewState);
+void TIM_ICInit(TIM_TypeDef *TIMx, TIM_ICInitTypeDef *TIM_ICInitStruct);
+void TIM_DMACmd(TIM_TypeDef *TIMx, uint16_t TIM_DMASource, FunctionalState NewState);
+
+//
+// DMA
+//
+#define DMA_DIR_PeripheralSRC           ((uint32_t)0x00000000)
+#define DMA_PeripheralInc_Disable       ((uint32_t)0x00000000)
+#define DMA_MemoryInc_Enable            ((uint32_t)0x00000080)
+#define DMA_PeripheralDataSize_HalfWord ((uint32_t)0x00000100)
+#define DMA_MemoryDataSize_HalfWord     ((uint32_t)0x00000400)
+#define DMA_Mode_Circular               ((uint32_t)0x00000020)
+#define DMA_Priority_High               ((uint32_t)0x00002000)
+#define DMA_M2M_Disable                 ((uint32_t)0x00000000)
+
+typedef struct
+{
+	uint32_t DMA_PeripheralBaseAddr;
+	uint32_t DMA_MemoryBaseAddr;
+	uint32_t DMA_DIR;
+	uint32_t DMA_BufferSize;
+	uint32_t DMA_PeripheralInc;
+	uint32_t DMA_MemoryInc;
+	uint32_t DMA_PeripheralDataSize;
+	uint32_t DMA_MemoryDataSize;
+	uint32_t DMA_Mode;
+	uint32_t DMA_Priority;
+	uint32_t DMA_M2M;
+} DMA_InitTypeDef;
+
+void DMA_Init(DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct);
+void DMA_Cmd(DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState);
+
+#endif
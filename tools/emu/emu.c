@@ -0,0 +1,660 @@
+/**
+  ******************************************************************************
+  * @file    emu.c
+  * @version V 1.0.0
+  * @brief   驱动仿真器的内核：时间、GPIO、EXTI、NVIC、delay.h，以及GPIO层面的软件I2C总线
+  ******************************************************************************
+  */
+
+#include "emu.h"
+#include "delay.h"
+#include "si2c.h"
+#include <string.h>
+
+struct Emu_GPIO_TypeDef
+{
+	uint8_t Index;  // 0 - GPIOA，1 - GPIOB，...
+	uint16_t In;    // 外部信号驱动的电平
+	uint16_t Out;   // 输出数据寄存器（ODR）
+};
+
+GPIO_TypeDef Emu_GPIOA = {0, 0, 0}, Emu_GPIOB = {1, 0, 0}, Emu_GPIOC = {2, 0, 0}, Emu_GPIOD = {3, 0, 0};
+
+Emu_TypeDef emu;
+
+//
+// 外部信号源
+//
+typedef struct
+{
+	uint64_t (*Next)(void *Ctx); // 下一个事件的时刻，UINT64_MAX表示没有
+	void (*Fire)(void *Ctx);     // 执行该事件
+	void *Ctx;
+} Source_TypeDef;
+
+static Source_TypeDef sources[EMU_MAX_SOURCES];
+static int numSources;
+
+//
+// 中断
+//
+static uint8_t primask;       // 1 - 中断被__disable_irq屏蔽
+static uint8_t inIsr;         // 1 - 正在执行中断响应函数（所有中断的优先级相同，不嵌套）
+static uint8_t extiPort[16];  // 每条EXTI线连接的端口（GPIO_EXTILineConfig）
+static uint16_t extiImr, extiRising, extiFalling, extiPr;
+static uint8_t nvicEnabled[64];
+
+__weak void EXTI0_IRQHandler(void) {}
+__weak void EXTI1_IRQHandler(void) {}
+__weak void EXTI2_IRQHandler(void) {}
+__weak void EXTI3_IRQHandler(void) {}
+__weak void EXTI4_IRQHandler(void) {}
+__weak void EXTI9_5_IRQHandler(void) {}
+__weak void EXTI15_10_IRQHandler(void) {}
+
+//
+// 外设中断（电平触发），挂起状态由外设的仿真给出
+//
+typedef struct
+{
+	uint8_t Irq;
+	uint8_t (*Pending)(void *Ctx);
+	void (*Handler)(void);
+	void *Ctx;
+} PeriphIrq_TypeDef;
+
+static PeriphIrq_TypeDef periphIrqs[EMU_MAX_PERIPH_IRQS];
+static int numPeriphIrqs;
+
+//
+// 软件I2C总线
+//
+typedef struct
+{
+	GPIO_TypeDef *SCL_GPIOx, *SDA_GPIOx;
+	uint16_t SCL_Pin, SDA_Pin;
+	Emu_I2CSlaveTypeDef *Slave;
+
+	uint8_t Scl, Sda;            // 总线的实际电平（线与）
+	uint8_t SlaveSda;            // 从机对SDA的输出，0表示拉低
+	uint8_t Active;              // 1 - 起始位之后、停止位之前
+	uint8_t Selected;            // 1 - 从机已被寻址且尚未释放
+	uint8_t State;
+	uint8_t Bits, Shift, Read;
+	uint64_t SclEdge, SdaEdge, StartTime;
+} SI2C_BusTypeDef;
+
+enum { BUS_IDLE, BUS_RECV, BUS_ACK_OUT, BUS_SEND, BUS_ACK_IN };
+
+static SI2C_BusTypeDef bus;
+
+static uint8_t BusOwns(GPIO_TypeDef *GPIOx, uint16_t Pin);
+static void BusUpdate(void);
+
+//
+// @简介：复位仿真器，清空时间、引脚、中断配置、信号源和统计
+//
+void Emu_Reset(void)
+{
+	memset(&emu, 0, sizeof(emu));
+
+	emu.CallCycles = 20;
+	emu.LoopCycles = 10;
+	emu.IrqCycles = 24;
+
+	emu.SI2C.MinHigh = emu.SI2C.MinLow = emu.SI2C.MinSetup = UINT32_MAX;
+
+	GPIO_TypeDef *ports[] = {GPIOA, GPIOB, GPIOC, GPIOD};
+
+	for(int i=0; i<4; i++)
+	{
+		ports[i]->In = 0xffff; // 上拉输入
+		ports[i]->Out = 0xffff;
+	}
+
+	numSources = 0;
+	numPeriphIrqs = 0;
+	primask = 0;
+	inIsr = 0;
+	extiImr = extiRising = extiFalling = extiPr = 0;
+	memset(extiPort, 0, sizeof(extiPort));
+	memset(nvicEnabled, 0, sizeof(nvicEnabled));
+	memset(&bus, 0, sizeof(bus));
+}
+
+//
+// @简介：时间前进，期间按时间顺序执行外部信号源的事件
+// @参数：Cycles - 前进的CPU周期数
+// @注意：事件触发的中断响应函数中也会调用本函数，因此时间只增不减
+//
+void Emu_Advance(uint32_t Cycles)
+{
+	uint64_t target = emu.Cycles + Cycles;
+
+	while(1)
+	{
+		int first = -1;
+		uint64_t t = UINT64_MAX;
+
+		for(int i=0; i<numSources; i++)
+		{
+			uint64_t n = sources[i].Next(sources[i].Ctx);
+
+			if(n < t)
+			{
+				t = n;
+				first = i;
+			}
+		}
+
+		if(first < 0 || t > target) break;
+
+		if(t > emu.Cycles) emu.Cycles = t;
+
+		sources[first].Fire(sources[first].Ctx);
+	}
+
+	if(target > emu.Cycles) emu.Cycles = target;
+}
+
+void Emu_AdvanceUs(double Us)
+{
+	Emu_Advance((uint32_t)(Us * (EMU_CPU_HZ / 1000000) + 0.5));
+}
+
+double Emu_Seconds(void)
+{
+	return (double)emu.Cycles / EMU_CPU_HZ;
+}
+
+//
+// @简介：登记一个外部信号源
+// @参数：Next - 返回下一个事件的时刻（CPU周期），UINT64_MAX表示没有
+// @参数：Fire - 执行下一个事件，通常是调用Emu_SetInput改变引脚电平
+//
+void Emu_AddSource(uint64_t (*Next)(void *Ctx), void (*Fire)(void *Ctx), void *Ctx)
+{
+	if(numSources >= EMU_MAX_SOURCES) return;
+
+	sources[numSources].Next = Next;
+	sources[numSources].Fire = Fire;
+	sources[numSources].Ctx = Ctx;
+	numSources++;
+}
+
+//
+// @简介：登记一个外设中断
+// @参数：Irq - 中断编号，NVIC使能后才响应
+// @参数：Pending - 返回1表示外设的中断标志和中断使能同时有效，响应函数须清除标志或关闭中断
+// @参数：Handler - 中断响应函数
+// @注意：外设的状态在CPU之外改变（例如传输结束）时，外设的仿真须调用Emu_Dispatch
+//
+void Emu_AddIrq(uint8_t Irq, uint8_t (*Pending)(void *Ctx), void (*Handler)(void), void *Ctx)
+{
+	if(numPeriphIrqs >= EMU_MAX_PERIPH_IRQS) return;
+
+	periphIrqs[numPeriphIrqs].Irq = Irq;
+	periphIrqs[numPeriphIrqs].Pending = Pending;
+	periphIrqs[numPeriphIrqs].Handler = Handler;
+	periphIrqs[numPeriphIrqs].Ctx = Ctx;
+	numPeriphIrqs++;
+}
+
+//
+// @简介：外部信号改变输入引脚的电平，按EXTI的配置挂起中断
+//
+void Emu_SetInput(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint8_t Level)
+{
+	uint16_t old = GPIOx->In;
+
+	if(Level) GPIOx->In |= GPIO_Pin;
+	else GPIOx->In &= ~GPIO_Pin;
+
+	uint16_t rising = ~old & GPIOx->In;
+	uint16_t falling = old & ~GPIOx->In;
+
+	for(int line=0; line<16; line++)
+	{
+		uint16_t bit = 1 << line;
+
+		if(!(bit & GPIO_Pin) || extiPort[line] != GPIOx->Index || !(extiImr & bit)) continue;
+
+		if(((rising & bit) && (extiRising & bit)) || ((falling & bit) && (extiFalling & bit)))
+		{
+			if(extiPr & bit) emu.LostEdges++;
+
+			extiPr |= bit;
+		}
+	}
+
+	Emu_Dispatch();
+}
+
+//
+// @简介：响应挂起的EXTI中断和外设中断，编号小的先响应
+//
+void Emu_Dispatch(void)
+{
+	static const struct { uint8_t Irq; uint16_t Lines; void (*Handler)(void); } vectors[] = {
+		{EXTI0_IRQn, 0x0001, EXTI0_IRQHandler},
+		{EXTI1_IRQn, 0x0002, EXTI1_IRQHandler},
+		{EXTI2_IRQn, 0x0004, EXTI2_IRQHandler},
+		{EXTI3_IRQn, 0x0008, EXTI3_IRQHandler},
+		{EXTI4_IRQn, 0x0010, EXTI4_IRQHandler},
+		{EXTI9_5_IRQn, 0x03e0, EXTI9_5_IRQHandler},
+		{EXTI15_10_IRQn, 0xfc00, EXTI15_10_IRQHandler},
+	};
+
+	if(primask || inIsr) return;
+
+	for(int guard=0; guard<1000; guard++)
+	{
+		uint8_t irq = 0xff;
+		void (*handler)(void) = NULL;
+
+		for(int i=0; i<7; i++)
+		{
+			if((extiPr & extiImr & vectors[i].Lines) && nvicEnabled[vectors[i].Irq] && vectors[i].Irq < irq)
+			{
+				irq = vectors[i].Irq;
+				handler = vectors[i].Handler;
+			}
+		}
+
+		for(int i=0; i<numPeriphIrqs; i++)
+		{
+			PeriphIrq_TypeDef *p = &periphIrqs[i];
+
+			if(nvicEnabled[p->Irq] && p->Irq < irq && p->Pending(p->Ctx))
+			{
+				irq = p->Irq;
+				handler = p->Handler;
+			}
+		}
+
+		if(handler == NULL) return;
+
+		inIsr = 1;
+
+		uint64_t start = emu.Cycles;
+
+		Emu_Advance(emu.IrqCycles);
+		handler();
+
+		emu.IsrCount++;
+		emu.IsrCycles += emu.Cycles - start;
+
+		inIsr = 0;
+	}
+}
+
+void __disable_irq(void)
+{
+	primask = 1;
+}
+
+void __enable_irq(void)
+{
+	primask = 0;
+	Emu_Dispatch();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// RCC、GPIO、EXTI、NVIC
+//////////////////////////////////////////////////////////////////////////
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState)
+{
+	(void)RCC_APB2Periph; (void)NewState;
+	Emu_Advance(emu.CallCycles);
+}
+
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState)
+{
+	(void)RCC_APB1Periph; (void)NewState;
+	Emu_Advance(emu.CallCycles);
+}
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct)
+{
+	(void)GPIOx; (void)GPIO_InitStruct;
+	Emu_Advance(emu.CallCycles * 4);
+}
+
+void GPIO_WriteBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, BitAction BitVal)
+{
+	Emu_Advance(emu.CallCycles);
+
+	if(BitVal == Bit_SET) GPIOx->Out |= GPIO_Pin;
+	else GPIOx->Out &= ~GPIO_Pin;
+
+	if(BusOwns(GPIOx, GPIO_Pin)) BusUpdate();
+}
+
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	Emu_Advance(emu.CallCycles);
+
+	if(BusOwns(GPIOx, GPIO_Pin))
+	{
+		return (GPIOx == bus.SCL_GPIOx && GPIO_Pin == bus.SCL_Pin) ? bus.Scl : bus.Sda;
+	}
+
+	return (GPIOx->In & GPIO_Pin) ? Bit_SET : Bit_RESET;
+}
+
+void GPIO_EXTILineConfig(uint8_t GPIO_PortSource, uint8_t GPIO_PinSource)
+{
+	Emu_Advance(emu.CallCycles);
+	extiPort[GPIO_PinSource & 0x0f] = GPIO_PortSource;
+}
+
+void GPIO_PinRemapConfig(uint32_t GPIO_Remap, FunctionalState NewState)
+{
+	(void)GPIO_Remap; (void)NewState;
+	Emu_Advance(emu.CallCycles);
+}
+
+void EXTI_Init(EXTI_InitTypeDef *EXTI_InitStruct)
+{
+	Emu_Advance(emu.CallCycles * 2);
+
+	uint16_t lines = EXTI_InitStruct->EXTI_Line;
+
+	extiRising &= ~lines;
+	extiFalling &= ~lines;
+
+	if(EXTI_InitStruct->EXTI_LineCmd != ENABLE || EXTI_InitStruct->EXTI_Mode != EXTI_Mode_Interrupt)
+	{
+		extiImr &= ~lines;
+		return;
+	}
+
+	extiImr |= lines;
+
+	if(EXTI_InitStruct->EXTI_Trigger != EXTI_Trigger_Falling) extiRising |= lines;
+	if(EXTI_InitStruct->EXTI_Trigger != EXTI_Trigger_Rising) extiFalling |= lines;
+}
+
+FlagStatus EXTI_GetFlagStatus(uint32_t EXTI_Line)
+{
+	Emu_Advance(emu.CallCycles);
+	return (extiPr & EXTI_Line) ? SET : RESET;
+}
+
+void EXTI_ClearFlag(uint32_t EXTI_Line)
+{
+	Emu_Advance(emu.CallCycles);
+	extiPr &= ~EXTI_Line;
+}
+
+ITStatus EXTI_GetITStatus(uint32_t EXTI_Line)
+{
+	Emu_Advance(emu.CallCycles);
+	return (extiPr & extiImr & EXTI_Line) ? SET : RESET;
+}
+
+void EXTI_ClearITPendingBit(uint32_t EXTI_Line)
+{
+	EXTI_ClearFlag(EXTI_Line);
+}
+
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct)
+{
+	Emu_Advance(emu.CallCycles * 2);
+	nvicEnabled[NVIC_InitStruct->NVIC_IRQChannel & 63] = NVIC_InitStruct->NVIC_IRQChannelCmd == ENABLE;
+	Emu_Dispatch();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// delay.h
+//////////////////////////////////////////////////////////////////////////
+
+void Delay_Init(void) {}
+
+void Delay(uint32_t ms)
+{
+	Emu_Advance(ms * (EMU_CPU_HZ / 1000));
+}
+
+uint32_t GetTick(void)
+{
+	Emu_Advance(emu.CallCycles);
+	return (uint32_t)(emu.Cycles / (EMU_CPU_HZ / 1000));
+}
+
+uint32_t GetUs(void)
+{
+	Emu_Advance(emu.CallCycles * 4); // 含浮点换算（软件浮点）
+	return (uint32_t)(emu.Cycles / (EMU_CPU_HZ / 1000000));
+}
+
+void DelayUs(uint32_t us)
+{
+	Emu_Advance(us * (EMU_CPU_HZ / 1000000));
+}
+
+//
+// @简介：替换si2c.c中的弱函数，按目标板的空循环耗时推进时间
+//
+void My_SI2C_Delay(uint32_t us)
+{
+	Emu_Advance(8 * us * emu.LoopCycles + emu.CallCycles);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 软件I2C总线（GPIO层面）
+// 主机（si2c.c）通过GPIO_WriteBit驱动SCL和SDA，从机在SCL下降沿改变SDA，
+// 在SCL上升沿采样，总线电平为主从双方输出的线与
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：把从机连接到由两个GPIO组成的软件I2C总线上
+//
+void Emu_SI2C_Attach(GPIO_TypeDef *SCL_GPIOx, uint16_t SCL_Pin, GPIO_TypeDef *SDA_GPIOx, uint16_t SDA_Pin, Emu_I2CSlaveTypeDef *Slave)
+{
+	memset(&bus, 0, sizeof(bus));
+
+	bus.SCL_GPIOx = SCL_GPIOx;
+	bus.SCL_Pin = SCL_Pin;
+	bus.SDA_GPIOx = SDA_GPIOx;
+	bus.SDA_Pin = SDA_Pin;
+	bus.Slave = Slave;
+	bus.SlaveSda = 1;
+	bus.Scl = 1;
+	bus.Sda = 1;
+	bus.State = BUS_IDLE;
+}
+
+static uint8_t BusOwns(GPIO_TypeDef *GPIOx, uint16_t Pin)
+{
+	if(bus.Slave == NULL) return 0;
+
+	return (GPIOx == bus.SCL_GPIOx && Pin == bus.SCL_Pin) || (GPIOx == bus.SDA_GPIOx && Pin == bus.SDA_Pin);
+}
+
+static void Check(uint32_t Duration, uint32_t *pMin, uint32_t Limit)
+{
+	if(Duration < *pMin) *pMin = Duration;
+	if(Duration < Limit) emu.SI2C.Violations++;
+}
+
+//
+// @简介：主机改变了SCL或SDA的输出之后，重新计算总线电平并推进从机的状态机
+//
+static void BusUpdate(void)
+{
+	const uint32_t tLow = EMU_CPU_HZ / 1000000 * 13 / 10; // 快速模式：tLOW >= 1.3us
+	const uint32_t tHigh = EMU_CPU_HZ / 1000000 * 6 / 10; // tHIGH >= 0.6us
+	const uint32_t tSetup = EMU_CPU_HZ / 10000000;        // tSU;DAT >= 100ns
+
+	uint8_t scl = (bus.SCL_GPIOx->Out & bus.SCL_Pin) ? 1 : 0;
+	uint8_t sda = ((bus.SDA_GPIOx->Out & bus.SDA_Pin) ? 1 : 0) & bus.SlaveSda;
+
+	uint64_t now = emu.Cycles;
+
+	if(scl == bus.Scl && sda == bus.Sda) return;
+
+	// SCL为高时SDA变化：起始位或停止位
+	if(scl && bus.Scl && sda != bus.Sda)
+	{
+		bus.Sda = sda;
+		bus.SdaEdge = now;
+
+		if(bus.Selected) bus.Slave->Stop(bus.Slave->Dev);
+		bus.Selected = 0;
+		
+		if(!sda) // 起始位（或重复起始位）
+		{
+			if(!bus.Active) bus.StartTime = now;
+			
+			emu.SI2C.Starts++;
+			bus.Active = 1;
+			bus.State = BUS_RECV;
+			bus.Bits = 0;
+			bus.Shift = 0;
+			bus.Read = 0xff; // 尚未寻址
+			bus.SlaveSda = 1;
+		}
+		else // 停止位
+		{
+			if(bus.Active) emu.SI2C.BusyCycles += now - bus.StartTime;
+			
+			emu.SI2C.Stops++;
+			bus.Active = 0;
+			bus.State = BUS_IDLE;
+			bus.SlaveSda = 1;
+		}
+
+		return;
+	}
+
+	if(sda != bus.Sda)
+	{
+		bus.Sda = sda;
+		bus.SdaEdge = now;
+	}
+
+	if(scl == bus.Scl) return;
+
+	uint32_t duration = (uint32_t)(now - bus.SclEdge);
+	bus.SclEdge = now;
+	bus.Scl = scl;
+
+	if(scl) // 上升沿：采样
+	{
+		if(bus.Active)
+		{
+			Check(duration, &emu.SI2C.MinLow, tLow);
+			Check((uint32_t)(now - bus.SdaEdge), &emu.SI2C.MinSetup, tSetup);
+		}
+
+		if(bus.State == BUS_RECV)
+		{
+			bus.Shift = (bus.Shift << 1) | bus.Sda;
+			bus.Bits++;
+		}
+		else if(bus.State == BUS_SEND)
+		{
+			bus.Bits++;
+		}
+		else if(bus.State == BUS_ACK_IN && bus.Sda) // 主机回NAK，从机不再发送
+		{
+			bus.Bits = 0xff;
+		}
+
+		return;
+	}
+
+	// 下降沿：从机改变SDA
+	if(bus.Active) Check(duration, &emu.SI2C.MinHigh, tHigh);
+
+	uint8_t ack;
+
+	switch(bus.State)
+	{
+	case BUS_RECV:
+		if(bus.Bits < 8) break;
+
+		if(bus.Read == 0xff) // 地址字节
+		{
+			ack = (bus.Shift >> 1) == bus.Slave->Addr && bus.Slave->Start(bus.Slave->Dev, bus.Shift & 1);
+			bus.Read = bus.Shift & 1;
+			bus.Selected = ack;
+		}
+		else
+		{
+			ack = bus.Slave->Write(bus.Slave->Dev, bus.Shift);
+			emu.SI2C.Bytes++;
+		}
+
+		if(ack)
+		{
+			bus.SlaveSda = 0;
+			bus.State = BUS_ACK_OUT;
+		}
+		else
+		{
+			emu.SI2C.Nacks++;
+			bus.State = BUS_IDLE; // 等待停止位
+			if(bus.Selected) bus.Slave->Stop(bus.Slave->Dev);
+			bus.Selected = 0;
+		}
+		break;
+
+	case BUS_ACK_OUT:
+		bus.SlaveSda = 1;
+		bus.Bits = 0;
+		bus.Shift = 0;
+
+		if(bus.Read == 1)
+		{
+			bus.Shift = bus.Slave->Read(bus.Slave->Dev);
+			bus.SlaveSda = (bus.Shift >> 7) & 1;
+			bus.State = BUS_SEND;
+			emu.SI2C.Bytes++;
+		}
+		else
+		{
+			bus.State = BUS_RECV;
+		}
+		break;
+
+	case BUS_SEND:
+		if(bus.Bits < 8)
+		{
+			bus.SlaveSda = (bus.Shift >> (7 - bus.Bits)) & 1;
+		}
+		else
+		{
+			bus.SlaveSda = 1;
+			bus.State = BUS_ACK_IN;
+		}
+		break;
+
+	case BUS_ACK_IN:
+		if(bus.Bits == 0xff) // 主机回了NAK
+		{
+			bus.State = BUS_IDLE;
+			bus.Slave->Stop(bus.Slave->Dev);
+			bus.Selected = 0;
+			break;
+		}
+
+		bus.Bits = 0;
+		bus.Shift = bus.Slave->Read(bus.Slave->Dev);
+		bus.SlaveSda = (bus.Shift >> 7) & 1;
+		bus.State = BUS_SEND;
+		emu.SI2C.Bytes++;
+		break;
+	}
+
+	// 从机改变了SDA，重新计算线与
+	sda = ((bus.SDA_GPIOx->Out & bus.SDA_Pin) ? 1 : 0) & bus.SlaveSda;
+	
+	if(sda != bus.Sda)
+	{
+		bus.Sda = sda;
+		bus.SdaEdge = now;
+	}
+}
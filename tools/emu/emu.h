@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file    emu.h
+  * @version V 1.0.0
+  * @brief   驱动仿真器的内核
+  *          以72MHz的CPU周期为时间单位。驱动每调用一次标准库函数，时间前进固定的周期数，
+  *          因此可以统计驱动的耗时和总线时序。时间前进的过程中，外部信号源（例如编码器）
+  *          按时间顺序改变引脚电平，经EXTI和NVIC触发驱动的中断响应函数，外设（硬件I2C）
+  *          的中断标志同样经NVIC触发；
+  *          __disable_irq期间发生的中断挂起到__enable_irq时再响应，
+  *          挂起期间同一条线上再次发生的边沿会被合并，与硬件一致
+  ******************************************************************************
+  */
+
+#ifndef EMU_H
+#define EMU_H
+
+#include <stdint.h>
+#include "stm32f10x.h"
+
+#define EMU_CPU_HZ 72000000
+#define EMU_MAX_SOURCES 4
+#define EMU_MAX_PERIPH_IRQS 4
+
+//
+// I2C从机的接口，软件I2C总线（GPIO层面）和硬件I2C（传输层面）共用
+//
+typedef struct
+{
+	uint8_t Addr;                              // 7位地址
+	uint8_t (*Start)(void *Dev, uint8_t Read); // 地址匹配后调用，返回1 - ACK
+	uint8_t (*Write)(void *Dev, uint8_t Data); // 主机写入一个字节，返回1 - ACK
+	uint8_t (*Read)(void *Dev);                // 主机读取一个字节
+	void (*Stop)(void *Dev);                   // 停止位或重复起始位
+	void *Dev;
+} Emu_I2CSlaveTypeDef;
+
+//
+// 软件I2C总线的统计，时间单位均为CPU周期
+//
+typedef struct
+{
+	uint32_t Starts, Stops, Bytes, Nacks;
+	uint32_t MinHigh, MinLow;  // SCL高、低电平的最短持续时间
+	uint32_t MinSetup;         // SDA变化到SCL上升沿的最短时间
+	uint32_t Violations;       // 不满足快速模式（400kHz）时序要求的次数
+	uint64_t BusyCycles;       // 起始位到停止位之间的总时间
+} Emu_SI2CStatTypeDef;
+
+typedef struct
+{
+	uint64_t Cycles;      // 当前时间，CPU周期数
+
+	// 耗时模型，单位CPU周期
+	uint32_t CallCycles;  // 调用一次标准库函数
+	uint32_t LoopCycles;  // My_SI2C_Delay中的一次空循环（目标板为-O0编译）
+	uint32_t IrqCycles;   // 中断的进入和退出
+
+	// 中断统计
+	uint32_t IsrCount;    // 中断响应函数的执行次数
+	uint64_t IsrCycles;   // 在中断中度过的时间
+	uint32_t LostEdges;   // 中断挂起期间同一条线上再次发生的边沿
+
+	Emu_SI2CStatTypeDef SI2C;
+} Emu_TypeDef;
+
+extern Emu_TypeDef emu;
+
+     void Emu_Reset(void);
+     void Emu_Advance(uint32_t Cycles);
+     void Emu_AdvanceUs(double Us);
+   double Emu_Seconds(void);
+     void Emu_AddSource(uint64_t (*Next)(void *Ctx), void (*Fire)(void *Ctx), void *Ctx);
+     void Emu_AddIrq(uint8_t Irq, uint8_t (*Pending)(void *Ctx), void (*Handler)(void), void *Ctx);
+     void Emu_Dispatch(void);
+     void Emu_SetInput(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint8_t Level);
+     void Emu_SI2C_Attach(GPIO_TypeDef *SCL_GPIOx, uint16_t SCL_Pin, GPIO_TypeDef *SDA_GPIOx, uint16_t SDA_Pin, Emu_I2CSlaveTypeDef *Slave);
+     void Emu_I2C_Attach(I2C_TypeDef *I2Cx, uint32_t ClockHz, Emu_I2CSlaveTypeDef *Slave);
+ uint32_t Emu_I2C_ExtraBytes(I2C_TypeDef *I2Cx);
+
+#endif
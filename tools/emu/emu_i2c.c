@@ -0,0 +1,441 @@
+/**
+  ******************************************************************************
+  * @file    emu_i2c.c
+  * @version V 1.0.0
+  * @brief   硬件I2C外设的仿真（传输层面）
+  *          按参考手册RM0008描述的主机模式行为实现SR1/SR2中的SB、ADDR、TXE、RXNE、
+  *          BTF、AF、BUSY标志位，以及起始位、停止位、ACK位对传输的影响：
+  *          - 每个字节（含应答位）占9个SCL周期，标志位在传输结束的时刻才置位
+  *          - 先读SR1再读SR2清除ADDR，接收模式下清除ADDR后立即开始接收第一个字节
+  *          - 接收时应答位取字节结束时刻的ACK位；DR未被读取时下一个字节存放在移位寄存器中，
+  *            置位BTF并拉低SCL等待，此时该字节已经应答，从机会继续发送
+  *          - STOP位在当前字节结束后生成
+  *          因此驱动中ACK和STOP设置得太晚时，从机会多发送字节，可由Emu_I2C_ExtraBytes查出。
+  *          事件中断（ITEVTEN：SB、ADDR、BTF，加上ITBUFEN：TXE、RXNE）和错误中断（ITERREN：AF）
+  *          在标志位和使能同时有效时挂起，经NVIC响应（I2Cx_EV_IRQHandler、I2Cx_ER_IRQHandler）
+  ******************************************************************************
+  */
+
+#include "emu.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+struct Emu_I2C_TypeDef
+{
+	Emu_I2CSlaveTypeDef *Slave;
+	uint32_t BitCycles;         // 一个SCL周期的CPU周期数
+
+	// SR1/SR2
+	uint8_t Busy, Sb, Addr, Txe, Rxne, Btf, Af;
+	uint8_t Sr1Read;            // ADDR置位后已读过SR1，再读SR2即清除ADDR
+
+	uint8_t Ack;                // CR1.ACK
+	uint8_t StartReq, StopReq;  // CR1.START、CR1.STOP，在当前字节结束后执行
+	uint8_t Mode;
+	uint8_t Selected;           // 从机已被寻址
+	uint8_t Dr, Shift;
+	uint8_t Shifting;           // 移位寄存器正在传输
+	uint8_t LastAck;            // 接收模式下最近一个字节的应答
+	uint64_t DoneAt;            // 当前操作结束的时刻
+
+	uint8_t ItEvt, ItBuf, ItErr; // CR2.ITEVTEN、ITBUFEN、ITERREN
+
+	uint32_t Received, Consumed; // 从从机接收的字节数、被驱动读走的字节数
+	uint32_t Polls;              // 标志位连续未变化的查询次数
+};
+
+enum { I2C_IDLE, I2C_ADDR, I2C_TX, I2C_RX };
+
+I2C_TypeDef Emu_I2C1, Emu_I2C2;
+
+__weak void I2C1_EV_IRQHandler(void) {}
+__weak void I2C1_ER_IRQHandler(void) {}
+__weak void I2C2_EV_IRQHandler(void) {}
+__weak void I2C2_ER_IRQHandler(void) {}
+
+static void Step(I2C_TypeDef *I2Cx);
+
+static uint64_t NextEvent(void *Ctx)
+{
+	I2C_TypeDef *I2Cx = Ctx;
+
+	return I2Cx->DoneAt != 0 ? I2Cx->DoneAt : UINT64_MAX;
+}
+
+static void FireEvent(void *Ctx)
+{
+	Step(Ctx);
+	Emu_Dispatch();
+}
+
+static uint8_t EvPending(void *Ctx)
+{
+	I2C_TypeDef *I2Cx = Ctx;
+
+	if(!I2Cx->ItEvt) return 0;
+
+	if(I2Cx->Sb || I2Cx->Addr || I2Cx->Btf) return 1;
+
+	return I2Cx->ItBuf && (I2Cx->Rxne || (I2Cx->Txe && I2Cx->Mode == I2C_TX));
+}
+
+static uint8_t ErPending(void *Ctx)
+{
+	I2C_TypeDef *I2Cx = Ctx;
+
+	return I2Cx->ItErr && I2Cx->Af;
+}
+
+//
+// @简介：把从机连接到硬件I2C上，并登记传输的时间和中断（须在Emu_Reset之后调用）
+// @参数：ClockHz - SCL的频率，I2C_Init可以改变
+//
+void Emu_I2C_Attach(I2C_TypeDef *I2Cx, uint32_t ClockHz, Emu_I2CSlaveTypeDef *Slave)
+{
+	*I2Cx = (I2C_TypeDef){0};
+
+	I2Cx->Slave = Slave;
+	I2Cx->BitCycles = EMU_CPU_HZ / ClockHz;
+	I2Cx->Ack = 0;
+
+	Emu_AddSource(NextEvent, FireEvent, I2Cx);
+
+	if(I2Cx == I2C1)
+	{
+		Emu_AddIrq(I2C1_EV_IRQn, EvPending, I2C1_EV_IRQHandler, I2Cx);
+		Emu_AddIrq(I2C1_ER_IRQn, ErPending, I2C1_ER_IRQHandler, I2Cx);
+	}
+	else
+	{
+		Emu_AddIrq(I2C2_EV_IRQn, EvPending, I2C2_EV_IRQHandler, I2Cx);
+		Emu_AddIrq(I2C2_ER_IRQn, ErPending, I2C2_ER_IRQHandler, I2Cx);
+	}
+}
+
+//
+// @简介：从机发送了但驱动没有读走的字节数
+//
+uint32_t Emu_I2C_ExtraBytes(I2C_TypeDef *I2Cx)
+{
+	return I2Cx->Received - I2Cx->Consumed;
+}
+
+static void ReleaseSlave(I2C_TypeDef *I2Cx)
+{
+	if(I2Cx->Selected) I2Cx->Slave->Stop(I2Cx->Slave->Dev);
+
+	I2Cx->Selected = 0;
+}
+
+static void DoStop(I2C_TypeDef *I2Cx)
+{
+	ReleaseSlave(I2Cx);
+
+	I2Cx->StopReq = 0;
+	I2Cx->Shifting = 0;
+	I2Cx->Mode = I2C_IDLE;
+	I2Cx->Txe = I2Cx->Btf = 0;
+	I2Cx->DoneAt = emu.Cycles + I2Cx->BitCycles; // 停止位之后总线空闲
+}
+
+static void DoStart(I2C_TypeDef *I2Cx)
+{
+	ReleaseSlave(I2Cx); // 重复起始位
+
+	I2Cx->StartReq = 0;
+	I2Cx->Shifting = 0;
+	I2Cx->Busy = 1;
+	I2Cx->Mode = I2C_ADDR;
+	I2Cx->Txe = I2Cx->Btf = 0;
+	I2Cx->DoneAt = emu.Cycles + I2Cx->BitCycles;
+	I2Cx->Sb = 0; // 在DoneAt时置位
+}
+
+//
+// @简介：开始接收下一个字节
+//
+static void RxNext(I2C_TypeDef *I2Cx)
+{
+	I2Cx->Shifting = 1;
+	I2Cx->DoneAt = emu.Cycles + I2Cx->BitCycles * 9;
+}
+
+//
+// @简介：处理截至当前时刻已经结束的操作
+//
+static void Step(I2C_TypeDef *I2Cx)
+{
+	while(I2Cx->DoneAt != 0 && I2Cx->DoneAt <= emu.Cycles)
+	{
+		I2Cx->DoneAt = 0;
+
+		switch(I2Cx->Mode)
+		{
+		case I2C_IDLE: // 停止位结束
+			I2Cx->Busy = 0;
+			break;
+
+		case I2C_ADDR:
+			if(!I2Cx->Shifting) // 起始位结束
+			{
+				I2Cx->Sb = 1;
+				break;
+			}
+
+			// 地址字节结束
+			I2Cx->Shifting = 0;
+
+			if((I2Cx->Shift >> 1) == I2Cx->Slave->Addr && I2Cx->Slave->Start(I2Cx->Slave->Dev, I2Cx->Shift & 1))
+			{
+				I2Cx->Selected = 1;
+				I2Cx->Addr = 1;
+				I2Cx->Sr1Read = 0;
+				I2Cx->Mode = (I2Cx->Shift & 1) ? I2C_RX : I2C_TX;
+			}
+			else
+			{
+				I2Cx->Af = 1;
+			}
+			break;
+
+		case I2C_TX:
+			if(!I2Cx->Shifting) break;
+
+			I2Cx->Shifting = 0;
+
+			if(!I2Cx->Slave->Write(I2Cx->Slave->Dev, I2Cx->Shift))
+			{
+				I2Cx->Af = 1;
+				break;
+			}
+
+			if(!I2Cx->Txe) // DR中有下一个字节
+			{
+				I2Cx->Shift = I2Cx->Dr;
+				I2Cx->Txe = 1;
+				I2Cx->Shifting = 1;
+				I2Cx->DoneAt = emu.Cycles + I2Cx->BitCycles * 9;
+			}
+			else if(I2Cx->StopReq)
+			{
+				DoStop(I2Cx);
+			}
+			else if(I2Cx->StartReq)
+			{
+				DoStart(I2Cx);
+			}
+			else
+			{
+				I2Cx->Btf = 1;
+			}
+			break;
+
+		case I2C_RX:
+			if(!I2Cx->Shifting) break;
+
+			I2Cx->Shifting = 0;
+			I2Cx->Shift = I2Cx->Slave->Read(I2Cx->Slave->Dev);
+			I2Cx->Received++;
+			I2Cx->LastAck = I2Cx->Ack;
+
+			if(!I2Cx->LastAck) ReleaseSlave(I2Cx); // NAK之后从机不再发送
+
+			if(!I2Cx->Rxne)
+			{
+				I2Cx->Dr = I2Cx->Shift;
+				I2Cx->Rxne = 1;
+			}
+			else
+			{
+				I2Cx->Btf = 1; // 拉低SCL，等待DR被读取
+				break;
+			}
+
+			if(I2Cx->StopReq) DoStop(I2Cx);
+			else if(I2Cx->StartReq) DoStart(I2Cx);
+			else if(I2Cx->LastAck) RxNext(I2Cx);
+			break;
+		}
+	}
+}
+
+static void Touch(I2C_TypeDef *I2Cx)
+{
+	Emu_Advance(emu.CallCycles);
+	Step(I2Cx);
+}
+
+static uint16_t ReadSR1(I2C_TypeDef *I2Cx)
+{
+	if(I2Cx->Addr) I2Cx->Sr1Read = 1;
+
+	return (I2Cx->Sb << 0) | (I2Cx->Addr << 1) | (I2Cx->Btf << 2) | (I2Cx->Rxne << 6) | (I2Cx->Txe << 7) | (I2Cx->Af << 10);
+}
+
+static uint16_t ReadSR2(I2C_TypeDef *I2Cx)
+{
+	uint16_t sr2 = (1 << 0) | (I2Cx->Busy << 1) | ((I2Cx->Mode == I2C_TX) << 2); // MSL、BUSY、TRA
+
+	if(I2Cx->Addr && I2Cx->Sr1Read) // 清除ADDR
+	{
+		I2Cx->Addr = 0;
+		I2Cx->Sr1Read = 0;
+
+		if(I2Cx->Mode == I2C_TX)
+		{
+			I2Cx->Txe = 1;
+		}
+		else if(I2Cx->Mode == I2C_RX)
+		{
+			RxNext(I2Cx); // 清除ADDR之前设置的STOP在第一个字节结束后生效
+		}
+	}
+
+	return sr2;
+}
+
+void I2C_Init(I2C_TypeDef *I2Cx, I2C_InitTypeDef *I2C_InitStruct)
+{
+	Emu_Advance(emu.CallCycles * 4);
+
+	if(I2C_InitStruct->I2C_ClockSpeed != 0) I2Cx->BitCycles = EMU_CPU_HZ / I2C_InitStruct->I2C_ClockSpeed;
+
+	I2Cx->Ack = I2C_InitStruct->I2C_Ack == I2C_Ack_Enable;
+}
+
+void I2C_Cmd(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	(void)NewState;
+	Touch(I2Cx);
+}
+
+void I2C_ITConfig(I2C_TypeDef *I2Cx, uint16_t I2C_IT, FunctionalState NewState)
+{
+	Touch(I2Cx);
+
+	uint8_t on = NewState == ENABLE;
+
+	if(I2C_IT & I2C_IT_EVT) I2Cx->ItEvt = on;
+	if(I2C_IT & I2C_IT_BUF) I2Cx->ItBuf = on;
+	if(I2C_IT & I2C_IT_ERR) I2Cx->ItErr = on;
+
+	Emu_Dispatch(); // 标志位已经置位时立即响应
+}
+
+FlagStatus I2C_GetFlagStatus(I2C_TypeDef *I2Cx, uint32_t I2C_FLAG)
+{
+	Touch(I2Cx);
+
+	uint32_t reg = (I2C_FLAG & 0x10000000) ? ReadSR1(I2Cx) : ((uint32_t)ReadSR2(I2Cx) << 16);
+	FlagStatus status = (reg & I2C_FLAG & 0x00ffffff) ? SET : RESET;
+
+	// 驱动在等待一个永远不会置位的标志
+	if(++I2Cx->Polls > 10000000)
+	{
+		fprintf(stderr, "i2c: flag 0x%08x never changes (driver hang)\n", (unsigned)I2C_FLAG);
+		exit(1);
+	}
+
+	return status;
+}
+
+uint16_t I2C_ReadRegister(I2C_TypeDef *I2Cx, uint8_t I2C_Register)
+{
+	Touch(I2Cx);
+	I2Cx->Polls = 0;
+
+	return I2C_Register == I2C_Register_SR1 ? ReadSR1(I2Cx) : ReadSR2(I2Cx);
+}
+
+void I2C_ClearFlag(I2C_TypeDef *I2Cx, uint32_t I2C_FLAG)
+{
+	Touch(I2Cx);
+
+	if(I2C_FLAG & I2C_FLAG_AF & 0x00ffffff) I2Cx->Af = 0;
+}
+
+void I2C_GenerateSTART(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	Touch(I2Cx);
+	I2Cx->Polls = 0;
+
+	if(NewState != ENABLE) return;
+
+	if(I2Cx->Shifting) I2Cx->StartReq = 1; // 当前字节结束后执行
+	else DoStart(I2Cx);
+}
+
+void I2C_GenerateSTOP(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	Touch(I2Cx);
+	I2Cx->Polls = 0;
+
+	if(NewState != ENABLE) return;
+
+	if(I2Cx->Shifting) I2Cx->StopReq = 1; // 当前字节结束后执行
+	else if(I2Cx->Mode == I2C_RX && I2Cx->Addr) I2Cx->StopReq = 1; // ADDR尚未清除
+	else if(I2Cx->Mode != I2C_IDLE || I2Cx->Busy) DoStop(I2Cx);
+}
+
+void I2C_AcknowledgeConfig(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	Touch(I2Cx);
+	I2Cx->Ack = NewState == ENABLE;
+}
+
+void I2C_SendData(I2C_TypeDef *I2Cx, uint8_t Data)
+{
+	Touch(I2Cx);
+	I2Cx->Polls = 0;
+
+	if(I2Cx->Sb) // 地址字节，SB由读SR1再写DR清除
+	{
+		I2Cx->Sb = 0;
+		I2Cx->Shift = Data;
+		I2Cx->Shifting = 1;
+		I2Cx->DoneAt = emu.Cycles + I2Cx->BitCycles * 9;
+		return;
+	}
+
+	if(I2Cx->Mode != I2C_TX) return;
+
+	I2Cx->Btf = 0;
+
+	if(!I2Cx->Shifting)
+	{
+		I2Cx->Shift = Data;
+		I2Cx->Shifting = 1;
+		I2Cx->Txe = 1;
+		I2Cx->DoneAt = emu.Cycles + I2Cx->BitCycles * 9;
+	}
+	else
+	{
+		I2Cx->Dr = Data;
+		I2Cx->Txe = 0;
+	}
+}
+
+uint8_t I2C_ReceiveData(I2C_TypeDef *I2Cx)
+{
+	Touch(I2Cx);
+	I2Cx->Polls = 0;
+
+	uint8_t data = I2Cx->Dr;
+
+	if(I2Cx->Rxne) I2Cx->Consumed++;
+
+	I2Cx->Rxne = 0;
+
+	if(I2Cx->Btf) // 移位寄存器中的字节进入DR，SCL释放
+	{
+		I2Cx->Btf = 0;
+		I2Cx->Dr = I2Cx->Shift;
+		I2Cx->Rxne = 1;
+
+		if(I2Cx->StopReq) DoStop(I2Cx);
+		else if(I2Cx->StartReq) DoStart(I2Cx);
+		else if(I2Cx->LastAck && I2Cx->Mode == I2C_RX) RxNext(I2Cx);
+	}
+
+	return data;
+}
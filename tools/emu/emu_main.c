@@ -0,0 +1,518 @@
+/**
+  ******************************************************************************
+  * @file    emu_main.c
+  * @version V 1.0.0
+  * @brief   驱动仿真测试台
+  *          把my_lib/si2c.c、my_lib/i2c.c、user/app_mpu6050.c、user/app_encoder.c原样编译到电脑上，
+  *          接到寄存器层面的MPU6050仿真和正交编码器仿真上运行，检查：
+  *          1. 软件I2C（si2c.c）：SCL时序、连续读的正确性，以及阻塞读取的耗时（对照）
+  *          2. 硬件I2C中断 + app_mpu6050：初始化写入的寄存器、读取的次数和耗时、CPU占用、
+  *             16位数据高低字节来自不同采样的次数（撕裂）、角速度和倾角的误差
+  *          3. 硬件I2C（i2c.c）：寄存器读写、连续读、FIFO，以及从机多发送的字节数
+  *          4. 编码器：占空比不对称和边沿抖动下的测速误差、计数、中断负载、丢失的边沿，
+  *             以及校准后能否恢复占空比
+  *
+  *          编译（在仓库根目录下，tools/emu/stm32f10x.h代替标准库的头文件，不要加-Itools/sim）：
+  *          gcc -O2 -o emu -Itools/emu -Iuser -Imy_lib tools/emu/emu.c tools/emu/emu_i2c.c \
+  *              tools/emu/emu_mpu6050.c tools/emu/emu_quad.c tools/emu/emu_main.c \
+  *              my_lib/si2c.c my_lib/i2c.c my_lib/qmath.c user/app_mpu6050.c user/app_encoder.c \
+  *              my_lib/bus.c user/app_bus.c tools/common/app_stubs.c -lm
+  *
+  *          使用：./emu [-t 秒] [-d 占空比] [-j 抖动us] [-f I2C频率kHz] [-c 空循环周期数] [-s 种子]
+  *          -c 为My_SI2C_Delay中一次空循环的CPU周期数，默认10（Keil -O0）
+  *          任何一项检查不通过时返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "emu.h"
+#include "emu_mpu6050.h"
+#include "emu_quad.h"
+#include "si2c.h"
+#include "i2c.h"
+#include "delay.h"
+#include "app_mpu6050.h"
+#include "app_encoder.h"
+#include "app_calibrator.h"
+#include "app_trace.h"
+
+#define RAD_PER_EDGE 0.01399402208920360588844895090594 // 与app_encoder.c相同
+
+static int failures = 0;
+
+static void Check(const char *Name, int Ok)
+{
+	printf("  %-30s %s\n", Name, Ok ? "ok" : "FAIL");
+
+	if(!Ok) failures++;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 校准器的替身
+//////////////////////////////////////////////////////////////////////////
+
+static CaliResult_TypeDef cali;
+
+const CaliResult_TypeDef *App_Calibrator_GetResult(void)
+{
+	return &cali;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 记录模块的替身，测试台不需要记录输入（遥测、热启动等见tools/common/app_stubs.c）
+//////////////////////////////////////////////////////////////////////////
+
+void App_Trace_Record(uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size)
+{
+	(void)Type; (void)Flags; (void)Us; (void)pData; (void)Size;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 传感器的运动：绕X轴摆动，theta = A/(2*pi*f) * (1 - cos(2*pi*f*t))
+//////////////////////////////////////////////////////////////////////////
+
+#define MOTION_AMP  50.0 // 角速度幅值，°/s
+#define MOTION_FREQ 1.0  // Hz
+
+static double MotionRate(double T)
+{
+	return MOTION_AMP * sin(2 * M_PI * MOTION_FREQ * T);
+}
+
+static double MotionAngle(double T)
+{
+	return MOTION_AMP / (2 * M_PI * MOTION_FREQ) * (1 - cos(2 * M_PI * MOTION_FREQ * T));
+}
+
+static void MotionSample(void *Ctx, double T, float Accel[3], float Gyro[3], float *pTemp)
+{
+	(void)Ctx;
+
+	double theta = MotionAngle(T) * M_PI / 180;
+
+	Accel[0] = 0;
+	Accel[1] = (float)sin(theta);
+	Accel[2] = (float)cos(theta);
+	Gyro[0] = (float)MotionRate(T);
+	Gyro[1] = 0;
+	Gyro[2] = 0;
+	*pTemp = 30;
+}
+
+static void WaitUntil(uint64_t Cycles)
+{
+	if(Cycles > emu.Cycles) Emu_Advance((uint32_t)(Cycles - emu.Cycles));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 1. 软件I2C（对照）
+//////////////////////////////////////////////////////////////////////////
+
+static void BenchSI2C(uint32_t LoopCycles)
+{
+	static Emu_MPU6050_TypeDef mpu;
+	Emu_I2CSlaveTypeDef slave;
+	SI2C_TypeDef si2c = {GPIOB, GPIO_Pin_8, GPIOB, GPIO_Pin_9};
+	uint8_t buffer[14], reg;
+
+	printf("si2c\n");
+
+	Emu_Reset();
+	emu.LoopCycles = LoopCycles;
+
+	Emu_MPU6050_Init(&mpu, MotionSample, NULL);
+	Emu_MPU6050_Slave(&mpu, &slave);
+	Emu_SI2C_Attach(GPIOB, GPIO_Pin_8, GPIOB, GPIO_Pin_9, &slave);
+
+	My_SI2C_Init(&si2c);
+
+	reg = 0x01;
+	My_SI2C_RegWriteBytes(&si2c, 0xd0, 0x6b, &reg, 1);
+	reg = 0x00;
+	My_SI2C_RegWriteBytes(&si2c, 0xd0, 0x19, &reg, 1);
+	Delay(5);
+
+	// 以前app_mpu6050用软件I2C读取，按同样的节奏（每1ms读一次，每5次读一次全部数据）估算其CPU占用
+	uint64_t start = emu.Cycles;
+
+	My_SI2C_RegReadBytes(&si2c, 0xd0, 0x3b, buffer, 14);
+
+	uint64_t allCycles = emu.Cycles - start;
+
+	Check("RegReadBytes 14 bytes", memcmp(buffer, mpu.Shadow, 14) == 0);
+
+	start = emu.Cycles;
+	My_SI2C_RegReadBytes(&si2c, 0xd0, 0x43, buffer, 2);
+
+	uint64_t gyroCycles = emu.Cycles - start;
+
+	Check("RegReadBytes 2 bytes", memcmp(buffer, mpu.Shadow + 8, 2) == 0);
+
+	printf("  14-byte read         %.1f us\n", allCycles / 72.0);
+	printf("  2-byte read          %.1f us\n", gyroCycles / 72.0);
+	printf("  cpu load at 1 kHz    %.1f %% (blocking, for comparison)\n",
+	       (allCycles + (MPU6050_ATTITUDE_DIV - 1) * gyroCycles) * 100.0 / (EMU_CPU_HZ / 1000 * MPU6050_RATE_MS * MPU6050_ATTITUDE_DIV));
+	printf("  scl high/low min     %.0f / %.0f ns (fast mode: 600 / 1300)\n", emu.SI2C.MinHigh / 0.072, emu.SI2C.MinLow / 0.072);
+	printf("  sda setup min        %.0f ns (fast mode: 100)\n", emu.SI2C.MinSetup / 0.072);
+	printf("  timing violations    %u\n", emu.SI2C.Violations);
+
+	Check("scl timing (fast mode)", emu.SI2C.Violations == 0);
+
+	reg = 0x75;
+	My_SI2C_SendBytes(&si2c, 0xd0, &reg, 1);
+	My_SI2C_ReceiveBytes(&si2c, 0xd0, buffer, 1);
+	Check("ReceiveBytes WHO_AM_I", buffer[0] == 0x68);
+
+	reg = 0x3b;
+	My_SI2C_SendBytes(&si2c, 0xd0, &reg, 1);
+	My_SI2C_ReceiveBytes(&si2c, 0xd0, buffer, 4);
+	Check("ReceiveBytes 4 bytes", memcmp(buffer, mpu.Shadow, 4) == 0);
+	Check("no nacks", emu.SI2C.Nacks == 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 2. 硬件I2C中断 + app_mpu6050
+//////////////////////////////////////////////////////////////////////////
+
+#define MAIN_LOOP_US 50 // 主循环轮询App_MPU6050_Proc的间隔
+
+static void BenchApp(double Duration)
+{
+	static Emu_MPU6050_TypeDef mpu;
+	Emu_I2CSlaveTypeDef slave;
+
+	printf("i2c1 irq + app_mpu6050\n");
+
+	Emu_Reset();
+
+	Emu_MPU6050_Init(&mpu, MotionSample, NULL);
+	Emu_MPU6050_Slave(&mpu, &slave);
+	Emu_I2C_Attach(I2C1, 400000, &slave);
+
+	App_MPU6050_Init();
+
+	// 复位完成后由App_MPU6050_Proc配置
+	while(!App_MPU6050_IsReady())
+	{
+		App_MPU6050_Proc();
+		Emu_AdvanceUs(MAIN_LOOP_US);
+	}
+
+	Check("init PWR_MGMT_1 = 0x01", mpu.Reg[0x6b] == 0x01);
+	Check("init SMPLRT_DIV/CONFIG", mpu.Reg[0x19] == 0x00 && mpu.Reg[0x1a] == 0x02);
+	Check("init GYRO/ACCEL_CONFIG", mpu.Reg[0x1b] == 0x18 && mpu.Reg[0x1c] == 0x00);
+
+	// 与主循环相同地轮询，CPU占用 = App_MPU6050_Proc本身的耗时 + I2C中断的耗时
+	uint32_t reads = 0, isr0 = emu.IsrCount, txn0 = mpu.Transactions;
+	uint64_t t0 = emu.Cycles, isrCycles0 = emu.IsrCycles, procCycles = 0, maxProcCycles = 0;
+	uint64_t readFrom = 0, sumRead = 0, maxRead = 0;
+	double maxGyroErr = 0, maxPitchErr = 0;
+	uint8_t wasReading = 0;
+
+	mpu.Pairs = mpu.Torn = 0;
+
+	while(emu.Cycles < t0 + (uint64_t)(Duration * EMU_CPU_HZ))
+	{
+		uint64_t start = emu.Cycles, isr = emu.IsrCycles;
+		float pitch0 = App_MPU6050_GetPitch();
+
+		App_MPU6050_Proc();
+
+		uint64_t cycles = emu.Cycles - start - (emu.IsrCycles - isr);
+
+		procCycles += cycles;
+		if(cycles > maxProcCycles) maxProcCycles = cycles;
+
+		// 读取结束，与开始读取时（数据寄存器被锁存）那次采样的真实值比较
+		if(wasReading && !App_MPU6050_IsReading())
+		{
+			double ts = floor(readFrom / (double)EMU_CPU_HZ * 1000) / 1000;
+			double gyroErr = fabs(App_MPU6050_GetGyroX() - MotionRate(ts));
+
+			if(ts > 0.05 && gyroErr > maxGyroErr) maxGyroErr = gyroErr;
+
+			if(App_MPU6050_GetPitch() != pitch0)
+			{
+				double pitchErr = fabs(App_MPU6050_GetPitch() - MotionAngle(ts));
+
+				if(ts > 0.5 && pitchErr > maxPitchErr) maxPitchErr = pitchErr;
+			}
+
+			sumRead += emu.Cycles - readFrom;
+			if(emu.Cycles - readFrom > maxRead) maxRead = emu.Cycles - readFrom;
+			reads++;
+		}
+
+		if(!wasReading && App_MPU6050_IsReading()) readFrom = start;
+
+		wasReading = App_MPU6050_IsReading();
+
+		Emu_AdvanceUs(MAIN_LOOP_US);
+	}
+
+	uint64_t total = emu.Cycles - t0, isrCycles = emu.IsrCycles - isrCycles0;
+	uint32_t isrCount = emu.IsrCount - isr0;
+
+	printf("  reads                %u, %.1f transactions each\n", reads, (mpu.Transactions - txn0) / (double)reads);
+	printf("  read to publish      avg %.1f us, max %.1f us\n", sumRead / (double)reads / 72, maxRead / 72.0);
+	printf("  proc time            max %.1f us\n", maxProcCycles / 72.0);
+	printf("  isr                  %u, %.0f cycles each\n", isrCount, isrCycles / (double)isrCount);
+	printf("  cpu load             %.1f %% (proc %.1f %%, isr %.1f %%)\n", (procCycles + isrCycles) * 100.0 / total,
+	       procCycles * 100.0 / total, isrCycles * 100.0 / total);
+	printf("  torn pairs           %u / %u\n", mpu.Torn, mpu.Pairs);
+	printf("  gyro x error max     %.3f deg/s\n", maxGyroErr);
+	printf("  pitch error max      %.3f deg\n", maxPitchErr);
+	printf("  extra bytes clocked  %u\n", Emu_I2C_ExtraBytes(I2C1));
+
+	Check("one read per ms", fabs(reads - Duration * 1000 / MPU6050_RATE_MS) <= 2);
+	Check("cpu load < 10%", (procCycles + isrCycles) * 10 < total);
+	Check("no torn pairs", mpu.Torn == 0);
+	Check("gyro within 1 lsb + 1 ms drift", maxGyroErr < 0.0611 + MOTION_AMP * 2 * M_PI * MOTION_FREQ * 0.001);
+	Check("pitch within 0.5 deg", maxPitchErr < 0.5);
+	Check("no extra bytes clocked", Emu_I2C_ExtraBytes(I2C1) == 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 3. 硬件I2C
+//////////////////////////////////////////////////////////////////////////
+
+static void RegWrite(uint8_t Reg, uint8_t Data)
+{
+	My_I2C_RegWriteBytes(I2C1, 0xd0, Reg, &Data, 1);
+}
+
+static uint8_t RegRead(uint8_t Reg)
+{
+	uint8_t data = 0;
+
+	My_I2C_RegReadBytes(I2C1, 0xd0, Reg, &data, 1);
+
+	return data;
+}
+
+static void BenchI2C(uint32_t ClockHz)
+{
+	static Emu_MPU6050_TypeDef mpu;
+	static uint8_t fifo[EMU_MPU6050_FIFO_SIZE];
+	Emu_I2CSlaveTypeDef slave;
+	uint8_t buffer[14];
+
+	printf("i2c (%u kHz)\n", ClockHz / 1000);
+
+	Emu_Reset();
+	Emu_MPU6050_Init(&mpu, MotionSample, NULL);
+	Emu_MPU6050_Slave(&mpu, &slave);
+	Emu_I2C_Attach(I2C1, ClockHz, &slave);
+
+	Check("WHO_AM_I", RegRead(0x75) == 0x68);
+
+	RegWrite(0x6b, 0x80); // 复位
+	Delay(100);
+	RegWrite(0x6b, 0x01);
+	RegWrite(0x1a, 0x01); // 1kHz
+	RegWrite(0x19, 0x00);
+	RegWrite(0x1b, 0x18);
+
+	Check("register write/read back", RegRead(0x6b) == 0x01 && RegRead(0x1a) == 0x01 && RegRead(0x1b) == 0x18);
+
+	Delay(5);
+
+	// 连续读
+	uint64_t start = emu.Cycles;
+
+	My_I2C_RegReadBytes(I2C1, 0xd0, 0x3b, buffer, 14);
+
+	printf("  14-byte read         %.1f us\n", (emu.Cycles - start) / 72.0);
+
+	Check("RegReadBytes 14 bytes", memcmp(buffer, mpu.Shadow, 14) == 0);
+
+	My_I2C_RegReadBytes(I2C1, 0xd0, 0x3b, buffer, 2);
+	Check("RegReadBytes 2 bytes", memcmp(buffer, mpu.Shadow, 2) == 0);
+
+	// FIFO：加速度和陀螺仪，每次采样12个字节
+	RegWrite(0x6a, 0x04); // FIFO_RESET
+	RegWrite(0x23, 0x78);
+	RegWrite(0x6a, 0x40);
+
+	uint32_t index0 = mpu.SampleIndex;
+
+	Delay(10);
+	RegWrite(0x6b, 0x41); // 睡眠，停止采样，数据寄存器保持最后一次采样的值
+
+	My_I2C_RegReadBytes(I2C1, 0xd0, 0x72, buffer, 2);
+
+	uint16_t count = (buffer[0] << 8) | buffer[1];
+	uint32_t samples = mpu.SampleIndex - index0;
+
+	My_I2C_RegReadBytes(I2C1, 0xd0, 0x74, fifo, count);
+
+	printf("  fifo                 %u bytes, %u samples\n", count, samples);
+
+	Check("fifo count = 12 x samples", count == samples * 12);
+	Check("fifo frame = data registers", count >= 12 && memcmp(fifo + count - 12, mpu.Reg + 0x3b, 6) == 0 && memcmp(fifo + count - 6, mpu.Reg + 0x43, 6) == 0);
+	Check("fifo no underflow", mpu.Underflows == 0);
+
+	printf("  extra bytes clocked  %u\n", Emu_I2C_ExtraBytes(I2C1));
+
+	Check("no extra bytes clocked", Emu_I2C_ExtraBytes(I2C1) == 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 4. 编码器
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	double SumSq, Max;
+	uint32_t N;
+} ErrTypeDef;
+
+static void Accumulate(ErrTypeDef *Err, double Measured, double Truth)
+{
+	double e = fabs(Measured - Truth) / fabs(Truth);
+
+	Err->SumSq += e * e;
+	Err->N++;
+
+	if(e > Err->Max) Err->Max = e;
+}
+
+//
+// @简介：按速度曲线运行两个编码器，每1ms读取一次速度（与电机任务相同），统计相对误差
+//
+static void RunProfile(Emu_Quad_TypeDef *QuadL, Emu_Quad_TypeDef *QuadR, ErrTypeDef *Err)
+{
+	static const double speeds[] = {100, 400, 1100, -400}; // 周期/s，1100约为1m/s
+
+	memset(Err, 0, sizeof(*Err));
+
+	for(int s=0; s<4; s++)
+	{
+		Emu_Quad_SetSpeed(QuadL, speeds[s]);
+		Emu_Quad_SetSpeed(QuadR, -speeds[s] * 0.9); // 右轮反向安装
+
+		uint64_t t0 = emu.Cycles;
+
+		for(int ms=1; ms<=500; ms++)
+		{
+			WaitUntil(t0 + (uint64_t)ms * (EMU_CPU_HZ / 1000));
+
+			float l = App_Encoder_GetSpeed_L();
+			float r = App_Encoder_GetSpeed_R();
+
+			if(ms < 20) continue; // 换向后的前几个边沿速度为0
+
+			Accumulate(Err, l, 2 * speeds[s] * RAD_PER_EDGE);
+			Accumulate(Err, r, 2 * speeds[s] * 0.9 * RAD_PER_EDGE);
+		}
+	}
+}
+
+static void BenchEncoder(float Duty, float JitterUs, uint32_t Seed)
+{
+	static Emu_Quad_TypeDef quadL, quadR;
+	ErrTypeDef err;
+
+	printf("encoder (duty %.2f, jitter %.1f us)\n", Duty, JitterUs);
+
+	Emu_Reset();
+
+	Emu_Quad_InitTypeDef Quad_InitStruct = {GPIOB, GPIO_Pin_14, GPIO_Pin_15, Duty, 0.25f, JitterUs, Seed};
+
+	Emu_Quad_Init(&quadL, &Quad_InitStruct);
+
+	Quad_InitStruct.A_Pin = GPIO_Pin_3;
+	Quad_InitStruct.B_Pin = GPIO_Pin_4;
+	Quad_InitStruct.Seed = Seed * 7 + 1;
+
+	Emu_Quad_Init(&quadR, &Quad_InitStruct);
+
+	// 未校准
+	cali.encoder_duty_l = 0.5f;
+	cali.encoder_duty_r = 0.5f;
+
+	App_Encoder_Init();
+
+	uint64_t t0 = emu.Cycles;
+	uint64_t isr0 = emu.IsrCycles;
+	uint32_t count0 = emu.IsrCount;
+
+	RunProfile(&quadL, &quadR, &err);
+
+	printf("  uncalibrated         rms %.2f %%, max %.2f %%\n", sqrt(err.SumSq / err.N) * 100, err.Max * 100);
+	printf("  isr                  %u, %.0f cycles each, %.2f %% cpu\n", emu.IsrCount - count0,
+		(double)(emu.IsrCycles - isr0) / (emu.IsrCount - count0), (double)(emu.IsrCycles - isr0) / (emu.Cycles - t0) * 100);
+	printf("  lost edges           %u\n", emu.LostEdges);
+
+	Check("count left", lround(App_Encoder_GetPos_L() / RAD_PER_EDGE) == quadL.EdgesA);
+	Check("count right", lround(-App_Encoder_GetPos_R() / RAD_PER_EDGE) == quadR.EdgesA);
+
+	// 校准：匀速正转时测量两种台阶的平均宽度
+	Emu_Quad_SetSpeed(&quadL, 400);
+	Emu_Quad_SetSpeed(&quadR, 400);
+	Delay(50);
+
+	App_Encoder_StartCalibration();
+	Delay(500);
+
+	float dutyL, dutyR;
+	int ret = App_Encoder_EndCalibration(&dutyL, &dutyR);
+
+	printf("  calibrated duty      %.4f / %.4f\n", dutyL, dutyR);
+
+	Check("calibration", ret == 0 && fabsf(dutyL - Duty) < 0.01f && fabsf(dutyR - Duty) < 0.01f);
+
+	cali.encoder_duty_l = dutyL;
+	cali.encoder_duty_r = dutyR;
+
+	App_Encoder_Init();
+
+	RunProfile(&quadL, &quadR, &err);
+
+	printf("  calibrated           rms %.2f %%, max %.2f %%\n", sqrt(err.SumSq / err.N) * 100, err.Max * 100);
+
+	Check("calibrated speed rms < 2%", sqrt(err.SumSq / err.N) < 0.02);
+	Check("no lost edges", emu.LostEdges == 0);
+}
+
+int main(int argc, char *argv[])
+{
+	double duration = 1;    // MPU6050读取的时长，单位s
+	float duty = 0.45f;     // 编码器A相占空比
+	float jitter = 1;       // 编码器边沿抖动，单位us
+	uint32_t clockHz = 400000;
+	uint32_t loopCycles = 10;
+	uint32_t seed = 1;
+
+	for(int i=1; i<argc; i++)
+	{
+		const char *opt = argv[i];
+		const char *arg = i + 1 < argc ? argv[i+1] : NULL;
+
+		if(arg == NULL) { fprintf(stderr, "missing value for %s\n", opt); return 1; }
+		i++;
+
+		if(strcmp(opt, "-t") == 0) duration = atof(arg);
+		else if(strcmp(opt, "-d") == 0) duty = atof(arg);
+		else if(strcmp(opt, "-j") == 0) jitter = atof(arg);
+		else if(strcmp(opt, "-f") == 0) clockHz = (uint32_t)(atof(arg) * 1000);
+		else if(strcmp(opt, "-c") == 0) loopCycles = atoi(arg);
+		else if(strcmp(opt, "-s") == 0) seed = atoi(arg);
+		else { fprintf(stderr, "unknown option %s\n", opt); return 1; }
+	}
+
+	if(duty <= 0.1f || duty >= 0.9f) { fprintf(stderr, "duty must be 0.1..0.9\n"); return 1; }
+	if(clockHz < 10000 || clockHz > 1000000) { fprintf(stderr, "i2c clock must be 10..1000 kHz\n"); return 1; }
+
+	BenchSI2C(loopCycles);
+	BenchApp(duration);
+	BenchI2C(clockHz);
+	BenchEncoder(duty, jitter, seed ? seed : 1);
+
+	printf("%s (%d failed)\n", failures ? "FAIL" : "PASS", failures);
+
+	return failures ? 1 : 0;
+}
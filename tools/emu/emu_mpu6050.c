@@ -0,0 +1,379 @@
+/**
+  ******************************************************************************
+  * @file    emu_mpu6050.c
+  * @version V 1.0.0
+  * @brief   寄存器层面的MPU6050仿真
+  ******************************************************************************
+  */
+
+#include "emu_mpu6050.h"
+#include <string.h>
+#include <math.h>
+
+// 寄存器地址
+#define SMPLRT_DIV    0x19
+#define CONFIG        0x1a
+#define GYRO_CONFIG   0x1b
+#define ACCEL_CONFIG  0x1c
+#define FIFO_EN       0x23
+#define INT_PIN_CFG   0x37
+#define INT_ENABLE    0x38
+#define INT_STATUS    0x3a
+#define ACCEL_XOUT_H  0x3b
+#define GYRO_ZOUT_L   0x48
+#define EXT_SENS_END  0x60
+#define SIGNAL_PATH_RESET 0x68
+#define USER_CTRL     0x6a
+#define PWR_MGMT_1    0x6b
+#define FIFO_COUNTH   0x72
+#define FIFO_COUNTL   0x73
+#define FIFO_R_W      0x74
+#define WHO_AM_I      0x75
+
+// 事务的阶段
+enum { MPU_IDLE, MPU_REG, MPU_WRITE, MPU_READ };
+
+static uint8_t Start(void *Dev, uint8_t Read);
+static uint8_t Write(void *Dev, uint8_t Data);
+static uint8_t Read(void *Dev);
+static void Stop(void *Dev);
+
+//
+// @简介：上电复位
+//
+static void PowerOnReset(Emu_MPU6050_TypeDef *Mpu)
+{
+	memset(Mpu->Reg, 0, sizeof(Mpu->Reg));
+
+	Mpu->Reg[PWR_MGMT_1] = 0x40; // 上电后处于睡眠状态
+	Mpu->Reg[WHO_AM_I] = 0x68;
+
+	Mpu->FifoHead = 0;
+	Mpu->FifoCount = 0;
+	Mpu->NextSample = emu.Cycles;
+}
+
+//
+// @简介：初始化仿真的MPU6050
+// @参数：Sample - 获取物理量的函数，在每个采样时刻调用
+//
+void Emu_MPU6050_Init(Emu_MPU6050_TypeDef *Mpu, Emu_MPU6050_SampleFunc Sample, void *Ctx)
+{
+	memset(Mpu, 0, sizeof(*Mpu));
+
+	Mpu->Sample = Sample;
+	Mpu->Ctx = Ctx;
+
+	PowerOnReset(Mpu);
+}
+
+//
+// @简介：填写I2C从机接口，地址0x68（AD0接地）
+//
+void Emu_MPU6050_Slave(Emu_MPU6050_TypeDef *Mpu, Emu_I2CSlaveTypeDef *Slave)
+{
+	Slave->Addr = 0x68;
+	Slave->Start = Start;
+	Slave->Write = Write;
+	Slave->Read = Read;
+	Slave->Stop = Stop;
+	Slave->Dev = Mpu;
+}
+
+//
+// @简介：当前配置下的采样率，单位Hz
+//        DLPF_CFG为0或7时陀螺仪输出率为8kHz，否则为1kHz，采样率 = 输出率 / (1 + SMPLRT_DIV)
+//
+double Emu_MPU6050_SampleRate(const Emu_MPU6050_TypeDef *Mpu)
+{
+	uint8_t dlpf = Mpu->Reg[CONFIG] & 0x07;
+	double rate = (dlpf == 0 || dlpf == 7) ? 8000.0 : 1000.0;
+
+	return rate / (1 + Mpu->Reg[SMPLRT_DIV]);
+}
+
+//
+// @简介：加速度计每LSB对应的g，由AFS_SEL决定
+//
+float Emu_MPU6050_AccelLsb(const Emu_MPU6050_TypeDef *Mpu)
+{
+	return (float)(1 << ((Mpu->Reg[ACCEL_CONFIG] >> 3) & 3)) / 16384.0f;
+}
+
+//
+// @简介：陀螺仪每LSB对应的°/s，由FS_SEL决定
+//
+float Emu_MPU6050_GyroLsb(const Emu_MPU6050_TypeDef *Mpu)
+{
+	return (float)(1 << ((Mpu->Reg[GYRO_CONFIG] >> 3) & 3)) / 131.0f;
+}
+
+static void PutRaw(uint8_t *p, float Value, float Lsb)
+{
+	float raw = roundf(Value / Lsb);
+
+	if(raw > 32767) raw = 32767;
+	if(raw < -32768) raw = -32768;
+
+	int16_t v = (int16_t)raw;
+
+	p[0] = (uint8_t)((uint16_t)v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+static void FifoPush(Emu_MPU6050_TypeDef *Mpu, const uint8_t *pData, int Size)
+{
+	for(int i=0; i<Size; i++)
+	{
+		if(Mpu->FifoCount == EMU_MPU6050_FIFO_SIZE) // 满，丢弃最旧的数据
+		{
+			Mpu->FifoHead = (Mpu->FifoHead + 1) % EMU_MPU6050_FIFO_SIZE;
+			Mpu->FifoCount--;
+			Mpu->Overflows++;
+			Mpu->Reg[INT_STATUS] |= 0x10; // FIFO_OFLOW_INT
+		}
+
+		Mpu->Fifo[(Mpu->FifoHead + Mpu->FifoCount) % EMU_MPU6050_FIFO_SIZE] = pData[i];
+		Mpu->FifoCount++;
+	}
+}
+
+//
+// @简介：完成一次采样：更新数据寄存器，写入FIFO，置位DATA_RDY_INT
+//
+static void DoSample(Emu_MPU6050_TypeDef *Mpu, uint64_t Cycles)
+{
+	float accel[3] = {0, 0, 1}, gyro[3] = {0, 0, 0}, temp = 25;
+
+	if(Mpu->Sample) Mpu->Sample(Mpu->Ctx, (double)Cycles / EMU_CPU_HZ, accel, gyro, &temp);
+
+	uint8_t *r = &Mpu->Reg[ACCEL_XOUT_H];
+	float aLsb = Emu_MPU6050_AccelLsb(Mpu), gLsb = Emu_MPU6050_GyroLsb(Mpu);
+
+	for(int i=0; i<3; i++)
+	{
+		PutRaw(r + 2 * i, accel[i], aLsb);
+		PutRaw(r + 8 + 2 * i, gyro[i], gLsb);
+	}
+
+	PutRaw(r + 6, temp - 36.53f, 1.0f / 340.0f);
+
+	Mpu->SampleIndex++;
+	Mpu->Reg[INT_STATUS] |= 0x01; // DATA_RDY_INT
+
+	// FIFO，按寄存器顺序写入：加速度、温度、陀螺仪X、Y、Z
+	uint8_t en = Mpu->Reg[FIFO_EN];
+
+	if(Mpu->Reg[USER_CTRL] & 0x40)
+	{
+		if(en & 0x08) FifoPush(Mpu, r, 6);
+		if(en & 0x80) FifoPush(Mpu, r + 6, 2);
+		if(en & 0x40) FifoPush(Mpu, r + 8, 2);
+		if(en & 0x20) FifoPush(Mpu, r + 10, 2);
+		if(en & 0x10) FifoPush(Mpu, r + 12, 2);
+	}
+}
+
+//
+// @简介：补齐截至当前时刻的全部采样
+//
+void Emu_MPU6050_Update(Emu_MPU6050_TypeDef *Mpu)
+{
+	if(Mpu->Reg[PWR_MGMT_1] & 0x40) // 睡眠
+	{
+		Mpu->NextSample = emu.Cycles;
+		return;
+	}
+
+	uint64_t period = (uint64_t)(EMU_CPU_HZ / Emu_MPU6050_SampleRate(Mpu) + 0.5);
+
+	// 长时间没有访问时跳过FIFO装不下的部分
+	uint64_t maxBacklog = period * EMU_MPU6050_FIFO_SIZE;
+
+	if(emu.Cycles > Mpu->NextSample + maxBacklog)
+	{
+		uint64_t skip = (emu.Cycles - Mpu->NextSample - maxBacklog) / period;
+		Mpu->NextSample += skip * period;
+		Mpu->SampleIndex += (uint32_t)skip;
+	}
+
+	while(Mpu->NextSample <= emu.Cycles)
+	{
+		DoSample(Mpu, Mpu->NextSample);
+		Mpu->NextSample += period;
+	}
+}
+
+static uint8_t Start(void *Dev, uint8_t Read)
+{
+	Emu_MPU6050_TypeDef *Mpu = Dev;
+
+	Emu_MPU6050_Update(Mpu);
+
+	Mpu->Transactions++;
+
+	if(Read)
+	{
+		memcpy(Mpu->Shadow, &Mpu->Reg[ACCEL_XOUT_H], sizeof(Mpu->Shadow));
+		Mpu->ShadowIndex = Mpu->SampleIndex;
+		Mpu->State = MPU_READ;
+	}
+	else
+	{
+		Mpu->State = MPU_REG;
+	}
+
+	return 1;
+}
+
+static void WriteReg(Emu_MPU6050_TypeDef *Mpu, uint8_t Reg, uint8_t Data)
+{
+	switch(Reg)
+	{
+	case PWR_MGMT_1:
+		if(Data & 0x80) // DEVICE_RESET
+		{
+			PowerOnReset(Mpu);
+			return;
+		}
+		if((Mpu->Reg[PWR_MGMT_1] & 0x40) && !(Data & 0x40)) // 唤醒，从下一个采样周期开始
+		{
+			Mpu->NextSample = emu.Cycles + (uint64_t)(EMU_CPU_HZ / Emu_MPU6050_SampleRate(Mpu));
+		}
+		Mpu->Reg[Reg] = Data;
+		return;
+
+	case USER_CTRL:
+		if(Data & 0x04) // FIFO_RESET，自动清零
+		{
+			Mpu->FifoHead = 0;
+			Mpu->FifoCount = 0;
+		}
+		if(Data & 0x01) // SIG_COND_RESET，清空数据寄存器
+		{
+			memset(&Mpu->Reg[ACCEL_XOUT_H], 0, GYRO_ZOUT_L - ACCEL_XOUT_H + 1);
+		}
+		Mpu->Reg[Reg] = Data & ~0x05;
+		return;
+
+	case SIGNAL_PATH_RESET:
+		return; // 自动清零
+
+	case FIFO_R_W:
+		FifoPush(Mpu, &Data, 1);
+		return;
+
+	case INT_STATUS:
+	case FIFO_COUNTH:
+	case FIFO_COUNTL:
+	case WHO_AM_I:
+		return; // 只读
+
+	default:
+		if(Reg >= ACCEL_XOUT_H && Reg <= EXT_SENS_END) return; // 只读
+		Mpu->Reg[Reg] = Data;
+		return;
+	}
+}
+
+static uint8_t Write(void *Dev, uint8_t Data)
+{
+	Emu_MPU6050_TypeDef *Mpu = Dev;
+
+	if(Mpu->State == MPU_REG)
+	{
+		Mpu->Ptr = Data & 0x7f;
+		Mpu->State = MPU_WRITE;
+		return 1;
+	}
+
+	Emu_MPU6050_Update(Mpu);
+	WriteReg(Mpu, Mpu->Ptr, Data);
+
+	if(Mpu->Ptr != FIFO_R_W) Mpu->Ptr = (Mpu->Ptr + 1) & 0x7f;
+
+	return 1;
+}
+
+//
+// @简介：统计16位数据的高低字节是否来自同一次采样
+//
+static void TrackPair(Emu_MPU6050_TypeDef *Mpu, uint8_t Reg)
+{
+	int i = Reg - ACCEL_XOUT_H;
+	int partner = i ^ 1;
+
+	Mpu->LastTxn[i] = Mpu->Transactions;
+	Mpu->LastIndex[i] = Mpu->ShadowIndex;
+
+	// 另一半在本事务或前两个事务（写寄存器地址+读）中读取过，视为同一个16位数据
+	if(Mpu->LastTxn[partner] + 2 >= Mpu->Transactions && Mpu->LastTxn[partner] != 0)
+	{
+		Mpu->Pairs++;
+
+		if(Mpu->LastIndex[partner] != Mpu->ShadowIndex) Mpu->Torn++;
+
+		Mpu->LastTxn[partner] = 0; // 已配对
+		Mpu->LastTxn[i] = 0;
+	}
+}
+
+static uint8_t Read(void *Dev)
+{
+	Emu_MPU6050_TypeDef *Mpu = Dev;
+	uint8_t reg = Mpu->Ptr;
+	uint8_t value;
+
+	Emu_MPU6050_Update(Mpu);
+
+	if(reg >= ACCEL_XOUT_H && reg <= EXT_SENS_END)
+	{
+		value = Mpu->Shadow[reg - ACCEL_XOUT_H];
+
+		if(reg <= GYRO_ZOUT_L) TrackPair(Mpu, reg);
+	}
+	else if(reg == INT_STATUS)
+	{
+		value = Mpu->Reg[INT_STATUS];
+		Mpu->Reg[INT_STATUS] = 0; // 读取后清零
+	}
+	else if(reg == FIFO_COUNTH)
+	{
+		value = Mpu->FifoCount >> 8;
+	}
+	else if(reg == FIFO_COUNTL)
+	{
+		value = Mpu->FifoCount & 0xff;
+	}
+	else if(reg == FIFO_R_W)
+	{
+		if(Mpu->FifoCount == 0)
+		{
+			Mpu->Underflows++;
+			value = 0;
+		}
+		else
+		{
+			value = Mpu->Fifo[Mpu->FifoHead];
+			Mpu->FifoHead = (Mpu->FifoHead + 1) % EMU_MPU6050_FIFO_SIZE;
+			Mpu->FifoCount--;
+		}
+	}
+	else
+	{
+		value = Mpu->Reg[reg];
+	}
+
+	// INT_RD_CLEAR = 1 时任意读操作都清除中断状态
+	if(Mpu->Reg[INT_PIN_CFG] & 0x10) Mpu->Reg[INT_STATUS] = 0;
+
+	if(reg != FIFO_R_W) Mpu->Ptr = (Mpu->Ptr + 1) & 0x7f;
+
+	return value;
+}
+
+static void Stop(void *Dev)
+{
+	Emu_MPU6050_TypeDef *Mpu = Dev;
+	Mpu->State = MPU_IDLE;
+}
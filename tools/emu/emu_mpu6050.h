@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    emu_mpu6050.h
+  * @version V 1.0.0
+  * @brief   寄存器层面的MPU6050仿真
+  *          实现0x19..0x48的配置和数据寄存器、中断状态、FIFO及其计数、
+  *          电源管理（复位、睡眠）和WHO_AM_I。采样时刻由SMPLRT_DIV和DLPF_CFG决定，
+  *          每个采样时刻调用用户提供的函数获取物理量，按量程换算后写入数据寄存器，
+  *          并按FIFO_EN写入FIFO。与芯片一致，连续读（突发读）期间数据寄存器的值
+  *          保持为读事务开始时的快照，分多次单字节读取则可能跨越两次采样
+  ******************************************************************************
+  */
+
+#ifndef EMU_MPU6050_H
+#define EMU_MPU6050_H
+
+#include <stdint.h>
+#include "emu.h"
+
+#define EMU_MPU6050_FIFO_SIZE 1024
+
+//
+// @简介：获取采样时刻的物理量
+// @参数：T - 采样时刻，单位s
+// @参数：Accel - 输出参数，加速度，单位g
+// @参数：Gyro - 输出参数，角速度，单位°/s
+// @参数：pTemp - 输出参数，温度，单位℃
+//
+typedef void (*Emu_MPU6050_SampleFunc)(void *Ctx, double T, float Accel[3], float Gyro[3], float *pTemp);
+
+typedef struct
+{
+	uint8_t Reg[128];
+	uint8_t Shadow[0x61 - 0x3b];  // 读事务开始时锁存的0x3B..0x60
+	uint32_t ShadowIndex;         // 快照对应的采样序号
+
+	uint8_t Fifo[EMU_MPU6050_FIFO_SIZE];
+	uint16_t FifoHead, FifoCount;
+
+	uint64_t NextSample;          // 下一次采样的时刻，CPU周期
+	uint32_t SampleIndex;         // 已完成的采样次数
+
+	uint8_t Ptr;                  // 寄存器指针
+	uint8_t State;                // 当前事务的阶段
+
+	Emu_MPU6050_SampleFunc Sample;
+	void *Ctx;
+
+	// 统计
+	uint32_t Transactions;
+	uint32_t Pairs;               // 读取的16位数据（高低字节各读一次）
+	uint32_t Torn;                // 高低字节来自不同采样的16位数据
+	uint32_t Overflows;           // FIFO溢出丢弃的字节
+	uint32_t Underflows;          // FIFO为空时读取的字节
+	uint32_t LastTxn[14];         // 0x3B..0x48每个寄存器最近一次被读取时的事务序号
+	uint32_t LastIndex[14];       // 以及当时的采样序号
+} Emu_MPU6050_TypeDef;
+
+   void Emu_MPU6050_Init(Emu_MPU6050_TypeDef *Mpu, Emu_MPU6050_SampleFunc Sample, void *Ctx);
+   void Emu_MPU6050_Slave(Emu_MPU6050_TypeDef *Mpu, Emu_I2CSlaveTypeDef *Slave);
+   void Emu_MPU6050_Update(Emu_MPU6050_TypeDef *Mpu);
+ double Emu_MPU6050_SampleRate(const Emu_MPU6050_TypeDef *Mpu);
+  float Emu_MPU6050_AccelLsb(const Emu_MPU6050_TypeDef *Mpu);
+  float Emu_MPU6050_GyroLsb(const Emu_MPU6050_TypeDef *Mpu);
+
+#endif
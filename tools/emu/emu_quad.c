@@ -0,0 +1,166 @@
+/**
+  ******************************************************************************
+  * @file    emu_quad.c
+  * @version V 1.0.0
+  * @brief   增量式编码器（A、B两相正交信号）的仿真
+  ******************************************************************************
+  */
+
+#include "emu_quad.h"
+#include <math.h>
+
+//
+// @简介：位置P处A、B两相的电平
+// @参数：Dir - 运动方向，边沿恰好位于P处时取运动之后的电平
+//
+static void Levels(const Emu_Quad_TypeDef *Quad, double P, int Dir, uint8_t *pA, uint8_t *pB)
+{
+	P += Dir * 1e-9;
+
+	double fa = P - floor(P);
+	double fb = P + Quad->Init.Phase - floor(P + Quad->Init.Phase);
+
+	*pA = fa < Quad->Init.Duty;
+	*pB = fb < 0.5;
+}
+
+//
+// @简介：标准正态分布的随机数（xorshift32 + Box-Muller）
+//
+static double Gauss(Emu_Quad_TypeDef *Quad)
+{
+	double u[2];
+
+	for(int i=0; i<2; i++)
+	{
+		Quad->Rng ^= Quad->Rng << 13;
+		Quad->Rng ^= Quad->Rng >> 17;
+		Quad->Rng ^= Quad->Rng << 5;
+		u[i] = (Quad->Rng + 1.0) / 4294967297.0;
+	}
+
+	return sqrt(-2 * log(u[0])) * cos(2 * M_PI * u[1]);
+}
+
+//
+// @简介：从当前的理想位置出发，找出运动方向上的下一个边沿
+//
+static void Schedule(Emu_Quad_TypeDef *Quad)
+{
+	if(Quad->Speed == 0)
+	{
+		Quad->NextAt = UINT64_MAX;
+		return;
+	}
+
+	// 一个周期内的4个边沿位置
+	double phase = Quad->Init.Phase - floor(Quad->Init.Phase);
+	double edges[4] = {0, Quad->Init.Duty, 1 - phase, 1.5 - phase};
+
+	double base = floor(Quad->Pos);
+	double best = Quad->Speed > 0 ? INFINITY : -INFINITY;
+
+	for(int k=-1; k<=1; k++)
+	{
+		for(int i=0; i<4; i++)
+		{
+			double e = base + k + edges[i] - floor(edges[i]);
+
+			if(Quad->Speed > 0 && e > Quad->Pos + 1e-9 && e < best) best = e;
+			if(Quad->Speed < 0 && e < Quad->Pos - 1e-9 && e > best) best = e;
+		}
+	}
+
+	double dt = (best - Quad->Pos) / Quad->Speed * EMU_CPU_HZ;
+	double jitter = Gauss(Quad) * Quad->Init.JitterUs * (EMU_CPU_HZ / 1000000);
+
+	Quad->NextPos = best;
+	Quad->NextIdeal = Quad->T0 + (uint64_t)(dt + 0.5);
+
+	double at = (double)Quad->NextIdeal + jitter;
+
+	// 保持边沿的先后顺序
+	if(at <= (double)Quad->LastAt) at = (double)Quad->LastAt + 1;
+	if(at <= (double)emu.Cycles) at = (double)emu.Cycles + 1;
+
+	Quad->NextAt = (uint64_t)at;
+}
+
+static uint64_t Next(void *Ctx)
+{
+	return ((Emu_Quad_TypeDef *)Ctx)->NextAt;
+}
+
+static void Fire(void *Ctx)
+{
+	Emu_Quad_TypeDef *Quad = Ctx;
+	int dir = Quad->Speed > 0 ? 1 : -1;
+	uint8_t a, b;
+
+	Quad->Pos = Quad->NextPos;
+	Quad->T0 = Quad->NextIdeal;
+	Quad->LastAt = Quad->NextAt;
+
+	Levels(Quad, Quad->Pos, dir, &a, &b);
+
+	Schedule(Quad);
+
+	// 与引脚的当前电平比较（改变速度时可能合并了一个尚未发生的边沿）
+	if(a != Quad->A)
+	{
+		Quad->A = a;
+		Quad->EdgesA += (a == Quad->B) ? 1 : -1; // 与驱动的判断相同
+		Emu_SetInput(Quad->Init.GPIOx, Quad->Init.A_Pin, a);
+	}
+
+	if(b != Quad->B)
+	{
+		Quad->B = b;
+		Quad->EdgesB++;
+		Emu_SetInput(Quad->Init.GPIOx, Quad->Init.B_Pin, b);
+	}
+}
+
+//
+// @简介：初始化编码器仿真，位置为0，静止，并登记为仿真器的信号源
+//
+void Emu_Quad_Init(Emu_Quad_TypeDef *Quad, Emu_Quad_InitTypeDef *Quad_InitStruct)
+{
+	Quad->Init = *Quad_InitStruct;
+	Quad->Pos = 0.1; // 避开边沿
+	Quad->T0 = emu.Cycles;
+	Quad->Speed = 0;
+	Quad->NextAt = UINT64_MAX;
+	Quad->LastAt = 0;
+	Quad->Rng = Quad_InitStruct->Seed ? Quad_InitStruct->Seed : 1;
+	Quad->EdgesA = 0;
+	Quad->EdgesB = 0;
+
+	Levels(Quad, Quad->Pos, 1, &Quad->A, &Quad->B);
+
+	Emu_SetInput(Quad->Init.GPIOx, Quad->Init.A_Pin, Quad->A);
+	Emu_SetInput(Quad->Init.GPIOx, Quad->Init.B_Pin, Quad->B);
+
+	Emu_AddSource(Next, Fire, Quad);
+}
+
+//
+// @简介：当前时刻的理想位置，单位周期
+//
+double Emu_Quad_GetPos(Emu_Quad_TypeDef *Quad)
+{
+	return Quad->Pos + Quad->Speed * ((double)emu.Cycles - (double)Quad->T0) / EMU_CPU_HZ;
+}
+
+//
+// @简介：从当前时刻开始以新的速度运动
+// @参数：CyclesPerSec - 速度，单位周期/s，负数表示反转
+//
+void Emu_Quad_SetSpeed(Emu_Quad_TypeDef *Quad, double CyclesPerSec)
+{
+	Quad->Pos = Emu_Quad_GetPos(Quad);
+	Quad->T0 = emu.Cycles;
+	Quad->Speed = CyclesPerSec;
+
+	Schedule(Quad);
+}
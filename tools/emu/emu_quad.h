@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    emu_quad.h
+  * @version V 1.0.0
+  * @brief   增量式编码器（A、B两相正交信号）的仿真
+  *          位置以编码器周期为单位，速度分段恒定。A相为高的部分占每个周期的Duty，
+  *          B相为50%占空比，相位领先A相Phase个周期，因此正转时A相上升沿处B相为高、
+  *          下降沿处B相为低，与app_encoder.c的约定一致。
+  *          每个边沿的时刻叠加高斯抖动（保持边沿的先后顺序），经Emu_SetInput送到引脚，
+  *          由EXTI触发驱动的中断响应函数
+  ******************************************************************************
+  */
+
+#ifndef EMU_QUAD_H
+#define EMU_QUAD_H
+
+#include <stdint.h>
+#include "emu.h"
+
+typedef struct
+{
+	GPIO_TypeDef *GPIOx;  // A、B两相所在的端口
+	uint16_t A_Pin;
+	uint16_t B_Pin;
+	float Duty;           // A相占空比（磁钢或码盘不对称），理想值0.5
+	float Phase;          // B相领先A相的相位，单位周期，理想值0.25
+	float JitterUs;       // 边沿时刻抖动的标准差，单位us
+	uint32_t Seed;        // 抖动的随机数种子，不能为0
+} Emu_Quad_InitTypeDef;
+
+typedef struct
+{
+	Emu_Quad_InitTypeDef Init;
+
+	double Pos;           // T0时刻的位置，单位周期
+	uint64_t T0;
+	double Speed;         // 速度，单位周期/s
+
+	double NextPos;       // 下一个边沿的位置
+	uint64_t NextIdeal;   // 下一个边沿的理想时刻
+	uint64_t NextAt;      // 下一个边沿叠加抖动后的时刻，UINT64_MAX表示没有
+	uint64_t LastAt;      // 上一个边沿的时刻
+	uint8_t A, B;         // 引脚的当前电平
+
+	uint32_t Rng;
+
+	// 统计
+	int32_t EdgesA;       // A相边沿数，按边沿处B相的电平判断方向，正转加一、反转减一
+	uint32_t EdgesB;
+} Emu_Quad_TypeDef;
+
+  void Emu_Quad_Init(Emu_Quad_TypeDef *Quad, Emu_Quad_InitTypeDef *Quad_InitStruct);
+  void Emu_Quad_SetSpeed(Emu_Quad_TypeDef *Quad, double CyclesPerSec);
+double Emu_Quad_GetPos(Emu_Quad_TypeDef *Quad);
+
+#endif
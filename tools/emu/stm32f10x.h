@@ -0,0 +1,268 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   驱动仿真用的替身头文件
+  *          在电脑上编译驱动代码（si2c.c、i2c.c、app_mpu6050.c、app_encoder.c）时
+  *          代替std_periph_driver/inc/stm32f10x.h，提供驱动用到的GPIO、EXTI、NVIC、
+  *          I2C和RCC接口，这些接口由emu.c和emu_i2c.c在寄存器行为的层面上实现，
+  *          常数的取值与标准库一致；外设句柄都是不透明指针，驱动无法绕过接口直接访问寄存器
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+
+#define __IO volatile
+#define __STATIC_INLINE static inline
+#define __weak __attribute__((weak))
+
+// 中断屏蔽，解除屏蔽时立即响应挂起的中断
+void __disable_irq(void);
+void __enable_irq(void);
+
+//
+// 外设句柄
+//
+typedef struct Emu_GPIO_TypeDef GPIO_TypeDef;
+typedef struct Emu_I2C_TypeDef I2C_TypeDef;
+typedef struct USART_TypeDef USART_TypeDef;
+typedef struct TIM_TypeDef TIM_TypeDef;
+typedef struct DMA_Channel_TypeDef DMA_Channel_TypeDef;
+
+extern GPIO_TypeDef Emu_GPIOA, Emu_GPIOB, Emu_GPIOC, Emu_GPIOD;
+extern I2C_TypeDef Emu_I2C1, Emu_I2C2;
+
+#define GPIOA (&Emu_GPIOA)
+#define GPIOB (&Emu_GPIOB)
+#define GPIOC (&Emu_GPIOC)
+#define GPIOD (&Emu_GPIOD)
+#define I2C1  (&Emu_I2C1)
+#define I2C2  (&Emu_I2C2)
+
+//
+// RCC
+//
+#define RCC_APB2Periph_AFIO  0x00000001
+#define RCC_APB2Periph_GPIOA 0x00000004
+#define RCC_APB2Periph_GPIOB 0x00000008
+#define RCC_APB2Periph_GPIOC 0x00000010
+#define RCC_APB2Periph_GPIOD 0x00000020
+#define RCC_APB1Periph_I2C1  0x00200000
+#define RCC_APB1Periph_I2C2  0x00400000
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState);
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState);
+
+//
+// GPIO
+//
+#define GPIO_Pin_0  ((uint16_t)0x0001)
+#define GPIO_Pin_1  ((uint16_t)0x0002)
+#define GPIO_Pin_2  ((uint16_t)0x0004)
+#define GPIO_Pin_3  ((uint16_t)0x0008)
+#define GPIO_Pin_4  ((uint16_t)0x0010)
+#define GPIO_Pin_5  ((uint16_t)0x0020)
+#define GPIO_Pin_6  ((uint16_t)0x0040)
+#define GPIO_Pin_7  ((uint16_t)0x0080)
+#define GPIO_Pin_8  ((uint16_t)0x0100)
+#define GPIO_Pin_9  ((uint16_t)0x0200)
+#define GPIO_Pin_10 ((uint16_t)0x0400)
+#define GPIO_Pin_11 ((uint16_t)0x0800)
+#define GPIO_Pin_12 ((uint16_t)0x1000)
+#define GPIO_Pin_13 ((uint16_t)0x2000)
+#define GPIO_Pin_14 ((uint16_t)0x4000)
+#define GPIO_Pin_15 ((uint16_t)0x8000)
+
+typedef enum
+{
+	GPIO_Speed_10MHz = 1,
+	GPIO_Speed_2MHz,
+	GPIO_Speed_50MHz
+} GPIOSpeed_TypeDef;
+
+typedef enum
+{
+	GPIO_Mode_AIN = 0x0,
+	GPIO_Mode_IN_FLOATING = 0x04,
+	GPIO_Mode_IPD = 0x28,
+	GPIO_Mode_IPU = 0x48,
+	GPIO_Mode_Out_OD = 0x14,
+	GPIO_Mode_Out_PP = 0x10,
+	GPIO_Mode_AF_OD = 0x1C,
+	GPIO_Mode_AF_PP = 0x18
+} GPIOMode_TypeDef;
+
+typedef enum
+{
+	Bit_RESET = 0,
+	Bit_SET
+} BitAction;
+
+typedef struct
+{
+	uint16_t GPIO_Pin;
+	GPIOSpeed_TypeDef GPIO_Speed;
+	GPIOMode_TypeDef GPIO_Mode;
+} GPIO_InitTypeDef;
+
+#define GPIO_PortSourceGPIOA 0x00
+#define GPIO_PortSourceGPIOB 0x01
+#define GPIO_PortSourceGPIOC 0x02
+#define GPIO_PortSourceGPIOD 0x03
+
+#define GPIO_PinSource0  0x00
+#define GPIO_PinSource1  0x01
+#define GPIO_PinSource2  0x02
+#define GPIO_PinSource3  0x03
+#define GPIO_PinSource4  0x04
+#define GPIO_PinSource5  0x05
+#define GPIO_PinSource6  0x06
+#define GPIO_PinSource7  0x07
+#define GPIO_PinSource8  0x08
+#define GPIO_PinSource9  0x09
+#define GPIO_PinSource10 0x0A
+#define GPIO_PinSource11 0x0B
+#define GPIO_PinSource12 0x0C
+#define GPIO_PinSource13 0x0D
+#define GPIO_PinSource14 0x0E
+#define GPIO_PinSource15 0x0F
+
+#define GPIO_Remap_I2C1            ((uint32_t)0x00000002)
+#define GPIO_Remap_SWJ_JTAGDisable ((uint32_t)0x00300200)
+
+   void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+   void GPIO_WriteBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, BitAction BitVal);
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+   void GPIO_EXTILineConfig(uint8_t GPIO_PortSource, uint8_t GPIO_PinSource);
+   void GPIO_PinRemapConfig(uint32_t GPIO_Remap, FunctionalState NewState);
+
+//
+// EXTI
+//
+#define EXTI_Line0  ((uint32_t)0x00001)
+#define EXTI_Line1  ((uint32_t)0x00002)
+#define EXTI_Line2  ((uint32_t)0x00004)
+#define EXTI_Line3  ((uint32_t)0x00008)
+#define EXTI_Line4  ((uint32_t)0x00010)
+#define EXTI_Line5  ((uint32_t)0x00020)
+#define EXTI_Line6  ((uint32_t)0x00040)
+#define EXTI_Line7  ((uint32_t)0x00080)
+#define EXTI_Line8  ((uint32_t)0x00100)
+#define EXTI_Line9  ((uint32_t)0x00200)
+#define EXTI_Line10 ((uint32_t)0x00400)
+#define EXTI_Line11 ((uint32_t)0x00800)
+#define EXTI_Line12 ((uint32_t)0x01000)
+#define EXTI_Line13 ((uint32_t)0x02000)
+#define EXTI_Line14 ((uint32_t)0x04000)
+#define EXTI_Line15 ((uint32_t)0x08000)
+
+typedef enum
+{
+	EXTI_Mode_Interrupt = 0x00,
+	EXTI_Mode_Event = 0x04
+} EXTIMode_TypeDef;
+
+typedef enum
+{
+	EXTI_Trigger_Rising = 0x08,
+	EXTI_Trigger_Falling = 0x0C,
+	EXTI_Trigger_Rising_Falling = 0x10
+} EXTITrigger_TypeDef;
+
+typedef struct
+{
+	uint32_t EXTI_Line;
+	EXTIMode_TypeDef EXTI_Mode;
+	EXTITrigger_TypeDef EXTI_Trigger;
+	FunctionalState EXTI_LineCmd;
+} EXTI_InitTypeDef;
+
+      void EXTI_Init(EXTI_InitTypeDef *EXTI_InitStruct);
+FlagStatus EXTI_GetFlagStatus(uint32_t EXTI_Line);
+      void EXTI_ClearFlag(uint32_t EXTI_Line);
+  ITStatus EXTI_GetITStatus(uint32_t EXTI_Line);
+      void EXTI_ClearITPendingBit(uint32_t EXTI_Line);
+
+//
+// NVIC
+//
+typedef enum
+{
+	EXTI0_IRQn = 6,
+	EXTI1_IRQn = 7,
+	EXTI2_IRQn = 8,
+	EXTI3_IRQn = 9,
+	EXTI4_IRQn = 10,
+	EXTI9_5_IRQn = 23,
+	I2C1_EV_IRQn = 31,
+	I2C1_ER_IRQn = 32,
+	I2C2_EV_IRQn = 33,
+	I2C2_ER_IRQn = 34,
+	EXTI15_10_IRQn = 40
+} IRQn_Type;
+
+typedef struct
+{
+	uint8_t NVIC_IRQChannel;
+	uint8_t NVIC_IRQChannelPreemptionPriority;
+	uint8_t NVIC_IRQChannelSubPriority;
+	FunctionalState NVIC_IRQChannelCmd;
+} NVIC_InitTypeDef;
+
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct);
+
+//
+// I2C
+//
+typedef struct
+{
+	uint32_t I2C_ClockSpeed;
+	uint16_t I2C_Mode;
+	uint16_t I2C_DutyCycle;
+	uint16_t I2C_OwnAddress1;
+	uint16_t I2C_Ack;
+	uint16_t I2C_AcknowledgedAddress;
+} I2C_InitTypeDef;
+
+#define I2C_Mode_I2C                  ((uint16_t)0x0000)
+#define I2C_DutyCycle_2               ((uint16_t)0xBFFF)
+#define I2C_Ack_Enable                ((uint16_t)0x0400)
+#define I2C_Ack_Disable               ((uint16_t)0x0000)
+#define I2C_AcknowledgedAddress_7bit  ((uint16_t)0x4000)
+
+#define I2C_IT_BUF ((uint16_t)0x0400)
+#define I2C_IT_EVT ((uint16_t)0x0200)
+#define I2C_IT_ERR ((uint16_t)0x0100)
+
+#define I2C_Register_SR1 ((uint8_t)0x14)
+#define I2C_Register_SR2 ((uint8_t)0x18)
+
+#define I2C_FLAG_BUSY ((uint32_t)0x00020000)
+#define I2C_FLAG_SB   ((uint32_t)0x10000001)
+#define I2C_FLAG_ADDR ((uint32_t)0x10000002)
+#define I2C_FLAG_BTF  ((uint32_t)0x10000004)
+#define I2C_FLAG_RXNE ((uint32_t)0x10000040)
+#define I2C_FLAG_TXE  ((uint32_t)0x10000080)
+#define I2C_FLAG_AF   ((uint32_t)0x10000400)
+#define I2C_FLAG_ARLO ((uint32_t)0x10000200)
+#define I2C_FLAG_BERR ((uint32_t)0x10000100)
+
+      void I2C_Init(I2C_TypeDef *I2Cx, I2C_InitTypeDef *I2C_InitStruct);
+      void I2C_Cmd(I2C_TypeDef *I2Cx, FunctionalState NewState);
+      void I2C_ITConfig(I2C_TypeDef *I2Cx, uint16_t I2C_IT, FunctionalState NewState);
+FlagStatus I2C_GetFlagStatus(I2C_TypeDef *I2Cx, uint32_t I2C_FLAG);
+      void I2C_ClearFlag(I2C_TypeDef *I2Cx, uint32_t I2C_FLAG);
+      void I2C_GenerateSTART(I2C_TypeDef *I2Cx, FunctionalState NewState);
+      void I2C_GenerateSTOP(I2C_TypeDef *I2Cx, FunctionalState NewState);
+      void I2C_AcknowledgeConfig(I2C_TypeDef *I2Cx, FunctionalState NewState);
+      void I2C_SendData(I2C_TypeDef *I2Cx, uint8_t Data);
+   uint8_t I2C_ReceiveData(I2C_TypeDef *I2Cx);
+  uint16_t I2C_ReadRegister(I2C_TypeDef *I2Cx, uint8_t I2C_Register);
+
+#endif
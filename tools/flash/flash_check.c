@@ -0,0 +1,364 @@
+/**
+  ******************************************************************************
+  * @file    flash_check.c
+  * @version V 1.0.0
+  * @brief   user/app_flash.c的掉电检查
+  *          在Page126和Page127的实际地址上映射一块内存作为Flash，按STM32F1的行为实现编程和擦除：
+  *          只能把擦除状态（0xFFFF）的半字写成其他值或把任意半字写成0，擦除把整页置为0xFF；
+  *          CRC按CRC单元的算法（多项式0x04C11DB7，逐字）计算。
+  *          随机地保存和删除各个键，每一步先完整地执行一遍，数出擦除和编程半字的次数，
+  *          然后从同一个Flash内容出发，依次在每一次操作处掉电：
+  *          1. 编程某个半字时掉电，这个半字没有写入或只写入了一部分位
+  *          2. 回收时擦除另一页之后掉电，以及擦除进行到一半时掉电（部分位变为1）
+  *          每次掉电后重新上电（清除app_flash.c的静态变量后调用App_Flash_Init），
+  *          每个键读到的必须是这一步之前的值或这一步要写的值（其他键必须是之前的值），不能是其他内容；
+  *          之后重新保存这个值，结果必须与没有掉电时相同，再次上电后仍然读到
+  *          直接包含app_flash.c，以便模拟上电时清除它的静态变量
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -Wno-int-to-pointer-cast -o flash_check -Itools/flash -Iuser tools/flash/flash_check.c
+  *
+  *          使用：./flash_check [-n 步数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <sys/mman.h>
+#include "app_flash.c"
+
+#define STORE_BASE FLASH_STORE_PAGE0
+#define STORE_SIZE (2 * FLASH_STORE_PAGE_SIZE)
+
+#define CUT_NONE (-1L)
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void Check(int Ok, const char *What, unsigned long A, unsigned long B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %lu, expected %lu\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 模拟的硬件
+//////////////////////////////////////////////////////////////////////////
+
+static uint8_t locked = 1;
+static long events = 0; // 本次上电以来擦除和编程半字的次数
+static long cutAt = CUT_NONE; // 在第几次操作时掉电
+static int cutMode = 0; // 0 - 操作没有进行（擦除则为刚好完成），1 - 操作进行了一部分
+static jmp_buf powerCut;
+static uint32_t crc;
+
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState)
+{
+	(void)RCC_AHBPeriph;
+	(void)NewState;
+}
+
+void FLASH_Unlock(void)
+{
+	locked = 0;
+}
+
+void FLASH_Lock(void)
+{
+	locked = 1;
+}
+
+void FLASH_ClearFlag(uint32_t FLASH_FLAG)
+{
+	(void)FLASH_FLAG;
+}
+
+FLASH_Status FLASH_ErasePage(uint32_t Page_Address)
+{
+	Check(!locked, "erase while locked", Page_Address, 0);
+	Check((Page_Address == FLASH_STORE_PAGE0 || Page_Address == FLASH_STORE_PAGE1), "erase address", Page_Address, FLASH_STORE_PAGE0);
+
+	if(locked) return FLASH_ERROR_WRP;
+
+	uint8_t *p = (uint8_t *)Page_Address;
+
+	if(events++ == cutAt)
+	{
+		if(cutMode == 0)
+		{
+			memset(p, 0xff, FLASH_STORE_PAGE_SIZE);
+		}
+		else
+		{
+			for(uint16_t i=0; i<FLASH_STORE_PAGE_SIZE; i++) p[i] |= Rand() & Rand(); // 约1/4的位已经变为1
+		}
+
+		longjmp(powerCut, 1);
+	}
+
+	memset(p, 0xff, FLASH_STORE_PAGE_SIZE);
+
+	return FLASH_COMPLETE;
+}
+
+FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data)
+{
+	Check(!locked, "program while locked", Address, 0);
+	Check(Address >= STORE_BASE && Address + 2 <= STORE_BASE + STORE_SIZE && Address % 2 == 0, "program address", Address, STORE_BASE);
+
+	if(locked) return FLASH_ERROR_WRP;
+
+	uint16_t *p = (uint16_t *)Address;
+
+	if(*p != 0xffff && Data != 0) return FLASH_ERROR_PG; // 只能写擦除状态的半字，写0除外
+
+	if(events++ == cutAt)
+	{
+		if(cutMode == 1)
+		{
+			*p &= ~((uint16_t)~Data & Rand()); // 要写成0的位只有一部分写成了0
+		}
+
+		longjmp(powerCut, 1);
+	}
+
+	*p &= Data;
+
+	return FLASH_COMPLETE;
+}
+
+void CRC_ResetDR(void)
+{
+	crc = 0xffffffff;
+}
+
+uint32_t CRC_CalcBlockCRC(uint32_t pBuffer[], uint32_t BufferLength)
+{
+	for(uint32_t i=0; i<BufferLength; i++)
+	{
+		crc ^= pBuffer[i];
+
+		for(int bit=0; bit<32; bit++)
+		{
+			crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+//
+// @简介：重新上电，Flash的内容不变，RAM清零
+//
+static void PowerOn(void)
+{
+	locked = 1;
+	events = 0;
+	cutAt = CUT_NONE;
+
+	active = 0;
+	generation = 0;
+	tail = FLASH_STORE_PAGE_SIZE;
+	memset(keyIndex, 0, sizeof(keyIndex));
+	initialized = 0;
+
+	App_Flash_Init();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 期望值
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	int len[APP_FLASH_MAX_KEYS]; // -1表示没有保存过
+	uint8_t data[APP_FLASH_MAX_KEYS][APP_FLASH_MAX_SIZE];
+} Store_t;
+
+static int SameValue(const Store_t *pStore, uint8_t Key, int Len, const uint8_t *pData)
+{
+	return Len == pStore->len[Key] && (Len <= 0 || memcmp(pData, pStore->data[Key], Len) == 0);
+}
+
+//
+// @简介：读出每个键，与Old或New比较；New为NULL时只能是Old
+//
+static void Verify(const char *What, const Store_t *pOld, const Store_t *pNew)
+{
+	for(uint8_t key=1; key<APP_FLASH_MAX_KEYS; key++)
+	{
+		uint8_t data[APP_FLASH_MAX_SIZE];
+		int len = App_Flash_Read(key, data, sizeof(data));
+
+		int ok = SameValue(pOld, key, len, data) || (pNew != NULL && SameValue(pNew, key, len, data));
+
+		Check(ok, What, len, pOld->len[key]);
+	}
+}
+
+//
+// @简介：执行一次保存或删除，Size为0表示删除
+//
+static int Apply(uint8_t Key, const uint8_t *pData, uint16_t Size)
+{
+	return (Size > 0) ? App_Flash_Write(Key, pData, Size) : App_Flash_Delete(Key);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 检查
+//////////////////////////////////////////////////////////////////////////
+
+static unsigned long cuts = 0, collects = 0;
+
+static void Step(Store_t *pStore, uint8_t *pImage)
+{
+	// #1. 随机选一个键，多数为保存，少数为删除，偶尔与已保存的值相同
+	uint8_t key = 1 + Rand() % (APP_FLASH_MAX_KEYS - 1);
+	uint8_t data[APP_FLASH_MAX_SIZE];
+	volatile uint16_t size = 0; // 掉电时经longjmp回到本函数，之后仍要使用
+
+	if(Rand() % 8 != 0)
+	{
+		if(pStore->len[key] > 0 && Rand() % 8 == 0)
+		{
+			size = pStore->len[key];
+			memcpy(data, pStore->data[key], size);
+		}
+		else
+		{
+			size = 1 + Rand() % APP_FLASH_MAX_SIZE;
+
+			for(uint16_t i=0; i<size; i++) data[i] = Rand();
+		}
+	}
+
+	// #2. 不掉电执行一遍，数出操作次数
+	memcpy((void *)STORE_BASE, pImage, STORE_SIZE);
+	PowerOn();
+
+	uint32_t gen = generation;
+	int ret = Apply(key, data, size);
+	long total = events;
+
+	Store_t next = *pStore;
+
+	if(ret == 0)
+	{
+		next.len[key] = (size > 0) ? size : -1;
+		memcpy(next.data[key], data, size);
+	}
+
+	Verify("write", &next, NULL);
+
+	PowerOn();
+	Verify("write, power on", &next, NULL);
+
+	if(generation != gen) collects++;
+
+	uint8_t after[STORE_SIZE];
+	memcpy(after, (const void *)STORE_BASE, STORE_SIZE);
+
+	// #3. 在每一次操作处掉电
+	for(long cut=0; cut<total; cut++)
+	{
+		for(int mode=0; mode<2; mode++)
+		{
+			memcpy((void *)STORE_BASE, pImage, STORE_SIZE);
+			PowerOn();
+
+			cutAt = cut;
+			cutMode = mode;
+
+			if(setjmp(powerCut) == 0)
+			{
+				Apply(key, data, size);
+				Check(0, "power cut not reached", cut, total);
+				continue;
+			}
+
+			cuts++;
+
+			PowerOn();
+			Verify("after power cut", pStore, &next);
+
+			// 重新保存，结果与没有掉电时相同，并且之后上电仍然有效
+			int again = Apply(key, data, size);
+
+			Check(again == ret, "write after power cut", again, ret);
+			Verify("write after power cut", &next, NULL);
+
+			PowerOn();
+			Verify("write after power cut, power on", &next, NULL);
+		}
+	}
+
+	*pStore = next;
+	memcpy(pImage, after, STORE_SIZE);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 400;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n steps] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// 在两页的实际地址上映射内存，app_flash.c按绝对地址访问
+	uintptr_t base = STORE_BASE & ~(uintptr_t)0xfff;
+	size_t length = (STORE_BASE + STORE_SIZE - base + 0xfff) & ~(size_t)0xfff;
+	void *map = mmap((void *)base, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+	if(map != (void *)base)
+	{
+		fprintf(stderr, "cannot map flash at 0x%08lx\n", (unsigned long)base);
+		return 1;
+	}
+
+	// 出厂时两页都是擦除状态
+	static uint8_t image[STORE_SIZE];
+	Store_t store;
+
+	memset(image, 0xff, sizeof(image));
+
+	for(uint8_t key=0; key<APP_FLASH_MAX_KEYS; key++) store.len[key] = -1;
+
+	for(unsigned long i=0; i<n; i++)
+	{
+		Step(&store, image);
+	}
+
+	printf("%lu power cuts, %lu collects\n", cuts, collects);
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
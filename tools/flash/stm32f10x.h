@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   参数存储检查用的替身头文件
+  *          在电脑上编译user/app_flash.c时代替std_periph_driver/inc/stm32f10x.h，
+  *          只提供app_flash.c用到的Flash、CRC和RCC的类型、常数和函数，
+  *          函数由flash_check.c按硬件的行为实现（只能把1写成0、半字编程、整页擦除）
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+
+//
+// RCC
+//
+#define RCC_AHBPeriph_CRC ((uint32_t)0x00000040)
+
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState);
+
+//
+// FLASH
+//
+typedef enum
+{
+	FLASH_BUSY = 1,
+	FLASH_ERROR_PG,
+	FLASH_ERROR_WRP,
+	FLASH_COMPLETE,
+	FLASH_TIMEOUT
+} FLASH_Status;
+
+#define FLASH_FLAG_BSY      ((uint32_t)0x00000001)
+#define FLASH_FLAG_EOP      ((uint32_t)0x00000020)
+#define FLASH_FLAG_PGERR    ((uint32_t)0x00000004)
+#define FLASH_FLAG_WRPRTERR ((uint32_t)0x00000010)
+
+        void FLASH_Unlock(void);
+        void FLASH_Lock(void);
+        void FLASH_ClearFlag(uint32_t FLASH_FLAG);
+FLASH_Status FLASH_ErasePage(uint32_t Page_Address);
+FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data);
+
+//
+// CRC
+//
+    void CRC_ResetDR(void);
+uint32_t CRC_CalcBlockCRC(uint32_t pBuffer[], uint32_t BufferLength);
+
+#endif
@@ -0,0 +1,252 @@
+/**
+  ******************************************************************************
+  * @file    fmt_check.c
+  * @version V 1.0.0
+  * @brief   my_lib/fmt.c的一致性检查和耗时对比
+  *          1. 一致性：固定的用例表加随机生成的格式和数值，逐一与C库的snprintf比较输出，
+  *             %f的实参先转换为float（与单片机上的用法一致），不一致时打印用例
+  *          2. 耗时：几种典型的格式各运行若干次，比较Fmt_Format与snprintf每次调用的CPU周期数
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o fmt_check -Imy_lib tools/fmt/fmt_check.c my_lib/fmt.c
+  *
+  *          使用：./fmt_check [-n 随机用例数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  *
+  *          代码体积：电脑上的数字没有参考价值，以Keil的map文件为准，
+  *          对比改用Fmt_VFormat前后Image component sizes中的Code和RO Data
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <float.h>
+#include <math.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "fmt.h"
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static uint64_t Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+//
+// @简介：用同样的参数分别调用两个实现并比较，包括返回值（截断时比较写入的字符数）
+//
+static void Check(uint16_t Size, const char *Format, ...)
+{
+	char a[256], b[256];
+	va_list args;
+
+	va_start(args, Format);
+	int na = Fmt_VFormat(a, Size, Format, args);
+	va_end(args);
+
+	va_start(args, Format);
+	int nb = vsnprintf(b, Size, Format, args);
+	va_end(args);
+
+	if(nb >= Size) nb = Size > 0 ? Size - 1 : 0;
+
+	checks++;
+
+	if(na != nb || (Size > 0 && strcmp(a, b) != 0))
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH fmt \"%s\" size %u: got \"%s\" (%d), libc \"%s\" (%d)\n", Format, Size, a, na, b, nb);
+		}
+
+		failures++;
+	}
+}
+
+static float RandFloat(void)
+{
+	union { float f; uint32_t u; } v;
+
+	switch(Rand() % 6)
+	{
+		case 0: v.u = Rand() ^ (Rand() << 16); return v.f;                   // 任意位模式，含nan、inf、非规格化数
+		case 1: return (float)((int32_t)Rand() % 2000) / 8.0f;               // 恰为一半的舍入
+		case 2: return ((float)Rand() / 65536.0f - 32768.0f) / 1000.0f;
+		case 3: return (float)((int32_t)Rand() % 100000) * 0.001f;
+		case 4: return ldexpf((float)(Rand() & 0xffffff), (int)(Rand() % 60) - 40);
+		default: return ((float)Rand() - 2147483648.0f) * 1e-6f;
+	}
+}
+
+static void Table(void)
+{
+	const float fv[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 1.5f, 2.5f, 0.125f, 0.375f, 3.14159265f, -2.71828f,
+	                    1e-10f, 123456.789f, 16777216.0f, 1e20f, -1e30f, FLT_MAX, FLT_MIN, 1e-45f, 0.05f,
+	                    9.9999995f, 0.999999f, INFINITY, -INFINITY, NAN};
+	const char *ff[] = {"%f", "%.0f", "%.1f", "%.2f", "%.3f", "%.9f", "%8.2f", "%-8.2f|", "%08.2f", "%+.2f",
+	                    "% .2f", "%+08.3f", "%10f", "%-12.4f|"};
+	const int iv[] = {0, 1, -1, 42, -42, 9, 10, 99, 100, 65535, 2147483647, -2147483647 - 1};
+	const char *fi[] = {"%d", "%i", "%u", "%x", "%X", "%5d", "%-5d|", "%05d", "%+d", "% d", "%08x", "%-8X|",
+	                    "%+05d", "% 5d", "%1d", "%0d"};
+	const char *fs[] = {"%s", "%10s", "%-10s|", "%.3s", "%8.2s", "%-8.2s|", "%.0s", "%.*s"};
+	const char *sv[] = {"", "a", "hello", "0123456789abcdef"};
+
+	for(size_t i=0; i<sizeof(ff)/sizeof(ff[0]); i++)
+		for(size_t k=0; k<sizeof(fv)/sizeof(fv[0]); k++)
+			Check(256, ff[i], (double)fv[k]);
+
+	for(size_t i=0; i<sizeof(fi)/sizeof(fi[0]); i++)
+		for(size_t k=0; k<sizeof(iv)/sizeof(iv[0]); k++)
+			Check(256, fi[i], iv[k]);
+
+	for(size_t i=0; i<sizeof(fs)/sizeof(fs[0]); i++)
+		for(size_t k=0; k<sizeof(sv)/sizeof(sv[0]); k++)
+		{
+			if(strstr(fs[i], "*") != NULL) Check(256, fs[i], 4, sv[k]);
+			else Check(256, fs[i], sv[k]);
+		}
+
+	Check(256, "%ld %lu %lx", -123456789L, 4000000000UL, 0xdeadbeefUL);
+	Check(256, "%c%c%-3c|%3c", 'a', 'b', 'c', 'd');
+	Check(256, "100%% %*d|%-*d|", 6, 7, 4, 8);
+	Check(256, "%.*f", 3, (double)1.23456f);
+	Check(256, "pitch=%.2f gyro=%d bat=%.3fV %s", (double)-1.25f, -300, (double)7.4f, "ok");
+
+	// 截断
+	for(uint16_t size=0; size<12; size++)
+	{
+		Check(size, "%s=%d", "abc", 12345);
+		Check(size, "%.3f", (double)-3.14159f);
+	}
+}
+
+static void Random(unsigned long N)
+{
+	static const char conv[] = "diuxXf";
+	char format[32];
+
+	for(unsigned long i=0; i<N; i++)
+	{
+		char c = conv[Rand() % 6];
+		int n = 0;
+
+		format[n++] = '%';
+
+		if(Rand() % 4 == 0) format[n++] = '-';
+		if(Rand() % 4 == 0) format[n++] = '0';
+		if(Rand() % 4 == 0) format[n++] = '+';
+		if(Rand() % 6 == 0) format[n++] = ' ';
+		if(Rand() % 2 == 0) n += sprintf(format + n, "%u", Rand() % 20);
+		if(c == 'f' && Rand() % 2 == 0) n += sprintf(format + n, ".%u", Rand() % (FMT_MAX_PRECISION + 1));
+
+		format[n++] = c;
+		format[n++] = '|';
+		format[n] = '\0';
+
+		if(c == 'f')
+		{
+			Check(256, format, (double)RandFloat());
+		}
+		else
+		{
+			int v = (int)Rand() >> (Rand() % 31);
+
+			// 标准没有规定无符号转换的+和空格，C库也忽略，这里同样忽略
+			Check(256, format, v);
+		}
+	}
+}
+
+//
+// @简介：比较一种格式的耗时，返回每次调用的周期数
+//
+#define TIME(Func, ...) do { \
+	uint64_t best = UINT64_MAX; \
+	for(int r=0; r<20; r++) { \
+		uint64_t t0 = Cycles(); \
+		for(int k=0; k<1000; k++) { Func(buf, sizeof(buf), __VA_ARGS__); __asm__ volatile("" ::: "memory"); } \
+		uint64_t t = Cycles() - t0; \
+		if(t < best) best = t; \
+	} \
+	cyc = best / 1000.0; \
+} while(0)
+
+static void Timing(void)
+{
+	char buf[128];
+	double cyc;
+	volatile float f = -12.345f;
+	volatile int d = -3000;
+
+	printf("\n%-40s %12s %12s\n", "format", "Fmt_Format", "snprintf");
+
+	TIME(Fmt_Format, "%d,%d\n", d, 25);
+	double a = cyc;
+	TIME(snprintf, "%d,%d\n", d, 25);
+	printf("%-40s %12.0f %12.0f\n", "\"%d,%d\\n\"", a, cyc);
+
+	TIME(Fmt_Format, "%.2f", (double)f);
+	a = cyc;
+	TIME(snprintf, "%.2f", (double)f);
+	printf("%-40s %12.0f %12.0f\n", "\"%.2f\"", a, cyc);
+
+	TIME(Fmt_Format, "pitch=%.2f gx=%.1f duty=%5.1f%% bat=%.3f", (double)f, (double)f, (double)f, (double)f);
+	a = cyc;
+	TIME(snprintf, "pitch=%.2f gx=%.1f duty=%5.1f%% bat=%.3f", (double)f, (double)f, (double)f, (double)f);
+	printf("%-40s %12.0f %12.0f\n", "4 x %f", a, cyc);
+
+	TIME(Fmt_Format, "%s %08x %-6s|", "state", 0xbeef, "ok");
+	a = cyc;
+	TIME(snprintf, "%s %08x %-6s|", "state", 0xbeef, "ok");
+	printf("%-40s %12.0f %12.0f\n", "\"%s %08x %-6s|\"", a, cyc);
+
+	printf("(CPU cycles per call on this machine, best of 20 x 1000)\n");
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 1000000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n cases] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Table();
+	Random(n);
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	Timing();
+
+	return failures ? 1 : 0;
+}
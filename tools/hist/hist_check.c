@@ -0,0 +1,248 @@
+/**
+  ******************************************************************************
+  * @file    hist_check.c
+  * @version V 1.0.0
+  * @brief   my_lib/hist.c的检查
+  *          1. 随机的桶数（含0和超过HIST_MAX_BINS）、桶宽和样本，百分位数与由排序后的样本得到的参考一致：
+  *             第ceil(N*Percent/100)个样本所在的桶的上边界，不超过最大值，落在最后一个桶时为最大值
+  *             （Percent为0时为第一个桶）；各桶的样本数、样本数和最大值与逐个统计的一致
+  *          2. 超出范围：大于最后一个桶的样本（直到0xFFFFFFFF）计入最后一个桶；
+  *             桶宽很大时桶的上边界超过32位；各桶的样本数之和接近2^32时累计不溢出
+  *          3. 没有样本时返回0，Hist_Reset之后与新初始化的相同
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o hist_check -Imy_lib tools/hist/hist_check.c my_lib/hist.c
+  *
+  *          使用：./hist_check [-n 随机直方图的个数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hist.h"
+
+#define MAX_SAMPLES 2000
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void Check(int Ok, const char *What, unsigned long A, unsigned long B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %lu, expected %lu\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+static int Compare(const void *A, const void *B)
+{
+	uint32_t a = *(const uint32_t *)A, b = *(const uint32_t *)B;
+
+	return (a > b) - (a < b);
+}
+
+//
+// @简介：由某个样本所在的桶得到的百分位数：桶的上边界，不超过最大值，最后一个桶为最大值
+//
+static uint32_t Upper(uint32_t Bin, uint16_t NumBins, uint32_t BinWidth, uint32_t Max)
+{
+	uint64_t upper = (uint64_t)(Bin + 1) * BinWidth;
+
+	return (Bin >= (uint32_t)NumBins - 1 || upper > Max) ? Max : (uint32_t)upper;
+}
+
+static uint32_t BinOf(uint32_t x, uint16_t NumBins, uint32_t BinWidth)
+{
+	uint32_t k = x / BinWidth;
+
+	return k < NumBins ? k : NumBins - 1u;
+}
+
+//
+// @简介：与排序后的样本比较所有百分位数
+//
+static void Percentiles(const Hist_TypeDef *Hist, uint32_t *pSamples, uint32_t N)
+{
+	qsort(pSamples, N, sizeof(uint32_t), Compare);
+
+	for(uint8_t p=0; p<=100; p++)
+	{
+		uint32_t want = 0;
+
+		if(N > 0)
+		{
+			uint32_t rank = (uint32_t)(((uint64_t)N * p + 99) / 100); // 第rank个样本，从1开始
+			uint32_t bin = rank == 0 ? 0 : BinOf(pSamples[rank - 1], Hist->NumBins, Hist->BinWidth);
+
+			want = Upper(bin, Hist->NumBins, Hist->BinWidth, pSamples[N - 1]);
+		}
+
+		uint32_t got = Hist_GetPercentile(Hist, p);
+
+		if(got != want && failures < 20)
+		{
+			printf("%u bins x %lu, %lu samples: p%u = %lu, expected %lu\n", Hist->NumBins, (unsigned long)Hist->BinWidth,
+			       (unsigned long)N, p, (unsigned long)got, (unsigned long)want);
+		}
+
+		Check(got == want, "percentile", got, want);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 1. 随机的直方图
+//////////////////////////////////////////////////////////////////////////
+
+static void Random(unsigned long Count)
+{
+	static uint32_t samples[MAX_SAMPLES];
+	static const uint32_t widths[] = {1, 7, 500, 65536, 0x08000000, 0x40000000, 0xFFFFFFFF};
+	Hist_TypeDef hist;
+
+	for(unsigned long n=0; n<Count; n++)
+	{
+		uint16_t numBins = Rand() % (HIST_MAX_BINS + 4);
+		uint32_t width = Rand() % 2 ? 1 + Rand() % 1000 : widths[Rand() % (sizeof(widths) / sizeof(widths[0]))];
+		uint16_t bins = numBins == 0 ? 1 : numBins > HIST_MAX_BINS ? HIST_MAX_BINS : numBins;
+		uint32_t num = Rand() % 4 == 0 ? Rand() % 8 : Rand() % MAX_SAMPLES;
+		uint32_t counts[HIST_MAX_BINS] = {0};
+		uint32_t max = 0;
+		uint64_t range = (uint64_t)bins * width; // 样本多数在这个范围内，少数超出
+
+		Hist_Init(&hist, numBins, width);
+
+		Check(hist.NumBins == bins, "bins", hist.NumBins, bins);
+
+		for(uint32_t i=0; i<num; i++)
+		{
+			uint32_t r = Rand() % 100;
+			uint64_t x = r < 5 ? 0xFFFFFFFFu - Rand() % 4 : r < 15 ? range + Rand() % 1000 : (((uint64_t)Rand() << 32 | Rand()) % range);
+
+			if(Rand() % 8 == 0 && i > 0) x = samples[Rand() % i]; // 重复的样本
+
+			samples[i] = x > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)x;
+			counts[BinOf(samples[i], bins, width)]++;
+
+			if(samples[i] > max) max = samples[i];
+
+			Hist_Add(&hist, samples[i]);
+		}
+
+		Check(hist.N == num, "count", hist.N, num);
+		Check(hist.Max == max, "max", hist.Max, max);
+		Check(!memcmp(hist.Bins, counts, sizeof(counts)), "bins", n, n);
+
+		Percentiles(&hist, samples, num);
+	}
+
+	printf("random     %lu histograms\n", Count);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 2、3. 超出范围，没有样本
+//////////////////////////////////////////////////////////////////////////
+
+static void Edges(void)
+{
+	Hist_TypeDef hist;
+	uint32_t samples[4];
+
+	// 没有样本
+	Hist_Init(&hist, 8, 100);
+
+	for(uint8_t p=0; p<=100; p += 10) Check(Hist_GetPercentile(&hist, p) == 0, "empty", p, 0);
+
+	// 全部大于最后一个桶
+	samples[0] = 800; samples[1] = 12345; samples[2] = 0xFFFFFFFF;
+
+	for(int i=0; i<3; i++) Hist_Add(&hist, samples[i]);
+
+	Check(hist.Bins[7] == 3, "last bin", hist.Bins[7], 3);
+	Check(Hist_GetPercentile(&hist, 0) == 100, "p0 with empty first bin", Hist_GetPercentile(&hist, 0), 100);
+	Check(Hist_GetPercentile(&hist, 1) == 0xFFFFFFFF, "p1 in last bin", Hist_GetPercentile(&hist, 1), 0xFFFFFFFF);
+
+	Percentiles(&hist, samples, 3);
+
+	// 清空后与新初始化的相同
+	Hist_TypeDef fresh;
+
+	Hist_Reset(&hist);
+	Hist_Init(&fresh, 8, 100);
+
+	Check(!memcmp(&hist, &fresh, sizeof(hist)), "reset", 0, 0);
+	Check(Hist_GetPercentile(&hist, 50) == 0, "empty after reset", Hist_GetPercentile(&hist, 50), 0);
+
+	// 桶宽很大，桶的上边界超过32位
+	Hist_Init(&hist, 32, 0x40000000);
+	samples[0] = 0x40000000; samples[1] = 0xC0000000; samples[2] = 0xFFFFFFFE; samples[3] = 0x7FFFFFFF;
+
+	for(int i=0; i<4; i++) Hist_Add(&hist, samples[i]);
+
+	Check(Hist_GetPercentile(&hist, 75) == 0xFFFFFFFE, "upper edge above 32 bits", Hist_GetPercentile(&hist, 75), 0xFFFFFFFE);
+
+	Percentiles(&hist, samples, 4);
+
+	// 一个桶
+	Hist_Init(&hist, 1, 10);
+	Hist_Add(&hist, 3);
+	Hist_Add(&hist, 5);
+
+	Check(Hist_GetPercentile(&hist, 0) == 5 && Hist_GetPercentile(&hist, 100) == 5, "single bin", Hist_GetPercentile(&hist, 0), 5);
+
+	// 各桶的样本数之和接近2^32，N*Percent和累计的样本数*100超过32位
+	Hist_Init(&hist, 4, 10);
+	hist.Bins[0] = 0x80000000;
+	hist.Bins[1] = 0x40000000;
+	hist.Bins[3] = 0x3FFFFFFF;
+	hist.N = 0xFFFFFFFF;
+	hist.Max = 1000;
+
+	Check(Hist_GetPercentile(&hist, 50) == 10, "large count p50", Hist_GetPercentile(&hist, 50), 10);
+	Check(Hist_GetPercentile(&hist, 51) == 20, "large count p51", Hist_GetPercentile(&hist, 51), 20);
+	Check(Hist_GetPercentile(&hist, 75) == 20, "large count p75", Hist_GetPercentile(&hist, 75), 20);
+	Check(Hist_GetPercentile(&hist, 76) == 1000, "large count p76", Hist_GetPercentile(&hist, 76), 1000);
+	Check(Hist_GetPercentile(&hist, 100) == 1000, "large count p100", Hist_GetPercentile(&hist, 100), 1000);
+
+	printf("edges      done\n");
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 100000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n histograms] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Edges();
+	Random(n);
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,347 @@
+/**
+  ******************************************************************************
+  * @file    lqr_gen.c
+  * @version V 1.0.0
+  * @brief   LQR增益生成工具（在电脑上运行）
+  *          读取小车的模型参数和Q/R权重，对线性化模型按控制周期做零阶保持离散化，
+  *          迭代求解离散Riccati方程，输出供app_control.c使用的增益头文件
+  *
+  *          编译：gcc -O2 -o lqr_gen tools/lqr_gen.c -lm
+  *          使用：./lqr_gen tools/lqr_model.txt [名称=数值 ...] > user/app_lqr_gain.h
+  *          命令行上的"名称=数值"会覆盖模型文件中的同名参数，便于批量扫描权重
+  ******************************************************************************
+  *
+  * 状态量 x = [alpha, dalpha, pos, vel, yaw]
+  *   alpha  - 倾角，单位rad
+  *   dalpha - 倾角速度，单位rad/s
+  *   pos    - 轮子位置，单位m
+  *   vel    - 轮子速度，单位m/s
+  *   yaw    - 偏航角速度，单位rad/s
+  * 控制量 u = [acc, turn]
+  *   acc    - 轮子的水平加速度，单位m/s^2（与串级PID中的ddx_ref相同）
+  *   turn   - 左右轮差动角加速度，单位rad/s^2（积分后即为转向环的omega_turn）
+  *
+  * 电机速度环以1kHz运行，远快于本控制环，因此模型把轮子的加速度视为可直接给定的输入，
+  * 与串级PID的解算公式 Jp*ddalpha = mp*g*lp*sin(alpha) + mp*lp*cos(alpha)*ddx 一致：
+  *   ddalpha = mp*g*lp/Jp * alpha + mp*lp/Jp * acc
+  *   dvel    = acc
+  *   dyaw    = 2*rw/track * turn   （omega_turn为正时偏航角速度增大，与转向环Kp>0一致）
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define NX 5 // 状态量个数
+#define NU 2 // 控制量个数
+
+typedef struct
+{
+	const char *Name;
+	double Value;
+} Param_TypeDef;
+
+static Param_TypeDef params[] = {
+	{"rw", 0.032}, {"lp", 0.062}, {"mp", 0.12}, {"Jp", 4.6128e-4}, {"g", 9.8}, {"track", 0.16},
+	{"Ts", 0.005},
+	{"q_alpha", 100}, {"q_dalpha", 1}, {"q_x", 4}, {"q_v", 10}, {"q_yaw", 1},
+	{"r_acc", 0.04}, {"r_turn", 2.5e-5},
+};
+
+#define NUM_PARAMS (sizeof(params) / sizeof(params[0]))
+
+static double *Param(const char *Name)
+{
+	for(size_t i=0; i<NUM_PARAMS; i++)
+	{
+		if(strcmp(params[i].Name, Name) == 0) return &params[i].Value;
+	}
+	return NULL;
+}
+
+//
+// @简介：解析一行"名称 = 数值"，#之后为注释
+// @返回值：0 - 成功或空行，-1 - 格式错误或未知参数
+//
+static int ParseLine(char *Line)
+{
+	char *p = strchr(Line, '#');
+	if(p) *p = '\0';
+	
+	char name[32];
+	double value;
+	
+	for(p = Line; *p; p++)
+	{
+		if(*p == '=') *p = ' ';
+	}
+	
+	int n = sscanf(Line, "%31s %lf", name, &value);
+	
+	if(n <= 0) return 0; // 空行
+	if(n != 2) return -1;
+	
+	double *v = Param(name);
+	if(v == NULL) return -1;
+	
+	*v = value;
+	return 0;
+}
+
+// 矩阵运算，矩阵按行存放，尺寸在调用时给出
+static void MatMul(const double *A, const double *B, double *C, int m, int k, int n)
+{
+	for(int i=0; i<m; i++)
+	{
+		for(int j=0; j<n; j++)
+		{
+			double s = 0;
+			for(int l=0; l<k; l++) s += A[i*k+l] * B[l*n+j];
+			C[i*n+j] = s;
+		}
+	}
+}
+
+static void Transpose(const double *A, double *At, int m, int n)
+{
+	for(int i=0; i<m; i++)
+	{
+		for(int j=0; j<n; j++) At[j*m+i] = A[i*n+j];
+	}
+}
+
+//
+// @简介：零阶保持离散化，对增广矩阵[A B; 0 0]*Ts求矩阵指数（泰勒级数）
+//
+static void Discretize(const double *A, const double *B, double Ts, double *Ad, double *Bd)
+{
+	enum { N = NX + NU };
+	double M[N*N] = {0}, E[N*N] = {0}, T[N*N], T2[N*N];
+	
+	for(int i=0; i<NX; i++)
+	{
+		for(int j=0; j<NX; j++) M[i*N+j] = A[i*NX+j] * Ts;
+		for(int j=0; j<NU; j++) M[i*N+NX+j] = B[i*NU+j] * Ts;
+	}
+	
+	for(int i=0; i<N; i++) E[i*N+i] = 1;
+	memcpy(T, E, sizeof(T));
+	
+	for(int k=1; k<30; k++)
+	{
+		MatMul(T, M, T2, N, N, N);
+		for(int i=0; i<N*N; i++)
+		{
+			T[i] = T2[i] / k;
+			E[i] += T[i];
+		}
+	}
+	
+	for(int i=0; i<NX; i++)
+	{
+		for(int j=0; j<NX; j++) Ad[i*NX+j] = E[i*N+j];
+		for(int j=0; j<NU; j++) Bd[i*NU+j] = E[i*N+NX+j];
+	}
+}
+
+//
+// @简介：迭代求解离散Riccati方程，得到增益 K = (R + B'PB)^-1 B'PA
+// @返回值：收敛所用的迭代次数，-1表示不收敛
+//
+static int SolveDare(const double *A, const double *B, const double *Q, const double *R, double *K)
+{
+	double P[NX*NX], At[NX*NX], Bt[NU*NX];
+	double PA[NX*NX], PB[NX*NU], BtPB[NU*NU], BtPA[NU*NX], AtPA[NX*NX], AtPB[NX*NU], T[NX*NX];
+	
+	memcpy(P, Q, sizeof(P));
+	Transpose(A, At, NX, NX);
+	Transpose(B, Bt, NX, NU);
+	
+	for(int iter=1; iter<=100000; iter++)
+	{
+		MatMul(P, A, PA, NX, NX, NX);
+		MatMul(P, B, PB, NX, NX, NU);
+		MatMul(Bt, PB, BtPB, NU, NX, NU);
+		MatMul(Bt, PA, BtPA, NU, NX, NX);
+		
+		// S = R + B'PB，2x2求逆
+		double s00 = R[0] + BtPB[0], s01 = R[1] + BtPB[1];
+		double s10 = R[2] + BtPB[2], s11 = R[3] + BtPB[3];
+		double det = s00*s11 - s01*s10;
+		double Si[NU*NU] = { s11/det, -s01/det, -s10/det, s00/det };
+		
+		MatMul(Si, BtPA, K, NU, NU, NX);
+		
+		// P' = Q + A'PA - A'PB K
+		MatMul(At, PA, AtPA, NX, NX, NX);
+		MatMul(At, PB, AtPB, NX, NX, NU);
+		MatMul(AtPB, K, T, NX, NU, NX);
+		
+		double delta = 0, norm = 0;
+		
+		for(int i=0; i<NX*NX; i++)
+		{
+			double p = Q[i] + AtPA[i] - T[i];
+			delta += fabs(p - P[i]);
+			norm += fabs(p);
+			P[i] = p;
+		}
+		
+		if(delta <= 1e-12 * norm) return iter;
+	}
+	
+	return -1;
+}
+
+//
+// @简介：闭环矩阵 A-BK 的谱半径（幂迭代），小于1表示闭环稳定
+//
+static double SpectralRadius(const double *A, const double *B, const double *K)
+{
+	double BK[NX*NX], Acl[NX*NX], x[NX], y[NX], r = 0;
+	
+	MatMul(B, K, BK, NX, NU, NX);
+	for(int i=0; i<NX*NX; i++) Acl[i] = A[i] - BK[i];
+	
+	for(int i=0; i<NX; i++) x[i] = 1.0 + 0.1 * i;
+	
+	// ||Acl^n x||^(1/n)
+	double logsum = 0;
+	int n = 20000;
+	
+	for(int k=0; k<n; k++)
+	{
+		MatMul(Acl, x, y, NX, NX, 1);
+		
+		double s = 0;
+		for(int i=0; i<NX; i++) s += y[i] * y[i];
+		s = sqrt(s);
+		if(s == 0) return 0;
+		
+		logsum += log(s);
+		for(int i=0; i<NX; i++) x[i] = y[i] / s;
+	}
+	
+	r = exp(logsum / n);
+	return r;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc < 2)
+	{
+		fprintf(stderr, "usage: %s model.txt [name=value ...]\n", argv[0]);
+		return 1;
+	}
+	
+	FILE *f = fopen(argv[1], "r");
+	if(f == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+	
+	char line[256];
+	int lineno = 0;
+	
+	while(fgets(line, sizeof(line), f))
+	{
+		lineno++;
+		if(ParseLine(line) != 0)
+		{
+			fprintf(stderr, "%s:%d: bad line\n", argv[1], lineno);
+			return 1;
+		}
+	}
+	fclose(f);
+	
+	for(int i=2; i<argc; i++)
+	{
+		strncpy(line, argv[i], sizeof(line) - 1);
+		line[sizeof(line) - 1] = '\0';
+		
+		if(ParseLine(line) != 0)
+		{
+			fprintf(stderr, "bad override: %s\n", argv[i]);
+			return 1;
+		}
+	}
+	
+	double rw = *Param("rw"), lp = *Param("lp"), mp = *Param("mp"), Jp = *Param("Jp"), g = *Param("g");
+	double track = *Param("track"), Ts = *Param("Ts");
+	
+	// 连续模型
+	double A[NX*NX] = {0}, B[NX*NU] = {0};
+	
+	A[0*NX+1] = 1;
+	A[1*NX+0] = mp * g * lp / Jp;
+	A[2*NX+3] = 1;
+	
+	B[1*NU+0] = mp * lp / Jp;
+	B[3*NU+0] = 1;
+	B[4*NU+1] = 2 * rw / track;
+	
+	double Q[NX*NX] = {0}, R[NU*NU] = {0};
+	
+	Q[0*NX+0] = *Param("q_alpha");
+	Q[1*NX+1] = *Param("q_dalpha");
+	Q[2*NX+2] = *Param("q_x");
+	Q[3*NX+3] = *Param("q_v");
+	Q[4*NX+4] = *Param("q_yaw");
+	R[0*NU+0] = *Param("r_acc");
+	R[1*NU+1] = *Param("r_turn");
+	
+	double Ad[NX*NX], Bd[NX*NU], K[NU*NX];
+	
+	Discretize(A, B, Ts, Ad, Bd);
+	
+	int iter = SolveDare(Ad, Bd, Q, R, K);
+	
+	if(iter < 0)
+	{
+		fprintf(stderr, "Riccati iteration did not converge\n");
+		return 1;
+	}
+	
+	double rho = SpectralRadius(Ad, Bd, K);
+	
+	if(rho > 1 + 1e-4)
+	{
+		fprintf(stderr, "closed loop unstable, spectral radius %g\n", rho);
+		return 1;
+	}
+	
+	if(rho >= 1)
+	{
+		fprintf(stderr, "warning: closed loop marginally stable (some state has zero weight)\n");
+	}
+	
+	printf("/**\n");
+	printf("  ******************************************************************************\n");
+	printf("  * @file    app_lqr_gain.h\n");
+	printf("  * @brief   LQR增益矩阵，由tools/lqr_gen自动生成，请勿手工修改\n");
+	printf("  *          状态量 [alpha, dalpha, pos, vel, yaw]，控制量 [acc, turn]\n");
+	printf("  *          rw=%g lp=%g mp=%g Jp=%g g=%g track=%g Ts=%g\n", rw, lp, mp, Jp, g, track, Ts);
+	printf("  *          Q=diag(%g, %g, %g, %g, %g) R=diag(%g, %g)\n", Q[0], Q[6], Q[12], Q[18], Q[24], R[0], R[3]);
+	printf("  *          闭环谱半径 %.6f，Riccati迭代%d次\n", rho, iter);
+	printf("  ******************************************************************************\n");
+	printf("  */\n\n");
+	printf("#ifndef APP_LQR_GAIN_H\n");
+	printf("#define APP_LQR_GAIN_H\n\n");
+	printf("#define LQR_GAIN_NUM_STATES %d\n", NX);
+	printf("#define LQR_GAIN_NUM_INPUTS %d\n", NU);
+	printf("#define LQR_GAIN_TS %gf // 增益对应的控制周期，单位s\n\n", Ts);
+	printf("static const float LQR_GAIN_K[LQR_GAIN_NUM_INPUTS * LQR_GAIN_NUM_STATES] = {\n");
+	
+	for(int i=0; i<NU; i++)
+	{
+		printf("\t");
+		for(int j=0; j<NX; j++) printf("%.7ef,%s", K[i*NX+j], j < NX-1 ? " " : "\n");
+	}
+	
+	printf("};\n\n");
+	printf("#endif\n");
+	
+	return 0;
+}
@@ -0,0 +1,207 @@
+/**
+  ******************************************************************************
+  * @file    pid_check.c
+  * @version V 1.0.0
+  * @brief   固定周期PID和低通滤波器的等价性检查
+  *          PID_ComputeFixedRate、LPF_CalcFixedRate使用预先算好的离散系数，
+  *          与Δt=Ts时的PID_Compute1、LPF_Calc只差在浮点运算的先后顺序上。
+  *          用随机的增益、周期和输入序列同时运行两种实现，逐次比较输出：
+  *          1. PID（含输出端的低通滤波器）、单独的低通滤波器
+  *          2. 运行中途PID_ChangeTunings修改增益、PID_ChangeRate修改周期后，
+  *             离散系数KiT、KdT、Lpf.Alpha被重新计算，输出仍与变周期的实现一致
+  *          3. 先启用低通滤波器再修改周期、修改周期后再启用低通滤波器两种顺序
+  *          容差：输出范围的1e-5（浮点舍入在积分项中的累积，实测约2e-7）
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o pid_check -Itools/sim -Imy_lib tools/pid/pid_check.c my_lib/pid.c my_lib/lpf.c -lm
+  *
+  *          使用：./pid_check [-n 随机用例数] [-s 种子]
+  *          全部在容差内时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pid.h"
+#include "lpf.h"
+#include "delay.h"
+
+#define STEPS     2000   // 每个用例的运算次数
+#define TOLERANCE 1.0e-5 // 相对于输出范围
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+static double maxErr = 0;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+//
+// @简介：[Lo, Hi)之间均匀分布的随机数
+//
+static float Uniform(float Lo, float Hi)
+{
+	return Lo + (Hi - Lo) * (float)(Rand() % 1000000) * 1.0e-6f;
+}
+
+static void Check(int Ok, const char *What, unsigned long Case, double A, double B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH case %lu %s: fixed %.9g, variable %.9g\n", Case, What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+static void CheckOutput(unsigned long Case, const char *What, float Fixed, float Variable, float Range)
+{
+	double err = fabs((double)Fixed - (double)Variable) / Range;
+
+	if(err > maxErr) maxErr = err;
+
+	Check(err <= TOLERANCE, What, Case, Fixed, Variable);
+}
+
+//
+// @简介：离散系数是否由当前的增益和周期算出（与pid.c、lpf.c中的表达式相同，应逐位相等）
+//
+static void CheckCoefficients(unsigned long Case, PID_TypeDef *PID)
+{
+	Check(PID->KiT == PID->Ki * 0.5f * PID->Ts, "KiT", Case, PID->KiT, PID->Ki * 0.5f * PID->Ts);
+	Check(PID->KdT == PID->Kd / PID->Ts, "KdT", Case, PID->KdT, PID->Kd / PID->Ts);
+
+	if(PID->LpfCmd)
+	{
+		Check(PID->Lpf.Alpha == PID->Ts / PID->Lpf.Tf, "Lpf.Alpha", Case, PID->Lpf.Alpha, PID->Ts / PID->Lpf.Tf);
+	}
+}
+
+//
+// @简介：一个随机用例：随机的增益、周期和输入，中途修改增益和周期
+//
+static void RandomCase(unsigned long Case)
+{
+	static const uint32_t periodsUs[] = {1000, 2000, 5000, 10000, 20000}; // 控制任务实际使用的周期
+
+	PID_InitTypeDef PID_InitStruct = {0};
+
+	PID_InitStruct.Kp = Uniform(-2, 2);
+	PID_InitStruct.Ki = Rand() % 4 ? Uniform(0, 20) : 0; // 包括Ki=0、Kd=0的用例
+	PID_InitStruct.Kd = Rand() % 4 ? Uniform(0, 0.05f) : 0;
+	PID_InitStruct.Setpoint = Uniform(-1, 1);
+	PID_InitStruct.OutputUpperLimit = Uniform(1, 100);
+	PID_InitStruct.OutputLowerLimit = -PID_InitStruct.OutputUpperLimit;
+	PID_InitStruct.DefaultOutput = Uniform(-0.5f, 0.5f);
+
+	float range = PID_InitStruct.OutputUpperLimit - PID_InitStruct.OutputLowerLimit;
+
+	uint32_t tsUs = periodsUs[Rand() % 5];
+	float tf = Uniform(0.04f, 0.2f); // 低通滤波器的时间常数不少于最长周期的2倍，修改周期后Ts/Tf仍小于1
+	uint8_t lpfMode = Rand() % 3; // 0 - 不启用低通滤波器，1 - 一开始就启用，2 - 修改周期后再启用
+
+	PID_TypeDef fixed, variable;
+	LPF_TypeDef lpfFixed, lpfVariable;
+
+	PID_InitFixedRate(&fixed, &PID_InitStruct, Time_UsToSec(tsUs));
+	PID_Init(&variable, &PID_InitStruct);
+
+	if(lpfMode == 1)
+	{
+		PID_LpfConfig(&fixed, tf, 1);
+		PID_LpfConfig(&variable, tf, 1);
+	}
+
+	LPF_InitFixedRate(&lpfFixed, tf, Time_UsToSec(tsUs));
+	LPF_Init(&lpfVariable, tf);
+
+	CheckCoefficients(Case, &fixed);
+
+	uint32_t lpfTsUs = tsUs; // 单独的低通滤波器始终以初始化时的周期运行
+	uint32_t now = Rand(), lpfNow = now;
+	float input = Uniform(-1, 1);
+
+	for(int k=0; k<STEPS; k++)
+	{
+		if(k == STEPS / 3) // 修改增益
+		{
+			float kp = Uniform(-2, 2), ki = Uniform(0, 20), kd = Uniform(0, 0.05f);
+
+			PID_ChangeTunings(&fixed, kp, ki, kd);
+			PID_ChangeTunings(&variable, kp, ki, kd);
+
+			CheckCoefficients(Case, &fixed);
+		}
+
+		if(k == 2 * STEPS / 3) // 修改周期
+		{
+			uint32_t newTsUs = periodsUs[Rand() % 5];
+			float newTf = Uniform(0.04f, 0.2f);
+
+			PID_ChangeRate(&fixed, Time_UsToSec(newTsUs));
+
+			if(lpfMode == 2)
+			{
+				PID_LpfConfig(&fixed, newTf, 1);
+				PID_LpfConfig(&variable, newTf, 1);
+			}
+
+			tsUs = newTsUs;
+
+			CheckCoefficients(Case, &fixed);
+		}
+
+		input += Uniform(-0.05f, 0.05f);
+		now += tsUs;
+		lpfNow += lpfTsUs;
+
+		float a = PID_ComputeFixedRate(&fixed, input);
+		float b = PID_Compute1(&variable, input, now);
+
+		CheckOutput(Case, "PID output", a, b, range);
+		CheckOutput(Case, "PID ITerm", fixed.ITerm, variable.ITerm, range);
+
+		float c = LPF_CalcFixedRate(&lpfFixed, input);
+		float d = LPF_Calc(&lpfVariable, input, lpfNow);
+
+		CheckOutput(Case, "LPF output", c, d, 2);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 2000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n cases] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	for(unsigned long i=0; i<n; i++)
+	{
+		RandomCase(i);
+	}
+
+	printf("%lu checks, %lu mismatches, max error %.2e of output range\n", checks, failures, maxErr);
+
+	return failures ? 1 : 0;
+}
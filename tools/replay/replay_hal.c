@@ -0,0 +1,653 @@
+/**
+  ******************************************************************************
+  * @file    replay_hal.c
+  * @version V 1.0.0
+  * @brief   回放用的硬件替身
+  ******************************************************************************
+  */
+
+#include "replay_hal.h"
+#include "app_trace.h"
+#include "delay.h"
+#include "i2c.h"
+#include "app_pwm.h"
+#include "app_bat.h"
+#include <math.h>
+#include <string.h>
+
+#define GEN_GETUS_COST   2   // 生成时每次调用GetUs消耗的时间，单位us，使代码的执行过程有先后
+#define GEN_ISR_COST     3   // 生成时每次编码器中断消耗的时间
+#define GEN_I2C_START_US 6   // 生成时开始一次中断方式读取的耗时
+#define GEN_I2C_READ_US  400 // 生成时读取14字节IMU数据的总线时间（I2C1，400kHz，与tools/emu一致）
+#define GEN_GYRO_READ_US 150 // 生成时只读取x轴角速度（2字节）的总线时间
+
+Replay_TypeDef replay;
+
+struct Emu_GPIO_TypeDef { uint8_t Dummy; };
+GPIO_TypeDef Emu_GPIOA, Emu_GPIOB, Emu_GPIOC, Emu_GPIOD;
+struct Emu_I2C_TypeDef { uint8_t Dummy; };
+I2C_TypeDef Emu_I2C1, Emu_I2C2;
+
+void EXTI3_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+
+// 正在执行的编码器中断
+static uint8_t inIsr = 0;
+static uint32_t isrUs;
+static uint32_t isrLine;
+static uint8_t levelA, levelB;
+
+static void Edge(uint8_t Left, uint8_t Flags, uint32_t Us);
+
+//////////////////////////////////////////////////////////////////////////
+// 回放：按顺序读取记录
+//////////////////////////////////////////////////////////////////////////
+
+static const uint8_t *data;
+static uint32_t dataLen, offset, lastUs;
+static uint64_t elapsed; // 从上电开始的时间，单位us，不受32位微秒时间回绕的影响
+
+static int Peek(Trace_RecordTypeDef *Record, int *pLen)
+{
+	uint32_t us = lastUs;
+	int n = Trace_Decode(&us, data + offset, dataLen - offset, Record);
+
+	if(n <= 0) return 0;
+
+	*pLen = n;
+	return 1;
+}
+
+static int Pop(Trace_RecordTypeDef *Record)
+{
+	int n;
+
+	if(!Peek(Record, &n)) return 0;
+
+	offset += n;
+	lastUs = Record->Us;
+	replay.Count[Record->Type]++;
+
+	return 1;
+}
+
+//
+// @简介：注入下一条同步记录之前的全部边沿，并统计LOST记录
+//        边沿只在控制代码读取编码器的临界区内才会被看到，
+//        因此在到达下一条同步记录之前的任何时刻注入，结果都相同
+//
+static void Pump(void)
+{
+	Trace_RecordTypeDef rec;
+	int n;
+
+	while(Peek(&rec, &n))
+	{
+		if(rec.Type == TRACE_EDGE_L || rec.Type == TRACE_EDGE_R)
+		{
+			Pop(&rec);
+			Edge(rec.Type == TRACE_EDGE_L, rec.Flags, rec.Us);
+		}
+		else if(rec.Type == TRACE_TYPE_LOST)
+		{
+			Pop(&rec);
+
+			if(replay.Lost == 0) replay.FirstLostUs = rec.Us;
+
+			replay.Lost += rec.Data[0] | (rec.Data[1] << 8) | (rec.Data[2] << 16) | ((uint32_t)rec.Data[3] << 24);
+		}
+		else
+		{
+			break;
+		}
+	}
+}
+
+//
+// @简介：取出控制代码此刻应当留下的同步记录
+// @返回值：1 - 成功，0 - 下一条记录不是该类型（控制代码的执行过程与记录不一致），或记录已经结束
+//
+static int Expect(uint8_t Type, Trace_RecordTypeDef *Record)
+{
+	int n;
+
+	Pump();
+
+	if(!Peek(Record, &n)) return 0; // 记录在任务中途结束（例如断电），不算不一致
+
+	if(Record->Type == Type)
+	{
+		Pop(Record);
+		return 1;
+	}
+
+	replay.Missing++;
+	return 0;
+}
+
+//
+// @简介：打开记录，定位到第一条HEADER记录
+//        串口可能在单片机上电之后才开始接收，因此跳过HEADER之前不完整的数据
+// @返回值：0 - 成功，-1 - 找不到HEADER记录
+//
+int Replay_Open(const uint8_t *pData, uint32_t Len, Trace_RecordTypeDef *Header)
+{
+	data = pData;
+	dataLen = Len;
+
+	for(offset = 0; offset < Len; offset++)
+	{
+		int n;
+		TraceHeader_TypeDef h;
+
+		lastUs = 0;
+
+		if(!Peek(Header, &n)) continue;
+		if(Header->Type != TRACE_HEADER || Header->Size != sizeof(h)) continue;
+
+		memcpy(&h, Header->Data, sizeof(h));
+
+		if(h.Magic != TRACE_MAGIC) continue;
+
+		Pop(Header);
+
+		replay.Us = Header->Us;
+		elapsed = Header->Us;
+		replay.Cali.encoder_duty_l = h.EncoderDuty_L;
+		replay.Cali.encoder_duty_r = h.EncoderDuty_R;
+		replay.Cali.mpu6050_gx_bias = h.GxBias;
+		replay.Cali.mpu6050_gy_bias = h.GyBias;
+		replay.Cali.mpu6050_gz_bias = h.GzBias;
+		replay.Cali.mpu6050_pitch_bias = h.PitchBias;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+//
+// @简介：取出下一条需要由主循环处理的记录（边沿已在途中注入）
+// @返回值：1 - 成功，0 - 记录结束
+//
+int Replay_Next(Trace_RecordTypeDef *Record)
+{
+	Pump();
+
+	if(!Pop(Record)) return 0;
+
+	elapsed += (int32_t)Time_Diff(Record->Us, replay.Us); // IMU记录的时间为开始读取的时刻，可能早于上一条记录
+	replay.Us = Record->Us;
+
+	return 1;
+}
+
+//
+// @简介：获取记录末尾未能解码的字节数，末尾不完整的一条记录属于正常情况，
+//        更多则说明中途有数据损坏，回放在损坏处停止
+//
+uint32_t Replay_GetRemaining(void)
+{
+	return dataLen - offset;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 生成：合成的运动，中断在开中断处按时插入
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	double (*Speed)(double T); // 转速，单位：边沿/s，正数为正转
+	uint32_t NextUs;           // 下一个边沿的时刻
+	uint8_t A;                 // A相电平
+} GenWheel_TypeDef;
+
+static FILE *genFile;
+static Trace_TypeDef genTrace;
+static uint8_t genBuffer[4096];
+static uint8_t irqMasked = 0;
+static uint64_t rng;
+static double (*genPitch)(double T);
+static GenWheel_TypeDef wheel_l, wheel_r;
+static float genTracedVolt = 0;
+
+static double Uniform(void)
+{
+	rng ^= rng >> 12;
+	rng ^= rng << 25;
+	rng ^= rng >> 27;
+
+	return ((rng * 2685821657736338717ull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void GenWheel_Schedule(GenWheel_TypeDef *Wheel, uint32_t Now)
+{
+	double s = fabs(Wheel->Speed(Now * 1e-6));
+
+	if(s < 20) // 几乎静止，10ms后再看
+	{
+		Wheel->NextUs = Now + 10000;
+	}
+	else
+	{
+		Wheel->NextUs = Now + (uint32_t)(1e6 / s * (0.8 + 0.4 * Uniform())) + 1; // 间隔有±20%的抖动
+	}
+}
+
+//
+// @简介：产生一个A相边沿，正转时上升沿B相为高、下降沿B相为低，反转相反
+//
+static void GenWheel_Fire(GenWheel_TypeDef *Wheel, uint8_t Left)
+{
+	double s = Wheel->Speed(replay.Us * 1e-6);
+
+	if(fabs(s) >= 20)
+	{
+		Wheel->A = !Wheel->A;
+
+		uint8_t b = s > 0 ? Wheel->A : !Wheel->A;
+
+		Edge(Left, Wheel->A | (b << 1), replay.Us);
+
+		replay.Us += GEN_ISR_COST;
+	}
+
+	GenWheel_Schedule(Wheel, replay.Us);
+}
+
+static void Gen_Flush(void)
+{
+	uint8_t byte;
+
+	while(Trace_ReadByte(&genTrace, &byte) == 0)
+	{
+		fputc(byte, genFile);
+	}
+}
+
+void Gen_Open(FILE *f, uint64_t Seed)
+{
+	genFile = f;
+	rng = Seed ? Seed : 1;
+	replay.Generate = 1;
+
+	Trace_Init(&genTrace, genBuffer, sizeof(genBuffer));
+}
+
+void Gen_Close(void)
+{
+	Gen_Flush();
+}
+
+void Gen_SetMotion(double (*Pitch)(double T), double (*Speed_L)(double T), double (*Speed_R)(double T))
+{
+	genPitch = Pitch;
+	wheel_l.Speed = Speed_L;
+	wheel_r.Speed = Speed_R;
+
+	GenWheel_Schedule(&wheel_l, replay.Us);
+	GenWheel_Schedule(&wheel_r, replay.Us);
+}
+
+//
+// @简介：经过Us微秒，其间到期的编码器中断在开中断时按时插入，并占用CPU时间
+//
+void Gen_Advance(uint32_t Us)
+{
+	uint32_t end = replay.Us + Us;
+
+	while(!irqMasked && !inIsr && genPitch != NULL) // 编码器初始化之前没有中断
+	{
+		GenWheel_TypeDef *w = Time_Reached(wheel_r.NextUs, wheel_l.NextUs) ? &wheel_l : &wheel_r;
+
+		if(!Time_Reached(end, w->NextUs)) break;
+
+		if(Time_Reached(w->NextUs, replay.Us)) replay.Us = w->NextUs;
+
+		uint32_t before = replay.Us;
+
+		GenWheel_Fire(w, w == &wheel_l);
+
+		end += replay.Us - before; // 中断占用的时间
+	}
+
+	if(Time_Reached(end, replay.Us)) replay.Us = end;
+}
+
+//
+// @简介：合成IMU原始数据，绕X轴俯仰，陀螺仪读数为俯仰角的导数，叠加±2LSB的噪声
+//
+static void Gen_Imu(uint8_t *pBuffer)
+{
+	double t = replay.Us * 1e-6;
+	double pitch = genPitch(t);
+	double rate = (genPitch(t + 1e-4) - genPitch(t - 1e-4)) / 2e-4;
+	double rad = pitch * M_PI / 180;
+	int16_t raw[7];
+
+	raw[0] = 0;                                    // ax
+	raw[1] = (int16_t)(sin(rad) * 16384);         // ay，2g量程
+	raw[2] = (int16_t)(cos(rad) * 16384);         // az
+	raw[3] = -1500;                                // 温度
+	raw[4] = (int16_t)(rate / 0.06097560975610);  // gx，2000°/s量程
+	raw[5] = 0;                                    // gy
+	raw[6] = 0;                                    // gz
+
+	for(int i = 0; i < 7; i++)
+	{
+		if(i != 3) raw[i] += (int16_t)(Uniform() * 5) - 2;
+
+		pBuffer[2 * i] = (uint16_t)raw[i] >> 8;
+		pBuffer[2 * i + 1] = (uint16_t)raw[i] & 0xff;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 编码器中断
+//////////////////////////////////////////////////////////////////////////
+
+static void Edge(uint8_t Left, uint8_t Flags, uint32_t Us)
+{
+	levelA = Flags & 0x01;
+	levelB = (Flags >> 1) & 0x01;
+	isrLine = Left ? EXTI_Line14 : EXTI_Line3;
+	isrUs = Us;
+
+	inIsr = 1;
+
+	if(Left)
+	{
+		EXTI15_10_IRQHandler();
+	}
+	else
+	{
+		EXTI3_IRQHandler();
+	}
+
+	inIsr = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// stm32f10x.h
+//////////////////////////////////////////////////////////////////////////
+
+//
+// 回放时，关中断意味着控制代码即将读取编码器，先注入此前发生的边沿
+//
+void __disable_irq(void)
+{
+	if(replay.Generate)
+	{
+		irqMasked = 1;
+	}
+	else
+	{
+		Pump();
+	}
+}
+
+void __enable_irq(void)
+{
+	if(replay.Generate)
+	{
+		irqMasked = 0;
+		Gen_Advance(0); // 响应关中断期间挂起的中断
+	}
+}
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState) { (void)RCC_APB2Periph; (void)NewState; }
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState) { (void)RCC_APB1Periph; (void)NewState; }
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct) { (void)GPIOx; (void)GPIO_InitStruct; }
+void GPIO_EXTILineConfig(uint8_t GPIO_PortSource, uint8_t GPIO_PinSource) { (void)GPIO_PortSource; (void)GPIO_PinSource; }
+void GPIO_PinRemapConfig(uint32_t GPIO_Remap, FunctionalState NewState) { (void)GPIO_Remap; (void)NewState; }
+void EXTI_Init(EXTI_InitTypeDef *EXTI_InitStruct) { (void)EXTI_InitStruct; }
+void EXTI_ClearFlag(uint32_t EXTI_Line) { (void)EXTI_Line; }
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct) { (void)NVIC_InitStruct; }
+
+FlagStatus EXTI_GetFlagStatus(uint32_t EXTI_Line)
+{
+	return (inIsr && EXTI_Line == isrLine) ? SET : RESET;
+}
+
+//
+// @简介：编码器引脚的电平，A相PB14/PB3，B相PB15/PB4
+//
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	(void)GPIOx;
+
+	if(GPIO_Pin == GPIO_Pin_14 || GPIO_Pin == GPIO_Pin_3) return levelA;
+	if(GPIO_Pin == GPIO_Pin_15 || GPIO_Pin == GPIO_Pin_4) return levelB;
+
+	return 1; // 其它引脚（I2C1的SDA）为高电平
+}
+
+void GPIO_WriteBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, BitAction BitVal) { (void)GPIOx; (void)GPIO_Pin; (void)BitVal; }
+
+//////////////////////////////////////////////////////////////////////////
+// delay.h
+//////////////////////////////////////////////////////////////////////////
+
+void Delay_Init(void) {}
+void Delay(uint32_t ms) { (void)ms; }
+void DelayUs(uint32_t us) { (void)us; }
+
+//
+// 回放时毫秒时间按触发记录的时间换算，与单片机上的GetTick可能相差1ms（见replay_main.c的说明）
+//
+uint32_t GetTick(void)
+{
+	if(replay.Generate) return replay.Us / 1000;
+
+	return (uint32_t)(elapsed / 1000);
+}
+
+//
+// @简介：回放时，中断中返回边沿的时间；控制代码读取编码器时返回同步记录中的时间
+//
+uint32_t GetUs(void)
+{
+	if(inIsr) return isrUs;
+
+	if(replay.Generate)
+	{
+		Gen_Advance(GEN_GETUS_COST);
+		return replay.Us;
+	}
+
+	Trace_RecordTypeDef rec;
+	int n;
+
+	Pump();
+
+	if(Peek(&rec, &n) && (rec.Type == TRACE_SPEED_L || rec.Type == TRACE_SPEED_R ||
+	                      rec.Type == TRACE_POS_L || rec.Type == TRACE_POS_R))
+	{
+		return rec.Us;
+	}
+
+	return replay.Us;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// i2c.h，MPU6050的初始化写入被忽略，其它寄存器读为0（初始化时等待复位完成，复位立即完成）。
+// 回放时App_MPU6050_Proc不运行，由replay_main.c把IMU记录交给App_MPU6050_Update；
+// 生成时中断方式的读取在开始时合成数据，经过总线时间后完成
+//////////////////////////////////////////////////////////////////////////
+
+void I2C_Init(I2C_TypeDef *I2Cx, I2C_InitTypeDef *I2C_InitStruct) { (void)I2Cx; (void)I2C_InitStruct; }
+void I2C_Cmd(I2C_TypeDef *I2Cx, FunctionalState NewState) { (void)I2Cx; (void)NewState; }
+void My_I2C_XferInit(I2C_XferTypeDef *Xfer, I2C_TypeDef *I2Cx, uint8_t NVIC_IRQChannelPreemptionPriority) { (void)NVIC_IRQChannelPreemptionPriority; Xfer->I2Cx = I2Cx; }
+void My_I2C_AbortIT(I2C_XferTypeDef *Xfer) { (void)Xfer; }
+void My_I2C_EV_IRQHandler(I2C_XferTypeDef *Xfer) { (void)Xfer; }
+void My_I2C_ER_IRQHandler(I2C_XferTypeDef *Xfer) { (void)Xfer; }
+
+int My_I2C_RegWriteBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, const uint8_t *pData, uint16_t Size)
+{
+	(void)I2Cx; (void)Addr; (void)Reg; (void)pData; (void)Size;
+
+	return 0;
+}
+
+int My_I2C_RegReadBytes(I2C_TypeDef *I2Cx, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size)
+{
+	(void)I2Cx; (void)Addr; (void)Reg;
+
+	memset(pBuffer, 0, Size);
+
+	return 0;
+}
+
+static uint32_t genXferDoneUs; // 生成时读取完成的时刻
+
+int My_I2C_RegReadBytes_IT(I2C_XferTypeDef *Xfer, uint8_t Addr, uint8_t Reg, uint8_t *pBuffer, uint16_t Size)
+{
+	(void)Addr;
+
+	uint8_t imu[14];
+
+	Gen_Imu(imu);
+
+	if(Reg == 0x43) // 只读x轴角速度
+	{
+		memcpy(pBuffer, imu + 8, Size < 2 ? Size : 2);
+		genXferDoneUs = replay.Us + GEN_GYRO_READ_US;
+	}
+	else
+	{
+		memcpy(pBuffer, imu, Size < sizeof(imu) ? Size : sizeof(imu));
+		genXferDoneUs = replay.Us + GEN_I2C_READ_US;
+	}
+
+	Xfer->Result = I2C_XFER_BUSY;
+	Gen_Advance(GEN_I2C_START_US);
+
+	return 0;
+}
+
+int8_t My_I2C_GetResult(I2C_XferTypeDef *Xfer)
+{
+	if(Xfer->Result == I2C_XFER_BUSY && Time_Reached(replay.Us, genXferDoneUs)) Xfer->Result = I2C_XFER_OK;
+
+	return Xfer->Result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_pwm.h
+//////////////////////////////////////////////////////////////////////////
+
+void App_PWM_Init(void) {}
+void App_PWM_Cmd(uint8_t State) { replay.PwmEnabled = State; }
+void App_PWM_Set_L(float Duty) { replay.Duty_L = Duty; }
+void App_PWM_Set_R(float Duty) { replay.Duty_R = Duty; }
+
+//////////////////////////////////////////////////////////////////////////
+// app_bat.h
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：回放时若下一条同步记录是BAT，说明单片机在此处读到了新的电压；
+//        生成时按user/app_bat.c的方式换算和记录，ADC每10ms转换一次，电压缓慢下降
+//
+float App_Bat_Get(void)
+{
+	if(replay.Generate)
+	{
+		if(replay.Us >= 10000)
+		{
+			uint16_t dr = 3850 - (replay.Us / 10000) % 4 - replay.Us / 1000000;
+
+			replay.Volt = dr / 4095.0f * 8.4;
+		}
+
+		if(replay.Volt != genTracedVolt)
+		{
+			float v = replay.Volt;
+
+			genTracedVolt = v;
+			App_Trace_Record(TRACE_BAT, 0, GetUs(), &v, sizeof(v));
+		}
+	}
+	else
+	{
+		Trace_RecordTypeDef rec;
+		int n;
+
+		Pump();
+
+		if(Peek(&rec, &n) && rec.Type == TRACE_BAT)
+		{
+			Pop(&rec);
+			memcpy(&replay.Volt, rec.Data, sizeof(replay.Volt));
+		}
+	}
+
+	return replay.Volt;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_calibrator.h
+//////////////////////////////////////////////////////////////////////////
+
+const CaliResult_TypeDef *App_Calibrator_GetResult(void)
+{
+	return &replay.Cali;
+}
+
+uint8_t App_Calibrator_IsBusy(void)
+{
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_trace.h
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：生成时写出记录；回放时取出控制代码读取编码器留下的同步记录，
+//        并比较PWM校验值，其余记录由回放的主循环注入，此处忽略
+//
+void App_Trace_Record(uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size)
+{
+	if(replay.Generate)
+	{
+		Trace_Write(&genTrace, Type, Flags, Us, pData, Size);
+		Gen_Flush();
+		replay.Count[Type]++;
+
+		if(Type == TRACE_CONTROL) replay.ControlUs = Us;
+
+		return;
+	}
+
+	Trace_RecordTypeDef rec;
+
+	switch(Type)
+	{
+		case TRACE_SPEED_L:
+		case TRACE_SPEED_R:
+		case TRACE_POS_L:
+		case TRACE_POS_R:
+		{
+			Expect(Type, &rec);
+			break;
+		}
+		case TRACE_PWM:
+		{
+			if(Expect(Type, &rec))
+			{
+				replay.Checks++;
+
+				if(rec.Size != Size || memcmp(rec.Data, pData, Size) != 0)
+				{
+					if(replay.Mismatches == 0) replay.FirstMismatchUs = rec.Us;
+
+					replay.Mismatches++;
+				}
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file    replay_hal.h
+  * @version V 1.0.0
+  * @brief   回放用的硬件替身
+  *          控制代码（app_control、app_motor、app_encoder、app_mpu6050）原样编译，
+  *          其依赖的时间、GPIO/EXTI、I2C、PWM、电池电压和校准参数由本模块实现。
+  *          两种工作方式：
+  *          回放 - 输入取自记录：编码器边沿按记录的先后调用EXTI中断函数注入，
+  *                 控制代码在临界区内读取编码器时取出对应的同步记录，从而看到与实物完全相同的边沿；
+  *                 电机任务输出的占空比与记录中的校验值逐位比较
+  *          生成 - 输入取自合成的运动曲线，按单片机的执行方式（中断可在任意开中断处插入）
+  *                 运行控制代码并写出记录，用于在没有实物时检验记录和回放本身
+  ******************************************************************************
+  */
+
+#ifndef REPLAY_HAL_H
+#define REPLAY_HAL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "trace.h"
+#include "app_calibrator.h"
+
+typedef struct
+{
+	uint8_t Generate;        // 0 - 回放，1 - 生成
+	uint32_t Us;             // 当前时间，单位us；回放时为最近一条触发记录的时间
+	uint32_t ControlUs;      // 最近一次控制任务开始的时间
+	float Volt;              // App_Bat_Get的返回值
+	float Duty_L, Duty_R;    // App_PWM_Set_L/R的参数
+	uint8_t PwmEnabled;
+	CaliResult_TypeDef Cali; // App_Calibrator_GetResult的返回值
+
+	// 回放的统计
+	uint32_t Count[16];      // 各类型记录的条数
+	uint32_t Checks;         // 比较过的PWM校验值
+	uint32_t Mismatches;     // 其中不一致的个数
+	uint32_t FirstMismatchUs;
+	uint32_t Missing;        // 控制代码需要某种同步记录，但记录中的下一条不是该类型
+	uint32_t Unconsumed;     // 控制代码没有取走的同步记录
+	uint32_t Lost;           // 单片机上因串口来不及发送而丢弃的记录
+	uint32_t FirstLostUs;
+} Replay_TypeDef;
+
+extern Replay_TypeDef replay;
+
+// 回放
+     int Replay_Open(const uint8_t *pData, uint32_t Len, Trace_RecordTypeDef *Header);
+     int Replay_Next(Trace_RecordTypeDef *Record);
+uint32_t Replay_GetRemaining(void);
+
+// 生成
+    void Gen_Open(FILE *f, uint64_t Seed);
+    void Gen_Close(void);
+    void Gen_Advance(uint32_t Us);
+    void Gen_SetMotion(double (*Pitch)(double T), double (*Speed_L)(double T), double (*Speed_R)(double T));
+
+#endif
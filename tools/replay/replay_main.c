@@ -0,0 +1,379 @@
+/**
+  ******************************************************************************
+  * @file    replay_main.c
+  * @version V 1.0.0
+  * @brief   记录回放器
+  *          读取单片机从USART2输出的记录（格式见my_lib/trace.h和user/app_trace.h，
+  *          user/app_usart2.h中的USART2_STREAM须为USART2_STREAM_TRACE），
+  *          把原始IMU数据、编码器边沿、电池电压、按键和串口命令按原来的先后
+  *          送入原样编译的控制代码：App_MPU6050_Update、编码器中断和测速、
+  *          App_Motor_Proc、App_Control_Proc，并把每1ms电机任务输出的占空比
+  *          与记录中的校验值逐位比较。修改控制器或滤波器后回放同一份记录，
+  *          即可在电脑上对比改动前后的行为，或复现一次摔倒
+  *
+  *          编译（在仓库根目录下，借用tools/emu/stm32f10x.h代替标准库的头文件）：
+  *          gcc -O2 -ffp-contract=off -o replay -Itools/replay -Itools/emu -Iuser -Imy_lib \
+  *              tools/replay/replay_hal.c tools/replay/replay_main.c \
+  *              user/app_control.c user/app_motor.c user/app_encoder.c user/app_mpu6050.c \
+  *              my_lib/pid.c my_lib/lpf.c my_lib/cascade.c my_lib/lqr.c my_lib/qmath.c my_lib/trace.c \
+  *              my_lib/bus.c user/app_bus.c tools/common/app_stubs.c -lm
+  *          -ffp-contract=off禁止把乘加合并为FMA，使浮点运算的舍入与单片机（软件浮点）一致；
+  *          32位x86上还需要-msse2 -mfpmath=sse，避免80位的中间结果
+  *
+  *          采集：单片机上电前打开串口，例如
+  *          stty -F /dev/ttyUSB0 921600 raw && cat /dev/ttyUSB0 > capture.bin
+  *
+  *          使用：./replay [-o out.csv] capture.bin
+  *                ./replay -g capture.bin [-t 秒] [-s 种子] [-o out.csv]
+  *          -g 不使用实物，以合成的运动运行控制代码并生成记录，用于检验记录和回放本身
+  *          -o 每个控制周期输出一行：时间、俯仰角、角速度、占空比、电池电压、电机使能
+  *          回放逐位一致时返回0，否则返回1
+  *
+  *          注意：1. 回放需要从上电开始的完整记录，出现LOST记录后的结果不再可信
+  *                2. 毫秒时间GetTick按触发记录的时间换算，自动起立的计时在极少数情况下
+  *                   可能与单片机相差1ms（毫秒进位恰好发生在记录和读取之间）
+  *                3. 编码器须使用EXTI方式（ENCODER_USE_EDGECAP为0）
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "replay_hal.h"
+#include "app_trace.h"
+#include "delay.h"
+#include "app_control.h"
+#include "app_motor.h"
+#include "app_mpu6050.h"
+
+static FILE *csv = NULL;
+
+static void CsvRow(void)
+{
+	if(csv == NULL) return;
+
+	fprintf(csv, "%.6f,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%d\n", replay.ControlUs * 1e-6,
+	        App_MPU6050_GetPitch(), App_MPU6050_GetGyroX(), App_MPU6050_GetGyroZ(),
+	        replay.Duty_L, replay.Duty_R, replay.Volt, replay.PwmEnabled);
+}
+
+//
+// @简介：单击按键，与user/app_button.c中UserButtonClickCb的处理相同
+//
+static void Click(FunctionalState NewState)
+{
+	App_Control_Reset();
+	App_Motor_Reset();
+	App_Motor_Cmd(NewState);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 回放
+//////////////////////////////////////////////////////////////////////////
+
+static int Replay(const char *Path)
+{
+	FILE *f = fopen(Path, "rb");
+
+	if(f == NULL)
+	{
+		fprintf(stderr, "cannot open %s\n", Path);
+		return 1;
+	}
+
+	fseek(f, 0, SEEK_END);
+	long len = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	uint8_t *buf = malloc(len > 0 ? len : 1);
+
+	if(fread(buf, 1, len, f) != (size_t)len)
+	{
+		fprintf(stderr, "cannot read %s\n", Path);
+		return 1;
+	}
+
+	fclose(f);
+
+	Trace_RecordTypeDef rec;
+
+	if(Replay_Open(buf, len, &rec) != 0)
+	{
+		fprintf(stderr, "no HEADER record in %s\n", Path);
+		return 1;
+	}
+
+	uint32_t startUs = rec.Us;
+	uint8_t reboot = 0;
+
+	// 与user/main.c的初始化顺序相同
+	App_Motor_Init();
+	App_MPU6050_Init();
+	App_Control_Init();
+
+	while(!reboot && Replay_Next(&rec))
+	{
+		switch(rec.Type)
+		{
+			case TRACE_HEADER: // 单片机重新上电，回放到此为止
+				reboot = 1;
+				break;
+			case TRACE_IMU:
+				if(rec.Flags == 1) // 只读x轴角速度
+				{
+					App_MPU6050_UpdateGyro(rec.Data, rec.Us);
+				}
+				else
+				{
+					App_MPU6050_Update(rec.Data, rec.Us);
+				}
+				break;
+			case TRACE_MOTOR:
+				App_Motor_Proc();
+				break;
+			case TRACE_CONTROL:
+				replay.ControlUs = rec.Us;
+				App_Control_Proc();
+				CsvRow();
+				break;
+			case TRACE_MOVE:
+			{
+				float arg[2];
+				memcpy(arg, rec.Data, sizeof(arg));
+				App_Control_Move(arg[0], arg[1]);
+				break;
+			}
+			case TRACE_MODE:
+				App_Control_SetMode(rec.Flags);
+				break;
+			case TRACE_BUTTON:
+				Click(rec.Flags ? ENABLE : DISABLE);
+				break;
+			case TRACE_BAT: // 控制代码没有在此处读取电压，仍然更新，使之后的结果尽量接近
+				memcpy(&replay.Volt, rec.Data, sizeof(replay.Volt));
+				replay.Unconsumed++;
+				break;
+			default: // 控制代码没有取走的同步记录
+				replay.Unconsumed++;
+				break;
+		}
+	}
+
+	printf("capture     %s, %.3f s%s\n", Path, (replay.Us - startUs) * 1e-6, reboot ? " (stopped at reboot)" : "");
+
+	uint32_t remaining = Replay_GetRemaining();
+
+	if(!reboot && remaining >= TRACE_MAX_RECORD)
+	{
+		printf("corrupt     stopped with %u bytes left\n", remaining);
+	}
+
+	printf("records     imu %u, edges %u/%u, speed %u/%u, pos %u/%u, bat %u\n",
+	       replay.Count[TRACE_IMU], replay.Count[TRACE_EDGE_L], replay.Count[TRACE_EDGE_R],
+	       replay.Count[TRACE_SPEED_L], replay.Count[TRACE_SPEED_R],
+	       replay.Count[TRACE_POS_L], replay.Count[TRACE_POS_R], replay.Count[TRACE_BAT]);
+	printf("            motor %u, control %u, move %u, mode %u, button %u\n",
+	       replay.Count[TRACE_MOTOR], replay.Count[TRACE_CONTROL], replay.Count[TRACE_MOVE],
+	       replay.Count[TRACE_MODE], replay.Count[TRACE_BUTTON]);
+	printf("pwm checks  %u, mismatches %u", replay.Checks, replay.Mismatches);
+
+	if(replay.Mismatches > 0) printf(" (first at %.6f s)", (replay.FirstMismatchUs - startUs) * 1e-6);
+
+	printf("\nsync        missing %u, unconsumed %u\n", replay.Missing, replay.Unconsumed);
+
+	if(replay.Lost > 0)
+	{
+		printf("lost        %u records (first at %.6f s), results after that are not exact\n",
+		       replay.Lost, (replay.FirstLostUs - startUs) * 1e-6);
+	}
+
+	int exact = replay.Mismatches == 0 && replay.Missing == 0 && replay.Unconsumed == 0 && replay.Lost == 0 &&
+	            (reboot || remaining < TRACE_MAX_RECORD);
+
+	printf("%s\n", exact ? "BIT-EXACT" : "DIVERGED");
+
+	free(buf);
+
+	return exact ? 0 : 1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 生成
+//////////////////////////////////////////////////////////////////////////
+
+//
+// 俯仰角，单位°：小幅摆动，8s时摔倒，10s后扶起
+//
+static double Pitch(double T)
+{
+	double swing = 2 * sin(2 * M_PI * 0.5 * T);
+
+	if(T < 8) return swing;
+	if(T < 8.5) return swing + (T - 8) / 0.5 * 85;
+	if(T < 9.5) return swing + 85;
+	if(T < 10) return swing + (10 - T) / 0.5 * 85;
+
+	return swing;
+}
+
+//
+// 轮子转速，单位：边沿/s，左右不同且会反转
+//
+static double Speed_L(double T)
+{
+	return 3000 * sin(2 * M_PI * T / 5);
+}
+
+static double Speed_R(double T)
+{
+	return 2000 * sin(2 * M_PI * T / 3 + 0.5);
+}
+
+static int Generate(const char *Path, double Duration, uint64_t Seed)
+{
+	FILE *f = fopen(Path, "wb");
+
+	if(f == NULL)
+	{
+		fprintf(stderr, "cannot create %s\n", Path);
+		return 1;
+	}
+
+	Gen_Open(f, Seed);
+
+	replay.Us = 1000; // 上电后约1ms开始记录
+
+	replay.Cali.encoder_duty_l = 0.47f;
+	replay.Cali.encoder_duty_r = 0.52f;
+	replay.Cali.mpu6050_gx_bias = 0.31f;
+	replay.Cali.mpu6050_gy_bias = -0.12f;
+	replay.Cali.mpu6050_gz_bias = 0.05f;
+	replay.Cali.mpu6050_pitch_bias = 0.8f;
+
+	TraceHeader_TypeDef h = {0};
+
+	h.Magic = TRACE_MAGIC;
+	h.Version = TRACE_VERSION;
+	h.EncoderDuty_L = replay.Cali.encoder_duty_l;
+	h.EncoderDuty_R = replay.Cali.encoder_duty_r;
+	h.GxBias = replay.Cali.mpu6050_gx_bias;
+	h.GyBias = replay.Cali.mpu6050_gy_bias;
+	h.GzBias = replay.Cali.mpu6050_gz_bias;
+	h.PitchBias = replay.Cali.mpu6050_pitch_bias;
+
+	App_Trace_Record(TRACE_HEADER, 0, GetUs(), &h, sizeof(h));
+
+	App_Motor_Init();
+	App_MPU6050_Init();
+	App_Control_Init();
+
+	Gen_SetMotion(Pitch, Speed_L, Speed_R);
+
+	// 按键和串口命令，时间单位s
+	static const struct { double T; uint8_t What; float Arg0, Arg1; } script[] =
+	{
+		{ 0.3, 0, 0, 0 },    // 单击，使能电机
+		{ 2.0, 1, 20, 10 },  // move
+		{ 4.0, 2, 1, 0 },    // mode lqr
+		{ 6.0, 2, 0, 0 },    // mode pid
+		{ 7.0, 1, 0, 0 },    // move 0 0
+		{ 10.5, 0, 0, 0 },   // 摔倒后单击复位
+	};
+	uint8_t next = 0;
+
+	while(replay.Us < Duration * 1e6)
+	{
+		if(next < sizeof(script) / sizeof(script[0]) && replay.Us >= script[next].T * 1e6)
+		{
+			switch(script[next].What)
+			{
+				case 0:
+				{
+					FunctionalState s = App_Motor_GetState() == DISABLE ? ENABLE : DISABLE;
+					App_Trace_Record(TRACE_BUTTON, s, GetUs(), NULL, 0);
+					Click(s);
+					break;
+				}
+				case 1:
+					App_Control_Move(script[next].Arg0, script[next].Arg1);
+					break;
+				case 2:
+					App_Control_SetMode(script[next].Arg0 ? CONTROL_MODE_LQR : CONTROL_MODE_CASCADE);
+					break;
+			}
+
+			next++;
+		}
+
+		// 与user/main.c的主循环相同
+		App_MPU6050_Proc();
+		App_Motor_Proc();
+
+		uint32_t controls = replay.Count[TRACE_CONTROL];
+
+		App_Control_Proc();
+
+		if(replay.Count[TRACE_CONTROL] != controls) CsvRow();
+
+		Gen_Advance(5); // 主循环中其它任务的耗时
+	}
+
+	Gen_Close();
+	fclose(f);
+
+	printf("generated   %s, %.3f s, imu %u, edges %u/%u, motor %u, control %u\n", Path, Duration,
+	       replay.Count[TRACE_IMU], replay.Count[TRACE_EDGE_L], replay.Count[TRACE_EDGE_R],
+	       replay.Count[TRACE_MOTOR], replay.Count[TRACE_CONTROL]);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = NULL;
+	const char *csvPath = NULL;
+	uint8_t generate = 0;
+	double duration = 12;
+	uint64_t seed = 1;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(!strcmp(argv[i], "-g")) generate = 1;
+		else if(!strcmp(argv[i], "-t") && i + 1 < argc) duration = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-o") && i + 1 < argc) csvPath = argv[++i];
+		else if(argv[i][0] != '-') path = argv[i];
+		else
+		{
+			path = NULL;
+			break;
+		}
+	}
+
+	if(path == NULL)
+	{
+		fprintf(stderr, "usage: %s [-o out.csv] capture.bin\n"
+		                "       %s -g capture.bin [-t seconds] [-s seed] [-o out.csv]\n", argv[0], argv[0]);
+		return 2;
+	}
+
+	if(csvPath != NULL)
+	{
+		csv = fopen(csvPath, "w");
+
+		if(csv == NULL)
+		{
+			fprintf(stderr, "cannot create %s\n", csvPath);
+			return 1;
+		}
+
+		fprintf(csv, "t,pitch,gyro_x,gyro_z,duty_l,duty_r,volt,enabled\n");
+	}
+
+	int ret = generate ? Generate(path, duration, seed) : Replay(path);
+
+	if(csv != NULL) fclose(csv);
+
+	return ret;
+}
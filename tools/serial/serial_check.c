@@ -0,0 +1,518 @@
+/**
+  ******************************************************************************
+  * @file    serial_check.c
+  * @version V 1.0.0
+  * @brief   my_lib/serial.c的随机检查
+  *          用内存模拟USART的寄存器和DMA通道，按硬件的时序搬运字节并调用中断处理函数，
+  *          发送方和接收方随机地穿插操作，与按字节序号记下的期望值逐一比较：
+  *          1. 发送：随机长度的预留、填写、提交（提交的字节数可以少于预留的），
+  *             预留与提交之间随机地发生DMA完成中断；线路上发出的字节必须与提交的顺序和内容完全一致，
+  *             预留成功当且仅当Size不超过My_Serial_GetTxFree()，被拒绝的字节数等于TxOverrun
+  *          2. 接收：随机长度的突发数据（包括超过缓冲区长度的），半满、全满和空闲线中断，
+  *             随机长度的读取；读出的字节必须是数据流中连续的一段，被覆盖的字节数等于RxOverrun
+  *          以上两项分别在DMA和中断逐字节（DMA通道为NULL）两种方式下运行
+  *          3. My_USART_ReceiveBytes的超时跨过GetTick()的回绕
+  *          每次调用后检查中断已重新打开（Lock/Unlock成对）
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -Wno-pointer-to-int-cast -o serial_check -Itools/serial -Imy_lib tools/serial/serial_check.c my_lib/serial.c
+  *
+  *          使用：./serial_check [-n 随机操作数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "serial.h"
+#include "usart.h"
+#include "delay.h"
+
+#define TX_SIZE 64
+#define RX_SIZE 64
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void Check(int Ok, const char *What, unsigned long A, unsigned long B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %lu, expected %lu\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+//
+// @简介：数据流中第Idx个字节的值，不以256为周期重复，跳过整数圈的字节也能发现
+//
+static uint8_t StreamByte(uint32_t Idx)
+{
+	Idx ^= Idx >> 13;
+	Idx *= 0x5bd1e995;
+	Idx ^= Idx >> 15;
+
+	return (uint8_t)Idx;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 模拟的硬件
+//////////////////////////////////////////////////////////////////////////
+
+USART_TypeDef Emu_USART[3];
+DMA_Channel_TypeDef Emu_DMA1_Channel[7];
+
+static uint32_t primask;
+static uint32_t tick;
+static uint32_t dmaEnabled;                 // 每个通道一位
+static uint32_t dmaIT[7];                   // DMA_ITConfig使能的中断
+static uint16_t txDmaCount;                 // 发送DMA启动时的CNDTR
+
+static Serial_TypeDef serial;
+static uint8_t txBuffer[TX_SIZE], rxBuffer[RX_SIZE];
+
+// 发送：已提交和已发出的字节数
+static uint32_t txCommitted, txSent;
+static unsigned long txRejected;
+
+// 接收：线路上已到达和读取方已读到的位置
+static uint32_t rxArrived, rxReadPos;
+static unsigned long rxOverrun;
+
+uint32_t __get_PRIMASK(void) { return primask; }
+void __set_PRIMASK(uint32_t PriMask) { primask = PriMask; }
+void __disable_irq(void) { primask = 1; }
+void __enable_irq(void) { primask = 0; }
+
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct) { (void)NVIC_InitStruct; }
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState) { (void)RCC_AHBPeriph; (void)NewState; }
+void USART_DMACmd(USART_TypeDef *USARTx, uint16_t USART_DMAReq, FunctionalState NewState) { (void)USARTx; (void)USART_DMAReq; (void)NewState; }
+void DMA_ClearITPendingBit(uint32_t DMAy_IT) { (void)DMAy_IT; }
+
+void USART_ITConfig(USART_TypeDef *USARTx, uint16_t USART_IT, FunctionalState NewState)
+{
+	if(USART_IT != USART_IT_TXE) return; // 接收和空闲线中断始终由检查程序按需调用
+
+	if(NewState) USARTx->CR1 |= USART_CR1_TXEIE;
+	else USARTx->CR1 &= ~USART_CR1_TXEIE;
+}
+
+//
+// @简介：发送一个字节，检查它是否为提交的下一个字节
+//
+void USART_SendData(USART_TypeDef *USARTx, uint16_t Data)
+{
+	(void)USARTx;
+
+	Check(txSent < txCommitted, "tx byte not committed", txSent, txCommitted);
+	Check(Data == StreamByte(txSent), "tx byte", Data, StreamByte(txSent));
+
+	txSent++;
+}
+
+uint16_t USART_ReceiveData(USART_TypeDef *USARTx)
+{
+	USARTx->SR &= ~(USART_FLAG_RXNE | USART_FLAG_IDLE | USART_FLAG_ORE | USART_FLAG_NE | USART_FLAG_FE); // 先读SR再读DR清除
+
+	return USARTx->DR;
+}
+
+FlagStatus USART_GetFlagStatus(USART_TypeDef *USARTx, uint16_t USART_FLAG)
+{
+	return (USARTx->SR & USART_FLAG) ? SET : RESET;
+}
+
+static int ChannelIndex(DMA_Channel_TypeDef *DMAy_Channelx)
+{
+	return (int)(DMAy_Channelx - Emu_DMA1_Channel);
+}
+
+void DMA_Init(DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct)
+{
+	DMAy_Channelx->CNDTR = DMA_InitStruct->DMA_BufferSize;
+	DMAy_Channelx->CMAR = DMA_InitStruct->DMA_MemoryBaseAddr;
+}
+
+void DMA_Cmd(DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState)
+{
+	int i = ChannelIndex(DMAy_Channelx);
+
+	if(NewState)
+	{
+		dmaEnabled |= 1u << i;
+
+		if(DMAy_Channelx == serial.Init.TxDMAy_Channelx) txDmaCount = DMAy_Channelx->CNDTR;
+	}
+	else
+	{
+		dmaEnabled &= ~(1u << i);
+	}
+}
+
+void DMA_ITConfig(DMA_Channel_TypeDef *DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState)
+{
+	int i = ChannelIndex(DMAy_Channelx);
+
+	if(NewState) dmaIT[i] |= DMA_IT;
+	else dmaIT[i] &= ~DMA_IT;
+}
+
+void Delay_Init(void) {}
+
+//
+// @简介：每次调用时间前进1ms，模拟My_USART_ReceiveBytes中的等待
+//
+static uint32_t arriveAt;  // 到达此时刻时收到arriveSize个字节
+static uint16_t arriveSize;
+static void Arrive(uint16_t Count);
+
+uint32_t GetTick(void)
+{
+	tick++;
+
+	if(arriveSize && tick == arriveAt)
+	{
+		Arrive(arriveSize);
+		arriveSize = 0;
+	}
+
+	return tick;
+}
+
+//
+// @简介：检查中断是否已经重新打开，在每次调用serial.c之后执行
+//
+static void CheckUnlocked(const char *What)
+{
+	Check(primask == 0, What, primask, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 发送
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：线路发出最多Count个字节，发送完成时进入中断
+//
+static void Transmit(uint16_t Count)
+{
+	DMA_Channel_TypeDef *dma = serial.Init.TxDMAy_Channelx;
+
+	for(uint16_t k=0; k<Count; k++)
+	{
+		if(dma != NULL)
+		{
+			if(!(dmaEnabled & (1u << ChannelIndex(dma))) || dma->CNDTR == 0) return;
+
+			// CMAR只有低32位，按相对于发送队列的偏移还原
+			uint32_t offset = dma->CMAR - (uint32_t)(uintptr_t)txBuffer + (txDmaCount - dma->CNDTR);
+
+			Check(offset < TX_SIZE, "tx dma offset", offset, TX_SIZE);
+
+			USART_SendData(serial.Init.USARTx, txBuffer[offset % TX_SIZE]);
+
+			dma->CNDTR--;
+
+			if(dma->CNDTR == 0 && (dmaIT[ChannelIndex(dma)] & DMA_IT_TC))
+			{
+				My_Serial_TxDMA_IRQHandler(&serial);
+				CheckUnlocked("unlocked after tx dma irq");
+			}
+		}
+		else
+		{
+			if(!(serial.Init.USARTx->CR1 & USART_CR1_TXEIE)) return;
+
+			serial.Init.USARTx->SR |= USART_FLAG_TXE;
+			My_Serial_IRQHandler(&serial);
+			CheckUnlocked("unlocked after txe irq");
+		}
+	}
+}
+
+//
+// @简介：发送方的一次操作：预留、填写、提交，或直接写入
+//
+static void Writer(void)
+{
+	uint16_t size = 1 + Rand() % (TX_SIZE + 1); // 包括放不下的长度
+	uint16_t free = My_Serial_GetTxFree(&serial);
+
+	CheckUnlocked("unlocked after GetTxFree");
+
+	if(Rand() % 4 == 0)
+	{
+		uint8_t data[TX_SIZE + 1];
+
+		for(uint16_t i=0; i<size; i++) data[i] = StreamByte(txCommitted + i);
+
+		uint16_t n = My_Serial_Write(&serial, data, size);
+
+		CheckUnlocked("unlocked after Write");
+		Check((n == size) == (size <= free), "Write accepted iff Size <= GetTxFree", n, size <= free ? size : 0);
+
+		if(n) txCommitted += n;
+		else txRejected += size;
+	}
+	else
+	{
+		uint8_t *p = My_Serial_TxReserve(&serial, size);
+
+		CheckUnlocked("unlocked after TxReserve");
+		Check((p != NULL) == (size <= free), "TxReserve accepted iff Size <= GetTxFree", p != NULL, size <= free);
+
+		if(p == NULL)
+		{
+			txRejected += size;
+		}
+		else
+		{
+			Check(p >= txBuffer && p + size <= txBuffer + TX_SIZE, "reserved inside queue", p - txBuffer, TX_SIZE - size);
+
+			Transmit(Rand() % 8); // 预留之后DMA仍在发送，其完成中断可以启动下一段
+
+			uint16_t n = 1 + Rand() % size; // 实际填写的字节数可以少于预留的
+
+			for(uint16_t i=0; i<n; i++) p[i] = StreamByte(txCommitted + i);
+
+			Transmit(Rand() % 8);
+
+			My_Serial_TxCommit(&serial, n);
+			CheckUnlocked("unlocked after TxCommit");
+
+			txCommitted += n;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 接收
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：线路上到达Count个字节，DMA写入缓冲区或RXNE中断逐字节读取
+//
+static void Arrive(uint16_t Count)
+{
+	DMA_Channel_TypeDef *dma = serial.Init.RxDMAy_Channelx;
+	USART_TypeDef *usart = serial.Init.USARTx;
+
+	for(uint16_t k=0; k<Count; k++)
+	{
+		uint8_t byte = StreamByte(rxArrived++);
+
+		if(dma != NULL)
+		{
+			uint16_t pos = RX_SIZE - dma->CNDTR;
+
+			rxBuffer[pos] = byte;
+
+			dma->CNDTR--;
+
+			uint32_t it = 0;
+
+			if(dma->CNDTR == RX_SIZE / 2) it = DMA_IT_HT;
+
+			if(dma->CNDTR == 0)
+			{
+				dma->CNDTR = RX_SIZE; // 循环模式自动重装
+				it = DMA_IT_TC;
+			}
+
+			if(it & dmaIT[ChannelIndex(dma)])
+			{
+				My_Serial_RxDMA_IRQHandler(&serial);
+				CheckUnlocked("unlocked after rx dma irq");
+			}
+		}
+		else
+		{
+			usart->DR = byte;
+			usart->SR |= USART_FLAG_RXNE;
+
+			My_Serial_IRQHandler(&serial);
+			CheckUnlocked("unlocked after rxne irq");
+
+			Check(!(usart->SR & USART_FLAG_RXNE), "RXNE cleared", usart->SR, 0);
+		}
+	}
+
+	if(Count && Rand() % 2) // 一帧结束，空闲线
+	{
+		usart->SR |= USART_FLAG_IDLE;
+
+		My_Serial_IRQHandler(&serial);
+		CheckUnlocked("unlocked after idle irq");
+
+		Check(My_Serial_RxIdle(&serial) == 1, "RxIdle", 0, 1);
+	}
+}
+
+//
+// @简介：读取方的一次操作，读出的字节必须是数据流中连续的一段
+//
+static void Reader(void)
+{
+	uint8_t data[RX_SIZE + 8];
+	uint16_t maxSize = Rand() % (RX_SIZE + 8);
+
+	uint32_t avail = rxArrived - rxReadPos;
+
+	uint16_t count = My_Serial_GetRxCount(&serial);
+
+	CheckUnlocked("unlocked after GetRxCount");
+	Check(count == (avail > RX_SIZE ? RX_SIZE : avail), "GetRxCount", count, avail > RX_SIZE ? RX_SIZE : avail);
+
+	if(avail > RX_SIZE) // 最早的数据已被覆盖
+	{
+		rxOverrun += avail - RX_SIZE;
+		rxReadPos = rxArrived - RX_SIZE;
+		avail = RX_SIZE;
+	}
+
+	uint16_t n = My_Serial_Read(&serial, data, maxSize);
+
+	CheckUnlocked("unlocked after Read");
+	Check(n == (avail < maxSize ? avail : maxSize), "Read count", n, avail < maxSize ? avail : maxSize);
+
+	for(uint16_t i=0; i<n; i++)
+	{
+		Check(data[i] == StreamByte(rxReadPos + i), "rx byte", data[i], StreamByte(rxReadPos + i));
+	}
+
+	rxReadPos += n;
+
+	Check(serial.RxOverrun == rxOverrun, "RxOverrun", serial.RxOverrun, rxOverrun);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 随机运行
+//////////////////////////////////////////////////////////////////////////
+
+static void Setup(uint8_t UseDMA)
+{
+	memset(Emu_USART, 0, sizeof(Emu_USART));
+	memset(Emu_DMA1_Channel, 0, sizeof(Emu_DMA1_Channel));
+	memset(dmaIT, 0, sizeof(dmaIT));
+	memset(txBuffer, 0xee, sizeof(txBuffer));
+	dmaEnabled = 0;
+	primask = 0;
+	txCommitted = txSent = 0;
+	txRejected = 0;
+	rxArrived = rxReadPos = 0;
+	rxOverrun = 0;
+
+	Serial_InitTypeDef Serial_InitStruct;
+
+	Serial_InitStruct.USARTx = USART1;
+	Serial_InitStruct.TxDMAy_Channelx = UseDMA ? DMA1_Channel4 : NULL;
+	Serial_InitStruct.RxDMAy_Channelx = UseDMA ? DMA1_Channel5 : NULL;
+	Serial_InitStruct.pTxBuffer = txBuffer;
+	Serial_InitStruct.TxBufferSize = TX_SIZE;
+	Serial_InitStruct.pRxBuffer = rxBuffer;
+	Serial_InitStruct.RxBufferSize = RX_SIZE;
+	Serial_InitStruct.NVIC_IRQChannelPreemptionPriority = 1;
+
+	My_Serial_Init(&serial, &Serial_InitStruct);
+	CheckUnlocked("unlocked after Init");
+}
+
+static void Random(uint8_t UseDMA, unsigned long Count)
+{
+	Setup(UseDMA);
+
+	for(unsigned long k=0; k<Count; k++)
+	{
+		switch(Rand() % 5)
+		{
+			case 0: Writer(); break;
+			case 1: Transmit(Rand() % (TX_SIZE / 2)); break;
+			case 2: Arrive(Rand() % 4 == 0 ? Rand() % (3 * RX_SIZE) : Rand() % (RX_SIZE / 4)); break; // 偶尔超过缓冲区长度
+			case 3: Reader(); break;
+			default: Writer(); Transmit(Rand() % 4); break;
+		}
+
+		Check(serial.TxOverrun == txRejected, "TxOverrun", serial.TxOverrun, txRejected);
+	}
+
+	// 排空发送队列，全部提交的字节都应发出
+	Transmit(TX_SIZE * 2);
+
+	Check(txSent == txCommitted, "all committed bytes sent", txSent, txCommitted);
+	Check(rxOverrun > 0, "overrun exercised", rxOverrun, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// My_USART_ReceiveBytes的超时
+//////////////////////////////////////////////////////////////////////////
+
+static void ReceiveTimeout(void)
+{
+	uint8_t data[8];
+
+	Setup(1);
+
+	// 没有数据，超时时刻越过0xFFFFFFFF
+	tick = 0xfffffff0;
+
+	uint16_t n = My_USART_ReceiveBytes(USART1, data, sizeof(data), 100);
+
+	CheckUnlocked("unlocked after ReceiveBytes");
+	Check(n == 0, "ReceiveBytes timeout count", n, 0);
+	Check(tick - 0xfffffff0u >= 100 && tick - 0xfffffff0u <= 102, "ReceiveBytes waited", tick - 0xfffffff0u, 100);
+
+	// 数据在回绕之后、超时之前到达
+	tick = 0xfffffff0;
+	arriveAt = 0x20;
+	arriveSize = sizeof(data);
+
+	n = My_USART_ReceiveBytes(USART1, data, sizeof(data), 100);
+
+	Check(n == sizeof(data), "ReceiveBytes count", n, sizeof(data));
+	Check(tick == 0x20, "ReceiveBytes returned on arrival", tick, 0x20);
+
+	for(uint16_t i=0; i<n; i++)
+	{
+		Check(data[i] == StreamByte(i), "ReceiveBytes byte", data[i], StreamByte(i));
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 1000000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n operations] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Random(1, n);
+	Random(0, n);
+	ReceiveTimeout();
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   串口队列检查用的替身头文件
+  *          在电脑上编译my_lib/serial.c时代替std_periph_driver/inc/stm32f10x.h，
+  *          只提供serial.c用到的类型、常数和函数。USART和DMA通道是serial_check.c中的普通变量，
+  *          由它按硬件的时序改写寄存器并调用中断处理函数，以模拟收发
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+
+#define __IO volatile
+#define __STATIC_INLINE static inline
+
+// 由serial_check.c实现，记录关中断的状态
+uint32_t __get_PRIMASK(void);
+    void __set_PRIMASK(uint32_t PriMask);
+    void __disable_irq(void);
+    void __enable_irq(void);
+
+//
+// 外设，只保留serial.c访问的寄存器
+//
+typedef struct
+{
+	__IO uint16_t SR;
+	__IO uint16_t DR;
+	__IO uint16_t CR1;
+} USART_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CCR;
+	__IO uint32_t CNDTR;
+	__IO uint32_t CPAR;
+	__IO uint32_t CMAR;
+} DMA_Channel_TypeDef;
+
+extern USART_TypeDef Emu_USART[3];
+extern DMA_Channel_TypeDef Emu_DMA1_Channel[7];
+
+#define USART1 (&Emu_USART[0])
+#define USART2 (&Emu_USART[1])
+#define USART3 (&Emu_USART[2])
+
+#define DMA1_Channel1 (&Emu_DMA1_Channel[0])
+#define DMA1_Channel2 (&Emu_DMA1_Channel[1])
+#define DMA1_Channel3 (&Emu_DMA1_Channel[2])
+#define DMA1_Channel4 (&Emu_DMA1_Channel[3])
+#define DMA1_Channel5 (&Emu_DMA1_Channel[4])
+#define DMA1_Channel6 (&Emu_DMA1_Channel[5])
+#define DMA1_Channel7 (&Emu_DMA1_Channel[6])
+
+//
+// NVIC
+//
+typedef enum
+{
+	DMA1_Channel1_IRQn = 11,
+	USART1_IRQn = 37,
+	USART2_IRQn = 38,
+	USART3_IRQn = 39,
+} IRQn_Type;
+
+typedef struct
+{
+	uint8_t NVIC_IRQChannel;
+	uint8_t NVIC_IRQChannelPreemptionPriority;
+	uint8_t NVIC_IRQChannelSubPriority;
+	FunctionalState NVIC_IRQChannelCmd;
+} NVIC_InitTypeDef;
+
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct);
+
+//
+// RCC
+//
+#define RCC_AHBPeriph_DMA1 ((uint32_t)0x00000001)
+
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState);
+
+//
+// USART
+//
+#define USART_FLAG_TXE  ((uint16_t)0x0080)
+#define USART_FLAG_TC   ((uint16_t)0x0040)
+#define USART_FLAG_RXNE ((uint16_t)0x0020)
+#define USART_FLAG_IDLE ((uint16_t)0x0010)
+#define USART_FLAG_ORE  ((uint16_t)0x0008)
+#define USART_FLAG_NE   ((uint16_t)0x0004)
+#define USART_FLAG_FE   ((uint16_t)0x0002)
+
+#define USART_CR1_TXEIE ((uint16_t)0x0080)
+
+#define USART_IT_IDLE ((uint16_t)0x0424)
+#define USART_IT_RXNE ((uint16_t)0x0525)
+#define USART_IT_TXE  ((uint16_t)0x0727)
+
+#define USART_DMAReq_Tx ((uint16_t)0x0080)
+#define USART_DMAReq_Rx ((uint16_t)0x0040)
+
+    void USART_ITConfig(USART_TypeDef *USARTx, uint16_t USART_IT, FunctionalState NewState);
+    void USART_DMACmd(USART_TypeDef *USARTx, uint16_t USART_DMAReq, FunctionalState NewState);
+    void USART_SendData(USART_TypeDef *USARTx, uint16_t Data);
+uint16_t USART_ReceiveData(USART_TypeDef *USARTx);
+FlagStatus USART_GetFlagStatus(USART_TypeDef *USARTx, uint16_t USART_FLAG);
+
+//
+// DMA
+//
+#define DMA_DIR_PeripheralDST       ((uint32_t)0x00000010)
+#define DMA_DIR_PeripheralSRC       ((uint32_t)0x00000000)
+#define DMA_PeripheralInc_Disable   ((uint32_t)0x00000000)
+#define DMA_MemoryInc_Enable        ((uint32_t)0x00000080)
+#define DMA_PeripheralDataSize_Byte ((uint32_t)0x00000000)
+#define DMA_MemoryDataSize_Byte     ((uint32_t)0x00000000)
+#define DMA_Mode_Circular           ((uint32_t)0x00000020)
+#define DMA_Mode_Normal             ((uint32_t)0x00000000)
+#define DMA_Priority_Medium         ((uint32_t)0x00001000)
+#define DMA_M2M_Disable             ((uint32_t)0x00000000)
+
+#define DMA_IT_TC ((uint32_t)0x00000002)
+#define DMA_IT_HT ((uint32_t)0x00000004)
+
+#define DMA1_IT_GL1 ((uint32_t)0x00000001)
+
+typedef struct
+{
+	uint32_t DMA_PeripheralBaseAddr;
+	uint32_t DMA_MemoryBaseAddr;
+	uint32_t DMA_DIR;
+	uint32_t DMA_BufferSize;
+	uint32_t DMA_PeripheralInc;
+	uint32_t DMA_MemoryInc;
+	uint32_t DMA_PeripheralDataSize;
+	uint32_t DMA_MemoryDataSize;
+	uint32_t DMA_Mode;
+	uint32_t DMA_Priority;
+	uint32_t DMA_M2M;
+} DMA_InitTypeDef;
+
+void DMA_Init(DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct);
+void DMA_Cmd(DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState);
+void DMA_ITConfig(DMA_Channel_TypeDef *DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState);
+void DMA_ClearITPendingBit(uint32_t DMAy_IT);
+
+#endif
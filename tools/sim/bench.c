@@ -0,0 +1,540 @@
+/**
+  ******************************************************************************
+  * @file    bench.c
+  * @version V 1.0.0
+  * @brief   控制质量回归测试
+  *          在软件在环仿真器上运行一组标准场景（扰动、速度阶跃、原地转向、低电量、
+  *          负载变化、摔倒后扶起），控制代码原样编译，每个场景输出调节时间、
+  *          倾角峰值、倾角RMS、位置漂移、电能和每个控制周期占用的CPU周期数；
+  *          结果为JSON，修改控制代码前后各运行一次，用-c比较两次的结果
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o bench -Itools/sim -Iuser -Imy_lib tools/sim/plant.c tools/sim/sim_hal.c tools/sim/bench.c \
+  *              user/app_control.c user/app_motor.c \
+  *              my_lib/pid.c my_lib/lpf.c my_lib/cascade.c my_lib/lqr.c my_lib/qmath.c my_lib/trace.c \
+  *              my_lib/bus.c user/app_bus.c tools/common/app_stubs.c -lm
+  *
+  *          使用：./bench [-m pid|lqr|all] [-f 场景名] [-s 种子] [-o 结果.json] [-c 基准.json] [-r 容差%]
+  *          -c 与之前保存的结果逐项比较，任何一项变差超过容差（默认1%）时返回3；
+  *             CPU周期数受电脑负载影响，只列出不参与判定
+  *
+  *          控制代码中的静态变量无法复位，每个场景在fork出的子进程中从上电状态开始运行；
+  *          IMU噪声由固定的种子产生，相同的代码两次运行的结果完全相同
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "sim_hal.h"
+#include "app_control.h"
+#include "app_motor.h"
+#include "app_mpu6050.h"
+
+#define STEP_US 100           // 被控对象的积分步长
+#define SETTLE_BAND 1.0       // 调节时间的判定带，单位°
+#define FALL_ANGLE 80.0       // 与app_control.c判定摔倒的角度一致，单位°
+#define CONTROL_PERIOD_MS 5   // 与app_control.c一致，CPU周期数按控制周期平均
+
+typedef struct
+{
+	const char *Name;
+	double Duration;          // 仿真时长，单位s
+	double Theta0;            // 初始倾角，单位°
+	double EventTime;         // 扰动或指令的时刻，单位s，各项指标从此刻开始统计
+	double PushRate;          // 在EventTime给车体角速度叠加的值，单位rad/s（模拟推一下）
+	double Shove;             // 从EventTime开始向前推车体的外力矩，单位N.m（模拟持续推车）
+	double ShoveSpan;         // 外力矩持续的时间，单位s
+	float Speed, Turn;        // 在EventTime通过App_Control_Move下发，取值与串口move命令相同
+	double Vbat;              // 电池电压，单位V，0表示默认值
+	double PayloadMass;       // 在EventTime放到车体上的负载质量，单位kg，固件中的车体参数不变
+	double PayloadHeight;     // 负载到轮轴的高度，单位m
+	double HoldTime;          // 摔倒后扶起：在此刻把车体扶正并按住，单位s
+	double ReleaseTime;       // 摔倒后扶起：在此刻按启动键并松手，指标从此刻开始统计
+} Scenario_TypeDef;
+
+typedef struct
+{
+	int Fell;                 // 统计期间是否摔倒
+	double Settle;            // 调节时间，单位s，结束时仍未进入判定带为NAN
+	double PeakPitch;         // 倾角绝对值的最大值，单位°
+	double RmsPitch;          // 倾角的RMS，单位°
+	double Drift;             // 结束时的位置与指令位置之差，单位m
+	double Energy;            // 两个电机从电池取得的电能，单位J
+	double FallDetect;        // 车体越过80度到电机停机的时间，单位s，姿态解算先于实际越过80度时为负，没有摔倒为NAN
+	double CyclesPerStep;     // 每个控制周期（5ms内的各任务）占用的CPU周期数
+	double MaxCycles;         // 超级循环单次运行的最大CPU周期数
+	double NsPerStep;         // 每个控制周期占用的时间，单位ns
+} Result_TypeDef;
+
+static const Scenario_TypeDef scenarios[] =
+{
+	//  名称            时长  倾角 时刻 扰动  外力矩 持续 速度 转向 电压 负载  高度  扶正 松手
+	{ "push",           6,    0,   1,   2.0,  0,     0,   0,   0,   0,   0,    0,    0,   0 },
+	{ "step_speed",     8,    0,   1,   0,    0,     0,   20,  0,   0,   0,    0,    0,   0 },
+	{ "turn_in_place",  6,    0,   1,   0,    0,     0,   0,   30,  0,   0,    0,    0,   0 },
+	{ "low_battery",    6,    0,   1,   2.0,  0,     0,   0,   0,   6.4, 0,    0,    0,   0 },
+	{ "payload",        6,    0,   1,   0,    0,     0,   0,   0,   0,   0.10, 0.12, 0,   0 },
+	{ "fall_recover",   8,    0,   1,   0,    0.5,   0.5, 0,   0,   0,   0,    0,    3,   3.5 },
+};
+
+#define NUM_SCENARIOS (sizeof(scenarios) / sizeof(scenarios[0]))
+
+static double TimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+//
+// @简介：读取CPU的周期计数器，没有时以ns代替
+//
+static uint64_t Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return (uint64_t)TimeNs();
+#endif
+}
+
+//
+// @简介：测量两次连续读取周期计数器的最小间隔，从每次测量中扣除
+//
+static uint64_t CyclesOverhead(void)
+{
+	uint64_t best = UINT64_MAX;
+
+	for(int i=0; i<1000; i++)
+	{
+		uint64_t c0 = Cycles();
+		uint64_t c = Cycles() - c0;
+
+		if(c < best) best = c;
+	}
+
+	return best;
+}
+
+//
+// @简介：在当前进程中运行一个场景
+//
+static void Run(const Scenario_TypeDef *S, uint8_t Mode, Result_TypeDef *R)
+{
+	Plant_ParamTypeDef P;
+	Plant_DefaultParam(&P);
+
+	if(S->Vbat > 0) P.Vbat = S->Vbat;
+
+	Sim_Init(&P, -S->Theta0 * M_PI / 180); // 倾角theta向前为正，固件的pitch与之相反
+
+	// 与main.c相同的初始化顺序，然后模拟按下启动按键
+	App_Motor_Init();
+	App_MPU6050_Init();
+	App_Control_Init();
+	App_Control_SetMode(Mode);
+	App_Control_Reset();
+	App_Motor_Cmd(ENABLE);
+
+	const uint32_t endUs = (uint32_t)(S->Duration * 1e6 + 0.5);
+	const uint32_t eventUs = (uint32_t)(S->EventTime * 1e6 + 0.5);
+	const uint32_t shoveEndUs = eventUs + (uint32_t)(S->ShoveSpan * 1e6 + 0.5);
+	const uint32_t holdUs = S->HoldTime > 0 ? (uint32_t)(S->HoldTime * 1e6 + 0.5) : UINT32_MAX;
+	const uint32_t releaseUs = S->ReleaseTime > 0 ? (uint32_t)(S->ReleaseTime * 1e6 + 0.5) : UINT32_MAX;
+	const uint32_t startUs = releaseUs != UINT32_MAX ? releaseUs : eventUs; // 开始统计的时刻
+	const double vRef = S->Speed / 3.8 * P.rw; // App_Control_Move的速度指令对应的车速，单位m/s
+
+	double sumSq = 0, x0 = 0, lastOut = 0, fallUs = -1, offUs = -1;
+	unsigned long samples = 0;
+	uint64_t cycles = 0, maxCycles = 0;
+	const uint64_t overhead = CyclesOverhead();
+	const double wall0 = TimeNs();
+	const uint64_t tsc0 = Cycles();
+
+	memset(R, 0, sizeof(*R));
+	R->FallDetect = NAN;
+
+	while(sim.Us < endUs)
+	{
+		// 向前推，固件的pitch为正；外力矩只作用在车体上，忽略其对轮子的反作用
+		if(sim.Us >= eventUs && sim.Us < shoveEndUs) sim.Plant.dtheta -= S->Shove / sim.Plant.P.Jp * STEP_US * 1e-6;
+
+		if(sim.Us == eventUs)
+		{
+			sim.Plant.dtheta -= S->PushRate;
+
+			if(S->Speed != 0 || S->Turn != 0) App_Control_Move(S->Speed, S->Turn);
+
+			if(S->PayloadMass > 0)
+			{
+				Plant_ParamTypeDef *p = &sim.Plant.P;
+				double m = p->mp + S->PayloadMass;
+
+				p->Jp += S->PayloadMass * S->PayloadHeight * S->PayloadHeight;
+				p->lp = (p->mp * p->lp + S->PayloadMass * S->PayloadHeight) / m;
+				p->mp = m;
+			}
+		}
+
+		// 扶正并按住车体，松手时按下启动键，与app_button.c相同
+		if(sim.Us >= holdUs && sim.Us < releaseUs)
+		{
+			sim.Plant.theta = sim.Plant.dtheta = sim.Plant.ddtheta = 0;
+			sim.Plant.dx = sim.Plant.ddx = 0;
+		}
+
+		if(sim.Us == releaseUs)
+		{
+			App_Control_Reset();
+			App_Motor_Reset();
+			App_Motor_Cmd(ENABLE);
+		}
+
+		if(sim.Us == startUs) x0 = sim.Plant.x;
+
+		// 超级循环，各任务自行按周期运行
+		uint64_t c0 = Cycles();
+
+		App_MPU6050_Proc();
+		App_Motor_Proc();
+		App_Control_Proc();
+
+		uint64_t c = Cycles() - c0;
+
+		c = c > overhead ? c - overhead : 0;
+		cycles += c;
+		if(c > maxCycles) maxCycles = c;
+
+		if(offUs < 0 && App_Motor_GetState() == DISABLE) offUs = sim.Us;
+
+		Sim_Step(STEP_US);
+
+		double pitch = -sim.Plant.theta * 180 / M_PI;
+
+		if(fallUs < 0 && fabs(pitch) > FALL_ANGLE) fallUs = sim.Us;
+
+		if(sim.Us <= startUs) continue;
+
+		const Plant_TypeDef *pl = &sim.Plant;
+
+		if(fabs(pitch) > FALL_ANGLE) R->Fell = 1;
+
+		sumSq += pitch * pitch;
+		samples++;
+		if(fabs(pitch) > R->PeakPitch) R->PeakPitch = fabs(pitch);
+		if(fabs(pitch) > SETTLE_BAND) lastOut = (sim.Us - startUs) * 1e-6;
+
+		R->Energy += (fabs(pl->dutyL * pl->P.Vbat * pl->iL) + fabs(pl->dutyR * pl->P.Vbat * pl->iR)) * STEP_US * 1e-6;
+	}
+
+	double periods = sim.Us / 1000.0 / CONTROL_PERIOD_MS;
+	double window = (endUs - startUs) * 1e-6;
+	double nsPerCycle = (TimeNs() - wall0) / (double)(Cycles() - tsc0); // 周期计数器的频率不一定等于CPU的主频
+
+	if(fallUs >= 0 && offUs >= 0) R->FallDetect = (offUs - fallUs) * 1e-6;
+
+	R->RmsPitch = samples ? sqrt(sumSq / samples) : 0;
+	R->Settle = (R->Fell || lastOut >= window - STEP_US * 1e-6) ? NAN : lastOut;
+	R->Drift = sim.Plant.x - x0 - vRef * window;
+	R->CyclesPerStep = cycles / periods;
+	R->MaxCycles = maxCycles;
+	R->NsPerStep = cycles / periods * nsPerCycle;
+}
+
+//
+// @简介：在子进程中运行一个场景，结果经管道传回
+// @返回值：0 - 成功，-1 - 子进程异常退出
+//
+static int RunIsolated(const Scenario_TypeDef *S, uint8_t Mode, Result_TypeDef *R)
+{
+	int fd[2];
+
+	if(pipe(fd) != 0) { perror("pipe"); return -1; }
+
+	fflush(stdout);
+
+	pid_t pid = fork();
+
+	if(pid < 0) { perror("fork"); return -1; }
+
+	if(pid == 0)
+	{
+		Result_TypeDef r;
+
+		close(fd[0]);
+		Run(S, Mode, &r);
+		_exit(write(fd[1], &r, sizeof(r)) == sizeof(r) ? 0 : 1);
+	}
+
+	close(fd[1]);
+
+	ssize_t n = read(fd[0], R, sizeof(*R));
+	int status;
+
+	close(fd[0]);
+	waitpid(pid, &status, 0);
+
+	return (n == sizeof(*R) && WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+}
+
+static void PutNumber(FILE *f, const char *Key, double Value, int Digits)
+{
+	if(isnan(Value)) fprintf(f, ", \"%s\": null", Key);
+	else fprintf(f, ", \"%s\": %.*f", Key, Digits, Value);
+}
+
+//
+// @简介：输出一个场景的结果，每个场景占一行，便于-c逐行读取
+//
+static void PutResult(FILE *f, const char *Name, const char *Mode, const Result_TypeDef *R, int Last)
+{
+	fprintf(f, "    {\"name\": \"%s\", \"mode\": \"%s\", \"fell\": %s", Name, Mode, R->Fell ? "true" : "false");
+	PutNumber(f, "settle_s", R->Settle, 4);
+	PutNumber(f, "peak_pitch_deg", R->PeakPitch, 4);
+	PutNumber(f, "rms_pitch_deg", R->RmsPitch, 4);
+	PutNumber(f, "drift_m", R->Drift, 5);
+	PutNumber(f, "energy_j", R->Energy, 4);
+	PutNumber(f, "fall_detect_s", R->FallDetect, 4);
+	PutNumber(f, "cycles_per_step", R->CyclesPerStep, 0);
+	PutNumber(f, "max_cycles", R->MaxCycles, 0);
+	PutNumber(f, "ns_per_step", R->NsPerStep, 1);
+	fprintf(f, "}%s\n", Last ? "" : ",");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 与之前的结果比较
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	const char *Key;
+	double Floor;    // 小于此值的变化视为相同，避免在接近0时按比例判定
+	uint8_t Judged;  // 是否参与判定
+	uint8_t Abs;     // 按绝对值比较
+	uint8_t NanWorse; // 由有值变为null算作变差（调节时间：原来能进入判定带，现在不能）
+} Metric_TypeDef;
+
+static const Metric_TypeDef metrics[] =
+{
+	{ "settle_s",        0.005,  1, 0, 1 },
+	{ "peak_pitch_deg",  0.01,   1, 0, 0 },
+	{ "rms_pitch_deg",   0.005,  1, 0, 0 },
+	{ "drift_m",         0.001,  1, 1, 0 },
+	{ "energy_j",        0.01,   1, 0, 0 },
+	{ "fall_detect_s",   0.001,  1, 0, 0 },
+	{ "cycles_per_step", 0,      0, 0, 0 },
+};
+
+#define NUM_METRICS (sizeof(metrics) / sizeof(metrics[0]))
+
+//
+// @简介：从一行JSON中读出某个键的值
+// @参数：pValue - 输出参数，值为null时为NAN
+// @返回值：0 - 成功，-1 - 没有这个键
+//
+static int JsonGet(const char *Line, const char *Key, char *pString, size_t Size, double *pValue)
+{
+	char pattern[64];
+
+	snprintf(pattern, sizeof(pattern), "\"%s\": ", Key);
+
+	const char *p = strstr(Line, pattern);
+
+	if(p == NULL) return -1;
+
+	p += strlen(pattern);
+
+	if(pString != NULL)
+	{
+		size_t i = 0;
+
+		if(*p++ != '"') return -1;
+		while(*p && *p != '"' && i + 1 < Size) pString[i++] = *p++;
+		pString[i] = '\0';
+	}
+
+	if(pValue != NULL)
+	{
+		if(strncmp(p, "null", 4) == 0) *pValue = NAN;
+		else if(strncmp(p, "true", 4) == 0) *pValue = 1;
+		else if(strncmp(p, "false", 5) == 0) *pValue = 0;
+		else *pValue = strtod(p, NULL);
+	}
+
+	return 0;
+}
+
+//
+// @简介：在基准文件中查找同名同模式的场景
+// @返回值：0 - 找到，-1 - 没有找到
+//
+static int FindBaseline(FILE *f, const char *Name, const char *Mode, char *Line, size_t Size)
+{
+	char name[64], mode[16];
+
+	rewind(f);
+
+	while(fgets(Line, Size, f))
+	{
+		if(JsonGet(Line, "name", name, sizeof(name), NULL) != 0) continue;
+		if(JsonGet(Line, "mode", mode, sizeof(mode), NULL) != 0) continue;
+		if(strcmp(name, Name) == 0 && strcmp(mode, Mode) == 0) return 0;
+	}
+
+	return -1;
+}
+
+//
+// @简介：比较一个场景的结果，输出到stderr
+// @返回值：变差超过容差的指标个数
+//
+static int Compare(FILE *Baseline, const char *Name, const char *Mode, const Result_TypeDef *R, double Tolerance)
+{
+	char line[1024];
+	int worse = 0;
+
+	if(FindBaseline(Baseline, Name, Mode, line, sizeof(line)) != 0)
+	{
+		fprintf(stderr, "%-14s %-4s (not in baseline)\n", Name, Mode);
+		return 0;
+	}
+
+	const double now[NUM_METRICS] = { R->Settle, R->PeakPitch, R->RmsPitch, R->Drift, R->Energy, R->FallDetect, R->CyclesPerStep };
+	double fell = 0;
+
+	JsonGet(line, "fell", NULL, 0, &fell);
+
+	if(R->Fell && !fell)
+	{
+		fprintf(stderr, "%-14s %-4s fell (did not fall before)  WORSE\n", Name, Mode);
+		worse++;
+	}
+
+	for(size_t k=0; k<NUM_METRICS; k++)
+	{
+		const Metric_TypeDef *m = &metrics[k];
+		double before;
+
+		if(JsonGet(line, m->Key, NULL, 0, &before) != 0) continue;
+
+		double a = m->Abs ? fabs(before) : before;
+		double b = m->Abs ? fabs(now[k]) : now[k];
+		const char *verdict = "";
+
+		if(isnan(a) && isnan(b)) continue;
+
+		if(!m->Judged) verdict = "";
+		else if(isnan(a) || isnan(b)) verdict = (isnan(b) && m->NanWorse) ? "  WORSE" : "";
+		else if(b - a > fmax(m->Floor, fabs(a) * Tolerance)) verdict = "  WORSE";
+		else if(a - b > fmax(m->Floor, fabs(a) * Tolerance)) verdict = "  better";
+
+		if(strcmp(verdict, "  WORSE") == 0) worse++;
+
+		fprintf(stderr, "%-14s %-4s %-16s %12.5g -> %12.5g", Name, Mode, m->Key, before, now[k]);
+		if(!isnan(a) && !isnan(b) && a != 0) fprintf(stderr, " (%+.1f%%)", (b - a) / fabs(a) * 100);
+		fprintf(stderr, "%s\n", verdict);
+	}
+
+	return worse;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *only = NULL, *outPath = NULL, *basePath = NULL;
+	int modes = 3; // bit0 - pid，bit1 - lqr
+	double tolerance = 1;
+
+	for(int i=1; i<argc; i++)
+	{
+		const char *opt = argv[i];
+		const char *arg = i + 1 < argc ? argv[i+1] : NULL;
+
+		if(arg == NULL) { fprintf(stderr, "missing value for %s\n", opt); return 1; }
+		i++;
+
+		if(strcmp(opt, "-m") == 0) modes = strcmp(arg, "pid") == 0 ? 1 : strcmp(arg, "lqr") == 0 ? 2 : 3;
+		else if(strcmp(opt, "-f") == 0) only = arg;
+		else if(strcmp(opt, "-s") == 0) sim.Seed = strtoull(arg, NULL, 0);
+		else if(strcmp(opt, "-o") == 0) outPath = arg;
+		else if(strcmp(opt, "-c") == 0) basePath = arg;
+		else if(strcmp(opt, "-r") == 0) tolerance = atof(arg);
+		else { fprintf(stderr, "unknown option %s\n", opt); return 1; }
+	}
+
+	FILE *out = stdout;
+	FILE *baseline = NULL;
+
+	if(basePath)
+	{
+		baseline = fopen(basePath, "r");
+		if(baseline == NULL) { perror(basePath); return 1; }
+	}
+
+	if(outPath)
+	{
+		out = fopen(outPath, "w");
+		if(out == NULL) { perror(outPath); return 1; }
+	}
+
+	sim.Noise = 1;
+
+	int total = 0, worse = 0, failed = 0;
+
+	for(size_t i=0; i<NUM_SCENARIOS; i++)
+	{
+		if(only == NULL || strcmp(only, scenarios[i].Name) == 0) total += (modes & 1) + (modes >> 1);
+	}
+
+	if(total == 0) { fprintf(stderr, "no scenario named %s\n", only); return 1; }
+
+	fprintf(out, "{\n  \"step_us\": %d, \"settle_band_deg\": %g, \"seed\": %llu,\n  \"scenarios\": [\n",
+	        STEP_US, SETTLE_BAND, (unsigned long long)(sim.Seed ? sim.Seed : 1));
+
+	for(size_t i=0; i<NUM_SCENARIOS; i++)
+	{
+		const Scenario_TypeDef *s = &scenarios[i];
+
+		if(only != NULL && strcmp(only, s->Name) != 0) continue;
+
+		for(int k=0; k<2; k++)
+		{
+			if(!(modes & (1 << k))) continue;
+
+			const char *mode = k ? "lqr" : "pid";
+			Result_TypeDef r;
+
+			if(RunIsolated(s, k ? CONTROL_MODE_LQR : CONTROL_MODE_CASCADE, &r) != 0)
+			{
+				fprintf(stderr, "%s/%s: simulation crashed\n", s->Name, mode);
+				failed = 1;
+				memset(&r, 0, sizeof(r));
+				r.Fell = 1;
+				r.Settle = r.FallDetect = NAN;
+			}
+
+			PutResult(out, s->Name, mode, &r, --total == 0);
+
+			if(baseline) worse += Compare(baseline, s->Name, mode, &r, tolerance / 100);
+		}
+	}
+
+	fprintf(out, "  ]\n}\n");
+
+	if(out != stdout) fclose(out);
+
+	if(baseline)
+	{
+		fclose(baseline);
+		fprintf(stderr, "%d metric(s) worse than baseline by more than %g%%\n", worse, tolerance);
+	}
+
+	return failed ? 2 : worse ? 3 : 0;
+}
@@ -0,0 +1,176 @@
+/**
+  ******************************************************************************
+  * @file    plant.c
+  * @version V 1.0.0
+  * @brief   两轮自平衡小车的被控对象模型（仿真用）
+  *
+  * 广义坐标：轮轴位置x、车体倾角theta（向前倾为正）、偏航角psi。
+  * 由拉格朗日方程（轮子纯滚动，不打滑）：
+  *   (mp + 1.5*mw + 2*Jm/rw^2) x'' + mp*lp*cos(theta) theta'' - mp*lp*sin(theta) theta'^2 = (tL + tR)/rw
+  *   mp*lp*cos(theta) x'' + Jp theta'' - mp*g*lp*sin(theta) = -(tL + tR)
+  *   Izz psi'' = (tR - tL)/rw * track/2
+  * 其中tL、tR为电机作用在轮子上的转矩（车体受到反作用力矩），轮子视为均匀圆盘，
+  * 电机和减速器的转动惯量Jm近似为随轮子一起转动。
+  *
+  * 符号约定与固件一致：编码器和电机速度环的正方向为"轮子相对车体向后转"，
+  * 即 omega = -(phi' - theta')，这样控制代码中的omega_ref为正时小车向前加速。
+  ******************************************************************************
+  */
+
+#include "plant.h"
+#include <math.h>
+
+//
+// @简介：默认参数，取自user/app_control.c和user/app_motor.c
+//
+void Plant_DefaultParam(Plant_ParamTypeDef *P)
+{
+	P->rw = 0.032;
+	P->lp = 0.062;
+	P->mp = 0.12;
+	P->Jp = 4.6128e-4;
+	P->mw = 0.26;
+	P->track = 0.16;
+	P->Iz = 2.8e-4;
+	P->g = 9.8;
+	
+	P->La = 1.5e-3;
+	P->Ra = 3.0;
+	P->Kt = 0.176;
+	P->Ke = 0.176;
+	P->Jm = 2.787e-4;
+	P->B = 2.279e-4;
+	P->TIdle = 0.01;
+	
+	P->Vbat = 7.4;
+	P->ThetaMax = 1.45; // 约83度，略大于固件判定摔倒的80度
+}
+
+void Plant_Init(Plant_TypeDef *Plant, const Plant_ParamTypeDef *P, double Theta0)
+{
+	Plant->P = *P;
+	
+	Plant->x = Plant->dx = 0;
+	Plant->theta = Theta0;
+	Plant->dtheta = 0;
+	Plant->psi = Plant->dpsi = 0;
+	Plant->phiL = Plant->phiR = 0;
+	Plant->iL = Plant->iR = 0;
+	Plant->dutyL = Plant->dutyR = 0;
+	Plant->ddx = Plant->ddtheta = 0;
+	Plant->LastDt = 0;
+	Plant->Decay = 0;
+}
+
+//
+// @简介：电机模型，返回作用在轮子上的转矩（轮子前进方向为正）
+// @参数：pI - 电枢电流，输入输出参数
+// @参数：Duty - 占空比，-1..1
+// @参数：Omega - 电机转速（固件的正方向），单位rad/s
+// @参数：Decay - 电流的衰减系数 exp(-dt*Ra/La)
+//
+static double Motor(const Plant_ParamTypeDef *P, double *pI, double Duty, double Omega, double Decay)
+{
+	double V = Duty * P->Vbat;
+	
+	// 电流按一阶惯性环节的解析解更新，步长大于电气时间常数时也稳定
+	double iInf = (V - P->Ke * Omega) / P->Ra;
+	*pI = iInf + (*pI - iInf) * Decay;
+	
+	// 库仑摩擦在零速附近线性过渡，避免来回跳变
+	double friction = P->TIdle * (Omega > 0.1 ? 1 : Omega < -0.1 ? -1 : Omega / 0.1);
+	
+	double torque = P->Kt * *pI - P->B * Omega - friction;
+	
+	return -torque;
+}
+
+//
+// @简介：积分一步（半隐式欧拉法）
+// @参数：dt - 步长，单位s，建议不大于200us
+//
+void Plant_Step(Plant_TypeDef *Plant, double dt)
+{
+	const Plant_ParamTypeDef *P = &Plant->P;
+	
+	if(dt != Plant->LastDt)
+	{
+		Plant->LastDt = dt;
+		Plant->Decay = exp(-dt * P->Ra / P->La);
+	}
+	
+	double tL = Motor(P, &Plant->iL, Plant->dutyL, Plant_MotorSpeed_L(Plant), Plant->Decay);
+	double tR = Motor(P, &Plant->iR, Plant->dutyR, Plant_MotorSpeed_R(Plant), Plant->Decay);
+	
+	double s = sin(Plant->theta), c = cos(Plant->theta);
+	
+	// 求解关于x''和theta''的2x2线性方程组
+	double m11 = P->mp + 1.5 * P->mw + 2 * P->Jm / (P->rw * P->rw);
+	double m12 = P->mp * P->lp * c;
+	double m22 = P->Jp;
+	double f1 = (tL + tR) / P->rw + P->mp * P->lp * s * Plant->dtheta * Plant->dtheta;
+	double f2 = P->mp * P->g * P->lp * s - (tL + tR);
+	double det = m11 * m22 - m12 * m12;
+	
+	Plant->ddx = (f1 * m22 - m12 * f2) / det;
+	Plant->ddtheta = (m11 * f2 - m12 * f1) / det;
+	
+	// 车体已经触地且继续向地面倾倒时，倾角不再变化，轮子推着整车移动
+	if((Plant->theta >= P->ThetaMax && Plant->ddtheta > 0) || (Plant->theta <= -P->ThetaMax && Plant->ddtheta < 0))
+	{
+		Plant->ddtheta = 0;
+		Plant->ddx = f1 / m11;
+	}
+	
+	double izz = P->Iz + (0.75 * P->mw + P->Jm / (P->rw * P->rw)) * P->track * P->track / 2;
+	double ddpsi = (tR - tL) / P->rw * P->track / 2 / izz;
+	
+	Plant->dx += Plant->ddx * dt;
+	Plant->dtheta += Plant->ddtheta * dt;
+	Plant->dpsi += ddpsi * dt;
+	
+	Plant->x += Plant->dx * dt;
+	Plant->theta += Plant->dtheta * dt;
+	Plant->psi += Plant->dpsi * dt;
+	
+	// 倾倒后车体触地，非弹性碰撞
+	if(Plant->theta > P->ThetaMax)
+	{
+		Plant->theta = P->ThetaMax;
+		if(Plant->dtheta > 0) Plant->dtheta = 0;
+	}
+	if(Plant->theta < -P->ThetaMax)
+	{
+		Plant->theta = -P->ThetaMax;
+		if(Plant->dtheta < 0) Plant->dtheta = 0;
+	}
+	
+	Plant->phiL += (Plant->dx - Plant->dpsi * P->track / 2) / P->rw * dt;
+	Plant->phiR += (Plant->dx + Plant->dpsi * P->track / 2) / P->rw * dt;
+}
+
+//
+// @简介：左电机转速（固件的正方向），单位rad/s
+//
+double Plant_MotorSpeed_L(const Plant_TypeDef *Plant)
+{
+	return -((Plant->dx - Plant->dpsi * Plant->P.track / 2) / Plant->P.rw - Plant->dtheta);
+}
+
+double Plant_MotorSpeed_R(const Plant_TypeDef *Plant)
+{
+	return -((Plant->dx + Plant->dpsi * Plant->P.track / 2) / Plant->P.rw - Plant->dtheta);
+}
+
+//
+// @简介：左电机转过的角度（固件的正方向），单位rad
+//
+double Plant_MotorAngle_L(const Plant_TypeDef *Plant)
+{
+	return -(Plant->phiL - Plant->theta);
+}
+
+double Plant_MotorAngle_R(const Plant_TypeDef *Plant)
+{
+	return -(Plant->phiR - Plant->theta);
+}
@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    plant.h
+  * @version V 1.0.0
+  * @brief   两轮自平衡小车的被控对象模型（仿真用）
+  *          车体为绕轮轴摆动的倒立摆，左右各一个直流减速电机经PWM驱动，
+  *          电机转矩作用在轮子与车体之间
+  ******************************************************************************
+  */
+
+#ifndef PLANT_H
+#define PLANT_H
+
+typedef struct
+{
+	// 车体参数，与user/app_control.c一致
+	double rw;    // 轮胎半径，单位m
+	double lp;    // 摆的长度（轮轴到质心），单位m
+	double mp;    // 摆的质量，单位kg
+	double Jp;    // 摆绕轮轴的转动惯量，单位kg.m^2
+	double mw;    // 两个轮子的总质量，单位kg
+	double track; // 轮距，单位m
+	double Iz;    // 车体绕竖直轴的转动惯量，单位kg.m^2
+	double g;     // 重力加速度，单位m/s^2
+	
+	// 电机参数（每侧），与user/app_motor.c一致，均折算到减速器输出轴
+	double La;    // 电枢电感，单位H
+	double Ra;    // 电枢电阻，单位Ω
+	double Kt;    // 扭矩常数，单位N.m/A
+	double Ke;    // 反电动势常数，单位V/(rad/s)
+	double Jm;    // 电机及减速器的转动惯量，单位kg.m^2
+	double B;     // 粘滞摩擦系数，单位N.m/(rad/s)
+	double TIdle; // 库仑摩擦力矩，单位N.m
+	
+	double Vbat;  // 电池电压，单位V
+	double ThetaMax; // 车体倾倒后触地的角度，单位rad，须大于固件判定摔倒的80度
+} Plant_ParamTypeDef;
+
+typedef struct
+{
+	Plant_ParamTypeDef P;
+	
+	double x, dx;          // 轮轴的位置和速度，单位m、m/s
+	double theta, dtheta;  // 车体倾角及角速度，向前倾为正，单位rad、rad/s
+	double psi, dpsi;      // 偏航角及角速度，逆时针为正，单位rad、rad/s
+	double phiL, phiR;     // 左右轮相对地面转过的角度，单位rad
+	double iL, iR;         // 左右电机的电枢电流，单位A
+	double dutyL, dutyR;   // 左右PWM的占空比，-1..1
+	double ddx, ddtheta;   // 最近一步的加速度，用于计算加速度计的读数
+	double LastDt, Decay;  // 电流更新的衰减系数exp(-dt*Ra/La)，步长不变时无需重复计算
+} Plant_TypeDef;
+
+void Plant_DefaultParam(Plant_ParamTypeDef *P);
+void Plant_Init(Plant_TypeDef *Plant, const Plant_ParamTypeDef *P, double Theta0);
+void Plant_Step(Plant_TypeDef *Plant, double dt);
+double Plant_MotorSpeed_L(const Plant_TypeDef *Plant);
+double Plant_MotorSpeed_R(const Plant_TypeDef *Plant);
+double Plant_MotorAngle_L(const Plant_TypeDef *Plant);
+double Plant_MotorAngle_R(const Plant_TypeDef *Plant);
+
+#endif
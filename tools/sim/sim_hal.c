@@ -0,0 +1,417 @@
+/**
+  ******************************************************************************
+  * @file    sim_hal.c
+  * @version V 1.0.0
+  * @brief   仿真用的硬件替身
+  ******************************************************************************
+  */
+
+#include "sim_hal.h"
+#include "delay.h"
+#include "task.h"
+#include "app_pwm.h"
+#include "app_encoder.h"
+#include "app_bat.h"
+#include "app_mpu6050.h"
+#include "app_trace.h"
+#include "app_calibrator.h"
+#include "app_bus.h"
+#include <math.h>
+
+#define PWM_PERIOD 999 // 与user/app_pwm.c一致
+#define ENCODER_SCALE 0.01399402208920360588844895090594 // 每个边沿对应的轮子转角，单位rad（A相双边沿）
+
+Sim_TypeDef sim;
+
+//
+// 编码器：A相双边沿计数，记录最近两个边沿的时间和方向
+//
+typedef struct
+{
+	int32_t Count;
+	int8_t d0, d1;      // 最近两个边沿的方向，+1/-1，0表示尚无边沿
+	uint32_t t0, t1;    // 最近两个边沿的时间，单位us
+} Encoder_TypeDef;
+
+static Encoder_TypeDef encoder_l, encoder_r;
+static uint8_t pwmEnabled = 0;
+
+static double Gauss(void);
+static void Encoder_Update(Encoder_TypeDef *Encoder, double Angle, double LastAngle, uint32_t StepUs);
+static float Encoder_Speed(const Encoder_TypeDef *Encoder);
+
+void Sim_Init(const Plant_ParamTypeDef *P, double Theta0)
+{
+	Plant_Init(&sim.Plant, P, Theta0);
+	
+	sim.Us = 0;
+	
+	if(sim.Seed == 0) sim.Seed = 1;
+	if(sim.GyroNoise == 0) sim.GyroNoise = 0.05;   // MPU6050：0.005°/s/√Hz，带宽94Hz
+	if(sim.AccelNoise == 0) sim.AccelNoise = 0.004; // MPU6050：400ug/√Hz，带宽92Hz
+}
+
+//
+// @简介：被控对象前进一步，并更新编码器
+//
+void Sim_Step(uint32_t StepUs)
+{
+	double lastL = Plant_MotorAngle_L(&sim.Plant);
+	double lastR = Plant_MotorAngle_R(&sim.Plant);
+	
+	Plant_Step(&sim.Plant, StepUs * 1e-6);
+	
+	Encoder_Update(&encoder_l, Plant_MotorAngle_L(&sim.Plant), lastL, StepUs);
+	Encoder_Update(&encoder_r, Plant_MotorAngle_R(&sim.Plant), lastR, StepUs);
+	
+	sim.Us += StepUs;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// delay.h
+//////////////////////////////////////////////////////////////////////////
+
+void Delay_Init(void) {}
+
+uint32_t GetTick(void)
+{
+	return sim.Us / 1000;
+}
+
+uint32_t GetUs(void)
+{
+	return sim.Us;
+}
+
+// 仿真时间由主循环推进，控制代码中的阻塞延迟不消耗仿真时间
+void Delay(uint32_t ms) { (void)ms; }
+void DelayUs(uint32_t us) { (void)us; }
+
+//////////////////////////////////////////////////////////////////////////
+// app_pwm.h，占空比按定时器的分辨率量化
+//////////////////////////////////////////////////////////////////////////
+
+void App_PWM_Init(void) {}
+
+void App_PWM_Cmd(uint8_t State)
+{
+	pwmEnabled = State;
+	
+	if(!State)
+	{
+		sim.Plant.dutyL = 0;
+		sim.Plant.dutyR = 0;
+	}
+}
+
+static double PWM_Quantize(float Duty)
+{
+	if(!pwmEnabled) return 0;
+	
+	if(Duty >  100) Duty = 100;
+	if(Duty < -100) Duty = -100;
+	
+	uint16_t ccr = (uint16_t)(fabsf(Duty) / 100.0f * (PWM_PERIOD + 1));
+	
+	return (Duty >= 0 ? 1 : -1) * (double)ccr / (PWM_PERIOD + 1);
+}
+
+void App_PWM_Set_L(float Duty)
+{
+	sim.Plant.dutyL = PWM_Quantize(Duty);
+}
+
+void App_PWM_Set_R(float Duty)
+{
+	sim.Plant.dutyR = PWM_Quantize(Duty);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_bat.h
+//////////////////////////////////////////////////////////////////////////
+
+void App_Bat_Init(void) {}
+void App_Bat_Proc(void) {}
+
+float App_Bat_Get(void)
+{
+	return sim.Plant.P.Vbat;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_encoder.h，速度估计与user/app_encoder.c相同：
+// 用上一个边沿间隔估计速度，若当前间隔已经更长则认为在减速
+//////////////////////////////////////////////////////////////////////////
+
+void App_Encoder_Init(void) {}
+void App_Encoder_Proc(void) {}
+
+static void Encoder_Update(Encoder_TypeDef *Encoder, double Angle, double LastAngle, uint32_t StepUs)
+{
+	int32_t count = (int32_t)floor(Angle / ENCODER_SCALE);
+	
+	while(count != Encoder->Count)
+	{
+		int8_t d = count > Encoder->Count ? 1 : -1;
+		
+		Encoder->Count += d;
+		
+		// 按线性插值求出边沿在本步内发生的时刻
+		double edge = (Encoder->Count + (d > 0 ? 0 : 1)) * ENCODER_SCALE;
+		double frac = Angle != LastAngle ? (edge - LastAngle) / (Angle - LastAngle) : 1;
+		
+		if(frac < 0) frac = 0;
+		if(frac > 1) frac = 1;
+		
+		Encoder->t1 = Encoder->t0;
+		Encoder->t0 = sim.Us + (uint32_t)(frac * StepUs);
+		Encoder->d1 = Encoder->d0;
+		Encoder->d0 = d;
+	}
+}
+
+static float Encoder_Speed(const Encoder_TypeDef *Encoder)
+{
+	if(Encoder->d0 * Encoder->d1 <= 0) return 0.0f; // 方向改变时强制令速度为0
+	
+	uint32_t dt0 = Time_Diff(Encoder->t0, Encoder->t1);
+	uint32_t dtnow = Time_Diff(GetUs(), Encoder->t0);
+	
+	uint32_t T = dtnow > dt0 ? dtnow : dt0;
+	
+	if(T == 0) return 0.0f;
+	
+	return Encoder->d0 / Time_UsToSec(T) * (float)ENCODER_SCALE;
+}
+
+float App_Encoder_GetPos_L(void)
+{
+	return encoder_l.Count * (float)ENCODER_SCALE;
+}
+
+float App_Encoder_GetPos_R(void)
+{
+	return encoder_r.Count * (float)ENCODER_SCALE;
+}
+
+float App_Encoder_GetSpeed_L(void)
+{
+	return Encoder_Speed(&encoder_l);
+}
+
+float App_Encoder_GetSpeed_R(void)
+{
+	return Encoder_Speed(&encoder_r);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_mpu6050.h，按user/app_mpu6050.c的量程和换算系数量化原始值，
+// 并使用相同的互补滤波器
+//////////////////////////////////////////////////////////////////////////
+
+static float ax, ay, az, gx, gy, gz, yaw, roll, pitch;
+static uint8_t firstCompute = 1;
+
+static int16_t Raw(double Value, double Lsb)
+{
+	double r = floor(Value / Lsb + 0.5);
+	
+	if(r >  32767) r =  32767;
+	if(r < -32768) r = -32768;
+	
+	return (int16_t)r;
+}
+
+void App_MPU6050_Init(void) {}
+
+//
+// 与固件相同：每MPU6050_RATE_MS开始一次读取，每MPU6050_ATTITUDE_DIV次读取全部数据，其余只读x轴角速度；
+// 在开始读取时采样，经过I2C1的传输时间（tools/emu测得）后才发布，样本的时刻为开始读取的时刻
+//
+#define SIM_READ_GYRO_US 150 // 读取2字节
+#define SIM_READ_ALL_US  400 // 读取14字节
+
+enum { READ_NONE, READ_GYRO, READ_ALL };
+
+static uint8_t reading = READ_NONE;
+static uint32_t readStart;
+
+static void SampleAll(void);
+static void SampleGyro(void);
+static void Publish(uint8_t All);
+
+void App_MPU6050_Proc(void)
+{
+	if(reading != READ_NONE)
+	{
+		if(Time_Diff(GetUs(), readStart) < (reading == READ_ALL ? SIM_READ_ALL_US : SIM_READ_GYRO_US)) return;
+		
+		Publish(reading == READ_ALL);
+		reading = READ_NONE;
+	}
+	
+	PERIODIC(MPU6050_RATE_MS);
+	
+	static uint8_t phase = 0;
+	
+	readStart = GetUs();
+	
+	if(phase == 0)
+	{
+		SampleAll();
+		reading = READ_ALL;
+	}
+	else
+	{
+		SampleGyro();
+		reading = READ_GYRO;
+	}
+	
+	if(++phase >= MPU6050_ATTITUDE_DIV) phase = 0;
+}
+
+uint8_t App_MPU6050_IsReady(void)
+{
+	return 1;
+}
+
+uint8_t App_MPU6050_IsReading(void)
+{
+	return reading != READ_NONE;
+}
+
+static void SampleAll(void)
+{
+	const Plant_TypeDef *p = &sim.Plant;
+	double l = p->P.lp; // 传感器安装在质心高度
+	double s = sin(p->theta), c = cos(p->theta);
+	
+	// 传感器处的比力（加速度减去重力加速度），世界坐标系，x向前，z向上
+	double fx = p->ddx + l * c * p->ddtheta - l * s * p->dtheta * p->dtheta;
+	double fz = -l * s * p->ddtheta - l * c * p->dtheta * p->dtheta + p->P.g;
+	
+	// 投影到传感器坐标系：y轴沿车体向前，z轴沿车体向上
+	// 陀螺仪x轴与倾角theta反向（固件的pitch向后倾为正），z轴与偏航角psi同向
+	double fy_body = (fx * c - fz * s) / p->P.g;
+	double fz_body = (fx * s + fz * c) / p->P.g;
+	
+	double nG = sim.Noise ? sim.GyroNoise : 0;
+	double nA = sim.Noise ? sim.AccelNoise : 0;
+	
+	// 量程：加速度±2g，陀螺仪±2000°/s
+	ax = Raw(nA * Gauss(), 0.00006103515625) * 0.00006103515625f;
+	ay = Raw(fy_body + nA * Gauss(), 0.00006103515625) * 0.00006103515625f;
+	az = Raw(fz_body + nA * Gauss(), 0.00006103515625) * 0.00006103515625f;
+	gx = Raw(-p->dtheta * 57.295779513 + nG * Gauss(), 0.06097560975610) * 0.06097560975610f;
+	gy = Raw(nG * Gauss(), 0.06097560975610) * 0.06097560975610f;
+	gz = Raw(p->dpsi * 57.295779513 + nG * Gauss(), 0.06097560975610) * 0.06097560975610f;
+	
+	float pitch_accel = atan2f(ay, az) * 1.0f / 3.14159265f * 180.0f;
+	float roll_accel = -atan2f(ax, az) * 1.0f / 3.14159265f * 180.0f;
+	
+	if(firstCompute)
+	{
+		firstCompute = 0;
+		yaw = 0;
+		roll = roll_accel;
+		pitch = pitch_accel;
+	}
+	else
+	{
+		yaw = yaw + gz * 0.005;
+		roll = 0.95238 * (roll + gy * 0.005) + (1 - 0.95238) * roll_accel;
+		pitch = 0.95238 * (pitch + gx * 0.005) + (1 - 0.95238) * pitch_accel;
+	}
+	
+}
+
+static void SampleGyro(void)
+{
+	double nG = sim.Noise ? sim.GyroNoise : 0;
+	
+	gx = Raw(-sim.Plant.dtheta * 57.295779513 + nG * Gauss(), 0.06097560975610) * 0.06097560975610f;
+}
+
+//
+// @简介：发布样本供控制任务读取（app_bus.h），仿真中没有安装偏差
+//
+static void Publish(uint8_t All)
+{
+	if(All)
+	{
+		ImuSample_TypeDef *imu = Bus_Write(&ImuTopic);
+		
+		imu->Ax = ax; imu->Ay = ay; imu->Az = az;
+		imu->Gx = gx; imu->Gy = gy; imu->Gz = gz;
+		imu->Pitch = pitch; imu->Roll = roll; imu->Yaw = yaw;
+		imu->Temp = 25.0f;
+		
+		Bus_Publish(&ImuTopic, readStart);
+	}
+	
+	((GyroSample_TypeDef *)Bus_Write(&GyroTopic))->Gx = gx;
+	Bus_Publish(&GyroTopic, readStart);
+}
+
+float App_MPU6050_GetAccelX(void) { return ax; }
+float App_MPU6050_GetAccelY(void) { return ay; }
+float App_MPU6050_GetAccelZ(void) { return az; }
+float App_MPU6050_GetGyroX(void) { return gx; }
+float App_MPU6050_GetGyroY(void) { return gy; }
+float App_MPU6050_GetGyroZ(void) { return gz; }
+float App_MPU6050_GetTemperature(void) { return 25.0f; }
+float App_MPU6050_GetYaw(void) { return yaw; }
+float App_MPU6050_GetRoll(void) { return roll; }
+float App_MPU6050_GetPitch(void) { return pitch; }
+
+//////////////////////////////////////////////////////////////////////////
+// app_trace.h，仿真不需要记录输入
+//////////////////////////////////////////////////////////////////////////
+
+void App_Trace_Record(uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size)
+{
+	(void)Type; (void)Flags; (void)Us; (void)pData; (void)Size;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// app_calibrator.h，仿真不校准
+//////////////////////////////////////////////////////////////////////////
+
+uint8_t App_Calibrator_IsBusy(void)
+{
+	return 0;
+}
+
+//
+// @简介：标准正态分布随机数（xorshift64* + Box-Muller）
+//
+static double Gauss(void)
+{
+	static int haveSpare = 0;
+	static double spare;
+	
+	if(haveSpare)
+	{
+		haveSpare = 0;
+		return spare;
+	}
+	
+	double u[2];
+	
+	for(int i=0; i<2; i++)
+	{
+		sim.Seed ^= sim.Seed >> 12;
+		sim.Seed ^= sim.Seed << 25;
+		sim.Seed ^= sim.Seed >> 27;
+		u[i] = ((sim.Seed * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+	}
+	
+	if(u[0] < 1e-300) u[0] = 1e-300;
+	
+	double r = sqrt(-2 * log(u[0]));
+	
+	spare = r * sin(2 * M_PI * u[1]);
+	haveSpare = 1;
+	
+	return r * cos(2 * M_PI * u[1]);
+}
@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file    sim_hal.h
+  * @version V 1.0.0
+  * @brief   仿真用的硬件替身
+  *          以被控对象模型为数据源，实现控制代码所依赖的delay、PWM、编码器、
+  *          电池电压和MPU6050接口，包括PWM占空比、编码器边沿和IMU读数的量化
+  ******************************************************************************
+  */
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdint.h>
+#include "plant.h"
+
+typedef struct
+{
+	Plant_TypeDef Plant;
+	uint32_t Us;          // 仿真时间，单位us，GetUs()/GetTick()由此得出
+	uint8_t Noise;        // 1 - 给IMU读数叠加白噪声
+	uint64_t Seed;        // 噪声的随机数种子
+	double GyroNoise;     // 陀螺仪噪声的标准差，单位°/s
+	double AccelNoise;    // 加速度计噪声的标准差，单位g
+} Sim_TypeDef;
+
+extern Sim_TypeDef sim;
+
+void Sim_Init(const Plant_ParamTypeDef *P, double Theta0);
+void Sim_Step(uint32_t StepUs);
+
+#endif
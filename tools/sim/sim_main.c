@@ -0,0 +1,153 @@
+/**
+  ******************************************************************************
+  * @file    sim_main.c
+  * @version V 1.0.0
+  * @brief   软件在环仿真器
+  *          把user/app_control.c、user/app_motor.c以及my_lib中的pid、lpf、cascade、
+  *          lqr、qmath原样编译到电脑上，用被控对象模型代替真实的小车，
+  *          以仿真时间运行，不受真实时间的限制
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o sim -Itools/sim -Iuser -Imy_lib tools/sim/plant.c tools/sim/sim_hal.c tools/sim/sim_main.c \
+  *              user/app_control.c user/app_motor.c \
+  *              my_lib/pid.c my_lib/lpf.c my_lib/cascade.c my_lib/lqr.c my_lib/qmath.c my_lib/trace.c \
+  *              my_lib/bus.c user/app_bus.c tools/common/app_stubs.c -lm
+  *
+  *          使用：./sim [-t 秒] [-a 初始倾角°] [-m pid|lqr] [-v 速度] [-w 转向]
+  *                      [-n] [-s 种子] [-d 步长us] [-o trace.csv]
+  *          -v/-w 在第1秒时通过App_Control_Move下发，取值与串口move命令相同
+  *          -n 给IMU读数叠加噪声
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "sim_hal.h"
+#include "app_control.h"
+#include "app_motor.h"
+#include "app_mpu6050.h"
+
+static double WallTime(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	double duration = 60;  // 仿真时长，单位s
+	double theta0 = 5;     // 初始倾角，单位°
+	uint8_t mode = CONTROL_MODE_CASCADE;
+	float speed = 0, turn = 0;
+	uint32_t stepUs = 100; // 被控对象的积分步长
+	const char *tracePath = NULL;
+	
+	for(int i=1; i<argc; i++)
+	{
+		const char *opt = argv[i];
+		const char *arg = i + 1 < argc ? argv[i+1] : NULL;
+		
+		if(strcmp(opt, "-n") == 0) { sim.Noise = 1; continue; }
+		
+		if(arg == NULL) { fprintf(stderr, "missing value for %s\n", opt); return 1; }
+		i++;
+		
+		if(strcmp(opt, "-t") == 0) duration = atof(arg);
+		else if(strcmp(opt, "-a") == 0) theta0 = atof(arg);
+		else if(strcmp(opt, "-m") == 0) mode = strcmp(arg, "lqr") == 0 ? CONTROL_MODE_LQR : CONTROL_MODE_CASCADE;
+		else if(strcmp(opt, "-v") == 0) speed = atof(arg);
+		else if(strcmp(opt, "-w") == 0) turn = atof(arg);
+		else if(strcmp(opt, "-s") == 0) sim.Seed = strtoull(arg, NULL, 0);
+		else if(strcmp(opt, "-d") == 0) stepUs = atoi(arg);
+		else if(strcmp(opt, "-o") == 0) tracePath = arg;
+		else { fprintf(stderr, "unknown option %s\n", opt); return 1; }
+	}
+	
+	if(stepUs == 0 || stepUs > 1000) { fprintf(stderr, "step must be 1..1000us\n"); return 1; }
+	
+	FILE *trace = NULL;
+	
+	if(tracePath)
+	{
+		trace = fopen(tracePath, "w");
+		if(trace == NULL) { perror(tracePath); return 1; }
+		fprintf(trace, "t,pitch,gyro_x,gyro_z,x,dx,theta,dpsi,speed_l,speed_r,duty_l,duty_r\n");
+	}
+	
+	Plant_ParamTypeDef P;
+	Plant_DefaultParam(&P);
+	
+	Sim_Init(&P, theta0 * M_PI / 180); // 倾角theta向前为正，固件的pitch与之相反
+	
+	// 与main.c相同的初始化顺序，然后模拟按下启动按键
+	App_Motor_Init();
+	App_MPU6050_Init();
+	App_Control_Init();
+	App_Control_SetMode(mode);
+	App_Control_Reset();
+	App_Motor_Cmd(ENABLE);
+	
+	uint32_t endUs = (uint32_t)(duration * 1e6);
+	uint32_t settleUs = 1000000; // 1s之后开始统计
+	uint32_t nextTraceUs = 0;
+	double sumSq = 0, maxPitch = 0;
+	unsigned long samples = 0;
+	int fell = 0;
+	
+	double wall0 = WallTime();
+	
+	while(sim.Us < endUs)
+	{
+		if(sim.Us == 1000000 && (speed != 0 || turn != 0))
+		{
+			App_Control_Move(speed, turn);
+		}
+		
+		// 超级循环，各任务自行按周期运行
+		App_MPU6050_Proc();
+		App_Motor_Proc();
+		App_Control_Proc();
+		
+		Sim_Step(stepUs);
+		
+		double pitch = sim.Plant.theta * 180 / M_PI;
+		
+		if(fabs(sim.Plant.theta) >= P.ThetaMax) fell = 1;
+		
+		if(sim.Us >= settleUs)
+		{
+			sumSq += pitch * pitch;
+			samples++;
+			if(fabs(pitch) > maxPitch) maxPitch = fabs(pitch);
+		}
+		
+		if(trace && sim.Us >= nextTraceUs)
+		{
+			nextTraceUs += 5000;
+			fprintf(trace, "%.4f,%.3f,%.3f,%.3f,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,%.3f\n",
+			        sim.Us * 1e-6, App_MPU6050_GetPitch(), App_MPU6050_GetGyroX(), App_MPU6050_GetGyroZ(),
+			        sim.Plant.x, sim.Plant.dx, sim.Plant.theta, sim.Plant.dpsi,
+			        App_Motor_GetSpeed_L(), App_Motor_GetSpeed_R(), sim.Plant.dutyL, sim.Plant.dutyR);
+		}
+	}
+	
+	double wall = WallTime() - wall0;
+	
+	if(trace) fclose(trace);
+	
+	printf("mode        %s\n", mode == CONTROL_MODE_LQR ? "lqr" : "pid");
+	printf("sim time    %.3f s\n", sim.Us * 1e-6);
+	printf("wall time   %.3f ms (%.0fx real time)\n", wall * 1e3, sim.Us * 1e-6 / wall);
+	printf("fell        %s\n", fell ? "yes" : "no");
+	printf("pitch rms   %.4f deg\n", samples ? sqrt(sumSq / samples) : 0.0);
+	printf("pitch max   %.4f deg\n", maxPitch);
+	printf("position    %.4f m\n", sim.Plant.x);
+	printf("velocity    %.4f m/s\n", sim.Plant.dx);
+	printf("yaw rate    %.4f rad/s\n", sim.Plant.dpsi);
+	
+	return fell ? 2 : 0;
+}
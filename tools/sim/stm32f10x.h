@@ -0,0 +1,29 @@
+/**
+  ******************************************************************************
+  * @file    stm32f10x.h
+  * @version V 1.0.0
+  * @brief   仿真用的替身头文件
+  *          在电脑上编译控制代码时代替std_periph_driver/inc/stm32f10x.h，
+  *          只提供控制代码用到的类型和内核函数，不包含任何寄存器定义，
+  *          因此一旦控制代码直接访问外设，编译就会失败，便于及时发现
+  ******************************************************************************
+  */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+
+#define __STATIC_INLINE static inline
+
+// 仿真是单线程的，不存在中断抢占
+__STATIC_INLINE void __disable_irq(void) {}
+__STATIC_INLINE void __enable_irq(void) {}
+
+// 串口只作为不透明的句柄出现在函数原型中
+typedef struct USART_TypeDef USART_TypeDef;
+
+#endif
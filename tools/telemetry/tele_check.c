@@ -0,0 +1,764 @@
+/**
+  ******************************************************************************
+  * @file    tele_check.c
+  * @version V 1.0.0
+  * @brief   my_lib/telemetry.c和tools/telemetry/tele_decode.c的随机检查
+  *          1. 编解码的基本环节：COBS随机数据（含大量0x00和超过254字节的非零段）的往返、
+  *             zigzag变长整数的边界值、CRC-8能查出任意一位错误
+  *          2. 往返：用telemetry.c生成各种数据类型、分频系数的通道（含NaN、超出范围的浮点数、
+  *             整个32位范围内跳变的整数、tick的16位回绕），穿插SCHEMA帧、VALUE帧和其它模块的帧，
+  *             交给原样编译的tele_decode解码（-f），输出的CSV必须与发送的值逐行、逐个字符一致
+  *          3. 损坏的数据流：随机地翻转帧中的一位、丢弃整帧、发送端来不及发送（Telemetry_Drop），
+  *             解码端不得输出错误的值；此后的DATA帧被跳过，直到下一个KEY帧重新同步，
+  *             输出的行与按此规则推算的完全一致
+  *          4. 可写的通道：Telemetry_SetWritable的无效通道、重复登记和登记表已满，SCHEMA帧的可写标志；
+  *             Telemetry_Write对没有的通道、只读通道、超出范围（含边界外一点、NaN、inf）的值不修改变量
+  *             也不调用OnWrite，范围内（含边界）的值写入：浮点数原样，整数四舍五入（.5远离0），
+  *             应答的VALUE帧给出状态和修改后的值
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o tele_check -Iuser -Imy_lib -Itools/telemetry tools/telemetry/tele_check.c my_lib/telemetry.c -lm
+  *
+  *          使用：./tele_check [-n 每种情形的tick数] [-s 种子]
+  *          全部一致时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "telemetry.h"
+
+// 解码器原样编译进来，每种情形在子进程中从头运行一次
+#define main TeleDecode_Main
+#include "tele_decode.c"
+#undef main
+
+#define NUM_CHANNELS 12
+#define KEY_INTERVAL 50
+#define OTHER_FRAME  (TELEMETRY_FRAME_USER + 1) // 共用串口的其它模块的帧，例如黑匣子
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void Check(int Ok, const char *What, unsigned long A, unsigned long B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %lu, expected %lu\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 1. COBS、变长整数、CRC-8
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：按telemetry.h的格式写一个zigzag变长整数：7位一组，低位在前，最高位为1表示后面还有
+//
+static uint16_t Varint(uint8_t *pOut, int32_t Value)
+{
+	uint32_t zz = Value < 0 ? ~((uint32_t)Value << 1) : (uint32_t)Value << 1;
+	uint16_t n = 0;
+
+	do
+	{
+		pOut[n] = zz & 0x7f;
+		zz >>= 7;
+		if(zz != 0) pOut[n] |= 0x80;
+		n++;
+	} while(zz != 0);
+
+	return n;
+}
+
+static void Codec(unsigned long Count)
+{
+	static uint8_t data[600], enc[TELEMETRY_COBS_SIZE(600)], dec[TELEMETRY_COBS_SIZE(600)];
+
+	for(unsigned long n=0; n<Count; n++)
+	{
+		uint16_t len = Rand() % sizeof(data);
+		uint32_t zeros = Rand() % 4; // 0 - 没有0x00，其余 - 0x00的比例递增
+
+		for(uint16_t i=0; i<len; i++)
+		{
+			data[i] = (zeros && Rand() % (8 >> zeros) == 0) ? 0 : 1 + Rand() % 255;
+		}
+
+		uint16_t m = Telemetry_CobsEncode(data, len, enc);
+
+		Check(m <= TELEMETRY_COBS_SIZE(len), "cobs size", m, TELEMETRY_COBS_SIZE(len));
+		Check(memchr(enc, 0, m - 1) == NULL && enc[m - 1] == 0, "cobs no zero inside", m, 0);
+
+		int k = Telemetry_CobsDecode(enc, m - 1, dec);
+
+		Check(k == len && memcmp(dec, data, len) == 0, "cobs round trip", k, len);
+
+		// 任意一位错误都能被CRC-8查出
+		if(len > 0)
+		{
+			uint8_t crc = Telemetry_Crc8(data, len);
+			uint16_t i = Rand() % len;
+
+			data[i] ^= 1 << (Rand() % 8);
+			Check(Telemetry_Crc8(data, len) != crc, "crc single bit", i, len);
+		}
+	}
+
+	static const int32_t edges[] = {0, 1, -1, 63, -64, 64, -65, 8191, -8192, 8192, -8193,
+	                                1048575, -1048576, 134217727, -134217728, 134217728, INT32_MAX, INT32_MIN};
+
+	for(unsigned long n=0; n<sizeof(edges) / sizeof(edges[0]) + Count; n++)
+	{
+		int32_t v = n < sizeof(edges) / sizeof(edges[0]) ? edges[n] : (int32_t)(Rand() ^ (Rand() << 16)) >> (Rand() % 32);
+		uint8_t buf[8];
+		int32_t out = 0;
+		uint16_t len = Varint(buf, v);
+
+		Check(len <= 5, "varint size", len, 5);
+		Check(Telemetry_GetVarint(buf, len, &out) == len && out == v, "varint round trip", (unsigned long)out, (unsigned long)v);
+		Check(Telemetry_GetVarint(buf, len - 1, &out) < 0, "varint truncated", len, 0);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 2、3. 经tele_decode的往返
+//////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	const char *Name;
+	double Flip;        // 每帧翻转一位的概率
+	double Drop;        // 每帧在线路上丢失的概率
+	double Overrun;     // 每个DATA/KEY帧来不及发送（Telemetry_Drop）的概率
+} Case_TypeDef;
+
+typedef struct
+{
+	uint64_t Tick;
+	int32_t Value[NUM_CHANNELS];
+} Row_TypeDef;
+
+// 发送的变量
+static float f128, fbig, f1000;
+static int32_t i32, i32off;
+static int16_t i16;
+static uint16_t u16;
+static int8_t i8;
+static uint8_t u8, u8b;
+static float fslow, fnan;
+
+static Telemetry_TypeDef tele;
+static Row_TypeDef *expect; // 按推算应输出的各行
+static unsigned long numExpect;
+
+// 按tele_decode的规则推算的解码端状态
+static struct
+{
+	uint8_t Known[NUM_CHANNELS];
+	uint8_t Synced, HaveSeq, LastSeq;
+	int32_t Value[NUM_CHANNELS];
+	uint64_t Tick;  // 展开后的tick
+} model;
+
+static unsigned long sent, corrupted, lost, overruns, resyncs;
+
+//
+// @简介：第i个通道的值换算成的整数，与ReadChannel相同（浮点数的取值使乘以Scale后不会恰好落在.5上）
+//
+static int32_t Expected(int Channel)
+{
+	const Telemetry_ChannelTypeDef *ch = &tele.Channels[Channel];
+
+	switch(ch->Type)
+	{
+	case TELEMETRY_INT32:  return *(const int32_t *)ch->pValue;
+	case TELEMETRY_INT16:  return *(const int16_t *)ch->pValue;
+	case TELEMETRY_UINT16: return *(const uint16_t *)ch->pValue;
+	case TELEMETRY_INT8:   return *(const int8_t *)ch->pValue;
+	case TELEMETRY_UINT8:  return *(const uint8_t *)ch->pValue;
+	default: break;
+	}
+
+	double x = (double)*(const float *)ch->pValue * ch->Scale;
+
+	if(isnan(x)) return 0;
+	if(x > 1e9) return 1000000000;
+	if(x < -1e9) return -1000000000;
+
+	return (int32_t)lround(x);
+}
+
+static void Vary(void)
+{
+	f128 += (int32_t)(Rand() % 257 - 128) / 128.0f + 0.25f / 128; // 1/128的整数倍加1/4个分辨率
+	if(fabsf(f128) > 1000) f128 = 0.25f / 128;
+
+	fbig = (Rand() % 16 == 0) ? ((Rand() & 1) ? 3e9f : -3e9f) : (float)(int32_t)(Rand() % 2000001 - 1000000) + 0.25f;
+	f1000 = (float)(int32_t)(Rand() % 20001 - 10000) / 1000.0f;
+	fnan = (Rand() % 4 == 0) ? NAN : (Rand() % 4 == 0) ? INFINITY : (float)(Rand() % 100) + 0.25f;
+	i32 = (Rand() % 8 == 0) ? (int32_t)(Rand() ^ (Rand() << 16)) : i32 + (int32_t)(Rand() % 21) - 10;
+	i16 = (int16_t)Rand();
+	u16 += Rand() % 5;
+	i8 = (int8_t)Rand();
+	u8 = (uint8_t)Rand();
+	u8b = (Rand() % 32 == 0) ? (uint8_t)Rand() : u8b;
+	fslow += 0.5f;
+	i32off--;
+}
+
+static void Setup(void)
+{
+	f128 = fbig = f1000 = fslow = fnan = 0;
+	i32 = i32off = 0; i16 = 0; u16 = 0; i8 = 0; u8 = u8b = 0;
+
+	Telemetry_Init(&tele, KEY_INTERVAL);
+
+	// 多于8个通道，位图为2个字节；各种分频系数的组合都会出现
+	Telemetry_AddChannel(&tele, "f128", TELEMETRY_FLOAT, &f128, 128, 1);
+	Telemetry_AddChannel(&tele, "fbig", TELEMETRY_FLOAT, &fbig, 1, 2);
+	Telemetry_AddChannel(&tele, "i32", TELEMETRY_INT32, &i32, 1, 1);
+	Telemetry_AddChannel(&tele, "i16", TELEMETRY_INT16, &i16, 1, 3);
+	Telemetry_AddChannel(&tele, "u16", TELEMETRY_UINT16, &u16, 1, 5);
+	Telemetry_AddChannel(&tele, "i8", TELEMETRY_INT8, &i8, 1, 1);
+	Telemetry_AddChannel(&tele, "u8", TELEMETRY_UINT8, &u8, 1, 7);
+	Telemetry_AddChannel(&tele, "off", TELEMETRY_INT32, &i32off, 1, 0); // 关闭，-f时一直为0，中途开启
+	Telemetry_AddChannel(&tele, "f1000", TELEMETRY_FLOAT, &f1000, 1000, 4);
+	Telemetry_AddChannel(&tele, "u8b", TELEMETRY_UINT8, &u8b, 1, 1); // 多数时候不变，差值为0
+	Telemetry_AddChannel(&tele, "fslow", TELEMETRY_FLOAT, &fslow, 10, 1000);
+	Telemetry_AddChannel(&tele, "fnan", TELEMETRY_FLOAT, &fnan, 4, 1);
+
+	memset(&model, 0, sizeof(model));
+	numExpect = 0;
+	sent = corrupted = lost = overruns = resyncs = 0;
+}
+
+//
+// @简介：把一帧编码后写入数据流，按情形翻转其中一位或整帧丢失，并按tele_decode的规则更新推算的状态
+// @返回值：1 - 解码端完好地收到了这一帧
+//
+static int Emit(FILE *f, const Case_TypeDef *C, const uint8_t *pFrame, uint16_t Len)
+{
+	uint8_t enc[TELEMETRY_COBS_SIZE(TELEMETRY_MAX_FRAME)];
+	uint16_t m = Telemetry_CobsEncode(pFrame, Len, enc);
+
+	sent++;
+
+	if(C->Drop > 0 && Rand() % 1000000 < C->Drop * 1000000)
+	{
+		lost++;
+		return 0;
+	}
+
+	if(C->Flip > 0 && Rand() % 1000000 < C->Flip * 1000000)
+	{
+		// 只翻转数据字节（不是COBS的长度字节），且不翻成0x00，解码后恰好一位错误，CRC-8一定能查出
+		uint8_t isCode[sizeof(enc)] = {0};
+
+		for(uint16_t i=0; i<m - 1; i += enc[i]) isCode[i] = 1;
+
+		for(;;)
+		{
+			uint16_t i = Rand() % (m - 1);
+			uint8_t bit = 1 << (Rand() % 8);
+
+			if(isCode[i] || (enc[i] ^ bit) == 0) continue;
+
+			enc[i] ^= bit;
+			break;
+		}
+
+		fwrite(enc, 1, m, f);
+
+		corrupted++;
+		model.Synced = 0;
+		return 0;
+	}
+
+	fwrite(enc, 1, m, f);
+
+	return 1;
+}
+
+static void EmitData(FILE *f, const Case_TypeDef *C, const uint8_t *pFrame, uint16_t Len)
+{
+	if(!Emit(f, C, pFrame, Len)) return;
+
+	int key = pFrame[0] == TELEMETRY_FRAME_KEY;
+	uint8_t seq = pFrame[1];
+	uint16_t t = pFrame[2] | (pFrame[3] << 8);
+
+	if(model.HaveSeq && seq != (uint8_t)(model.LastSeq + 1)) model.Synced = 0;
+
+	model.LastSeq = seq;
+	model.HaveSeq = 1;
+
+	if(!key && !model.Synced) return;
+
+	for(int i=0; i<NUM_CHANNELS; i++)
+	{
+		if(!model.Known[i]) { model.Synced = 0; return; }
+	}
+
+	if(key && !model.Synced) resyncs++;
+
+	model.Synced = 1;
+
+	// 本帧含有的通道取发送时的值，其余沿用（-f）
+	for(int i=0; i<NUM_CHANNELS; i++)
+	{
+		if(pFrame[4 + i / 8] & (1 << (i % 8))) model.Value[i] = Expected(i);
+	}
+
+	model.Tick = numExpect == 0 ? t : model.Tick + (uint16_t)(t - (uint16_t)model.Tick);
+
+	expect[numExpect].Tick = model.Tick;
+	memcpy(expect[numExpect].Value, model.Value, sizeof(model.Value));
+	numExpect++;
+}
+
+static void EmitSchema(FILE *f, const Case_TypeDef *C, const uint8_t *pFrame, uint16_t Len)
+{
+	if(Emit(f, C, pFrame, Len)) model.Known[pFrame[1]] = 1;
+}
+
+//
+// @简介：生成一个情形的数据流
+//
+static void Generate(FILE *f, const Case_TypeDef *C, unsigned long Ticks)
+{
+	uint8_t frame[TELEMETRY_MAX_FRAME];
+
+	Setup();
+
+	for(unsigned long k=0; k<Ticks; k++)
+	{
+		Vary();
+
+		if(k == Ticks / 3) Telemetry_SetDivider(&tele, 7, 2); // 中途开启，随后为KEY帧
+		if(k == Ticks / 2) Telemetry_SetDivider(&tele, 3, 1);
+
+		uint16_t n = Telemetry_Sample(&tele, frame);
+
+		if(n > 0)
+		{
+			if(C->Overrun > 0 && Rand() % 1000000 < C->Overrun * 1000000)
+			{
+				Telemetry_Drop(&tele); // 没有发出，下一帧为KEY帧
+				overruns++;
+			}
+			else
+			{
+				EmitData(f, C, frame, n);
+			}
+		}
+
+		n = Telemetry_Schema(&tele, frame);
+
+		if(n > 0) EmitSchema(f, C, frame, n);
+
+		// 单次读取的应答和其它模块的帧，解码端不输出到CSV
+		if(Rand() % 64 == 0)
+		{
+			n = Telemetry_Value(&tele, Rand() % (NUM_CHANNELS + 2) - 1, TELEMETRY_STATUS_OK, frame);
+			Emit(f, C, frame, n);
+		}
+
+		if(Rand() % 64 == 0)
+		{
+			n = 0;
+			frame[n++] = OTHER_FRAME;
+
+			for(uint8_t len = Rand() % 40; len > 0; len--) frame[n++] = Rand() % 3 ? 0 : Rand();
+
+			frame[n] = Telemetry_Crc8(frame, n);
+			Emit(f, C, frame, n + 1);
+		}
+
+		// 两帧之间偶尔有多余的0x00，例如中途接入时
+		if(Rand() % 256 == 0) fputc(0, f);
+	}
+}
+
+//
+// @简介：在子进程中运行tele_decode -f -o Csv Capture
+// @返回值：tele_decode的返回值
+//
+static int Decode(const char *Capture, const char *Csv)
+{
+	fflush(stdout);
+
+	pid_t pid = fork();
+
+	if(pid == 0)
+	{
+		char *argv[] = {"tele_decode", "-f", "-o", (char *)Csv, (char *)Capture, NULL};
+
+		if(freopen("/dev/null", "w", stderr) == NULL) _exit(2); // 统计信息和VALUE帧的应答
+
+		_exit(TeleDecode_Main(5, argv));
+	}
+
+	int status = 0;
+
+	waitpid(pid, &status, 0);
+
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+//
+// @简介：逐行、逐个字符比较CSV
+//
+static void Compare(FILE *Csv)
+{
+	char line[1024], want[1024];
+	unsigned long r = 0;
+
+	// 表头
+	int n = snprintf(want, sizeof(want), "t");
+
+	for(int i=0; i<NUM_CHANNELS; i++) n += snprintf(want + n, sizeof(want) - n, ",%s", tele.Channels[i].Name);
+
+	if(fgets(line, sizeof(line), Csv) == NULL) line[0] = '\0';
+
+	line[strcspn(line, "\n")] = '\0';
+
+	Check(strcmp(line, want) == 0 || numExpect == 0, "csv header", strlen(line), strlen(want));
+
+	while(fgets(line, sizeof(line), Csv) != NULL)
+	{
+		line[strcspn(line, "\n")] = '\0';
+
+		if(r >= numExpect) { r++; continue; }
+
+		const Row_TypeDef *row = &expect[r];
+
+		n = snprintf(want, sizeof(want), "%.3f", (row->Tick - expect[0].Tick) * TELEMETRY_PERIOD_MS * 1e-3);
+
+		for(int i=0; i<NUM_CHANNELS; i++)
+		{
+			const Telemetry_ChannelTypeDef *ch = &tele.Channels[i];
+
+			n += snprintf(want + n, sizeof(want) - n, ",%.9g", Telemetry_ToValue(ch->Type, ch->Scale, row->Value[i]));
+		}
+
+		if(strcmp(line, want) != 0 && failures < 20)
+		{
+			printf("row %lu (tick %llu):\n  got      %s\n  expected %s\n", r, (unsigned long long)row->Tick, line, want);
+		}
+
+		Check(strcmp(line, want) == 0, "csv row", r, r);
+
+		r++;
+	}
+
+	Check(r == numExpect, "csv rows", r, numExpect);
+}
+
+static void RoundTrip(const Case_TypeDef *C, unsigned long Ticks)
+{
+	char capture[] = "/tmp/tele_check_XXXXXX", csv[] = "/tmp/tele_check_XXXXXX";
+	int fdCapture = mkstemp(capture), fdCsv = mkstemp(csv);
+
+	if(fdCapture < 0 || fdCsv < 0) { perror("mkstemp"); exit(2); }
+
+	FILE *f = fdopen(fdCapture, "wb");
+
+	expect = realloc(expect, Ticks * sizeof(Row_TypeDef));
+
+	Generate(f, C, Ticks);
+	fclose(f);
+
+	int ret = Decode(capture, csv);
+
+	Check(ret == 0, "tele_decode exit", ret, 0);
+
+	FILE *in = fdopen(fdCsv, "r");
+
+	Compare(in);
+	fclose(in);
+
+	unlink(capture);
+	unlink(csv);
+
+	printf("%-10s %lu frames, %lu corrupted, %lu lost, %lu overruns, %lu resyncs, %lu rows\n",
+	       C->Name, sent, corrupted, lost, overruns, resyncs, numExpect);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 4. 可写的通道
+//////////////////////////////////////////////////////////////////////////
+
+#define NUM_TYPED  6  // 各种数据类型的可写通道
+#define NUM_FILLER (TELEMETRY_MAX_WRITABLE - NUM_TYPED + 1) // 把登记表填满后多出一个
+
+static float wf;
+static int32_t wi32, ro;
+static int16_t wi16;
+static uint16_t wu16;
+static int8_t wi8;
+static uint8_t wu8;
+static int32_t filler[NUM_FILLER];
+static unsigned long onWrite;
+
+static void OnWrite(void)
+{
+	onWrite++;
+}
+
+//
+// @简介：通道变量当前的值
+//
+static double Read(const Telemetry_ChannelTypeDef *Ch)
+{
+	switch(Ch->Type)
+	{
+	case TELEMETRY_INT32:  return *(const int32_t *)Ch->pValue;
+	case TELEMETRY_INT16:  return *(const int16_t *)Ch->pValue;
+	case TELEMETRY_UINT16: return *(const uint16_t *)Ch->pValue;
+	case TELEMETRY_INT8:   return *(const int8_t *)Ch->pValue;
+	case TELEMETRY_UINT8:  return *(const uint8_t *)Ch->pValue;
+	default:               return *(const float *)Ch->pValue;
+	}
+}
+
+//
+// @简介：写入一次，检查返回的状态、变量、OnWrite的调用次数和应答的VALUE帧
+//
+static void Write(Telemetry_TypeDef *T, int8_t Channel, float Value, uint8_t Status)
+{
+	int valid = Channel >= 0 && Channel < T->NumChannels;
+	const Telemetry_ChannelTypeDef *ch = valid ? &T->Channels[Channel] : NULL;
+	double before = valid ? Read(ch) : 0, want = before;
+	unsigned long calls = onWrite;
+
+	if(Status == TELEMETRY_STATUS_OK)
+	{
+		// 整数四舍五入，.5远离0，在双精度下计算
+		want = ch->Type == TELEMETRY_FLOAT ? Value : trunc(Value);
+
+		if(ch->Type != TELEMETRY_FLOAT && fabs(Value - want) >= 0.5) want += Value > 0 ? 1 : -1;
+	}
+
+	uint8_t got = Telemetry_Write(T, Channel, Value);
+
+	if(got != Status && failures < 20)
+	{
+		printf("Telemetry_Write(%d, %a) = %u, expected %u\n", Channel, Value, got, Status);
+	}
+
+	Check(got == Status, "write status", got, Status);
+
+	if(!valid) return;
+
+	double after = Read(ch);
+
+	if(after != want && failures < 20)
+	{
+		printf("Telemetry_Write(%s, %a): variable %.9g, expected %.9g\n", ch->Name, Value, after, want);
+	}
+
+	Check(after == want, "written value", Channel, Status);
+	Check(onWrite - calls == (Status == TELEMETRY_STATUS_OK && T->Writables[ch->Writable].OnWrite != NULL),
+	      "OnWrite calls", onWrite - calls, Status == TELEMETRY_STATUS_OK);
+
+	// 应答：类型 通道号 状态 值（与KEY帧相同的换算） CRC8
+	uint8_t frame[TELEMETRY_VALUE_FRAME];
+	uint16_t len = Telemetry_Value(T, Channel, got, frame);
+	int32_t raw = 0;
+
+	Check(len >= 5 && frame[0] == TELEMETRY_FRAME_VALUE && frame[1] == (uint8_t)Channel && frame[2] == got,
+	      "value frame", len, 5);
+	Check(Telemetry_Crc8(frame, len - 1) == frame[len - 1], "value frame crc", len, 0);
+	Check(Telemetry_GetVarint(frame + 3, len - 4, &raw) == len - 4, "value frame varint", len, 0);
+
+	double scaled = ch->Type == TELEMETRY_FLOAT ? after * ch->Scale : after;
+
+	Check(fabs(raw - scaled) <= 0.5 + 1e-6 * fabs(scaled), "value frame value", (unsigned long)raw, (unsigned long)lround(scaled));
+}
+
+static void Writable(unsigned long Count)
+{
+	static Telemetry_TypeDef reg;
+	static const struct
+	{
+		const char *Name;
+		uint8_t Type;
+		void *pValue;
+		float Min, Max;
+	} typed[NUM_TYPED] = {
+		{"wf",   TELEMETRY_FLOAT,  &wf,   -1000,  1000},
+		{"wi32", TELEMETRY_INT32,  &wi32, -1e9f,  1e9f},
+		{"wi16", TELEMETRY_INT16,  &wi16, -32768, 32767},
+		{"wu16", TELEMETRY_UINT16, &wu16, 0,      65535},
+		{"wi8",  TELEMETRY_INT8,   &wi8,  -128,   127},
+		{"wu8",  TELEMETRY_UINT8,  &wu8,  0,      255},
+	};
+	static const char *names[NUM_FILLER] = {"x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10"};
+	int8_t ch[NUM_TYPED], chRo, chFiller[NUM_FILLER];
+	unsigned long outside = 0;
+
+	Telemetry_Init(&reg, KEY_INTERVAL);
+
+	for(int i=0; i<NUM_TYPED; i++) ch[i] = Telemetry_AddChannel(&reg, typed[i].Name, typed[i].Type, typed[i].pValue, 100, 0);
+
+	chRo = Telemetry_AddChannel(&reg, "ro", TELEMETRY_INT32, &ro, 1, 1);
+
+	for(int i=0; i<NUM_FILLER; i++) chFiller[i] = Telemetry_AddChannel(&reg, names[i], TELEMETRY_INT32, &filler[i], 1, 0);
+
+	// 登记：无效的通道、重复登记返回原来的序号、登记表已满
+	Check(Telemetry_SetWritable(&reg, -1, 0, 1, NULL) == -1, "writable invalid channel", 0, 0);
+	Check(Telemetry_SetWritable(&reg, reg.NumChannels, 0, 1, NULL) == -1, "writable invalid channel", reg.NumChannels, 0);
+
+	for(int i=0; i<NUM_TYPED; i++)
+	{
+		int8_t w = Telemetry_SetWritable(&reg, ch[i], 0, 0, NULL);
+
+		Check(w == i, "writable index", w, i);
+		Check(Telemetry_SetWritable(&reg, ch[i], typed[i].Min, typed[i].Max, i % 2 ? OnWrite : NULL) == w, "writable again", i, w);
+	}
+
+	for(int i=0; i<NUM_FILLER; i++)
+	{
+		int8_t w = Telemetry_SetWritable(&reg, chFiller[i], -10, 10, OnWrite);
+
+		Check(w == (i < NUM_FILLER - 1 ? NUM_TYPED + i : -1), "writable table full", (unsigned long)w, NUM_TYPED + i);
+	}
+
+	Check(reg.NumWritables == TELEMETRY_MAX_WRITABLE, "writables", reg.NumWritables, TELEMETRY_MAX_WRITABLE);
+
+	// SCHEMA帧的可写标志
+	uint8_t frame[TELEMETRY_MAX_FRAME];
+	uint16_t n;
+	int schemas = 0;
+
+	while((n = Telemetry_Schema(&reg, frame)) > 0)
+	{
+		uint8_t i = frame[1];
+		int writable = reg.Channels[i].Writable >= 0;
+
+		Check((frame[10] & TELEMETRY_FLAG_WRITABLE) == (writable ? TELEMETRY_FLAG_WRITABLE : 0), "schema writable flag", i, writable);
+		Check(writable == (i != chRo && i != chFiller[NUM_FILLER - 1]), "writable channel", i, writable);
+		schemas++;
+	}
+
+	Check(schemas == reg.NumChannels, "schema frames", schemas, reg.NumChannels);
+
+	// 没有的通道、只读的通道
+	Write(&reg, -1, 0, TELEMETRY_STATUS_UNKNOWN);
+	Write(&reg, reg.NumChannels, 0, TELEMETRY_STATUS_UNKNOWN);
+	Write(&reg, 127, 0, TELEMETRY_STATUS_UNKNOWN);
+	Write(&reg, chRo, 1, TELEMETRY_STATUS_READONLY);
+	Write(&reg, chFiller[NUM_FILLER - 1], 1, TELEMETRY_STATUS_READONLY);
+	Write(&reg, chFiller[0], 10, TELEMETRY_STATUS_OK);
+	Write(&reg, chFiller[0], 10.5f, TELEMETRY_STATUS_RANGE);
+
+	// 边界、边界外一点、NaN、inf，四舍五入的边界
+	for(int i=0; i<NUM_TYPED; i++)
+	{
+		float lo = typed[i].Min, hi = typed[i].Max;
+
+		Write(&reg, ch[i], lo, TELEMETRY_STATUS_OK);
+		Write(&reg, ch[i], hi, TELEMETRY_STATUS_OK);
+		Write(&reg, ch[i], nextafterf(lo, -INFINITY), TELEMETRY_STATUS_RANGE);
+		Write(&reg, ch[i], nextafterf(hi, INFINITY), TELEMETRY_STATUS_RANGE);
+		Write(&reg, ch[i], NAN, TELEMETRY_STATUS_RANGE);
+		Write(&reg, ch[i], -NAN, TELEMETRY_STATUS_RANGE);
+		Write(&reg, ch[i], INFINITY, TELEMETRY_STATUS_RANGE);
+		Write(&reg, ch[i], -INFINITY, TELEMETRY_STATUS_RANGE);
+
+		static const float halves[] = {0.5f, 1.5f, 2.5f, 0.49999997f, 0.50000006f, 1.4999999f, 126.5f, 8388607.5f, 8388609.0f, 16777215.0f};
+
+		for(size_t k=0; k<sizeof(halves) / sizeof(halves[0]); k++)
+		{
+			for(int sign=-1; sign<=1; sign+=2)
+			{
+				float v = sign * halves[k];
+
+				Write(&reg, ch[i], v, (v >= lo && v <= hi) ? TELEMETRY_STATUS_OK : TELEMETRY_STATUS_RANGE);
+			}
+		}
+	}
+
+	// 随机的值，约10%在范围外
+	for(unsigned long k=0; k<Count; k++)
+	{
+		int i = Rand() % NUM_TYPED;
+		double lo = typed[i].Min, hi = typed[i].Max, span = hi - lo;
+		float v;
+
+		switch(Rand() % 4)
+		{
+		case 0:  v = (float)(floor(lo + Rand() / 4294967296.0 * span) + 0.5); break; // .5
+		case 1:  v = nextafterf((float)(floor(lo + Rand() / 4294967296.0 * span) + 0.5), Rand() % 2 ? INFINITY : -INFINITY); break;
+		default: v = (float)(lo - 0.05 * span + Rand() / 4294967296.0 * 1.1 * span); break;
+		}
+
+		int inside = v >= typed[i].Min && v <= typed[i].Max;
+
+		outside += !inside;
+		Write(&reg, ch[i], v, inside ? TELEMETRY_STATUS_OK : TELEMETRY_STATUS_RANGE);
+	}
+
+	printf("%-10s %lu writes, %lu out of range\n", "writable", Count, outside);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 100000; // 超过65536，tick的16位回绕
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n ticks] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	static const Case_TypeDef cases[] =
+	{
+		{"clean",   0,     0,     0},
+		{"flip",    0.002, 0,     0},
+		{"drop",    0,     0.002, 0},
+		{"overrun", 0,     0,     0.002},
+		{"all",     0.005, 0.005, 0.005},
+	};
+
+	Codec(n);
+
+	for(size_t i=0; i<sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		RoundTrip(&cases[i], n);
+	}
+
+	Writable(n);
+
+	free(expect);
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
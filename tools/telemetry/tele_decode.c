@@ -0,0 +1,354 @@
+/**
+  ******************************************************************************
+  * @file    tele_decode.c
+  * @version V 1.0.0
+  * @brief   遥测解码器
+  *          读取单片机从USART2输出的遥测帧（格式见my_lib/telemetry.h，USART2_STREAM须为
+  *          USART2_STREAM_TELEMETRY），按0x00切分、COBS解码并校验CRC，由SCHEMA帧得到各通道的
+  *          名称和分辨率，从第一个KEY帧开始还原各通道的值，每帧输出CSV的一行：
+  *            t,通道1,通道2,...
+  *          t为单片机的tick换算成的秒数，本帧没有采样的通道留空（-f时沿用上一次的值）。
+  *          可以边采集边解码，每行输出后立即刷新
+  *
+  *          编译（在仓库根目录下）：
+  *          gcc -O2 -o tele_decode -Iuser -Imy_lib tools/telemetry/tele_decode.c my_lib/telemetry.c
+  *
+  *          采集和解码，例如
+  *          stty -F /dev/ttyUSB0 921600 raw && cat /dev/ttyUSB0 | ./tele_decode -o run.csv
+  *          调整采样率（通道名称见CSV的表头）：
+  *          printf 'rate * 1000\n' > /dev/ttyUSB0
+  *          printf 'rate bat 10\n' > /dev/ttyUSB0
+  *          读取、修改变量（VALUE帧的应答输出到stderr，可写的变量在通道描述中标有w）：
+  *          printf 'get d0_l\n' > /dev/ttyUSB0
+  *          printf 'set alpha_kp 8.5\n' > /dev/ttyUSB0
+  *          端到端延迟的直方图（user/app_latency.h）每秒一次，同样输出到stderr，单位us
+  *
+  *          使用：./tele_decode [-f] [-o out.csv] [capture.bin]
+  *          不指定文件时从标准输入读取，不指定-o时输出到标准输出，统计信息输出到stderr
+  *
+  *          注意：丢帧（序号不连续或CRC错误）后直到下一个KEY帧之前的帧无法还原，被跳过
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "telemetry.h"
+#include "app_telemetry.h"
+#include "app_latency.h"
+
+#define MAX_ENCODED 1024 // 超过此长度还没有遇到0x00的数据视为损坏
+
+typedef struct
+{
+	char Name[TELEMETRY_MAX_NAME + 1];
+	uint8_t Known;
+	uint8_t Type;
+	float Scale;
+	uint16_t Divider;
+	uint8_t Flags;
+	int32_t Value;
+} Channel_TypeDef;
+
+static Channel_TypeDef channels[TELEMETRY_MAX_CHANNELS];
+static int numChannels = 0;
+static int synced = 0;      // 各通道的值已由KEY帧确定
+static int headerDone = 0;
+static int fill = 0;
+static int haveSeq = 0;
+static uint8_t lastSeq;
+static uint16_t lastTick;
+static uint64_t tick = 0;   // 展开后的tick
+static uint64_t firstTick = 0;
+static FILE *out;
+
+// 统计
+static uint64_t bytes, frames, rows, badFrames, seqGaps, skipped;
+
+static int AllKnown(void)
+{
+	if(numChannels == 0) return 0;
+
+	for(int i=0; i<numChannels; i++)
+	{
+		if(!channels[i].Known) return 0;
+	}
+
+	return 1;
+}
+
+static void Header(void)
+{
+	fprintf(out, "t");
+
+	for(int i=0; i<numChannels; i++)
+	{
+		fprintf(out, ",%s", channels[i].Name);
+	}
+
+	fprintf(out, "\n");
+
+	headerDone = 1;
+}
+
+static void Schema(const uint8_t *pFrame, int Len)
+{
+	if(Len < 11) { badFrames++; return; }
+
+	int id = pFrame[1];
+	int count = pFrame[2];
+
+	if(id >= TELEMETRY_MAX_CHANNELS || count > TELEMETRY_MAX_CHANNELS || id >= count) { badFrames++; return; }
+
+	if(count != numChannels)
+	{
+		if(headerDone)
+		{
+			fprintf(stderr, "channel count changed %d -> %d, restarting header\n", numChannels, count);
+			headerDone = 0;
+		}
+
+		for(int i=0; i<TELEMETRY_MAX_CHANNELS; i++) channels[i].Known = 0;
+
+		numChannels = count;
+		synced = 0;
+	}
+
+	Channel_TypeDef *ch = &channels[id];
+	int nameLen = Len - 11;
+
+	if(nameLen > TELEMETRY_MAX_NAME) nameLen = TELEMETRY_MAX_NAME;
+
+	ch->Type = pFrame[3];
+	memcpy(&ch->Scale, pFrame + 4, 4);
+	ch->Divider = pFrame[8] | (pFrame[9] << 8);
+	ch->Flags = pFrame[10];
+	memcpy(ch->Name, pFrame + 11, nameLen);
+	ch->Name[nameLen] = '\0';
+	ch->Known = 1;
+}
+
+static void Data(const uint8_t *pFrame, int Len)
+{
+	int key = pFrame[0] == TELEMETRY_FRAME_KEY;
+	uint8_t seq = pFrame[1];
+	uint16_t t = pFrame[2] | (pFrame[3] << 8);
+	int maskLen = (numChannels + 7) / 8;
+
+	if(haveSeq && seq != (uint8_t)(lastSeq + 1))
+	{
+		seqGaps++;
+		synced = 0;
+	}
+
+	lastSeq = seq;
+	haveSeq = 1;
+
+	if(!key && !synced) { skipped++; return; }
+	if(!AllKnown() || Len < 4 + maskLen) { skipped++; synced = 0; return; }
+
+	// 只在确认整帧可以解码后才更新各通道的值
+	int32_t values[TELEMETRY_MAX_CHANNELS];
+	uint8_t present[TELEMETRY_MAX_CHANNELS] = {0};
+	int pos = 4 + maskLen;
+
+	for(int i=0; i<numChannels; i++)
+	{
+		if(!(pFrame[4 + i / 8] & (1 << (i % 8)))) continue;
+
+		int32_t v;
+		int n = Telemetry_GetVarint(pFrame + pos, Len - pos, &v);
+
+		if(n < 0) { badFrames++; synced = 0; return; }
+
+		pos += n;
+		values[i] = key ? v : (int32_t)((uint32_t)channels[i].Value + (uint32_t)v);
+		present[i] = 1;
+	}
+
+	if(pos != Len) { badFrames++; synced = 0; return; }
+
+	if(!headerDone)
+	{
+		Header();
+		tick = firstTick = t;
+	}
+	else
+	{
+		tick += (uint16_t)(t - lastTick);
+	}
+
+	lastTick = t;
+	synced = 1;
+
+	fprintf(out, "%.3f", (tick - firstTick) * TELEMETRY_PERIOD_MS * 1e-3);
+
+	for(int i=0; i<numChannels; i++)
+	{
+		if(present[i]) channels[i].Value = values[i];
+
+		if(present[i] || fill)
+		{
+			fprintf(out, ",%.9g", Telemetry_ToValue(channels[i].Type, channels[i].Scale, channels[i].Value));
+		}
+		else
+		{
+			fprintf(out, ",");
+		}
+	}
+
+	fprintf(out, "\n");
+	fflush(out);
+
+	rows++;
+}
+
+//
+// @简介：get、set命令的应答，输出到stderr
+//
+static void Value(const uint8_t *pFrame, int Len)
+{
+	static const char *status[] = {"ok", "unknown", "read-only", "out of range"};
+
+	if(Len < 3) { badFrames++; return; }
+
+	int id = pFrame[1];
+	const char *st = pFrame[2] < sizeof(status) / sizeof(status[0]) ? status[pFrame[2]] : "?";
+	int32_t raw;
+
+	if(id >= numChannels || !channels[id].Known || Telemetry_GetVarint(pFrame + 3, Len - 3, &raw) < 0)
+	{
+		fprintf(stderr, "value: channel %d, %s\n", id, st);
+		return;
+	}
+
+	Channel_TypeDef *ch = &channels[id];
+
+	fprintf(stderr, "value: %s%s = %.9g, %s\n", ch->Name, (ch->Flags & TELEMETRY_FLAG_WRITABLE) ? " (w)" : "",
+	        Telemetry_ToValue(ch->Type, ch->Scale, raw), st);
+}
+
+//
+// @简介：端到端延迟的直方图（user/app_latency.h），输出到stderr，只列出有样本的桶
+//
+static void Latency(const uint8_t *pFrame, int Len)
+{
+	if(Len < 12 || Len != 12 + pFrame[1] * 4) { badFrames++; return; }
+
+	int bins = pFrame[1];
+	int width = pFrame[2] | pFrame[3] << 8;
+	uint32_t n = pFrame[4] | pFrame[5] << 8 | pFrame[6] << 16 | (uint32_t)pFrame[7] << 24;
+	uint32_t max = pFrame[8] | pFrame[9] << 8 | pFrame[10] << 16 | (uint32_t)pFrame[11] << 24;
+
+	fprintf(stderr, "latency: %u samples, max %u us |", n, max);
+
+	for(int k=0; k<bins; k++)
+	{
+		const uint8_t *p = pFrame + 12 + k * 4;
+		uint32_t count = p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+
+		if(count == 0) continue;
+
+		if(k == bins - 1) fprintf(stderr, " >=%d: %u", k * width, count);
+		else              fprintf(stderr, " %d-%d: %u", k * width, (k + 1) * width, count);
+	}
+
+	fprintf(stderr, "\n");
+}
+
+static void Frame(const uint8_t *pData, int Len)
+{
+	uint8_t frame[MAX_ENCODED];
+
+	if(Len == 0) return; // 连续的0x00，例如刚接入时
+
+	int n = Telemetry_CobsDecode(pData, Len, frame);
+
+	if(n < 2 || Telemetry_Crc8(frame, n - 1) != frame[n - 1])
+	{
+		badFrames++;
+		synced = 0;
+		return;
+	}
+
+	frames++;
+	n--;
+
+	switch(frame[0])
+	{
+		case TELEMETRY_FRAME_SCHEMA: Schema(frame, n); break;
+		case TELEMETRY_FRAME_DATA:
+		case TELEMETRY_FRAME_KEY:    Data(frame, n); break;
+		case TELEMETRY_FRAME_VALUE:  Value(frame, n); break;
+		case LATENCY_FRAME:          Latency(frame, n); break;
+		default:                     if(frame[0] < TELEMETRY_FRAME_USER) badFrames++; break; // 其它模块的帧（如黑匣子）跳过
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = NULL, *csvPath = NULL;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-f")) fill = 1;
+		else if(!strcmp(argv[i], "-o") && i + 1 < argc) csvPath = argv[++i];
+		else if(argv[i][0] != '-') path = argv[i];
+		else
+		{
+			fprintf(stderr, "usage: %s [-f] [-o out.csv] [capture.bin]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	FILE *in = path ? fopen(path, "rb") : stdin;
+
+	if(in == NULL) { perror(path); return 1; }
+
+	out = csvPath ? fopen(csvPath, "w") : stdout;
+
+	if(out == NULL) { perror(csvPath); return 1; }
+
+	uint8_t buf[MAX_ENCODED];
+	int len = 0;
+	int discard = 0; // 过长的数据丢弃到下一个0x00为止；中途接入时的半帧由CRC剔除
+	int c;
+
+	while((c = fgetc(in)) != EOF)
+	{
+		bytes++;
+
+		if(c == 0)
+		{
+			if(!discard) Frame(buf, len);
+
+			len = 0;
+			discard = 0;
+		}
+		else if(len < MAX_ENCODED)
+		{
+			buf[len++] = c;
+		}
+		else
+		{
+			badFrames++;
+			discard = 1;
+		}
+	}
+
+	double seconds = (tick - firstTick) * TELEMETRY_PERIOD_MS * 1e-3;
+
+	fprintf(stderr, "bytes %llu, frames %llu, rows %llu, bad %llu, seq gaps %llu, skipped %llu\n",
+	        (unsigned long long)bytes, (unsigned long long)frames, (unsigned long long)rows,
+	        (unsigned long long)badFrames, (unsigned long long)seqGaps, (unsigned long long)skipped);
+
+	if(seconds > 0)
+	{
+		fprintf(stderr, "%.3f s, %.1f KB/s\n", seconds, bytes / seconds / 1000.0);
+	}
+
+	if(out != stdout) fclose(out);
+	if(in != stdin) fclose(in);
+
+	return 0;
+}
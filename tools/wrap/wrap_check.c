@@ -0,0 +1,436 @@
+/**
+  ******************************************************************************
+  * @file    wrap_check.c
+  * @version V 1.0.0
+  * @brief   32位时间戳回绕的检查
+  *          GetTick()约49.7天、GetUs()约71.6分钟回绕一次，台架上很难等到，
+  *          这里把驱动仿真器（tools/emu）的时间直接拨到回绕前，检查：
+  *          1. Time_Diff、Time_Reached：跨过0xFFFFFFFF->0的固定用例和随机用例
+  *          2. PERIODIC、PERIODIC_LATE、PERIODIC_START：截止时刻跨过回绕时，任务仍然按周期准时执行，
+  *             PERIODIC_LATE给出的落后时间为0；被阻塞时给出阻塞的时长
+  *          3. PID_Compute1、PID_Compute2、LPF_Calc：时间戳跨过回绕与不跨过回绕（整体平移）时，
+  *             Δt相同，输出逐位相同
+  *          4. 编码器测速（app_encoder.c原样编译，EXTI方式）：GetUs()在匀速运行中途回绕时，
+  *             每1ms读取的速度与不回绕时相同、与真实速度的误差在容差内；
+  *             停转的台阶跨过回绕时，速度读数单调下降且不为负
+  *          5. PID_TypeDef、LPF_TypeDef：时间戳为32位，结构体中没有按8字节对齐的成员，打印两者的大小
+  *
+  *          编译（在仓库根目录下，tools/emu/stm32f10x.h代替标准库的头文件）：
+  *          gcc -O2 -o wrap_check -Itools/emu -Iuser -Imy_lib tools/emu/emu.c tools/emu/emu_i2c.c \
+  *              tools/emu/emu_quad.c tools/wrap/wrap_check.c user/app_encoder.c my_lib/pid.c my_lib/lpf.c \
+  *              tools/common/app_stubs.c -lm
+  *
+  *          使用：./wrap_check [-n 随机用例数] [-s 种子]
+  *          全部通过时返回0，否则返回1
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "emu.h"
+#include "emu_quad.h"
+#include "delay.h"
+#include "task.h"
+#include "pid.h"
+#include "lpf.h"
+#include "app_encoder.h"
+#include "app_calibrator.h"
+#include "app_trace.h"
+
+#define RAD_PER_EDGE 0.01399402208920360588844895090594 // 与app_encoder.c相同
+
+#define CYCLES_PER_MS ((uint64_t)EMU_CPU_HZ / 1000)
+#define CYCLES_PER_US ((uint64_t)EMU_CPU_HZ / 1000000)
+#define US_WRAP       ((uint64_t)1 << 32) // GetUs()回绕的时刻，单位us
+
+static unsigned long checks = 0, failures = 0;
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t Rand(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void Check(int Ok, const char *What, double A, double B)
+{
+	checks++;
+
+	if(!Ok)
+	{
+		if(failures < 20)
+		{
+			printf("MISMATCH %s: got %.9g, expected %.9g\n", What, A, B);
+		}
+
+		failures++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 校准器和记录模块的替身（与tools/emu/emu_main.c相同，其余见tools/common/app_stubs.c）
+//////////////////////////////////////////////////////////////////////////
+
+static CaliResult_TypeDef cali;
+
+const CaliResult_TypeDef *App_Calibrator_GetResult(void)
+{
+	return &cali;
+}
+
+void App_Trace_Record(uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size)
+{
+	(void)Type; (void)Flags; (void)Us; (void)pData; (void)Size;
+}
+
+static void WaitUntil(uint64_t Cycles)
+{
+	if(Cycles > emu.Cycles) Emu_Advance((uint32_t)(Cycles - emu.Cycles));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 1. Time_Diff、Time_Reached
+//////////////////////////////////////////////////////////////////////////
+
+static void TimeFunctions(unsigned long Count)
+{
+	Check(Time_Diff(0x10, 0xfffffff0) == 0x20, "Time_Diff across wrap", Time_Diff(0x10, 0xfffffff0), 0x20);
+	Check(Time_Diff(0, 0xffffffff) == 1, "Time_Diff 0xffffffff->0", Time_Diff(0, 0xffffffff), 1);
+	Check(Time_Reached(0x10, 0xfffffff0) == 1, "Time_Reached after wrap", Time_Reached(0x10, 0xfffffff0), 1);
+	Check(Time_Reached(0xfffffff0, 0x10) == 0, "Time_Reached before wrap", Time_Reached(0xfffffff0, 0x10), 0);
+	Check(Time_Reached(0, 0) == 1, "Time_Reached equal", Time_Reached(0, 0), 1);
+	Check(Time_Reached(0xffffffff, 0) == 0, "Time_Reached 1 before", Time_Reached(0xffffffff, 0), 0);
+	Check(Time_Reached(0x7fffffff, 0) == 1, "Time_Reached 2^31-1 after", Time_Reached(0x7fffffff, 0), 1);
+
+	for(unsigned long i=0; i<Count; i++)
+	{
+		uint32_t a = Rand() ^ (Rand() << 16);
+		uint32_t d = (Rand() ^ (Rand() << 16)) & 0x7ffffffe; // 相距不超过2^31-1
+
+		if(i % 2) a = 0xffffffff - (d >> (Rand() % 31)); // 一半的用例跨过回绕
+
+		Check(Time_Diff(a + d, a) == d, "Time_Diff random", Time_Diff(a + d, a), d);
+		Check(Time_Reached(a + d, a) == 1, "Time_Reached random", Time_Reached(a + d, a), 1);
+		Check(Time_Reached(a, a + d + 1) == 0, "Time_Reached random early", Time_Reached(a, a + d + 1), 0);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 2. PERIODIC、PERIODIC_LATE、PERIODIC_START
+//////////////////////////////////////////////////////////////////////////
+
+#define TASK_MAX_RUNS 64
+
+static uint32_t taskPeriod;
+static uint32_t taskRuns[TASK_MAX_RUNS], taskNumRuns;
+static uint32_t lateRuns[TASK_MAX_RUNS], lateNumRuns, lateLast, lateMax;
+static uint32_t blockRuns[TASK_MAX_RUNS], blockNumRuns;
+
+static void Task(void)
+{
+	PERIODIC(taskPeriod);
+
+	if(taskNumRuns < TASK_MAX_RUNS) taskRuns[taskNumRuns] = GetTick();
+	taskNumRuns++;
+}
+
+static void Late(void)
+{
+	PERIODIC_LATE(taskPeriod, late);
+
+	if(lateNumRuns < TASK_MAX_RUNS) lateRuns[lateNumRuns] = GetTick();
+	lateNumRuns++;
+	lateLast = late;
+	if(late > lateMax) lateMax = late;
+}
+
+static void Block(void)
+{
+	PERIODIC_START(BLOCK, taskPeriod)
+		if(blockNumRuns < TASK_MAX_RUNS) blockRuns[blockNumRuns] = GetTick();
+		blockNumRuns++;
+	PERIODIC_END
+}
+
+static void Periodic(void)
+{
+	const uint32_t first = 0xffffffc0; // 第一个截止时刻，其后第13个截止时刻跨过回绕
+	const uint32_t period = 5;
+	const uint32_t end = 0x40;         // 回绕后继续运行到此时刻
+
+	Emu_Reset();
+
+	// 任务中的nxt是静态变量，先以一个很长的周期执行一次，把截止时刻放到回绕前
+	taskPeriod = first;
+	Task();
+	Late();
+	Block();
+
+	taskPeriod = period;
+	taskNumRuns = 0;
+	lateNumRuns = 0;
+	lateMax = 0;
+	blockNumRuns = 0;
+
+	emu.Cycles = (uint64_t)(first - 0x40) * CYCLES_PER_MS;
+
+	// 每0.25ms轮询一次，任务在截止时刻所在的那一毫秒内执行
+	for(uint64_t t = emu.Cycles; (uint32_t)(emu.Cycles / CYCLES_PER_MS) != end; t += CYCLES_PER_MS / 4)
+	{
+		WaitUntil(t);
+		Task();
+		Late();
+		Block();
+	}
+
+	uint32_t expected = (uint32_t)(0x40 + end) / period + 1; // [first, end]之间的截止时刻数
+
+	Check(taskNumRuns == expected, "PERIODIC runs", taskNumRuns, expected);
+	Check(lateNumRuns == expected, "PERIODIC_LATE runs", lateNumRuns, expected);
+	Check(lateMax == 0, "PERIODIC_LATE on time", lateMax, 0);
+	Check(blockNumRuns == expected, "PERIODIC_START runs", blockNumRuns, expected);
+
+	for(uint32_t i=0; i<expected && i<TASK_MAX_RUNS; i++)
+	{
+		Check(taskRuns[i] == first + i * period, "PERIODIC tick", taskRuns[i], first + i * period);
+		Check(lateRuns[i] == first + i * period, "PERIODIC_LATE tick", lateRuns[i], first + i * period);
+		Check(blockRuns[i] == first + i * period, "PERIODIC_START tick", blockRuns[i], first + i * period);
+	}
+
+	// 在下一个截止时刻之后7ms才执行（例如被其它任务阻塞），随后连续补跑，落后时间依次减少一个周期
+	uint32_t deadline = first + expected * period;
+
+	WaitUntil(emu.Cycles + (uint64_t)(Time_Diff(deadline, GetTick()) + 7) * CYCLES_PER_MS);
+
+	Late();
+	Check(lateLast == 7, "PERIODIC_LATE blocked", lateLast, 7);
+
+	Late();
+	Check(lateLast == 7 - period, "PERIODIC_LATE catching up", lateLast, 7 - period);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 3. PID_Compute1、PID_Compute2、LPF_Calc
+//////////////////////////////////////////////////////////////////////////
+
+static void ContinuousTime(unsigned long Count)
+{
+	PID_InitTypeDef PID_InitStruct = {0};
+
+	PID_InitStruct.Kp = 1.3f;
+	PID_InitStruct.Ki = 4.0f;
+	PID_InitStruct.Kd = 0.02f;
+	PID_InitStruct.Setpoint = 0.5f;
+	PID_InitStruct.OutputUpperLimit = 100;
+	PID_InitStruct.OutputLowerLimit = -100;
+
+	PID_TypeDef pid1[2], pid2[2];
+	LPF_TypeDef lpf[2];
+
+	for(int k=0; k<2; k++)
+	{
+		PID_Init(&pid1[k], &PID_InitStruct);
+		PID_LpfConfig(&pid1[k], 0.02f, 1);
+		PID_Init(&pid2[k], &PID_InitStruct);
+		LPF_Init(&lpf[k], 0.01f);
+	}
+
+	// 两组时间戳相差一个常数：第0组从0x10000000开始不回绕，第1组在第Count/2次附近回绕
+	uint32_t now[2];
+
+	now[0] = 0x10000000;
+	now[1] = 0xffffffff - (Count / 2) * 5000;
+
+	float input = 0;
+
+	for(unsigned long i=0; i<Count; i++)
+	{
+		uint32_t dt = 4000 + Rand() % 2001; // 5ms附近抖动
+		float dInputDt = ((float)(Rand() % 2001) - 1000.0f) * 0.01f;
+
+		input += dInputDt * dt * 1.0e-6f;
+
+		float out1[2], out2[2], outLpf[2];
+
+		for(int k=0; k<2; k++)
+		{
+			now[k] += dt;
+
+			out1[k] = PID_Compute1(&pid1[k], input, now[k]);
+			out2[k] = PID_Compute2(&pid2[k], input, dInputDt, now[k]);
+			outLpf[k] = LPF_Calc(&lpf[k], input, now[k]);
+		}
+
+		Check(memcmp(&out1[0], &out1[1], sizeof(float)) == 0, "PID_Compute1 across wrap", out1[1], out1[0]);
+		Check(memcmp(&out2[0], &out2[1], sizeof(float)) == 0, "PID_Compute2 across wrap", out2[1], out2[0]);
+		Check(memcmp(&outLpf[0], &outLpf[1], sizeof(float)) == 0, "LPF_Calc across wrap", outLpf[1], outLpf[0]);
+		Check(fabsf(out1[1]) <= 100, "PID_Compute1 bounded", out1[1], 100);
+	}
+
+	Check(now[1] < now[0], "PID timestamps wrapped", now[1], now[0]);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 4. 编码器测速
+//////////////////////////////////////////////////////////////////////////
+
+#define SPEED_MS   500 // 每种速度运行的时长
+#define SETTLE_MS  20  // 启动后的前几个边沿速度为0，不参与比较
+
+static Emu_Quad_TypeDef quadL, quadR;
+
+//
+// @简介：从StartUs（GetUs()的值）开始以固定速度运行编码器，每1ms读取一次速度
+//
+static void RunSpeed(uint64_t StartUs, double Speed, float *pL, float *pR)
+{
+	Emu_Reset();
+
+	emu.Cycles = StartUs * CYCLES_PER_US;
+
+	Emu_Quad_InitTypeDef Quad_InitStruct = {GPIOB, GPIO_Pin_14, GPIO_Pin_15, 0.5f, 0.25f, 1.0f, 1};
+
+	Emu_Quad_Init(&quadL, &Quad_InitStruct);
+
+	Quad_InitStruct.A_Pin = GPIO_Pin_3;
+	Quad_InitStruct.B_Pin = GPIO_Pin_4;
+	Quad_InitStruct.Seed = 8;
+
+	Emu_Quad_Init(&quadR, &Quad_InitStruct);
+
+	cali.encoder_duty_l = 0.5f;
+	cali.encoder_duty_r = 0.5f;
+
+	App_Encoder_Init();
+
+	Emu_Quad_SetSpeed(&quadL, Speed);
+	Emu_Quad_SetSpeed(&quadR, -Speed * 0.9); // 右轮反向安装
+
+	uint64_t t0 = emu.Cycles;
+
+	for(int ms=1; ms<=SPEED_MS; ms++)
+	{
+		WaitUntil(t0 + (uint64_t)ms * CYCLES_PER_MS);
+
+		pL[ms - 1] = App_Encoder_GetSpeed_L();
+		pR[ms - 1] = App_Encoder_GetSpeed_R();
+	}
+}
+
+static void EncoderSpeed(void)
+{
+	static const double speeds[] = {100, 400, 1100, -400}; // 周期/s，1100约为1m/s
+
+	for(int s=0; s<4; s++)
+	{
+		float l[2][SPEED_MS], r[2][SPEED_MS];
+
+		RunSpeed(1000000, speeds[s], l[0], r[0]);                   // 不回绕
+		RunSpeed(US_WRAP - SPEED_MS * 1000 / 2, speeds[s], l[1], r[1]); // 运行到一半时GetUs()回绕
+
+		double truthL = 2 * speeds[s] * RAD_PER_EDGE;
+		double truthR = 2 * speeds[s] * 0.9 * RAD_PER_EDGE;
+
+		for(int ms=SETTLE_MS; ms<SPEED_MS; ms++)
+		{
+			Check(fabs(l[1][ms] - l[0][ms]) <= 1e-4 * fabs(truthL), "left speed across wrap", l[1][ms], l[0][ms]);
+			Check(fabs(r[1][ms] - r[0][ms]) <= 1e-4 * fabs(truthR), "right speed across wrap", r[1][ms], r[0][ms]);
+			Check(fabs(l[1][ms] - truthL) <= 0.02 * fabs(truthL), "left speed vs truth", l[1][ms], truthL);
+			Check(fabs(r[1][ms] - truthR) <= 0.02 * fabs(truthR), "right speed vs truth", r[1][ms], truthR);
+		}
+	}
+}
+
+//
+// @简介：停转前的最后一个边沿在回绕前，之后的读数以当前台阶已持续的时间计算，应当单调下降
+//
+static void EncoderStop(void)
+{
+	Emu_Reset();
+
+	emu.Cycles = (US_WRAP - 200000) * CYCLES_PER_US;
+
+	Emu_Quad_InitTypeDef Quad_InitStruct = {GPIOB, GPIO_Pin_14, GPIO_Pin_15, 0.5f, 0.25f, 0, 1};
+
+	Emu_Quad_Init(&quadL, &Quad_InitStruct);
+
+	cali.encoder_duty_l = 0.5f;
+
+	App_Encoder_Init();
+
+	Emu_Quad_SetSpeed(&quadL, 200);
+
+	WaitUntil((US_WRAP - 3000) * CYCLES_PER_US); // 边沿间隔1.25ms，最后一个边沿距回绕不超过1.25ms
+
+	Emu_Quad_SetSpeed(&quadL, 0);
+
+	float last = App_Encoder_GetSpeed_L();
+
+	Check(last > 0, "speed before stop", last, 2 * 200 * RAD_PER_EDGE);
+
+	for(int ms=1; ms<=100; ms++)
+	{
+		WaitUntil((US_WRAP - 3000 + (uint64_t)ms * 1000) * CYCLES_PER_US);
+
+		float v = App_Encoder_GetSpeed_L();
+
+		Check(v >= 0 && v <= last, "speed decays across wrap", v, last);
+
+		last = v;
+	}
+
+	Check(last < 0.1f * 2 * 200 * RAD_PER_EDGE, "speed after stop", last, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 5. 结构体大小
+//////////////////////////////////////////////////////////////////////////
+
+//
+// @简介：64位时间戳使PID_TypeDef、LPF_TypeDef按8字节对齐（PID_TypeDef 112字节、LPF_TypeDef 16字节），
+//        改为32位之后按4字节对齐
+//
+static void StructSize(void)
+{
+	PID_TypeDef pid;
+	LPF_TypeDef lpf;
+
+	Check(sizeof(pid.LastTime) == 4, "PID_TypeDef.LastTime size", sizeof(pid.LastTime), 4);
+	Check(sizeof(lpf.LastTime) == 4, "LPF_TypeDef.LastTime size", sizeof(lpf.LastTime), 4);
+	Check(_Alignof(PID_TypeDef) == 4, "PID_TypeDef alignment", _Alignof(PID_TypeDef), 4);
+	Check(_Alignof(LPF_TypeDef) == 4, "LPF_TypeDef alignment", _Alignof(LPF_TypeDef), 4);
+
+	printf("sizeof     PID_TypeDef %u, LPF_TypeDef %u\n", (unsigned)sizeof(PID_TypeDef), (unsigned)sizeof(LPF_TypeDef));
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long n = 1000000;
+
+	for(int i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) n = strtoul(argv[++i], NULL, 0);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) rng = strtoull(argv[++i], NULL, 0) | 1;
+		else
+		{
+			fprintf(stderr, "usage: %s [-n cases] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	TimeFunctions(n);
+	Periodic();
+	ContinuousTime(n / 10);
+	EncoderSpeed();
+	EncoderStop();
+	StructSize();
+
+	printf("%lu checks, %lu mismatches\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
@@ -1,8 +1,8 @@
-#ifndef APP_BAT_VOLT_MONITOR_H
-#define APP_BAT_VOLT_MONITOR_H
-
-void App_Bat_Init(void);
-float App_Bat_Get(void);
-void App_Bat_Proc(void);
-
-#endif
+#ifndef APP_BAT_VOLT_MONITOR_H
+#define APP_BAT_VOLT_MONITOR_H
+
+void App_Bat_Init(void);
+float App_Bat_Get(void);
+void App_Bat_Proc(void);
+
+#endif
@@ -0,0 +1,142 @@
+#include "app_blackbox.h"
+#include "app_telemetry.h"
+#include "task.h"
+
+//
+// 导出时每BLACKBOX_DUMP_PERIOD_MS发送一帧，每帧BLACKBOX_RECORDS_PER_FRAME条记录（编码后约180字节），
+// 约18KB/s，与默认采样率的遥测一起远低于串口的带宽，全部记录约0.4s发完。
+// 队列放不下时下次重发同一帧，不会丢失记录
+//
+#define BLACKBOX_DUMP_PERIOD_MS     10
+#define BLACKBOX_RECORDS_PER_FRAME  4
+
+static BlackBox_TypeDef blackbox;
+static BlackBoxRecord_TypeDef records[BLACKBOX_DEPTH];
+static uint8_t initialized = 0;
+
+static uint8_t dumpId = 0; // 导出序号，解码端据此区分多次导出
+static int32_t dumpNext = -1; // 下一帧的第一条记录，-1表示先发HEADER
+
+static uint16_t MakeHeader(uint8_t *pOut);
+static uint16_t MakeData(uint8_t *pOut, uint16_t First);
+
+//
+// @简介：初始化黑匣子
+// @注意：控制任务可能在此之前取记录的位置，因此App_BlackBox_Next也会调用本函数
+//
+void App_BlackBox_Init(void)
+{
+	if(initialized) return;
+
+	BlackBox_Init(&blackbox, records, sizeof(BlackBoxRecord_TypeDef), BLACKBOX_DEPTH, BLACKBOX_POST_TRIGGER);
+
+	initialized = 1;
+}
+
+//
+// @简介：取得本周期记录的位置，由控制任务直接填写
+// @返回值：记录的地址，已冻结（等待导出）时返回NULL
+//
+BlackBoxRecord_TypeDef *App_BlackBox_Next(void)
+{
+	App_BlackBox_Init();
+
+	return (BlackBoxRecord_TypeDef *)BlackBox_Next(&blackbox);
+}
+
+//
+// @简介：触发，冻结触发前后的记录并导出；已触发、尚未导出完毕时忽略
+// @参数：Reason - 触发原因，BLACKBOX_REASON_xxx
+// @参数：Us - 触发的时刻，单位us
+//
+void App_BlackBox_Trigger(uint8_t Reason, uint32_t Us)
+{
+	App_BlackBox_Init();
+
+	BlackBox_Trigger(&blackbox, Reason, Us);
+}
+
+//
+// @简介：冻结后在后台导出，导出完毕后重新开始记录
+//
+void App_BlackBox_Proc(void)
+{
+	PERIODIC(BLACKBOX_DUMP_PERIOD_MS);
+
+	if(!initialized || blackbox.State != BLACKBOX_STATE_FROZEN) return;
+
+	uint8_t frame[4 + BLACKBOX_RECORDS_PER_FRAME * sizeof(BlackBoxRecord_TypeDef) + 1];
+	uint16_t len;
+
+	if(dumpNext < 0)
+	{
+		len = MakeHeader(frame);
+	}
+	else
+	{
+		len = MakeData(frame, dumpNext);
+	}
+
+	if(App_Telemetry_Send(frame, len) != 0) return; // 下次重发
+
+	if(dumpNext < 0)
+	{
+		dumpNext = 0;
+	}
+	else
+	{
+		dumpNext += BLACKBOX_RECORDS_PER_FRAME;
+	}
+
+	if(dumpNext >= BlackBox_GetCount(&blackbox))
+	{
+		dumpNext = -1;
+		dumpId++;
+		BlackBox_Arm(&blackbox);
+	}
+}
+
+static uint16_t MakeHeader(uint8_t *pOut)
+{
+	uint16_t count = BlackBox_GetCount(&blackbox);
+	uint16_t n = 0;
+
+	pOut[n++] = BLACKBOX_FRAME_HEADER;
+	pOut[n++] = BLACKBOX_VERSION;
+	pOut[n++] = dumpId;
+	pOut[n++] = blackbox.Reason;
+	pOut[n++] = blackbox.TriggerUs;
+	pOut[n++] = blackbox.TriggerUs >> 8;
+	pOut[n++] = blackbox.TriggerUs >> 16;
+	pOut[n++] = blackbox.TriggerUs >> 24;
+	pOut[n++] = count;
+	pOut[n++] = count >> 8;
+	pOut[n++] = blackbox.PreTrigger;
+	pOut[n++] = blackbox.PreTrigger >> 8;
+	pOut[n++] = sizeof(BlackBoxRecord_TypeDef);
+	pOut[n] = Telemetry_Crc8(pOut, n);
+
+	return n + 1;
+}
+
+static uint16_t MakeData(uint8_t *pOut, uint16_t First)
+{
+	uint16_t count = BlackBox_GetCount(&blackbox);
+	uint16_t n = 0;
+
+	pOut[n++] = BLACKBOX_FRAME_DATA;
+	pOut[n++] = dumpId;
+	pOut[n++] = First;
+	pOut[n++] = First >> 8;
+
+	for(uint16_t i = First; i < count && i < First + BLACKBOX_RECORDS_PER_FRAME; i++)
+	{
+		const uint8_t *p = (const uint8_t *)BlackBox_Get(&blackbox, i);
+
+		for(uint16_t k = 0; k < sizeof(BlackBoxRecord_TypeDef); k++) pOut[n++] = p[k];
+	}
+
+	pOut[n] = Telemetry_Crc8(pOut, n);
+
+	return n + 1;
+}
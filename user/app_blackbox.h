@@ -0,0 +1,75 @@
+#ifndef APP_BLACKBOX_H
+#define APP_BLACKBOX_H
+
+#include "blackbox.h"
+#include "telemetry.h"
+
+//
+// 黑匣子，格式见my_lib/blackbox.h
+// 控制任务每个姿态周期（5ms）写入一条BlackBoxRecord_TypeDef，RAM中循环保存最近的BLACKBOX_DEPTH条。
+// 小车摔倒或控制任务超时后再记录BLACKBOX_POST_TRIGGER条即冻结，由App_BlackBox_Proc在后台
+// 经USART2导出（与遥测帧混在同一字节流中，USART2_STREAM须为USART2_STREAM_TELEMETRY），
+// 导出完毕后重新开始记录。tools/blackbox把导出的数据解码为以触发时刻为零点的CSV
+//
+#define BLACKBOX_DEPTH        160 // 记录的条数，控制周期5ms时约0.8s，占用7KB RAM
+#define BLACKBOX_POST_TRIGGER 40  // 触发后的记录条数，其余为触发前的记录
+
+// 触发原因
+#define BLACKBOX_REASON_FALL    1 // 倾角超过80°，小车摔倒
+#define BLACKBOX_REASON_OVERRUN 2 // 控制任务落后一个周期以上
+
+// 导出的帧，COBS编码后经App_Telemetry_Send发出，最后一个字节为CRC8（Telemetry_Crc8）
+//   HEADER - 类型 版本 导出序号 触发原因 触发时刻(4) 记录条数(2) 触发前的条数(2) 每条记录的字节数 CRC8
+//   DATA   - 类型 导出序号 第一条记录的序号(2) 若干条记录 CRC8
+// 多字节整数均为小端，记录按BlackBoxRecord_TypeDef的内存布局原样存放
+#define BLACKBOX_FRAME_HEADER (TELEMETRY_FRAME_USER + 0)
+#define BLACKBOX_FRAME_DATA   (TELEMETRY_FRAME_USER + 1)
+#define BLACKBOX_VERSION      1
+
+// 各物理量的小数位数（Q格式，见BlackBox_Q16），可表示的范围为±2^(15-Q)
+#define BLACKBOX_Q_ALPHA 12 // rad
+#define BLACKBOX_Q_GYRO  10 // rad/s
+#define BLACKBOX_Q_V     8  // rad/s
+#define BLACKBOX_Q_PID   11 // 速度环、角度环、转向环的输出和积分项
+#define BLACKBOX_Q_DPID  8  // 角速度环的输出和积分项，rad/s^2
+#define BLACKBOX_Q_DDX   8  // m/s^2
+#define BLACKBOX_Q_OMEGA 9  // rad/s
+#define BLACKBOX_Q_TURN  11 // rad/s
+#define BLACKBOX_Q_DUTY  7  // %
+#define BLACKBOX_Q_VOLT  11 // V
+
+// 记录的标志
+#define BLACKBOX_FLAG_STANDUP 0x07 // bit0..2 自动起立的阶段（standingUp），0表示正常控制
+#define BLACKBOX_FLAG_MOTOR   0x08 // 电机已使能
+#define BLACKBOX_FLAG_OVERRUN 0x10 // 自上一条记录以来控制任务落后一个姿态周期以上
+
+typedef struct
+{
+	uint32_t Us;        // 控制任务开始执行的时刻，单位us
+	int16_t Alpha;      // 倾角
+	int16_t DAlpha;     // 倾角速度
+	int16_t Gz;         // 偏航角速度
+	int16_t V;          // 轮速
+	int16_t VelOut;     // 速度环的输出和积分项
+	int16_t VelI;
+	int16_t AlphaOut;   // 角度环
+	int16_t AlphaI;
+	int16_t DAlphaOut;  // 角速度环
+	int16_t DAlphaI;
+	int16_t TurnOut;    // 转向环
+	int16_t DdxRef;     // 期望的水平加速度
+	int16_t OmegaRef;   // 电机转速的参考值
+	int16_t OmegaTurn;
+	int16_t Duty_L;     // 电机任务最近一次输出的占空比
+	int16_t Duty_R;
+	int16_t Volt;       // 电池电压
+	uint8_t Mode;       // CONTROL_MODE_xxx
+	uint8_t Flags;      // BLACKBOX_FLAG_xxx
+} BlackBoxRecord_TypeDef;
+
+                   void App_BlackBox_Init(void);
+BlackBoxRecord_TypeDef *App_BlackBox_Next(void);
+                   void App_BlackBox_Trigger(uint8_t Reason, uint32_t Us);
+                   void App_BlackBox_Proc(void);
+
+#endif
@@ -0,0 +1,252 @@
+#include "app_boot.h"
+#include "stm32f10x.h"
+#include "blackbox.h"
+#include "app_telemetry.h"
+#include "app_cmd.h"
+#include "task.h"
+
+//
+// 检查点在后备寄存器中的格式，每个寄存器16位：
+//   DR1      - 0x5A00 | 控制模式<<1 | 电机，高8位不对说明没有检查点或已作废
+//   DR2..DR9 - 各状态量，Q格式的定点数（BlackBox_Q16）
+//   DR10     - DR1..DR9的校验值，后备寄存器内容出错（后备域复位后的随机值、干扰）时校验不通过
+// 写入时先作废DR1，写完DR2..DR10后最后写入DR1，写入过程中复位时DR1总是无效，按冷启动处理。
+// 不能只靠校验值：相邻两个控制周期的检查点只差几个LSB，新旧寄存器混在一起时校验值有可能恰好一致
+//
+#define BOOT_MAGIC      0x5A00
+#define BOOT_NUM_REGS   10
+
+#define BOOT_Q_PITCH    7  // 度，±256
+#define BOOT_Q_OMEGA    9  // rad/s，±64
+#define BOOT_Q_PID      11 // 速度环和角度环的积分项，±16
+#define BOOT_Q_DPID     8  // 角速度环的积分项，±128
+#define BOOT_Q_POS      12 // m，±8
+#define BOOT_Q_VOLT     11 // V，±16
+
+static const uint16_t regs[BOOT_NUM_REGS] = {
+	BKP_DR1, BKP_DR2, BKP_DR3, BKP_DR4, BKP_DR5, BKP_DR6, BKP_DR7, BKP_DR8, BKP_DR9, BKP_DR10,
+};
+
+static uint8_t resetCause = BOOT_RESET_POWER;
+static uint8_t warm = 0;
+static BootCheckpoint_TypeDef checkpoint;
+
+typedef struct
+{
+	const char *Name;
+	uint32_t Us;
+} BootMark_TypeDef;
+
+static uint32_t bootUs; // App_Boot_Init开始执行的时刻
+static int32_t readyUs = -1; // 控制任务第一次输出的时刻（相对bootUs），-1表示尚未输出
+static BootMark_TypeDef marks[BOOT_MAX_MARKS];
+static uint8_t numMarks = 0;
+static uint8_t reported = 0; // 已输出的行数
+
+static uint16_t Check(const uint16_t *pData);
+static  uint8_t Load(BootCheckpoint_TypeDef *pCheckpoint);
+
+//
+// @简介：判断复位原因，读取检查点
+// @注意：须在其它模块初始化之前调用
+//
+void App_Boot_Init(void)
+{
+	bootUs = GetUs();
+	
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR | RCC_APB1Periph_BKP, ENABLE);
+	
+	PWR_BackupAccessCmd(ENABLE); // 此后一直允许写后备寄存器
+	
+	// #1. 复位原因，复位按键的标志在任何复位时都会置位，最后判断
+	if(RCC_GetFlagStatus(RCC_FLAG_PORRST) == SET)
+	{
+		resetCause = BOOT_RESET_POWER;
+	}
+	else if(RCC_GetFlagStatus(RCC_FLAG_IWDGRST) == SET || RCC_GetFlagStatus(RCC_FLAG_WWDGRST) == SET)
+	{
+		resetCause = BOOT_RESET_WATCHDOG;
+	}
+	else if(RCC_GetFlagStatus(RCC_FLAG_SFTRST) == SET)
+	{
+		resetCause = BOOT_RESET_SOFTWARE;
+	}
+	else
+	{
+		resetCause = BOOT_RESET_PIN;
+	}
+	
+	RCC_ClearFlag();
+	
+	// #2. 上电复位以外读取检查点
+	warm = (resetCause != BOOT_RESET_POWER) && Load(&checkpoint);
+	
+	// #3. 作废检查点，控制任务运行后重新写入
+	BKP_WriteBackupRegister(BKP_DR1, 0);
+}
+
+//
+// @简介：全部模块初始化完毕后调用，启动看门狗
+//
+void App_Boot_Start(void)
+{
+	App_Telemetry_AddVariable("reset", TELEMETRY_UINT8, &resetCause, 1);
+	App_Telemetry_AddVariable("warm", TELEMETRY_UINT8, &warm, 1);
+	App_Telemetry_AddVariable("boot_us", TELEMETRY_INT32, &readyUs, 1);
+	
+#if BOOT_WATCHDOG_MS > 0
+	DBGMCU_Config(DBGMCU_IWDG_STOP, ENABLE); // 调试时内核暂停，看门狗也暂停
+	
+	IWDG_WriteAccessCmd(IWDG_WriteAccess_Enable);
+	IWDG_SetPrescaler(IWDG_Prescaler_32); // 40kHz/32，每0.8ms计一次
+	IWDG_SetReload(BOOT_WATCHDOG_MS * 40 / 32);
+	IWDG_ReloadCounter();
+	IWDG_Enable();
+#endif
+}
+
+//
+// @简介：喂狗，放在主循环中，每轮执行一次；任何一个任务卡住超过BOOT_WATCHDOG_MS即复位。
+//        控制任务第一次输出后逐行输出启动时间
+//
+void App_Boot_Proc(void)
+{
+#if BOOT_WATCHDOG_MS > 0
+	IWDG_ReloadCounter();
+#endif
+	
+	PERIODIC_START(report, 50)
+	
+	if(readyUs >= 0 && reported <= numMarks)
+	{
+		if(reported < numMarks)
+		{
+			uint32_t start = (reported == 0) ? bootUs : marks[reported - 1].Us;
+			
+			App_Cmd_Printf("boot: %s %lu us\n", marks[reported].Name, (unsigned long)(marks[reported].Us - start));
+		}
+		else
+		{
+			App_Cmd_Printf("boot: ready %ld us %s\n", (long)readyUs, warm ? "warm" : "cold");
+		}
+		
+		reported++;
+	}
+	
+	PERIODIC_END
+}
+
+//
+// @简介：记下初始化的一个阶段结束的时刻，该阶段从上一次调用（或App_Boot_Init）开始
+// @参数：Name - 阶段的名称，须为常量字符串
+// @注意：最多BOOT_MAX_MARKS个，多余的忽略
+//
+void App_Boot_Mark(const char *Name)
+{
+	if(numMarks >= BOOT_MAX_MARKS) return;
+	
+	marks[numMarks].Name = Name;
+	marks[numMarks].Us = GetUs();
+	numMarks++;
+}
+
+//
+// @简介：控制任务第一次输出时调用，记下启动完成的时刻，之后的调用忽略
+//
+void App_Boot_Ready(void)
+{
+	if(readyUs >= 0) return;
+	
+	readyUs = GetUs() - bootUs;
+}
+
+//
+// @简介：取得热启动时复位前的状态
+// @返回值：检查点，冷启动时返回NULL
+//
+const BootCheckpoint_TypeDef *App_Boot_GetWarm(void)
+{
+	return warm ? &checkpoint : NULL;
+}
+
+//
+// @简介：写入检查点，由控制任务每个周期调用
+// @注意：只做定点数转换和寄存器写入，不调用浮点库函数
+//
+void App_Boot_Checkpoint(const BootCheckpoint_TypeDef *pCheckpoint)
+{
+	uint16_t data[BOOT_NUM_REGS];
+	
+	data[0] = BOOT_MAGIC | (pCheckpoint->Mode & 0x7f) << 1 | (pCheckpoint->Motor ? 1 : 0);
+	data[1] = BlackBox_Q16(pCheckpoint->Pitch, BOOT_Q_PITCH);
+	data[2] = BlackBox_Q16(pCheckpoint->OmegaRef, BOOT_Q_OMEGA);
+	data[3] = BlackBox_Q16(pCheckpoint->VelI, BOOT_Q_PID);
+	data[4] = BlackBox_Q16(pCheckpoint->AlphaI, BOOT_Q_PID);
+	data[5] = BlackBox_Q16(pCheckpoint->DAlphaI, BOOT_Q_DPID);
+	data[6] = BlackBox_Q16(pCheckpoint->PosErr, BOOT_Q_POS);
+	data[7] = BlackBox_Q16(pCheckpoint->MotorI_L, BOOT_Q_VOLT);
+	data[8] = BlackBox_Q16(pCheckpoint->MotorI_R, BOOT_Q_VOLT);
+	data[9] = Check(data);
+	
+	BKP_WriteBackupRegister(BKP_DR1, 0);
+	
+	for(uint8_t i=1; i<BOOT_NUM_REGS; i++)
+	{
+		BKP_WriteBackupRegister(regs[i], data[i]);
+	}
+	
+	BKP_WriteBackupRegister(BKP_DR1, data[0]);
+}
+
+//
+// @简介：读取复位原因
+// @返回值：BOOT_RESET_xxx
+//
+uint8_t App_Boot_GetResetCause(void)
+{
+	return resetCause;
+}
+
+//
+// @简介：读取并校验检查点
+// @返回值：1 - 有效，0 - 没有检查点或已损坏
+//
+static uint8_t Load(BootCheckpoint_TypeDef *pCheckpoint)
+{
+	uint16_t data[BOOT_NUM_REGS];
+	
+	for(uint8_t i=0; i<BOOT_NUM_REGS; i++)
+	{
+		data[i] = BKP_ReadBackupRegister(regs[i]);
+	}
+	
+	if((data[0] & 0xff00) != BOOT_MAGIC || data[9] != Check(data)) return 0;
+	
+	pCheckpoint->Mode = (data[0] >> 1) & 0x7f;
+	pCheckpoint->Motor = data[0] & 1;
+	pCheckpoint->Pitch = (int16_t)data[1] / (float)(1 << BOOT_Q_PITCH);
+	pCheckpoint->OmegaRef = (int16_t)data[2] / (float)(1 << BOOT_Q_OMEGA);
+	pCheckpoint->VelI = (int16_t)data[3] / (float)(1 << BOOT_Q_PID);
+	pCheckpoint->AlphaI = (int16_t)data[4] / (float)(1 << BOOT_Q_PID);
+	pCheckpoint->DAlphaI = (int16_t)data[5] / (float)(1 << BOOT_Q_DPID);
+	pCheckpoint->PosErr = (int16_t)data[6] / (float)(1 << BOOT_Q_POS);
+	pCheckpoint->MotorI_L = (int16_t)data[7] / (float)(1 << BOOT_Q_VOLT);
+	pCheckpoint->MotorI_R = (int16_t)data[8] / (float)(1 << BOOT_Q_VOLT);
+	
+	return 1;
+}
+
+//
+// @简介：DR1..DR9的校验值，逐个循环左移后异或，全0的寄存器（后备域复位后）校验不通过
+//
+static uint16_t Check(const uint16_t *pData)
+{
+	uint16_t check = 0xB007;
+	
+	for(uint8_t i=0; i<BOOT_NUM_REGS - 1; i++)
+	{
+		check = (uint16_t)(check << 1 | check >> 15) ^ pData[i];
+	}
+	
+	return check;
+}
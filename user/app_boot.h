@@ -0,0 +1,59 @@
+#ifndef APP_BOOT_H
+#define APP_BOOT_H
+
+#include <stdint.h>
+
+//
+// 热启动
+// 控制任务每个周期把继续平衡所需的最少状态写入后备寄存器（BKP_DR1..DR10，共20字节），
+// 后备寄存器不受系统复位影响。看门狗、软件或复位按键引起的复位之后，如果检查点有效，
+// 各模块初始化时跳过多余的步骤并接着复位前的状态运行：MPU6050不再复位和等待100ms，
+// 互补滤波器从保存的倾角继续而不是从加速度计重新开始，控制器和电机的积分项、电机转速的参考值
+// 与控制模式保持不变，电机按原样使能，复位后第一个控制周期即可接着平衡。
+// 上电复位（含掉电复位）一律冷启动：F103没有欠压复位，电压过低时产生的是掉电复位，
+// 此时无法知道断电了多久，且没有后备电池时后备寄存器已经丢失。
+// 检查点读取后立即作废，初始化期间再次复位时不会用到过期的状态
+//
+#define BOOT_WATCHDOG_MS 100 // 独立看门狗的超时（按LSI为40kHz计算，实际为67~133ms），0表示不启用。
+                             // 主循环中最长的操作是参数存储回收时擦除Flash，不超过40ms
+
+// 启动时间
+// 初始化的各阶段结束时调用App_Boot_Mark记下时刻，控制任务第一次输出时调用App_Boot_Ready，
+// 之后由App_Boot_Proc经App_Cmd每50ms输出一行（串口的发送队列较小，一次全部输出会被丢弃）：
+//   boot: mpu_rst 1234 us     各阶段的耗时
+//   boot: ready 23456 us cold 从App_Boot_Init到控制任务第一次输出，冷启动或热启动
+// 时间从App_Boot_Init开始计算（时基在第一次调用GetUs时启动），不含复位后到main之前的启动代码
+// （SystemInit等待HSE起振和锁相环锁定，约1~2ms）
+//
+#define BOOT_MAX_MARKS 8
+
+// 复位原因
+#define BOOT_RESET_POWER    0 // 上电或掉电复位
+#define BOOT_RESET_PIN      1 // 复位按键
+#define BOOT_RESET_SOFTWARE 2
+#define BOOT_RESET_WATCHDOG 3 // 独立或窗口看门狗
+
+typedef struct
+{
+	float Pitch;      // 倾角（已校准，同App_MPU6050_GetPitch），单位度
+	float OmegaRef;   // 电机转速的参考值，单位rad/s
+	float VelI;       // 串级PID各级的积分项
+	float AlphaI;
+	float DAlphaI;
+	float PosErr;     // LQR的位置参考值与当前位置之差，单位m
+	float MotorI_L;   // 电机速度环的积分项，单位V
+	float MotorI_R;
+	uint8_t Mode;     // CONTROL_MODE_xxx
+	uint8_t Motor;    // 1 - 电机已使能且在正常控制（不在起立过程中）
+} BootCheckpoint_TypeDef;
+
+                        void App_Boot_Init(void);
+                        void App_Boot_Start(void);
+                        void App_Boot_Proc(void);
+const BootCheckpoint_TypeDef *App_Boot_GetWarm(void);
+                        void App_Boot_Checkpoint(const BootCheckpoint_TypeDef *pCheckpoint);
+                     uint8_t App_Boot_GetResetCause(void);
+                        void App_Boot_Mark(const char *Name);
+                        void App_Boot_Ready(void);
+
+#endif
@@ -0,0 +1,9 @@
+#include "app_bus.h"
+
+static ImuSample_TypeDef imuSample;
+static GyroSample_TypeDef gyroSample;
+static WheelState_TypeDef wheelState;
+
+Bus_TopicTypeDef ImuTopic = BUS_TOPIC(imuSample);
+Bus_TopicTypeDef GyroTopic = BUS_TOPIC(gyroSample);
+Bus_TopicTypeDef WheelTopic = BUS_TOPIC(wheelState);
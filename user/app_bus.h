@@ -0,0 +1,38 @@
+#ifndef APP_BUS_H
+#define APP_BUS_H
+
+#include "bus.h"
+
+//
+// 模块之间传递的样本（my_lib/bus.h），每个主题一个生产者，每个样本只计算一次：
+//   ImuTopic   - App_MPU6050_Update发布，每5ms一次，时刻为开始读取传感器的时刻
+//   GyroTopic  - App_MPU6050_Proc发布，每1ms一次，只有角速度环用到的x轴角速度，时刻同上
+//   WheelTopic - App_Motor_Proc发布，每1ms一次（校准期间暂停），时刻为电机任务开始的时刻
+// 消费者用Bus_GetAge得到样本的年龄，控制任务把两者的年龄登记为遥测变量imu_age、wheel_age
+//
+
+typedef struct
+{
+	float Ax, Ay, Az;       // 加速度，单位g
+	float Gx, Gy, Gz;       // 角速度，已扣除零偏，单位度/s
+	float Pitch, Roll, Yaw; // 姿态，单位度，Pitch已加上安装偏差（校准结果）
+	float Temp;             // 温度，单位℃
+} ImuSample_TypeDef;
+
+typedef struct
+{
+	float Gx;               // x轴角速度，已扣除零偏，单位度/s
+} GyroSample_TypeDef;
+
+typedef struct
+{
+	float Speed_L, Speed_R; // 轮子转速，单位rad/s
+	float Duty_L, Duty_R;   // 输出的占空比，单位%
+	float Volt;             // 用到的电池电压，单位V
+} WheelState_TypeDef;
+
+extern Bus_TopicTypeDef ImuTopic;
+extern Bus_TopicTypeDef GyroTopic;
+extern Bus_TopicTypeDef WheelTopic;
+
+#endif
@@ -1,7 +1,7 @@
-#ifndef APP_BUTTON_H
-#define APP_BUTTON_H
-
-void App_Button_Init(void);
-void App_Button_Proc(void);
-
-#endif
+#ifndef APP_BUTTON_H
+#define APP_BUTTON_H
+
+void App_Button_Init(void);
+void App_Button_Proc(void);
+
+#endif
@@ -1,249 +1,657 @@
-#include "app_calibrator.h"
-#include "delay.h"
-#include "app_encoder.h"
-#include "app_pwm.h"
-#include "task.h"
-#include "app_mpu6050.h"
-
-#define CALI_RESULT_ADDR_START 0x0801fC00 // 存储校准结果的起始位置，Page127
-#define CALI_KEY 0x34562897feda0312
-
-static CaliResult_TypeDef caliResult; // 用于存储校准信息
-
-static void OnBoardLED_Init(void);
-static void OnBoardLED_Set(uint8_t State);
-static int CalibrateEncoders(void); // 编码器校准
-static int CalibrateMPU6050(void); // 校准MPU6050
-static void LoadCaliResult(void); // 从单片机的Flash加载校准信息
-static void SaveCaliResult(void); // 将校准信息保存回单片机的Flash当中
-
-//
-// @简介：初始化校准器
-//
-void App_Calibrator_Init(void)
-{
-	OnBoardLED_Init(); // 初始化板载LED，校准时作为指示灯
-	LoadCaliResult(); // 加载之前存储的校准结果
-}
-
-//
-// @简介：执行校准过程
-//
-void App_Calibrator_DoCalibration(void)
-{
-	
-	// #1. 等待用户将设备放置到合适位置
-	// 板载LED闪烁，表示即将进入校准状态
-	for(uint32_t i=0; i<50;i++) // 5s
-	{
-		OnBoardLED_Set(0);
-		Delay(50);
-		OnBoardLED_Set(1);
-		Delay(50);
-	}
-	
-	// #2. 点亮LED，开始校准过程
-	OnBoardLED_Set(1);
-	
-	// #2.1. 校准编码器
-	if(CalibrateEncoders() != 0)
-	{
-		// 校准失败
-		goto CALI_END;
-	}
-	
-	// #2.2. 校准MPU6050
-	if(CalibrateMPU6050() != 0)
-	{
-		goto CALI_END;
-	}
-	
-	// #3. 保存校准结果
-	SaveCaliResult();
-	
-CALI_END:
-	// #4. 校准结束，持续闪灯
-	while(1)
-	{
-		OnBoardLED_Set(0);
-		Delay(50);
-		OnBoardLED_Set(1);
-		Delay(50);
-	}
-}
-
-const CaliResult_TypeDef *App_Calibrator_GetResult(void)
-{
-	return &caliResult;
-}
-
-//
-// @简介：初始化板载LED，将板载LED作为校准指示灯
-//
-static void OnBoardLED_Init(void)
-{
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
-	
-	GPIO_WriteBit(GPIOC, GPIO_Pin_13, Bit_SET); // 初始状态下熄灭板载LED
-	
-	GPIO_InitTypeDef GPIO_InitStruct = {0};
-	
-	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_13;
-	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_Out_OD;
-	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_2MHz;
-	
-	GPIO_Init(GPIOC, &GPIO_InitStruct);
-}
-
-//
-// @简介：控制板载LED的亮灭
-// @参数：State - 0 - 熄灭，非零 - 点亮
-//
-static void OnBoardLED_Set(uint8_t State)
-{
-	GPIO_WriteBit(GPIOC, GPIO_Pin_13, State ? Bit_RESET : Bit_SET);
-}
-
-//
-// @简介：校准编码器误差
-// @返回值：0 - 成功 非零 - 失败
-//
-static int CalibrateEncoders(void)
-{
-	int ret = 0;
-	
-	// #1. 开启电机
-	App_PWM_Cmd(1);
-	App_PWM_Set_L(50);
-	App_PWM_Set_R(-50);
-	
-	// #2. 等待1秒
-	Delay(1000);
-	
-	// #3. 开始测试
-	App_Encoder_StartCalibration();
-	
-	// #4. 等待10秒
-	Delay(10000);
-	
-	// #5. 校准结束
-	float duty_l, duty_r;
-	if(App_Encoder_EndCalibration(&duty_l, &duty_r) != 0)
-	{
-		ret = -1; // 校准失败
-	}
-	
-	// #7. 关闭电机
-	App_PWM_Cmd(0);
-	App_PWM_Set_L(0);
-	App_PWM_Set_R(0);
-	
-	// #8. 写入校准结果
-	if(ret == 0) // 只有校准成功才写入
-	{
-		caliResult.encoder_duty_l = duty_l;
-		caliResult.encoder_duty_r = duty_r;
-	}
-	
-	return ret;
-}
-
-//
-// @简介：校准MPU6050
-//
-static int CalibrateMPU6050(void)
-{
-	// #1. 等待1s
-	Delay(1000);
-	
-	// #2. 将之前的校准数据清零
-	caliResult.mpu6050_gx_bias = 0;
-	caliResult.mpu6050_gy_bias = 0;
-	caliResult.mpu6050_gz_bias = 0;
-	caliResult.mpu6050_pitch_bias = 0;
-	
-	// #3. 进入校准，假定采样率200Hz，10s对应2000个点
-	
-	uint16_t n;
-	float gx = 0, gy = 0, gz = 0, pitch = 0;
-	
-	while(1)
-	{
-		App_MPU6050_Proc();
-		
-		PERIODIC_START(MPU6050_AQUIRE, 5) // 每5ms采集一次数据
-		
-		gx+= App_MPU6050_GetGyroX();
-		gy+= App_MPU6050_GetGyroY();
-		gz+= App_MPU6050_GetGyroZ();
-		
-		float tmp = App_MPU6050_GetPitch() - 180;
-		
-		if(tmp < -180) // 将角度限制在-180到180之间
-		{
-			tmp += 360;
-		}
-		else if(tmp > 180)
-		{
-			tmp -= 360;
-		}
-		
-		pitch += tmp;
-		n++;
-		
-		if(n==2000) break;
-		
-		PERIODIC_END
-	}
-	
-	caliResult.mpu6050_gx_bias = gx / n;
-	caliResult.mpu6050_gy_bias = gy / n;
-	caliResult.mpu6050_gz_bias = gz / n;
-	caliResult.mpu6050_pitch_bias = pitch / n;
-	
-	return 0;
-}
-
-static void LoadCaliResult(void)
-{
-	// #1. 加载校准结构
-	// #1.1. 从单片机的Flash加载校准结果
-	caliResult = *(CaliResult_TypeDef *)CALI_RESULT_ADDR_START;
-	
-	// #1.2. 校验key，以确定校准信息是否有效
-	if(caliResult.key != CALI_KEY) // 如果校准信息无效
-	{
-		// 给校准信息赋默认值
-		caliResult.encoder_duty_l = 0.5f;
-		caliResult.encoder_duty_r = 0.5f;
-		caliResult.mpu6050_gx_bias = 0;
-		caliResult.mpu6050_gy_bias = 0;
-		caliResult.mpu6050_gz_bias = 0;
-		caliResult.mpu6050_pitch_bias = 0;
-	}
-}
-
-//
-// @简介：将校准结果保存到单片机的Flash当中
-//
-static void SaveCaliResult(void)
-{
-	// #1. 解锁Flash
-	FLASH_Unlock();
-	
-	// #2. 页擦除
-	FLASH_ErasePage(CALI_RESULT_ADDR_START); // 擦除page127
-	
-	// #3. 页编程
-	caliResult.key = CALI_KEY;
-	uint16_t *data = (uint16_t *)&caliResult;
-	uint16_t size = sizeof(caliResult)/2 + 1;
-	
-	for(uint16_t i=0; i<size; i++)
-	{
-		FLASH_ProgramHalfWord(CALI_RESULT_ADDR_START+2*i, data[i]);
-	}
-	
-	// #4. 锁定Flash
-	FLASH_Lock();
-}
+#include "app_calibrator.h"
+#include "delay.h"
+#include "app_encoder.h"
+#include "app_pwm.h"
+#include "task.h"
+#include "pt.h"
+#include "app_mpu6050.h"
+#include "app_flash.h"
+#include "app_motor.h"
+#include "app_control.h"
+#include "app_cmd.h"
+#include "stats.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+// 旧版本把校准结果整页写在Page127，现在改存在app_flash.c中，升级后第一次上电时从这里导入
+#define CALI_LEGACY_ADDR_START 0x0801fC00
+#define CALI_LEGACY_KEY 0x34562897feda0312
+
+// 保存在app_flash.c中的两条记录，旧版本的记录没有噪声的部分，读取时按长度区分
+typedef struct
+{
+	float duty_l;
+	float duty_r;
+	float duty_l_sd;
+	float duty_r_sd;
+	uint16_t samples;
+	uint16_t rejected;
+} EncoderCali_TypeDef;
+
+typedef struct
+{
+	float gx_bias;
+	float gy_bias;
+	float gz_bias;
+	float pitch_bias;
+	float gx_sd;
+	float gy_sd;
+	float gz_sd;
+	float pitch_sd;
+	uint16_t samples;
+	uint16_t rejected;
+} IMUCali_TypeDef;
+
+#define ENCODER_CALI_V1_SIZE offsetof(EncoderCali_TypeDef, duty_l_sd)
+#define IMU_CALI_V1_SIZE     offsetof(IMUCali_TypeDef, gx_sd)
+
+//
+// 校准作为普通任务在主循环中分步执行（协程，my_lib/pt.h），不阻塞其它任务：
+//   倒计时5s（LED快闪，把小车平放好） -> 电机起转1s -> 编码器计时 -> 静置1s -> 采集陀螺仪和倾角
+//   -> 保存 -> 指示结果3s（成功LED慢闪，失败或取消LED快闪） -> 恢复正常运行
+// 测量期间LED常亮，电机和控制任务暂停（App_Calibrator_IsBusy），进度每秒经USART3报告一次。
+// 测量中途可以取消，此前的校准结果保持不变
+//
+// 两项测量都用流式统计（my_lib/stats.h）边采集边计算均值和标准误差，达到最少样本数且
+// 每个量的标准误差都不超过容差即提前结束，安静的桌面上各需1~2s。偏离均值超过CALI_OUTLIER_SIGMA倍
+// 标准差的样本剔除；IMU的点大部分被剔除或者开头的点就很分散说明小车被碰动，统计从头开始。
+// 到达时间上限时标准误差不超过容差的CALI_CAP_FACTOR倍仍然采用，否则校准失败
+//
+#define CALI_PERIOD_MS    5     // 任务周期，与App_MPU6050_Proc相同，每个周期采集一个点
+#define CALI_COUNTDOWN_MS 5000
+#define CALI_SPINUP_MS    1000
+#define CALI_SETTLE_MS    1000
+#define CALI_RESULT_MS    3000
+#define CALI_REPORT_MS    1000  // 报告进度的间隔
+
+#define CALI_ENCODER_MS          10000  // 编码器计时的上限
+#define CALI_ENCODER_WINDOW_MS   100    // 每段的长度，每段的占空比作为一个样本
+#define CALI_ENCODER_MIN_SAMPLES 10
+#define CALI_ENCODER_TOL         0.001f  // 占空比的标准误差，对应台阶高度的误差约0.2%
+#define CALI_ENCODER_MIN_SD      0.001f  // 剔除样本时标准差的下限，避免样本很一致时误剔除
+#define CALI_ENCODER_MAX_SD      0.02f   // 剔除样本时标准差的上限，避免开头混入异常的样本后什么都不剔除
+
+#define CALI_IMU_MS          10000  // 采集陀螺仪和倾角的上限，与旧版本固定采集的2000点相同
+#define CALI_IMU_MIN_SAMPLES 200    // 相邻的点经过MPU6050的低通滤波并不独立，至少采集1s
+#define CALI_GYRO_TOL        0.005f // 度/s
+#define CALI_PITCH_TOL       0.01f  // 度
+#define CALI_GYRO_MIN_SD     0.061f // 度/s，陀螺仪的1个LSB
+#define CALI_PITCH_MIN_SD    0.05f  // 度
+#define CALI_GYRO_MAX_SD     1.0f   // 度/s
+#define CALI_PITCH_MAX_SD    0.5f   // 度
+#define CALI_MOTION_SAMPLES  20     // 剔除一个点计2，采用一个点减1，累计到2倍此值时从头开始，连续剔除时为100ms
+
+#define CALI_OUTLIER_SIGMA 5
+#define CALI_OUTLIER_MIN_N 5    // 样本数少于此时标准差还不可靠，不剔除
+#define CALI_CAP_FACTOR    4
+
+// 校准的步骤
+#define CALI_STATE_IDLE      0
+#define CALI_STATE_COUNTDOWN 1
+#define CALI_STATE_SPINUP    2
+#define CALI_STATE_ENCODER   3
+#define CALI_STATE_SETTLE    4
+#define CALI_STATE_IMU       5
+#define CALI_STATE_DONE      6 // 以下两个步骤只指示结果，电机和控制任务已经恢复
+#define CALI_STATE_FAILED    7
+
+static const char *stateNames[] = {"idle", "countdown", "spinup", "encoder", "settle", "imu", "done", "failed"};
+
+static CaliResult_TypeDef caliResult; // 用于存储校准信息
+static CaliNoise_TypeDef caliNoise;
+
+static uint8_t state = CALI_STATE_IDLE;
+static uint32_t stateStart; // 进入当前步骤的时刻，单位ms
+static uint32_t lastReport;
+static PT_TypeDef calibration; // 测量各步骤的协程
+
+// 测量的中间结果，全部完成后才写入caliResult
+static Stats_TypeDef duty_l, duty_r;
+static Stats_TypeDef gx, gy, gz, pitch;
+static uint16_t encoderRejected, imuRejected;
+static uint16_t motion; // IMU剔除的点多于采用的点时增加，见CALI_MOTION_SAMPLES
+
+static void OnBoardLED_Init(void);
+static void OnBoardLED_Set(uint8_t State);
+static uint8_t Calibrate(PT_TypeDef *pt);
+static void Enter(uint8_t State);
+static uint32_t Elapsed(void); // 进入当前步骤后经过的时间，单位ms
+static void Finish(uint8_t State);
+static void StopMotors(void);
+static int8_t SampleEncoder(void); // 取一段编码器的占空比
+static int8_t SampleMPU6050(void); // 采集一个点
+static void RestartMPU6050(void);
+static uint8_t IsOutlier(const Stats_TypeDef *Stats, float x, float MinSd, float MaxSd);
+static int8_t Check(uint32_t Elapsed, uint32_t Cap, uint8_t Converged, uint8_t Acceptable);
+static uint8_t Progress(void); // 当前步骤的进度，0..100
+static void LoadCaliResult(void); // 从单片机的Flash加载校准信息
+static void SaveCaliResult(void); // 将校准信息保存回单片机的Flash当中
+
+//
+// @简介：初始化校准器
+//
+void App_Calibrator_Init(void)
+{
+	OnBoardLED_Init(); // 初始化板载LED，校准时作为指示灯
+	LoadCaliResult(); // 加载之前存储的校准结果
+}
+
+//
+// @简介：开始校准，已在校准中时忽略
+//
+void App_Calibrator_Start(void)
+{
+	if(App_Calibrator_IsBusy()) return;
+	
+	App_Motor_Cmd(DISABLE);
+	
+	App_Cmd_Printf("cali: start, keep the car still\n");
+	
+	Enter(CALI_STATE_COUNTDOWN);
+	lastReport = stateStart;
+	PT_INIT(&calibration);
+}
+
+//
+// @简介：取消校准，之前的校准结果保持不变
+//
+void App_Calibrator_Cancel(void)
+{
+	if(!App_Calibrator_IsBusy()) return;
+	
+	if(state == CALI_STATE_ENCODER)
+	{
+		float tmp_l, tmp_r;
+		
+		App_Encoder_EndCalibration(&tmp_l, &tmp_r); // 结束编码器的计时，结果丢弃
+	}
+	
+	App_Cmd_Printf("cali: cancelled\n");
+	
+	Finish(CALI_STATE_FAILED);
+}
+
+//
+// @简介：是否正在测量，此时电机由校准器控制，电机和控制任务暂停
+// @返回值：1 - 正在测量，0 - 没有在校准或者只在指示结果
+//
+uint8_t App_Calibrator_IsBusy(void)
+{
+	return state != CALI_STATE_IDLE && state < CALI_STATE_DONE;
+}
+
+//
+// @简介：校准任务，每次执行一步，放在主循环中App_MPU6050_Proc之后
+//
+void App_Calibrator_Proc(void)
+{
+	PERIODIC(CALI_PERIOD_MS);
+	
+	if(state == CALI_STATE_IDLE) return;
+	
+	uint32_t now = GetTick();
+	
+	if(App_Calibrator_IsBusy())
+	{
+		if(Time_Diff(now, lastReport) >= CALI_REPORT_MS)
+		{
+			lastReport = now;
+			App_Cmd_Printf("cali: %s %u%%\n", stateNames[state], Progress());
+		}
+		
+		Calibrate(&calibration); // 结束时进入CALI_STATE_DONE或CALI_STATE_FAILED
+		return;
+	}
+	
+	// 指示结果，成功慢闪，失败快闪
+	OnBoardLED_Set((Elapsed() / (state == CALI_STATE_DONE ? 500 : 50)) % 2);
+	
+	if(Elapsed() >= CALI_RESULT_MS)
+	{
+		OnBoardLED_Set(0);
+		state = CALI_STATE_IDLE;
+	}
+}
+
+//
+// @简介：测量的各个步骤，每个周期调用一次，结束时调用Finish
+//
+static uint8_t Calibrate(PT_TypeDef *pt)
+{
+	static int8_t ret;
+	float tmp_l, tmp_r;
+	
+	PT_BEGIN(pt);
+	
+	// #1. 等待用户将设备放置到合适位置，板载LED闪烁
+	while(Elapsed() < CALI_COUNTDOWN_MS)
+	{
+		OnBoardLED_Set((Elapsed() / 50) % 2);
+		PT_YIELD(pt);
+	}
+	
+	OnBoardLED_Set(1); // 点亮LED，开始测量
+	
+	// #2. 电机起转，等待转速稳定
+	App_PWM_Cmd(1);
+	App_PWM_Set_L(50);
+	App_PWM_Set_R(-50);
+	
+	Enter(CALI_STATE_SPINUP);
+	PT_WAIT_UNTIL(pt, Elapsed() >= CALI_SPINUP_MS);
+	
+	// #3. 编码器计时，每段取一个样本，直到足够准确
+	Stats_Init(&duty_l);
+	Stats_Init(&duty_r);
+	encoderRejected = 0;
+	
+	App_Encoder_StartCalibration();
+	Enter(CALI_STATE_ENCODER);
+	
+	do
+	{
+		PT_DELAY(pt, CALI_ENCODER_WINDOW_MS);
+		ret = SampleEncoder();
+	} while(ret == 0);
+	
+	App_Encoder_EndCalibration(&tmp_l, &tmp_r); // 结束计时，结果以各段的统计为准
+	
+	StopMotors();
+	
+	if(ret < 0)
+	{
+		App_Cmd_Printf("cali: encoder failed\n");
+		Finish(CALI_STATE_FAILED);
+		PT_EXIT(pt);
+	}
+	
+	// #4. 等待电机停稳
+	Enter(CALI_STATE_SETTLE);
+	PT_WAIT_UNTIL(pt, Elapsed() >= CALI_SETTLE_MS);
+	
+	// #5. 采集陀螺仪和倾角，每个周期一个点，直到足够准确
+	Stats_Init(&gx);
+	Stats_Init(&gy);
+	Stats_Init(&gz);
+	Stats_Init(&pitch);
+	imuRejected = 0;
+	motion = 0;
+	
+	Enter(CALI_STATE_IMU);
+	
+	do
+	{
+		PT_YIELD(pt);
+		ret = SampleMPU6050();
+	} while(ret == 0);
+	
+	if(ret < 0)
+	{
+		App_Cmd_Printf("cali: imu too noisy, n=%u\n", gx.N);
+		Finish(CALI_STATE_FAILED);
+		PT_EXIT(pt);
+	}
+	
+	// #6. 写入并保存校准结果，立即生效
+	caliResult.encoder_duty_l = duty_l.Mean;
+	caliResult.encoder_duty_r = duty_r.Mean;
+	caliResult.mpu6050_gx_bias = gx.Mean;
+	caliResult.mpu6050_gy_bias = gy.Mean;
+	caliResult.mpu6050_gz_bias = gz.Mean;
+	caliResult.mpu6050_pitch_bias = pitch.Mean;
+	
+	caliNoise.encoder_duty_l_sd = Stats_GetStdDev(&duty_l);
+	caliNoise.encoder_duty_r_sd = Stats_GetStdDev(&duty_r);
+	caliNoise.mpu6050_gx_sd = Stats_GetStdDev(&gx);
+	caliNoise.mpu6050_gy_sd = Stats_GetStdDev(&gy);
+	caliNoise.mpu6050_gz_sd = Stats_GetStdDev(&gz);
+	caliNoise.mpu6050_pitch_sd = Stats_GetStdDev(&pitch);
+	caliNoise.encoder_samples = duty_l.N;
+	caliNoise.encoder_rejected = encoderRejected;
+	caliNoise.mpu6050_samples = gx.N;
+	caliNoise.mpu6050_rejected = imuRejected;
+	
+	SaveCaliResult();
+	App_Encoder_UpdateCalibration();
+	
+	App_Cmd_Printf("cali: done, duty %.4f %.4f sd %.4f %.4f\n", duty_l.Mean, duty_r.Mean,
+	               caliNoise.encoder_duty_l_sd, caliNoise.encoder_duty_r_sd);
+	App_Cmd_Printf("cali: gyro bias %.3f %.3f %.3f, pitch bias %.2f\n", caliResult.mpu6050_gx_bias,
+	               caliResult.mpu6050_gy_bias, caliResult.mpu6050_gz_bias, caliResult.mpu6050_pitch_bias);
+	App_Cmd_Printf("cali: imu sd %.3f %.3f %.3f %.3f, n=%u\n", caliNoise.mpu6050_gx_sd,
+	               caliNoise.mpu6050_gy_sd, caliNoise.mpu6050_gz_sd, caliNoise.mpu6050_pitch_sd, gx.N);
+	
+	Finish(CALI_STATE_DONE);
+	
+	PT_END(pt);
+}
+
+const CaliResult_TypeDef *App_Calibrator_GetResult(void)
+{
+	return &caliResult;
+}
+
+const CaliNoise_TypeDef *App_Calibrator_GetNoise(void)
+{
+	return &caliNoise;
+}
+
+//
+// @简介：初始化板载LED，将板载LED作为校准指示灯
+//
+static void OnBoardLED_Init(void)
+{
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
+	
+	GPIO_WriteBit(GPIOC, GPIO_Pin_13, Bit_SET); // 初始状态下熄灭板载LED
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_13;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_Out_OD;
+	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_2MHz;
+	
+	GPIO_Init(GPIOC, &GPIO_InitStruct);
+}
+
+//
+// @简介：控制板载LED的亮灭
+// @参数：State - 0 - 熄灭，非零 - 点亮
+//
+static void OnBoardLED_Set(uint8_t State)
+{
+	GPIO_WriteBit(GPIOC, GPIO_Pin_13, State ? Bit_RESET : Bit_SET);
+}
+
+//
+// @简介：进入下一个步骤
+//
+static void Enter(uint8_t State)
+{
+	state = State;
+	stateStart = GetTick();
+}
+
+static uint32_t Elapsed(void)
+{
+	return Time_Diff(GetTick(), stateStart);
+}
+
+//
+// @简介：结束校准，停下电机，复位控制器后恢复正常运行（电机保持关闭），然后指示结果
+//
+static void Finish(uint8_t State)
+{
+	StopMotors();
+	
+	App_Control_Reset();
+	
+	Enter(State);
+}
+
+static void StopMotors(void)
+{
+	App_PWM_Cmd(0);
+	App_PWM_Set_L(0);
+	App_PWM_Set_R(0);
+}
+
+//
+// @简介：取一段编码器的占空比加入统计
+// @返回值：0 - 继续计时，1 - 完成，-1 - 失败
+//
+static int8_t SampleEncoder(void)
+{
+	float l, r;
+	
+	int ret = App_Encoder_SampleCalibration(&l, &r);
+	
+	if(ret < 0) return -1; // 电机反转
+	
+	if(ret > 0 || IsOutlier(&duty_l, l, CALI_ENCODER_MIN_SD, CALI_ENCODER_MAX_SD) ||
+	   IsOutlier(&duty_r, r, CALI_ENCODER_MIN_SD, CALI_ENCODER_MAX_SD))
+	{
+		encoderRejected++; // 这一段的边沿不足或者受到干扰
+	}
+	else
+	{
+		Stats_Add(&duty_l, l);
+		Stats_Add(&duty_r, r);
+	}
+	
+	uint8_t enough = duty_l.N >= CALI_ENCODER_MIN_SAMPLES;
+	uint8_t converged = enough && Stats_GetStdErr(&duty_l) <= CALI_ENCODER_TOL && Stats_GetStdErr(&duty_r) <= CALI_ENCODER_TOL;
+	uint8_t acceptable = enough && Stats_GetStdErr(&duty_l) <= CALI_ENCODER_TOL * CALI_CAP_FACTOR &&
+	                     Stats_GetStdErr(&duty_r) <= CALI_ENCODER_TOL * CALI_CAP_FACTOR;
+	
+	return Check(Elapsed(), CALI_ENCODER_MS, converged, acceptable);
+}
+
+//
+// @简介：采集一个点，扣除当前使用的零偏，得到未经校准的值；偏离均值太远的点剔除，
+//        大部分点被剔除说明小车被碰动，统计从头开始
+// @返回值：0 - 继续采集，1 - 完成，-1 - 失败
+//
+static int8_t SampleMPU6050(void)
+{
+	float x = App_MPU6050_GetGyroX() + caliResult.mpu6050_gx_bias;
+	float y = App_MPU6050_GetGyroY() + caliResult.mpu6050_gy_bias;
+	float z = App_MPU6050_GetGyroZ() + caliResult.mpu6050_gz_bias;
+	
+	float tmp = App_MPU6050_GetPitch() - caliResult.mpu6050_pitch_bias - 180;
+	
+	if(tmp < -180) // 将角度限制在-180到180之间
+	{
+		tmp += 360;
+	}
+	else if(tmp > 180)
+	{
+		tmp -= 360;
+	}
+	
+	if(IsOutlier(&gx, x, CALI_GYRO_MIN_SD, CALI_GYRO_MAX_SD) || IsOutlier(&gy, y, CALI_GYRO_MIN_SD, CALI_GYRO_MAX_SD) ||
+	   IsOutlier(&gz, z, CALI_GYRO_MIN_SD, CALI_GYRO_MAX_SD) || IsOutlier(&pitch, tmp, CALI_PITCH_MIN_SD, CALI_PITCH_MAX_SD))
+	{
+		imuRejected++;
+		
+		motion += 2;
+		
+		if(motion >= 2 * CALI_MOTION_SAMPLES) RestartMPU6050();
+	}
+	else
+	{
+		if(motion > 0) motion--;
+		
+		Stats_Add(&gx, x);
+		Stats_Add(&gy, y);
+		Stats_Add(&gz, z);
+		Stats_Add(&pitch, tmp);
+		
+		// 开头的CALI_OUTLIER_MIN_N个点不剔除，从头开始时还在碰动则会混入，此后它们的标准差超过上限，
+		// 正常的点也判不出偏离，混入的点一直留在统计中
+		if(gx.N == CALI_OUTLIER_MIN_N &&
+		   (Stats_GetStdDev(&gx) > CALI_GYRO_MAX_SD || Stats_GetStdDev(&gy) > CALI_GYRO_MAX_SD ||
+		    Stats_GetStdDev(&gz) > CALI_GYRO_MAX_SD || Stats_GetStdDev(&pitch) > CALI_PITCH_MAX_SD))
+		{
+			RestartMPU6050();
+		}
+	}
+	
+	uint8_t enough = gx.N >= CALI_IMU_MIN_SAMPLES;
+	uint8_t converged = enough && Stats_GetStdErr(&gx) <= CALI_GYRO_TOL && Stats_GetStdErr(&gy) <= CALI_GYRO_TOL &&
+	                    Stats_GetStdErr(&gz) <= CALI_GYRO_TOL && Stats_GetStdErr(&pitch) <= CALI_PITCH_TOL;
+	uint8_t acceptable = enough && Stats_GetStdErr(&gx) <= CALI_GYRO_TOL * CALI_CAP_FACTOR &&
+	                     Stats_GetStdErr(&gy) <= CALI_GYRO_TOL * CALI_CAP_FACTOR &&
+	                     Stats_GetStdErr(&gz) <= CALI_GYRO_TOL * CALI_CAP_FACTOR &&
+	                     Stats_GetStdErr(&pitch) <= CALI_PITCH_TOL * CALI_CAP_FACTOR;
+	
+	return Check(Elapsed(), CALI_IMU_MS, converged, acceptable);
+}
+
+//
+// @简介：小车被碰动，IMU的统计从头开始
+//
+static void RestartMPU6050(void)
+{
+	App_Cmd_Printf("cali: motion, restart\n");
+	
+	Stats_Init(&gx);
+	Stats_Init(&gy);
+	Stats_Init(&gz);
+	Stats_Init(&pitch);
+	motion = 0;
+}
+
+//
+// @简介：样本偏离均值是否超过CALI_OUTLIER_SIGMA倍标准差
+// @参数：MinSd、MaxSd - 标准差的下限和上限。开头的几个样本受到干扰时标准差很大，
+//        有上限才能把此后正常的样本判为偏离，大部分被剔除时统计从头开始
+//
+static uint8_t IsOutlier(const Stats_TypeDef *Stats, float x, float MinSd, float MaxSd)
+{
+	if(Stats->N < CALI_OUTLIER_MIN_N) return 0;
+	
+	float sd = Stats_GetStdDev(Stats);
+	
+	if(sd < MinSd) sd = MinSd;
+	if(sd > MaxSd) sd = MaxSd;
+	
+	return fabsf(x - Stats->Mean) > CALI_OUTLIER_SIGMA * sd;
+}
+
+//
+// @简介：判断一项测量是否结束
+// @参数：Elapsed - 已经测量的时间，单位ms
+// @参数：Cap - 时间上限，单位ms
+// @参数：Converged - 样本数和标准误差都已满足要求
+// @参数：Acceptable - 标准误差不超过容差的CALI_CAP_FACTOR倍，到达上限时仍可采用
+// @返回值：0 - 继续测量，1 - 完成，-1 - 到达上限仍不满足要求，失败
+//
+static int8_t Check(uint32_t Elapsed, uint32_t Cap, uint8_t Converged, uint8_t Acceptable)
+{
+	if(Converged) return 1;
+	
+	if(Elapsed < Cap) return 0;
+	
+	return Acceptable ? 1 : -1;
+}
+
+static uint8_t Progress(void)
+{
+	uint32_t elapsed = Elapsed();
+	
+	switch(state)
+	{
+		case CALI_STATE_COUNTDOWN: return elapsed * 100 / CALI_COUNTDOWN_MS;
+		case CALI_STATE_SPINUP:    return elapsed * 100 / CALI_SPINUP_MS;
+		case CALI_STATE_ENCODER:   return elapsed * 100 / CALI_ENCODER_MS; // 相对于上限，满足要求时提前结束
+		case CALI_STATE_SETTLE:    return elapsed * 100 / CALI_SETTLE_MS;
+		case CALI_STATE_IMU:       return elapsed * 100 / CALI_IMU_MS;
+		default:                   return 100;
+	}
+}
+
+static void LoadCaliResult(void)
+{
+	EncoderCali_TypeDef encoder;
+	IMUCali_TypeDef imu;
+	
+	// #1. 给校准信息赋默认值
+	caliResult.encoder_duty_l = 0.5f;
+	caliResult.encoder_duty_r = 0.5f;
+	caliResult.mpu6050_gx_bias = 0;
+	caliResult.mpu6050_gy_bias = 0;
+	caliResult.mpu6050_gz_bias = 0;
+	caliResult.mpu6050_pitch_bias = 0;
+	
+	// #2. 从参数存储中加载，两部分分别保存，缺一部分时该部分用默认值；
+	//     旧版本的记录没有噪声的部分，噪声保持为0（未知）
+	uint8_t found = 0;
+	int len;
+	
+	memset(&caliNoise, 0, sizeof(caliNoise));
+	
+	len = App_Flash_Read(APP_FLASH_KEY_ENCODER, &encoder, sizeof(encoder));
+	
+	if(len == sizeof(encoder) || len == ENCODER_CALI_V1_SIZE)
+	{
+		caliResult.encoder_duty_l = encoder.duty_l;
+		caliResult.encoder_duty_r = encoder.duty_r;
+		found = 1;
+	}
+	
+	if(len == sizeof(encoder))
+	{
+		caliNoise.encoder_duty_l_sd = encoder.duty_l_sd;
+		caliNoise.encoder_duty_r_sd = encoder.duty_r_sd;
+		caliNoise.encoder_samples = encoder.samples;
+		caliNoise.encoder_rejected = encoder.rejected;
+	}
+	
+	len = App_Flash_Read(APP_FLASH_KEY_IMU, &imu, sizeof(imu));
+	
+	if(len == sizeof(imu) || len == IMU_CALI_V1_SIZE)
+	{
+		caliResult.mpu6050_gx_bias = imu.gx_bias;
+		caliResult.mpu6050_gy_bias = imu.gy_bias;
+		caliResult.mpu6050_gz_bias = imu.gz_bias;
+		caliResult.mpu6050_pitch_bias = imu.pitch_bias;
+		found = 1;
+	}
+	
+	if(len == sizeof(imu))
+	{
+		caliNoise.mpu6050_gx_sd = imu.gx_sd;
+		caliNoise.mpu6050_gy_sd = imu.gy_sd;
+		caliNoise.mpu6050_gz_sd = imu.gz_sd;
+		caliNoise.mpu6050_pitch_sd = imu.pitch_sd;
+		caliNoise.mpu6050_samples = imu.samples;
+		caliNoise.mpu6050_rejected = imu.rejected;
+	}
+	
+	if(found) return;
+	
+	// #3. 导入旧版本的校准结果，Page127在下一次垃圾回收时才会被擦除，此前已经导入
+	const CaliResult_TypeDef *legacy = (const CaliResult_TypeDef *)CALI_LEGACY_ADDR_START;
+	
+	if(legacy->key == CALI_LEGACY_KEY)
+	{
+		caliResult = *legacy;
+		SaveCaliResult();
+	}
+}
+
+//
+// @简介：将校准结果保存到参数存储中
+// @注意：只追加记录，不擦除整页；保存过程中掉电时之前的校准结果仍然有效
+//
+static void SaveCaliResult(void)
+{
+	EncoderCali_TypeDef encoder;
+	IMUCali_TypeDef imu;
+	
+	memset(&encoder, 0, sizeof(encoder));
+	memset(&imu, 0, sizeof(imu));
+	
+	encoder.duty_l = caliResult.encoder_duty_l;
+	encoder.duty_r = caliResult.encoder_duty_r;
+	encoder.duty_l_sd = caliNoise.encoder_duty_l_sd;
+	encoder.duty_r_sd = caliNoise.encoder_duty_r_sd;
+	encoder.samples = caliNoise.encoder_samples;
+	encoder.rejected = caliNoise.encoder_rejected;
+	
+	imu.gx_bias = caliResult.mpu6050_gx_bias;
+	imu.gy_bias = caliResult.mpu6050_gy_bias;
+	imu.gz_bias = caliResult.mpu6050_gz_bias;
+	imu.pitch_bias = caliResult.mpu6050_pitch_bias;
+	imu.gx_sd = caliNoise.mpu6050_gx_sd;
+	imu.gy_sd = caliNoise.mpu6050_gy_sd;
+	imu.gz_sd = caliNoise.mpu6050_gz_sd;
+	imu.pitch_sd = caliNoise.mpu6050_pitch_sd;
+	imu.samples = caliNoise.mpu6050_samples;
+	imu.rejected = caliNoise.mpu6050_rejected;
+	
+	App_Flash_Write(APP_FLASH_KEY_ENCODER, &encoder, sizeof(encoder));
+	App_Flash_Write(APP_FLASH_KEY_IMU, &imu, sizeof(imu));
+}
@@ -1,27 +1,48 @@
-#ifndef APP_CALIBRATOR_H
-#define APP_CALIBRATOR_H
-
-#include "stm32f10x.h"
-
-/*
-* @简介：该结构体用于存储校准参数
-*/
-typedef struct
-{
-	uint64_t key; // 用于校验是否存在有效的校准信息，当该值等于CALIBRATOR_KEY时表示校准信息有效
-	
-	// 编码器校准相关
-	float encoder_duty_l; // 左编码器占空比
-	float encoder_duty_r; // 右编码器占空比
-	float mpu6050_gx_bias; // 陀螺仪x轴偏移量
-	float mpu6050_gy_bias;
-	float mpu6050_gz_bias;
-	float mpu6050_pitch_bias;
-	
-} CaliResult_TypeDef;
-
-void App_Calibrator_Init(void);
-void App_Calibrator_DoCalibration(void);
-const CaliResult_TypeDef *App_Calibrator_GetResult(void);
-
-#endif
+#ifndef APP_CALIBRATOR_H
+#define APP_CALIBRATOR_H
+
+#include "stm32f10x.h"
+
+/*
+* @简介：该结构体用于存储校准参数
+*/
+typedef struct
+{
+	uint64_t key; // 仅用于导入旧版本保存在Page127的校准结果，当该值等于CALI_LEGACY_KEY时有效
+	
+	// 编码器校准相关
+	float encoder_duty_l; // 左编码器占空比
+	float encoder_duty_r; // 右编码器占空比
+	float mpu6050_gx_bias; // 陀螺仪x轴偏移量
+	float mpu6050_gy_bias;
+	float mpu6050_gz_bias;
+	float mpu6050_pitch_bias;
+	
+} CaliResult_TypeDef;
+
+/*
+* @简介：校准时测得的噪声，与校准结果一起保存，用于判断传感器和安装的状况
+*/
+typedef struct
+{
+	float encoder_duty_l_sd; // 每段（CALI_ENCODER_WINDOW_MS）测得的左编码器占空比的标准差
+	float encoder_duty_r_sd;
+	float mpu6050_gx_sd; // 陀螺仪x轴的噪声（标准差），单位：度/s
+	float mpu6050_gy_sd;
+	float mpu6050_gz_sd;
+	float mpu6050_pitch_sd; // 倾角的噪声（标准差），单位：度
+	uint16_t encoder_samples; // 参与统计的段数，0表示未知（旧版本的校准结果）
+	uint16_t encoder_rejected; // 剔除的段数
+	uint16_t mpu6050_samples; // 参与统计的点数，0表示未知
+	uint16_t mpu6050_rejected; // 剔除的点数
+} CaliNoise_TypeDef;
+
+void App_Calibrator_Init(void);
+void App_Calibrator_Start(void);
+void App_Calibrator_Cancel(void);
+uint8_t App_Calibrator_IsBusy(void);
+void App_Calibrator_Proc(void);
+const CaliResult_TypeDef *App_Calibrator_GetResult(void);
+const CaliNoise_TypeDef *App_Calibrator_GetNoise(void);
+
+#endif
@@ -1,140 +1,232 @@
-#include "app_cmd.h"
-#include "usart.h"
-#include <string.h>
-#include <stdlib.h>
-#include "app_control.h"
-
-void App_Cmd_Init(void)
-{
-	// #1. 初始化IO引脚
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
-	
-	GPIO_InitTypeDef GPIO_InitStruct = {0};
-	
-	// PB10 AF_PP
-	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_10;
-	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;
-	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_2MHz;
-	
-	GPIO_Init(GPIOB, &GPIO_InitStruct);
-	
-	// PA3 IPU
-	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_11;
-	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
-	
-	GPIO_Init(GPIOB, &GPIO_InitStruct);
-	
-	// #2. 开启USART3的时钟
-	RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART3, ENABLE);
-	
-	// #3. 配置USART3的参数
-	USART_InitTypeDef USART_InitStruct = {0};
-	
-	USART_InitStruct.USART_BaudRate = 9600;
-	USART_InitStruct.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
-	USART_InitStruct.USART_Parity = USART_Parity_No;
-	USART_InitStruct.USART_StopBits = USART_StopBits_1;
-	USART_InitStruct.USART_WordLength = USART_WordLength_8b;
-	USART_Init(USART3, &USART_InitStruct);
-	
-	// #4. 配置RxNE中断
-	USART_ITConfig(USART3, USART_IT_RXNE, ENABLE);
-	
-	NVIC_InitTypeDef NVIC_InitStruct = {0};
-	NVIC_InitStruct.NVIC_IRQChannel = USART3_IRQn;
-	NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
-	NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 0;
-	NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
-	
-	NVIC_Init(&NVIC_InitStruct);
-	
-	// #5. 闭合USART3的总开关
-	USART_Cmd(USART3, ENABLE);
-}
-
-static char buffer[64];
-static char cmd[64];
-static uint16_t cursor = 0;
-static volatile uint8_t cmdPending = 0;
-
-void USART3_IRQHandler(void)
-{
-	if(USART_GetFlagStatus(USART3, USART_FLAG_RXNE) == SET)
-	{
-		uint8_t dataRcvd = USART_ReceiveData(USART3);
-		
-		if(dataRcvd == '\n')
-		{
-			buffer[cursor++] = '\0';
-			strcpy(cmd, buffer);
-			cursor = 0; // 清空
-			cmdPending = 1;
-		}
-		else
-		{
-			if(cursor >= 254)
-			{
-				cursor = 0; // 清空
-			}
-			
-			buffer[cursor++] = dataRcvd;
-		}
-	}
-}
-
-static void Move_Handler(const char *Args);
-
-void App_Cmd_Proc(void)
-{
-	char cmdCpy[64];
-	
-	if(!cmdPending) return;
-	
-	__disable_irq();
-	
-	strcpy(cmdCpy, cmd); // 取出消息
-	cmdPending = 0;
-	
-	__enable_irq();
-
-	
-	// 对消息进行解析
-	
-	// 将所有的空格替换成'\0'
-	uint16_t len = strlen(cmdCpy);
-	
-	for(uint16_t i=0;i<len; i++)
-	{
-		if(cmdCpy[i] == ' ')
-		{
-			cmdCpy[i] = '\0';
-		}
-	}
-	
-	const char *name = cmdCpy;
-	
-	if(strcasecmp(name, "move") == 0)
-	{
-		Move_Handler(cmdCpy);
-	}
-}
-
-static void Move(int8_t Speed, int8_t Turn)
-{
-//	My_USART_Printf(USART2, "%d,%d\n", Speed, Turn);
-	
-	App_Control_Move(Speed, Turn);
-}
-
-static void Move_Handler(const char *Args)
-{
-	const char *ptr = Args + strlen(Args) + 1;
-	
-	int8_t turn = atoi(ptr);
-	
-	ptr = ptr + strlen(ptr) + 1;
-	
-	int8_t speed = atoi(ptr);
-	
-	Move(speed, turn);
-}
+#include "app_cmd.h"
+#include "usart.h"
+#include "serial.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include "fmt.h"
+#include "app_control.h"
+#include "app_calibrator.h"
+
+//
+// USART3（PB10/PB11，9600bps）接收命令，一行一条，以'\n'结束。
+// 接收由DMA1_Channel3循环写入，App_Cmd_Proc在主循环中取出并拼成一行；
+// DMA1_Channel2已被灯带（TIM2_UP）占用，发送改用TXE中断
+//
+#define CMD_TX_BUFFER_SIZE 128
+#define CMD_RX_BUFFER_SIZE 64
+
+static uint8_t txBuffer[CMD_TX_BUFFER_SIZE];
+static uint8_t rxBuffer[CMD_RX_BUFFER_SIZE];
+static Serial_TypeDef serial;
+
+void App_Cmd_Init(void)
+{
+	// #1. 初始化IO引脚
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	// PB10 AF_PP
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_10;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;
+	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_2MHz;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	// PA3 IPU
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_11;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	// #2. 开启USART3的时钟
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART3, ENABLE);
+	
+	// #3. 配置USART3的参数
+	USART_InitTypeDef USART_InitStruct = {0};
+	
+	USART_InitStruct.USART_BaudRate = 9600;
+	USART_InitStruct.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
+	USART_InitStruct.USART_Parity = USART_Parity_No;
+	USART_InitStruct.USART_StopBits = USART_StopBits_1;
+	USART_InitStruct.USART_WordLength = USART_WordLength_8b;
+	USART_Init(USART3, &USART_InitStruct);
+	
+	// #4. 配置发送队列和接收缓冲区
+	Serial_InitTypeDef Serial_InitStruct = {0};
+	
+	Serial_InitStruct.USARTx = USART3;
+	Serial_InitStruct.TxDMAy_Channelx = NULL;
+	Serial_InitStruct.RxDMAy_Channelx = DMA1_Channel3;
+	Serial_InitStruct.pTxBuffer = txBuffer;
+	Serial_InitStruct.TxBufferSize = CMD_TX_BUFFER_SIZE;
+	Serial_InitStruct.pRxBuffer = rxBuffer;
+	Serial_InitStruct.RxBufferSize = CMD_RX_BUFFER_SIZE;
+	Serial_InitStruct.NVIC_IRQChannelPreemptionPriority = 0;
+	
+	My_Serial_Init(&serial, &Serial_InitStruct);
+	
+	// #5. 闭合USART3的总开关
+	USART_Cmd(USART3, ENABLE);
+}
+
+//
+// @简介：经USART3发送格式化的字符串，放入发送队列后立即返回，队列放不下的部分丢弃
+// @注意：一次不超过64个字符
+//
+void App_Cmd_Printf(const char *Format, ...)
+{
+	char buffer[64];
+	va_list argptr;
+	
+	__va_start(argptr, Format);
+	
+	int n = Fmt_VFormat(buffer, sizeof(buffer), Format, argptr);
+	
+	__va_end(argptr);
+	
+	My_Serial_Write(&serial, buffer, n);
+}
+
+void USART3_IRQHandler(void)
+{
+	My_Serial_IRQHandler(&serial);
+}
+
+void DMA1_Channel3_IRQHandler(void)
+{
+	My_Serial_RxDMA_IRQHandler(&serial);
+}
+
+static char line[64];
+static uint16_t cursor = 0;
+
+static void Move_Handler(const char *Args);
+static void Mode_Handler(const char *Args);
+static void Save_Handler(void);
+static void Cali_Handler(const char *Args);
+
+void App_Cmd_Proc(void)
+{
+	char cmdCpy[64] = {0}; // 末尾补0，缺少参数时取到的是空串
+	uint8_t byte;
+	uint8_t complete = 0;
+	
+	while(!complete && My_Serial_Read(&serial, &byte, 1) == 1)
+	{
+		if(byte == '\n')
+		{
+			line[cursor] = '\0';
+			strcpy(cmdCpy, line); // 取出消息
+			cursor = 0; // 清空
+			complete = 1;
+		}
+		else if(cursor >= sizeof(line) - 1)
+		{
+			cursor = 0; // 过长，丢弃
+		}
+		else
+		{
+			line[cursor++] = byte;
+		}
+	}
+	
+	if(!complete) return;
+	
+	// 对消息进行解析
+	
+	// 将所有的空格替换成'\0'
+	uint16_t len = strlen(cmdCpy);
+	
+	for(uint16_t i=0;i<len; i++)
+	{
+		if(cmdCpy[i] == ' ')
+		{
+			cmdCpy[i] = '\0';
+		}
+	}
+	
+	const char *name = cmdCpy;
+	
+	if(strcasecmp(name, "move") == 0)
+	{
+		Move_Handler(cmdCpy);
+	}
+	else if(strcasecmp(name, "mode") == 0)
+	{
+		Mode_Handler(cmdCpy);
+	}
+	else if(strcasecmp(name, "save") == 0)
+	{
+		Save_Handler();
+	}
+	else if(strcasecmp(name, "cali") == 0)
+	{
+		Cali_Handler(cmdCpy);
+	}
+}
+
+static void Move(int8_t Speed, int8_t Turn)
+{
+//	My_USART_Printf(USART2, "%d,%d\n", Speed, Turn);
+	
+	App_Control_Move(Speed, Turn);
+}
+
+static void Move_Handler(const char *Args)
+{
+	const char *ptr = Args + strlen(Args) + 1;
+	
+	int8_t turn = atoi(ptr);
+	
+	ptr = ptr + strlen(ptr) + 1;
+	
+	int8_t speed = atoi(ptr);
+	
+	Move(speed, turn);
+}
+
+//
+// @简介：切换控制模式，格式 mode pid 或 mode lqr
+//
+static void Mode_Handler(const char *Args)
+{
+	const char *ptr = Args + strlen(Args) + 1;
+	
+	if(strcasecmp(ptr, "lqr") == 0)
+	{
+		App_Control_SetMode(CONTROL_MODE_LQR);
+	}
+	else if(strcasecmp(ptr, "pid") == 0)
+	{
+		App_Control_SetMode(CONTROL_MODE_CASCADE);
+	}
+}
+
+//
+// @简介：保存当前的PID增益（例如经遥测的set命令在线调整后），格式 save，回复ok或failed
+//
+static void Save_Handler(void)
+{
+	const char *reply = (App_Control_SaveGains() == 0) ? "ok\n" : "failed\n";
+	
+	My_Serial_Write(&serial, (const uint8_t *)reply, strlen(reply));
+}
+
+//
+// @简介：开始或取消校准，格式 cali 或 cali stop，进度经USART3报告
+//
+static void Cali_Handler(const char *Args)
+{
+	const char *ptr = Args + strlen(Args) + 1;
+	
+	if(strcasecmp(ptr, "stop") == 0)
+	{
+		App_Calibrator_Cancel();
+	}
+	else
+	{
+		App_Calibrator_Start();
+	}
+}
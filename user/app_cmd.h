@@ -1,9 +1,10 @@
-#ifndef APP_CMD_H
-#define APP_CMD_H
-
-#include "stm32f10x.h"
-
-void App_Cmd_Init(void);
-void App_Cmd_Proc(void);
-
-#endif
+#ifndef APP_CMD_H
+#define APP_CMD_H
+
+#include "stm32f10x.h"
+
+void App_Cmd_Init(void);
+void App_Cmd_Proc(void);
+void App_Cmd_Printf(const char *Format, ...);
+
+#endif
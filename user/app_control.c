@@ -1,264 +1,654 @@
-#include "app_control.h"
-#include "app_pwm.h"
-#include "app_encoder.h"
-#include "app_bat.h"
-#include "app_mpu6050.h"
-#include "pid.h"
-#include "task.h"
-#include "qmath.h"
-#include "usart.h"
-#include "app_motor.h"
-
-static PID_TypeDef pid_alpha;
-static PID_TypeDef pid_dalpha;
-static PID_TypeDef pid_vel;
-static PID_TypeDef pid_turn;
-static float omega_ref = 0;
-
-static uint8_t standingUp = 0;
-
-const float g = 9.8;   // 重力加速度
-
-// 车体参数
-static float rw = 0.032f; // 轮胎半径，单位m
-static float lp = 0.062f; // 摆的长度，单位m
-static float mp = 0.12f; // 摆的质量，单位kg
-//static float mw = 0.26f; // 轮的质量，单位kg
-static float Jp = 4.6128e-4f; // 摆的转动惯量
-
-static void StartUp(void);
-
-//static float rad_2_deg(float rad)
-//{
-//	return rad * 57.295779513f;
-//}
-
-static float deg_2_rad(float deg)
-{
-	return deg * 0.0174532925f;
-}
-
-void App_Control_Init(void)
-{
-	PID_InitTypeDef PID_InitStruct = {0};
-	
-	//
-	// 速度环
-	//
-	PID_InitStruct.Kp = 0.2f;
-	PID_InitStruct.Ki = 0.002f;
-	PID_InitStruct.Kd = 0.0f;
-	
-	PID_InitStruct.DefaultOutput = 0;
-	PID_InitStruct.Setpoint = 0;
-	PID_InitStruct.OutputUpperLimit =  9.8f; // 输出量：加速度a，单位m/s^2，设其最大与重力加速度g相同
-	PID_InitStruct.OutputLowerLimit = -9.8f;
-	
-	PID_Init(&pid_vel, &PID_InitStruct);
-	
-	//
-	// 角度环
-	//
-	PID_InitStruct.Kp = 7;
-	PID_InitStruct.Ki = 7;
-	PID_InitStruct.Kd = 0;
-	
-	PID_InitStruct.DefaultOutput = 0;
-	PID_InitStruct.Setpoint = 0;
-	PID_InitStruct.OutputUpperLimit =  6.28f; // 输出量：角速度，单位rad/s，设其最大值为2PI rad/s
-	PID_InitStruct.OutputLowerLimit = -6.28f;
-	
-	PID_Init(&pid_alpha, &PID_InitStruct);
-	
-	//
-	// 角速度环
-	//
-	PID_InitStruct.Kp = 30;
-	PID_InitStruct.Ki = 30;
-	PID_InitStruct.Kd = 0;
-	
-	PID_InitStruct.DefaultOutput = 0;
-	PID_InitStruct.Setpoint = 0;
-	PID_InitStruct.OutputUpperLimit =  100.0f; // 输出量：角加速度，设其
-	PID_InitStruct.OutputLowerLimit = -100.0f;
-	
-	PID_Init(&pid_dalpha, &PID_InitStruct);
-	
-	//
-	// 转向环
-	// 
-	PID_InitStruct.Kp = 1;
-	PID_InitStruct.Ki = 0;
-	PID_InitStruct.Kd = 0;
-	
-	PID_InitStruct.DefaultOutput = 0;
-	PID_InitStruct.Setpoint = 0;
-	PID_InitStruct.OutputUpperLimit =  10.0f;
-	PID_InitStruct.OutputLowerLimit = -10.0f;
-	
-	PID_Init(&pid_turn, &PID_InitStruct);
-}
-
-void App_Control_Proc(void)
-{
-	PERIODIC(5);
-	
-	if(standingUp) // 小车自动起立
-	{
-		StartUp();
-		return; 
-	}
-	
-	uint64_t now = GetUs();
-	
-	static uint64_t lastTime = 0;
-	
-	float deltaT = (now - lastTime) * 1.0e-6f;
-	
-	lastTime = now;
-	
-	// 采集传感器信息，角度和角速度
-	
-	float alpha = deg_2_rad(App_MPU6050_GetPitch()); // MPU6050传感器给出的是角度值，要转换成弧度值
-	
-	float dalpha = deg_2_rad(App_MPU6050_GetGyroX()); // rad/s
-	
-	float gz = deg_2_rad(App_MPU6050_GetGyroZ()); // rad/s
-	
-	///////////////////////////////////////////////////////////////////////
-	// 速度环
-	///////////////////////////////////////////////////////////////////////
-	
-	// 采集车轮速度
-	float v = (App_Motor_GetSpeed_L() + App_Motor_GetSpeed_R()) / 2.0f + dalpha * (lp+rw) / rw;
-	
-	float alpha_ref = qatan(PID_Compute1(&pid_vel, v, now)/ g);
-	
-	
-	///////////////////////////////////////////////////////////////////////
-	// pid外环，角度环
-	///////////////////////////////////////////////////////////////////////
-	
-	PID_ChangeSetpoint(&pid_alpha, alpha_ref);
-	
-	float dalpha_ref = PID_Compute1(&pid_alpha, alpha, now);
-	
-	///////////////////////////////////////////////////////////////////////
-	// pid内环，角速度环
-	///////////////////////////////////////////////////////////////////////
-	
-	PID_ChangeSetpoint(&pid_dalpha, dalpha_ref);
-	
-	float ddalpha_ref = PID_Compute1(&pid_dalpha, dalpha, now);
-	
-	// 解算，根据角加速度计算水平向加速度
-	
-	// float ddx_ref = (lp*ddalpha_ref - g*qsin(alpha)) / qcos(alpha);
-	float ddx_ref = (Jp*ddalpha_ref - mp*g*lp*qsin(alpha)) / (mp*lp*qcos(alpha));
-	
-	// 对加速度积分，得到期望速度
-	
-	omega_ref += ddx_ref * deltaT / rw;
-	
-	if(omega_ref >  40) omega_ref = 40;
-	if(omega_ref < -40) omega_ref = -40;
-		
-	///////////////////////////////////////////////////////////////////////
-	// 转向环
-	///////////////////////////////////////////////////////////////////////
-	
-	float omega_turn = PID_Compute1(&pid_turn, gz, now);
-	
-	if(fabsf(alpha) > deg_2_rad(80)) // 小车摔倒
-	{
-		standingUp = 5; // 进入自动起立模式
-	}
-	
-	App_Motor_SetSpeed_L(-omega_ref + omega_turn);
-	App_Motor_SetSpeed_R(-omega_ref - omega_turn);
-}
-
-void App_Control_Move(float speed, float turn)
-{
-	PID_ChangeSetpoint(&pid_vel, -speed / 3.8f);
-	PID_ChangeSetpoint(&pid_turn, -turn / 7.0f);
-}
-
-static void StartUp(void)
-{
-	static uint32_t lastTime;
-	
-	switch(standingUp)
-	{
-		case 1: // 第1阶段，准备停转500ms
-		{
-			lastTime = GetTick();
-			standingUp = 2; // 进入停转等待
-			
-			App_Motor_SetSpeed_L(0);
-			App_Motor_SetSpeed_R(0);
-			
-			break;
-		}
-		case 2: // 停转等待
-		{
-			if(GetTick() - lastTime > 500)
-			{
-				standingUp = 3;
-			}
-			break;
-		}
-		case 3: // 最大功率反向转动
-		{
-			App_Motor_Reset();
-				
-			if(App_MPU6050_GetPitch() > 0) // 向前倒
-			{
-				App_Motor_SetSpeed_L(999);
-				App_Motor_SetSpeed_R(999);
-			}
-			else // 向后倒
-			{
-				App_Motor_SetSpeed_L(-999);
-				App_Motor_SetSpeed_R(-999);
-			}
-			
-			lastTime = GetTick();
-			
-			standingUp = 4;
-			
-			break;
-		}
-		case 4: // 检测是否立起
-		{
-			if(fabsf(App_MPU6050_GetPitch()) < 40)
-			{
-				standingUp = 0;
-				App_Control_Reset();
-				App_Motor_Reset();
-				break;
-			}
-			
-			if(GetTick() - lastTime > 5000) // 超时，起立失败
-			{
-				App_Motor_Cmd(DISABLE);
-				standingUp = 5;
-			}
-			break;
-		}
-		case 5: // 起立失败
-			App_Motor_Cmd(DISABLE);
-			break;
-	}
-}
-
-void App_Control_Reset(void)
-{
-	PID_Reset(&pid_alpha);
-	PID_Reset(&pid_dalpha);
-	PID_Reset(&pid_vel);
-	PID_Reset(&pid_turn);
-	App_Motor_Reset();
-	omega_ref = 0;
-	standingUp = 0;
-}
+#include "app_control.h"
+#include "app_pwm.h"
+#include "app_encoder.h"
+#include "app_bat.h"
+#include "app_mpu6050.h"
+#include "pid.h"
+#include "cascade.h"
+#include "lqr.h"
+#include "app_lqr_gain.h"
+#include "app_pid_gain.h"
+#include "task.h"
+#include "pt.h"
+#include "qmath.h"
+#include "usart.h"
+#include "app_motor.h"
+#include "app_trace.h"
+#include "app_telemetry.h"
+#include "app_blackbox.h"
+#include "app_flash.h"
+#include "app_calibrator.h"
+#include "app_boot.h"
+#include "app_bus.h"
+
+// 控制任务分为三个速率组，各级PID的离散系数由各自的周期算出（PID_InitFixedRate），增益不随周期变化：
+//   CONTROL_RATE_MS   - 基本周期，角速度环和对期望加速度的积分，与电机速度环同为1kHz
+//   CONTROL_PERIOD_MS - 姿态的更新周期（MPU6050_ATTITUDE_DIV），角度环、LQR、摔倒检测、黑匣子
+//   CONTROL_VEL_MS    - 速度环和转向环
+// 慢速组的输出在两次运行之间保持不变，作为快速组的设定值（Cascade_Run）
+#define CONTROL_RATE_MS   1
+#define CONTROL_PERIOD_MS 5
+#define CONTROL_VEL_MS    20
+#define CONTROL_RATE_TS (CONTROL_RATE_MS * 1.0e-3f)
+#define CONTROL_TS (CONTROL_PERIOD_MS * 1.0e-3f)
+#define CONTROL_PERIOD_DIV (CONTROL_PERIOD_MS / CONTROL_RATE_MS)
+
+// LQR的状态量编号，须与tools/lqr_gen.c中的顺序一致
+#define LQR_STATE_ALPHA  0 // 倾角，单位rad
+#define LQR_STATE_DALPHA 1 // 倾角速度，单位rad/s
+#define LQR_STATE_POS    2 // 轮子位置，单位m
+#define LQR_STATE_VEL    3 // 轮子速度，单位m/s
+#define LQR_STATE_YAW    4 // 偏航角速度，单位rad/s
+
+// LQR的控制量编号
+#define LQR_INPUT_ACC    0 // 水平加速度，单位m/s^2
+#define LQR_INPUT_TURN   1 // 左右轮差动角加速度，单位rad/s^2
+
+static Cascade_TypeDef cascade; // 速度环 -> 角度环 -> 角速度环，以及独立的转向环
+static int8_t stage_vel;
+static int8_t stage_alpha;
+static int8_t stage_dalpha;
+static int8_t stage_turn;
+
+// 各级的反馈量，在Cascade_Run之前更新
+static float v;
+static float alpha;
+static float dalpha;
+static float gz;
+
+static LQR_TypeDef lqr; // 全状态反馈，增益由tools/lqr_gen生成
+static uint8_t mode = CONTROL_MODE_CASCADE;
+
+static float omega_ref = 0;
+static float omega_turn = 0;
+static float ddx_ref = 0; // 期望的水平加速度，单位m/s^2
+
+static uint8_t standingUp = 0;
+static PT_TypeDef standUpPt; // 摔倒后的处理（StartUp）的协程
+
+static float posErr = 0; // LQR的位置参考值与当前位置之差，写入热启动的检查点
+
+static int32_t imuAge = 0; // 本周期使用的样本的年龄（Bus_GetAge），单位us，-1表示还没有发布过
+static int32_t wheelAge = 0;
+
+const float g = 9.8;   // 重力加速度
+
+// 车体参数
+static float rw = 0.032f; // 轮胎半径，单位m
+static float lp = 0.062f; // 摆的长度，单位m
+static float mp = 0.12f; // 摆的质量，单位kg
+//static float mw = 0.26f; // 轮的质量，单位kg
+static float Jp = 4.6128e-4f; // 摆的转动惯量
+
+static uint8_t StartUp(PT_TypeDef *pt);
+static float acc_2_alpha(float acc);
+static float GetPos(void);
+static void Record(uint32_t Us, uint8_t Overrun);
+static void AddGain(const char *Name, int8_t Stage, uint8_t Ki, float Max);
+static void OnGainWrite(void);
+static void LoadGains(void);
+static void Checkpoint(void);
+static void Resume(const BootCheckpoint_TypeDef *pCheckpoint);
+
+//static float rad_2_deg(float rad)
+//{
+//	return rad * 57.295779513f;
+//}
+
+static float deg_2_rad(float deg)
+{
+	return deg * 0.0174532925f;
+}
+
+//
+// @简介：速度环的输出（水平加速度）换算为角度环的设定值（倾角）
+//
+static float acc_2_alpha(float acc)
+{
+	return qatan(acc / g);
+}
+
+void App_Control_Init(void)
+{
+	Cascade_StageInitTypeDef StageInitStruct = {0};
+	PID_InitTypeDef *PID_InitStruct = &StageInitStruct.PID_InitStruct;
+	
+	Cascade_Init(&cascade, CONTROL_RATE_TS);
+	
+	//
+	// 速度环
+	//
+	PID_InitStruct->Kp = PID_GAIN_VEL_KP;
+	PID_InitStruct->Ki = PID_GAIN_VEL_KI;
+	PID_InitStruct->Kd = 0.0f;
+	
+	PID_InitStruct->DefaultOutput = 0;
+	PID_InitStruct->Setpoint = 0;
+	PID_InitStruct->OutputUpperLimit =  9.8f; // 输出量：加速度a，单位m/s^2，设其最大与重力加速度g相同
+	PID_InitStruct->OutputLowerLimit = -9.8f;
+	
+	StageInitStruct.pInput = &v;
+	StageInitStruct.Transform = acc_2_alpha;
+	StageInitStruct.Decimation = CONTROL_VEL_MS / CONTROL_RATE_MS;
+	StageInitStruct.Average = 1; // 轮速含有按1kHz更新的倾角速度的补偿项，取平均以免混叠
+	
+	stage_vel = Cascade_AddStage(&cascade, &StageInitStruct);
+	
+	//
+	// 角度环
+	//
+	PID_InitStruct->Kp = PID_GAIN_ALPHA_KP;
+	PID_InitStruct->Ki = PID_GAIN_ALPHA_KI;
+	PID_InitStruct->Kd = 0;
+	
+	PID_InitStruct->DefaultOutput = 0;
+	PID_InitStruct->Setpoint = 0;
+	PID_InitStruct->OutputUpperLimit =  6.28f; // 输出量：角速度，单位rad/s，设其最大值为2PI rad/s
+	PID_InitStruct->OutputLowerLimit = -6.28f;
+	
+	StageInitStruct.pInput = &alpha;
+	StageInitStruct.Transform = NULL;
+	StageInitStruct.Decimation = CONTROL_PERIOD_DIV;
+	StageInitStruct.Average = 0; // 姿态按本级的周期更新，直接使用刚到达的值（Cascade_Align）
+	
+	stage_alpha = Cascade_AddStage(&cascade, &StageInitStruct);
+	
+	//
+	// 角速度环
+	//
+	PID_InitStruct->Kp = PID_GAIN_DALPHA_KP;
+	PID_InitStruct->Ki = PID_GAIN_DALPHA_KI;
+	PID_InitStruct->Kd = 0;
+	
+	PID_InitStruct->DefaultOutput = 0;
+	PID_InitStruct->Setpoint = 0;
+	PID_InitStruct->OutputUpperLimit =  100.0f; // 输出量：角加速度，设其
+	PID_InitStruct->OutputLowerLimit = -100.0f;
+	
+	StageInitStruct.pInput = &dalpha;
+	StageInitStruct.Transform = NULL;
+	StageInitStruct.Decimation = 1;
+	
+	stage_dalpha = Cascade_AddStage(&cascade, &StageInitStruct);
+	
+	//
+	// 转向环
+	// 
+	PID_InitStruct->Kp = 1;
+	PID_InitStruct->Ki = 0;
+	PID_InitStruct->Kd = 0;
+	
+	PID_InitStruct->DefaultOutput = 0;
+	PID_InitStruct->Setpoint = 0;
+	PID_InitStruct->OutputUpperLimit =  10.0f;
+	PID_InitStruct->OutputLowerLimit = -10.0f;
+	
+	StageInitStruct.pInput = &gz;
+	StageInitStruct.Transform = NULL;
+	StageInitStruct.Decimation = CONTROL_VEL_MS / CONTROL_RATE_MS;
+	StageInitStruct.Average = 1; // 取本级周期内各次姿态的偏航角速度的平均值
+	
+	stage_turn = Cascade_AddStage(&cascade, &StageInitStruct);
+	
+	Cascade_Link(&cascade, stage_vel, stage_alpha);
+	Cascade_Link(&cascade, stage_alpha, stage_dalpha);
+	
+	LoadGains(); // 保存过的增益覆盖app_pid_gain.h中的默认值
+	
+	//
+	// LQR
+	//
+	LQR_InitTypeDef LQR_InitStruct = {0};
+	
+	LQR_InitStruct.K = LQR_GAIN_K;
+	LQR_InitStruct.NumStates = LQR_GAIN_NUM_STATES;
+	LQR_InitStruct.NumInputs = LQR_GAIN_NUM_INPUTS;
+	LQR_InitStruct.pOutputUpperLimit = NULL; // 由后面对omega_ref和omega_turn的限幅兜底
+	LQR_InitStruct.pOutputLowerLimit = NULL;
+	
+	LQR_Init(&lqr, &LQR_InitStruct);
+	
+	//
+	// 遥测，各级PID的输出和积分项，以及电机转速的参考值
+	//
+	App_Telemetry_AddChannel("v", TELEMETRY_FLOAT, &v, 100);
+	App_Telemetry_AddChannel("vel_out", TELEMETRY_FLOAT, &Cascade_GetPID(&cascade, stage_vel)->LastOutput, 1000);
+	App_Telemetry_AddChannel("vel_i", TELEMETRY_FLOAT, &Cascade_GetPID(&cascade, stage_vel)->ITerm, 1000);
+	App_Telemetry_AddChannel("alpha_out", TELEMETRY_FLOAT, &Cascade_GetPID(&cascade, stage_alpha)->LastOutput, 1000);
+	App_Telemetry_AddChannel("alpha_i", TELEMETRY_FLOAT, &Cascade_GetPID(&cascade, stage_alpha)->ITerm, 1000);
+	App_Telemetry_AddChannel("dalpha_out", TELEMETRY_FLOAT, &Cascade_GetPID(&cascade, stage_dalpha)->LastOutput, 100);
+	App_Telemetry_AddChannel("dalpha_i", TELEMETRY_FLOAT, &Cascade_GetPID(&cascade, stage_dalpha)->ITerm, 100);
+	App_Telemetry_AddChannel("turn_out", TELEMETRY_FLOAT, &Cascade_GetPID(&cascade, stage_turn)->LastOutput, 1000);
+	App_Telemetry_AddChannel("ddx_ref", TELEMETRY_FLOAT, &ddx_ref, 1000);
+	App_Telemetry_AddChannel("omega_ref", TELEMETRY_FLOAT, &omega_ref, 100);
+	App_Telemetry_AddChannel("omega_turn", TELEMETRY_FLOAT, &omega_turn, 100);
+	App_Telemetry_AddChannel("mode", TELEMETRY_UINT8, &mode, 1);
+	
+	//
+	// 调试时按需观察的变量，默认不发送；各级的增益可以在线修改，范围为整定值的0~4倍
+	//
+	App_Telemetry_AddVariable("standup", TELEMETRY_UINT8, &standingUp, 1);
+	App_Telemetry_AddVariable("imu_age", TELEMETRY_INT32, &imuAge, 1);
+	App_Telemetry_AddVariable("wheel_age", TELEMETRY_INT32, &wheelAge, 1);
+	
+	AddGain("vel_kp",    stage_vel,    0, PID_GAIN_VEL_KP * 4);
+	AddGain("vel_ki",    stage_vel,    1, PID_GAIN_VEL_KI * 4);
+	AddGain("alpha_kp",  stage_alpha,  0, PID_GAIN_ALPHA_KP * 4);
+	AddGain("alpha_ki",  stage_alpha,  1, PID_GAIN_ALPHA_KI * 4);
+	AddGain("dalpha_kp", stage_dalpha, 0, PID_GAIN_DALPHA_KP * 4);
+	AddGain("dalpha_ki", stage_dalpha, 1, PID_GAIN_DALPHA_KI * 4);
+	AddGain("turn_kp",   stage_turn,   0, 4.0f);
+	
+	//
+	// 热启动时接着复位前的状态运行
+	//
+	const BootCheckpoint_TypeDef *warm = App_Boot_GetWarm();
+	
+	if(warm != NULL) Resume(warm);
+}
+
+//
+// @简介：把一级PID的Kp或Ki登记为可写的变量
+// @参数：Name - 名称
+// @参数：Stage - 级的编号
+// @参数：Ki - 0 - Kp，1 - Ki
+// @参数：Max - 允许写入的最大值，最小值为0
+//
+static void AddGain(const char *Name, int8_t Stage, uint8_t Ki, float Max)
+{
+	PID_TypeDef *pid = Cascade_GetPID(&cascade, Stage);
+	int8_t ch = App_Telemetry_AddVariable(Name, TELEMETRY_FLOAT, Ki ? &pid->Ki : &pid->Kp, 1.0e4f);
+	
+	App_Telemetry_SetWritable(ch, 0, Max, OnGainWrite);
+}
+
+//
+// @简介：增益被修改后重新计算各级的离散系数，下一个控制周期生效
+//
+static void OnGainWrite(void)
+{
+	for(int8_t i=0; i<cascade.NumStages; i++)
+	{
+		PID_TypeDef *pid = Cascade_GetPID(&cascade, i);
+		
+		PID_ChangeTunings(pid, pid->Kp, pid->Ki, pid->Kd);
+	}
+}
+
+void App_Control_Proc(void)
+{
+	// 本周期的角速度还在读取（由I2C中断完成，约0.15~0.4ms），读完后再运行，使角速度环用上最新的样本
+	if(App_MPU6050_IsReading()) return;
+	
+	PERIODIC_LATE(CONTROL_RATE_MS, late);
+	
+	if(!App_MPU6050_IsReady()) return; // MPU6050还在初始化，没有姿态数据
+	
+	// 新的姿态到达时运行慢速组，MPU6050没有按时给出（例如I2C出错）时最迟每两个姿态周期运行一次
+	static uint32_t imuSeq = 0;
+	static uint8_t sinceAttitude = 0;
+	uint8_t attitude = Bus_Poll(&ImuTopic, &imuSeq) || ++sinceAttitude >= 2 * CONTROL_PERIOD_DIV;
+	
+	if(attitude)
+	{
+		sinceAttitude = 0;
+		Checkpoint(); // 上一个周期结束时的状态，校准期间也要写入（电机已关闭）
+	}
+	
+	if(App_Calibrator_IsBusy()) return; // 校准期间暂停，结束时由校准器复位
+	
+	static uint8_t synced = 0; // PERIODIC上电后先连续补跑到当前时刻，追上之前不判断超时
+	static uint8_t overrun = 0; // 自上次写入黑匣子以来是否超时
+	
+	uint32_t us = GetUs();
+	
+	App_Trace_Record(TRACE_CONTROL, 0, us, NULL, 0);
+	
+	// 比计划时刻落后一个姿态周期以上即为超时
+	if(late < CONTROL_PERIOD_MS)
+	{
+		synced = 1;
+	}
+	else if(synced)
+	{
+		overrun = 1;
+		App_BlackBox_Trigger(BLACKBOX_REASON_OVERRUN, us);
+	}
+	
+	// 姿态和轮速直接读取生产者发布的样本（app_bus.h），不再逐个调用各模块的Get函数
+	const ImuSample_TypeDef *imu = Bus_Read(&ImuTopic);
+	const GyroSample_TypeDef *gyro = Bus_Read(&GyroTopic);
+	const WheelState_TypeDef *wheel = Bus_Read(&WheelTopic);
+	
+	// 采集传感器信息，角速度每个周期更新，角度只在姿态更新时更新
+	
+	dalpha = deg_2_rad(gyro->Gx); // rad/s
+	
+	if(attitude)
+	{
+		alpha = deg_2_rad(imu->Pitch); // MPU6050传感器给出的是角度值，要转换成弧度值
+		
+		gz = deg_2_rad(imu->Gz); // rad/s
+		
+		imuAge = Bus_GetAge(&ImuTopic, us);
+	}
+	
+	wheelAge = Bus_GetAge(&WheelTopic, us);
+	
+	if(standingUp) // 小车摔倒，按姿态周期执行
+	{
+		if(!attitude) return;
+		
+		App_Motor_ClearSource(); // 电机已关闭，不统计延迟
+		StartUp(&standUpPt);
+		Record(us, overrun);
+		overrun = 0;
+		return; 
+	}
+	
+	// 采集车轮速度，电机任务最近一次测得的值
+	v = (wheel->Speed_L + wheel->Speed_R) / 2.0f + dalpha * (lp+rw) / rw;
+	
+	if(mode == CONTROL_MODE_LQR)
+	{
+		///////////////////////////////////////////////////////////////////////
+		// LQR：u = -K(x - x_ref)，增益按CONTROL_PERIOD_MS离散化，只在姿态更新时运行
+		///////////////////////////////////////////////////////////////////////
+		
+		if(attitude)
+		{
+			float x[LQR_GAIN_NUM_STATES];
+			float u[LQR_GAIN_NUM_INPUTS];
+			
+			// 位置参考值跟随速度参考值积分，移动时不会被位置反馈拉回原处
+			LQR_ChangeReference(&lqr, LQR_STATE_POS, LQR_GetReference(&lqr, LQR_STATE_POS) + LQR_GetReference(&lqr, LQR_STATE_VEL) * CONTROL_TS);
+			
+			x[LQR_STATE_ALPHA] = alpha;
+			x[LQR_STATE_DALPHA] = dalpha;
+			x[LQR_STATE_POS] = GetPos();
+			
+			posErr = LQR_GetReference(&lqr, LQR_STATE_POS) - x[LQR_STATE_POS];
+			x[LQR_STATE_VEL] = -((wheel->Speed_L + wheel->Speed_R) / 2.0f + dalpha) * rw; // 编码器测的是轮子相对车体的转速，需补上车体的转动
+			x[LQR_STATE_YAW] = gz;
+			
+			LQR_Compute(&lqr, x, u);
+			
+			ddx_ref = u[LQR_INPUT_ACC];
+			
+			omega_turn += u[LQR_INPUT_TURN] * CONTROL_TS;
+			
+			if(omega_turn >  10) omega_turn = 10;
+			if(omega_turn < -10) omega_turn = -10;
+		}
+	}
+	else
+	{
+		///////////////////////////////////////////////////////////////////////
+		// 串级pid：速度环 -> 角度环 -> 角速度环，以及转向环
+		///////////////////////////////////////////////////////////////////////
+		
+		if(attitude) Cascade_Align(&cascade, CONTROL_PERIOD_DIV); // 角度环使用刚到达的姿态
+		
+		Cascade_Run(&cascade);
+		
+		float ddalpha_ref = Cascade_GetOutput(&cascade, stage_dalpha);
+		
+		// 解算，根据角加速度计算水平向加速度
+		
+		// float ddx_ref = (lp*ddalpha_ref - g*qsin(alpha)) / qcos(alpha);
+		ddx_ref = (Jp*ddalpha_ref - mp*g*lp*qsin(alpha)) / (mp*lp*qcos(alpha));
+		
+		omega_turn = Cascade_GetOutput(&cascade, stage_turn);
+	}
+	
+	// 对加速度积分，得到期望速度。LQR的增益按姿态周期离散化，期望加速度在姿态更新时一次积分
+	
+	if(mode != CONTROL_MODE_LQR)
+	{
+		omega_ref += ddx_ref * CONTROL_RATE_TS / rw;
+	}
+	else if(attitude)
+	{
+		omega_ref += ddx_ref * CONTROL_TS / rw;
+	}
+	
+	if(omega_ref >  40) omega_ref = 40;
+	if(omega_ref < -40) omega_ref = -40;
+	
+	if(attitude && fabsf(alpha) > deg_2_rad(80)) // 小车摔倒
+	{
+		standingUp = 5; // 关闭电机，直到App_Control_Reset
+		PT_INIT(&standUpPt);
+		App_BlackBox_Trigger(BLACKBOX_REASON_FALL, us);
+	}
+	
+	App_Motor_SetSpeed_L(-omega_ref + omega_turn);
+	App_Motor_SetSpeed_R(-omega_ref - omega_turn);
+	
+	// 参考值依据的最新样本的采样时刻，电机任务据此统计延迟：串级PID为角速度，LQR为姿态
+	App_Motor_SetSource(Bus_GetUs(mode == CONTROL_MODE_LQR ? &ImuTopic : &GyroTopic));
+	
+	if(!attitude) return;
+	
+	App_Boot_Ready(); // 启动完成，只记录第一次
+	
+	Record(us, overrun);
+	overrun = 0;
+}
+
+void App_Control_Move(float speed, float turn)
+{
+	float arg[2] = {speed, turn};
+	
+	App_Trace_Record(TRACE_MOVE, 0, GetUs(), arg, sizeof(arg));
+	
+	Cascade_ChangeSetpoint(&cascade, stage_vel, -speed / 3.8f);
+	Cascade_ChangeSetpoint(&cascade, stage_turn, -turn / 7.0f);
+	
+	// LQR的速度单位为m/s，方向与串级PID的速度环相反
+	LQR_ChangeReference(&lqr, LQR_STATE_VEL, speed / 3.8f * rw);
+	LQR_ChangeReference(&lqr, LQR_STATE_YAW, -turn / 7.0f);
+}
+
+//
+// @简介：切换控制模式，在两次控制周期之间生效
+//        切换时保留omega_ref和omega_turn，使电机的转速参考值连续，
+//        并复位即将启用的控制器的内部状态
+// @参数：Mode - CONTROL_MODE_CASCADE 串级PID
+//               CONTROL_MODE_LQR     LQR全状态反馈
+//
+void App_Control_SetMode(uint8_t Mode)
+{
+	if(Mode == mode) return;
+	
+	App_Trace_Record(TRACE_MODE, Mode, GetUs(), NULL, 0);
+	
+	if(Mode == CONTROL_MODE_LQR)
+	{
+		LQR_ChangeReference(&lqr, LQR_STATE_POS, GetPos()); // 以当前位置为平衡点
+		mode = CONTROL_MODE_LQR;
+	}
+	else
+	{
+		Cascade_Reset(&cascade);
+		mode = CONTROL_MODE_CASCADE;
+	}
+}
+
+uint8_t App_Control_GetMode(void)
+{
+	return mode;
+}
+
+//
+// @简介：保存串级PID各级当前的增益，下次上电时使用
+// @返回值：0 - 成功，-1 - 电机运行中或写入失败
+// @注意：写Flash期间CPU停顿，电机运行时不保存
+//
+int App_Control_SaveGains(void)
+{
+	const int8_t stages[4] = {stage_vel, stage_alpha, stage_dalpha, stage_turn};
+	float gains[4][3];
+	
+	if(App_Motor_GetState() == ENABLE) return -1;
+	
+	for(uint8_t i=0; i<4; i++)
+	{
+		PID_TypeDef *pid = Cascade_GetPID(&cascade, stages[i]);
+		
+		gains[i][0] = pid->Kp;
+		gains[i][1] = pid->Ki;
+		gains[i][2] = pid->Kd;
+	}
+	
+	return App_Flash_Write(APP_FLASH_KEY_PID_GAINS, gains, sizeof(gains));
+}
+
+//
+// @简介：加载保存过的增益，没有保存过或数据无效时保持默认值
+//
+static void LoadGains(void)
+{
+	const int8_t stages[4] = {stage_vel, stage_alpha, stage_dalpha, stage_turn};
+	float gains[4][3]; // 速度环、角度环、角速度环、转向环的Kp、Ki、Kd
+	
+	if(App_Flash_Read(APP_FLASH_KEY_PID_GAINS, gains, sizeof(gains)) != sizeof(gains)) return;
+	
+	for(uint8_t i=0; i<4; i++)
+	{
+		for(uint8_t k=0; k<3; k++)
+		{
+			if(!(gains[i][k] >= 0 && gains[i][k] < 1.0e6f)) return; // 含NaN
+		}
+	}
+	
+	for(uint8_t i=0; i<4; i++)
+	{
+		PID_ChangeTunings(Cascade_GetPID(&cascade, stages[i]), gains[i][0], gains[i][1], gains[i][2]);
+	}
+}
+
+//
+// @简介：读取轮子相对地面的位置，单位m，方向与omega_ref一致
+//        编码器测的是轮子相对车体转过的角度，需补上车体的倾角
+//
+static float GetPos(void)
+{
+	return -((App_Encoder_GetPos_L() + App_Encoder_GetPos_R()) / 2.0f + deg_2_rad(App_MPU6050_GetPitch())) * rw;
+}
+
+//
+// @简介：向黑匣子写入本周期的控制状态
+//        每个姿态周期都要执行，只做定点数转换（BlackBox_Q16）和存储，不调用浮点库函数
+// @参数：Us - 本周期开始执行的时刻
+// @参数：Overrun - 自上次写入以来是否超时
+//
+static void Record(uint32_t Us, uint8_t Overrun)
+{
+	BlackBoxRecord_TypeDef *r = App_BlackBox_Next();
+	
+	if(r == NULL) return; // 已冻结，等待导出
+	
+	const WheelState_TypeDef *wheel = Bus_Read(&WheelTopic);
+	const PID_TypeDef *vel = Cascade_GetPID(&cascade, stage_vel);
+	const PID_TypeDef *ang = Cascade_GetPID(&cascade, stage_alpha);
+	const PID_TypeDef *rate = Cascade_GetPID(&cascade, stage_dalpha);
+	
+	r->Us = Us;
+	r->Alpha = BlackBox_Q16(alpha, BLACKBOX_Q_ALPHA);
+	r->DAlpha = BlackBox_Q16(dalpha, BLACKBOX_Q_GYRO);
+	r->Gz = BlackBox_Q16(gz, BLACKBOX_Q_GYRO);
+	r->V = BlackBox_Q16(v, BLACKBOX_Q_V);
+	r->VelOut = BlackBox_Q16(vel->LastOutput, BLACKBOX_Q_PID);
+	r->VelI = BlackBox_Q16(vel->ITerm, BLACKBOX_Q_PID);
+	r->AlphaOut = BlackBox_Q16(ang->LastOutput, BLACKBOX_Q_PID);
+	r->AlphaI = BlackBox_Q16(ang->ITerm, BLACKBOX_Q_PID);
+	r->DAlphaOut = BlackBox_Q16(rate->LastOutput, BLACKBOX_Q_DPID);
+	r->DAlphaI = BlackBox_Q16(rate->ITerm, BLACKBOX_Q_DPID);
+	r->TurnOut = BlackBox_Q16(Cascade_GetPID(&cascade, stage_turn)->LastOutput, BLACKBOX_Q_PID);
+	r->DdxRef = BlackBox_Q16(ddx_ref, BLACKBOX_Q_DDX);
+	r->OmegaRef = BlackBox_Q16(omega_ref, BLACKBOX_Q_OMEGA);
+	r->OmegaTurn = BlackBox_Q16(omega_turn, BLACKBOX_Q_TURN);
+	r->Duty_L = BlackBox_Q16(wheel->Duty_L, BLACKBOX_Q_DUTY);
+	r->Duty_R = BlackBox_Q16(wheel->Duty_R, BLACKBOX_Q_DUTY);
+	r->Volt = BlackBox_Q16(wheel->Volt, BLACKBOX_Q_VOLT);
+	r->Mode = mode;
+	r->Flags = (standingUp & BLACKBOX_FLAG_STANDUP) | (App_Motor_GetState() == ENABLE ? BLACKBOX_FLAG_MOTOR : 0) | (Overrun ? BLACKBOX_FLAG_OVERRUN : 0);
+}
+
+//
+// @简介：摔倒后的处理，standingUp不为0时每个控制周期调用一次，standingUp为当前的阶段：
+//        5 - 摔倒，电机保持关闭，直到App_Control_Reset
+// @注意：阶段的编号与黑匣子和遥测中的记录一致（BLACKBOX_FLAG_STANDUP）
+//
+static uint8_t StartUp(PT_TypeDef *pt)
+{
+	PT_BEGIN(pt);
+	
+	while(standingUp == 5)
+	{
+		App_Motor_Cmd(DISABLE);
+		PT_YIELD(pt);
+	}
+	
+	PT_END(pt);
+}
+
+//
+// @简介：写入热启动的检查点（app_boot.h）
+//        只读取已有的变量，不读取编码器（App_Encoder_GetPos_x会产生记录）
+//
+static void Checkpoint(void)
+{
+	BootCheckpoint_TypeDef cp;
+	
+	cp.Pitch = App_MPU6050_GetPitch();
+	cp.OmegaRef = omega_ref;
+	cp.VelI = Cascade_GetPID(&cascade, stage_vel)->ITerm;
+	cp.AlphaI = Cascade_GetPID(&cascade, stage_alpha)->ITerm;
+	cp.DAlphaI = Cascade_GetPID(&cascade, stage_dalpha)->ITerm;
+	cp.PosErr = posErr;
+	cp.MotorI_L = App_Motor_GetITerm_L();
+	cp.MotorI_R = App_Motor_GetITerm_R();
+	cp.Mode = mode;
+	cp.Motor = (App_Motor_GetState() == ENABLE) && !standingUp;
+	
+	App_Boot_Checkpoint(&cp);
+}
+
+//
+// @简介：热启动，恢复复位前的控制模式、积分项和电机转速的参考值，
+//        复位前电机在正常控制时重新使能，下一个控制周期即接着平衡
+// @注意：PID第一次计算时只有比例项（PID_ComputeFixedRate），恢复的积分项从第二个周期起生效
+//
+static void Resume(const BootCheckpoint_TypeDef *pCheckpoint)
+{
+	App_Control_SetMode(pCheckpoint->Mode);
+	
+	Cascade_GetPID(&cascade, stage_vel)->ITerm = pCheckpoint->VelI;
+	Cascade_GetPID(&cascade, stage_alpha)->ITerm = pCheckpoint->AlphaI;
+	Cascade_GetPID(&cascade, stage_dalpha)->ITerm = pCheckpoint->DAlphaI;
+	
+	LQR_ChangeReference(&lqr, LQR_STATE_POS, GetPos() + pCheckpoint->PosErr); // 编码器从0开始计数
+	posErr = pCheckpoint->PosErr;
+	
+	omega_ref = pCheckpoint->OmegaRef;
+	
+	if(pCheckpoint->Motor)
+	{
+		App_Motor_SetSpeed_L(-omega_ref);
+		App_Motor_SetSpeed_R(-omega_ref);
+		App_Motor_Resume(pCheckpoint->MotorI_L, pCheckpoint->MotorI_R);
+	}
+}
+
+void App_Control_Reset(void)
+{
+	Cascade_Reset(&cascade);
+	LQR_ChangeReference(&lqr, LQR_STATE_POS, GetPos());
+	App_Motor_Reset();
+	omega_ref = 0;
+	omega_turn = 0;
+	standingUp = 0;
+	PT_INIT(&standUpPt);
+}
@@ -1,9 +1,17 @@
-#ifndef APP_CONTROL_H
-#define APP_CONTROL_H
-
-void App_Control_Init(void);
-void App_Control_Proc(void);
-void App_Control_Move(float speed, float turn);
-void App_Control_Reset(void);
-
-#endif
+#ifndef APP_CONTROL_H
+#define APP_CONTROL_H
+
+#include <stdint.h>
+
+#define CONTROL_MODE_CASCADE 0 // 串级PID（默认）
+#define CONTROL_MODE_LQR     1 // LQR全状态反馈
+
+void App_Control_Init(void);
+void App_Control_Proc(void);
+void App_Control_Move(float speed, float turn);
+void App_Control_Reset(void);
+void App_Control_SetMode(uint8_t Mode);
+uint8_t App_Control_GetMode(void);
+int App_Control_SaveGains(void);
+
+#endif
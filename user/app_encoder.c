@@ -1,463 +1,725 @@
-#include "app_encoder.h"
-#include "delay.h"
-#include "math.h"
-#include "app_calibrator.h"
-
-static volatile int64_t encoder_l = 0; // 左电机编码器的值
-static volatile int64_t encoder_r = 0; // 右电机编码器的值
-static volatile int8_t d0_l = 0, d1_l = 0; // 左电机旋转的方向，0 - 初始状态，+-1234对应4个阶段
-static volatile int8_t d0_r = 0, d1_r = 0; // 右电机旋转的方向，0 - 初始状态，+-1234对应4个阶段
-static volatile uint64_t t0_l = 0, t1_l = 0; // 左电机编码器发生变化的时间，单位us
-static volatile uint64_t t0_r = 0, t1_r = 0; // 右电机编码器发生变化的时间，单位us
-static float m_l[2], m_r[2];
-static void Encoder_L_Init(void); // 左编码器初始化
-static void Encoder_R_Init(void); // 右编码器初始化
-
-// 校准用
-static volatile int8_t calibrateFlag_l = 0; // 校准开始标志位，0-校准停止，1-校准准备，2-校准开始，-1 - 校准失败
-static volatile uint64_t lastEdge_l = 0; // 用于记录上次边沿发生的时间（校准用）
-static volatile uint64_t t1_cali_l = 0, t2_cali_l = 0;
-static volatile uint16_t n1_cali_l = 0, n2_cali_l = 0; 
-// 校准用
-static volatile int8_t calibrateFlag_r = 0; // 校准开始标志位，0-校准停止，1-校准准备，2-校准开始，-1 - 校准失败
-static volatile uint64_t lastEdge_r = 0; // 用于记录上次边沿发生的时间（校准用）
-static volatile uint64_t t1_cali_r = 0, t2_cali_r = 0;
-static volatile uint16_t n1_cali_r = 0, n2_cali_r = 0; 
-
-//
-// @简介：对编码器模块进行初始化
-//
-void App_Encoder_Init(void)
-{
-	Encoder_L_Init(); 
-	Encoder_R_Init(); 
-	
-	// 从校准器中读出占空比
-	float duty_l = App_Calibrator_GetResult()->encoder_duty_l;
-	float duty_r = App_Calibrator_GetResult()->encoder_duty_r;
-	
-	// 计算台阶高度
-	// 左编码器台阶高度
-	// m_l[0] - 第1阶段（从A相上升沿到A相下降沿）的台阶高度
-	// m_1[1] - 第2阶段（从A相下降沿到A相上升沿）的台阶高度
-	m_l[0] = duty_l * 2; // m[]表示台阶高度，占空比*2，比如占空比为0.49，则m[0]=0.98,m[1]=1.02
-	m_l[1] = 2 - duty_l * 2;
-	
-	// 右编码器台阶高度
-	m_r[0] = duty_r * 2;
-	m_r[1] = 2 - duty_r * 2;
-}
-
-//
-// @简介：读取左轮胎旋转的角度，单位：度
-//
-float App_Encoder_GetPos_L(void)
-{
-	// return encoder_l / 22.0f / (30613.0f / 1500.0f) * 2*PI; 
-	return encoder_l * 0.01399402208920360588844895090594f;
-}
-
-//
-// @简介：读取右轮胎旋转的角度，单位：度
-//
-float App_Encoder_GetPos_R(void)
-{
-	// return encoder_r / 22.0f / (30613.0f / 1500.0f) * 360.0f; 
-	return -encoder_r * 0.01399402208920360588844895090594f;
-}
-
-//
-// @简介：读取左轮胎旋转的角速度，omega的值，单位是 度/s
-// 
-float App_Encoder_GetSpeed_L(void)
-{
-	__disable_irq(); // 为了保持数据完整性，关闭单片机的总中断
-	
-	// 拷贝传感器数据
-	int8_t d0_cpy = d0_l; // 上一个时刻编码器方向及阶段
-	int8_t d1_cpy = d1_l; // 上上个时刻编码器方向及阶段
-	uint64_t t0_cpy = t0_l; // 上一个时刻
-	uint64_t t1_cpy = t1_l; // 上上个时刻
-	
-	__enable_irq(); // 开启单片机的总中断
-	
-	if(d0_cpy * d1_cpy <= 0) return 0.0f; // 方向改变时强制令速度为0
-	
-	uint64_t now = GetUs(); // 获取当前时间
-	
-	int8_t dnow; // 当前方向
-	
-	// 推算当前阶段和方向
-	if(d0_cpy > 0)
-	{
-		dnow = d0_cpy % 2 + 1; // 1->1%2+1=2 2->2%2+1=1
-	}
-	else
-	{
-		dnow = -((-d0_cpy) % 2 +1);
-	}
-	
-	float M,T; // M表示台阶高度，T表示台阶宽度
-	
-	float Mnow = dnow > 0 ? m_l[dnow-1]   : -m_l[-dnow-1];
-	float M0 = d0_cpy > 0 ? m_l[d0_cpy-1] : -m_l[-d0_cpy-1];
-	
-	if((fabsf(Mnow)*(t0_cpy-t1_cpy)) < fabsf(M0)*(now - t0_cpy)) // 速度减慢
-	{	
-		M = Mnow;
-		T = (now - t0_cpy)  * 1.0e-6f;
-	}
-	else // 速度不变或者加快
-	{
-		M = M0;
-		T = (t0_cpy-t1_cpy) * 1.0e-6f;
-	}
-	
-	return M / T * 0.01399402208920360588844895090594f;
-}
-
-
-//
-// @简介：读取右轮胎旋转的角速度，omega的值，单位是 度/s
-// 
-float App_Encoder_GetSpeed_R(void)
-{
-	__disable_irq(); // 关闭单片机的总中断
-	
-	int8_t d0_cpy = d0_r;
-	int8_t d1_cpy = d1_r;
-	uint64_t t0_cpy = t0_r;
-	uint64_t t1_cpy = t1_r;
-	
-	__enable_irq(); // 开启单片机的总中断
-	
-	if(d0_cpy * d1_cpy <= 0) return 0.0f; // 方向改变时强制令速度为0
-	
-	uint64_t now = GetUs();
-	int8_t dnow; // 当前方向
-	
-	if(d0_cpy > 0)
-	{
-		dnow = d0_cpy % 2 + 1; // 1->1%2+1=2 2->2%2+1=1
-	}
-	else
-	{
-		dnow = -((-d0_cpy) % 2 +1);
-	}
-	
-	float M,T;
-	
-	float Mnow = dnow > 0 ? m_r[dnow-1]   : -m_r[-dnow-1];
-	float M0 = d0_cpy > 0 ? m_r[d0_cpy-1] : -m_r[-d0_cpy-1];
-	
-	if((fabsf(Mnow)*(t0_cpy-t1_cpy)) < fabsf(M0)*(now - t0_cpy))
-	{	
-		M = Mnow;
-		T = (now - t0_cpy)  * 1.0e-6f;
-	}
-	else
-	{
-		M = M0;
-		T = (t0_cpy-t1_cpy) * 1.0e-6f;
-	}
-	
-	return -M / T * 0.01399402208920360588844895090594f;
-}
-
-//
-// @简介：左编码器初始化
-//
-static void Encoder_L_Init(void)
-{
-	// 初始化A和B的引脚
-	// PB14, PB15 - IPU
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE); 
-	
-	GPIO_InitTypeDef GPIO_InitStruct = {0};
-	
-	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_14 | GPIO_Pin_15;
-	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
-	
-	GPIO_Init(GPIOB, &GPIO_InitStruct);	
-	
-	// EXTI初始化
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
-	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource14); // 让EXTI_Line14监控PB14
-	
-	// 配置EXTI的参数
-	EXTI_InitTypeDef EXTI_InitStruct = {0};
-	
-	// EXTI14
-	EXTI_InitStruct.EXTI_Line = EXTI_Line14;
-	EXTI_InitStruct.EXTI_LineCmd = ENABLE;
-	EXTI_InitStruct.EXTI_Mode = EXTI_Mode_Interrupt;
-	EXTI_InitStruct.EXTI_Trigger = EXTI_Trigger_Rising_Falling;
-	
-	EXTI_Init(&EXTI_InitStruct);
-	
-	// 开启EXTI的中断EXTI15_10_IRQn
-	NVIC_InitTypeDef NVIC_InitStruct = {0};
-	
-	NVIC_InitStruct.NVIC_IRQChannel = EXTI15_10_IRQn;// 中断编号
-	NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
-	NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 0;
-	NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
-	
-	NVIC_Init(&NVIC_InitStruct);
-}
-
-//
-// @简介：右编码器初始化
-//
-static void Encoder_R_Init(void)
-{
-	// 初始化A和B的引脚
-	// 关闭JTAG，开启SWD
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
-	GPIO_PinRemapConfig(GPIO_Remap_SWJ_JTAGDisable, ENABLE);
-	
-	// PB3, PB4 - IPU
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE); 
-	
-	GPIO_InitTypeDef GPIO_InitStruct = {0};
-	
-	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_3 | GPIO_Pin_4;
-	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
-	
-	GPIO_Init(GPIOB, &GPIO_InitStruct);
-	
-	// EXTI初始化
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
-	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource3); // 让EXTI_Line3监控PB3
-	
-	// 配置EXTI的参数
-	EXTI_InitTypeDef EXTI_InitStruct = {0};
-	
-	// EXTI3
-	EXTI_InitStruct.EXTI_Line = EXTI_Line3;
-	EXTI_InitStruct.EXTI_LineCmd = ENABLE;
-	EXTI_InitStruct.EXTI_Mode = EXTI_Mode_Interrupt;
-	EXTI_InitStruct.EXTI_Trigger = EXTI_Trigger_Rising_Falling;
-	
-	EXTI_Init(&EXTI_InitStruct);
-	
-	// 开启EXTI的中断
-	NVIC_InitTypeDef NVIC_InitStruct = {0};
-	
-	// EXTI3_IRQn
-	NVIC_InitStruct.NVIC_IRQChannel = EXTI3_IRQn;// 中断编号
-	NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
-	NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 0;
-	NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
-	
-	NVIC_Init(&NVIC_InitStruct);
-}
-
-//
-// @简介：EXTI3的中断响应函数，对应右编码器的A相
-//
-void EXTI3_IRQHandler(void)
-{
-	EXTI_ClearFlag(EXTI_Line3); // 对标志位进行清零
-		
-	uint8_t a = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_3); // A相的当前电压
-	uint8_t b = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4); // B相的当前电压
-	
-	uint64_t now = GetUs();
-	
-	t1_r = t0_r;
-	t0_r = now;
-	d1_r = d0_r;
-	
-	if(a == Bit_SET) // A相上升沿
-	{
-		if(b == Bit_SET) // 正转，1
-		{
-			d0_r = 2;
-			encoder_r++;
-			
-			if(calibrateFlag_r == 1) // 校准准备中
-			{
-				calibrateFlag_r = 2; // 遇到1号边沿即开始校准
-				
-				// 对所有数据清零
-				t1_cali_r = 0; t2_cali_r = 0;
-				n1_cali_r = 0; n2_cali_r = 0;
-				lastEdge_r = now;
-			}
-			else if(calibrateFlag_r == 2) // 遇到1号边沿，累加t4
-			{
-				t2_cali_r += now - lastEdge_r;
-				n2_cali_r++;
-				lastEdge_r = now;
-			}
-		}
-		else // 反转
-		{
-			d0_r = -2;
-			encoder_r--;
-			
-			if(calibrateFlag_r == 1 || calibrateFlag_r == 2)
-			{
-				calibrateFlag_r = -1; // 遇电机反转则校准失败
-			}
-		}
-	}
-	else // A相下降沿
-	{
-		if(b == Bit_RESET) // 正转，3
-		{
-			encoder_r++;
-			d0_r = 1;
-			
-			if(calibrateFlag_r == 2) // 遇到1号边沿，累加t1
-			{
-				t1_cali_r += now - lastEdge_r;
-				n1_cali_r++;
-				lastEdge_r = now ;
-			}
-		}
-		else // 反转
-		{
-			encoder_r--;
-			d0_r = -1;
-			
-			if(calibrateFlag_r == 1 || calibrateFlag_r == 2)
-			{
-				calibrateFlag_r = -1; // 遇电机反转则校准失败
-			}
-		}
-	}
-}
-
-//
-// @简介：EXTI15_10的中断响应函数，对应左编码器的A相
-//
-void EXTI15_10_IRQHandler(void)
-{
-	if(EXTI_GetFlagStatus(EXTI_Line14) == SET)
-	{
-		EXTI_ClearFlag(EXTI_Line14); // 对标志位进行清零
-		
-		uint8_t a = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_14); // A相的当前电压
-		uint8_t b = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_15); // B相的当前电压
-		
-		uint64_t now = GetUs();
-		
-		t1_l = t0_l;
-		t0_l = now;
-		d1_l = d0_l;
-		
-		if(a == Bit_SET) // A相上升沿
-		{
-			if(b == Bit_SET) // 正转，1
-			{
-				d0_l = 2;
-				encoder_l++;
-				
-				if(calibrateFlag_l == 1) // 校准准备中
-				{
-					calibrateFlag_l = 2; // 遇到1号边沿即开始校准
-					
-					// 对所有数据清零
-					t1_cali_l = 0; t2_cali_l = 0;
-					n1_cali_l = 0; n2_cali_l = 0;
-					lastEdge_l = now;
-				}
-				else if(calibrateFlag_l == 2) // 累加t2
-				{
-					t2_cali_l += now - lastEdge_l;
-					n2_cali_l++;
-					lastEdge_l = now;
-				}
-			}
-			else // 反转
-			{
-				d0_l = -2;
-				encoder_l--;
-				
-				if(calibrateFlag_l == 1 || calibrateFlag_l == 2)
-				{
-					calibrateFlag_l = -1; // 遇电机反转则校准失败
-				}
-			}
-		}
-		else // A相下降沿
-		{
-			if(b == Bit_RESET) // 正转，3
-			{
-				encoder_l++;
-				d0_l = 1;
-				
-				if(calibrateFlag_l == 2) // 累加t1
-				{
-					t1_cali_l += now - lastEdge_l;
-					n1_cali_l++;
-					lastEdge_l = now;
-				}
-			}
-			else // 反转
-			{
-				encoder_l--;
-				d0_l = -1;
-				
-				if(calibrateFlag_l == 1 || calibrateFlag_l == 2)
-				{
-					calibrateFlag_l = -1; // 遇电机反转则校准失败
-				}
-			}
-		}
-	}
-}
-
-void App_Encoder_StartCalibration(void)
-{
-	calibrateFlag_l = 1; // 准备校准
-	calibrateFlag_r = 1; // 准备校准
-	
-	// 复位所有校准临时数据
-	
-	t1_cali_l = 0; t2_cali_l = 0;
-	n1_cali_l = 0; n2_cali_l = 0;
-	lastEdge_l = 0;
-	
-	t1_cali_r = 0; t2_cali_r = 0;
-	n1_cali_r = 0; n2_cali_r = 0;
-	lastEdge_r = 0;
-}
-
-int App_Encoder_EndCalibration(float *duty_l, float *duty_r)
-{
-	int ret = 0;
-	
-	__disable_irq();
-	
-	if(calibrateFlag_l < 0 || calibrateFlag_r < 0)
-	{
-		ret = -1;
-	}
-	
-	calibrateFlag_l = 0; // 结束校准
-	calibrateFlag_r = 0; // 结束校准
-	
-	__enable_irq();
-	
-	if(ret == 0)
-	{
-		float t1_l = ((float)t1_cali_l) / ((float)n1_cali_l);
-		float t2_l = ((float)t2_cali_l) / ((float)n2_cali_l);
-		
-		float t1_r = ((float)t1_cali_r) / ((float)n1_cali_r);
-		float t2_r = ((float)t2_cali_r) / ((float)n2_cali_r);
-		
-		*duty_l = t1_l / (t1_l + t2_l);
-		*duty_r = t1_r / (t1_r + t2_r);
-	}
-	else
-	{
-		*duty_l = 0.5;
-		*duty_r = 0.5;
-	}
-	
-	return ret;
-}
+#include "app_encoder.h"
+#include "delay.h"
+#include "math.h"
+#include "app_calibrator.h"
+#include "edgecap.h"
+#include "app_trace.h"
+#include "app_telemetry.h"
+
+//
+// 编码器边沿时间的来源
+// 0 - A相的上升沿和下降沿都触发EXTI中断，在中断中用GetUs()记录时间（适用于当前的电路板）
+// 1 - 定时器输入捕获+循环DMA，只捕获A相上升沿，硬件同时记下边沿时间（CCR）和端口电平（IDR），
+//     由App_Encoder_Proc在1ms的电机任务中批量处理，边沿不再产生中断。
+//     右轮 A相PB3 -> TIM2_CH2（部分重映射1），B相PB4，DMA1_Channel7/DMA1_Channel5
+//     左轮 A相PB0 -> TIM3_CH3，B相PB1，DMA1_Channel2/DMA1_Channel3
+//     注意：PB14没有输入捕获功能，左轮需要改接到PB0/PB1，电池电压采样需要相应移到其它ADC引脚；
+//           TIM2被右轮占用后，彩灯需要改用其它定时器；
+//           DMA1_Channel7和DMA1_Channel3与USART2发送、USART3接收冲突，二者需要改为中断方式（DMA通道设为NULL）
+//
+#define ENCODER_USE_EDGECAP 0
+
+#define EDGECAP_BUFFER_SIZE 16 // 最高转速下每1ms不超过3个上升沿，溢出时见EdgeCap_TypeDef.Overruns
+
+static volatile int32_t encoder_l = 0; // 左电机编码器的值
+static volatile int32_t encoder_r = 0; // 右电机编码器的值
+static volatile int8_t d0_l = 0, d1_l = 0; // 左电机旋转的方向，0 - 初始状态，+-1234对应4个阶段
+static volatile int8_t d0_r = 0, d1_r = 0; // 右电机旋转的方向，0 - 初始状态，+-1234对应4个阶段
+static volatile uint32_t t0_l = 0, t1_l = 0; // 左电机编码器发生变化的时间，单位us
+static volatile uint32_t t0_r = 0, t1_r = 0; // 右电机编码器发生变化的时间，单位us
+static float m_l[2], m_r[2];
+static void Encoder_L_Init(void); // 左编码器初始化
+static void Encoder_R_Init(void); // 右编码器初始化
+
+#if ENCODER_USE_EDGECAP
+static EdgeCap_TypeDef edgecap_l, edgecap_r;
+static uint16_t edgecap_time_l[EDGECAP_BUFFER_SIZE], edgecap_level_l[EDGECAP_BUFFER_SIZE];
+static uint16_t edgecap_time_r[EDGECAP_BUFFER_SIZE], edgecap_level_r[EDGECAP_BUFFER_SIZE];
+#endif
+
+// 校准用
+static volatile int8_t calibrateFlag_l = 0; // 校准开始标志位，0-校准停止，1-校准准备，2-校准开始，-1 - 校准失败
+static volatile uint32_t lastEdge_l = 0; // 用于记录上次边沿发生的时间（校准用）
+static volatile uint32_t t1_cali_l = 0, t2_cali_l = 0;
+static volatile uint16_t n1_cali_l = 0, n2_cali_l = 0; 
+// 校准用
+static volatile int8_t calibrateFlag_r = 0; // 校准开始标志位，0-校准停止，1-校准准备，2-校准开始，-1 - 校准失败
+static volatile uint32_t lastEdge_r = 0; // 用于记录上次边沿发生的时间（校准用）
+static volatile uint32_t t1_cali_r = 0, t2_cali_r = 0;
+static volatile uint16_t n1_cali_r = 0, n2_cali_r = 0; 
+
+//
+// @简介：对编码器模块进行初始化
+//
+void App_Encoder_Init(void)
+{
+	Encoder_L_Init(); 
+	Encoder_R_Init(); 
+	
+	App_Telemetry_AddVariable("d0_l", TELEMETRY_INT8, &d0_l, 1); // 编码器的方向和阶段，调试时按需观察
+	App_Telemetry_AddVariable("d0_r", TELEMETRY_INT8, &d0_r, 1);
+	
+	App_Encoder_UpdateCalibration();
+}
+
+//
+// @简介：按校准器当前的结果重新计算台阶高度，校准完成后调用，无需重新上电
+//
+void App_Encoder_UpdateCalibration(void)
+{
+#if ENCODER_USE_EDGECAP
+	// 只用上升沿计时，每个台阶都是完整的一个周期，与占空比无关
+	m_l[0] = 2; m_l[1] = 2;
+	m_r[0] = 2; m_r[1] = 2;
+#else
+	// 从校准器中读出占空比
+	float duty_l = App_Calibrator_GetResult()->encoder_duty_l;
+	float duty_r = App_Calibrator_GetResult()->encoder_duty_r;
+	
+	// 计算台阶高度
+	// 左编码器台阶高度
+	// m_l[0] - 第1阶段（从A相上升沿到A相下降沿）的台阶高度
+	// m_1[1] - 第2阶段（从A相下降沿到A相上升沿）的台阶高度
+	m_l[0] = duty_l * 2; // m[]表示台阶高度，占空比*2，比如占空比为0.49，则m[0]=0.98,m[1]=1.02
+	m_l[1] = 2 - duty_l * 2;
+	
+	// 右编码器台阶高度
+	m_r[0] = duty_r * 2;
+	m_r[1] = 2 - duty_r * 2;
+#endif
+}
+
+//
+// @简介：读取左轮胎旋转的角度，单位：度
+//
+float App_Encoder_GetPos_L(void)
+{
+	__disable_irq(); // 读取计数值和留下记录在同一临界区内，回放时能确定读到了哪些边沿
+	
+	int32_t encoder_cpy = encoder_l;
+	
+	App_Trace_Record(TRACE_POS_L, 0, GetUs(), NULL, 0);
+	
+	__enable_irq();
+	
+	// return encoder_l / 22.0f / (30613.0f / 1500.0f) * 2*PI; 
+	return encoder_cpy * 0.01399402208920360588844895090594f;
+}
+
+//
+// @简介：读取右轮胎旋转的角度，单位：度
+//
+float App_Encoder_GetPos_R(void)
+{
+	__disable_irq();
+	
+	int32_t encoder_cpy = encoder_r;
+	
+	App_Trace_Record(TRACE_POS_R, 0, GetUs(), NULL, 0);
+	
+	__enable_irq();
+	
+	// return encoder_r / 22.0f / (30613.0f / 1500.0f) * 360.0f; 
+	return -encoder_cpy * 0.01399402208920360588844895090594f;
+}
+
+//
+// @简介：读取左轮胎旋转的角速度，omega的值，单位是 度/s
+// 
+float App_Encoder_GetSpeed_L(void)
+{
+	__disable_irq(); // 为了保持数据完整性，关闭单片机的总中断
+	
+	// 拷贝传感器数据
+	int8_t d0_cpy = d0_l; // 上一个时刻编码器方向及阶段
+	int8_t d1_cpy = d1_l; // 上上个时刻编码器方向及阶段
+	uint32_t t0_cpy = t0_l; // 上一个时刻
+	uint32_t t1_cpy = t1_l; // 上上个时刻
+	
+	uint32_t now = GetUs(); // 获取当前时间，与快照在同一临界区内读取
+	
+	App_Trace_Record(TRACE_SPEED_L, 0, now, NULL, 0); // 回放时据此确定快照包含哪些边沿
+	
+	__enable_irq(); // 开启单片机的总中断
+	
+	if(d0_cpy * d1_cpy <= 0) return 0.0f; // 方向改变时强制令速度为0
+	
+	int8_t dnow; // 当前方向
+	
+	// 推算当前阶段和方向
+	if(d0_cpy > 0)
+	{
+		dnow = d0_cpy % 2 + 1; // 1->1%2+1=2 2->2%2+1=1
+	}
+	else
+	{
+		dnow = -((-d0_cpy) % 2 +1);
+	}
+	
+	float M,T; // M表示台阶高度，T表示台阶宽度
+	
+	float Mnow = dnow > 0 ? m_l[dnow-1]   : -m_l[-dnow-1];
+	float M0 = d0_cpy > 0 ? m_l[d0_cpy-1] : -m_l[-d0_cpy-1];
+	
+	uint32_t dt0 = Time_Diff(t0_cpy, t1_cpy); // 上一个台阶的宽度
+	uint32_t dtnow = Time_Diff(now, t0_cpy); // 当前台阶已经持续的时间
+	
+	if((fabsf(Mnow)*dt0) < fabsf(M0)*dtnow) // 速度减慢
+	{	
+		M = Mnow;
+		T = Time_UsToSec(dtnow);
+	}
+	else // 速度不变或者加快
+	{
+		M = M0;
+		T = Time_UsToSec(dt0);
+	}
+	
+	return M / T * 0.01399402208920360588844895090594f;
+}
+
+
+//
+// @简介：读取右轮胎旋转的角速度，omega的值，单位是 度/s
+// 
+float App_Encoder_GetSpeed_R(void)
+{
+	__disable_irq(); // 关闭单片机的总中断
+	
+	int8_t d0_cpy = d0_r;
+	int8_t d1_cpy = d1_r;
+	uint32_t t0_cpy = t0_r;
+	uint32_t t1_cpy = t1_r;
+	
+	uint32_t now = GetUs();
+	
+	App_Trace_Record(TRACE_SPEED_R, 0, now, NULL, 0);
+	
+	__enable_irq(); // 开启单片机的总中断
+	
+	if(d0_cpy * d1_cpy <= 0) return 0.0f; // 方向改变时强制令速度为0
+	
+	int8_t dnow; // 当前方向
+	
+	if(d0_cpy > 0)
+	{
+		dnow = d0_cpy % 2 + 1; // 1->1%2+1=2 2->2%2+1=1
+	}
+	else
+	{
+		dnow = -((-d0_cpy) % 2 +1);
+	}
+	
+	float M,T;
+	
+	float Mnow = dnow > 0 ? m_r[dnow-1]   : -m_r[-dnow-1];
+	float M0 = d0_cpy > 0 ? m_r[d0_cpy-1] : -m_r[-d0_cpy-1];
+	
+	uint32_t dt0 = Time_Diff(t0_cpy, t1_cpy);
+	uint32_t dtnow = Time_Diff(now, t0_cpy);
+	
+	if((fabsf(Mnow)*dt0) < fabsf(M0)*dtnow)
+	{	
+		M = Mnow;
+		T = Time_UsToSec(dtnow);
+	}
+	else
+	{
+		M = M0;
+		T = Time_UsToSec(dt0);
+	}
+	
+	return -M / T * 0.01399402208920360588844895090594f;
+}
+
+#if !ENCODER_USE_EDGECAP
+
+//
+// @简介：左编码器初始化
+//
+static void Encoder_L_Init(void)
+{
+	// 初始化A和B的引脚
+	// PB14, PB15 - IPU
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE); 
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_14 | GPIO_Pin_15;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);	
+	
+	// EXTI初始化
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
+	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource14); // 让EXTI_Line14监控PB14
+	
+	// 配置EXTI的参数
+	EXTI_InitTypeDef EXTI_InitStruct = {0};
+	
+	// EXTI14
+	EXTI_InitStruct.EXTI_Line = EXTI_Line14;
+	EXTI_InitStruct.EXTI_LineCmd = ENABLE;
+	EXTI_InitStruct.EXTI_Mode = EXTI_Mode_Interrupt;
+	EXTI_InitStruct.EXTI_Trigger = EXTI_Trigger_Rising_Falling;
+	
+	EXTI_Init(&EXTI_InitStruct);
+	
+	// 开启EXTI的中断EXTI15_10_IRQn
+	NVIC_InitTypeDef NVIC_InitStruct = {0};
+	
+	NVIC_InitStruct.NVIC_IRQChannel = EXTI15_10_IRQn;// 中断编号
+	NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+	
+	NVIC_Init(&NVIC_InitStruct);
+}
+
+//
+// @简介：右编码器初始化
+//
+static void Encoder_R_Init(void)
+{
+	// 初始化A和B的引脚
+	// 关闭JTAG，开启SWD
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
+	GPIO_PinRemapConfig(GPIO_Remap_SWJ_JTAGDisable, ENABLE);
+	
+	// PB3, PB4 - IPU
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE); 
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_3 | GPIO_Pin_4;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	// EXTI初始化
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
+	GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource3); // 让EXTI_Line3监控PB3
+	
+	// 配置EXTI的参数
+	EXTI_InitTypeDef EXTI_InitStruct = {0};
+	
+	// EXTI3
+	EXTI_InitStruct.EXTI_Line = EXTI_Line3;
+	EXTI_InitStruct.EXTI_LineCmd = ENABLE;
+	EXTI_InitStruct.EXTI_Mode = EXTI_Mode_Interrupt;
+	EXTI_InitStruct.EXTI_Trigger = EXTI_Trigger_Rising_Falling;
+	
+	EXTI_Init(&EXTI_InitStruct);
+	
+	// 开启EXTI的中断
+	NVIC_InitTypeDef NVIC_InitStruct = {0};
+	
+	// EXTI3_IRQn
+	NVIC_InitStruct.NVIC_IRQChannel = EXTI3_IRQn;// 中断编号
+	NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+	
+	NVIC_Init(&NVIC_InitStruct);
+}
+
+//
+// @简介：EXTI3的中断响应函数，对应右编码器的A相
+//
+void EXTI3_IRQHandler(void)
+{
+	EXTI_ClearFlag(EXTI_Line3); // 对标志位进行清零
+		
+	uint8_t a = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_3); // A相的当前电压
+	uint8_t b = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_4); // B相的当前电压
+	
+	uint32_t now = GetUs();
+	
+	App_Trace_Record(TRACE_EDGE_R, a | (b << 1), now, NULL, 0);
+	
+	t1_r = t0_r;
+	t0_r = now;
+	d1_r = d0_r;
+	
+	if(a == Bit_SET) // A相上升沿
+	{
+		if(b == Bit_SET) // 正转，1
+		{
+			d0_r = 2;
+			encoder_r++;
+			
+			if(calibrateFlag_r == 1) // 校准准备中
+			{
+				calibrateFlag_r = 2; // 遇到1号边沿即开始校准
+				
+				// 对所有数据清零
+				t1_cali_r = 0; t2_cali_r = 0;
+				n1_cali_r = 0; n2_cali_r = 0;
+				lastEdge_r = now;
+			}
+			else if(calibrateFlag_r == 2) // 遇到1号边沿，累加t4
+			{
+				t2_cali_r += Time_Diff(now, lastEdge_r);
+				n2_cali_r++;
+				lastEdge_r = now;
+			}
+		}
+		else // 反转
+		{
+			d0_r = -2;
+			encoder_r--;
+			
+			if(calibrateFlag_r == 1 || calibrateFlag_r == 2)
+			{
+				calibrateFlag_r = -1; // 遇电机反转则校准失败
+			}
+		}
+	}
+	else // A相下降沿
+	{
+		if(b == Bit_RESET) // 正转，3
+		{
+			encoder_r++;
+			d0_r = 1;
+			
+			if(calibrateFlag_r == 2) // 遇到1号边沿，累加t1
+			{
+				t1_cali_r += Time_Diff(now, lastEdge_r);
+				n1_cali_r++;
+				lastEdge_r = now ;
+			}
+		}
+		else // 反转
+		{
+			encoder_r--;
+			d0_r = -1;
+			
+			if(calibrateFlag_r == 1 || calibrateFlag_r == 2)
+			{
+				calibrateFlag_r = -1; // 遇电机反转则校准失败
+			}
+		}
+	}
+}
+
+//
+// @简介：EXTI15_10的中断响应函数，对应左编码器的A相
+//
+void EXTI15_10_IRQHandler(void)
+{
+	if(EXTI_GetFlagStatus(EXTI_Line14) == SET)
+	{
+		EXTI_ClearFlag(EXTI_Line14); // 对标志位进行清零
+		
+		uint8_t a = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_14); // A相的当前电压
+		uint8_t b = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_15); // B相的当前电压
+		
+		uint32_t now = GetUs();
+		
+		App_Trace_Record(TRACE_EDGE_L, a | (b << 1), now, NULL, 0);
+		
+		t1_l = t0_l;
+		t0_l = now;
+		d1_l = d0_l;
+		
+		if(a == Bit_SET) // A相上升沿
+		{
+			if(b == Bit_SET) // 正转，1
+			{
+				d0_l = 2;
+				encoder_l++;
+				
+				if(calibrateFlag_l == 1) // 校准准备中
+				{
+					calibrateFlag_l = 2; // 遇到1号边沿即开始校准
+					
+					// 对所有数据清零
+					t1_cali_l = 0; t2_cali_l = 0;
+					n1_cali_l = 0; n2_cali_l = 0;
+					lastEdge_l = now;
+				}
+				else if(calibrateFlag_l == 2) // 累加t2
+				{
+					t2_cali_l += Time_Diff(now, lastEdge_l);
+					n2_cali_l++;
+					lastEdge_l = now;
+				}
+			}
+			else // 反转
+			{
+				d0_l = -2;
+				encoder_l--;
+				
+				if(calibrateFlag_l == 1 || calibrateFlag_l == 2)
+				{
+					calibrateFlag_l = -1; // 遇电机反转则校准失败
+				}
+			}
+		}
+		else // A相下降沿
+		{
+			if(b == Bit_RESET) // 正转，3
+			{
+				encoder_l++;
+				d0_l = 1;
+				
+				if(calibrateFlag_l == 2) // 累加t1
+				{
+					t1_cali_l += Time_Diff(now, lastEdge_l);
+					n1_cali_l++;
+					lastEdge_l = now;
+				}
+			}
+			else // 反转
+			{
+				encoder_l--;
+				d0_l = -1;
+				
+				if(calibrateFlag_l == 1 || calibrateFlag_l == 2)
+				{
+					calibrateFlag_l = -1; // 遇电机反转则校准失败
+				}
+			}
+		}
+	}
+}
+
+//
+// @简介：编码器的周期性处理，由1ms的电机任务调用
+//        EXTI方式下边沿已在中断中处理完毕，此函数为空
+//
+void App_Encoder_Proc(void)
+{
+}
+
+#else
+
+//
+// @简介：左编码器初始化，A相PB0由TIM3_CH3捕获，B相PB1
+//
+static void Encoder_L_Init(void)
+{
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_1;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	EdgeCap_InitTypeDef EdgeCap_InitStruct = {0};
+	
+	EdgeCap_InitStruct.TIMx = TIM3; // TIM3已由App_Bat配置为1us/计数
+	EdgeCap_InitStruct.TIM_Channel = TIM_Channel_3;
+	EdgeCap_InitStruct.TIM_ICPolarity = TIM_ICPolarity_Rising;
+	EdgeCap_InitStruct.TimeDMAy_Channelx = DMA1_Channel2;
+	EdgeCap_InitStruct.LevelDMAy_Channelx = DMA1_Channel3;
+	EdgeCap_InitStruct.GPIOx = GPIOB;
+	EdgeCap_InitStruct.GPIO_Pin = GPIO_Pin_0;
+	EdgeCap_InitStruct.pTimeBuffer = edgecap_time_l;
+	EdgeCap_InitStruct.pLevelBuffer = edgecap_level_l;
+	EdgeCap_InitStruct.BufferSize = EDGECAP_BUFFER_SIZE;
+	
+	My_EdgeCap_Init(&edgecap_l, &EdgeCap_InitStruct);
+}
+
+//
+// @简介：右编码器初始化，A相PB3由TIM2_CH2捕获（部分重映射1），B相PB4
+//
+static void Encoder_R_Init(void)
+{
+	// 关闭JTAG，开启SWD
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
+	GPIO_PinRemapConfig(GPIO_Remap_SWJ_JTAGDisable, ENABLE);
+	GPIO_PinRemapConfig(GPIO_PartialRemap1_TIM2, ENABLE);
+	
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_4;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	EdgeCap_InitTypeDef EdgeCap_InitStruct = {0};
+	
+	EdgeCap_InitStruct.TIMx = TIM2;
+	EdgeCap_InitStruct.TIM_Channel = TIM_Channel_2;
+	EdgeCap_InitStruct.TIM_ICPolarity = TIM_ICPolarity_Rising;
+	EdgeCap_InitStruct.TimeDMAy_Channelx = DMA1_Channel7;
+	EdgeCap_InitStruct.LevelDMAy_Channelx = DMA1_Channel5;
+	EdgeCap_InitStruct.GPIOx = GPIOB;
+	EdgeCap_InitStruct.GPIO_Pin = GPIO_Pin_3;
+	EdgeCap_InitStruct.pTimeBuffer = edgecap_time_r;
+	EdgeCap_InitStruct.pLevelBuffer = edgecap_level_r;
+	EdgeCap_InitStruct.BufferSize = EDGECAP_BUFFER_SIZE;
+	
+	My_EdgeCap_Init(&edgecap_r, &EdgeCap_InitStruct);
+}
+
+//
+// @简介：编码器的周期性处理，由1ms的电机任务调用
+//        批量取出DMA缓冲区中的上升沿，更新计数值和最近两个边沿的时间
+//        A相上升沿时B相为高电平表示正转
+//
+void App_Encoder_Proc(void)
+{
+	uint32_t t[EDGECAP_BUFFER_SIZE];
+	uint16_t idr[EDGECAP_BUFFER_SIZE];
+	uint16_t n;
+	uint32_t overruns;
+	
+	// 左轮
+	overruns = edgecap_l.Overruns;
+	n = My_EdgeCap_Fetch(&edgecap_l, t, idr, EDGECAP_BUFFER_SIZE);
+	
+	if(edgecap_l.Overruns != overruns) // 丢失了边沿，计数已不准确，等重新测得两个边沿后再计算转速
+	{
+		d0_l = 0;
+		d1_l = 0;
+	}
+	
+	for(uint16_t i=0; i<n; i++)
+	{
+		int8_t dir = (idr[i] & GPIO_Pin_1) ? 1 : -1;
+		
+		encoder_l += dir * 2;
+		t1_l = t0_l;
+		t0_l = t[i];
+		d1_l = d0_l;
+		d0_l = dir;
+	}
+	
+	// 右轮
+	overruns = edgecap_r.Overruns;
+	n = My_EdgeCap_Fetch(&edgecap_r, t, idr, EDGECAP_BUFFER_SIZE);
+	
+	if(edgecap_r.Overruns != overruns) // 丢失了边沿，计数已不准确，等重新测得两个边沿后再计算转速
+	{
+		d0_r = 0;
+		d1_r = 0;
+	}
+	
+	for(uint16_t i=0; i<n; i++)
+	{
+		int8_t dir = (idr[i] & GPIO_Pin_4) ? 1 : -1;
+		
+		encoder_r += dir * 2;
+		t1_r = t0_r;
+		t0_r = t[i];
+		d1_r = d0_r;
+		d0_r = dir;
+	}
+}
+
+#endif
+
+void App_Encoder_StartCalibration(void)
+{
+	calibrateFlag_l = 1; // 准备校准
+	calibrateFlag_r = 1; // 准备校准
+	
+	// 复位所有校准临时数据
+	
+	t1_cali_l = 0; t2_cali_l = 0;
+	n1_cali_l = 0; n2_cali_l = 0;
+	lastEdge_l = 0;
+	
+	t1_cali_r = 0; t2_cali_r = 0;
+	n1_cali_r = 0; n2_cali_r = 0;
+	lastEdge_r = 0;
+}
+
+int App_Encoder_EndCalibration(float *duty_l, float *duty_r)
+{
+#if ENCODER_USE_EDGECAP
+	// 只用上升沿计时，速度与占空比无关，不需要校准
+	*duty_l = 0.5;
+	*duty_r = 0.5;
+	
+	return 0;
+#else
+	int ret = 0;
+	
+	__disable_irq();
+	
+	if(calibrateFlag_l < 0 || calibrateFlag_r < 0)
+	{
+		ret = -1;
+	}
+	
+	calibrateFlag_l = 0; // 结束校准
+	calibrateFlag_r = 0; // 结束校准
+	
+	__enable_irq();
+	
+	if(ret == 0)
+	{
+		float t1_l = ((float)t1_cali_l) / ((float)n1_cali_l);
+		float t2_l = ((float)t2_cali_l) / ((float)n2_cali_l);
+		
+		float t1_r = ((float)t1_cali_r) / ((float)n1_cali_r);
+		float t2_r = ((float)t2_cali_r) / ((float)n2_cali_r);
+		
+		*duty_l = t1_l / (t1_l + t2_l);
+		*duty_r = t1_r / (t1_r + t2_r);
+	}
+	else
+	{
+		*duty_l = 0.5;
+		*duty_r = 0.5;
+	}
+	
+	return ret;
+#endif
+}
+
+//
+// @简介：取出上次取样（或开始校准）以来的占空比，并清零累加值继续计时，
+//        校准器把每段时间的结果作为一个样本做统计
+// @参数：duty_l、duty_r - 输出参数，这段时间内左右编码器A相的占空比
+// @返回值：0 - 成功，1 - 这段时间内的边沿不足一个周期，-1 - 电机反转，校准失败
+// @注意：此后调用App_Encoder_EndCalibration只统计最后一次取样之后的部分
+//
+int App_Encoder_SampleCalibration(float *duty_l, float *duty_r)
+{
+#if ENCODER_USE_EDGECAP
+	*duty_l = 0.5;
+	*duty_r = 0.5;
+	
+	return 0;
+#else
+	__disable_irq();
+	
+	int8_t flag_l = calibrateFlag_l, flag_r = calibrateFlag_r;
+	uint32_t t1_l = t1_cali_l, t2_l = t2_cali_l, t1_r = t1_cali_r, t2_r = t2_cali_r;
+	uint16_t n1_l = n1_cali_l, n2_l = n2_cali_l, n1_r = n1_cali_r, n2_r = n2_cali_r;
+	
+	t1_cali_l = 0; t2_cali_l = 0;
+	n1_cali_l = 0; n2_cali_l = 0;
+	
+	t1_cali_r = 0; t2_cali_r = 0;
+	n1_cali_r = 0; n2_cali_r = 0;
+	
+	__enable_irq();
+	
+	if(flag_l < 0 || flag_r < 0) return -1;
+	
+	if(flag_l != 2 || flag_r != 2 || n1_l == 0 || n2_l == 0 || n1_r == 0 || n2_r == 0) return 1;
+	
+	float h1_l = ((float)t1_l) / ((float)n1_l);
+	float h2_l = ((float)t2_l) / ((float)n2_l);
+	
+	float h1_r = ((float)t1_r) / ((float)n1_r);
+	float h2_r = ((float)t2_r) / ((float)n2_r);
+	
+	*duty_l = h1_l / (h1_l + h2_l);
+	*duty_r = h1_r / (h1_r + h2_r);
+	
+	return 0;
+#endif
+}
\ No newline at end of file
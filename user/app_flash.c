@@ -0,0 +1,299 @@
+#include "app_flash.h"
+#include "stm32f10x.h"
+#include <string.h>
+
+//
+// 页的格式：
+//   页头 - Magic(4) 代数(4)，回收时最后写入，Magic完整才算有效；两页都有效时代数大的为当前页
+//   记录 - 记录头(4) 数据（补齐到4字节） CRC(4)，从页头之后依次追加
+//          记录头为 键 长度 ~(键|长度<<8)(2)，长度为0表示删除该键
+//          CRC由CRC单元对记录头和数据逐字计算
+// 同一个键以最后一条CRC正确的记录为准。记录头损坏时无法确定后面记录的位置，
+// 此后的记录作废，本页不再追加，下次保存时回收
+//
+#define FLASH_STORE_PAGE0 0x0801F800 // Page126
+#define FLASH_STORE_PAGE1 0x0801FC00 // Page127，与旧版本校准结果的位置相同
+#define FLASH_STORE_PAGE_SIZE 0x400
+#define FLASH_STORE_MAGIC 0x3153564b // "KVS1"
+#define FLASH_STORE_HEADER_SIZE 8
+
+#define RECORD_SIZE(Len) (4 + (((Len) + 3) & ~3) + 4)
+#define RECORD_HEADER(Key, Len) ((uint32_t)(Key) | (uint32_t)(Len) << 8 | (uint32_t)(~((Key) | (Len) << 8) & 0xffff) << 16)
+
+static uint32_t active = 0; // 当前页的地址，0表示两页都没有格式化
+static uint32_t generation = 0; // 当前页的代数
+static uint16_t tail = FLASH_STORE_PAGE_SIZE; // 当前页中下一条记录的位置
+static uint16_t keyIndex[APP_FLASH_MAX_KEYS]; // 每个键最新的记录在当前页中的位置，0表示没有
+static uint8_t initialized = 0;
+
+static uint32_t Read32(uint32_t Addr);
+static uint32_t Crc(const uint32_t *pData, uint16_t Words);
+static     void Scan(uint32_t Page);
+static      int Program(uint32_t Addr, const uint32_t *pData, uint16_t Words);
+static      int Collect(void);
+static      int Append(uint8_t Key, const void *pData, uint16_t Size);
+
+//
+// @简介：初始化，找出当前页并建立索引
+// @注意：读写之前会自动调用
+//
+void App_Flash_Init(void)
+{
+	if(initialized) return;
+
+	RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+
+	uint8_t valid0 = Read32(FLASH_STORE_PAGE0) == FLASH_STORE_MAGIC;
+	uint8_t valid1 = Read32(FLASH_STORE_PAGE1) == FLASH_STORE_MAGIC;
+	uint32_t gen0 = Read32(FLASH_STORE_PAGE0 + 4);
+	uint32_t gen1 = Read32(FLASH_STORE_PAGE1 + 4);
+
+	if(valid0 && valid1)
+	{
+		active = ((int32_t)(gen1 - gen0) > 0) ? FLASH_STORE_PAGE1 : FLASH_STORE_PAGE0;
+	}
+	else if(valid0 || valid1)
+	{
+		active = valid0 ? FLASH_STORE_PAGE0 : FLASH_STORE_PAGE1;
+	}
+	else
+	{
+		active = 0; // 第一次保存时格式化
+	}
+
+	if(active != 0)
+	{
+		generation = (active == FLASH_STORE_PAGE0) ? gen0 : gen1;
+		Scan(active);
+	}
+
+	initialized = 1;
+}
+
+//
+// @简介：读取一个键的值
+// @参数：Key - 键，APP_FLASH_KEY_xxx
+// @参数：pData - 输出参数，读到的数据，超过Size的部分不复制
+// @参数：Size - pData的大小
+// @返回值：保存的数据的长度，调用者据此判断格式是否与当前版本一致；-1表示没有保存过
+//
+int App_Flash_Read(uint8_t Key, void *pData, uint16_t Size)
+{
+	App_Flash_Init();
+
+	if(Key == 0 || Key >= APP_FLASH_MAX_KEYS || keyIndex[Key] == 0) return -1;
+
+	uint32_t addr = active + keyIndex[Key];
+	uint8_t len = Read32(addr) >> 8;
+
+	memcpy(pData, (const void *)(addr + 4), len < Size ? len : Size);
+
+	return len;
+}
+
+//
+// @简介：保存一个键的值，在当前页末尾追加一条记录，页满时先回收
+// @参数：Key - 键，APP_FLASH_KEY_xxx
+// @参数：pData - 数据
+// @参数：Size - 数据的长度，1..APP_FLASH_MAX_SIZE
+// @返回值：0 - 成功，-1 - 参数错误或写入失败（之前保存的值仍然有效）
+// @注意：与已保存的值相同时不写入。写Flash期间CPU停顿，追加一条记录约1ms，
+//        回收时擦除一页另需约20ms，不要在平衡控制期间调用
+//
+int App_Flash_Write(uint8_t Key, const void *pData, uint16_t Size)
+{
+	if(Size == 0) return -1;
+
+	return Append(Key, pData, Size);
+}
+
+//
+// @简介：删除一个键，此后读取时视为没有保存过
+// @返回值：0 - 成功，-1 - 写入失败
+//
+int App_Flash_Delete(uint8_t Key)
+{
+	return Append(Key, NULL, 0);
+}
+
+static int Append(uint8_t Key, const void *pData, uint16_t Size)
+{
+	App_Flash_Init();
+
+	if(Key == 0 || Key >= APP_FLASH_MAX_KEYS || Size > APP_FLASH_MAX_SIZE) return -1;
+
+	// #1. 与已保存的值相同时不写入，减少磨损
+	if(keyIndex[Key] == 0)
+	{
+		if(Size == 0) return 0;
+	}
+	else if((uint8_t)(Read32(active + keyIndex[Key]) >> 8) == Size && memcmp((const void *)(active + keyIndex[Key] + 4), pData, Size) == 0)
+	{
+		return 0;
+	}
+
+	// #2. 在RAM中组好记录，CRC单元要求按字对齐
+	uint32_t record[RECORD_SIZE(APP_FLASH_MAX_SIZE) / 4];
+	uint16_t size = RECORD_SIZE(Size);
+	uint16_t words = size / 4;
+
+	memset(record, 0, size);
+	record[0] = RECORD_HEADER(Key, Size);
+
+	if(Size > 0) memcpy(&record[1], pData, Size);
+
+	record[words - 1] = Crc(record, words - 1);
+
+	// #3. 写入，页满时先回收
+	int ret = 0;
+
+	FLASH_Unlock();
+
+	if(active == 0 || tail + size > FLASH_STORE_PAGE_SIZE)
+	{
+		ret = Collect();
+
+		if(ret == 0 && tail + size > FLASH_STORE_PAGE_SIZE) ret = -1; // 回收后仍放不下
+	}
+
+	uint16_t offset = tail;
+
+	if(ret == 0)
+	{
+		tail += size; // 写入失败时这段空间也不能再用
+		ret = Program(active + offset, record, words);
+	}
+
+	FLASH_Lock();
+
+	// #4. 读回校验通过才更新索引
+	if(ret != 0 || Crc((const uint32_t *)(active + offset), words - 1) != Read32(active + offset + size - 4)) return -1;
+
+	keyIndex[Key] = (Size > 0) ? offset : 0;
+
+	return 0;
+}
+
+//
+// @简介：扫描一页中的记录，建立索引并找出下一条记录的位置
+//
+static void Scan(uint32_t Page)
+{
+	uint16_t offset = FLASH_STORE_HEADER_SIZE;
+
+	memset(keyIndex, 0, sizeof(keyIndex));
+
+	while(offset + RECORD_SIZE(0) <= FLASH_STORE_PAGE_SIZE)
+	{
+		uint32_t header = Read32(Page + offset);
+
+		if(header == 0xffffffff) break; // 已擦除，记录到此为止
+
+		uint8_t key = header;
+		uint8_t len = header >> 8;
+		uint16_t size = RECORD_SIZE(len);
+
+		if(header != RECORD_HEADER(key, len) || key == 0 || key >= APP_FLASH_MAX_KEYS ||
+		   len > APP_FLASH_MAX_SIZE || offset + size > FLASH_STORE_PAGE_SIZE)
+		{
+			offset = FLASH_STORE_PAGE_SIZE; // 记录头损坏
+			break;
+		}
+
+		// CRC错误的记录（写入时掉电）跳过，该键沿用之前的记录
+		if(Crc((const uint32_t *)(Page + offset), size / 4 - 1) == Read32(Page + offset + size - 4))
+		{
+			keyIndex[key] = (len > 0) ? offset : 0;
+		}
+
+		offset += size;
+	}
+
+	// 剩余的空间须为擦除状态才能追加，例如写记录头时掉电就可能留下无法识别的数据
+	for(uint16_t i=offset; i<FLASH_STORE_PAGE_SIZE; i+=4)
+	{
+		if(Read32(Page + i) != 0xffffffff)
+		{
+			offset = FLASH_STORE_PAGE_SIZE;
+			break;
+		}
+	}
+
+	tail = offset;
+}
+
+//
+// @简介：垃圾回收，把每个键的最新记录复制到另一页，复制完毕后写入页头，另一页成为当前页
+// @返回值：0 - 成功，-1 - 失败，当前页不变
+// @注意：调用前须解锁Flash。擦除或复制过程中掉电时另一页没有有效的页头，上电后仍使用原来的页
+//
+static int Collect(void)
+{
+	uint32_t target = (active == FLASH_STORE_PAGE0) ? FLASH_STORE_PAGE1 : FLASH_STORE_PAGE0;
+	uint16_t newIndex[APP_FLASH_MAX_KEYS] = {0};
+	uint16_t offset = FLASH_STORE_HEADER_SIZE;
+
+	FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+
+	// 先把另一页的Magic写成0（任何半字都可以写成0）再擦除：擦除中途掉电时页头可能完好而代数的一部分位变为1，
+	// 上电后这一页会被当作更新的页
+	uint32_t invalid = 0;
+
+	if(Program(target, &invalid, 1) != 0 || FLASH_ErasePage(target) != FLASH_COMPLETE) return -1;
+
+	for(uint8_t key=1; key<APP_FLASH_MAX_KEYS; key++)
+	{
+		if(keyIndex[key] == 0) continue;
+
+		uint32_t addr = active + keyIndex[key];
+		uint16_t size = RECORD_SIZE((uint8_t)(Read32(addr) >> 8));
+
+		if(Program(target + offset, (const uint32_t *)addr, size / 4) != 0) return -1;
+
+		newIndex[key] = offset;
+		offset += size;
+	}
+
+	uint32_t header[2] = {FLASH_STORE_MAGIC, generation + 1};
+
+	// 先写代数，最后写Magic
+	if(Program(target + 4, &header[1], 1) != 0 || Program(target, &header[0], 1) != 0) return -1;
+
+	active = target;
+	generation++;
+	tail = offset;
+	memcpy(keyIndex, newIndex, sizeof(keyIndex));
+
+	return 0;
+}
+
+//
+// @简介：按半字写入Flash
+// @返回值：0 - 成功，-1 - 失败
+//
+static int Program(uint32_t Addr, const uint32_t *pData, uint16_t Words)
+{
+	FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+
+	for(uint16_t i=0; i<Words; i++)
+	{
+		uint32_t word = pData[i];
+
+		if(FLASH_ProgramHalfWord(Addr + 4 * i, word) != FLASH_COMPLETE) return -1;
+		if(FLASH_ProgramHalfWord(Addr + 4 * i + 2, word >> 16) != FLASH_COMPLETE) return -1;
+	}
+
+	return 0;
+}
+
+static uint32_t Read32(uint32_t Addr)
+{
+	return *(const volatile uint32_t *)Addr;
+}
+
+static uint32_t Crc(const uint32_t *pData, uint16_t Words)
+{
+	CRC_ResetDR();
+
+	return CRC_CalcBlockCRC((uint32_t *)pData, Words);
+}
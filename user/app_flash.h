@@ -1,6 +1,26 @@
-#ifndef APP_FLASH_H
-#define APP_FLASH_H
-
-
-
-#endif
+#ifndef APP_FLASH_H
+#define APP_FLASH_H
+
+#include <stdint.h>
+
+//
+// 参数存储，占用Flash的Page126和Page127，两页轮流使用（ping-pong）。
+// 每次保存只在当前页的末尾追加一条记录，不擦除；当前页写满时才把每个键的最新记录
+// 复制到另一页（垃圾回收），复制完毕后写入页头，另一页才成为当前页，原来的页保留到下次回收。
+// 记录带CRC（STM32的CRC单元），保存过程中掉电只会丢失正在写的这一条，之前的值仍然有效。
+// 上电时扫描当前页，在RAM中建立每个键的最新记录的索引，读取时直接定位
+//
+#define APP_FLASH_MAX_KEYS 16 // 键为1..APP_FLASH_MAX_KEYS-1
+#define APP_FLASH_MAX_SIZE 60 // 每条记录的数据的最大字节数
+
+// 键的分配
+#define APP_FLASH_KEY_ENCODER   1 // 编码器的校准结果（app_calibrator.c）
+#define APP_FLASH_KEY_IMU       2 // MPU6050的零偏（app_calibrator.c）
+#define APP_FLASH_KEY_PID_GAINS 3 // 串级PID的增益（app_control.c）
+
+void App_Flash_Init(void);
+ int App_Flash_Read(uint8_t Key, void *pData, uint16_t Size);
+ int App_Flash_Write(uint8_t Key, const void *pData, uint16_t Size);
+ int App_Flash_Delete(uint8_t Key);
+
+#endif
@@ -0,0 +1,82 @@
+#include "app_latency.h"
+#include "app_telemetry.h"
+#include "task.h"
+
+static Hist_TypeDef hist;
+
+// 上一个统计周期的结果，单位us
+static int32_t p50 = 0;
+static int32_t p99 = 0;
+static int32_t max = 0;
+
+static uint16_t MakeFrame(uint8_t *pOut);
+
+void App_Latency_Init(void)
+{
+	Hist_Init(&hist, LATENCY_BINS, LATENCY_BIN_US);
+	
+	App_Telemetry_AddVariable("lat_p50", TELEMETRY_INT32, &p50, 1);
+	App_Telemetry_AddVariable("lat_p99", TELEMETRY_INT32, &p99, 1);
+	App_Telemetry_AddVariable("lat_max", TELEMETRY_INT32, &max, 1);
+}
+
+//
+// @简介：记下一次延迟，由电机任务在写PWM之后调用
+// @参数：Us - 写PWM的时刻与所用IMU样本的时刻之差，单位us
+//
+void App_Latency_Add(uint32_t Us)
+{
+	Hist_Add(&hist, Us);
+}
+
+//
+// @简介：每LATENCY_REPORT_MS更新遥测变量并发出直方图，然后开始下一个统计周期
+//
+void App_Latency_Proc(void)
+{
+	PERIODIC(LATENCY_REPORT_MS);
+	
+	if(hist.N == 0) return; // 电机未使能或还在起立，没有样本
+	
+	p50 = Hist_GetPercentile(&hist, 50);
+	p99 = Hist_GetPercentile(&hist, 99);
+	max = hist.Max;
+	
+	uint8_t frame[12 + LATENCY_BINS * 4 + 1];
+	
+	App_Telemetry_Send(frame, MakeFrame(frame)); // 队列放不下时丢弃这一帧，遥测变量仍然有效
+	
+	Hist_Reset(&hist);
+}
+
+static uint16_t MakeFrame(uint8_t *pOut)
+{
+	uint16_t n = 0;
+	
+	pOut[n++] = LATENCY_FRAME;
+	pOut[n++] = hist.NumBins;
+	pOut[n++] = hist.BinWidth;
+	pOut[n++] = hist.BinWidth >> 8;
+	
+	uint32_t words[2] = {hist.N, hist.Max};
+	
+	for(uint8_t i=0; i<2; i++)
+	{
+		pOut[n++] = words[i];
+		pOut[n++] = words[i] >> 8;
+		pOut[n++] = words[i] >> 16;
+		pOut[n++] = words[i] >> 24;
+	}
+	
+	for(uint16_t k=0; k<hist.NumBins; k++)
+	{
+		pOut[n++] = hist.Bins[k];
+		pOut[n++] = hist.Bins[k] >> 8;
+		pOut[n++] = hist.Bins[k] >> 16;
+		pOut[n++] = hist.Bins[k] >> 24;
+	}
+	
+	pOut[n] = Telemetry_Crc8(pOut, n);
+	
+	return n + 1;
+}
@@ -0,0 +1,29 @@
+#ifndef APP_LATENCY_H
+#define APP_LATENCY_H
+
+#include "hist.h"
+#include "telemetry.h"
+
+//
+// 端到端延迟：从MPU6050采样（GyroTopic或ImuTopic的时刻，app_bus.h）到据此算出的占空比写入PWM（TIM_SetCompare1）。
+// 控制任务把所用的最新样本的时刻交给电机任务（App_Motor_SetSource），电机任务每次写PWM时
+// 调用App_Latency_Add记下延迟；电机任务1ms执行一次，参考值在两次更新之间保持不变，
+// 因此直方图反映的是“正在输出的占空比所依据的测量值有多旧”。
+// 串级PID的角速度环每1ms更新参考值，LQR每5ms更新一次，每个样本贡献5个左右的延迟。
+// 每LATENCY_REPORT_MS统计一次：p50、p99、最大值登记为遥测变量lat_p50、lat_p99、lat_max，
+// 整个直方图以LATENCY帧经App_Telemetry_Send发出（tools/telemetry解码后输出到stderr），然后清空
+//
+#define LATENCY_REPORT_MS 1000 // 统计周期
+#define LATENCY_BINS      32   // 桶数，最后一个桶包括更大的延迟
+#define LATENCY_BIN_US    500  // 桶宽，单位us，可表示0~16ms
+
+// LATENCY帧，COBS编码，最后一个字节为CRC8（Telemetry_Crc8）
+//   类型 桶数 桶宽(2) 样本数(4) 最大值(4) 各桶的样本数(4*桶数) CRC8
+// 多字节整数均为小端，单位us
+#define LATENCY_FRAME (TELEMETRY_FRAME_USER + 2)
+
+void App_Latency_Init(void);
+void App_Latency_Add(uint32_t Us);
+void App_Latency_Proc(void);
+
+#endif
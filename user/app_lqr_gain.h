@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file    app_lqr_gain.h
+  * @brief   LQR增益矩阵，由tools/lqr_gen自动生成，请勿手工修改
+  *          状态量 [alpha, dalpha, pos, vel, yaw]，控制量 [acc, turn]
+  *          rw=0.032 lp=0.062 mp=0.12 Jp=0.00046128 g=9.8 track=0.16 Ts=0.005
+  *          Q=diag(100, 1, 4, 10, 1) R=diag(0.04, 2.5e-05)
+  *          闭环谱半径 0.996807，Riccati迭代3554次
+  ******************************************************************************
+  */
+
+#ifndef APP_LQR_GAIN_H
+#define APP_LQR_GAIN_H
+
+#define LQR_GAIN_NUM_STATES 5
+#define LQR_GAIN_NUM_INPUTS 2
+#define LQR_GAIN_TS 0.005f // 增益对应的控制周期，单位s
+
+static const float LQR_GAIN_K[LQR_GAIN_NUM_INPUTS * LQR_GAIN_NUM_STATES] = {
+	6.7612297e+01f, 5.8815144e+00f, -7.8581496e+00f, -1.5719100e+01f, 0.0000000e+00f,
+	0.0000000e+00f, 0.0000000e+00f, 0.0000000e+00f, 0.0000000e+00f, 1.6396078e+02f,
+};
+
+#endif
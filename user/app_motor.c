@@ -1,115 +1,239 @@
-#include "app_motor.h"
-#include "app_pwm.h"
-#include "app_encoder.h"
-#include "pid.h"
-#include "delay.h"
-#include "task.h"
-#include "math.h"
-#include "app_bat.h"
-
-// 电机参数
-//static const float La = 1.5e-3f; // 电枢电感，单位H
-//static const float Ra = 3.0f; // 电枢电阻，单位Ω
-//static const float Kt = 0.176; // 扭矩常数，单位N.m/A
-//static const float Ke = 0.176; // 反电动势常数，单位V/(rad/s)
-//static const float Jm = 2.787e-4f; // 电机的转动惯量，单位kg.m^2
-//static const float Jw = 3.891e-4f; // 小车等效转动惯量
-//static const float B  = 2.279e-4f; // 电机摩擦系数，单位N.m/(rad/s)
-//static const float TIdle = 0.01f; // 负载力矩，单位N.m
-
-static PID_TypeDef pid_l; // 左电机速度环PID
-static PID_TypeDef pid_r; // 右电机速度环PID
-
-static FunctionalState enabled = DISABLE; // 电机的当前使能状态
-
-void App_Motor_Init(void)
-{
-	App_PWM_Init();
-	App_Encoder_Init();
-	
-	PID_InitTypeDef PID_InitStruct = {0};
-	
-	PID_InitStruct.Kp = 0.5f;
-	PID_InitStruct.Ki = 5.0f;
-	PID_InitStruct.Kd = 0.0f;
-	PID_InitStruct.OutputUpperLimit = 8.2f; // 最高电压8.2V
-	PID_InitStruct.OutputLowerLimit = -8.2f; // 最低电压-8.2V
-	PID_InitStruct.Setpoint = 0;
-	PID_InitStruct.DefaultOutput = 0;
-	
-	PID_Init(&pid_l, &PID_InitStruct);
-	PID_Init(&pid_r, &PID_InitStruct);
-}
-
-void App_Motor_Cmd(FunctionalState NewState)
-{
-	App_PWM_Cmd(NewState);
-	PID_Cmd(&pid_l, NewState);
-	PID_Cmd(&pid_r, NewState);
-	
-	enabled = NewState;
-}
-
-FunctionalState App_Motor_GetState(void)
-{
-	return enabled;
-}
-
-void App_Motor_Reset(void)
-{
-	PID_Reset(&pid_l);
-	PID_Reset(&pid_r);
-}
-
-void App_Motor_Proc(void)
-{
-	PERIODIC(1)
-	
-	uint64_t now = GetUs();
-	
-	// 编码器
-	float omega_l = App_Encoder_GetSpeed_L(); // 左轮转速，单位rad/s
-	float omega_r = App_Encoder_GetSpeed_R(); // 右轮转速，单位rad/s
-	
-	// 电池电压
-	float bat = App_Bat_Get();
-	
-	// PID
-	float Va_l = PID_Compute1(&pid_l, omega_l, now);
-	float Va_r = PID_Compute1(&pid_r, omega_r, now);
-	
-	// 由期望电压计算占空比
-	float duty_l = Va_l / bat * 100.0;
-	float duty_r = Va_r / bat * 100.0;
-	
-	App_PWM_Set_L(duty_l);
-	App_PWM_Set_R(duty_r);
-}
-
-float App_Motor_GetSpeed_L(void)
-{
-	return App_Encoder_GetSpeed_L();
-}
-
-float App_Motor_GetSpeed_R(void)
-{
-	return App_Encoder_GetSpeed_R();
-}
-
-//
-// @简介：设置左电机的转速，单位rad/s
-//        该电机的标称转速为282r/min（29.516rad/s max）
-//
-void App_Motor_SetSpeed_L(float Speed)
-{
-	PID_ChangeSetpoint(&pid_l, Speed);
-}
-
-//
-// @简介：设置右电机的转速，单位rad/s
-//        该电机的标称转速为282r/min（29.516rad/s max）
-//
-void App_Motor_SetSpeed_R(float Speed)
-{
-	PID_ChangeSetpoint(&pid_r, Speed);
-}
+#include "app_motor.h"
+#include "app_pwm.h"
+#include "app_encoder.h"
+#include "pid.h"
+#include "delay.h"
+#include "task.h"
+#include "math.h"
+#include "app_bat.h"
+#include "app_pid_gain.h"
+#include "app_calibrator.h"
+#include "app_trace.h"
+#include "trace.h"
+#include "app_telemetry.h"
+#include "app_bus.h"
+#include "app_latency.h"
+
+// 电机参数
+//static const float La = 1.5e-3f; // 电枢电感，单位H
+//static const float Ra = 3.0f; // 电枢电阻，单位Ω
+//static const float Kt = 0.176; // 扭矩常数，单位N.m/A
+//static const float Ke = 0.176; // 反电动势常数，单位V/(rad/s)
+//static const float Jm = 2.787e-4f; // 电机的转动惯量，单位kg.m^2
+//static const float Jw = 3.891e-4f; // 小车等效转动惯量
+//static const float B  = 2.279e-4f; // 电机摩擦系数，单位N.m/(rad/s)
+//static const float TIdle = 0.01f; // 负载力矩，单位N.m
+
+#define MOTOR_PERIOD_MS 1 // 电机速度环的运算周期
+
+static PID_TypeDef pid_l; // 左电机速度环PID
+static PID_TypeDef pid_r; // 右电机速度环PID
+
+static FunctionalState enabled = DISABLE; // 电机的当前使能状态
+
+// 最近一次电机任务的测量值和输出，供遥测观察
+static float omega_l, omega_r; // 轮子转速，单位rad/s
+static float duty_l, duty_r;   // 占空比，单位%
+static float volt;             // 电池电压，单位V
+
+// 当前参考值所依据的IMU样本的时刻（App_Motor_SetSource），用于统计端到端延迟（app_latency.h）
+static uint32_t sourceUs;
+static uint8_t sourceValid = 0;
+
+void App_Motor_Init(void)
+{
+	App_PWM_Init();
+	App_Encoder_Init();
+	
+	PID_InitTypeDef PID_InitStruct = {0};
+	
+	PID_InitStruct.Kp = PID_GAIN_MOTOR_KP;
+	PID_InitStruct.Ki = PID_GAIN_MOTOR_KI;
+	PID_InitStruct.Kd = 0.0f;
+	PID_InitStruct.OutputUpperLimit = 8.2f; // 最高电压8.2V
+	PID_InitStruct.OutputLowerLimit = -8.2f; // 最低电压-8.2V
+	PID_InitStruct.Setpoint = 0;
+	PID_InitStruct.DefaultOutput = 0;
+	
+	PID_InitFixedRate(&pid_l, &PID_InitStruct, MOTOR_PERIOD_MS * 1.0e-3f);
+	PID_InitFixedRate(&pid_r, &PID_InitStruct, MOTOR_PERIOD_MS * 1.0e-3f);
+	
+	// 遥测，转速分辨率0.01rad/s，占空比0.01%，电压0.001V
+	App_Telemetry_AddChannel("omega_l", TELEMETRY_FLOAT, &omega_l, 100);
+	App_Telemetry_AddChannel("omega_r", TELEMETRY_FLOAT, &omega_r, 100);
+	App_Telemetry_AddChannel("omega_ref_l", TELEMETRY_FLOAT, &pid_l.Setpoint, 100);
+	App_Telemetry_AddChannel("omega_ref_r", TELEMETRY_FLOAT, &pid_r.Setpoint, 100);
+	App_Telemetry_AddChannel("iterm_l", TELEMETRY_FLOAT, &pid_l.ITerm, 1000);
+	App_Telemetry_AddChannel("iterm_r", TELEMETRY_FLOAT, &pid_r.ITerm, 1000);
+	App_Telemetry_AddChannel("duty_l", TELEMETRY_FLOAT, &duty_l, 100);
+	App_Telemetry_AddChannel("duty_r", TELEMETRY_FLOAT, &duty_r, 100);
+}
+
+void App_Motor_Cmd(FunctionalState NewState)
+{
+	App_PWM_Cmd(NewState);
+	PID_Cmd(&pid_l, NewState);
+	PID_Cmd(&pid_r, NewState);
+	
+	enabled = NewState;
+	
+	if(NewState == DISABLE) sourceValid = 0;
+}
+
+FunctionalState App_Motor_GetState(void)
+{
+	return enabled;
+}
+
+void App_Motor_Reset(void)
+{
+	PID_Reset(&pid_l);
+	PID_Reset(&pid_r);
+}
+
+void App_Motor_Proc(void)
+{
+	PERIODIC(MOTOR_PERIOD_MS)
+	
+	if(App_Calibrator_IsBusy()) return; // 校准期间电机由校准器直接控制
+	
+	uint32_t us = GetUs();
+	
+	App_Trace_Record(TRACE_MOTOR, 0, us, NULL, 0);
+	
+	// 编码器
+	App_Encoder_Proc(); // 批量处理自上次以来的编码器边沿
+	
+	omega_l = App_Encoder_GetSpeed_L(); // 左轮转速，单位rad/s
+	omega_r = App_Encoder_GetSpeed_R(); // 右轮转速，单位rad/s
+	
+	// 电池电压
+	volt = App_Bat_Get();
+	
+	// PID
+	float Va_l = PID_ComputeFixedRate(&pid_l, omega_l);
+	float Va_r = PID_ComputeFixedRate(&pid_r, omega_r);
+	
+	// 由期望电压计算占空比
+	duty_l = Va_l / volt * 100.0;
+	duty_r = Va_r / volt * 100.0;
+	
+	App_PWM_Set_L(duty_l);
+	App_PWM_Set_R(duty_r);
+	
+	uint32_t pwmUs = GetUs();
+	
+	if(enabled == ENABLE && sourceValid) App_Latency_Add(Time_Diff(pwmUs, sourceUs));
+	
+	// 发布样本（app_bus.h），控制任务直接使用这里测得的转速，不再读取编码器
+	WheelState_TypeDef *wheel = Bus_Write(&WheelTopic);
+	
+	wheel->Speed_L = omega_l;
+	wheel->Speed_R = omega_r;
+	wheel->Duty_L = duty_l;
+	wheel->Duty_R = duty_r;
+	wheel->Volt = volt;
+	
+	Bus_Publish(&WheelTopic, us);
+	
+	// 记录输出的校验值，回放时逐位比较
+	float duty[2] = {duty_l, duty_r};
+	uint16_t hash = Trace_Hash(duty, sizeof(duty));
+	
+	App_Trace_Record(TRACE_PWM, 0, pwmUs, &hash, sizeof(hash));
+}
+
+//
+// @简介：读取最近一次电机任务测得的轮子转速，单位rad/s
+// @注意：不读取编码器，也不产生记录（app_trace.c）
+//
+float App_Motor_GetSpeed_L(void)
+{
+	return omega_l;
+}
+
+float App_Motor_GetSpeed_R(void)
+{
+	return omega_r;
+}
+
+//
+// @简介：设置左电机的转速，单位rad/s
+//        该电机的标称转速为282r/min（29.516rad/s max）
+//
+void App_Motor_SetSpeed_L(float Speed)
+{
+	PID_ChangeSetpoint(&pid_l, Speed);
+}
+
+//
+// @简介：设置右电机的转速，单位rad/s
+//        该电机的标称转速为282r/min（29.516rad/s max）
+//
+void App_Motor_SetSpeed_R(float Speed)
+{
+	PID_ChangeSetpoint(&pid_r, Speed);
+}
+
+//
+// @简介：设置当前参考值所依据的IMU样本的时刻，此后每次写PWM时统计延迟（app_latency.h）
+// @参数：Us - 样本的时刻（Bus_GetUs(&ImuTopic)），单位us
+// @注意：参考值与姿态无关时（自动起立）调用App_Motor_ClearSource，不统计
+//
+void App_Motor_SetSource(uint32_t Us)
+{
+	sourceUs = Us;
+	sourceValid = 1;
+}
+
+void App_Motor_ClearSource(void)
+{
+	sourceValid = 0;
+}
+
+//
+// @简介：读取最近一次电机任务输出的占空比，单位%
+// @注意：同样不读取编码器，也不产生记录，供黑匣子等观察用
+//
+float App_Motor_GetDuty_L(void)
+{
+	return duty_l;
+}
+
+float App_Motor_GetDuty_R(void)
+{
+	return duty_r;
+}
+
+//
+// @简介：读取最近一次电机任务用到的电池电压，单位V，同样不产生记录
+//
+float App_Motor_GetVolt(void)
+{
+	return volt;
+}
+
+//
+// @简介：读取速度环的积分项，即电机电压中的积分部分，单位V，供热启动的检查点使用（app_boot.h）
+//
+float App_Motor_GetITerm_L(void)
+{
+	return pid_l.ITerm;
+}
+
+float App_Motor_GetITerm_R(void)
+{
+	return pid_r.ITerm;
+}
+
+//
+// @简介：热启动时使能电机，速度环从复位前的积分项继续，输出的电压不会从0开始
+// @参数：ITerm_L、ITerm_R - 复位前的积分项，单位V
+//
+void App_Motor_Resume(float ITerm_L, float ITerm_R)
+{
+	App_Motor_Cmd(ENABLE);
+	
+	pid_l.ITerm = ITerm_L;
+	pid_r.ITerm = ITerm_R;
+}
@@ -1,173 +1,456 @@
-#include "app_mpu6050.h"
-#include "si2c.h"
-#include "task.h"
-#include "qmath.h"
-#include "app_calibrator.h"
-
-static SI2C_TypeDef si2c;
-
-static void    reg_write(uint8_t reg, uint8_t data);
-static uint8_t reg_read(uint8_t reg);
-
-void App_MPU6050_Init(void)
-{
-	// #1. 初始化软I2C PB8-SCL  PB9-SDA
-	si2c.SCL_GPIOx = GPIOB;
-	si2c.SCL_GPIO_Pin = GPIO_Pin_8;
-	si2c.SDA_GPIOx = GPIOB;
-	si2c.SDA_GPIO_Pin = GPIO_Pin_9;
-	
-	My_SI2C_Init(&si2c);
-	
-	// #2. 初始化MPU6050
-	reg_write(0x6b, 0x80); // 设备复位
-	Delay(100);
-	reg_write(0x6b, 0x01); // 关闭睡眠模式，并将陀螺仪作为时钟来源
-	reg_write(0x19, 0x00); // 设置采样率为1kHz
-	
-	reg_write(0x1b, 0x18); // 设置陀螺仪的量程为2000°/s
-	reg_write(0x1a, 0x02); // 设置陀螺仪的带宽为94Hz
-	// reg_write(0x1a, 0x00); // 设置陀螺仪的带宽为250Hz
-	
-	reg_write(0x1c, 0x00); // 设置加速度传感器的量程为2g
-	reg_write(0x1d, 0x02); // 设置加速度传感器的带宽为92Hz
-	// reg_write(0x1d, 0x00); // 设置加速度传感器的带宽为460Hz
-}
-
-static uint8_t firstCompute = 1;
-static float ax, ay, az, temp, gx, gy, gz, yaw, roll, pitch;
-
-void App_MPU6050_Proc(void)
-{
-	PERIODIC(5); // 每5ms执行一次
-	App_MPU6050_Update();
-}
-
-void App_MPU6050_Update(void)
-{
-	// #1. 读取传感器原始值
-	int16_t accel_x_raw = (short)(reg_read(0x3b) << 8) | reg_read(0x3c);
-	int16_t accel_y_raw = (short)(reg_read(0x3d) << 8) | reg_read(0x3e);
-	int16_t accel_z_raw = (short)(reg_read(0x3f) << 8) | reg_read(0x40);
-	
-	int16_t temp_raw = (short)(reg_read(0x41) << 8) | reg_read(0x42);
-	
-	int16_t gyro_x_raw = (short)(reg_read(0x43) << 8) | reg_read(0x44);
-	int16_t gyro_y_raw = (short)(reg_read(0x45) << 8) | reg_read(0x46);
-	int16_t gyro_z_raw = (short)(reg_read(0x47) << 8) | reg_read(0x48);
-	
-	// #2. 换算
-	ax = accel_x_raw * 0.00006103515625f;
-	ay = accel_y_raw * 0.00006103515625f;
-	az = accel_z_raw * 0.00006103515625f;
-	
-	temp = temp_raw * 0.00294117647059f + 36.53;
-	
-	gx = gyro_x_raw * 0.06097560975610f - App_Calibrator_GetResult()->mpu6050_gx_bias;
-	gy = gyro_y_raw * 0.06097560975610f - App_Calibrator_GetResult()->mpu6050_gy_bias;
-	gz = gyro_z_raw * 0.06097560975610f - App_Calibrator_GetResult()->mpu6050_gz_bias;
-	
-	// #3. 互补滤波器
-	
-	float pitch_accel = qatan2(ay, az) * 1.0f / 3.14159265f * 180.0f;    // 翻滚角（加速度）
-	float roll_accel = -qatan2(ax, az) * 1.0f / 3.14159265f * 180.0f;  // 俯仰角（加速度）
-	
-	if(firstCompute) // 首次融合时使用加速度结果
-	{
-		firstCompute = 0;
-		
-		yaw = 0;
-		roll = roll_accel;
-		pitch = pitch_accel;
-	}
-	else
-	{
-		// 计算偏航角
-		yaw = yaw + gz * 0.005; // 直接使用陀螺仪计算偏航角
-		
-		// 计算翻滚角
-		if(roll - roll_accel > 180) roll -= 360;
-		if(roll_accel - roll > 180) roll += 360;
-		roll = 0.95238 * (roll + gy * 0.005) + (1 - 0.95238) * roll_accel;
-		
-		// 计算俯仰角
-		if(pitch - pitch_accel > 180) pitch -= 360;
-		if(pitch_accel - pitch > 180) pitch += 360;
-		pitch = 0.95238 * (pitch + gx * 0.005) + (1 - 0.95238) * pitch_accel;
-	}
-	
-	// 将所有角度限制在+-180度之间
-	if(yaw > 180) yaw -= 360;
-	if(yaw < -180) yaw += 360;
-	
-	if(roll > 180) roll -= 360;
-	if(roll < -180) roll += 360;
-	
-	if(pitch > 180) pitch -= 360;
-	if(pitch < -180) pitch += 360;
-}
-
-float App_MPU6050_GetAccelX(void)
-{
-	return ax; 
-}
-
-// 单位 度/s
-float App_MPU6050_GetAccelY(void)
-{ 
-	return ay; 
-}
-
-float App_MPU6050_GetAccelZ(void)
-{ 
-	return az; 
-}
-
-float App_MPU6050_GetGyroX(void)
-{
-	return gx; 
-}
-
-float App_MPU6050_GetGyroY(void)
-{ 
-	return gy; 
-}
-
-float App_MPU6050_GetGyroZ(void)
-{ 
-	return gz; 
-}
-
-float App_MPU6050_GetTemperature(void)
-{ 
-	return temp; 
-}
-
-float App_MPU6050_GetYaw(void)
-{
-	return yaw; 
-}
-
-float App_MPU6050_GetRoll(void)
-{ 
-	return roll; 
-}
-
-float App_MPU6050_GetPitch(void)
-{ 
-	return pitch + App_Calibrator_GetResult()->mpu6050_pitch_bias; 
-}
-
-static void reg_write(uint8_t reg, uint8_t data)
-{
-	My_SI2C_RegWriteBytes(&si2c, 0xd0, reg, &data, 1);
-}
-
-static uint8_t reg_read(uint8_t reg)
-{
-	uint8_t regVal;
-	
-	My_SI2C_RegReadBytes(&si2c, 0xd0, reg, &regVal, 1);
-	
-	return regVal;
-}
+#include "app_mpu6050.h"
+#include "i2c.h"
+#include "task.h"
+#include "pt.h"
+#include "qmath.h"
+#include "app_calibrator.h"
+#include "app_trace.h"
+#include "app_telemetry.h"
+#include "app_boot.h"
+#include "app_bus.h"
+
+static I2C_XferTypeDef xfer; // I2C1的中断方式传输
+
+static void    bus_clear(void);
+static void    reg_write(uint8_t reg, uint8_t data);
+static void    regs_read(uint8_t reg, uint8_t *pBuffer, uint16_t Size);
+static uint8_t BringUp(PT_TypeDef *pt);
+static uint8_t ResetDone(void);
+
+#define MPU6050_RESET_TIMEOUT_US 100000
+#define MPU6050_READ_TIMEOUT_US  800 // 400kHz下读取14字节约0.4ms，超过此时间中止
+
+enum { READ_NONE, READ_GYRO, READ_ALL };
+
+static uint8_t readBuffer[14]; // 中断方式读取的缓冲区
+static uint8_t reading = READ_NONE; // 正在进行的读取
+static uint32_t readStart; // 开始读取的时刻，单位us，即样本的时刻
+static uint32_t readErrors = 0; // 读取失败、总线忙或超时的次数
+
+static uint8_t resetCalled = 0; // App_MPU6050_Reset已调用
+static uint8_t resetting = 0; // 已开始复位，配置之前须等待复位完成
+static uint32_t resetStart; // 开始复位的时刻，单位us
+static PT_TypeDef bringUp; // 等待复位并配置的协程
+static uint8_t configured = 0;
+
+static uint8_t firstCompute = 1;
+static uint8_t pitchRestored = 0; // 1 - 热启动，首次融合时倾角沿用复位前的值
+static float ax, ay, az, temp, gx, gy, gz, yaw, roll, pitch;
+
+//
+// @简介：初始化硬件I2C并让MPU6050开始复位，不等待复位完成
+// @注意：复位需要约100ms，期间可以初始化其它模块，App_MPU6050_Proc等待复位完成后再配置。
+//        热启动时芯片没有断电，不必复位。没有调用时由App_MPU6050_Init调用
+//
+void App_MPU6050_Reset(void)
+{
+	// #1. 初始化I2C1，引脚重映射到PB8-SCL  PB9-SDA，快速模式400kHz
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO, ENABLE);
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_I2C1, ENABLE);
+	
+	bus_clear();
+	
+	GPIO_PinRemapConfig(GPIO_Remap_I2C1, ENABLE);
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_8 | GPIO_Pin_9;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_OD;
+	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_10MHz;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	I2C_InitTypeDef I2C_InitStruct = {0};
+	
+	I2C_InitStruct.I2C_ClockSpeed = 400000;
+	I2C_InitStruct.I2C_Mode = I2C_Mode_I2C;
+	I2C_InitStruct.I2C_DutyCycle = I2C_DutyCycle_2;
+	I2C_InitStruct.I2C_OwnAddress1 = 0;
+	I2C_InitStruct.I2C_Ack = I2C_Ack_Disable;
+	I2C_InitStruct.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+	
+	I2C_Init(I2C1, &I2C_InitStruct);
+	I2C_Cmd(I2C1, ENABLE);
+	
+	// 读取倒数第二个字节时须在约22us内关闭ACK，事件中断使用最高的抢占优先级（与编码器相同）
+	My_I2C_XferInit(&xfer, I2C1, 0);
+	
+	// #2. 设备复位
+	if(App_Boot_GetWarm() == NULL)
+	{
+		reg_write(0x6b, 0x80);
+		resetStart = GetUs();
+		resetting = 1;
+	}
+	
+	resetCalled = 1;
+}
+
+//
+// @简介：初始化，不等待MPU6050复位完成，复位完成后由App_MPU6050_Proc配置，见App_MPU6050_IsReady
+//
+void App_MPU6050_Init(void)
+{
+	if(!resetCalled) App_MPU6050_Reset();
+	
+	const BootCheckpoint_TypeDef *warm = App_Boot_GetWarm();
+	
+	// 热启动时互补滤波器从复位前的倾角继续，翻滚角仍由加速度计给出初值
+	if(warm != NULL)
+	{
+		pitch = warm->Pitch - App_Calibrator_GetResult()->mpu6050_pitch_bias;
+		pitchRestored = 1;
+	}
+	
+	// 遥测，角度分辨率0.01°，角速度0.1°/s，加速度0.001g
+	App_Telemetry_AddChannel("pitch", TELEMETRY_FLOAT, &pitch, 100);
+	App_Telemetry_AddChannel("roll", TELEMETRY_FLOAT, &roll, 100);
+	App_Telemetry_AddChannel("gx", TELEMETRY_FLOAT, &gx, 10);
+	App_Telemetry_AddChannel("gy", TELEMETRY_FLOAT, &gy, 10);
+	App_Telemetry_AddChannel("gz", TELEMETRY_FLOAT, &gz, 10);
+	App_Telemetry_AddChannel("ax", TELEMETRY_FLOAT, &ax, 1000);
+	App_Telemetry_AddChannel("az", TELEMETRY_FLOAT, &az, 1000);
+	App_Telemetry_AddVariable("imu_err", TELEMETRY_INT32, &readErrors, 1);
+}
+
+void App_MPU6050_Proc(void)
+{
+	if(!configured) // 等待复位完成并配置，每轮主循环检查一次
+	{
+		if(BringUp(&bringUp) == PT_WAITING) return;
+		
+		configured = 1;
+	}
+	
+	// #1. 上一次读取结束后解码并发布
+	if(reading != READ_NONE)
+	{
+		int8_t result = My_I2C_GetResult(&xfer);
+		
+		if(result == I2C_XFER_BUSY)
+		{
+			if(Time_Diff(GetUs(), readStart) < MPU6050_READ_TIMEOUT_US) return;
+			
+			My_I2C_AbortIT(&xfer); // 超时，例如从机没有响应
+			result = I2C_XFER_ABORTED;
+		}
+		
+		if(result != I2C_XFER_OK)
+		{
+			readErrors++;
+		}
+		else if(reading == READ_ALL)
+		{
+			App_MPU6050_Update(readBuffer, readStart);
+		}
+		else
+		{
+			App_MPU6050_UpdateGyro(readBuffer, readStart);
+		}
+		
+		reading = READ_NONE;
+	}
+	
+	// #2. 开始下一次读取，由I2C中断在后台完成
+	PERIODIC(MPU6050_RATE_MS);
+	
+	// 每MPU6050_ATTITUDE_DIV次读一次全部数据（14字节，约0.4ms），其余只读角速度环用到的x轴角速度（约0.15ms）
+	static uint8_t phase = 0;
+	
+	uint8_t all = phase == 0;
+	
+	if(++phase >= MPU6050_ATTITUDE_DIV) phase = 0;
+	
+	readStart = GetUs();
+	
+	if(My_I2C_RegReadBytes_IT(&xfer, 0xd0, all ? 0x3b : 0x43, readBuffer, all ? 14 : 2) == 0)
+	{
+		reading = all ? READ_ALL : READ_GYRO;
+	}
+	else
+	{
+		readErrors++;
+	}
+}
+
+//
+// @简介：是否已配置完毕并读取过至少一次，此前各角度和角速度没有意义
+// @返回值：1 - 是，0 - 否
+//
+uint8_t App_MPU6050_IsReady(void)
+{
+	return !firstCompute;
+}
+
+//
+// @简介：是否有读取正在进行，读取结束后App_MPU6050_Proc才发布新的样本
+// @返回值：1 - 是，0 - 否
+//
+uint8_t App_MPU6050_IsReading(void)
+{
+	return reading != READ_NONE;
+}
+
+//
+// @简介：I2C1的事件和错误中断
+//
+void I2C1_EV_IRQHandler(void)
+{
+	My_I2C_EV_IRQHandler(&xfer);
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+	My_I2C_ER_IRQHandler(&xfer);
+}
+
+//
+// @简介：等待复位完成后配置MPU6050，热启动时没有复位，配置重写一遍即可
+//
+static uint8_t BringUp(PT_TypeDef *pt)
+{
+	PT_BEGIN(pt);
+	
+	// #1. 等待复位完成
+	PT_WAIT_UNTIL(pt, ResetDone());
+	
+	resetting = 0;
+	
+	// #2. 配置
+	reg_write(0x6b, 0x01); // 关闭睡眠模式，并将陀螺仪作为时钟来源
+	reg_write(0x19, 0x00); // 设置采样率为1kHz
+	
+	reg_write(0x1b, 0x18); // 设置陀螺仪的量程为2000°/s
+	reg_write(0x1a, 0x02); // 设置陀螺仪的带宽为94Hz
+	// reg_write(0x1a, 0x00); // 设置陀螺仪的带宽为250Hz
+	
+	reg_write(0x1c, 0x00); // 设置加速度传感器的量程为2g
+	reg_write(0x1d, 0x02); // 设置加速度传感器的带宽为92Hz
+	// reg_write(0x1d, 0x00); // 设置加速度传感器的带宽为460Hz
+	
+	PT_END(pt);
+}
+
+//
+// @简介：复位是否已完成，复位完成时PWR_MGMT_1的DEVICE_RESET位自动清零，通常早于手册给出的100ms
+// @返回值：1 - 已完成、没有复位（热启动）或者超过MPU6050_RESET_TIMEOUT_US仍未清零（照常配置），0 - 继续等待
+//
+static uint8_t ResetDone(void)
+{
+	if(!resetting) return 1;
+	
+	if(Time_Diff(GetUs(), resetStart) >= MPU6050_RESET_TIMEOUT_US) return 1;
+	
+	uint8_t pwr_mgmt_1 = 0x80;
+	
+	regs_read(0x6b, &pwr_mgmt_1, 1);
+	
+	return (pwr_mgmt_1 & 0x80) == 0;
+}
+
+//
+// @简介：解码从0x3b开始读取的14个字节，更新姿态并发布
+// @参数：pData - 原始数据，芯片在连续读期间锁存数据寄存器，
+//        保证同一个数据的高低字节以及各轴的数据来自同一次采样
+// @参数：Us - 开始读取的时刻，单位us
+//
+void App_MPU6050_Update(const uint8_t *pData, uint32_t Us)
+{
+	// #1. 传感器原始值
+	App_Trace_Record(TRACE_IMU, 0, Us, pData, 14);
+	
+	int16_t accel_x_raw = (short)(pData[0] << 8) | pData[1];
+	int16_t accel_y_raw = (short)(pData[2] << 8) | pData[3];
+	int16_t accel_z_raw = (short)(pData[4] << 8) | pData[5];
+	
+	int16_t temp_raw = (short)(pData[6] << 8) | pData[7];
+	
+	int16_t gyro_x_raw = (short)(pData[8] << 8) | pData[9];
+	int16_t gyro_y_raw = (short)(pData[10] << 8) | pData[11];
+	int16_t gyro_z_raw = (short)(pData[12] << 8) | pData[13];
+	
+	// #2. 换算
+	ax = accel_x_raw * 0.00006103515625f;
+	ay = accel_y_raw * 0.00006103515625f;
+	az = accel_z_raw * 0.00006103515625f;
+	
+	temp = temp_raw * 0.00294117647059f + 36.53;
+	
+	const CaliResult_TypeDef *cali = App_Calibrator_GetResult();
+	
+	gx = gyro_x_raw * 0.06097560975610f - cali->mpu6050_gx_bias;
+	gy = gyro_y_raw * 0.06097560975610f - cali->mpu6050_gy_bias;
+	gz = gyro_z_raw * 0.06097560975610f - cali->mpu6050_gz_bias;
+	
+	// #3. 互补滤波器
+	
+	float pitch_accel = qatan2(ay, az) * 1.0f / 3.14159265f * 180.0f;    // 翻滚角（加速度）
+	float roll_accel = -qatan2(ax, az) * 1.0f / 3.14159265f * 180.0f;  // 俯仰角（加速度）
+	
+	if(firstCompute) // 首次融合时使用加速度结果
+	{
+		firstCompute = 0;
+		
+		yaw = 0;
+		roll = roll_accel;
+		
+		if(!pitchRestored) pitch = pitch_accel;
+	}
+	else
+	{
+		// 计算偏航角
+		yaw = yaw + gz * 0.005; // 直接使用陀螺仪计算偏航角
+		
+		// 计算翻滚角
+		if(roll - roll_accel > 180) roll -= 360;
+		if(roll_accel - roll > 180) roll += 360;
+		roll = 0.95238 * (roll + gy * 0.005) + (1 - 0.95238) * roll_accel;
+		
+		// 计算俯仰角
+		if(pitch - pitch_accel > 180) pitch -= 360;
+		if(pitch_accel - pitch > 180) pitch += 360;
+		pitch = 0.95238 * (pitch + gx * 0.005) + (1 - 0.95238) * pitch_accel;
+	}
+	
+	// 将所有角度限制在+-180度之间
+	if(yaw > 180) yaw -= 360;
+	if(yaw < -180) yaw += 360;
+	
+	if(roll > 180) roll -= 360;
+	if(roll < -180) roll += 360;
+	
+	if(pitch > 180) pitch -= 360;
+	if(pitch < -180) pitch += 360;
+	
+	// #4. 发布样本（app_bus.h），倾角在此加上安装偏差，读取时不再计算
+	ImuSample_TypeDef *sample = Bus_Write(&ImuTopic);
+	
+	sample->Ax = ax;
+	sample->Ay = ay;
+	sample->Az = az;
+	sample->Gx = gx;
+	sample->Gy = gy;
+	sample->Gz = gz;
+	sample->Pitch = pitch + cali->mpu6050_pitch_bias;
+	sample->Roll = roll;
+	sample->Yaw = yaw;
+	sample->Temp = temp;
+	
+	Bus_Publish(&ImuTopic, Us);
+	
+	((GyroSample_TypeDef *)Bus_Write(&GyroTopic))->Gx = gx;
+	Bus_Publish(&GyroTopic, Us);
+}
+
+//
+// @简介：解码从0x43开始读取的2个字节（x轴角速度）并发布（GyroTopic），不更新姿态
+// @参数：Us - 开始读取的时刻，单位us
+//
+void App_MPU6050_UpdateGyro(const uint8_t *pData, uint32_t Us)
+{
+	App_Trace_Record(TRACE_IMU, 1, Us, pData, 2);
+	
+	int16_t gyro_x_raw = (short)(pData[0] << 8) | pData[1];
+	
+	gx = gyro_x_raw * 0.06097560975610f - App_Calibrator_GetResult()->mpu6050_gx_bias;
+	
+	((GyroSample_TypeDef *)Bus_Write(&GyroTopic))->Gx = gx;
+	Bus_Publish(&GyroTopic, Us);
+}
+
+float App_MPU6050_GetAccelX(void)
+{
+	return ax; 
+}
+
+// 单位 度/s
+float App_MPU6050_GetAccelY(void)
+{ 
+	return ay; 
+}
+
+float App_MPU6050_GetAccelZ(void)
+{ 
+	return az; 
+}
+
+float App_MPU6050_GetGyroX(void)
+{
+	return gx; 
+}
+
+float App_MPU6050_GetGyroY(void)
+{ 
+	return gy; 
+}
+
+float App_MPU6050_GetGyroZ(void)
+{ 
+	return gz; 
+}
+
+float App_MPU6050_GetTemperature(void)
+{ 
+	return temp; 
+}
+
+float App_MPU6050_GetYaw(void)
+{
+	return yaw; 
+}
+
+float App_MPU6050_GetRoll(void)
+{ 
+	return roll; 
+}
+
+float App_MPU6050_GetPitch(void)
+{ 
+	return ((const ImuSample_TypeDef *)Bus_Read(&ImuTopic))->Pitch; // 已加上安装偏差
+}
+
+//
+// @简介：单片机在读取中途复位（热启动）时，MPU6050可能正拉低SDA等待发送下一位，
+//        I2C外设会一直认为总线忙。此时用GPIO在SCL上补足时钟，直到从机释放SDA，再发送停止位
+//
+static void bus_clear(void)
+{
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	GPIO_WriteBit(GPIOB, GPIO_Pin_8 | GPIO_Pin_9, Bit_SET);
+	
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_8 | GPIO_Pin_9;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_Out_OD;
+	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_10MHz;
+	
+	GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	for(uint8_t i=0; i<9 && GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_9) == Bit_RESET; i++)
+	{
+		GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_RESET);
+		DelayUs(5);
+		GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_SET);
+		DelayUs(5);
+	}
+	
+	// 停止位：SCL为高时SDA由低变高
+	GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_RESET);
+	GPIO_WriteBit(GPIOB, GPIO_Pin_9, Bit_RESET);
+	DelayUs(5);
+	GPIO_WriteBit(GPIOB, GPIO_Pin_8, Bit_SET);
+	DelayUs(5);
+	GPIO_WriteBit(GPIOB, GPIO_Pin_9, Bit_SET);
+	DelayUs(5);
+}
+
+// 以下为阻塞方式的读写，只在配置期间使用（此时没有中断方式的传输）
+
+static void reg_write(uint8_t reg, uint8_t data)
+{
+	My_I2C_RegWriteBytes(I2C1, 0xd0, reg, &data, 1);
+}
+
+static void regs_read(uint8_t reg, uint8_t *pBuffer, uint16_t Size)
+{
+	My_I2C_RegReadBytes(I2C1, 0xd0, reg, pBuffer, Size);
+}
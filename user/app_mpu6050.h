@@ -1,20 +1,32 @@
-#ifndef MPU6050_H
-#define MPU6050_H
-
-#include "stdint.h"
-
- void App_MPU6050_Init(void);
- void App_MPU6050_Proc(void);
- void App_MPU6050_Update(void);
-float App_MPU6050_GetAccelX(void);
-float App_MPU6050_GetAccelY(void);
-float App_MPU6050_GetAccelZ(void);
-float App_MPU6050_GetGyroX(void);
-float App_MPU6050_GetGyroY(void);
-float App_MPU6050_GetGyroZ(void);
-float App_MPU6050_GetTemperature(void);
-float App_MPU6050_GetYaw(void);
-float App_MPU6050_GetRoll(void);
-float App_MPU6050_GetPitch(void);
-
-#endif
+#ifndef MPU6050_H
+#define MPU6050_H
+
+#include "stdint.h"
+
+//
+// 每MPU6050_RATE_MS读取一次x轴角速度（GyroTopic，角速度环），其中每MPU6050_ATTITUDE_DIV次读取全部数据
+// 并更新姿态（ImuTopic）。读取经硬件I2C1由中断在后台完成（i2c.c），App_MPU6050_Proc只负责开始读取和
+// 解码，CPU占用见tools/emu
+//
+#define MPU6050_RATE_MS      1 // 读取x轴角速度的周期，MPU6050的采样率为1kHz
+#define MPU6050_ATTITUDE_DIV 5 // 每MPU6050_ATTITUDE_DIV个周期读取一次全部数据并更新姿态，即5ms
+
+   void App_MPU6050_Reset(void);
+   void App_MPU6050_Init(void);
+   void App_MPU6050_Proc(void);
+   void App_MPU6050_Update(const uint8_t *pData, uint32_t Us);
+   void App_MPU6050_UpdateGyro(const uint8_t *pData, uint32_t Us);
+uint8_t App_MPU6050_IsReady(void);
+uint8_t App_MPU6050_IsReading(void);
+  float App_MPU6050_GetAccelX(void);
+  float App_MPU6050_GetAccelY(void);
+  float App_MPU6050_GetAccelZ(void);
+  float App_MPU6050_GetGyroX(void);
+  float App_MPU6050_GetGyroY(void);
+  float App_MPU6050_GetGyroZ(void);
+  float App_MPU6050_GetTemperature(void);
+  float App_MPU6050_GetYaw(void);
+  float App_MPU6050_GetRoll(void);
+  float App_MPU6050_GetPitch(void);
+
+#endif
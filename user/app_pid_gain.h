@@ -0,0 +1,21 @@
+/**
+  ******************************************************************************
+  * @file    app_pid_gain.h
+  * @brief   串级PID和电机速度环的增益，可由tools/batch/tune自动生成
+  *          当前为台架上手工整定的数值
+  ******************************************************************************
+  */
+
+#ifndef APP_PID_GAIN_H
+#define APP_PID_GAIN_H
+
+#define PID_GAIN_VEL_KP    2.0000000e-01f // 速度环
+#define PID_GAIN_VEL_KI    2.0000000e-03f
+#define PID_GAIN_ALPHA_KP  7.0000000e+00f // 角度环
+#define PID_GAIN_ALPHA_KI  7.0000000e+00f
+#define PID_GAIN_DALPHA_KP 3.0000000e+01f // 角速度环
+#define PID_GAIN_DALPHA_KI 3.0000000e+01f
+#define PID_GAIN_MOTOR_KP  5.0000000e-01f // 电机速度环
+#define PID_GAIN_MOTOR_KI  5.0000000e+00f
+
+#endif
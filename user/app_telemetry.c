@@ -0,0 +1,258 @@
+#include "app_telemetry.h"
+#include "app_usart2.h"
+#include "task.h"
+#include <string.h>
+#include <stdlib.h>
+
+//
+// 每个tick生成一帧，COBS编码后直接写入USART2发送队列中预留的空间，由DMA发出；
+// 队列放不下时丢弃该帧，下一帧改为KEY帧。现有的28个通道全部以1kHz发送时约40KB/s（仿真实测），
+// 低于串口约92KB/s的带宽
+//
+#define TELEMETRY_KEY_INTERVAL 100 // KEY帧的间隔，单位tick
+
+static Telemetry_TypeDef telemetry;
+static uint8_t initialized = 0;
+
+static char line[48];
+static uint16_t cursor = 0;
+
+static void Cmd_Proc(void);
+static void Cmd_Exec(char *Name, char *Arg1, char *Arg2);
+static void Reply(int8_t Channel, uint8_t Status);
+static uint16_t Hz_2_Divider(int Hz);
+
+//
+// @简介：初始化遥测
+// @注意：各模块可以在此之前登记通道
+//
+void App_Telemetry_Init(void)
+{
+	if(initialized) return;
+
+	Telemetry_Init(&telemetry, TELEMETRY_KEY_INTERVAL);
+
+	initialized = 1;
+}
+
+//
+// @简介：登记一个通道，以TELEMETRY_DEFAULT_HZ发送
+// @参数：Name - 名称，须为字符串常量，不含空格
+// @参数：Type - 数据类型，TELEMETRY_xxx
+// @参数：pValue - 变量的地址，变量须在整个运行期间有效（全局或静态变量）
+// @参数：Scale - 仅对TELEMETRY_FLOAT有效，分辨率为1/Scale
+// @返回值：通道号，-1表示通道已满
+//
+int8_t App_Telemetry_AddChannel(const char *Name, uint8_t Type, const volatile void *pValue, float Scale)
+{
+	App_Telemetry_Init();
+
+	return Telemetry_AddChannel(&telemetry, Name, Type, pValue, Scale, Hz_2_Divider(TELEMETRY_DEFAULT_HZ));
+}
+
+//
+// @简介：登记一个默认不发送的通道，可以用命令get读取，或者用rate、div开启
+// @参数：同App_Telemetry_AddChannel
+// @返回值：通道号，-1表示通道已满
+//
+int8_t App_Telemetry_AddVariable(const char *Name, uint8_t Type, const volatile void *pValue, float Scale)
+{
+	App_Telemetry_Init();
+
+	return Telemetry_AddChannel(&telemetry, Name, Type, pValue, Scale, 0);
+}
+
+//
+// @简介：允许用命令set在给定的范围内修改通道的变量
+// @参数：Channel - App_Telemetry_AddChannel或App_Telemetry_AddVariable返回的通道号
+// @参数：Min, Max - 允许写入的范围
+// @参数：OnWrite - 写入后调用，可以为NULL
+// @返回值：0 - 成功，-1 - 通道号无效或可写的通道已满
+//
+int8_t App_Telemetry_SetWritable(int8_t Channel, float Min, float Max, void (*OnWrite)(void))
+{
+	App_Telemetry_Init();
+
+	return Telemetry_SetWritable(&telemetry, Channel, Min, Max, OnWrite) >= 0 ? 0 : -1;
+}
+
+//
+// @简介：采样并发送，须放在主循环中控制代码之后，使同一tick内看到的是更新后的值
+//
+void App_Telemetry_Proc(void)
+{
+	PERIODIC(TELEMETRY_PERIOD_MS);
+
+	uint8_t frame[TELEMETRY_MAX_FRAME];
+	uint16_t len;
+
+	Cmd_Proc();
+
+#if USART2_STREAM == USART2_STREAM_TELEMETRY
+	len = Telemetry_Sample(&telemetry, frame);
+
+	if(len > 0 && App_Telemetry_Send(frame, len) != 0)
+	{
+		Telemetry_Drop(&telemetry);
+	}
+
+	len = Telemetry_Schema(&telemetry, frame);
+
+	if(len > 0)
+	{
+		App_Telemetry_Send(frame, len); // 描述帧轮流重发，丢了也无妨
+	}
+#else
+	(void)frame; (void)len;
+#endif
+}
+
+//
+// @简介：获取因串口来不及发送而丢弃的帧数
+//
+uint32_t App_Telemetry_GetDropped(void)
+{
+	return telemetry.Dropped;
+}
+
+//
+// @简介：COBS编码后写入USART2的发送队列，也供其它模块发送自定义的帧（类型为TELEMETRY_FRAME_USER及以上）
+// @参数：pFrame - 编码前的帧，第一个字节为帧的类型
+// @参数：Len - 帧的长度
+// @返回值：0 - 成功，-1 - 队列放不下，或者USART2未用于遥测（USART2_STREAM），帧未发送
+// @注意：可以在中断中调用
+//
+int App_Telemetry_Send(const uint8_t *pFrame, uint16_t Len)
+{
+#if USART2_STREAM == USART2_STREAM_TELEMETRY
+	Serial_TypeDef *serial = App_USART2_GetSerial();
+	int ret = -1;
+
+	// 遥测帧、其它模块的帧和printf可能在主循环和中断中写入同一个队列，预留到提交之间须关中断
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+
+	uint8_t *p = My_Serial_TxReserve(serial, TELEMETRY_COBS_SIZE(Len));
+
+	if(p != NULL)
+	{
+		My_Serial_TxCommit(serial, Telemetry_CobsEncode(pFrame, Len, p));
+		ret = 0;
+	}
+
+	__set_PRIMASK(primask);
+
+	return ret;
+#else
+	(void)pFrame; (void)Len;
+	return -1;
+#endif
+}
+
+//
+// @简介：处理电脑端经USART2发来的命令
+//
+static void Cmd_Proc(void)
+{
+	uint8_t byte;
+
+	while(My_Serial_Read(App_USART2_GetSerial(), &byte, 1) == 1)
+	{
+		if(byte == '\r') continue;
+
+		if(byte != '\n')
+		{
+			if(cursor < sizeof(line) - 1)
+			{
+				line[cursor++] = byte;
+			}
+			else
+			{
+				cursor = sizeof(line); // 过长，丢弃这一行
+			}
+
+			continue;
+		}
+
+		if(cursor >= sizeof(line))
+		{
+			cursor = 0;
+			continue;
+		}
+
+		line[cursor] = '\0';
+		cursor = 0;
+
+		char *name = strtok(line, " ");
+		char *arg1 = strtok(NULL, " ");
+		char *arg2 = strtok(NULL, " ");
+
+		if(name != NULL) Cmd_Exec(name, arg1, arg2);
+	}
+}
+
+//
+// @简介：执行一条命令
+//
+static void Cmd_Exec(char *Name, char *Arg1, char *Arg2)
+{
+	if(strcmp(Name, "schema") == 0 || strcmp(Name, "list") == 0)
+	{
+		Telemetry_RequestSchema(&telemetry);
+		return;
+	}
+
+	if(Arg1 == NULL) return;
+
+	uint8_t all = (strcmp(Arg1, "*") == 0);
+	int8_t ch = all ? -1 : Telemetry_FindChannel(&telemetry, Arg1);
+
+	if(strcmp(Name, "rate") == 0 && Arg2 != NULL)
+	{
+		if(ch >= 0 || all) Telemetry_SetDivider(&telemetry, ch, Hz_2_Divider(atoi(Arg2)));
+	}
+	else if(strcmp(Name, "div") == 0 && Arg2 != NULL)
+	{
+		int div = atoi(Arg2);
+
+		if(ch >= 0 || all) Telemetry_SetDivider(&telemetry, ch, div < 0 ? 0 : div > 0xffff ? 0xffff : div);
+	}
+	else if(strcmp(Name, "get") == 0)
+	{
+		Reply(ch, TELEMETRY_STATUS_OK);
+	}
+	else if(strcmp(Name, "set") == 0 && Arg2 != NULL)
+	{
+		char *end;
+		float value = strtod(Arg2, &end);
+
+		Reply(ch, (*end == '\0') ? Telemetry_Write(&telemetry, ch, value) : TELEMETRY_STATUS_RANGE);
+	}
+}
+
+//
+// @简介：以VALUE帧应答get、set，队列放不下时不再重发
+//
+static void Reply(int8_t Channel, uint8_t Status)
+{
+	uint8_t frame[TELEMETRY_VALUE_FRAME];
+	uint16_t len = Telemetry_Value(&telemetry, Channel, Status, frame);
+
+	App_Telemetry_Send(frame, len);
+}
+
+//
+// @简介：采样率换算为分频系数，0Hz为关闭，超过1kHz按1kHz
+//
+static uint16_t Hz_2_Divider(int Hz)
+{
+	if(Hz <= 0) return 0;
+
+	int div = 1000 / TELEMETRY_PERIOD_MS / Hz;
+
+	if(div < 1) div = 1;
+	if(div > 0xffff) div = 0xffff;
+
+	return div;
+}
@@ -0,0 +1,31 @@
+#ifndef APP_TELEMETRY_H
+#define APP_TELEMETRY_H
+
+#include "telemetry.h"
+
+//
+// 遥测，格式见my_lib/telemetry.h
+// 各模块在初始化时用App_Telemetry_AddChannel登记需要观察的变量，默认以100Hz发送；
+// 用App_Telemetry_AddVariable登记的变量默认不发送，供调试时按需观察。
+// 电脑端经USART2发送命令（一行一条，以'\n'结束）：
+//   rate <名称> <Hz>   - 设置通道的采样率，名称为*表示全部通道，0表示关闭，最高1000Hz
+//   div <名称> <n>     - 设置通道的分频系数，每n个tick（ms）发送一次，0表示关闭
+//   schema 或 list     - 重发全部通道的描述（含是否可写）
+//   get <名称>         - 读取一次，以VALUE帧应答
+//   set <名称> <值>    - 修改可写的通道（App_Telemetry_SetWritable），超出范围时不修改，
+//                        以VALUE帧应答结果和修改后的值
+// 命令在主循环中两个任务之间执行，修改变量不会与控制代码冲突
+// 输出由tools/telemetry解码为CSV
+//
+#define TELEMETRY_PERIOD_MS 1   // 基本周期（tick），即最高采样率1kHz
+#define TELEMETRY_DEFAULT_HZ 100 // 通道的默认采样率
+
+  void App_Telemetry_Init(void);
+int8_t App_Telemetry_AddChannel(const char *Name, uint8_t Type, const volatile void *pValue, float Scale);
+int8_t App_Telemetry_AddVariable(const char *Name, uint8_t Type, const volatile void *pValue, float Scale);
+int8_t App_Telemetry_SetWritable(int8_t Channel, float Min, float Max, void (*OnWrite)(void));
+  void App_Telemetry_Proc(void);
+   int App_Telemetry_Send(const uint8_t *pFrame, uint16_t Len);
+uint32_t App_Telemetry_GetDropped(void);
+
+#endif
@@ -0,0 +1,99 @@
+#include "app_trace.h"
+#include "stm32f10x.h"
+#include "trace.h"
+#include "delay.h"
+#include "app_calibrator.h"
+#include "app_usart2.h"
+
+//
+// 记录经USART2的发送队列（app_usart2.c）由DMA发出，主循环不参与，USART2_STREAM须为USART2_STREAM_TRACE。
+// 最坏情况下（两个车轮都以最高转速转动）约45KB/s，低于串口约92KB/s的带宽；
+// 队列放不下时丢弃新记录，并在恢复后插入一条LOST记录
+//
+static uint32_t lastUs = 0;       // 最近一条记录的时间，用于时间差编码
+static uint32_t dropped = 0;      // 尚未报告的丢弃条数
+static uint32_t totalDropped = 0; // 累计丢弃的条数
+
+//
+// @简介：初始化记录模块，写入HEADER记录
+// @注意：须在App_USART2_Init和App_Calibrator_Init之后、其它模块初始化之前调用，
+//        回放需要从上电开始的完整记录
+//
+void App_Trace_Init(void)
+{
+	const CaliResult_TypeDef *cali = App_Calibrator_GetResult();
+	TraceHeader_TypeDef header = {0};
+
+	header.Magic = TRACE_MAGIC;
+	header.Version = TRACE_VERSION;
+	header.EncoderDuty_L = cali->encoder_duty_l;
+	header.EncoderDuty_R = cali->encoder_duty_r;
+	header.GxBias = cali->mpu6050_gx_bias;
+	header.GyBias = cali->mpu6050_gy_bias;
+	header.GzBias = cali->mpu6050_gz_bias;
+	header.PitchBias = cali->mpu6050_pitch_bias;
+
+	App_Trace_Record(TRACE_HEADER, 0, GetUs(), &header, sizeof(header));
+}
+
+//
+// @简介：写入一条记录，可以在中断中调用
+// @参数：Type - 记录类型，TRACE_xxx
+// @参数：Flags - 标志，0..7
+// @参数：Us - 记录的时间，单位us
+// @参数：pData - 负载，为NULL时不带负载
+// @参数：Size - 负载的长度
+// @注意：可以在关中断的临界区内调用，返回时保持原来的中断屏蔽状态
+//
+void App_Trace_Record(uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size)
+{
+#if USART2_STREAM == USART2_STREAM_TRACE
+	Serial_TypeDef *serial = App_USART2_GetSerial();
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq(); // 预留、编码和提交须连续完成，lastUs也只能按写入顺序更新
+
+	uint16_t len = Trace_GetEncodedSize(lastUs, Us, pData != NULL, Size);
+	uint8_t n[4];
+
+	if(dropped > 0)
+	{
+		// 先报告丢弃的条数，LOST记录与本条记录同一时刻，本条记录的时间差为0
+		n[0] = dropped; n[1] = dropped >> 8; n[2] = dropped >> 16; n[3] = dropped >> 24;
+
+		len = Trace_GetEncodedSize(lastUs, Us, 1, sizeof(n)) + Trace_GetEncodedSize(Us, Us, pData != NULL, Size);
+	}
+
+	uint8_t *p = My_Serial_TxReserve(serial, len);
+
+	if(p == NULL)
+	{
+		dropped++;
+		totalDropped++;
+	}
+	else
+	{
+		if(dropped > 0)
+		{
+			p += Trace_Encode(&lastUs, p, TRACE_TYPE_LOST, 0, Us, n, sizeof(n));
+			dropped = 0;
+		}
+
+		Trace_Encode(&lastUs, p, Type, Flags, Us, pData, Size);
+
+		My_Serial_TxCommit(serial, len);
+	}
+
+	__set_PRIMASK(primask);
+#else
+	(void)Type; (void)Flags; (void)Us; (void)pData; (void)Size;
+#endif
+}
+
+//
+// @简介：获取因串口来不及发送而丢弃的记录条数
+//
+uint32_t App_Trace_GetDropped(void)
+{
+	return totalDropped;
+}
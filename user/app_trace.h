@@ -0,0 +1,53 @@
+#ifndef APP_TRACE_H
+#define APP_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//
+// 记录的类型，格式见my_lib/trace.h
+// 从上电开始记录控制代码的全部输入，tools/replay据此在电脑上逐位复现控制代码的运行过程。
+// 输入分为两类：
+//   异步输入 - 编码器边沿，发生在中断中，回放时按记录的先后注入
+//   同步输入 - 控制代码在读取异步输入（编码器快照）或其它输入时留下的标记，
+//              回放时在同一位置取出，从而确定每次读取看到了哪些边沿
+// 注意：ENCODER_USE_EDGECAP为1时边沿在任务中批量处理，不产生EDGE记录，回放不支持这种方式
+//
+#define TRACE_HEADER   0  // 开始记录，负载为TraceHeader_TypeDef
+#define TRACE_IMU      1  // App_MPU6050_Update读到的14字节原始数据（0x3B..0x48）；标志为1时为
+                          // App_MPU6050_UpdateGyro读到的2字节（0x43..0x44）
+#define TRACE_EDGE_L   2  // 左编码器A相边沿，标志bit0为A相电平，bit1为B相电平
+#define TRACE_EDGE_R   3  // 右编码器A相边沿，同上
+#define TRACE_SPEED_L  4  // App_Encoder_GetSpeed_L读取快照，时间即计算速度用的当前时刻
+#define TRACE_SPEED_R  5  // App_Encoder_GetSpeed_R读取快照
+#define TRACE_POS_L    6  // App_Encoder_GetPos_L读取计数值
+#define TRACE_POS_R    7  // App_Encoder_GetPos_R读取计数值
+#define TRACE_BAT      8  // App_Bat_Get返回的电压发生了变化，负载为float
+#define TRACE_MOTOR    9  // 电机任务开始执行
+#define TRACE_CONTROL  10 // 控制任务开始执行
+#define TRACE_PWM      11 // 电机任务输出的占空比的校验值（Trace_Hash），回放时用于逐位比较
+#define TRACE_MOVE     12 // App_Control_Move，负载为speed和turn两个float
+#define TRACE_MODE     13 // App_Control_SetMode，标志为新的模式
+#define TRACE_BUTTON   14 // 单击按键（复位控制器并切换电机使能），标志为新的使能状态
+
+#define TRACE_MAGIC    0x43524254 // "TBRC"
+#define TRACE_VERSION  2
+
+typedef struct
+{
+	uint32_t Magic;
+	uint8_t Version;
+	uint8_t Reserved[3];
+	float EncoderDuty_L;    // 以下为回放所需的校准参数，与CaliResult_TypeDef对应
+	float EncoderDuty_R;
+	float GxBias;
+	float GyBias;
+	float GzBias;
+	float PitchBias;
+} TraceHeader_TypeDef;
+
+void App_Trace_Init(void);
+void App_Trace_Record(uint8_t Type, uint8_t Flags, uint32_t Us, const void *pData, uint8_t Size);
+uint32_t App_Trace_GetDropped(void);
+
+#endif
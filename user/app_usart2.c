@@ -1,38 +1,87 @@
-#include "app_usart2.h"
-
-void App_USART2_Init(void)
-{
-	// #1. 初始化IO引脚
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
-	
-	GPIO_InitTypeDef GPIO_InitStruct = {0};
-	
-	// PA2 AF_PP
-	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_2;
-	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;
-	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_2MHz;
-	
-	GPIO_Init(GPIOA, &GPIO_InitStruct);
-	
-	// PA3 IPU
-	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_3;
-	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
-	
-	GPIO_Init(GPIOA, &GPIO_InitStruct);
-	
-	// #2. 开启USART2的时钟
-	RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART2, ENABLE);
-	
-	// #3. 配置USART2的参数
-	USART_InitTypeDef USART_InitStruct = {0};
-	
-	USART_InitStruct.USART_BaudRate = 921600;
-	USART_InitStruct.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
-	USART_InitStruct.USART_Parity = USART_Parity_No;
-	USART_InitStruct.USART_StopBits = USART_StopBits_1;
-	USART_InitStruct.USART_WordLength = USART_WordLength_8b;
-	USART_Init(USART2, &USART_InitStruct);
-	
-	// #5. 闭合USART2的总开关
-	USART_Cmd(USART2, ENABLE);
-}
+#include "app_usart2.h"
+
+//
+// USART2（PA2/PA3，921600bps）用于输出记录和遥测，约92KB/s。
+// 发送队列由DMA1_Channel7在后台发出，接收由DMA1_Channel6循环写入，
+// 写入方只在队列中预留空间并填写数据，从不等待串口
+//
+#define USART2_TX_BUFFER_SIZE 2048
+#define USART2_RX_BUFFER_SIZE 64
+
+static uint8_t txBuffer[USART2_TX_BUFFER_SIZE];
+static uint8_t rxBuffer[USART2_RX_BUFFER_SIZE];
+static Serial_TypeDef serial;
+
+void App_USART2_Init(void)
+{
+	// #1. 初始化IO引脚
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
+	
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	
+	// PA2 AF_PP
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_2;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;
+	GPIO_InitStruct.GPIO_Speed = GPIO_Speed_2MHz;
+	
+	GPIO_Init(GPIOA, &GPIO_InitStruct);
+	
+	// PA3 IPU
+	GPIO_InitStruct.GPIO_Pin = GPIO_Pin_3;
+	GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
+	
+	GPIO_Init(GPIOA, &GPIO_InitStruct);
+	
+	// #2. 开启USART2的时钟
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART2, ENABLE);
+	
+	// #3. 配置USART2的参数
+	USART_InitTypeDef USART_InitStruct = {0};
+	
+	USART_InitStruct.USART_BaudRate = 921600;
+	USART_InitStruct.USART_Mode = USART_Mode_Tx | USART_Mode_Rx;
+	USART_InitStruct.USART_Parity = USART_Parity_No;
+	USART_InitStruct.USART_StopBits = USART_StopBits_1;
+	USART_InitStruct.USART_WordLength = USART_WordLength_8b;
+	USART_Init(USART2, &USART_InitStruct);
+	
+	// #4. 配置发送队列和接收缓冲区
+	Serial_InitTypeDef Serial_InitStruct = {0};
+	
+	Serial_InitStruct.USARTx = USART2;
+	Serial_InitStruct.TxDMAy_Channelx = DMA1_Channel7;
+	Serial_InitStruct.RxDMAy_Channelx = DMA1_Channel6;
+	Serial_InitStruct.pTxBuffer = txBuffer;
+	Serial_InitStruct.TxBufferSize = USART2_TX_BUFFER_SIZE;
+	Serial_InitStruct.pRxBuffer = rxBuffer;
+	Serial_InitStruct.RxBufferSize = USART2_RX_BUFFER_SIZE;
+	Serial_InitStruct.NVIC_IRQChannelPreemptionPriority = 2; // 低于编码器和ADC
+	
+	My_Serial_Init(&serial, &Serial_InitStruct);
+	
+	// #5. 闭合USART2的总开关
+	USART_Cmd(USART2, ENABLE);
+}
+
+//
+// @简介：获取USART2的串口句柄，用于My_Serial_xxx
+//
+Serial_TypeDef *App_USART2_GetSerial(void)
+{
+	return &serial;
+}
+
+void USART2_IRQHandler(void)
+{
+	My_Serial_IRQHandler(&serial);
+}
+
+void DMA1_Channel7_IRQHandler(void)
+{
+	My_Serial_TxDMA_IRQHandler(&serial);
+}
+
+void DMA1_Channel6_IRQHandler(void)
+{
+	My_Serial_RxDMA_IRQHandler(&serial);
+}
@@ -1,8 +1,16 @@
-#ifndef APP_USART2_H
-#define APP_USART2_H
-
-#include "usart.h"
-
-void App_USART2_Init(void);
-
-#endif
+#ifndef APP_USART2_H
+#define APP_USART2_H
+
+#include "usart.h"
+#include "serial.h"
+
+// USART2输出的数据流，记录和遥测的字节流不能混在一起，只能选择其一
+#define USART2_STREAM_TRACE     0 // 控制代码的输入记录（app_trace.c），由tools/replay回放
+#define USART2_STREAM_TELEMETRY 1 // 遥测（app_telemetry.c），由tools/telemetry解码为CSV
+
+#define USART2_STREAM USART2_STREAM_TELEMETRY
+
+void App_USART2_Init(void);
+Serial_TypeDef *App_USART2_GetSerial(void);
+
+#endif